@@ -0,0 +1,14 @@
+# 单元测试和性能测试程序：与examples下的程序使用相同的编译和链接设置，但编译为控制台程序（测试结果输出到标准输出）
+include("${CMAKE_CURRENT_LIST_DIR}/duilib_bin.cmake")
+
+if(DUILIB_OS_WINDOWS)
+    if(MSVC)
+        # 使用控制台子系统，入口函数为main
+        set_target_properties(${PROJECT_NAME} PROPERTIES
+            LINK_FLAGS "/SUBSYSTEM:CONSOLE"
+        )
+    elseif(DUILIB_MINGW)
+        # 去掉生成Windows程序的链接参数
+        string(REPLACE "-mwindows" "" CMAKE_EXE_LINKER_FLAGS "${CMAKE_EXE_LINKER_FLAGS}")
+    endif()
+endif()
@@ -0,0 +1,170 @@
+#include "AnimationFrameClock.h"
+#include "duilib/Animation/AnimationPlayer.h"
+#include "duilib/Core/GlobalManager.h"
+#include <algorithm>
+
+namespace ui
+{
+
+AnimationFrameClock::AnimationFrameClock():
+    m_nPlayerCount(0),
+    m_nFrameRate(60),
+    m_nTimerId(0),
+    m_bInFrame(false),
+    m_frameTime(std::chrono::steady_clock::now())
+{
+}
+
+AnimationFrameClock::~AnimationFrameClock()
+{
+    m_clockFlag.Cancel();
+}
+
+void AnimationFrameClock::SetFrameRate(int32_t nFrameRate)
+{
+    ASSERT((nFrameRate >= 1) && (nFrameRate <= 240));
+    if (nFrameRate < 1) {
+        nFrameRate = 1;
+    }
+    else if (nFrameRate > 240) {
+        nFrameRate = 240;
+    }
+    if (m_nFrameRate == nFrameRate) {
+        return;
+    }
+    m_nFrameRate = nFrameRate;
+    if (IsRunning()) {
+        //按新的帧率重新启动帧时钟
+        StopClock();
+        StartClock();
+    }
+}
+
+int32_t AnimationFrameClock::GetFrameRate() const
+{
+    return m_nFrameRate;
+}
+
+uint32_t AnimationFrameClock::GetFrameIntervalMs() const
+{
+    uint32_t nFrameIntervalMs = (uint32_t)(1000 / m_nFrameRate);
+    if (nFrameIntervalMs == 0) {
+        nFrameIntervalMs = 1;
+    }
+    return nFrameIntervalMs;
+}
+
+void AnimationFrameClock::AddPlayer(AnimationPlayerBase* pPlayer)
+{
+    ASSERT(pPlayer != nullptr);
+    if (pPlayer == nullptr) {
+        return;
+    }
+    if (std::find(m_players.begin(), m_players.end(), pPlayer) != m_players.end()) {
+        return;
+    }
+    m_players.push_back(pPlayer);
+    ++m_nPlayerCount;
+    if (!IsRunning()) {
+        StartClock();
+    }
+}
+
+void AnimationFrameClock::RemovePlayer(AnimationPlayerBase* pPlayer)
+{
+    auto iter = std::find(m_players.begin(), m_players.end(), pPlayer);
+    if ((pPlayer == nullptr) || (iter == m_players.end())) {
+        return;
+    }
+    if (m_bInFrame) {
+        //帧回调中，不能改变列表的结构
+        *iter = nullptr;
+    }
+    else {
+        m_players.erase(iter);
+    }
+    ASSERT(m_nPlayerCount > 0);
+    --m_nPlayerCount;
+    if ((m_nPlayerCount == 0) && !m_bInFrame) {
+        StopClock();
+    }
+}
+
+size_t AnimationFrameClock::GetPlayerCount() const
+{
+    return m_nPlayerCount;
+}
+
+bool AnimationFrameClock::IsRunning() const
+{
+    return m_nTimerId != 0;
+}
+
+std::chrono::steady_clock::time_point AnimationFrameClock::GetFrameTime() const
+{
+    return m_frameTime;
+}
+
+void AnimationFrameClock::Clear()
+{
+    for (AnimationPlayerBase*& pPlayer : m_players) {
+        if (pPlayer != nullptr) {
+            pPlayer->m_bInFrameClock = false;
+            pPlayer = nullptr;
+        }
+    }
+    if (!m_bInFrame) {
+        m_players.clear();
+    }
+    m_nPlayerCount = 0;
+    StopClock();
+}
+
+void AnimationFrameClock::StartClock()
+{
+    ASSERT(m_nTimerId == 0);
+    m_frameTime = std::chrono::steady_clock::now();
+    auto frameCallback = std::bind(&AnimationFrameClock::OnFrame, this);
+    m_nTimerId = GlobalManager::Instance().Timer().AddTimer(m_clockFlag.GetWeakFlag(), frameCallback, GetFrameIntervalMs());
+    //有动画播放期间，定时器按帧对齐：同一帧内到期的定时器（比如GIF动画、滚动条的定时器）与动画帧合并为一次唤醒
+    GlobalManager::Instance().Timer().SetFrameInterval(GetFrameIntervalMs());
+}
+
+void AnimationFrameClock::StopClock()
+{
+    m_clockFlag.Cancel();
+    if (m_nTimerId != 0) {
+        GlobalManager::Instance().Timer().RemoveTimer(m_nTimerId);
+        m_nTimerId = 0;
+        //没有动画播放时，定时器恢复按各自的时间触发
+        GlobalManager::Instance().Timer().SetFrameInterval(0);
+    }
+}
+
+void AnimationFrameClock::OnFrame()
+{
+    if (m_bInFrame) {
+        return;
+    }
+    m_bInFrame = true;
+    m_frameTime = std::chrono::steady_clock::now();
+    //本帧新加入的动画，在加入时已经播放过一次，不参与本帧
+    const size_t nCount = m_players.size();
+    for (size_t nIndex = 0; nIndex < nCount; ++nIndex) {
+        AnimationPlayerBase* pPlayer = m_players[nIndex];
+        if (pPlayer != nullptr) {
+            //播放回调中可能停止、删除任意动画（包括自身），移除的动画会被置为nullptr
+            pPlayer->Play();
+        }
+    }
+    m_bInFrame = false;
+
+    m_players.erase(std::remove(m_players.begin(), m_players.end(), nullptr), m_players.end());
+    ASSERT(m_players.size() == m_nPlayerCount);
+    if (m_players.empty()) {
+        //没有正在播放的动画，停止帧时钟，空闲时不再唤醒
+        StopClock();
+    }
+}
+
+} // namespace ui
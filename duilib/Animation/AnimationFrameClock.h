@@ -0,0 +1,107 @@
+#ifndef UI_ANIMATION_ANIMATION_FRAME_CLOCK_H_
+#define UI_ANIMATION_ANIMATION_FRAME_CLOCK_H_
+
+#include "duilib/duilib_defs.h"
+#include "duilib/Core/Callback.h"
+#include <chrono>
+#include <vector>
+
+namespace ui
+{
+class AnimationPlayerBase;
+
+/** 动画的帧时钟：所有正在播放的动画（AnimationPlayer，包括ScrollBox的滚动动画），由同一个按帧率触发的定时器统一驱动，
+*   每一帧中，各个动画按已经播放的时间计算当前值；没有正在播放的动画时，定时器停止，不产生任何唤醒
+*/
+class UILIB_API AnimationFrameClock
+{
+public:
+    AnimationFrameClock();
+    ~AnimationFrameClock();
+    AnimationFrameClock(const AnimationFrameClock&) = delete;
+    AnimationFrameClock& operator = (const AnimationFrameClock&) = delete;
+
+public:
+    /** 设置帧率（每秒的帧数）
+    * @param [in] nFrameRate 帧率，有效范围为[1, 240]，默认为60
+    */
+    void SetFrameRate(int32_t nFrameRate);
+
+    /** 获取帧率（每秒的帧数）
+    */
+    int32_t GetFrameRate() const;
+
+    /** 添加一个正在播放的动画，如果帧时钟未启动，则启动帧时钟
+    */
+    void AddPlayer(AnimationPlayerBase* pPlayer);
+
+    /** 移除一个动画（动画停止或者播放完成），如果没有正在播放的动画，则停止帧时钟
+    */
+    void RemovePlayer(AnimationPlayerBase* pPlayer);
+
+    /** 获取正在播放的动画个数
+    */
+    size_t GetPlayerCount() const;
+
+    /** 帧时钟是否正在运行
+    */
+    bool IsRunning() const;
+
+    /** 获取当前帧的时间戳（在动画的播放回调中调用时，同一帧内的所有动画得到的时间戳相同）
+    */
+    std::chrono::steady_clock::time_point GetFrameTime() const;
+
+    /** 移除所有动画，并停止帧时钟
+    */
+    void Clear();
+
+private:
+    /** 帧时钟的定时器回调：驱动所有正在播放的动画播放一帧
+    */
+    void OnFrame();
+
+    /** 启动帧时钟
+    */
+    void StartClock();
+
+    /** 停止帧时钟
+    */
+    void StopClock();
+
+    /** 获取每帧的时间间隔（毫秒）
+    */
+    uint32_t GetFrameIntervalMs() const;
+
+private:
+    /** 正在播放的动画列表（在帧回调中移除的动画，先置为nullptr，帧回调结束后再清理）
+    */
+    std::vector<AnimationPlayerBase*> m_players;
+
+    /** 正在播放的动画个数
+    */
+    size_t m_nPlayerCount;
+
+    /** 帧率
+    */
+    int32_t m_nFrameRate;
+
+    /** 帧时钟的定时器ID
+    */
+    size_t m_nTimerId;
+
+    /** 是否正在执行帧回调
+    */
+    bool m_bInFrame;
+
+    /** 当前帧的时间戳
+    */
+    std::chrono::steady_clock::time_point m_frameTime;
+
+    /** 定时器取消标志
+    */
+    WeakCallbackFlag m_clockFlag;
+};
+
+} // namespace ui
+
+#endif // UI_ANIMATION_ANIMATION_FRAME_CLOCK_H_
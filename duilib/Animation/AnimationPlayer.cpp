@@ -1,4 +1,5 @@
 #include "AnimationPlayer.h"
+#include "duilib/Animation/AnimationFrameClock.h"
 #include "duilib/Core/GlobalManager.h"
 
 #define AP_NO_VALUE -1
@@ -14,24 +15,42 @@ AnimationPlayerBase::AnimationPlayerBase():
     m_animationType(AnimationType::kAnimationNone),
     m_bFirstRun(true),
     m_playCallback(nullptr),
-    m_completeCallback(nullptr)
+    m_completeCallback(nullptr),
+    m_bInFrameClock(false)
 {
     InitBaseData();
 }
 
 AnimationPlayerBase::~AnimationPlayerBase()
 {
+    RemoveFromFrameClock();
+}
+
+void AnimationPlayerBase::AddToFrameClock()
+{
+    if (!m_bInFrameClock) {
+        m_bInFrameClock = true;
+        GlobalManager::Instance().FrameClock().AddPlayer(this);
+    }
+}
+
+void AnimationPlayerBase::RemoveFromFrameClock()
+{
+    if (m_bInFrameClock) {
+        m_bInFrameClock = false;
+        GlobalManager::Instance().FrameClock().RemovePlayer(this);
+    }
 }
 
 void AnimationPlayerBase::Reset()
 {
-    m_weakFlagOwner.Cancel();
+    RemoveFromFrameClock();
     Init();
 }
 
 void AnimationPlayerBase::Clear()
 {
-    m_weakFlagOwner.Cancel();
+    RemoveFromFrameClock();
     m_playCallback = nullptr;
     m_completeCallback = nullptr;
 }
@@ -43,7 +62,6 @@ void AnimationPlayerBase::InitBaseData()
     m_currentValue = 0;
     m_totalMillSeconds = AP_NO_VALUE;
     m_palyedMillSeconds = 0;
-    m_elapseMillSeconds = 0;
     m_reverseStart = false;
     m_bPlaying = false;
     m_startTime = std::chrono::steady_clock::now();
@@ -56,7 +74,7 @@ void AnimationPlayerBase::Init()
 
 void AnimationPlayerBase::Start()
 {
-    m_weakFlagOwner.Cancel();
+    RemoveFromFrameClock();
     m_palyedMillSeconds = 0;
     m_reverseStart = false;
     StartTimer();
@@ -64,12 +82,12 @@ void AnimationPlayerBase::Start()
 
 void AnimationPlayerBase::Stop()
 {
-    m_weakFlagOwner.Cancel();
+    RemoveFromFrameClock();
 }
 
 void AnimationPlayerBase::Continue()
 {
-    m_weakFlagOwner.Cancel();
+    RemoveFromFrameClock();
     if (m_reverseStart) {
         ReverseAllValue();
     }    
@@ -81,7 +99,7 @@ void AnimationPlayerBase::Continue()
 
 void AnimationPlayerBase::ReverseContinue()
 {
-    m_weakFlagOwner.Cancel();
+    RemoveFromFrameClock();
     if (!m_reverseStart) {
         ReverseAllValue();
     }        
@@ -104,23 +122,18 @@ void AnimationPlayerBase::StartTimer()
         return;
     }
 
-    m_elapseMillSeconds = m_totalMillSeconds / std::abs(m_endValue - m_startValue);
-    if (m_elapseMillSeconds == 0) {
-        m_elapseMillSeconds = 1;
-    }
-
+    //先加入帧时钟再播放第一帧：如果第一帧就播放完成，会在Complete中从帧时钟移除
+    AddToFrameClock();
     Play();
-    auto playCallback = UiBind(&AnimationPlayerBase::Play, this);
-    ASSERT(m_elapseMillSeconds <= INT32_MAX);
-    GlobalManager::Instance().Timer().AddTimer(m_weakFlagOwner.GetWeakFlag(), playCallback, (uint32_t)m_elapseMillSeconds);
 }
 
 void AnimationPlayerBase::Play()
 {
+    //按实际经过的时间计算当前值，与帧时钟的触发间隔无关
     std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now();
     auto thisTime = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - m_startTime); //播放耗时：毫秒
     m_palyedMillSeconds += thisTime.count(); //累计到已播放时间（毫秒）
-    m_startTime = std::chrono::steady_clock::now();
+    m_startTime += thisTime; //未满1毫秒的部分，累计到下一帧
 
     int64_t newCurrentValue = GetCurrentValue();
     if (m_playCallback) {
@@ -160,7 +173,7 @@ void AnimationPlayerBase::Complete()
         m_completeCallback();
     }        
 
-    m_weakFlagOwner.Cancel();
+    RemoveFromFrameClock();
     m_bPlaying = false;
 }
 
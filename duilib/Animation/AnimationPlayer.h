@@ -7,6 +7,7 @@
 
 namespace ui 
 {
+class AnimationFrameClock;
 
 typedef std::function<void (int64_t)> PlayCallback;        //播放回调函数
 typedef std::function<void (void)> CompleteCallback;    //播放完成回调函数
@@ -99,7 +100,7 @@ public:
     */
     virtual void ReverseContinue();
 
-    /** 启动动画定时器
+    /** 启动动画（加入帧时钟，由帧时钟统一驱动播放）
     */
     virtual void StartTimer();
 
@@ -108,10 +109,20 @@ public:
     virtual int64_t GetCurrentValue() const = 0;
 
 private:
-    /** 播放一次动画（在定时器中触发调用）
+    friend class AnimationFrameClock;
+
+    /** 播放一次动画（在帧时钟的每一帧中触发调用）
     */
     void Play();
 
+    /** 加入帧时钟
+    */
+    void AddToFrameClock();
+
+    /** 从帧时钟中移除
+    */
+    void RemoveFromFrameClock();
+
     /** 交换起始值和结束值
     */
     void ReverseAllValue();
@@ -149,10 +160,6 @@ protected:
     */
     int64_t m_palyedMillSeconds;
 
-    /** 动画播放的时间间隔，即定时器的触发时间间隔（毫秒）
-    */
-    int64_t m_elapseMillSeconds;
-
     /** 是否第一次播放
     */
     bool m_bFirstRun;
@@ -173,13 +180,14 @@ protected:
     */
     CompleteCallback m_completeCallback;
     
-    /** 播放的开始时间戳
+    /** 上次播放的时间戳
     */
     std::chrono::steady_clock::time_point m_startTime;
-    
-    /** 定时器终止标志
+
+private:
+    /** 是否已经加入帧时钟
     */
-    WeakCallbackFlag m_weakFlagOwner;
+    bool m_bInFrameClock;
 };
 
 
@@ -198,7 +206,7 @@ public:
     */
     virtual void Init() override;
 
-    /** 启动动画定时器
+    /** 启动动画（加入帧时钟，由帧时钟统一驱动播放）
     */
     virtual void StartTimer() override;
 
@@ -2131,6 +2131,7 @@ bool ListBox::SortItems(PFNCompareFunc pfnCompare, void* pCompareContext)
     //Linux 系统
     qsort_r(&(*m_items.begin()), m_items.size(), sizeof(Control*), ListBox::ItemComareFuncLinux, this);
 #endif    
+    InvalidateHitTestIndex();
     IListBoxItem* pItem = nullptr;
     const size_t itemCount = m_items.size();
     for (size_t i = 0; i < itemCount; ++i) {
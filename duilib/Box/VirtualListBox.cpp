@@ -8,17 +8,20 @@ namespace ui {
 VirtualListBoxElement::VirtualListBoxElement():
     m_pVirtualListBox(nullptr),
     m_pfnCountChangedNotify(),
-    m_pfnDataChangedNotify()
+    m_pfnDataChangedNotify(),
+    m_pfnElementsChangedNotify()
 {
 }
 
 void VirtualListBoxElement::RegNotifys(VirtualListBox* pVirtualListBox,
                                        const DataChangedNotify& dcNotify,
-                                       const CountChangedNotify& ccNotify)
+                                       const CountChangedNotify& ccNotify,
+                                       const ElementsChangedNotify& ecNotify)
 {
     m_pVirtualListBox = pVirtualListBox;
     m_pfnDataChangedNotify = dcNotify;
     m_pfnCountChangedNotify = ccNotify;
+    m_pfnElementsChangedNotify = ecNotify;
 }
 
 void VirtualListBoxElement::UnRegNotifys(VirtualListBox* pVirtualListBox)
@@ -27,6 +30,7 @@ void VirtualListBoxElement::UnRegNotifys(VirtualListBox* pVirtualListBox)
         m_pVirtualListBox = nullptr;
         m_pfnDataChangedNotify = nullptr;
         m_pfnCountChangedNotify = nullptr;
+        m_pfnElementsChangedNotify = nullptr;
     }
 }
 
@@ -44,6 +48,36 @@ void VirtualListBoxElement::EmitCountChanged()
     }
 }
 
+void VirtualListBoxElement::EmitElementsInserted(size_t nStartIndex, size_t nCount)
+{
+    if (m_pfnElementsChangedNotify) {
+        m_pfnElementsChangedNotify(nStartIndex, 0, nCount);
+    }
+    else {
+        EmitCountChanged();
+    }
+}
+
+void VirtualListBoxElement::EmitElementsRemoved(size_t nStartIndex, size_t nCount)
+{
+    if (m_pfnElementsChangedNotify) {
+        m_pfnElementsChangedNotify(nStartIndex, nCount, 0);
+    }
+    else {
+        EmitCountChanged();
+    }
+}
+
+bool VirtualListBoxElement::IsVariableElementSize() const
+{
+    return false;
+}
+
+int32_t VirtualListBoxElement::GetElementSize(size_t /*nElementIndex*/) const
+{
+    return -1;
+}
+
 /////////////////////////////////////////////////////////////////////////////
 //
 VirtualListBox::VirtualListBox(Window* pWindow, Layout* pLayout)
@@ -81,7 +115,9 @@ void VirtualListBox::SetDataProvider(VirtualListBoxElement* pProvider)
         //注册模型数据变动通知回调
         pProvider->RegNotifys(this,
                               UiBind(&VirtualListBox::OnModelDataChanged, this, std::placeholders::_1, std::placeholders::_2),
-                              UiBind(&VirtualListBox::OnModelCountChanged, this));
+                              UiBind(&VirtualListBox::OnModelCountChanged, this),
+                              UiBind(&VirtualListBox::OnModelElementsChanged, this, std::placeholders::_1,
+                                     std::placeholders::_2, std::placeholders::_3));
     }
 }
 
@@ -261,6 +297,20 @@ size_t VirtualListBox::GetElementCount() const
     return elementCount;
 }
 
+bool VirtualListBox::IsVariableElementSize() const
+{
+    return (m_pDataProvider != nullptr) && m_pDataProvider->IsVariableElementSize();
+}
+
+int32_t VirtualListBox::QueryElementSize(size_t nElementIndex) const
+{
+    int32_t nSize = -1;
+    if (m_pDataProvider != nullptr) {
+        nSize = m_pDataProvider->GetElementSize(nElementIndex);
+    }
+    return (nSize < 0) ? -1 : nSize;
+}
+
 void VirtualListBox::SetElementSelected(size_t nElementIndex, bool bSelected)
 {
     ASSERT(m_pDataProvider != nullptr);
@@ -486,6 +536,11 @@ void VirtualListBox::OnModelDataChanged(size_t nStartElementIndex, size_t nEndEl
         OnRefreshElements(refreshDataList);
         OnFilledElements(refreshDataList);
     }
+    if (IsVariableElementSize() && (m_pVirtualLayout != nullptr)) {
+        //数据项的大小可能发生变化，需要重新测量并布局
+        m_pVirtualLayout->InvalidateElementSize(nStartElementIndex, nEndElementIndex);
+        ReArrangeChild(true);
+    }
 }
 
 void VirtualListBox::OnFilledElements(const RefreshDataList& refreshDataList)
@@ -512,6 +567,20 @@ void VirtualListBox::OnFilledElements(const RefreshDataList& refreshDataList)
 void VirtualListBox::OnModelCountChanged()
 {
     //元素的个数发生变化（有添加或者删除）
+    if (IsVariableElementSize() && (m_pVirtualLayout != nullptr)) {
+        //变化的位置未知：按在末尾追加或者删除元素处理，已测量的大小保留（数据有变化时由EmitDataChanged通知）
+        m_pVirtualLayout->OnElementCountChanged(Box::InvalidIndex, 0, 0);
+    }
+    Refresh();
+}
+
+void VirtualListBox::OnModelElementsChanged(size_t nStartElementIndex, size_t nRemovedCount, size_t nInsertedCount)
+{
+    //在指定位置插入或者删除了元素
+    if (IsVariableElementSize() && (m_pVirtualLayout != nullptr)) {
+        //变化位置之后的元素，已测量的大小随之移动
+        m_pVirtualLayout->OnElementCountChanged(nStartElementIndex, nRemovedCount, nInsertedCount);
+    }
     Refresh();
 }
 
@@ -12,6 +12,7 @@ namespace ui {
 
 typedef std::function<void(size_t nStartIndex, size_t nEndIndex)> DataChangedNotify;
 typedef std::function<void()> CountChangedNotify;
+typedef std::function<void(size_t nStartIndex, size_t nRemovedCount, size_t nInsertedCount)> ElementsChangedNotify;
 
 class VirtualListBox;
 class UILIB_API VirtualListBoxElement : public virtual SupportWeakCallback
@@ -62,15 +63,29 @@ public:
     */
     virtual void SetMultiSelect(bool bMultiSelect) = 0;
 
+    /** 数据项的大小是否可变（纵向布局为高度，横向布局为宽度；仅VirtualVLayout和VirtualHLayout支持）
+    *   如果返回false，所有数据项的大小均为布局中设置的子项大小(item_size)
+    */
+    virtual bool IsVariableElementSize() const;
+
+    /** 获取数据项的大小（仅当IsVariableElementSize()返回true时调用）
+    * @param [in] nElementIndex 数据元素的索引ID，范围：[0, GetElementCount())
+    * @return 返回数据项的大小（包含控件的外边距），如果返回-1，表示大小未知：
+    *         未显示时按子项大小(item_size)估算，显示时按填充数据后的控件测量实际大小
+    */
+    virtual int32_t GetElementSize(size_t nElementIndex) const;
+
 public:
     /** 注册事件通知回调
     * @param [in] pVirtualListBox 关联的VirtualListBox对象
     * @param [in] dcNotify 数据内容变化通知回调函数
     * @param [in] ccNotify 数据项个数变化通知回调函数
+    * @param [in] ecNotify 数据项插入或者删除通知回调函数（带有变化的位置）
     */
     void RegNotifys(VirtualListBox* pVirtualListBox,
                     const DataChangedNotify& dcNotify,
-                    const CountChangedNotify& ccNotify);
+                    const CountChangedNotify& ccNotify,
+                    const ElementsChangedNotify& ecNotify = nullptr);
 
     /** 注销事件通知回调
     * @param [in] pVirtualListBox 关联的VirtualListBox对象
@@ -85,10 +100,23 @@ protected:
     */
     void EmitDataChanged(size_t nStartElementIndex, size_t nEndElementIndex);
 
-    /** 发送通知：数据项个数发生变化
+    /** 发送通知：数据项个数发生变化（大小可变的布局按在末尾追加或者删除数据项处理，
+    *   如果在中间插入或者删除了数据项，应使用EmitElementsInserted或者EmitElementsRemoved通知变化的位置）
     */
     void EmitCountChanged();
 
+    /** 发送通知：在指定位置插入了数据项（如果未注册对应的回调函数，按数据项个数变化通知）
+    * @param [in] nStartElementIndex 插入的位置
+    * @param [in] nCount 插入的数据项个数
+    */
+    void EmitElementsInserted(size_t nStartElementIndex, size_t nCount);
+
+    /** 发送通知：在指定位置删除了数据项（如果未注册对应的回调函数，按数据项个数变化通知）
+    * @param [in] nStartElementIndex 删除的起始位置
+    * @param [in] nCount 删除的数据项个数
+    */
+    void EmitElementsRemoved(size_t nStartElementIndex, size_t nCount);
+
 private:
     /** 回调函数关联的VirtualListBox对象
     */
@@ -101,6 +129,10 @@ private:
     /** 数据个数发生变化的回调函数
     */
     CountChangedNotify m_pfnCountChangedNotify;
+
+    /** 数据项插入或者删除的回调函数
+    */
+    ElementsChangedNotify m_pfnElementsChangedNotify;
 };
 
 /** 虚表实现的ListBox，支持大数据量，支持滚动条
@@ -112,6 +144,7 @@ class UILIB_API VirtualListBox : public ListBox
     friend class VirtualVLayout;    
     friend class VirtualHTileLayout;
     friend class VirtualVTileLayout;
+    friend class VirtualVariableSizeLayout;
 public:
     VirtualListBox(Window* pWindow, Layout* pLayout);
 
@@ -143,6 +176,16 @@ public:
     */
     size_t GetElementCount() const;
 
+    /** 数据元素的大小是否可变（由数据代理对象决定）
+    */
+    bool IsVariableElementSize() const;
+
+    /** 从数据代理对象获取数据元素的大小
+    * @param [in] nElementIndex 数据元素的索引ID，范围：[0, GetElementCount())
+    * @return 返回数据元素的大小，如果返回-1表示大小未知
+    */
+    int32_t QueryElementSize(size_t nElementIndex) const;
+
     /** 获取当前选择的数据元素索引号(仅单选时有效)
     @return 返回选择的数据元素索引号，范围：[0, GetElementCount())
     */
@@ -501,6 +544,10 @@ protected:
     */
     void OnModelCountChanged();
 
+    /** 在指定位置插入或者删除了数据项，在事件中需要重新加载展示数据
+    */
+    void OnModelElementsChanged(size_t nStartElementIndex, size_t nRemovedCount, size_t nInsertedCount);
+
     /** 是否允许从界面状态同步到存储状态
     */
     bool IsEnableUpdateProvider() const;
@@ -4,6 +4,7 @@
 #include "duilib/Control/Button.h"
 #include "duilib/Core/StateColorMap2.h"
 #include "duilib/Utils/AttributeUtil.h"
+#include "duilib/Utils/AttributeTable.h"
 #include "duilib/Core/StateColorMap.h"
 #include "duilib/Animation/AnimationManager.h"
 #include "duilib/Animation/AnimationPlayer.h"
@@ -279,6 +280,10 @@ protected:
     */
     virtual bool ButtonUp(const EventArgs& msg) override;
 
+    /** 选择状态下，优先使用按下状态的边框颜色
+    */
+    virtual ControlStateType GetPaintBorderColorState(ControlStateType stateType) const override;
+
 protected:
     /** 获取被选择时指定状态下的实际被渲染文本颜色
      * @param [in] buttonStateType 要获取何种状态下的颜色
@@ -399,146 +404,342 @@ inline DString CheckBoxTemplate<HBox>::GetType() const { return DUI_CTR_CHECKBOX
 template<>
 inline DString CheckBoxTemplate<VBox>::GetType() const { return DUI_CTR_CHECKBOXVBOX; }
 
+/** CheckBox属性表的内部实现（模板类在头文件中实现，属性表不属于公共接口，放在detail命名空间中）
+*/
+namespace detail
+{
+/** CheckBox的属性ID（与属性名称一一对应，兼容的旧属性名称对应相同的属性ID）
+*/
+enum class CheckBoxAttribute : int32_t
+{
+    kSelected,
+    kSwitchSelect,
+    kSupportCheckMode,
+    kAutoCheckSelect,
+    kAutoSelectCheck,
+    kNormalFirst,
+    kSelectedNormalImage,
+    kSelectedHotImage,
+    kSelectedPushedImage,
+    kSelectedDisabledImage,
+    kSelectedForeNormalImage,
+    kSelectedForeHotImage,
+    kSelectedForePushedImage,
+    kSelectedForeDisabledImage,
+    kPartSelectedNormalImage,
+    kPartSelectedHotImage,
+    kPartSelectedPushedImage,
+    kPartSelectedDisabledImage,
+    kPartSelectedForeNormalImage,
+    kPartSelectedForeHotImage,
+    kPartSelectedForePushedImage,
+    kPartSelectedForeDisabledImage,
+    kSelectedTextColor,
+    kSelectedNormalTextColor,
+    kSelectedHotTextColor,
+    kSelectedPushedTextColor,
+    kSelectedDisabledTextColor,
+    kSelectedNormalColor,
+    kSelectedHotColor,
+    kSelectedPushedColor,
+    kSelectedDisabledColor,
+    kSelectedNormalColorMargin,
+    kSelectedHotColorMargin,
+    kSelectedPushedColorMargin,
+    kSelectedDisabledColorMargin,
+    kSelectedNormalColorRound,
+    kSelectedHotColorRound,
+    kSelectedPushedColorRound,
+    kSelectedDisabledColorRound
+};
+
+/** CheckBox的属性表（属性名称 -> 属性ID）
+*/
+inline constexpr AttributeTableEntry kCheckBoxAttributeEntries[] = {
+    {"selected", (int32_t)CheckBoxAttribute::kSelected},
+    {"switch_select", (int32_t)CheckBoxAttribute::kSwitchSelect},
+    {"switchselect", (int32_t)CheckBoxAttribute::kSwitchSelect},
+    {"support_check_Mode", (int32_t)CheckBoxAttribute::kSupportCheckMode},
+    {"auto_check_select", (int32_t)CheckBoxAttribute::kAutoCheckSelect},
+    {"auto_select_check", (int32_t)CheckBoxAttribute::kAutoSelectCheck},
+    {"normal_first", (int32_t)CheckBoxAttribute::kNormalFirst},
+    {"normalfirst", (int32_t)CheckBoxAttribute::kNormalFirst},
+    {"selected_normal_image", (int32_t)CheckBoxAttribute::kSelectedNormalImage},
+    {"selectednormalimage", (int32_t)CheckBoxAttribute::kSelectedNormalImage},
+    {"selected_hot_image", (int32_t)CheckBoxAttribute::kSelectedHotImage},
+    {"selectedhotimage", (int32_t)CheckBoxAttribute::kSelectedHotImage},
+    {"selected_pushed_image", (int32_t)CheckBoxAttribute::kSelectedPushedImage},
+    {"selectedpushedimage", (int32_t)CheckBoxAttribute::kSelectedPushedImage},
+    {"selected_disabled_image", (int32_t)CheckBoxAttribute::kSelectedDisabledImage},
+    {"selecteddisabledimage", (int32_t)CheckBoxAttribute::kSelectedDisabledImage},
+    {"selected_fore_normal_image", (int32_t)CheckBoxAttribute::kSelectedForeNormalImage},
+    {"selectedforenormalimage", (int32_t)CheckBoxAttribute::kSelectedForeNormalImage},
+    {"selected_fore_hot_image", (int32_t)CheckBoxAttribute::kSelectedForeHotImage},
+    {"selectedforehotimage", (int32_t)CheckBoxAttribute::kSelectedForeHotImage},
+    {"selected_fore_pushed_image", (int32_t)CheckBoxAttribute::kSelectedForePushedImage},
+    {"selectedforepushedimage", (int32_t)CheckBoxAttribute::kSelectedForePushedImage},
+    {"selected_fore_disabled_image", (int32_t)CheckBoxAttribute::kSelectedForeDisabledImage},
+    {"selectedforedisabledimage", (int32_t)CheckBoxAttribute::kSelectedForeDisabledImage},
+    {"part_selected_normal_image", (int32_t)CheckBoxAttribute::kPartSelectedNormalImage},
+    {"part_selected_hot_image", (int32_t)CheckBoxAttribute::kPartSelectedHotImage},
+    {"part_selected_pushed_image", (int32_t)CheckBoxAttribute::kPartSelectedPushedImage},
+    {"part_selected_disabled_image", (int32_t)CheckBoxAttribute::kPartSelectedDisabledImage},
+    {"part_selected_fore_normal_image", (int32_t)CheckBoxAttribute::kPartSelectedForeNormalImage},
+    {"part_selected_fore_hot_image", (int32_t)CheckBoxAttribute::kPartSelectedForeHotImage},
+    {"part_selected_fore_pushed_image", (int32_t)CheckBoxAttribute::kPartSelectedForePushedImage},
+    {"part_selected_fore_disabled_image", (int32_t)CheckBoxAttribute::kPartSelectedForeDisabledImage},
+    {"selected_text_color", (int32_t)CheckBoxAttribute::kSelectedTextColor},
+    {"selectedtextcolor", (int32_t)CheckBoxAttribute::kSelectedTextColor},
+    {"selected_normal_text_color", (int32_t)CheckBoxAttribute::kSelectedNormalTextColor},
+    {"selectednormaltextcolor", (int32_t)CheckBoxAttribute::kSelectedNormalTextColor},
+    {"selected_hot_text_color", (int32_t)CheckBoxAttribute::kSelectedHotTextColor},
+    {"selectedhottextcolor", (int32_t)CheckBoxAttribute::kSelectedHotTextColor},
+    {"selected_pushed_text_color", (int32_t)CheckBoxAttribute::kSelectedPushedTextColor},
+    {"selectedpushedtextcolor", (int32_t)CheckBoxAttribute::kSelectedPushedTextColor},
+    {"selected_disabled_text_color", (int32_t)CheckBoxAttribute::kSelectedDisabledTextColor},
+    {"selecteddisabledtextcolor", (int32_t)CheckBoxAttribute::kSelectedDisabledTextColor},
+    {"selected_normal_color", (int32_t)CheckBoxAttribute::kSelectedNormalColor},
+    {"selectednormalcolor", (int32_t)CheckBoxAttribute::kSelectedNormalColor},
+    {"selected_hot_color", (int32_t)CheckBoxAttribute::kSelectedHotColor},
+    {"selectedhotcolor", (int32_t)CheckBoxAttribute::kSelectedHotColor},
+    {"selected_pushed_color", (int32_t)CheckBoxAttribute::kSelectedPushedColor},
+    {"selectedpushedcolor", (int32_t)CheckBoxAttribute::kSelectedPushedColor},
+    {"selected_disabled_color", (int32_t)CheckBoxAttribute::kSelectedDisabledColor},
+    {"selecteddisabledcolor", (int32_t)CheckBoxAttribute::kSelectedDisabledColor},
+    {"selected_normal_color_margin", (int32_t)CheckBoxAttribute::kSelectedNormalColorMargin},
+    {"selected_hot_color_margin", (int32_t)CheckBoxAttribute::kSelectedHotColorMargin},
+    {"selected_pushed_color_margin", (int32_t)CheckBoxAttribute::kSelectedPushedColorMargin},
+    {"selected_disabled_color_margin", (int32_t)CheckBoxAttribute::kSelectedDisabledColorMargin},
+    {"selected_normal_color_round", (int32_t)CheckBoxAttribute::kSelectedNormalColorRound},
+    {"selected_hot_color_round", (int32_t)CheckBoxAttribute::kSelectedHotColorRound},
+    {"selected_pushed_color_round", (int32_t)CheckBoxAttribute::kSelectedPushedColorRound},
+    {"selected_disabled_color_round", (int32_t)CheckBoxAttribute::kSelectedDisabledColorRound},
+};
+inline constexpr AttributeTable kCheckBoxAttributeTable(kCheckBoxAttributeEntries);
+static_assert(kCheckBoxAttributeTable.IsValid(), "CheckBox attribute table is invalid!");
+} // namespace detail
+
 template<typename InheritType>
 void CheckBoxTemplate<InheritType>::SetAttribute(const DString& strName, const DString& strValue)
 {
-    if (strName == _T("selected")) {
-        Selected(strValue == _T("true"), true);
-    }
-    else if ((strName == _T("switch_select")) || (strName == _T("switchselect"))) {
-        Selected(!IsSelected());
-    }
-    else if (strName == _T("support_check_Mode")) {
-        SetSupportCheckMode(strValue == _T("true"));
-    }
-    else if (strName == _T("auto_check_select")) {
-        //设置当选择状态变化时，是否自动同步到勾选状态，保持勾选状态与选择状态一致(Select->Check)
-        SetAutoCheckSelect(strValue == _T("true"));
-    }
-    else if (strName == _T("auto_select_check")) {
-        //设置当勾选状态变化时，是否自动同步到选择状态，保持选择状态与勾选状态一致(Check -> Select)
-        SetAutoSelectCheck(strValue == _T("true"));
-    }
-    else if ((strName == _T("normal_first")) || (strName == _T("normalfirst"))) {
-        SetPaintNormalFirst(strValue == _T("true"));
-    }
-    else if ((strName == _T("selected_normal_image")) || (strName == _T("selectednormalimage"))) {
-        SetSelectedStateImage(kControlStateNormal, strValue);
-    }
-    else if ((strName == _T("selected_hot_image")) || (strName == _T("selectedhotimage"))) {
-        SetSelectedStateImage(kControlStateHot, strValue);
-    }
-    else if ((strName == _T("selected_pushed_image")) || (strName == _T("selectedpushedimage"))) {
-        SetSelectedStateImage(kControlStatePushed, strValue);
-    }
-    else if ((strName == _T("selected_disabled_image")) || (strName == _T("selecteddisabledimage"))) {
-        SetSelectedStateImage(kControlStateDisabled, strValue);
-    }
-    else if ((strName == _T("selected_fore_normal_image")) || (strName == _T("selectedforenormalimage"))) {
-        SetSelectedForeStateImage(kControlStateNormal, strValue);
-    }
-    else if ((strName == _T("selected_fore_hot_image")) || (strName == _T("selectedforehotimage"))) {
-        SetSelectedForeStateImage(kControlStateHot, strValue);
-    }
-    else if ((strName == _T("selected_fore_pushed_image")) || (strName == _T("selectedforepushedimage"))) {
-        SetSelectedForeStateImage(kControlStatePushed, strValue);
-    }
-    else if ((strName == _T("selected_fore_disabled_image")) || (strName == _T("selectedforedisabledimage"))) {
-        SetSelectedForeStateImage(kControlStateDisabled, strValue);
-    }
-    else if (strName == _T("part_selected_normal_image")) {
-        SetPartSelectedStateImage(kControlStateNormal, strValue);
-    }
-    else if (strName == _T("part_selected_hot_image")) {
-        SetPartSelectedStateImage(kControlStateHot, strValue);
-    }
-    else if (strName == _T("part_selected_pushed_image")) {
-        SetPartSelectedStateImage(kControlStatePushed, strValue);
-    }
-    else if (strName == _T("part_selected_disabled_image")) {
-        SetPartSelectedStateImage(kControlStateDisabled, strValue);
-    }
-    else if (strName == _T("part_selected_fore_normal_image")) {
-        SetPartSelectedForeStateImage(kControlStateNormal, strValue);
-    }
-    else if (strName == _T("part_selected_fore_hot_image")) {
-        SetPartSelectedForeStateImage(kControlStateHot, strValue);
-    }
-    else if (strName == _T("part_selected_fore_pushed_image")) {
-        SetPartSelectedForeStateImage(kControlStatePushed, strValue);
-    }
-    else if (strName == _T("part_selected_fore_disabled_image")) {
-        SetPartSelectedForeStateImage(kControlStateDisabled, strValue);
-    }
-    else if ((strName == _T("selected_text_color")) || (strName == _T("selectedtextcolor"))) {
-        SetSelectedTextColor(strValue);
-    }
-    else if ((strName == _T("selected_normal_text_color")) || (strName == _T("selectednormaltextcolor"))) {
-        SetSelectedStateTextColor(kControlStateNormal, strValue);
-    }
-    else if ((strName == _T("selected_hot_text_color")) || (strName == _T("selectedhottextcolor"))) {
-        SetSelectedStateTextColor(kControlStateHot, strValue);
-    }
-    else if ((strName == _T("selected_pushed_text_color")) || (strName == _T("selectedpushedtextcolor"))) {
-        SetSelectedStateTextColor(kControlStatePushed, strValue);
-    }
-    else if ((strName == _T("selected_disabled_text_color")) || (strName == _T("selecteddisabledtextcolor"))) {
-        SetSelectedStateTextColor(kControlStateDisabled, strValue);
-    }
-    else if ((strName == _T("selected_normal_color")) || (strName == _T("selectednormalcolor"))) {
-        SetSelectedStateColor(kControlStateNormal, strValue);
-    }
-    else if ((strName == _T("selected_hot_color")) || (strName == _T("selectedhotcolor"))) {
-        SetSelectedStateColor(kControlStateHot, strValue);
-    }
-    else if ((strName == _T("selected_pushed_color")) || (strName == _T("selectedpushedcolor"))) {
-        SetSelectedStateColor(kControlStatePushed, strValue);
-    }
-    else if ((strName == _T("selected_disabled_color")) || (strName == _T("selecteddisabledcolor"))) {
-        SetSelectedStateColor(kControlStateDisabled, strValue);
-    }
-    else if (strName == _T("selected_normal_color_margin")) {
-        UiMargin rcMargin;
-        AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
-        SetSelectedStateColorMargin(kControlStateNormal, rcMargin, true);
-    }
-    else if (strName == _T("selected_hot_color_margin")) {
-        UiMargin rcMargin;
-        AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
-        SetSelectedStateColorMargin(kControlStateHot, rcMargin, true);
-    }
-    else if (strName == _T("selected_pushed_color_margin")) {
-        UiMargin rcMargin;
-        AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
-        SetSelectedStateColorMargin(kControlStatePushed, rcMargin, true);
-    }
-    else if (strName == _T("selected_disabled_color_margin")) {
-        UiMargin rcMargin;
-        AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
-        SetSelectedStateColorMargin(kControlStateDisabled, rcMargin, true);
-    }
-    else if (strName == _T("selected_normal_color_round")) {
-        UiSize szRound;
-        AttributeUtil::ParseSizeValue(strValue.c_str(), szRound);
-        SetSelectedStateColorRound(kControlStateNormal, szRound, true);
-    }
-    else if (strName == _T("selected_hot_color_round")) {
-        UiSize szRound;
-        AttributeUtil::ParseSizeValue(strValue.c_str(), szRound);
-        SetSelectedStateColorRound(kControlStateHot, szRound, true);
-    }
-    else if (strName == _T("selected_pushed_color_round")) {
-        UiSize szRound;
-        AttributeUtil::ParseSizeValue(strValue.c_str(), szRound);
-        SetSelectedStateColorRound(kControlStatePushed, szRound, true);
-    }
-    else if (strName == _T("selected_disabled_color_round")) {
-        UiSize szRound;
-        AttributeUtil::ParseSizeValue(strValue.c_str(), szRound);
-        SetSelectedStateColorRound(kControlStateDisabled, szRound, true);
-    }
-    else {
+    using detail::CheckBoxAttribute;
+    switch ((CheckBoxAttribute)detail::kCheckBoxAttributeTable.Find(strName)) {
+    case CheckBoxAttribute::kSelected:
+        {
+            Selected(strValue == _T("true"), true);
+        }
+        break;
+    case CheckBoxAttribute::kSwitchSelect:
+        {
+            Selected(!IsSelected());
+        }
+        break;
+    case CheckBoxAttribute::kSupportCheckMode:
+        {
+            SetSupportCheckMode(strValue == _T("true"));
+        }
+        break;
+    case CheckBoxAttribute::kAutoCheckSelect:
+        {
+            //设置当选择状态变化时，是否自动同步到勾选状态，保持勾选状态与选择状态一致(Select->Check)
+            SetAutoCheckSelect(strValue == _T("true"));
+        }
+        break;
+    case CheckBoxAttribute::kAutoSelectCheck:
+        {
+            //设置当勾选状态变化时，是否自动同步到选择状态，保持选择状态与勾选状态一致(Check -> Select)
+            SetAutoSelectCheck(strValue == _T("true"));
+        }
+        break;
+    case CheckBoxAttribute::kNormalFirst:
+        {
+            SetPaintNormalFirst(strValue == _T("true"));
+        }
+        break;
+    case CheckBoxAttribute::kSelectedNormalImage:
+        {
+            SetSelectedStateImage(kControlStateNormal, strValue);
+        }
+        break;
+    case CheckBoxAttribute::kSelectedHotImage:
+        {
+            SetSelectedStateImage(kControlStateHot, strValue);
+        }
+        break;
+    case CheckBoxAttribute::kSelectedPushedImage:
+        {
+            SetSelectedStateImage(kControlStatePushed, strValue);
+        }
+        break;
+    case CheckBoxAttribute::kSelectedDisabledImage:
+        {
+            SetSelectedStateImage(kControlStateDisabled, strValue);
+        }
+        break;
+    case CheckBoxAttribute::kSelectedForeNormalImage:
+        {
+            SetSelectedForeStateImage(kControlStateNormal, strValue);
+        }
+        break;
+    case CheckBoxAttribute::kSelectedForeHotImage:
+        {
+            SetSelectedForeStateImage(kControlStateHot, strValue);
+        }
+        break;
+    case CheckBoxAttribute::kSelectedForePushedImage:
+        {
+            SetSelectedForeStateImage(kControlStatePushed, strValue);
+        }
+        break;
+    case CheckBoxAttribute::kSelectedForeDisabledImage:
+        {
+            SetSelectedForeStateImage(kControlStateDisabled, strValue);
+        }
+        break;
+    case CheckBoxAttribute::kPartSelectedNormalImage:
+        {
+            SetPartSelectedStateImage(kControlStateNormal, strValue);
+        }
+        break;
+    case CheckBoxAttribute::kPartSelectedHotImage:
+        {
+            SetPartSelectedStateImage(kControlStateHot, strValue);
+        }
+        break;
+    case CheckBoxAttribute::kPartSelectedPushedImage:
+        {
+            SetPartSelectedStateImage(kControlStatePushed, strValue);
+        }
+        break;
+    case CheckBoxAttribute::kPartSelectedDisabledImage:
+        {
+            SetPartSelectedStateImage(kControlStateDisabled, strValue);
+        }
+        break;
+    case CheckBoxAttribute::kPartSelectedForeNormalImage:
+        {
+            SetPartSelectedForeStateImage(kControlStateNormal, strValue);
+        }
+        break;
+    case CheckBoxAttribute::kPartSelectedForeHotImage:
+        {
+            SetPartSelectedForeStateImage(kControlStateHot, strValue);
+        }
+        break;
+    case CheckBoxAttribute::kPartSelectedForePushedImage:
+        {
+            SetPartSelectedForeStateImage(kControlStatePushed, strValue);
+        }
+        break;
+    case CheckBoxAttribute::kPartSelectedForeDisabledImage:
+        {
+            SetPartSelectedForeStateImage(kControlStateDisabled, strValue);
+        }
+        break;
+    case CheckBoxAttribute::kSelectedTextColor:
+        {
+            SetSelectedTextColor(strValue);
+        }
+        break;
+    case CheckBoxAttribute::kSelectedNormalTextColor:
+        {
+            SetSelectedStateTextColor(kControlStateNormal, strValue);
+        }
+        break;
+    case CheckBoxAttribute::kSelectedHotTextColor:
+        {
+            SetSelectedStateTextColor(kControlStateHot, strValue);
+        }
+        break;
+    case CheckBoxAttribute::kSelectedPushedTextColor:
+        {
+            SetSelectedStateTextColor(kControlStatePushed, strValue);
+        }
+        break;
+    case CheckBoxAttribute::kSelectedDisabledTextColor:
+        {
+            SetSelectedStateTextColor(kControlStateDisabled, strValue);
+        }
+        break;
+    case CheckBoxAttribute::kSelectedNormalColor:
+        {
+            SetSelectedStateColor(kControlStateNormal, strValue);
+        }
+        break;
+    case CheckBoxAttribute::kSelectedHotColor:
+        {
+            SetSelectedStateColor(kControlStateHot, strValue);
+        }
+        break;
+    case CheckBoxAttribute::kSelectedPushedColor:
+        {
+            SetSelectedStateColor(kControlStatePushed, strValue);
+        }
+        break;
+    case CheckBoxAttribute::kSelectedDisabledColor:
+        {
+            SetSelectedStateColor(kControlStateDisabled, strValue);
+        }
+        break;
+    case CheckBoxAttribute::kSelectedNormalColorMargin:
+        {
+            UiMargin rcMargin;
+            AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
+            SetSelectedStateColorMargin(kControlStateNormal, rcMargin, true);
+        }
+        break;
+    case CheckBoxAttribute::kSelectedHotColorMargin:
+        {
+            UiMargin rcMargin;
+            AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
+            SetSelectedStateColorMargin(kControlStateHot, rcMargin, true);
+        }
+        break;
+    case CheckBoxAttribute::kSelectedPushedColorMargin:
+        {
+            UiMargin rcMargin;
+            AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
+            SetSelectedStateColorMargin(kControlStatePushed, rcMargin, true);
+        }
+        break;
+    case CheckBoxAttribute::kSelectedDisabledColorMargin:
+        {
+            UiMargin rcMargin;
+            AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
+            SetSelectedStateColorMargin(kControlStateDisabled, rcMargin, true);
+        }
+        break;
+    case CheckBoxAttribute::kSelectedNormalColorRound:
+        {
+            UiSize szRound;
+            AttributeUtil::ParseSizeValue(strValue.c_str(), szRound);
+            SetSelectedStateColorRound(kControlStateNormal, szRound, true);
+        }
+        break;
+    case CheckBoxAttribute::kSelectedHotColorRound:
+        {
+            UiSize szRound;
+            AttributeUtil::ParseSizeValue(strValue.c_str(), szRound);
+            SetSelectedStateColorRound(kControlStateHot, szRound, true);
+        }
+        break;
+    case CheckBoxAttribute::kSelectedPushedColorRound:
+        {
+            UiSize szRound;
+            AttributeUtil::ParseSizeValue(strValue.c_str(), szRound);
+            SetSelectedStateColorRound(kControlStatePushed, szRound, true);
+        }
+        break;
+    case CheckBoxAttribute::kSelectedDisabledColorRound:
+        {
+            UiSize szRound;
+            AttributeUtil::ParseSizeValue(strValue.c_str(), szRound);
+            SetSelectedStateColorRound(kControlStateDisabled, szRound, true);
+        }
+        break;
+    default:
         BaseClass::SetAttribute(strName, strValue);
+        break;
     }
 }
 
@@ -800,13 +1001,16 @@ bool CheckBoxTemplate<InheritType>::HasHotState()
 template<typename InheritType>
 DString CheckBoxTemplate<InheritType>::GetBorderColor(ControlStateType stateType) const
 {
-    if (this->IsSelected()) {
-        DString borderColor = BaseClass::GetBorderColor(kControlStatePushed);
-        if (!borderColor.empty()) {
-            return borderColor;
-        }
+    return BaseClass::GetBorderColor(CheckBoxTemplate<InheritType>::GetPaintBorderColorState(stateType));
+}
+
+template<typename InheritType>
+ControlStateType CheckBoxTemplate<InheritType>::GetPaintBorderColorState(ControlStateType stateType) const
+{
+    if (this->IsSelected() && this->HasBorderColor(kControlStatePushed)) {
+        return kControlStatePushed;
     }
-    return BaseClass::GetBorderColor(stateType);
+    return BaseClass::GetPaintBorderColorState(stateType);
 }
 
 template<typename InheritType>
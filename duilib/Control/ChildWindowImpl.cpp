@@ -101,6 +101,11 @@ void ChildWindowImpl::OnWindowAlphaChanged()
     // 空实现
 }
 
+void ChildWindowImpl::OnWindowInvalidate(const UiRect& /*rcItem*/)
+{
+    // 空实现
+}
+
 void ChildWindowImpl::OnWindowEnterFullscreen()
 {
     // 空实现
@@ -90,6 +90,10 @@ protected:
     */
     virtual void OnWindowAlphaChanged() override;
 
+    /** 窗口区域标记为需要重绘（在发出重绘消息前调用）
+    */
+    virtual void OnWindowInvalidate(const UiRect& rcItem) override;
+
     /** 进入全屏状态
     */
     virtual void OnWindowEnterFullscreen() override;
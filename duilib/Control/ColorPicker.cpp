@@ -642,7 +642,7 @@ private:
                 }
             }
             ASSERT(destColorIndex == (int32_t)(spBitmap->GetWidth() * spBitmap->GetHeight()));
-            m_spBitmap->UnLockPixelBits();
+            m_spBitmap->UnLockPixelBits(false);
         }
         spBitmap->UnLockPixelBits();
         return spBitmap;
@@ -533,29 +533,34 @@ bool Combo::CanPlaceCaptionBar() const
 
 DString Combo::GetBorderColor(ControlStateType stateType) const
 {
-    DString borderColor;
+    return BaseClass::GetBorderColor(Combo::GetPaintBorderColorState(stateType));
+}
+
+ControlStateType Combo::GetPaintBorderColorState(ControlStateType stateType) const
+{
+    bool bHot = false;
     if (m_pIconControl != nullptr) {
         if (m_pIconControl->IsFocused() || m_pIconControl->IsMouseFocused()) {
-            borderColor = BaseClass::GetBorderColor(kControlStateHot);
+            bHot = true;
         }
     }
-    if (borderColor.empty() && (m_pEditControl != nullptr)) {
+    if (!bHot && (m_pEditControl != nullptr)) {
         if (m_pEditControl->IsFocused() || m_pEditControl->IsMouseFocused()) {
-            borderColor = BaseClass::GetBorderColor(kControlStateHot);
+            bHot = true;
         }
     }
-    if (borderColor.empty() && (m_pButtonControl != nullptr)) {
+    if (!bHot && (m_pButtonControl != nullptr)) {
         if (m_pButtonControl->IsFocused() || m_pButtonControl->IsMouseFocused()) {
-            borderColor = BaseClass::GetBorderColor(kControlStateHot);
+            bHot = true;
         }
     }
-    if (borderColor.empty() && (m_pWindow != nullptr) && !m_pWindow->IsClosingWnd()) {
-        borderColor = BaseClass::GetBorderColor(kControlStateHot);
+    if (!bHot && (m_pWindow != nullptr) && !m_pWindow->IsClosingWnd()) {
+        bHot = true;
     }
-    if (borderColor.empty()) {
-        borderColor = BaseClass::GetBorderColor(stateType);
+    if (bHot && HasBorderColor(kControlStateHot)) {
+        return kControlStateHot;
     }
-    return borderColor;
+    return BaseClass::GetPaintBorderColorState(stateType);
 }
 
 void Combo::OnInit()
@@ -40,6 +40,7 @@ public:
 
 protected:
     virtual void OnInit() override;
+    virtual ControlStateType GetPaintBorderColorState(ControlStateType stateType) const override;
 
 public:
     /** Combo类型
@@ -520,24 +520,29 @@ bool ComboButton::CanPlaceCaptionBar() const
 
 DString ComboButton::GetBorderColor(ControlStateType stateType) const
 {
-    DString borderColor;
-    if (borderColor.empty() && (m_pLeftButton != nullptr)) {
+    return BaseClass::GetBorderColor(ComboButton::GetPaintBorderColorState(stateType));
+}
+
+ControlStateType ComboButton::GetPaintBorderColorState(ControlStateType stateType) const
+{
+    bool bHot = false;
+    if (m_pLeftButton != nullptr) {
         if (m_pLeftButton->IsFocused() || m_pLeftButton->IsMouseFocused() || m_pLeftButton->IsHotState()) {
-            borderColor = BaseClass::GetBorderColor(kControlStateHot);
+            bHot = true;
         }
     }
-    if (borderColor.empty() && (m_pRightButton != nullptr)) {
+    if (!bHot && (m_pRightButton != nullptr)) {
         if (m_pRightButton->IsFocused() || m_pRightButton->IsMouseFocused() || m_pRightButton->IsHotState()) {
-            borderColor = BaseClass::GetBorderColor(kControlStateHot);
+            bHot = true;
         }
     }
-    if (borderColor.empty() && (m_pWindow != nullptr) && !m_pWindow->IsClosingWnd()) {
-        borderColor = BaseClass::GetBorderColor(kControlStateHot);
+    if (!bHot && (m_pWindow != nullptr) && !m_pWindow->IsClosingWnd()) {
+        bHot = true;
     }
-    if (borderColor.empty()) {
-        borderColor = BaseClass::GetBorderColor(stateType);
+    if (bHot && HasBorderColor(kControlStateHot)) {
+        return kControlStateHot;
     }
-    return borderColor;
+    return BaseClass::GetPaintBorderColorState(stateType);
 }
 
 void ComboButton::OnInit()
@@ -130,6 +130,8 @@ public:
     void AttachWindowClose(const EventCallback& callback, EventCallbackID callbackID = 0) { AttachEvent(kEventWindowClose, callback, callbackID); }
 
 protected:
+    virtual ControlStateType GetPaintBorderColorState(ControlStateType stateType) const override;
+
     /** 显示下拉列表
     */
     virtual void ShowComboList();
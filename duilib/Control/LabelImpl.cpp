@@ -7,6 +7,7 @@
 #include "duilib/Core/StateColorMap.h"
 #include "duilib/Utils/StringConvert.h"
 #include "duilib/Utils/AttributeUtil.h"
+#include "duilib/Utils/AttributeTable.h"
 #include "duilib/Animation/AnimationManager.h"
 #include "duilib/Animation/AnimationPlayer.h"
 
@@ -46,161 +47,277 @@ LabelImpl::~LabelImpl()
     m_pTextDrawer.reset();
 }
 
+namespace
+{
+/** Label的属性ID（与属性名称一一对应，兼容的旧属性名称对应相同的属性ID）
+*/
+enum class LabelAttribute : int32_t
+{
+    kTextAlign,
+    kEndEllipsis,
+    kPathEllipsis,
+    kSingleLine,
+    kMultiLine,
+    kText,
+    kTextId,
+    kAutoTooltip,
+    kFont,
+    kNormalTextColor,
+    kHotTextColor,
+    kPushedTextColor,
+    kDisabledTextColor,
+    kTextPadding,
+    kReplaceNewline,
+    kSpacingMul,
+    kSpacingAdd,
+    kVerticalText,
+    kWordSpacing,
+    kUseFontHeight,
+    kAsciiRotate90,
+    kRichText
+};
+
+/** Label的属性表（属性名称 -> 属性ID）
+*/
+constexpr AttributeTableEntry kLabelAttributeEntries[] = {
+    {"text_align", (int32_t)LabelAttribute::kTextAlign},
+    {"end_ellipsis", (int32_t)LabelAttribute::kEndEllipsis},
+    {"endellipsis", (int32_t)LabelAttribute::kEndEllipsis},
+    {"path_ellipsis", (int32_t)LabelAttribute::kPathEllipsis},
+    {"pathellipsis", (int32_t)LabelAttribute::kPathEllipsis},
+    {"single_line", (int32_t)LabelAttribute::kSingleLine},
+    {"singleline", (int32_t)LabelAttribute::kSingleLine},
+    {"multi_line", (int32_t)LabelAttribute::kMultiLine},
+    {"multiline", (int32_t)LabelAttribute::kMultiLine},
+    {"text", (int32_t)LabelAttribute::kText},
+    {"text_id", (int32_t)LabelAttribute::kTextId},
+    {"textid", (int32_t)LabelAttribute::kTextId},
+    {"auto_tooltip", (int32_t)LabelAttribute::kAutoTooltip},
+    {"autotooltip", (int32_t)LabelAttribute::kAutoTooltip},
+    {"font", (int32_t)LabelAttribute::kFont},
+    {"normal_text_color", (int32_t)LabelAttribute::kNormalTextColor},
+    {"normaltextcolor", (int32_t)LabelAttribute::kNormalTextColor},
+    {"hot_text_color", (int32_t)LabelAttribute::kHotTextColor},
+    {"hottextcolor", (int32_t)LabelAttribute::kHotTextColor},
+    {"pushed_text_color", (int32_t)LabelAttribute::kPushedTextColor},
+    {"pushedtextcolor", (int32_t)LabelAttribute::kPushedTextColor},
+    {"disabled_text_color", (int32_t)LabelAttribute::kDisabledTextColor},
+    {"disabledtextcolor", (int32_t)LabelAttribute::kDisabledTextColor},
+    {"text_padding", (int32_t)LabelAttribute::kTextPadding},
+    {"textpadding", (int32_t)LabelAttribute::kTextPadding},
+    {"replace_newline", (int32_t)LabelAttribute::kReplaceNewline},
+    {"spacing_mul", (int32_t)LabelAttribute::kSpacingMul},
+    {"spacing_add", (int32_t)LabelAttribute::kSpacingAdd},
+    {"vertical_text", (int32_t)LabelAttribute::kVerticalText},
+    {"word_spacing", (int32_t)LabelAttribute::kWordSpacing},
+    {"use_font_height", (int32_t)LabelAttribute::kUseFontHeight},
+    {"ascii_rotate_90", (int32_t)LabelAttribute::kAsciiRotate90},
+    {"rich_text", (int32_t)LabelAttribute::kRichText},
+};
+constexpr AttributeTable kLabelAttributeTable(kLabelAttributeEntries);
+static_assert(kLabelAttributeTable.IsValid(), "Label attribute table is invalid!");
+}
+
 bool LabelImpl::OnSetAttribute(const DString& strName, const DString& strValue)
 {
-    if (strName == _T("text_align")) {
-        bool bHCenter = false;        
-        size_t centerPos = strValue.find(_T("center"));
-        if (centerPos != DString::npos) {
-            //"center"这个属性有歧义，保留以保持兼容性，新的属性是"hcenter"
-            bHCenter = true;
-            size_t vCenterPos = strValue.find(_T("vcenter"));
-            if (vCenterPos != DString::npos) {
-                if ((vCenterPos + 1) == centerPos) {
-                    bHCenter = false;
+    switch ((LabelAttribute)kLabelAttributeTable.Find(strName)) {
+    case LabelAttribute::kTextAlign:
+        {
+            bool bHCenter = false;        
+            size_t centerPos = strValue.find(_T("center"));
+            if (centerPos != DString::npos) {
+                //"center"这个属性有歧义，保留以保持兼容性，新的属性是"hcenter"
+                bHCenter = true;
+                size_t vCenterPos = strValue.find(_T("vcenter"));
+                if (vCenterPos != DString::npos) {
+                    if ((vCenterPos + 1) == centerPos) {
+                        bHCenter = false;
+                    }
                 }
             }
-        }
 
-        //水平对齐方式
-        if (strValue.find(_T("hcenter")) != DString::npos) {            
-            bHCenter = true;
+            //水平对齐方式
+            if (strValue.find(_T("hcenter")) != DString::npos) {            
+                bHCenter = true;
+            }
+            if (bHCenter) {
+                //水平对齐：居中
+                m_uTextStyle &= ~TEXT_HALIGN_ALL;
+                m_uTextStyle |= TEXT_HCENTER;
+            }
+            else if (strValue.find(_T("right")) != DString::npos) {
+                //水平对齐：靠右
+                m_uTextStyle &= ~TEXT_HALIGN_ALL;
+                m_uTextStyle |= TEXT_RIGHT;
+            }
+            else if (strValue.find(_T("left")) != DString::npos) {
+                //水平对齐：靠左
+                m_uTextStyle &= ~TEXT_HALIGN_ALL;
+                m_uTextStyle |= TEXT_LEFT;
+            }
+            else if (strValue.find(_T("hjustify")) != DString::npos) {
+                //水平对齐：两端对齐
+                m_uTextStyle &= ~TEXT_HALIGN_ALL;
+                m_uTextStyle |= TEXT_HJUSTIFY;
+            }
+
+            //垂直对齐方式
+            if (strValue.find(_T("top")) != DString::npos) {
+                //垂直对齐：靠上
+                m_uTextStyle &= ~TEXT_VALIGN_ALL;
+                m_uTextStyle |= TEXT_TOP;
+            }
+            else if (strValue.find(_T("vcenter")) != DString::npos) {
+                //垂直对齐：居中
+                m_uTextStyle &= ~TEXT_VALIGN_ALL;
+                m_uTextStyle |= TEXT_VCENTER;
+            }
+            else if (strValue.find(_T("bottom")) != DString::npos) {
+                //垂直对齐：靠下
+                m_uTextStyle &= ~TEXT_VALIGN_ALL;
+                m_uTextStyle |= TEXT_BOTTOM;
+            }
+            else if (strValue.find(_T("vjustify")) != DString::npos) {
+                //垂直对齐：靠下
+                m_uTextStyle &= ~TEXT_VALIGN_ALL;
+                m_uTextStyle |= TEXT_VJUSTIFY;
+            }
         }
-        if (bHCenter) {
-            //水平对齐：居中
-            m_uTextStyle &= ~TEXT_HALIGN_ALL;
-            m_uTextStyle |= TEXT_HCENTER;
+        break;
+    case LabelAttribute::kEndEllipsis:
+        {
+            if (strValue == _T("true")) {
+                m_uTextStyle |= TEXT_END_ELLIPSIS;
+            }
+            else {
+                m_uTextStyle &= ~TEXT_END_ELLIPSIS;
+            }
         }
-        else if (strValue.find(_T("right")) != DString::npos) {
-            //水平对齐：靠右
-            m_uTextStyle &= ~TEXT_HALIGN_ALL;
-            m_uTextStyle |= TEXT_RIGHT;
+        break;
+    case LabelAttribute::kPathEllipsis:
+        {
+            if (strValue == _T("true")) {
+                m_uTextStyle |= TEXT_PATH_ELLIPSIS;
+            }
+            else {
+                m_uTextStyle &= ~TEXT_PATH_ELLIPSIS;
+            }
         }
-        else if (strValue.find(_T("left")) != DString::npos) {
-            //水平对齐：靠左
-            m_uTextStyle &= ~TEXT_HALIGN_ALL;
-            m_uTextStyle |= TEXT_LEFT;
+        break;
+    case LabelAttribute::kSingleLine:
+        {
+            SetSingleLine(strValue == _T("true"));
         }
-        else if (strValue.find(_T("hjustify")) != DString::npos) {
-            //水平对齐：两端对齐
-            m_uTextStyle &= ~TEXT_HALIGN_ALL;
-            m_uTextStyle |= TEXT_HJUSTIFY;
+        break;
+    case LabelAttribute::kMultiLine:
+        {
+            SetSingleLine(strValue != _T("true"));
         }
-
-        //垂直对齐方式
-        if (strValue.find(_T("top")) != DString::npos) {
-            //垂直对齐：靠上
-            m_uTextStyle &= ~TEXT_VALIGN_ALL;
-            m_uTextStyle |= TEXT_TOP;
+        break;
+    case LabelAttribute::kText:
+        {
+            SetText(strValue);
         }
-        else if (strValue.find(_T("vcenter")) != DString::npos) {
-            //垂直对齐：居中
-            m_uTextStyle &= ~TEXT_VALIGN_ALL;
-            m_uTextStyle |= TEXT_VCENTER;
+        break;
+    case LabelAttribute::kTextId:
+        {
+            SetTextId(strValue);
         }
-        else if (strValue.find(_T("bottom")) != DString::npos) {
-            //垂直对齐：靠下
-            m_uTextStyle &= ~TEXT_VALIGN_ALL;
-            m_uTextStyle |= TEXT_BOTTOM;
+        break;
+    case LabelAttribute::kAutoTooltip:
+        {
+            SetAutoShowToolTipEnabled(strValue == _T("true"));
         }
-        else if (strValue.find(_T("vjustify")) != DString::npos) {
-            //垂直对齐：靠下
-            m_uTextStyle &= ~TEXT_VALIGN_ALL;
-            m_uTextStyle |= TEXT_VJUSTIFY;
+        break;
+    case LabelAttribute::kFont:
+        {
+            SetFontId(strValue);
         }
-    }
-    else if ((strName == _T("end_ellipsis")) || (strName == _T("endellipsis"))) {
-        if (strValue == _T("true")) {
-            m_uTextStyle |= TEXT_END_ELLIPSIS;
+        break;
+    case LabelAttribute::kNormalTextColor:
+        {
+            SetStateTextColor(kControlStateNormal, strValue);
         }
-        else {
-            m_uTextStyle &= ~TEXT_END_ELLIPSIS;
+        break;
+    case LabelAttribute::kHotTextColor:
+        {
+            SetStateTextColor(kControlStateHot, strValue);
         }
-    }
-    else if ((strName == _T("path_ellipsis")) || (strName == _T("pathellipsis"))) {
-        if (strValue == _T("true")) {
-            m_uTextStyle |= TEXT_PATH_ELLIPSIS;
+        break;
+    case LabelAttribute::kPushedTextColor:
+        {
+            SetStateTextColor(kControlStatePushed, strValue);
         }
-        else {
-            m_uTextStyle &= ~TEXT_PATH_ELLIPSIS;
+        break;
+    case LabelAttribute::kDisabledTextColor:
+        {
+            SetStateTextColor(kControlStateDisabled, strValue);
         }
-    }
-    else if ((strName == _T("single_line")) || (strName == _T("singleline"))) {
-        SetSingleLine(strValue == _T("true"));
-    }
-    else if ((strName == _T("multi_line")) || (strName == _T("multiline"))) {
-        SetSingleLine(strValue != _T("true"));
-    }
-    else if (strName == _T("text")) {
-        SetText(strValue);
-    }
-    else if ((strName == _T("text_id")) || (strName == _T("textid"))){
-        SetTextId(strValue);
-    }
-    else if ((strName == _T("auto_tooltip")) || (strName == _T("autotooltip"))) {
-        SetAutoShowToolTipEnabled(strValue == _T("true"));
-    }
-    else if (strName == _T("font")) {
-        SetFontId(strValue);
-    }
-    else if ((strName == _T("normal_text_color")) || (strName == _T("normaltextcolor"))) {
-        SetStateTextColor(kControlStateNormal, strValue);
-    }
-    else if ((strName == _T("hot_text_color")) || (strName == _T("hottextcolor"))) {
-        SetStateTextColor(kControlStateHot, strValue);
-    }
-    else if ((strName == _T("pushed_text_color")) || (strName == _T("pushedtextcolor"))) {
-        SetStateTextColor(kControlStatePushed, strValue);
-    }
-    else if ((strName == _T("disabled_text_color")) || (strName == _T("disabledtextcolor"))) {
-        SetStateTextColor(kControlStateDisabled, strValue);
-    }
-    else if ((strName == _T("text_padding")) || (strName == _T("textpadding"))) {
-        UiPadding rcTextPadding;
-        AttributeUtil::ParsePaddingValue(strValue.c_str(), rcTextPadding);
-        SetTextPadding(rcTextPadding, true);
-    }
-    else if (strName == _T("replace_newline")) {
-        // 设置是否替换换行符(将字符串"\\n"替换为换行符"\n"
-        SetReplaceNewline(strValue == _T("true"));
-    }
-    else if (strName == _T("spacing_mul")) {
-        // 设置行间距倍数
-        float mul = 1.0f;
-        float add = 0;
-        GetLineSpacing(&mul, &add);
-        mul = StringUtil::StringToFloat(strValue.c_str(), nullptr);
-        SetLineSpacing(mul, add, false);
-    }
-    else if (strName == _T("spacing_add")) {
-        // 设置行间距固定的附加像素值
-        float mul = 1.0f;
-        float add = 0;
-        GetLineSpacing(&mul, &add);
-        add = StringUtil::StringToFloat(strValue.c_str(), nullptr);
-        SetLineSpacing(mul, add, true);
-    }
-    else if (strName == _T("vertical_text")) {
-        // 设置是否为纵向文本
-        SetVerticalText(strValue == _T("true"));
-    }
-    else if (strName == _T("word_spacing")) {
-        // 设置两个相邻的字符之间的间隔（像素）
-        SetWordSpacing(StringUtil::StringToFloat(strValue.c_str(), nullptr), true);
-    }
-    else if (strName == _T("use_font_height")) {
-        // 设置当纵向绘制文本时，使用字体的默认高度，而不是每个字体的高度（显示时所有字体等高）
-        SetUseFontHeight(strValue == _T("true"));
-    }
-    else if (strName == _T("ascii_rotate_90")) {
-        // 设置当纵向绘制文本时，对于字母数字等，顺时针旋转90度显示
-        SetRotate90ForAscii(strValue == _T("true"));
-    }
-    else if (strName == _T("rich_text")) {
-        // 设置文本内容是否为RichText
-        SetRichText(strValue == _T("true"));
-    }
-    else {
+        break;
+    case LabelAttribute::kTextPadding:
+        {
+            UiPadding rcTextPadding;
+            AttributeUtil::ParsePaddingValue(strValue.c_str(), rcTextPadding);
+            SetTextPadding(rcTextPadding, true);
+        }
+        break;
+    case LabelAttribute::kReplaceNewline:
+        {
+            // 设置是否替换换行符(将字符串"\\n"替换为换行符"\n"
+            SetReplaceNewline(strValue == _T("true"));
+        }
+        break;
+    case LabelAttribute::kSpacingMul:
+        {
+            // 设置行间距倍数
+            float mul = 1.0f;
+            float add = 0;
+            GetLineSpacing(&mul, &add);
+            mul = StringUtil::StringToFloat(strValue.c_str(), nullptr);
+            SetLineSpacing(mul, add, false);
+        }
+        break;
+    case LabelAttribute::kSpacingAdd:
+        {
+            // 设置行间距固定的附加像素值
+            float mul = 1.0f;
+            float add = 0;
+            GetLineSpacing(&mul, &add);
+            add = StringUtil::StringToFloat(strValue.c_str(), nullptr);
+            SetLineSpacing(mul, add, true);
+        }
+        break;
+    case LabelAttribute::kVerticalText:
+        {
+            // 设置是否为纵向文本
+            SetVerticalText(strValue == _T("true"));
+        }
+        break;
+    case LabelAttribute::kWordSpacing:
+        {
+            // 设置两个相邻的字符之间的间隔（像素）
+            SetWordSpacing(StringUtil::StringToFloat(strValue.c_str(), nullptr), true);
+        }
+        break;
+    case LabelAttribute::kUseFontHeight:
+        {
+            // 设置当纵向绘制文本时，使用字体的默认高度，而不是每个字体的高度（显示时所有字体等高）
+            SetUseFontHeight(strValue == _T("true"));
+        }
+        break;
+    case LabelAttribute::kAsciiRotate90:
+        {
+            // 设置当纵向绘制文本时，对于字母数字等，顺时针旋转90度显示
+            SetRotate90ForAscii(strValue == _T("true"));
+        }
+        break;
+    case LabelAttribute::kRichText:
+        {
+            // 设置文本内容是否为RichText
+            SetRichText(strValue == _T("true"));
+        }
+        break;
+    default:
         return false;
     }
     return true;
@@ -729,26 +846,24 @@ void LabelImpl::DoPaintText(const UiRect& rc, IRender* pRender)
         return;
     }
 
-    ControlStateType stateType = m_pOwner->GetState();
-    UiColor dwClrColor = m_pOwner->GetUiColor(GetPaintStateTextColor(m_pOwner->GetState(), stateType));
+    ControlStateType stateType = GetPaintStateType(m_pOwner->GetState());
+    UiColor dwClrColor = GetStateUiTextColor(stateType);
 
     DrawStringParam drawParam = GetDrawParam();//绘制参数
     drawParam.textRect = rc;
 
     if (m_pOwner->GetAnimationManager().GetAnimationPlayer(AnimationType::kAnimationHot)) {
         if ((stateType == kControlStateNormal || stateType == kControlStateHot) && 
-            !GetStateTextColor(kControlStateHot).empty()) {
-            DString clrColor = GetStateTextColor(kControlStateNormal);
-            if (!clrColor.empty()) {                
-                drawParam.dwTextColor = m_pOwner->GetUiColor(clrColor);
+            HasStateTextColor(kControlStateHot)) {
+            if (HasStateTextColor(kControlStateNormal)) {
+                drawParam.dwTextColor = GetStateUiTextColor(kControlStateNormal);
                 drawParam.uFade = 255;
                 m_pTextDrawer->DrawString(pRender, textValue, drawParam, GetFontId(), IsRichText(), m_pOwner);
             }
 
             if (m_pOwner->GetHotAlpha() > 0) {
-                DString textColor = GetStateTextColor(kControlStateHot);
-                if (!textColor.empty()) {
-                    drawParam.dwTextColor = m_pOwner->GetUiColor(textColor);
+                if (HasStateTextColor(kControlStateHot)) {
+                    drawParam.dwTextColor = GetStateUiTextColor(kControlStateHot);
                     drawParam.uFade = (uint8_t)m_pOwner->GetHotAlpha();
                     m_pTextDrawer->DrawString(pRender, textValue, drawParam, GetFontId(), IsRichText(), m_pOwner);
                 }
@@ -821,17 +936,55 @@ void LabelImpl::SetStateTextColor(ControlStateType stateType, const DString& dwT
 
 DString LabelImpl::GetPaintStateTextColor(ControlStateType buttonStateType, ControlStateType& stateType)
 {
-    stateType = buttonStateType;
-    if (stateType == kControlStatePushed && GetStateTextColor(kControlStatePushed).empty()) {
+    stateType = GetPaintStateType(buttonStateType);
+    return GetStateTextColor(stateType);
+}
+
+ControlStateType LabelImpl::GetPaintStateType(ControlStateType buttonStateType) const
+{
+    ControlStateType stateType = buttonStateType;
+    if (stateType == kControlStatePushed && !HasStateTextColor(kControlStatePushed)) {
         stateType = kControlStateHot;
     }
-    if (stateType == kControlStateHot && GetStateTextColor(kControlStateHot).empty()) {
+    if (stateType == kControlStateHot && !HasStateTextColor(kControlStateHot)) {
         stateType = kControlStateNormal;
     }
-    if (stateType == kControlStateDisabled && GetStateTextColor(kControlStateDisabled).empty()) {
+    if (stateType == kControlStateDisabled && !HasStateTextColor(kControlStateDisabled)) {
         stateType = kControlStateNormal;
     }
-    return GetStateTextColor(stateType);
+    return stateType;
+}
+
+bool LabelImpl::HasStateTextColor(ControlStateType stateType) const
+{
+    if ((m_pTextColorMap != nullptr) && m_pTextColorMap->HasStateColor(stateType)) {
+        return true;
+    }
+    if (stateType == kControlStateNormal) {
+        return !GlobalManager::Instance().Color().GetDefaultTextColor().empty();
+    }
+    if (stateType == kControlStateDisabled) {
+        return !GlobalManager::Instance().Color().GetDefaultDisabledTextColor().empty();
+    }
+    return false;
+}
+
+UiColor LabelImpl::GetStateUiTextColor(ControlStateType stateType) const
+{
+    if ((m_pTextColorMap != nullptr) && m_pTextColorMap->HasStateColor(stateType)) {
+        return m_pTextColorMap->GetStateUiColor(stateType);
+    }
+    //未设置文本颜色时，使用默认的文本颜色
+    if ((stateType != kControlStateNormal) && (stateType != kControlStateDisabled)) {
+        return UiColor();
+    }
+    const DString& defaultColor = (stateType == kControlStateNormal) ?
+                                  GlobalManager::Instance().Color().GetDefaultTextColor() :
+                                  GlobalManager::Instance().Color().GetDefaultDisabledTextColor();
+    if (m_defaultTextColor != defaultColor) {
+        m_defaultTextColor = defaultColor;
+    }
+    return m_defaultTextColor.GetColor(m_pOwner);
 }
 
 DString LabelImpl::GetFontId() const
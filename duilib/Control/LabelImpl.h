@@ -148,6 +148,19 @@ public:
      */
     DString GetPaintStateTextColor(ControlStateType buttonStateType, ControlStateType& stateType);
 
+    /** 获取指定状态下实际被渲染文本颜色的状态（未设置该状态的文本颜色时，按按下->悬停->正常、禁用->正常的顺序回退）
+     * @param [in] buttonStateType 控件的状态
+     */
+    ControlStateType GetPaintStateType(ControlStateType buttonStateType) const;
+
+    /** 是否设置了指定状态下的文本颜色（包含默认的文本颜色）
+     */
+    bool HasStateTextColor(ControlStateType stateType) const;
+
+    /** 获取指定状态下的文本颜色值（预先解析的颜色值，不需要每次绘制时查找颜色表）
+     */
+    UiColor GetStateUiTextColor(ControlStateType stateType) const;
+
     /** 获取当前字体ID
      * @return 返回字体ID，该字体ID在 global.xml 中标识
      */
@@ -305,6 +318,9 @@ private:
     //各个状态（默认/悬停/按下/禁用）的文本颜色映射表
     std::unique_ptr<StateColorMap> m_pTextColorMap;
 
+    //未设置文本颜色时，使用的默认文本颜色（预先解析的颜色值）
+    mutable UiNamedColor m_defaultTextColor;
+
     //文本内边距
     UiPadding16 m_rcTextPadding;
 
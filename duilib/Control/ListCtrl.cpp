@@ -5,6 +5,7 @@
 #include "duilib/Control/RichEdit.h"
 #include "duilib/Core/GlobalManager.h"
 #include "duilib/Core/Keyboard.h"
+#include "duilib/Utils/AttributeTable.h"
 #include <set>
 
 namespace ui
@@ -107,114 +108,260 @@ ImageListPtr ListCtrl::GetImageList(ListCtrlType type) const
     }
 }
 
+namespace
+{
+/** ListCtrl的属性ID（与属性名称一一对应，兼容的旧属性名称对应相同的属性ID）
+*/
+enum class ListCtrlAttribute : int32_t
+{
+    kHeaderClass,
+    kHeaderItemClass,
+    kHeaderSplitBoxClass,
+    kHeaderSplitControlClass,
+    kEnableHeaderDragOrder,
+    kCheckBoxClass,
+    kDataItemClass,
+    kDataSubItemClass,
+    kRowGridLineWidth,
+    kRowGridLineColor,
+    kColumnGridLineWidth,
+    kColumnGridLineColor,
+    kReportViewClass,
+    kHeaderHeight,
+    kDataItemHeight,
+    kShowHeader,
+    kMultiSelect,
+    kEnableColumnWidthAuto,
+    kAutoCheckSelect,
+    kShowHeaderCheckbox,
+    kShowDataItemCheckbox,
+    kType,
+    kIconViewClass,
+    kIconViewItemClass,
+    kIconViewItemImageClass,
+    kIconViewItemLabelClass,
+    kListViewClass,
+    kListViewItemClass,
+    kListViewItemImageClass,
+    kListViewItemLabelClass,
+    kEnableItemEdit,
+    kListCtrlRicheditClass
+};
+
+/** ListCtrl的属性表（属性名称 -> 属性ID）
+*/
+constexpr AttributeTableEntry kListCtrlAttributeEntries[] = {
+    {"header_class", (int32_t)ListCtrlAttribute::kHeaderClass},
+    {"header_item_class", (int32_t)ListCtrlAttribute::kHeaderItemClass},
+    {"header_split_box_class", (int32_t)ListCtrlAttribute::kHeaderSplitBoxClass},
+    {"header_split_control_class", (int32_t)ListCtrlAttribute::kHeaderSplitControlClass},
+    {"enable_header_drag_order", (int32_t)ListCtrlAttribute::kEnableHeaderDragOrder},
+    {"check_box_class", (int32_t)ListCtrlAttribute::kCheckBoxClass},
+    {"data_item_class", (int32_t)ListCtrlAttribute::kDataItemClass},
+    {"data_sub_item_class", (int32_t)ListCtrlAttribute::kDataSubItemClass},
+    {"row_grid_line_width", (int32_t)ListCtrlAttribute::kRowGridLineWidth},
+    {"row_grid_line_color", (int32_t)ListCtrlAttribute::kRowGridLineColor},
+    {"column_grid_line_width", (int32_t)ListCtrlAttribute::kColumnGridLineWidth},
+    {"column_grid_line_color", (int32_t)ListCtrlAttribute::kColumnGridLineColor},
+    {"report_view_class", (int32_t)ListCtrlAttribute::kReportViewClass},
+    {"header_height", (int32_t)ListCtrlAttribute::kHeaderHeight},
+    {"data_item_height", (int32_t)ListCtrlAttribute::kDataItemHeight},
+    {"show_header", (int32_t)ListCtrlAttribute::kShowHeader},
+    {"multi_select", (int32_t)ListCtrlAttribute::kMultiSelect},
+    {"enable_column_width_auto", (int32_t)ListCtrlAttribute::kEnableColumnWidthAuto},
+    {"auto_check_select", (int32_t)ListCtrlAttribute::kAutoCheckSelect},
+    {"show_header_checkbox", (int32_t)ListCtrlAttribute::kShowHeaderCheckbox},
+    {"show_data_item_checkbox", (int32_t)ListCtrlAttribute::kShowDataItemCheckbox},
+    {"type", (int32_t)ListCtrlAttribute::kType},
+    {"icon_view_class", (int32_t)ListCtrlAttribute::kIconViewClass},
+    {"icon_view_item_class", (int32_t)ListCtrlAttribute::kIconViewItemClass},
+    {"icon_view_item_image_class", (int32_t)ListCtrlAttribute::kIconViewItemImageClass},
+    {"icon_view_item_label_class", (int32_t)ListCtrlAttribute::kIconViewItemLabelClass},
+    {"list_view_class", (int32_t)ListCtrlAttribute::kListViewClass},
+    {"list_view_item_class", (int32_t)ListCtrlAttribute::kListViewItemClass},
+    {"list_view_item_image_class", (int32_t)ListCtrlAttribute::kListViewItemImageClass},
+    {"list_view_item_label_class", (int32_t)ListCtrlAttribute::kListViewItemLabelClass},
+    {"enable_item_edit", (int32_t)ListCtrlAttribute::kEnableItemEdit},
+    {"list_ctrl_richedit_class", (int32_t)ListCtrlAttribute::kListCtrlRicheditClass},
+};
+constexpr AttributeTable kListCtrlAttributeTable(kListCtrlAttributeEntries);
+static_assert(kListCtrlAttributeTable.IsValid(), "ListCtrl attribute table is invalid!");
+}
+
 void ListCtrl::SetAttribute(const DString& strName, const DString& strValue)
 {
-    if (strName == _T("header_class")) {
-        SetHeaderClass(strValue);
-    }
-    else if (strName == _T("header_item_class")) {
-        SetHeaderItemClass(strValue);
-    }
-    else if (strName == _T("header_split_box_class")) {
-        SetHeaderSplitBoxClass(strValue);
-    }
-    else if (strName == _T("header_split_control_class")) {
-        SetHeaderSplitControlClass(strValue);
-    }
-    else if (strName == _T("enable_header_drag_order")) {
-        SetEnableHeaderDragOrder(strValue == _T("true"));
-    }
-    else if (strName == _T("check_box_class")) {
-        SetCheckBoxClass(strValue);
-    }
-    else if (strName == _T("data_item_class")) {
-        SetDataItemClass(strValue);
-    }
-    else if (strName == _T("data_sub_item_class")) {
-        SetDataSubItemClass(strValue);
-    }
-    else if (strName == _T("row_grid_line_width")) {
-        SetRowGridLineWidth(StringUtil::StringToInt32(strValue), true);
-    }
-    else if (strName == _T("row_grid_line_color")) {
-        SetRowGridLineColor(strValue);
-    }
-    else if (strName == _T("column_grid_line_width")) {
-        SetColumnGridLineWidth(StringUtil::StringToInt32(strValue), true);
-    }
-    else if (strName == _T("column_grid_line_color")) {
-        SetColumnGridLineColor(strValue);
-    }
-    else if (strName == _T("report_view_class")) {
-        SetReportViewClass(strValue);
-    }
-    else if (strName == _T("header_height")) {
-        SetHeaderHeight(StringUtil::StringToInt32(strValue), true);
-    }
-    else if (strName == _T("data_item_height")) {
-        SetDataItemHeight(StringUtil::StringToInt32(strValue), true);
-    }
-    else if (strName == _T("show_header")) {
-        SetHeaderVisible(strValue == _T("true"));
-    }
-    else if (strName == _T("multi_select")) {
-        SetMultiSelect(strValue == _T("true"));
-    }
-    else if (strName == _T("enable_column_width_auto")) {
-        SetEnableColumnWidthAuto(strValue == _T("true"));
-    }
-    else if (strName == _T("auto_check_select")) {
-        SetAutoCheckSelect(strValue == _T("true"));
-    }
-    else if (strName == _T("show_header_checkbox")) {
-        SetHeaderShowCheckBox(strValue == _T("true"));
-    }
-    else if (strName == _T("show_data_item_checkbox")) {
-        SetDataItemShowCheckBox(strValue == _T("true"));
-    }
-    else if (strName == _T("type")) {
-        if (strValue == _T("report")) {
-            SetListCtrlType(ListCtrlType::Report);
-        }
-        else if (strValue == _T("icon")) {
-            SetListCtrlType(ListCtrlType::Icon);
-        }
-        else if (strValue == _T("list")) {
-            SetListCtrlType(ListCtrlType::List);
+    switch ((ListCtrlAttribute)kListCtrlAttributeTable.Find(strName)) {
+    case ListCtrlAttribute::kHeaderClass:
+        {
+            SetHeaderClass(strValue);
+        }
+        break;
+    case ListCtrlAttribute::kHeaderItemClass:
+        {
+            SetHeaderItemClass(strValue);
+        }
+        break;
+    case ListCtrlAttribute::kHeaderSplitBoxClass:
+        {
+            SetHeaderSplitBoxClass(strValue);
+        }
+        break;
+    case ListCtrlAttribute::kHeaderSplitControlClass:
+        {
+            SetHeaderSplitControlClass(strValue);
+        }
+        break;
+    case ListCtrlAttribute::kEnableHeaderDragOrder:
+        {
+            SetEnableHeaderDragOrder(strValue == _T("true"));
+        }
+        break;
+    case ListCtrlAttribute::kCheckBoxClass:
+        {
+            SetCheckBoxClass(strValue);
+        }
+        break;
+    case ListCtrlAttribute::kDataItemClass:
+        {
+            SetDataItemClass(strValue);
+        }
+        break;
+    case ListCtrlAttribute::kDataSubItemClass:
+        {
+            SetDataSubItemClass(strValue);
+        }
+        break;
+    case ListCtrlAttribute::kRowGridLineWidth:
+        {
+            SetRowGridLineWidth(StringUtil::StringToInt32(strValue), true);
+        }
+        break;
+    case ListCtrlAttribute::kRowGridLineColor:
+        {
+            SetRowGridLineColor(strValue);
+        }
+        break;
+    case ListCtrlAttribute::kColumnGridLineWidth:
+        {
+            SetColumnGridLineWidth(StringUtil::StringToInt32(strValue), true);
+        }
+        break;
+    case ListCtrlAttribute::kColumnGridLineColor:
+        {
+            SetColumnGridLineColor(strValue);
+        }
+        break;
+    case ListCtrlAttribute::kReportViewClass:
+        {
+            SetReportViewClass(strValue);
+        }
+        break;
+    case ListCtrlAttribute::kHeaderHeight:
+        {
+            SetHeaderHeight(StringUtil::StringToInt32(strValue), true);
+        }
+        break;
+    case ListCtrlAttribute::kDataItemHeight:
+        {
+            SetDataItemHeight(StringUtil::StringToInt32(strValue), true);
+        }
+        break;
+    case ListCtrlAttribute::kShowHeader:
+        {
+            SetHeaderVisible(strValue == _T("true"));
+        }
+        break;
+    case ListCtrlAttribute::kMultiSelect:
+        {
+            SetMultiSelect(strValue == _T("true"));
+        }
+        break;
+    case ListCtrlAttribute::kEnableColumnWidthAuto:
+        {
+            SetEnableColumnWidthAuto(strValue == _T("true"));
+        }
+        break;
+    case ListCtrlAttribute::kAutoCheckSelect:
+        {
+            SetAutoCheckSelect(strValue == _T("true"));
+        }
+        break;
+    case ListCtrlAttribute::kShowHeaderCheckbox:
+        {
+            SetHeaderShowCheckBox(strValue == _T("true"));
+        }
+        break;
+    case ListCtrlAttribute::kShowDataItemCheckbox:
+        {
+            SetDataItemShowCheckBox(strValue == _T("true"));
+        }
+        break;
+    case ListCtrlAttribute::kType:
+        {
+            if (strValue == _T("report")) {
+                SetListCtrlType(ListCtrlType::Report);
+            }
+            else if (strValue == _T("icon")) {
+                SetListCtrlType(ListCtrlType::Icon);
+            }
+            else if (strValue == _T("list")) {
+                SetListCtrlType(ListCtrlType::List);
+            }
         }
-    }
-    else if (strName == _T("icon_view_class")) {
-        SetIconViewClass(strValue);
-    }
-    else if (strName == _T("icon_view_item_class")) {
-        SetIconViewItemClass(strValue);
-    }
-    else if (strName == _T("icon_view_item_image_class")) {
-        SetIconViewItemImageClass(strValue);
-    }
-    else if (strName == _T("icon_view_item_label_class")) {
-        SetIconViewItemLabelClass(strValue);
-    }
-    else if (strName == _T("list_view_class")) {
-        SetListViewClass(strValue);
-    }
-    else if (strName == _T("list_view_item_class")) {
-        SetListViewItemClass(strValue);
-    }
-    else if (strName == _T("list_view_item_image_class")) {
-        SetListViewItemImageClass(strValue);
-    }
-    else if (strName == _T("list_view_item_label_class")) {
-        SetListViewItemLabelClass(strValue);
-    }
-    else if (strName == _T("enable_item_edit")) {
-        SetEnableItemEdit(strValue == _T("true"));
-    }
-    else if (strName == _T("list_ctrl_richedit_class")) {
-        SetRichEditClass(strValue);
-    }
-    else {
+        break;
+    case ListCtrlAttribute::kIconViewClass:
+        {
+            SetIconViewClass(strValue);
+        }
+        break;
+    case ListCtrlAttribute::kIconViewItemClass:
+        {
+            SetIconViewItemClass(strValue);
+        }
+        break;
+    case ListCtrlAttribute::kIconViewItemImageClass:
+        {
+            SetIconViewItemImageClass(strValue);
+        }
+        break;
+    case ListCtrlAttribute::kIconViewItemLabelClass:
+        {
+            SetIconViewItemLabelClass(strValue);
+        }
+        break;
+    case ListCtrlAttribute::kListViewClass:
+        {
+            SetListViewClass(strValue);
+        }
+        break;
+    case ListCtrlAttribute::kListViewItemClass:
+        {
+            SetListViewItemClass(strValue);
+        }
+        break;
+    case ListCtrlAttribute::kListViewItemImageClass:
+        {
+            SetListViewItemImageClass(strValue);
+        }
+        break;
+    case ListCtrlAttribute::kListViewItemLabelClass:
+        {
+            SetListViewItemLabelClass(strValue);
+        }
+        break;
+    case ListCtrlAttribute::kEnableItemEdit:
+        {
+            SetEnableItemEdit(strValue == _T("true"));
+        }
+        break;
+    case ListCtrlAttribute::kListCtrlRicheditClass:
+        {
+            SetRichEditClass(strValue);
+        }
+        break;
+    default:
         BaseClass::SetAttribute(strName, strValue);
+        break;
     }
 }
 
@@ -1539,6 +1686,11 @@ void ListCtrl::SetSortCompareFunction(ListCtrlDataCompareFunc pfnCompareFunc, vo
     m_pData->SetSortCompareFunction(pfnCompareFunc, pUserData);
 }
 
+size_t ListCtrl::ResortDataItem(size_t itemIndex)
+{
+    return m_pData->ResortDataItem(itemIndex);
+}
+
 void ListCtrl::SetColumnSortFlag(size_t columnIndex, uint8_t nSortFlag)
 {
     SetColumnSortFlagById(GetColumnId(columnIndex), nSortFlag);
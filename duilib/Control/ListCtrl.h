@@ -561,6 +561,12 @@ public:
     */
     void SetSortCompareFunction(ListCtrlDataCompareFunc pfnCompareFunc, void* pUserData);
 
+    /** 修改数据项的内容后，按当前的排序方式，将该数据项移动到正确的位置（不对全部数据重新排序）
+    * @param [in] itemIndex 数据项的索引号, 有效范围：[0, GetDataItemCount())
+    * @return 返回数据项新的索引号，如果未排序过或者失败则返回Box::InvalidIndex
+    */
+    size_t ResortDataItem(size_t itemIndex);
+
 public:
     /** 是否支持多选
     */
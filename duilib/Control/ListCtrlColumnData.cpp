@@ -0,0 +1,505 @@
+#include "ListCtrlColumnData.h"
+
+namespace ui
+{
+ListCtrlColumnData::ListCtrlColumnData():
+    m_nGarbageLength(0),
+    m_imageIds(-1),
+    m_textFormats(0),
+    m_sortGroups(0),
+    m_userDataN(0)
+{
+}
+
+ListCtrlColumnData::~ListCtrlColumnData()
+{
+}
+
+size_t ListCtrlColumnData::GetRowCount() const
+{
+    return m_flags.size();
+}
+
+void ListCtrlColumnData::ResizeRows(size_t nRowCount)
+{
+    const size_t nOldRowCount = m_flags.size();
+    for (size_t nRowIndex = nRowCount; nRowIndex < nOldRowCount; ++nRowIndex) {
+        m_nGarbageLength += m_textRefs[nRowIndex].m_nLength;
+    }
+    m_textRefs.resize(nRowCount);
+    m_flags.resize(nRowCount, 0);
+    m_imageIds.Resize(nRowCount);
+    m_textFormats.Resize(nRowCount);
+    m_sortGroups.Resize(nRowCount);
+    m_userDataN.Resize(nRowCount);
+    m_userDataS.Resize(nRowCount);
+    m_textColors.Resize(nRowCount);
+    m_bkColors.Resize(nRowCount);
+    if (nRowCount == 0) {
+        ClearRows();
+    }
+    else if (nRowCount < nOldRowCount) {
+        CompactText(false);
+    }
+}
+
+void ListCtrlColumnData::InsertRow(size_t nRowIndex)
+{
+    ASSERT(nRowIndex <= m_flags.size());
+    if (nRowIndex > m_flags.size()) {
+        return;
+    }
+    m_textRefs.insert(m_textRefs.begin() + nRowIndex, TextRef());
+    m_flags.insert(m_flags.begin() + nRowIndex, (uint8_t)0);
+    m_imageIds.Insert(nRowIndex);
+    m_textFormats.Insert(nRowIndex);
+    m_sortGroups.Insert(nRowIndex);
+    m_userDataN.Insert(nRowIndex);
+    m_userDataS.Insert(nRowIndex);
+    m_textColors.Insert(nRowIndex);
+    m_bkColors.Insert(nRowIndex);
+}
+
+void ListCtrlColumnData::EraseRow(size_t nRowIndex)
+{
+    ASSERT(nRowIndex < m_flags.size());
+    if (nRowIndex >= m_flags.size()) {
+        return;
+    }
+    m_nGarbageLength += m_textRefs[nRowIndex].m_nLength;
+    m_textRefs.erase(m_textRefs.begin() + nRowIndex);
+    m_flags.erase(m_flags.begin() + nRowIndex);
+    m_imageIds.Erase(nRowIndex);
+    m_textFormats.Erase(nRowIndex);
+    m_sortGroups.Erase(nRowIndex);
+    m_userDataN.Erase(nRowIndex);
+    m_userDataS.Erase(nRowIndex);
+    m_textColors.Erase(nRowIndex);
+    m_bkColors.Erase(nRowIndex);
+    CompactText(false);
+}
+
+void ListCtrlColumnData::ClearRows()
+{
+    std::vector<CharType> textArena;
+    m_textArena.swap(textArena);
+    m_nGarbageLength = 0;
+    std::vector<TextRef> textRefs;
+    m_textRefs.swap(textRefs);
+    std::vector<uint8_t> flags;
+    m_flags.swap(flags);
+    m_imageIds.Clear();
+    m_textFormats.Clear();
+    m_sortGroups.Clear();
+    m_userDataN.Clear();
+    m_userDataS.Clear();
+    m_textColors.Clear();
+    m_bkColors.Clear();
+}
+
+void ListCtrlColumnData::ReorderRows(const std::vector<size_t>& rowOrder)
+{
+    const size_t nRowCount = m_flags.size();
+    ASSERT(rowOrder.size() == nRowCount);
+    if (rowOrder.size() != nRowCount) {
+        return;
+    }
+    std::vector<TextRef> textRefs;
+    std::vector<uint8_t> flags;
+    std::vector<size_t> oldToNew;
+    textRefs.reserve(nRowCount);
+    flags.reserve(nRowCount);
+    oldToNew.resize(nRowCount);
+    for (size_t nNewIndex = 0; nNewIndex < nRowCount; ++nNewIndex) {
+        const size_t nOldIndex = rowOrder[nNewIndex];
+        ASSERT(nOldIndex < nRowCount);
+        textRefs.push_back(m_textRefs[nOldIndex]);
+        flags.push_back(m_flags[nOldIndex]);
+        oldToNew[nOldIndex] = nNewIndex;
+    }
+    //文本缓冲区的内容不需要移动，只调整每行的位置记录
+    m_textRefs.swap(textRefs);
+    m_flags.swap(flags);
+    m_imageIds.Reorder(rowOrder);
+    m_textFormats.Reorder(rowOrder);
+    m_sortGroups.Reorder(rowOrder);
+    m_userDataN.Reorder(rowOrder);
+    m_userDataS.Reorder(oldToNew);
+    m_textColors.Reorder(oldToNew);
+    m_bkColors.Reorder(oldToNew);
+}
+
+size_t ListCtrlColumnData::GetMemoryBytes() const
+{
+    size_t nBytes = sizeof(ListCtrlColumnData);
+    nBytes += m_textArena.capacity() * sizeof(CharType);
+    nBytes += m_textRefs.capacity() * sizeof(TextRef);
+    nBytes += m_flags.capacity() * sizeof(uint8_t);
+    nBytes += m_imageIds.GetMemoryBytes();
+    nBytes += m_textFormats.GetMemoryBytes();
+    nBytes += m_sortGroups.GetMemoryBytes();
+    nBytes += m_userDataN.GetMemoryBytes();
+    nBytes += m_userDataS.GetMemoryBytes();
+    nBytes += m_textColors.GetMemoryBytes();
+    nBytes += m_bkColors.GetMemoryBytes();
+    return nBytes;
+}
+
+bool ListCtrlColumnData::HasData(size_t nRowIndex) const
+{
+    ASSERT(nRowIndex < m_flags.size());
+    if (nRowIndex >= m_flags.size()) {
+        return false;
+    }
+    return (m_flags[nRowIndex] & RowFlag::kHasData) != 0;
+}
+
+void ListCtrlColumnData::MarkData(size_t nRowIndex)
+{
+    m_flags[nRowIndex] |= RowFlag::kHasData;
+}
+
+bool ListCtrlColumnData::SetFlag(size_t nRowIndex, uint8_t nFlag, bool bSet)
+{
+    ASSERT(nRowIndex < m_flags.size());
+    if (nRowIndex >= m_flags.size()) {
+        return false;
+    }
+    uint8_t nOldFlags = m_flags[nRowIndex];
+    uint8_t nNewFlags = bSet ? (nOldFlags | nFlag) : (nOldFlags & ~nFlag);
+    m_flags[nRowIndex] = nNewFlags | RowFlag::kHasData;
+    return (nOldFlags & nFlag) != (nNewFlags & nFlag);
+}
+
+void ListCtrlColumnData::SetData(size_t nRowIndex, const Storage& storage)
+{
+    ASSERT(nRowIndex < m_flags.size());
+    if (nRowIndex >= m_flags.size()) {
+        return;
+    }
+    SetText(nRowIndex, storage.text.c_str());
+    SetImageId(nRowIndex, storage.nImageId);
+    SetTextFormat(nRowIndex, storage.nTextFormat);
+    SetSortGroup(nRowIndex, storage.nSortGroup);
+    SetUserDataN(nRowIndex, storage.userDataN);
+    SetUserDataS(nRowIndex, storage.userDataS.c_str());
+    SetTextColor(nRowIndex, storage.textColor);
+    SetBkColor(nRowIndex, storage.bkColor);
+    SetShowCheckBox(nRowIndex, storage.bShowCheckBox);
+    SetChecked(nRowIndex, storage.bChecked);
+    SetEditable(nRowIndex, storage.bEditable);
+}
+
+bool ListCtrlColumnData::GetData(size_t nRowIndex, Storage& storage) const
+{
+    if (!HasData(nRowIndex)) {
+        storage = Storage();
+        return false;
+    }
+    //逐个字段赋值（不先清空数据），排序时反复读取到同一个对象中，减少内存分配
+    size_t nTextLength = 0;
+    const CharType* pText = GetTextData(nRowIndex, nTextLength);
+    storage.text = std::basic_string_view<CharType>(pText, nTextLength);
+    storage.nImageId = GetImageId(nRowIndex);
+    storage.nTextFormat = GetTextFormat(nRowIndex);
+    storage.nSortGroup = GetSortGroup(nRowIndex);
+    storage.userDataN = GetUserDataN(nRowIndex);
+    const UiString* pUserDataS = m_userDataS.Find(nRowIndex);
+    if (pUserDataS != nullptr) {
+        storage.userDataS = *pUserDataS;
+    }
+    else {
+        storage.userDataS.clear();
+    }
+    storage.textColor = GetTextColor(nRowIndex);
+    storage.bkColor = GetBkColor(nRowIndex);
+    const uint8_t nFlags = m_flags[nRowIndex];
+    storage.bShowCheckBox = (nFlags & RowFlag::kShowCheckBox) != 0;
+    storage.bChecked = (nFlags & RowFlag::kChecked) != 0;
+    storage.bEditable = (nFlags & RowFlag::kEditable) != 0;
+    return true;
+}
+
+const ListCtrlColumnData::CharType* ListCtrlColumnData::GetTextData(size_t nRowIndex, size_t& nLength) const
+{
+    nLength = 0;
+    ASSERT(nRowIndex < m_textRefs.size());
+    if ((nRowIndex >= m_textRefs.size()) || (m_textRefs[nRowIndex].m_nLength == 0)) {
+        return nullptr;
+    }
+    const TextRef& textRef = m_textRefs[nRowIndex];
+    nLength = textRef.m_nLength;
+    return m_textArena.data() + textRef.m_nOffset;
+}
+
+DString ListCtrlColumnData::GetText(size_t nRowIndex) const
+{
+    size_t nLength = 0;
+    const CharType* pText = GetTextData(nRowIndex, nLength);
+    if (pText == nullptr) {
+        return DString();
+    }
+    return DString(pText, nLength);
+}
+
+bool ListCtrlColumnData::SetText(size_t nRowIndex, const DString& text)
+{
+    ASSERT(nRowIndex < m_textRefs.size());
+    if (nRowIndex >= m_textRefs.size()) {
+        return false;
+    }
+    size_t nLength = 0;
+    const CharType* pText = GetTextData(nRowIndex, nLength);
+    if ((nLength == text.size()) && ((nLength == 0) || std::equal(pText, pText + nLength, text.c_str()))) {
+        MarkData(nRowIndex);
+        return false;
+    }
+    if (!WriteText(nRowIndex, text.c_str(), text.size())) {
+        //文本缓冲区已满，写入失败，该行数据保持不变
+        return false;
+    }
+    MarkData(nRowIndex);
+    return true;
+}
+
+bool ListCtrlColumnData::WriteText(size_t nRowIndex, const CharType* pText, size_t nLength)
+{
+    TextRef& textRef = m_textRefs[nRowIndex];
+    if (nLength <= textRef.m_nLength) {
+        //新文本不比旧文本长，原地覆盖
+        if (nLength > 0) {
+            std::copy(pText, pText + nLength, m_textArena.begin() + textRef.m_nOffset);
+        }
+        m_nGarbageLength += textRef.m_nLength - nLength;
+        textRef.m_nLength = (uint32_t)nLength;
+        if (nLength == 0) {
+            textRef.m_nOffset = 0;
+        }
+    }
+    else {
+        //追加到缓冲区的末尾，旧文本成为无用数据
+        //文本的偏移量和长度为32位，超出范围时先整理缓冲区，仍然超出范围则写入失败
+        if ((nLength > UINT32_MAX) || (m_textArena.size() + nLength > UINT32_MAX)) {
+            CompactText(true);
+        }
+        ASSERT((nLength <= UINT32_MAX) && (m_textArena.size() + nLength <= UINT32_MAX));
+        if ((nLength > UINT32_MAX) || (m_textArena.size() + nLength > UINT32_MAX)) {
+            return false;
+        }
+        m_nGarbageLength += textRef.m_nLength;
+        textRef.m_nOffset = (uint32_t)m_textArena.size();
+        textRef.m_nLength = (uint32_t)nLength;
+        m_textArena.insert(m_textArena.end(), pText, pText + nLength);
+    }
+    CompactText(false);
+    return true;
+}
+
+void ListCtrlColumnData::CompactText(bool bForce)
+{
+    if (m_nGarbageLength == 0) {
+        return;
+    }
+    //无用数据超过缓冲区的一半时才整理，保证整理的均摊开销为O(1)
+    if (!bForce && ((m_nGarbageLength < 4096) || (m_nGarbageLength * 2 < m_textArena.size()))) {
+        return;
+    }
+    std::vector<CharType> textArena;
+    textArena.reserve(m_textArena.size() - m_nGarbageLength);
+    for (TextRef& textRef : m_textRefs) {
+        if (textRef.m_nLength == 0) {
+            textRef.m_nOffset = 0;
+            continue;
+        }
+        size_t nOffset = textArena.size();
+        auto iterBegin = m_textArena.begin() + textRef.m_nOffset;
+        textArena.insert(textArena.end(), iterBegin, iterBegin + textRef.m_nLength);
+        textRef.m_nOffset = (uint32_t)nOffset;
+    }
+    m_textArena.swap(textArena);
+    m_nGarbageLength = 0;
+}
+
+int32_t ListCtrlColumnData::GetImageId(size_t nRowIndex) const
+{
+    return m_imageIds.Get(nRowIndex);
+}
+
+bool ListCtrlColumnData::SetImageId(size_t nRowIndex, int32_t nImageId)
+{
+    ASSERT(nRowIndex < m_flags.size());
+    if (nRowIndex >= m_flags.size()) {
+        return false;
+    }
+    MarkData(nRowIndex);
+    return m_imageIds.Set(nRowIndex, nImageId, m_flags.size());
+}
+
+uint16_t ListCtrlColumnData::GetTextFormat(size_t nRowIndex) const
+{
+    return m_textFormats.Get(nRowIndex);
+}
+
+bool ListCtrlColumnData::SetTextFormat(size_t nRowIndex, uint16_t nTextFormat)
+{
+    ASSERT(nRowIndex < m_flags.size());
+    if (nRowIndex >= m_flags.size()) {
+        return false;
+    }
+    MarkData(nRowIndex);
+    return m_textFormats.Set(nRowIndex, nTextFormat, m_flags.size());
+}
+
+int32_t ListCtrlColumnData::GetSortGroup(size_t nRowIndex) const
+{
+    return m_sortGroups.Get(nRowIndex);
+}
+
+bool ListCtrlColumnData::SetSortGroup(size_t nRowIndex, int32_t nSortGroup)
+{
+    ASSERT(nRowIndex < m_flags.size());
+    if (nRowIndex >= m_flags.size()) {
+        return false;
+    }
+    MarkData(nRowIndex);
+    return m_sortGroups.Set(nRowIndex, nSortGroup, m_flags.size());
+}
+
+uint64_t ListCtrlColumnData::GetUserDataN(size_t nRowIndex) const
+{
+    return m_userDataN.Get(nRowIndex);
+}
+
+bool ListCtrlColumnData::SetUserDataN(size_t nRowIndex, uint64_t userDataN)
+{
+    ASSERT(nRowIndex < m_flags.size());
+    if (nRowIndex >= m_flags.size()) {
+        return false;
+    }
+    MarkData(nRowIndex);
+    return m_userDataN.Set(nRowIndex, userDataN, m_flags.size());
+}
+
+DString ListCtrlColumnData::GetUserDataS(size_t nRowIndex) const
+{
+    const UiString* pUserDataS = m_userDataS.Find(nRowIndex);
+    if (pUserDataS != nullptr) {
+        return pUserDataS->c_str();
+    }
+    return DString();
+}
+
+const ListCtrlColumnData::CharType* ListCtrlColumnData::GetUserDataSData(size_t nRowIndex, size_t& nLength) const
+{
+    nLength = 0;
+    const UiString* pUserDataS = m_userDataS.Find(nRowIndex);
+    if ((pUserDataS == nullptr) || pUserDataS->empty()) {
+        return nullptr;
+    }
+    nLength = std::char_traits<CharType>::length(pUserDataS->c_str());
+    return pUserDataS->c_str();
+}
+
+bool ListCtrlColumnData::SetUserDataS(size_t nRowIndex, const DString& userDataS)
+{
+    ASSERT(nRowIndex < m_flags.size());
+    if (nRowIndex >= m_flags.size()) {
+        return false;
+    }
+    MarkData(nRowIndex);
+    const UiString* pUserDataS = m_userDataS.Find(nRowIndex);
+    if (userDataS.empty()) {
+        if (pUserDataS == nullptr) {
+            return false;
+        }
+        m_userDataS.Remove(nRowIndex);
+        return true;
+    }
+    if ((pUserDataS != nullptr) && (*pUserDataS == userDataS)) {
+        return false;
+    }
+    m_userDataS.Set(nRowIndex, UiString(userDataS));
+    return true;
+}
+
+UiColor ListCtrlColumnData::GetTextColor(size_t nRowIndex) const
+{
+    const UiColor* pColor = m_textColors.Find(nRowIndex);
+    return (pColor != nullptr) ? *pColor : UiColor();
+}
+
+bool ListCtrlColumnData::SetTextColor(size_t nRowIndex, const UiColor& textColor)
+{
+    ASSERT(nRowIndex < m_flags.size());
+    if (nRowIndex >= m_flags.size()) {
+        return false;
+    }
+    MarkData(nRowIndex);
+    if (GetTextColor(nRowIndex) == textColor) {
+        return false;
+    }
+    if (textColor.IsEmpty()) {
+        m_textColors.Remove(nRowIndex);
+    }
+    else {
+        m_textColors.Set(nRowIndex, textColor);
+    }
+    return true;
+}
+
+UiColor ListCtrlColumnData::GetBkColor(size_t nRowIndex) const
+{
+    const UiColor* pColor = m_bkColors.Find(nRowIndex);
+    return (pColor != nullptr) ? *pColor : UiColor();
+}
+
+bool ListCtrlColumnData::SetBkColor(size_t nRowIndex, const UiColor& bkColor)
+{
+    ASSERT(nRowIndex < m_flags.size());
+    if (nRowIndex >= m_flags.size()) {
+        return false;
+    }
+    MarkData(nRowIndex);
+    if (GetBkColor(nRowIndex) == bkColor) {
+        return false;
+    }
+    if (bkColor.IsEmpty()) {
+        m_bkColors.Remove(nRowIndex);
+    }
+    else {
+        m_bkColors.Set(nRowIndex, bkColor);
+    }
+    return true;
+}
+
+bool ListCtrlColumnData::IsShowCheckBox(size_t nRowIndex) const
+{
+    return (nRowIndex < m_flags.size()) && ((m_flags[nRowIndex] & RowFlag::kShowCheckBox) != 0);
+}
+
+bool ListCtrlColumnData::SetShowCheckBox(size_t nRowIndex, bool bShowCheckBox)
+{
+    return SetFlag(nRowIndex, RowFlag::kShowCheckBox, bShowCheckBox);
+}
+
+bool ListCtrlColumnData::IsChecked(size_t nRowIndex) const
+{
+    return (nRowIndex < m_flags.size()) && ((m_flags[nRowIndex] & RowFlag::kChecked) != 0);
+}
+
+bool ListCtrlColumnData::SetChecked(size_t nRowIndex, bool bChecked)
+{
+    return SetFlag(nRowIndex, RowFlag::kChecked, bChecked);
+}
+
+bool ListCtrlColumnData::IsEditable(size_t nRowIndex) const
+{
+    return (nRowIndex < m_flags.size()) && ((m_flags[nRowIndex] & RowFlag::kEditable) != 0);
+}
+
+bool ListCtrlColumnData::SetEditable(size_t nRowIndex, bool bEditable)
+{
+    return SetFlag(nRowIndex, RowFlag::kEditable, bEditable);
+}
+
+}//namespace ui
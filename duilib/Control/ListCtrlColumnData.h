@@ -0,0 +1,374 @@
+#ifndef UI_CONTROL_LIST_CTRL_COLUMN_DATA_H_
+#define UI_CONTROL_LIST_CTRL_COLUMN_DATA_H_
+
+#include "duilib/Control/ListCtrlDefs.h"
+#include <vector>
+#include <algorithm>
+
+namespace ui
+{
+/** 列表中一列数据的列式存储（每个<行,列>不再单独分配内存）
+*   文本：每列一个字符串缓冲区（Arena），每行只记录偏移和长度；
+*   标志位（是否有数据、CheckBox、勾选、可编辑）：每行1个字节的密集数组；
+*   图标、文本属性、排序分组、整型用户数据：按需分配的密集数组（全部为默认值时不占用内存）；
+*   文本颜色、背景颜色、字符串用户数据：很少设置的属性，使用按行号排序的稀疏表
+*/
+class ListCtrlColumnData
+{
+public:
+    typedef ListCtrlSubItemData2 Storage;
+    typedef DString::value_type CharType;
+
+public:
+    ListCtrlColumnData();
+    ~ListCtrlColumnData();
+
+public:
+    /** 获取行数
+    */
+    size_t GetRowCount() const;
+
+    /** 设置行数（新增的行无数据）
+    */
+    void ResizeRows(size_t nRowCount);
+
+    /** 在指定位置插入一个无数据的行
+    * @param [in] nRowIndex 行的索引号，有效范围：[0, GetRowCount()]
+    */
+    void InsertRow(size_t nRowIndex);
+
+    /** 删除指定行
+    * @param [in] nRowIndex 行的索引号，有效范围：[0, GetRowCount())
+    */
+    void EraseRow(size_t nRowIndex);
+
+    /** 删除所有行，并释放内存
+    */
+    void ClearRows();
+
+    /** 调整行的顺序
+    * @param [in] rowOrder 新的行顺序：新的第i行为原来的第rowOrder[i]行，数组的长度必须与行数相同
+    */
+    void ReorderRows(const std::vector<size_t>& rowOrder);
+
+    /** 获取数据占用的内存（字节）
+    */
+    size_t GetMemoryBytes() const;
+
+public:
+    /** 该行是否有数据
+    */
+    bool HasData(size_t nRowIndex) const;
+
+    /** 设置该行的全部数据
+    */
+    void SetData(size_t nRowIndex, const Storage& storage);
+
+    /** 获取该行的全部数据
+    * @return 如果该行无数据，返回false
+    */
+    bool GetData(size_t nRowIndex, Storage& storage) const;
+
+    /** 获取文本（不复制数据，返回的指针在修改该列的文本之前有效）
+    * @param [out] nLength 返回文本的长度
+    */
+    const CharType* GetTextData(size_t nRowIndex, size_t& nLength) const;
+
+    /** 获取文本
+    */
+    DString GetText(size_t nRowIndex) const;
+
+    /** 设置文本，返回值表示数据是否有变化（以下各个设置函数相同）
+    */
+    bool SetText(size_t nRowIndex, const DString& text);
+
+    /** 图标资源Id
+    */
+    int32_t GetImageId(size_t nRowIndex) const;
+    bool SetImageId(size_t nRowIndex, int32_t nImageId);
+
+    /** 文本属性
+    */
+    uint16_t GetTextFormat(size_t nRowIndex) const;
+    bool SetTextFormat(size_t nRowIndex, uint16_t nTextFormat);
+
+    /** 排序分组
+    */
+    int32_t GetSortGroup(size_t nRowIndex) const;
+    bool SetSortGroup(size_t nRowIndex, int32_t nSortGroup);
+
+    /** 用户自定义数据(整型)
+    */
+    uint64_t GetUserDataN(size_t nRowIndex) const;
+    bool SetUserDataN(size_t nRowIndex, uint64_t userDataN);
+
+    /** 用户自定义数据(字符串类型)
+    */
+    DString GetUserDataS(size_t nRowIndex) const;
+    const CharType* GetUserDataSData(size_t nRowIndex, size_t& nLength) const;
+    bool SetUserDataS(size_t nRowIndex, const DString& userDataS);
+
+    /** 文本颜色
+    */
+    UiColor GetTextColor(size_t nRowIndex) const;
+    bool SetTextColor(size_t nRowIndex, const UiColor& textColor);
+
+    /** 背景颜色
+    */
+    UiColor GetBkColor(size_t nRowIndex) const;
+    bool SetBkColor(size_t nRowIndex, const UiColor& bkColor);
+
+    /** 是否显示CheckBox
+    */
+    bool IsShowCheckBox(size_t nRowIndex) const;
+    bool SetShowCheckBox(size_t nRowIndex, bool bShowCheckBox);
+
+    /** CheckBox的勾选状态
+    */
+    bool IsChecked(size_t nRowIndex) const;
+    bool SetChecked(size_t nRowIndex, bool bChecked);
+
+    /** 是否可编辑
+    */
+    bool IsEditable(size_t nRowIndex) const;
+    bool SetEditable(size_t nRowIndex, bool bEditable);
+
+private:
+    /** 标志位
+    */
+    enum RowFlag : uint8_t
+    {
+        kHasData        = 0x01,     //该行有数据
+        kShowCheckBox   = 0x02,     //显示CheckBox
+        kChecked        = 0x04,     //勾选状态
+        kEditable       = 0x08      //可编辑
+    };
+
+    /** 设置标志位，返回值表示标志位是否有变化（同时标记该行有数据）
+    */
+    bool SetFlag(size_t nRowIndex, uint8_t nFlag, bool bSet);
+
+    /** 标记该行有数据
+    */
+    void MarkData(size_t nRowIndex);
+
+    /** 在文本缓冲区中写入文本
+    * @return 文本缓冲区超出32位的范围时返回false，该行的文本保持不变
+    */
+    bool WriteText(size_t nRowIndex, const CharType* pText, size_t nLength);
+
+    /** 无用的文本数据过多时，整理文本缓冲区
+    * @param [in] bForce 为true时只要有无用数据就整理
+    */
+    void CompactText(bool bForce);
+
+private:
+    /** 按需分配的密集数组：所有行都为默认值时，不分配内存
+    */
+    template<typename T>
+    class LazyArray
+    {
+    public:
+        explicit LazyArray(const T& defaultValue) : m_defaultValue(defaultValue) {}
+
+        T Get(size_t nIndex) const
+        {
+            return (nIndex < m_data.size()) ? m_data[nIndex] : m_defaultValue;
+        }
+        bool Set(size_t nIndex, const T& value, size_t nRowCount)
+        {
+            if (m_data.empty()) {
+                if (value == m_defaultValue) {
+                    return false;
+                }
+                m_data.resize(nRowCount, m_defaultValue);
+            }
+            if (m_data[nIndex] == value) {
+                return false;
+            }
+            m_data[nIndex] = value;
+            return true;
+        }
+        void Resize(size_t nRowCount)
+        {
+            if (!m_data.empty()) {
+                m_data.resize(nRowCount, m_defaultValue);
+            }
+        }
+        void Insert(size_t nIndex)
+        {
+            if (!m_data.empty()) {
+                m_data.insert(m_data.begin() + nIndex, m_defaultValue);
+            }
+        }
+        void Erase(size_t nIndex)
+        {
+            if (!m_data.empty()) {
+                m_data.erase(m_data.begin() + nIndex);
+            }
+        }
+        void Reorder(const std::vector<size_t>& rowOrder)
+        {
+            if (!m_data.empty()) {
+                std::vector<T> data;
+                data.reserve(rowOrder.size());
+                for (size_t nOldIndex : rowOrder) {
+                    data.push_back(m_data[nOldIndex]);
+                }
+                m_data.swap(data);
+            }
+        }
+        void Clear()
+        {
+            std::vector<T> data;
+            m_data.swap(data);
+        }
+        size_t GetMemoryBytes() const { return m_data.capacity() * sizeof(T); }
+
+    private:
+        std::vector<T> m_data;
+        T m_defaultValue;
+    };
+
+    /** 稀疏表：只保存非默认值的行，按行号排序
+    */
+    template<typename T>
+    class SparseArray
+    {
+    public:
+        typedef std::pair<size_t, T> Item;
+
+        const T* Find(size_t nIndex) const
+        {
+            auto iter = LowerBound(nIndex);
+            if ((iter != m_items.end()) && (iter->first == nIndex)) {
+                return &iter->second;
+            }
+            return nullptr;
+        }
+        void Set(size_t nIndex, const T& value)
+        {
+            auto iter = LowerBound(nIndex);
+            if ((iter != m_items.end()) && (iter->first == nIndex)) {
+                iter->second = value;
+            }
+            else {
+                m_items.insert(iter, Item(nIndex, value));
+            }
+        }
+        void Remove(size_t nIndex)
+        {
+            auto iter = LowerBound(nIndex);
+            if ((iter != m_items.end()) && (iter->first == nIndex)) {
+                m_items.erase(iter);
+            }
+        }
+        void Resize(size_t nRowCount)
+        {
+            m_items.erase(LowerBound(nRowCount), m_items.end());
+        }
+        void Insert(size_t nIndex)
+        {
+            for (auto iter = LowerBound(nIndex); iter != m_items.end(); ++iter) {
+                iter->first += 1;
+            }
+        }
+        void Erase(size_t nIndex)
+        {
+            Remove(nIndex);
+            for (auto iter = LowerBound(nIndex); iter != m_items.end(); ++iter) {
+                iter->first -= 1;
+            }
+        }
+        void Reorder(const std::vector<size_t>& oldToNew)
+        {
+            for (Item& item : m_items) {
+                item.first = oldToNew[item.first];
+            }
+            std::sort(m_items.begin(), m_items.end(), [](const Item& a, const Item& b) {
+                    return a.first < b.first;
+                });
+        }
+        bool IsEmpty() const { return m_items.empty(); }
+        void Clear()
+        {
+            std::vector<Item> items;
+            m_items.swap(items);
+        }
+        size_t GetMemoryBytes() const { return m_items.capacity() * sizeof(Item); }
+
+    private:
+        typename std::vector<Item>::iterator LowerBound(size_t nIndex)
+        {
+            return std::lower_bound(m_items.begin(), m_items.end(), nIndex, [](const Item& item, size_t n) {
+                    return item.first < n;
+                });
+        }
+        typename std::vector<Item>::const_iterator LowerBound(size_t nIndex) const
+        {
+            return std::lower_bound(m_items.begin(), m_items.end(), nIndex, [](const Item& item, size_t n) {
+                    return item.first < n;
+                });
+        }
+
+    private:
+        std::vector<Item> m_items;
+    };
+
+    /** 文本在缓冲区中的位置
+    */
+    struct TextRef
+    {
+        uint32_t m_nOffset = 0;
+        uint32_t m_nLength = 0;
+    };
+
+private:
+    /** 文本缓冲区
+    */
+    std::vector<CharType> m_textArena;
+
+    /** 文本缓冲区中无用数据的长度（修改、删除后留下的旧文本）
+    */
+    size_t m_nGarbageLength;
+
+    /** 每行文本的位置
+    */
+    std::vector<TextRef> m_textRefs;
+
+    /** 每行的标志位
+    */
+    std::vector<uint8_t> m_flags;
+
+    /** 图标资源Id
+    */
+    LazyArray<int32_t> m_imageIds;
+
+    /** 文本属性
+    */
+    LazyArray<uint16_t> m_textFormats;
+
+    /** 排序分组
+    */
+    LazyArray<int32_t> m_sortGroups;
+
+    /** 用户自定义数据(整型)
+    */
+    LazyArray<uint64_t> m_userDataN;
+
+    /** 用户自定义数据(字符串类型)
+    */
+    SparseArray<UiString> m_userDataS;
+
+    /** 文本颜色
+    */
+    SparseArray<UiColor> m_textColors;
+
+    /** 背景颜色
+    */
+    SparseArray<UiColor> m_bkColors;
+};
+
+}//namespace ui
+
+#endif //UI_CONTROL_LIST_CTRL_COLUMN_DATA_H_
@@ -3,9 +3,189 @@
 #include "duilib/Core/GlobalManager.h"
 #include <set>
 #include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <cwctype>
 
 namespace ui
 {
+namespace
+{
+/** 排序时不区分大小写：转换为小写
+*/
+inline DString::value_type FoldCase(DString::value_type ch)
+{
+#ifdef DUILIB_UNICODE
+    return (DString::value_type)::towlower((wint_t)ch);
+#else
+    return (DString::value_type)::tolower((unsigned char)ch);
+#endif
+}
+
+/** 并行执行一组任务：向框架的线程池投递任务，当前线程也参与执行，所有任务完成后返回
+*   每个任务只执行一次（由先取到的线程执行）；线程池停止时丢弃的任务由当前线程执行，不会一直等待
+* @param [in] tasks 需要执行的任务（返回前一直有效）
+*/
+void RunParallelTasks(const std::vector<StdClosure>& tasks)
+{
+    struct TParallelState
+    {
+        const std::vector<StdClosure>* m_pTasks = nullptr;  //任务列表（所有任务取出后不再访问）
+        std::atomic<size_t> m_nNextTask{ 0 };               //下一个要执行的任务
+        size_t m_nFinishedCount = 0;                        //已经执行完成的任务个数
+        std::mutex m_mutex;
+        std::condition_variable m_finishedCv;
+    };
+    std::shared_ptr<TParallelState> pState = std::make_shared<TParallelState>();
+    pState->m_pTasks = &tasks;
+    const size_t nTaskCount = tasks.size();
+    auto runTasks = [pState, nTaskCount]() {
+            size_t nTaskIndex = pState->m_nNextTask++;
+            while (nTaskIndex < nTaskCount) {
+                (*pState->m_pTasks)[nTaskIndex]();
+                {
+                    std::lock_guard<std::mutex> stateGuard(pState->m_mutex);
+                    ++pState->m_nFinishedCount;
+                }
+                pState->m_finishedCv.notify_all();
+                nTaskIndex = pState->m_nNextTask++;
+            }
+        };
+    for (size_t i = 1; i < nTaskCount; ++i) {
+        if (GlobalManager::Instance().Thread().PostTask(kThreadPool, runTasks) == 0) {
+            break;
+        }
+    }
+    runTasks();
+    std::unique_lock<std::mutex> stateGuard(pState->m_mutex);
+    pState->m_finishedCv.wait(stateGuard, [&pState, nTaskCount]() {
+            return pState->m_nFinishedCount == nTaskCount;
+        });
+}
+
+/** 稳定排序：数据量大时，分段在框架的线程池中排序，然后逐轮两两归并
+* @param [in] indexs 需要排序的数据
+* @param [in] compareFunc 比较函数（必须是线程安全的）
+*/
+template<typename CompareFunc>
+void ParallelStableSort(std::vector<uint32_t>& indexs, const CompareFunc& compareFunc)
+{
+    //数据量较少、线程池未启动或者当前线程就是线程池的工作线程时，在当前线程中排序
+    const size_t nMinParallelCount = 65536;
+    const size_t nCount = indexs.size();
+    ThreadManager& threadManager = GlobalManager::Instance().Thread();
+    size_t nThreadCount = threadManager.GetThreadPoolThreadCount(kThreadPool);
+    nThreadCount = std::min(nThreadCount, (size_t)8);
+    if ((nCount < nMinParallelCount) || (nThreadCount < 2) ||
+        (threadManager.GetCurrentThreadIdentifier() == kThreadPool)) {
+        std::stable_sort(indexs.begin(), indexs.end(), compareFunc);
+        return;
+    }
+    //分段边界
+    std::vector<size_t> bounds;
+    for (size_t i = 0; i <= nThreadCount; ++i) {
+        bounds.push_back(nCount * i / nThreadCount);
+    }
+    std::vector<StdClosure> tasks;
+    for (size_t i = 0; i < nThreadCount; ++i) {
+        tasks.push_back([&indexs, &compareFunc, &bounds, i]() {
+                std::stable_sort(indexs.begin() + bounds[i], indexs.begin() + bounds[i + 1], compareFunc);
+            });
+    }
+    RunParallelTasks(tasks);
+    //两两归并相邻的分段（inplace_merge是稳定的）
+    while (bounds.size() > 2) {
+        std::vector<size_t> mergedBounds;
+        tasks.clear();
+        size_t i = 0;
+        for (; (i + 2) < bounds.size(); i += 2) {
+            const size_t nFirst = bounds[i];
+            const size_t nMiddle = bounds[i + 1];
+            const size_t nLast = bounds[i + 2];
+            tasks.push_back([&indexs, &compareFunc, nFirst, nMiddle, nLast]() {
+                    std::inplace_merge(indexs.begin() + nFirst, indexs.begin() + nMiddle,
+                                       indexs.begin() + nLast, compareFunc);
+                });
+            mergedBounds.push_back(nFirst);
+        }
+        for (; (i + 1) < bounds.size(); ++i) {
+            //奇数个分段时，最后一段本轮不参与归并
+            mergedBounds.push_back(bounds[i]);
+        }
+        mergedBounds.push_back(nCount);
+        RunParallelTasks(tasks);
+        bounds.swap(mergedBounds);
+    }
+}
+
+/** 使用自定义的比较函数比较列数据中的两行（无数据的行排在最前面）
+*   比较时从列数据中读取到两个可复用的缓存中，不为每行数据生成副本
+*/
+class ColumnDataLess
+{
+public:
+    ColumnDataLess(const ListCtrlColumnData& columnData,
+                   const ListCtrlDataCompareFunc& pfnCompareFunc,
+                   const ListCtrlCompareParam& param):
+        m_columnData(columnData),
+        m_pfnCompareFunc(pfnCompareFunc),
+        m_param(param)
+    {
+        m_nRowIndex[0] = Box::InvalidIndex;
+        m_nRowIndex[1] = Box::InvalidIndex;
+    }
+
+    /** 实现(nRowIndexA < nRowIndexB)的比较逻辑
+    * @param [in] nRowIndexA 第一个比较数据在列数据中的行号
+    * @param [in] nRowIndexB 第二个比较数据在列数据中的行号
+    */
+    bool operator()(size_t nRowIndexA, size_t nRowIndexB)
+    {
+        if (!m_columnData.HasData(nRowIndexB)) {
+            return false;
+        }
+        if (!m_columnData.HasData(nRowIndexA)) {
+            return true;
+        }
+        const ListCtrlSubItemData2& a = GetStorage(nRowIndexA, nRowIndexB);
+        const ListCtrlSubItemData2& b = GetStorage(nRowIndexB, nRowIndexA);
+        return m_pfnCompareFunc(a, b, m_param);
+    }
+
+private:
+    /** 获取一行的数据（优先使用缓存，不覆盖另一个比较数据所在的缓存）
+    */
+    const ListCtrlSubItemData2& GetStorage(size_t nRowIndex, size_t nOtherRowIndex)
+    {
+        for (size_t i = 0; i < 2; ++i) {
+            if (m_nRowIndex[i] == nRowIndex) {
+                return m_storage[i];
+            }
+        }
+        const size_t nSlot = (m_nRowIndex[0] == nOtherRowIndex) ? 1 : 0;
+        m_columnData.GetData(nRowIndex, m_storage[nSlot]);
+        m_nRowIndex[nSlot] = nRowIndex;
+        return m_storage[nSlot];
+    }
+
+private:
+    /** 列数据
+    */
+    const ListCtrlColumnData& m_columnData;
+
+    /** 自定义的比较函数及其参数
+    */
+    const ListCtrlDataCompareFunc& m_pfnCompareFunc;
+    const ListCtrlCompareParam& m_param;
+
+    /** 缓存的两行数据及其行号
+    */
+    ListCtrlSubItemData2 m_storage[2];
+    size_t m_nRowIndex[2];
+};
+}//namespace
+
 ListCtrlData::ListCtrlData() :
     m_pListView(nullptr),
     m_pfnCompareFunc(nullptr),
@@ -60,24 +240,28 @@ bool ListCtrlData::FillElement(Control* pControl, size_t nElementIndex)
 int32_t ListCtrlData::GetMaxColumnWidth(size_t columnId) const
 {
     int32_t nMaxWidth = -1;
-    std::vector<ListCtrlSubItemData2Ptr> subItemList;
     auto iter = m_dataMap.find(columnId);
     ASSERT(iter != m_dataMap.end());
-    if (iter != m_dataMap.end()) {
-        const StoragePtrList& storageList = iter->second;
-        const size_t nCount = storageList.size();
-        for (size_t index = 0; index < nCount; ++index) {
-            if (storageList[index] != nullptr) {
-                subItemList.push_back(storageList[index]);
-            }
-        }
+    ASSERT(m_pListView != nullptr);
+    if ((iter == m_dataMap.end()) || (m_pListView == nullptr)) {
+        return nMaxWidth;
     }
-    if (!subItemList.empty()) {
-        ASSERT(m_pListView != nullptr);
-        if (m_pListView != nullptr) {
-            nMaxWidth = m_pListView->GetMaxDataItemWidth(subItemList);
+    //分批生成数据，避免同时为所有行分配内存
+    const size_t nBatchSize = 4096;
+    const ListCtrlColumnData& columnData = iter->second;
+    const size_t nCount = columnData.GetRowCount();
+    std::vector<ListCtrlSubItemData2Ptr> subItemList;
+    for (size_t index = 0; index < nCount; ++index) {
+        size_t nTextLength = 0;
+        if (columnData.HasData(index) && (columnData.GetTextData(index, nTextLength) != nullptr)) {
+            //文本为空的数据项，不影响列宽
+            subItemList.push_back(MakeSubItemStorage(columnData, index));
         }
-    }    
+        if (!subItemList.empty() && ((subItemList.size() >= nBatchSize) || ((index + 1) == nCount))) {
+            nMaxWidth = std::max(nMaxWidth, m_pListView->GetMaxDataItemWidth(subItemList));
+            subItemList.clear();
+        }
+    }
     return nMaxWidth;
 }
 
@@ -213,6 +397,7 @@ void ListCtrlData::ChangeDpiScale(const DpiManager& dpiManager, uint32_t nOldDpi
             data.nItemHeight = ui::TruncateToUInt16(dpiManager.GetScaleInt((int32_t)data.nItemHeight, nOldDpiScale));
         }
     }
+    m_heightIndex.Invalidate();
 }
 
 void ListCtrlData::SubItemToStorage(const ListCtrlSubItemData& item, Storage& storage) const
@@ -273,9 +458,9 @@ bool ListCtrlData::AddColumn(size_t columnId)
     if ((columnId == Box::InvalidIndex) || (columnId == 0)) {
         return false;
     }
-    StoragePtrList& storageList = m_dataMap[columnId];
+    ListCtrlColumnData& columnData = m_dataMap[columnId];
     //列的长度与行保持一致
-    storageList.resize(m_rowDataList.size());
+    columnData.ResizeRows(m_rowDataList.size());
     EmitCountChanged();
     return true;
 }
@@ -285,9 +470,15 @@ bool ListCtrlData::RemoveColumn(size_t columnId)
     auto iter = m_dataMap.find(columnId);
     if (iter != m_dataMap.end()) {
         m_dataMap.erase(iter);
+        if (m_sortParam.bValid && (m_sortParam.nColumnId == columnId)) {
+            //排序的列已删除
+            m_sortParam = SortParam();
+        }
         if (m_dataMap.empty()) {
             //如果所有列都删除了，行也清空为0
             m_rowDataList.clear();
+            m_rowOrder.clear();
+            m_heightIndex.Invalidate();
             m_nSelectedIndex = Box::InvalidIndex;
             m_hideRowCount = 0;
             m_heightRowCount = 0;
@@ -305,13 +496,10 @@ bool ListCtrlData::SetColumnCheck(size_t columnId, bool bChecked, bool bRefresh)
     auto iter = m_dataMap.find(columnId);
     ASSERT(iter != m_dataMap.end());
     if (iter != m_dataMap.end()) {
-        StoragePtrList& storageList = iter->second;
-        const size_t nCount = storageList.size();
+        ListCtrlColumnData& columnData = iter->second;
+        const size_t nCount = columnData.GetRowCount();
         for (size_t index = 0; index < nCount; ++index) {
-            if (storageList[index] == nullptr) {
-                storageList[index] = std::make_shared<Storage>();
-            }
-            storageList[index]->bChecked = bChecked;
+            columnData.SetChecked(index, bChecked);
         }
         bRet = true;
     }
@@ -321,41 +509,44 @@ bool ListCtrlData::SetColumnCheck(size_t columnId, bool bChecked, bool bRefresh)
     return bRet;
 }
 
-ListCtrlData::StoragePtr ListCtrlData::GetSubItemStorage(
-    size_t itemIndex, size_t nColumnId) const
+const ListCtrlColumnData* ListCtrlData::GetSubItemColumn(size_t itemIndex, size_t nColumnId, size_t& nRowIndex) const
 {
-    StoragePtr pStorage;
     auto iter = m_dataMap.find(nColumnId);
     ASSERT(iter != m_dataMap.end());
-    if (iter != m_dataMap.end()) {
-        const StoragePtrList& storageList = iter->second;
-        ASSERT(itemIndex < storageList.size());
-        if (itemIndex < storageList.size()) {
-            //关联列：获取数据
-            pStorage = storageList[itemIndex];
+    if ((iter != m_dataMap.end()) && (itemIndex < m_rowDataList.size())) {
+        const ListCtrlColumnData& columnData = iter->second;
+        nRowIndex = GetStorageIndex(itemIndex);
+        ASSERT(nRowIndex < columnData.GetRowCount());
+        if ((nRowIndex < columnData.GetRowCount()) && columnData.HasData(nRowIndex)) {
+            //关联列：有数据
+            return &columnData;
         }
     }
-    return pStorage;
+    return nullptr;
 }
 
-ListCtrlData::StoragePtr ListCtrlData::GetSubItemStorageForWrite(
-    size_t itemIndex, size_t nColumnId)
+ListCtrlColumnData* ListCtrlData::GetSubItemColumnForWrite(size_t itemIndex, size_t nColumnId, size_t& nRowIndex)
 {
-    StoragePtr pStorage;
     auto iter = m_dataMap.find(nColumnId);
     ASSERT(iter != m_dataMap.end());
-    if (iter != m_dataMap.end()) {
-        StoragePtrList& storageList = iter->second;
-        ASSERT(itemIndex < storageList.size());
-        if (itemIndex < storageList.size()) {
-            //关联列：获取数据
-            pStorage = storageList[itemIndex];
-            if (pStorage == nullptr) {
-                pStorage = std::make_shared<Storage>();
-                storageList[itemIndex] = pStorage;
-            }
+    if ((iter != m_dataMap.end()) && (itemIndex < m_rowDataList.size())) {
+        ListCtrlColumnData& columnData = iter->second;
+        nRowIndex = GetStorageIndex(itemIndex);
+        ASSERT(nRowIndex < columnData.GetRowCount());
+        if (nRowIndex < columnData.GetRowCount()) {
+            return &columnData;
         }
     }
+    return nullptr;
+}
+
+ListCtrlData::StoragePtr ListCtrlData::MakeSubItemStorage(const ListCtrlColumnData& columnData, size_t nRowIndex) const
+{
+    StoragePtr pStorage;
+    if (columnData.HasData(nRowIndex)) {
+        pStorage = std::make_shared<Storage>();
+        columnData.GetData(nRowIndex, *pStorage);
+    }
     return pStorage;
 }
 
@@ -366,13 +557,14 @@ bool ListCtrlData::GetSubItemStorageList(size_t itemIndex, std::vector<ListCtrlS
     if (itemIndex >= m_rowDataList.size()) {
         return false;
     }
+    const size_t nRowIndex = GetStorageIndex(itemIndex);
     ListCtrlSubItemData2Pair dataPair;
     for (auto iter = m_dataMap.begin(); iter != m_dataMap.end(); ++iter) {
         dataPair.nColumnId = iter->first;        
-        const StoragePtrList& dataList = iter->second;
-        ASSERT(itemIndex < dataList.size());
-        if (itemIndex < dataList.size()) {
-            dataPair.pSubItemData = dataList.at(itemIndex);
+        const ListCtrlColumnData& columnData = iter->second;
+        ASSERT(nRowIndex < columnData.GetRowCount());
+        if (nRowIndex < columnData.GetRowCount()) {
+            dataPair.pSubItemData = MakeSubItemStorage(columnData, nRowIndex);
         }
         else {
             dataPair.pSubItemData = nullptr;
@@ -393,12 +585,30 @@ bool ListCtrlData::IsNormalMode() const
     return (m_hideRowCount == 0) && (m_heightRowCount == 0) && (m_atTopRowCount == 0);
 }
 
+const ListCtrlHeightIndex& ListCtrlData::GetHeightIndex(int32_t nDefaultItemHeight) const
+{
+    if (!m_heightIndex.IsValid(m_rowDataList.size(), nDefaultItemHeight)) {
+        m_heightIndex.Build(m_rowDataList, nDefaultItemHeight);
+    }
+    return m_heightIndex;
+}
+
+size_t ListCtrlData::GetMemoryBytes() const
+{
+    size_t nBytes = m_rowDataList.capacity() * sizeof(ListCtrlItemData);
+    nBytes += m_heightIndex.GetMemoryBytes();
+    for (auto iter = m_dataMap.begin(); iter != m_dataMap.end(); ++iter) {
+        nBytes += iter->second.GetMemoryBytes();
+    }
+    return nBytes;
+}
+
 size_t ListCtrlData::GetDataItemCount() const
 {
 #ifdef _DEBUG
     auto iter = m_dataMap.begin();
     for (; iter != m_dataMap.end(); ++iter) {
-        ASSERT(iter->second.size() == m_rowDataList.size());
+        ASSERT(iter->second.GetRowCount() == m_rowDataList.size());
     }
 #endif
     return m_rowDataList.size();
@@ -415,12 +625,23 @@ bool ListCtrlData::SetDataItemCount(size_t itemCount)
         return true;
     }
     size_t nOldCount = m_rowDataList.size();
+    if (itemCount < nOldCount) {
+        //行数变少时，删除的是显示顺序中末尾的行，需要先按显示顺序整理列数据
+        ApplyRowOrder();
+    }
+    else if (!m_rowOrder.empty()) {
+        //行数变多时，新增的行追加在显示顺序的末尾
+        for (size_t index = nOldCount; index < itemCount; ++index) {
+            m_rowOrder.push_back((uint32_t)index);
+        }
+    }
     m_rowDataList.resize(itemCount); 
+    m_heightIndex.SetRowCount(itemCount);
     if (m_nSelectedIndex >= m_rowDataList.size()) {
         m_nSelectedIndex = Box::InvalidIndex;
     }
     for (auto iter = m_dataMap.begin(); iter != m_dataMap.end(); ++iter) {
-        iter->second.resize(itemCount);
+        iter->second.ResizeRows(itemCount);
     }
     if (itemCount < nOldCount) {
         //行数变少了
@@ -460,23 +681,25 @@ size_t ListCtrlData::AddDataItem(size_t columnId, const ListCtrlSubItemData& dat
     Storage storage;
     SubItemToStorage(dataItem, storage);
 
-    size_t nDataItemIndex = Box::InvalidIndex;
+    const size_t nRowIndex = m_rowDataList.size();
     for (auto iter = m_dataMap.begin(); iter != m_dataMap.end(); ++iter) {
         size_t id = iter->first;
-        StoragePtrList& storageList = iter->second;
+        ListCtrlColumnData& columnData = iter->second;
+        //其他列：插入空数据
+        columnData.InsertRow(columnData.GetRowCount());
         if (id == columnId) {
             //关联列：保存数据
-            storageList.push_back(std::make_shared<Storage>(storage));
-            nDataItemIndex = storageList.size() - 1;
-        }
-        else {
-            //其他列：插入空数据
-            storageList.push_back(nullptr);
+            columnData.SetData(nRowIndex, storage);
         }
     }
+    if (!m_rowOrder.empty()) {
+        m_rowOrder.push_back((uint32_t)nRowIndex);
+    }
 
     //行数据，插入1条数据
     m_rowDataList.push_back(ListCtrlItemData());
+    m_heightIndex.AppendRow(m_rowDataList.back());
+    const size_t nDataItemIndex = m_rowDataList.size() - 1;
 
     EmitCountChanged();
     return nDataItemIndex;
@@ -496,18 +719,21 @@ bool ListCtrlData::InsertDataItem(size_t itemIndex, size_t columnId, const ListC
     Storage storage;
     SubItemToStorage(dataItem, storage);
 
+    //如果已经排过序，列数据追加在末尾，只在排序索引中插入
+    const size_t nRowIndex = m_rowOrder.empty() ? itemIndex : m_rowDataList.size();
     for (auto iter = m_dataMap.begin(); iter != m_dataMap.end(); ++iter) {
         size_t id = iter->first;
-        StoragePtrList& storageList = iter->second;
+        ListCtrlColumnData& columnData = iter->second;
+        //其他列：插入空数据
+        columnData.InsertRow(nRowIndex);
         if (id == columnId) {
             //关联列：保存数据
-            storageList.insert(storageList.begin() + itemIndex, std::make_shared<Storage>(storage));
-        }
-        else {
-            //其他列：插入空数据
-            storageList.insert(storageList.begin() + itemIndex, nullptr);
+            columnData.SetData(nRowIndex, storage);
         }
     }
+    if (!m_rowOrder.empty()) {
+        m_rowOrder.insert(m_rowOrder.begin() + itemIndex, (uint32_t)nRowIndex);
+    }
 
     //行数据，插入1条数据
     ASSERT(itemIndex < m_rowDataList.size());
@@ -515,6 +741,7 @@ bool ListCtrlData::InsertDataItem(size_t itemIndex, size_t columnId, const ListC
         ++m_nSelectedIndex;
     }
     m_rowDataList.insert(m_rowDataList.begin() + itemIndex, ListCtrlItemData());
+    m_heightIndex.InsertRow(itemIndex, m_rowDataList[itemIndex]);
 
     EmitCountChanged();
     return true;
@@ -527,10 +754,20 @@ bool ListCtrlData::DeleteDataItem(size_t itemIndex)
         return false;
     }
 
+    const size_t nRowIndex = GetStorageIndex(itemIndex);
     for (auto iter = m_dataMap.begin(); iter != m_dataMap.end(); ++iter) {
-        StoragePtrList& storageList = iter->second;
-        if (itemIndex < storageList.size()) {
-            storageList.erase(storageList.begin() + itemIndex);
+        ListCtrlColumnData& columnData = iter->second;
+        if (nRowIndex < columnData.GetRowCount()) {
+            columnData.EraseRow(nRowIndex);
+        }
+    }
+    if (!m_rowOrder.empty()) {
+        //更新排序索引：删除的行之后的行号减1
+        m_rowOrder.erase(m_rowOrder.begin() + itemIndex);
+        for (uint32_t& nOrder : m_rowOrder) {
+            if (nOrder > nRowIndex) {
+                nOrder -= 1;
+            }
         }
     }
 
@@ -546,6 +783,7 @@ bool ListCtrlData::DeleteDataItem(size_t itemIndex)
             }
         }
         m_rowDataList.erase(m_rowDataList.begin() + itemIndex);
+        m_heightIndex.RemoveRow(itemIndex);
         if (!oldData.bVisible) {
             m_hideRowCount -= 1;
             ASSERT(m_hideRowCount >= 0);
@@ -567,18 +805,20 @@ bool ListCtrlData::DeleteAllDataItems()
 {
     bool bDeleted = false;
     for (auto iter = m_dataMap.begin(); iter != m_dataMap.end(); ++iter) {
-        StoragePtrList& storageList = iter->second;
-        if (!storageList.empty()) {
+        ListCtrlColumnData& columnData = iter->second;
+        if (columnData.GetRowCount() != 0) {
             bDeleted = true;
         }
-        StoragePtrList emptyList;
-        storageList.swap(emptyList);
+        columnData.ClearRows();
     }
     //清空行数据
     if (!m_rowDataList.empty()) {
         bDeleted = true;
     }
     m_rowDataList.clear();
+    m_rowOrder.clear();
+    m_sortParam = SortParam();
+    m_heightIndex.Invalidate();
     m_nSelectedIndex = Box::InvalidIndex;
     m_hideRowCount = 0;
     m_heightRowCount = 0;
@@ -607,6 +847,7 @@ bool ListCtrlData::SetDataItemData(size_t itemIndex, const ListCtrlItemData& ite
             m_rowDataList[itemIndex].nItemHeight = -1;
         }
         const ListCtrlItemData& newItemData = m_rowDataList[itemIndex];
+        m_heightIndex.UpdateRow(itemIndex, newItemData);
         if (newItemData.bSelected != oldItemData.bSelected) {
             bChanged = true;
             bItemChanged = true;
@@ -689,6 +930,7 @@ bool ListCtrlData::SetDataItemVisible(size_t itemIndex, bool bVisible, bool& bCh
         bool bOldVisible = rowData.bVisible;
         bChanged = rowData.bVisible != bVisible;
         rowData.bVisible = bVisible;
+        m_heightIndex.UpdateRow(itemIndex, rowData);
 
         if (!bOldVisible && bVisible) {
             m_hideRowCount -= 1;
@@ -919,10 +1161,10 @@ void ListCtrlData::GetColumnCheckStatus(size_t columnId, bool& bChecked, bool& b
     if (iter == m_dataMap.end()) {
         return;
     }
-    const StoragePtrList& sortStorageList = iter->second;
+    const ListCtrlColumnData& columnData = iter->second;
     size_t nCheckCount = 0;
     size_t nUnCheckCount = 0;
-    const size_t nCount = sortStorageList.size();
+    const size_t nCount = columnData.GetRowCount();
     if (nCount == 0) {
         return;
     }
@@ -936,14 +1178,14 @@ void ListCtrlData::GetColumnCheckStatus(size_t columnId, bool& bChecked, bool& b
         if (!rowData.bVisible) {
             continue;
         }
-        const StoragePtr& pStorage = sortStorageList[itemIndex];
-        if (pStorage == nullptr) {
+        const size_t nRowIndex = GetStorageIndex(itemIndex);
+        if (!columnData.HasData(nRowIndex)) {
             continue;
         }
-        if (!pStorage->bShowCheckBox) {
+        if (!columnData.IsShowCheckBox(nRowIndex)) {
             continue;
         }
-        if (pStorage->bChecked) {
+        if (columnData.IsChecked(nRowIndex)) {
             nCheckCount++;
         }
         else {
@@ -1005,6 +1247,7 @@ bool ListCtrlData::SetDataItemAlwaysAtTop(size_t itemIndex, int8_t nAlwaysAtTop,
         int8_t nOldAlwaysAtTop = rowData.nAlwaysAtTop;
         bChanged = rowData.nAlwaysAtTop != nAlwaysAtTop;
         rowData.nAlwaysAtTop = nAlwaysAtTop;
+        m_heightIndex.UpdateRow(itemIndex, rowData);
         if ((nOldAlwaysAtTop >= 0) && (nAlwaysAtTop < 0)) {
             m_atTopRowCount -= 1;
         }
@@ -1048,6 +1291,7 @@ bool ListCtrlData::SetDataItemHeight(size_t itemIndex, int32_t nItemHeight, bool
         bChanged = rowData.nItemHeight != nItemHeight;
         ASSERT(nItemHeight <= INT16_MAX);
         rowData.nItemHeight = (int16_t)nItemHeight;
+        m_heightIndex.UpdateRow(itemIndex, rowData);
         if ((nOldItemHeight >= 0) && (nItemHeight < 0)) {
             m_heightRowCount -= 1;
         }
@@ -1112,22 +1356,15 @@ bool ListCtrlData::SetSubItemData(size_t itemIndex, size_t columnId,
     ASSERT(iter != m_dataMap.end());
     if (iter != m_dataMap.end()) {
         //关联列：更新数据
-        StoragePtrList& storageList = iter->second;
-        ASSERT(itemIndex < storageList.size());
-        if (itemIndex < storageList.size()) {
-            StoragePtr pStorage = storageList[itemIndex];
-            if (pStorage == nullptr) {
-                storageList[itemIndex] = std::make_shared<Storage>(storage);
-                if (storage.bChecked) {
-                    bCheckChanged = true;
-                }
-            }
-            else {
-                if (storage.bChecked != pStorage->bChecked) {
-                    bCheckChanged = true;
-                }
-                *pStorage = storage;
+        ListCtrlColumnData& columnData = iter->second;
+        const size_t nRowIndex = GetStorageIndex(itemIndex);
+        ASSERT(nRowIndex < columnData.GetRowCount());
+        if ((itemIndex < m_rowDataList.size()) && (nRowIndex < columnData.GetRowCount())) {
+            bool bOldChecked = columnData.HasData(nRowIndex) && columnData.IsChecked(nRowIndex);
+            if (storage.bChecked != bOldChecked) {
+                bCheckChanged = true;
             }
+            columnData.SetData(nRowIndex, storage);
             bRet = true;
         }
     }
@@ -1146,12 +1383,13 @@ bool ListCtrlData::GetSubItemData(size_t itemIndex, size_t columnId, ListCtrlSub
     auto iter = m_dataMap.find(columnId);
     ASSERT(iter != m_dataMap.end());
     if (iter != m_dataMap.end()) {
-        const StoragePtrList& storageList = iter->second;
-        ASSERT(itemIndex < storageList.size());
-        if (itemIndex < storageList.size()) {
-            StoragePtr pStorage = storageList[itemIndex];
-            if (pStorage != nullptr) {
-                StorageToSubItem(*pStorage, subItemData);
+        const ListCtrlColumnData& columnData = iter->second;
+        const size_t nRowIndex = GetStorageIndex(itemIndex);
+        ASSERT(nRowIndex < columnData.GetRowCount());
+        if ((itemIndex < m_rowDataList.size()) && (nRowIndex < columnData.GetRowCount())) {
+            Storage storage;
+            if (columnData.GetData(nRowIndex, storage)) {
+                StorageToSubItem(storage, subItemData);
             }
             bRet = true;
         }
@@ -1161,14 +1399,14 @@ bool ListCtrlData::GetSubItemData(size_t itemIndex, size_t columnId, ListCtrlSub
 
 bool ListCtrlData::SetSubItemText(size_t itemIndex, size_t columnId, const DString& text)
 {
-    StoragePtr pStorage = GetSubItemStorageForWrite(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    size_t nRowIndex = 0;
+    ListCtrlColumnData* pColumnData = GetSubItemColumnForWrite(itemIndex, columnId, nRowIndex);
+    ASSERT(pColumnData != nullptr);
+    if (pColumnData == nullptr) {
         //索引号无效
         return false;
     }
-    if (pStorage->text != text) {
-        pStorage->text = text;
+    if (pColumnData->SetText(nRowIndex, text)) {
         EmitDataChanged(itemIndex, itemIndex);
     }    
     return true;
@@ -1176,25 +1414,26 @@ bool ListCtrlData::SetSubItemText(size_t itemIndex, size_t columnId, const DStri
 
 DString ListCtrlData::GetSubItemText(size_t itemIndex, size_t columnId) const
 {
-    StoragePtr pStorage = GetSubItemStorage(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    size_t nRowIndex = 0;
+    const ListCtrlColumnData* pColumnData = GetSubItemColumn(itemIndex, columnId, nRowIndex);
+    ASSERT(pColumnData != nullptr);
+    if (pColumnData == nullptr) {
         //索引号无效
         return DString();
     }
-    return pStorage->text.c_str();
+    return pColumnData->GetText(nRowIndex);
 }
 
 bool ListCtrlData::SetSubItemSortGroup(size_t itemIndex, size_t columnId, int32_t nSortGroup)
 {
-    StoragePtr pStorage = GetSubItemStorageForWrite(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    size_t nRowIndex = 0;
+    ListCtrlColumnData* pColumnData = GetSubItemColumnForWrite(itemIndex, columnId, nRowIndex);
+    ASSERT(pColumnData != nullptr);
+    if (pColumnData == nullptr) {
         //索引号无效
         return false;
     }
-    if (pStorage->nSortGroup != nSortGroup) {
-        pStorage->nSortGroup = nSortGroup;
+    if (pColumnData->SetSortGroup(nRowIndex, nSortGroup)) {
         EmitDataChanged(itemIndex, itemIndex);
     }
     return true;
@@ -1202,25 +1441,26 @@ bool ListCtrlData::SetSubItemSortGroup(size_t itemIndex, size_t columnId, int32_
 
 int32_t ListCtrlData::GetSubItemSortGroup(size_t itemIndex, size_t columnId) const
 {
-    StoragePtr pStorage = GetSubItemStorage(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    size_t nRowIndex = 0;
+    const ListCtrlColumnData* pColumnData = GetSubItemColumn(itemIndex, columnId, nRowIndex);
+    ASSERT(pColumnData != nullptr);
+    if (pColumnData == nullptr) {
         //索引号无效
         return 0;
     }
-    return pStorage->nSortGroup;
+    return pColumnData->GetSortGroup(nRowIndex);
 }
 
 bool ListCtrlData::SetSubItemUserDataN(size_t itemIndex, size_t columnId, uint64_t userDataN)
 {
-    StoragePtr pStorage = GetSubItemStorageForWrite(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    size_t nRowIndex = 0;
+    ListCtrlColumnData* pColumnData = GetSubItemColumnForWrite(itemIndex, columnId, nRowIndex);
+    ASSERT(pColumnData != nullptr);
+    if (pColumnData == nullptr) {
         //索引号无效
         return false;
     }
-    if (pStorage->userDataN != userDataN) {
-        pStorage->userDataN = userDataN;
+    if (pColumnData->SetUserDataN(nRowIndex, userDataN)) {
         EmitDataChanged(itemIndex, itemIndex);
     }
     return true;
@@ -1228,25 +1468,26 @@ bool ListCtrlData::SetSubItemUserDataN(size_t itemIndex, size_t columnId, uint64
 
 uint64_t ListCtrlData::GetSubItemUserDataN(size_t itemIndex, size_t columnId) const
 {
-    StoragePtr pStorage = GetSubItemStorage(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    size_t nRowIndex = 0;
+    const ListCtrlColumnData* pColumnData = GetSubItemColumn(itemIndex, columnId, nRowIndex);
+    ASSERT(pColumnData != nullptr);
+    if (pColumnData == nullptr) {
         //索引号无效
         return 0;
     }
-    return pStorage->userDataN;
+    return pColumnData->GetUserDataN(nRowIndex);
 }
 
 bool ListCtrlData::SetSubItemUserDataS(size_t itemIndex, size_t columnId, const DString& userDataS)
 {
-    StoragePtr pStorage = GetSubItemStorageForWrite(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    size_t nRowIndex = 0;
+    ListCtrlColumnData* pColumnData = GetSubItemColumnForWrite(itemIndex, columnId, nRowIndex);
+    ASSERT(pColumnData != nullptr);
+    if (pColumnData == nullptr) {
         //索引号无效
         return false;
     }
-    if (pStorage->userDataS != userDataS) {
-        pStorage->userDataS = userDataS;
+    if (pColumnData->SetUserDataS(nRowIndex, userDataS)) {
         EmitDataChanged(itemIndex, itemIndex);
     }
     return true;
@@ -1254,25 +1495,26 @@ bool ListCtrlData::SetSubItemUserDataS(size_t itemIndex, size_t columnId, const
 
 DString ListCtrlData::GetSubItemUserDataS(size_t itemIndex, size_t columnId) const
 {
-    StoragePtr pStorage = GetSubItemStorage(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    size_t nRowIndex = 0;
+    const ListCtrlColumnData* pColumnData = GetSubItemColumn(itemIndex, columnId, nRowIndex);
+    ASSERT(pColumnData != nullptr);
+    if (pColumnData == nullptr) {
         //索引号无效
         return DString();
     }
-    return pStorage->userDataS.c_str();
+    return pColumnData->GetUserDataS(nRowIndex);
 }
 
 bool ListCtrlData::SetSubItemTextColor(size_t itemIndex, size_t columnId, const UiColor& textColor)
 {
-    StoragePtr pStorage = GetSubItemStorageForWrite(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    size_t nRowIndex = 0;
+    ListCtrlColumnData* pColumnData = GetSubItemColumnForWrite(itemIndex, columnId, nRowIndex);
+    ASSERT(pColumnData != nullptr);
+    if (pColumnData == nullptr) {
         //索引号无效
         return false;
     }
-    if (pStorage->textColor != textColor) {
-        pStorage->textColor = textColor;
+    if (pColumnData->SetTextColor(nRowIndex, textColor)) {
         EmitDataChanged(itemIndex, itemIndex);
     }    
     return true;
@@ -1281,27 +1523,28 @@ bool ListCtrlData::SetSubItemTextColor(size_t itemIndex, size_t columnId, const
 bool ListCtrlData::GetSubItemTextColor(size_t itemIndex, size_t columnId, UiColor& textColor) const
 {
     textColor = UiColor();
-    StoragePtr pStorage = GetSubItemStorage(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    size_t nRowIndex = 0;
+    const ListCtrlColumnData* pColumnData = GetSubItemColumn(itemIndex, columnId, nRowIndex);
+    ASSERT(pColumnData != nullptr);
+    if (pColumnData == nullptr) {
         //索引号无效
         return false;
     }
-    textColor = pStorage->textColor;
+    textColor = pColumnData->GetTextColor(nRowIndex);
     return true;
 }
 
 bool ListCtrlData::SetSubItemTextFormat(size_t itemIndex, size_t columnId, int32_t nTextFormat)
 {
-    StoragePtr pStorage = GetSubItemStorageForWrite(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    size_t nRowIndex = 0;
+    ListCtrlColumnData* pColumnData = GetSubItemColumnForWrite(itemIndex, columnId, nRowIndex);
+    ASSERT(pColumnData != nullptr);
+    if (pColumnData == nullptr) {
         //索引号无效
         return false;
     }
     int32_t nValidTextFormat = (int32_t)Label::GetValidTextStyle(nTextFormat);
-    if (pStorage->nTextFormat != nValidTextFormat) {
-        pStorage->nTextFormat = ui::TruncateToUInt16(nValidTextFormat);
+    if (pColumnData->SetTextFormat(nRowIndex, ui::TruncateToUInt16(nValidTextFormat))) {
         EmitDataChanged(itemIndex, itemIndex);
     }
     return true;
@@ -1310,10 +1553,11 @@ bool ListCtrlData::SetSubItemTextFormat(size_t itemIndex, size_t columnId, int32
 int32_t ListCtrlData::GetSubItemTextFormat(size_t itemIndex, size_t columnId) const
 {
     int32_t nTextFormat = 0;
-    StoragePtr pStorage = GetSubItemStorage(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage != nullptr) {
-        nTextFormat = pStorage->nTextFormat;
+    size_t nRowIndex = 0;
+    const ListCtrlColumnData* pColumnData = GetSubItemColumn(itemIndex, columnId, nRowIndex);
+    ASSERT(pColumnData != nullptr);
+    if (pColumnData != nullptr) {
+        nTextFormat = pColumnData->GetTextFormat(nRowIndex);
         if (nTextFormat <= 0) {
             nTextFormat = m_nDefaultTextStyle;
         }
@@ -1323,14 +1567,14 @@ int32_t ListCtrlData::GetSubItemTextFormat(size_t itemIndex, size_t columnId) co
 
 bool ListCtrlData::SetSubItemBkColor(size_t itemIndex, size_t columnId, const UiColor& bkColor)
 {
-    StoragePtr pStorage = GetSubItemStorageForWrite(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    size_t nRowIndex = 0;
+    ListCtrlColumnData* pColumnData = GetSubItemColumnForWrite(itemIndex, columnId, nRowIndex);
+    ASSERT(pColumnData != nullptr);
+    if (pColumnData == nullptr) {
         //索引号无效
         return false;
     }
-    if (pStorage->bkColor != bkColor) {
-        pStorage->bkColor = bkColor;
+    if (pColumnData->SetBkColor(nRowIndex, bkColor)) {
         EmitDataChanged(itemIndex, itemIndex);
     }    
     return true;
@@ -1339,37 +1583,39 @@ bool ListCtrlData::SetSubItemBkColor(size_t itemIndex, size_t columnId, const Ui
 bool ListCtrlData::GetSubItemBkColor(size_t itemIndex, size_t columnId, UiColor& bkColor) const
 {
     bkColor = UiColor();
-    StoragePtr pStorage = GetSubItemStorage(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    size_t nRowIndex = 0;
+    const ListCtrlColumnData* pColumnData = GetSubItemColumn(itemIndex, columnId, nRowIndex);
+    ASSERT(pColumnData != nullptr);
+    if (pColumnData == nullptr) {
         //索引号无效
         return false;
     }
-    bkColor = pStorage->bkColor;
+    bkColor = pColumnData->GetBkColor(nRowIndex);
     return true;
 }
 
 bool ListCtrlData::IsSubItemShowCheckBox(size_t itemIndex, size_t columnId) const
 {
-    StoragePtr pStorage = GetSubItemStorage(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    size_t nRowIndex = 0;
+    const ListCtrlColumnData* pColumnData = GetSubItemColumn(itemIndex, columnId, nRowIndex);
+    ASSERT(pColumnData != nullptr);
+    if (pColumnData == nullptr) {
         //索引号无效
         return false;
     }
-    return pStorage->bShowCheckBox;
+    return pColumnData->IsShowCheckBox(nRowIndex);
 }
 
 bool ListCtrlData::SetSubItemShowCheckBox(size_t itemIndex, size_t columnId, bool bShowCheckBox)
 {
-    StoragePtr pStorage = GetSubItemStorageForWrite(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    size_t nRowIndex = 0;
+    ListCtrlColumnData* pColumnData = GetSubItemColumnForWrite(itemIndex, columnId, nRowIndex);
+    ASSERT(pColumnData != nullptr);
+    if (pColumnData == nullptr) {
         //索引号无效
         return false;
     }
-    if (pStorage->bShowCheckBox != bShowCheckBox) {
-        pStorage->bShowCheckBox = bShowCheckBox;
+    if (pColumnData->SetShowCheckBox(nRowIndex, bShowCheckBox)) {
         EmitDataChanged(itemIndex, itemIndex);
     }    
     return true;
@@ -1377,16 +1623,16 @@ bool ListCtrlData::SetSubItemShowCheckBox(size_t itemIndex, size_t columnId, boo
 
 bool ListCtrlData::SetSubItemCheck(size_t itemIndex, size_t columnId, bool bChecked, bool bRefresh)
 {
-    StoragePtr pStorage = GetSubItemStorageForWrite(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    size_t nRowIndex = 0;
+    ListCtrlColumnData* pColumnData = GetSubItemColumnForWrite(itemIndex, columnId, nRowIndex);
+    ASSERT(pColumnData != nullptr);
+    if (pColumnData == nullptr) {
         //索引号无效
         return false;
     }
-    ASSERT(pStorage->bShowCheckBox);
-    if (pStorage->bShowCheckBox) {
-        if (pStorage->bChecked != bChecked) {
-            pStorage->bChecked = bChecked;
+    ASSERT(pColumnData->IsShowCheckBox(nRowIndex));
+    if (pColumnData->IsShowCheckBox(nRowIndex)) {
+        if (pColumnData->SetChecked(nRowIndex, bChecked)) {
             if (bRefresh) {
                 EmitDataChanged(itemIndex, itemIndex);
             }            
@@ -1399,15 +1645,16 @@ bool ListCtrlData::SetSubItemCheck(size_t itemIndex, size_t columnId, bool bChec
 bool ListCtrlData::GetSubItemCheck(size_t itemIndex, size_t columnId, bool& bChecked) const
 {
     bChecked = false;
-    StoragePtr pStorage = GetSubItemStorage(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    size_t nRowIndex = 0;
+    const ListCtrlColumnData* pColumnData = GetSubItemColumn(itemIndex, columnId, nRowIndex);
+    ASSERT(pColumnData != nullptr);
+    if (pColumnData == nullptr) {
         //索引号无效
         return false;
     }
-    ASSERT(pStorage->bShowCheckBox);
-    if (pStorage->bShowCheckBox) {
-        bChecked = pStorage->bChecked;
+    ASSERT(pColumnData->IsShowCheckBox(nRowIndex));
+    if (pColumnData->IsShowCheckBox(nRowIndex)) {
+        bChecked = pColumnData->IsChecked(nRowIndex);
         return true;
     }
     return false;
@@ -1415,17 +1662,17 @@ bool ListCtrlData::GetSubItemCheck(size_t itemIndex, size_t columnId, bool& bChe
 
 bool ListCtrlData::SetSubItemImageId(size_t itemIndex, size_t columnId, int32_t imageId)
 {
-    StoragePtr pStorage = GetSubItemStorageForWrite(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    size_t nRowIndex = 0;
+    ListCtrlColumnData* pColumnData = GetSubItemColumnForWrite(itemIndex, columnId, nRowIndex);
+    ASSERT(pColumnData != nullptr);
+    if (pColumnData == nullptr) {
         //索引号无效
         return false;
     }
     if (imageId < -1) {
         imageId = -1;
     }
-    if (pStorage->nImageId != imageId) {
-        pStorage->nImageId = imageId;
+    if (pColumnData->SetImageId(nRowIndex, imageId)) {
         EmitDataChanged(itemIndex, itemIndex);
     }
     return true;
@@ -1434,24 +1681,25 @@ bool ListCtrlData::SetSubItemImageId(size_t itemIndex, size_t columnId, int32_t
 int32_t ListCtrlData::GetSubItemImageId(size_t itemIndex, size_t columnId) const
 {
     int32_t nImageId = -1;
-    StoragePtr pStorage = GetSubItemStorage(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage != nullptr) {
-        nImageId = pStorage->nImageId;
+    size_t nRowIndex = 0;
+    const ListCtrlColumnData* pColumnData = GetSubItemColumn(itemIndex, columnId, nRowIndex);
+    ASSERT(pColumnData != nullptr);
+    if (pColumnData != nullptr) {
+        nImageId = pColumnData->GetImageId(nRowIndex);
     }
     return nImageId;
 }
 
 bool ListCtrlData::SetSubItemEditable(size_t itemIndex, size_t columnId, bool bEditable)
 {
-    StoragePtr pStorage = GetSubItemStorageForWrite(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage == nullptr) {
+    size_t nRowIndex = 0;
+    ListCtrlColumnData* pColumnData = GetSubItemColumnForWrite(itemIndex, columnId, nRowIndex);
+    ASSERT(pColumnData != nullptr);
+    if (pColumnData == nullptr) {
         //索引号无效
         return false;
     }
-    if (pStorage->bEditable != bEditable) {
-        pStorage->bEditable = bEditable;
+    if (pColumnData->SetEditable(nRowIndex, bEditable)) {
         EmitDataChanged(itemIndex, itemIndex);
     }
     return true;
@@ -1460,10 +1708,11 @@ bool ListCtrlData::SetSubItemEditable(size_t itemIndex, size_t columnId, bool bE
 bool ListCtrlData::IsSubItemEditable(size_t itemIndex, size_t columnId) const
 {
     bool bEditable = false;
-    StoragePtr pStorage = GetSubItemStorage(itemIndex, columnId);
-    ASSERT(pStorage != nullptr);
-    if (pStorage != nullptr) {
-        bEditable = pStorage->bEditable;
+    size_t nRowIndex = 0;
+    const ListCtrlColumnData* pColumnData = GetSubItemColumn(itemIndex, columnId, nRowIndex);
+    ASSERT(pColumnData != nullptr);
+    if (pColumnData != nullptr) {
+        bEditable = pColumnData->IsEditable(nRowIndex);
     }
     return bEditable;
 }
@@ -1472,113 +1721,326 @@ bool ListCtrlData::SortDataItems(size_t nColumnId, size_t nColumnIndex,
                                  bool bSortedUp, uint8_t nSortFlag,
                                  ListCtrlDataCompareFunc pfnCompareFunc, void* pUserData)
 {
-    StorageMap::iterator iter = m_dataMap.find(nColumnId);
+    ColumnDataMap::iterator iter = m_dataMap.find(nColumnId);
     ASSERT(iter != m_dataMap.end());
     if (iter == m_dataMap.end()) {
         return false;
     }
-    StoragePtrList sortStorageList = iter->second;
-    if (sortStorageList.empty()) {
+    const ListCtrlColumnData& sortColumnData = iter->second;
+    const size_t dataCount = m_rowDataList.size();
+    ASSERT(sortColumnData.GetRowCount() == dataCount);
+    ASSERT(dataCount <= UINT32_MAX);
+    if ((dataCount == 0) || (sortColumnData.GetRowCount() != dataCount) || (dataCount > UINT32_MAX)) {
         return false;
     }
-    std::vector<StorageData> sortedDataList;
-    const size_t dataCount = sortStorageList.size();
+    if (pfnCompareFunc == nullptr) {
+        //如果无有效参数，则使用外部设置的排序函数
+        pfnCompareFunc = m_pfnCompareFunc;
+        pUserData = m_pUserData;
+    }
+
+    //排序的对象是数据项的索引号，初始为当前的显示顺序，稳定排序保证关键字相同的数据项保持原来的顺序，
+    //因此先后按多个列排序时，可实现多列排序的效果
+    std::vector<uint32_t> sortedIndexs;
+    sortedIndexs.resize(dataCount);
     for (size_t index = 0; index < dataCount; ++index) {
-        sortedDataList.push_back({index, sortStorageList[index] });
-    }    
-    SortStorageData(sortedDataList, nColumnId, nColumnIndex, bSortedUp, nSortFlag, pfnCompareFunc, pUserData);
-
-    //对原数据进行顺序调整
-    const size_t sortedDataCount = sortedDataList.size();
-    StoragePtrList orgStorageList; //副本数据
-    for (iter = m_dataMap.begin(); iter != m_dataMap.end(); ++iter) {
-        orgStorageList = iter->second; 
-        StoragePtrList& storageList = iter->second;   //修改目标
-        ASSERT(storageList.size() == sortedDataList.size());
-        if (storageList.size() != sortedDataList.size()) {
-            return false;
+        sortedIndexs[index] = (uint32_t)index;
+    }
+
+    if (pfnCompareFunc != nullptr) {
+        //使用自定义的比较函数排序：比较函数不一定是线程安全的，在当前线程中排序
+        ListCtrlCompareParam param;
+        param.nColumnId = nColumnId;
+        param.nColumnIndex = nColumnIndex;
+        param.nSortFlag = nSortFlag;
+        param.pUserData = pUserData;
+        ColumnDataLess columnDataLess(sortColumnData, pfnCompareFunc, param);
+        std::stable_sort(sortedIndexs.begin(), sortedIndexs.end(), [&](uint32_t a, uint32_t b) {
+                //实现(a < b)的比较逻辑，降序时交换比较参数
+                if (bSortedUp) {
+                    return columnDataLess(GetStorageIndex(a), GetStorageIndex(b));
+                }
+                else {
+                    return columnDataLess(GetStorageIndex(b), GetStorageIndex(a));
+                }
+            });
+    }
+    else {
+        //使用默认的比较函数：预先计算排序关键字，数据量大时并行排序
+        std::vector<SortKey> sortKeys;
+        std::vector<DString::value_type> keyBuffer;
+        MakeSortKeys(sortColumnData, nSortFlag, sortKeys, keyBuffer);
+        const SortKey* pSortKeys = sortKeys.data();
+        if (bSortedUp) {
+            ParallelStableSort(sortedIndexs, [pSortKeys, nSortFlag](uint32_t a, uint32_t b) {
+                    return SortKeyLess(pSortKeys[a], pSortKeys[b], nSortFlag);
+                });
         }
-        for (size_t index = 0; index < sortedDataCount; ++index) {
-            const StorageData& sortedData = sortedDataList[index];
-            storageList[index] = orgStorageList[sortedData.index]; //赋值原数据
+        else {
+            ParallelStableSort(sortedIndexs, [pSortKeys, nSortFlag](uint32_t a, uint32_t b) {
+                    return SortKeyLess(pSortKeys[b], pSortKeys[a], nSortFlag);
+                });
         }
     }
+    ApplySortedIndexs(sortedIndexs);
 
-    //对行数据进行排序
-    bool bFoundSelectedIndex = false;
+    m_sortParam.bValid = true;
+    m_sortParam.nColumnId = nColumnId;
+    m_sortParam.nColumnIndex = nColumnIndex;
+    m_sortParam.bSortedUp = bSortedUp;
+    m_sortParam.nSortFlag = nSortFlag;
+    m_sortParam.pfnCompareFunc = pfnCompareFunc;
+    m_sortParam.pUserData = pUserData;
+
+    EmitCountChanged();
+    return true;
+}
+
+void ListCtrlData::ApplySortedIndexs(const std::vector<uint32_t>& sortedIndexs)
+{
+    //只调整显示顺序（排序索引）和行属性数据，列数据不移动
+    const size_t sortedDataCount = sortedIndexs.size();
     ASSERT(sortedDataCount == m_rowDataList.size());
-    RowDataList rowDataList = m_rowDataList;
+    if (sortedDataCount != m_rowDataList.size()) {
+        return;
+    }
+    std::vector<uint32_t> rowOrder;
+    rowOrder.resize(sortedDataCount);
+    RowDataList rowDataList;
+    rowDataList.resize(sortedDataCount);
+    bool bFoundSelectedIndex = false;
     for (size_t index = 0; index < sortedDataCount; ++index) {
-        const StorageData& sortedData = sortedDataList[index];
-        m_rowDataList[index] = rowDataList[sortedData.index]; //赋值原数据
-        if (!bFoundSelectedIndex && (m_nSelectedIndex == sortedData.index)) {
+        const size_t nOldIndex = sortedIndexs[index];
+        rowOrder[index] = (uint32_t)GetStorageIndex(nOldIndex);
+        rowDataList[index] = m_rowDataList[nOldIndex]; //赋值原数据
+        if (!bFoundSelectedIndex && (m_nSelectedIndex == nOldIndex)) {
             m_nSelectedIndex = index;
             bFoundSelectedIndex = true;
         }
     }
+    m_rowOrder.swap(rowOrder);
+    m_rowDataList.swap(rowDataList);
+    m_heightIndex.Invalidate();
+}
 
-    EmitCountChanged();
-    return true;
+size_t ListCtrlData::ResortDataItem(size_t itemIndex)
+{
+    const size_t nCount = m_rowDataList.size();
+    ASSERT(itemIndex < nCount);
+    if (!m_sortParam.bValid || (itemIndex >= nCount)) {
+        return Box::InvalidIndex;
+    }
+    auto iter = m_dataMap.find(m_sortParam.nColumnId);
+    if (iter == m_dataMap.end()) {
+        return Box::InvalidIndex;
+    }
+    const ListCtrlColumnData& sortColumnData = iter->second;
+    const bool bSortedUp = m_sortParam.bSortedUp;
+    const uint8_t nSortFlag = m_sortParam.nSortFlag;
+
+    //比较函数：数据项 < 第nOtherIndex个数据项
+    std::function<bool(size_t nOtherIndex)> itemLess;
+    SortKey itemKey;
+    DString itemKeyBuffer;
+    ListCtrlCompareParam param;
+    if (m_sortParam.pfnCompareFunc != nullptr) {
+        param.nColumnId = m_sortParam.nColumnId;
+        param.nColumnIndex = m_sortParam.nColumnIndex;
+        param.nSortFlag = nSortFlag;
+        param.pUserData = m_sortParam.pUserData;
+        const size_t nItemRowIndex = GetStorageIndex(itemIndex);
+        itemLess = [&, nItemRowIndex, columnDataLess = ColumnDataLess(sortColumnData, m_sortParam.pfnCompareFunc, param)]
+            (size_t nOtherIndex) mutable {
+                const size_t nOtherRowIndex = GetStorageIndex(nOtherIndex);
+                return bSortedUp ? columnDataLess(nItemRowIndex, nOtherRowIndex) :
+                                   columnDataLess(nOtherRowIndex, nItemRowIndex);
+            };
+    }
+    else {
+        MakeSortKey(sortColumnData, GetStorageIndex(itemIndex), nSortFlag, itemKey, itemKeyBuffer);
+        itemLess = [&](size_t nOtherIndex) {
+                SortKey otherKey;
+                DString otherKeyBuffer;
+                MakeSortKey(sortColumnData, GetStorageIndex(nOtherIndex), nSortFlag, otherKey, otherKeyBuffer);
+                return bSortedUp ? SortKeyLess(itemKey, otherKey, nSortFlag) :
+                                   SortKeyLess(otherKey, itemKey, nSortFlag);
+            };
+    }
+
+    //在除去该数据项后的有序序列中二分查找插入位置（插入到相等的数据项之后）
+    size_t nLow = 0;
+    size_t nHigh = nCount - 1;
+    while (nLow < nHigh) {
+        const size_t nMid = nLow + (nHigh - nLow) / 2;
+        const size_t nOtherIndex = (nMid < itemIndex) ? nMid : (nMid + 1);
+        if (itemLess(nOtherIndex)) {
+            nHigh = nMid;
+        }
+        else {
+            nLow = nMid + 1;
+        }
+    }
+    const size_t nNewItemIndex = nLow;
+    if (nNewItemIndex != itemIndex) {
+        MoveDataItem(itemIndex, nNewItemIndex);
+        if (IsNormalMode()) {
+            EmitDataChanged(std::min(itemIndex, nNewItemIndex), std::max(itemIndex, nNewItemIndex));
+        }
+        else {
+            EmitCountChanged();
+        }
+    }
+    return nNewItemIndex;
 }
 
-bool ListCtrlData::SortStorageData(std::vector<StorageData>& dataList, size_t nColumnId, size_t nColumnIndex,
-                                   bool bSortedUp, uint8_t nSortFlag,
-                                   ListCtrlDataCompareFunc pfnCompareFunc, void* pUserData)
+void ListCtrlData::MoveDataItem(size_t nFromIndex, size_t nToIndex)
 {
-    if (dataList.empty()) {
-        return false;
+    const size_t nCount = m_rowDataList.size();
+    ASSERT((nFromIndex < nCount) && (nToIndex < nCount));
+    if ((nFromIndex >= nCount) || (nToIndex >= nCount) || (nFromIndex == nToIndex)) {
+        return;
+    }
+    if (m_rowOrder.empty()) {
+        m_rowOrder.resize(nCount);
+        for (size_t index = 0; index < nCount; ++index) {
+            m_rowOrder[index] = (uint32_t)index;
+        }
+    }
+    if (nFromIndex < nToIndex) {
+        std::rotate(m_rowOrder.begin() + nFromIndex, m_rowOrder.begin() + nFromIndex + 1, m_rowOrder.begin() + nToIndex + 1);
+        std::rotate(m_rowDataList.begin() + nFromIndex, m_rowDataList.begin() + nFromIndex + 1, m_rowDataList.begin() + nToIndex + 1);
+        if (m_nSelectedIndex == nFromIndex) {
+            m_nSelectedIndex = nToIndex;
+        }
+        else if ((m_nSelectedIndex > nFromIndex) && (m_nSelectedIndex <= nToIndex)) {
+            m_nSelectedIndex -= 1;
+        }
+    }
+    else {
+        std::rotate(m_rowOrder.begin() + nToIndex, m_rowOrder.begin() + nFromIndex, m_rowOrder.begin() + nFromIndex + 1);
+        std::rotate(m_rowDataList.begin() + nToIndex, m_rowDataList.begin() + nFromIndex, m_rowDataList.begin() + nFromIndex + 1);
+        if (m_nSelectedIndex == nFromIndex) {
+            m_nSelectedIndex = nToIndex;
+        }
+        else if ((m_nSelectedIndex >= nToIndex) && (m_nSelectedIndex < nFromIndex)) {
+            m_nSelectedIndex += 1;
+        }
     }
+    //更新行高索引：只有移动范围内的行发生了变化
+    const size_t nEndIndex = std::max(nFromIndex, nToIndex);
+    for (size_t index = std::min(nFromIndex, nToIndex); index <= nEndIndex; ++index) {
+        m_heightIndex.UpdateRow(index, m_rowDataList[index]);
+    }
+}
 
-    if (pfnCompareFunc == nullptr) {
-        //如果无有效参数，则使用外部设置的排序函数
-        pfnCompareFunc = m_pfnCompareFunc;
-        pUserData = m_pUserData;
+size_t ListCtrlData::GetStorageIndex(size_t itemIndex) const
+{
+    if (m_rowOrder.empty()) {
+        return itemIndex;
     }
+    ASSERT(itemIndex < m_rowOrder.size());
+    return (itemIndex < m_rowOrder.size()) ? m_rowOrder[itemIndex] : itemIndex;
+}
 
-    if (pfnCompareFunc != nullptr) {
-        //使用自定义的比较函数排序
-        ListCtrlCompareParam param;
-        param.nColumnId = nColumnId;
-        param.nColumnIndex = nColumnIndex;
-        param.nSortFlag = nSortFlag;
-        param.pUserData = pUserData;
-        std::sort(dataList.begin(), dataList.end(), [this, pfnCompareFunc, &param](const StorageData& a, const StorageData& b) {
-                //实现(a < b)的比较逻辑
-                if (b.pStorage == nullptr) {
-                    return false;
-                }
-                if (a.pStorage == nullptr) {
-                    return true;
-                }
-                const Storage& storageA = *a.pStorage;
-                const Storage& storageB = *b.pStorage;
-                return pfnCompareFunc(storageA, storageB, param);
-            });
+void ListCtrlData::ApplyRowOrder()
+{
+    if (m_rowOrder.empty()) {
+        return;
+    }
+    std::vector<size_t> rowOrder(m_rowOrder.begin(), m_rowOrder.end());
+    for (auto iter = m_dataMap.begin(); iter != m_dataMap.end(); ++iter) {
+        iter->second.ReorderRows(rowOrder);
+    }
+    std::vector<uint32_t> emptyOrder;
+    m_rowOrder.swap(emptyOrder);
+}
+
+void ListCtrlData::MakeSortKeys(const ListCtrlColumnData& columnData, uint8_t nSortFlag,
+                                std::vector<SortKey>& sortKeys, std::vector<DString::value_type>& keyBuffer) const
+{
+    const size_t nCount = m_rowDataList.size();
+    sortKeys.clear();
+    sortKeys.resize(nCount);
+    keyBuffer.clear();
+    const bool bByNumber = (nSortFlag & ListCtrlSubItemSortFlag::kSortByUserDataN) != 0;
+    const bool bByUserDataS = !bByNumber && ((nSortFlag & ListCtrlSubItemSortFlag::kSortByUserDataS) != 0);
+    const bool bNoCase = !bByNumber && ((nSortFlag & ListCtrlSubItemSortFlag::kSortNoCase) != 0);
+    for (size_t index = 0; index < nCount; ++index) {
+        const size_t nRowIndex = GetStorageIndex(index);
+        SortKey& sortKey = sortKeys[index];
+        sortKey.bHasData = columnData.HasData(nRowIndex);
+        if (!sortKey.bHasData) {
+            continue;
+        }
+        sortKey.nSortGroup = columnData.GetSortGroup(nRowIndex);
+        if (bByNumber) {
+            sortKey.nNumber = columnData.GetUserDataN(nRowIndex);
+        }
+        else if (bByUserDataS) {
+            sortKey.pText = columnData.GetUserDataSData(nRowIndex, sortKey.nTextLength);
+        }
+        else {
+            sortKey.pText = columnData.GetTextData(nRowIndex, sortKey.nTextLength);
+        }
+    }
+    if (bNoCase) {
+        //不区分大小写：预先转换为小写，排序时直接比较
+        size_t nTotalLength = 0;
+        for (const SortKey& sortKey : sortKeys) {
+            nTotalLength += sortKey.nTextLength;
+        }
+        keyBuffer.reserve(nTotalLength);
+        for (SortKey& sortKey : sortKeys) {
+            if (sortKey.nTextLength == 0) {
+                continue;
+            }
+            const size_t nOffset = keyBuffer.size();
+            for (size_t i = 0; i < sortKey.nTextLength; ++i) {
+                keyBuffer.push_back(FoldCase(sortKey.pText[i]));
+            }
+            sortKey.pText = keyBuffer.data() + nOffset;
+        }
+    }
+}
+
+void ListCtrlData::MakeSortKey(const ListCtrlColumnData& columnData, size_t nRowIndex, uint8_t nSortFlag,
+                               SortKey& sortKey, DString& keyBuffer) const
+{
+    sortKey = SortKey();
+    keyBuffer.clear();
+    sortKey.bHasData = columnData.HasData(nRowIndex);
+    if (!sortKey.bHasData) {
+        return;
+    }
+    sortKey.nSortGroup = columnData.GetSortGroup(nRowIndex);
+    if (nSortFlag & ListCtrlSubItemSortFlag::kSortByUserDataN) {
+        sortKey.nNumber = columnData.GetUserDataN(nRowIndex);
+        return;
+    }
+    if (nSortFlag & ListCtrlSubItemSortFlag::kSortByUserDataS) {
+        sortKey.pText = columnData.GetUserDataSData(nRowIndex, sortKey.nTextLength);
     }
     else {
-        //排序：升序，使用默认的排序函数
-        std::sort(dataList.begin(), dataList.end(), [this, nSortFlag](const StorageData& a, const StorageData& b) {
-                //实现(a < b)的比较逻辑
-                if (b.pStorage == nullptr) {
-                    return false;
-                }
-                if (a.pStorage == nullptr) {
-                    return true;
-                }
-                const Storage& storageA = *a.pStorage;
-                const Storage& storageB = *b.pStorage;
-                return SortDataCompareFunc(storageA, storageB, nSortFlag);
-            });
+        sortKey.pText = columnData.GetTextData(nRowIndex, sortKey.nTextLength);
     }
-    if (!bSortedUp) {
-        //降序
-        std::reverse(dataList.begin(), dataList.end());
+    if ((nSortFlag & ListCtrlSubItemSortFlag::kSortNoCase) && (sortKey.nTextLength > 0)) {
+        keyBuffer.assign(sortKey.pText, sortKey.nTextLength);
+        for (DString::value_type& ch : keyBuffer) {
+            ch = FoldCase(ch);
+        }
+        sortKey.pText = keyBuffer.c_str();
     }
-    return true;
 }
 
-bool ListCtrlData::SortDataCompareFunc(const ListCtrlSubItemData2& a, const ListCtrlSubItemData2& b, uint8_t nSortFlag) const
+bool ListCtrlData::SortKeyLess(const SortKey& a, const SortKey& b, uint8_t nSortFlag)
 {
+    //实现(a < b)的比较逻辑，无数据的排在最前面
+    if (!b.bHasData) {
+        return false;
+    }
+    if (!a.bHasData) {
+        return true;
+    }
     if (nSortFlag & ListCtrlSubItemSortFlag::kSortByGroup) {
         //支持分组排序
         if (a.nSortGroup != b.nSortGroup) {
@@ -1587,30 +2049,17 @@ bool ListCtrlData::SortDataCompareFunc(const ListCtrlSubItemData2& a, const List
     }
     if (nSortFlag & ListCtrlSubItemSortFlag::kSortByUserDataN) {
         //按 .userDataN 字段排序(整型值)
-        return a.userDataN < b.userDataN;
-    }
-    else if (nSortFlag & ListCtrlSubItemSortFlag::kSortByUserDataS) {
-        //按 .userDataS 字段排序(字符串值)
-        if (nSortFlag & ListCtrlSubItemSortFlag::kSortNoCase) {
-            //不区分大小写
-            return StringUtil::StringICompare(a.userDataS.c_str(), b.userDataS.c_str()) < 0;
-        }
-        else {
-            //区分大小写
-            return StringUtil::StringCompare(a.userDataS.c_str(), b.userDataS.c_str()) < 0;
-        }
+        return a.nNumber < b.nNumber;
     }
-    else {
-        //按 .text 字段排序(字符串值)
-        if (nSortFlag & ListCtrlSubItemSortFlag::kSortNoCase) {
-            //不区分大小写
-            return StringUtil::StringICompare(a.text.c_str(), b.text.c_str()) < 0;
-        }
-        else {
-            //区分大小写
-            return StringUtil::StringCompare(a.text.c_str(), b.text.c_str()) < 0;
+    //按 .text 或者 .userDataS 字段排序(字符串值)，与StringCompare的比较结果一致
+    const size_t nLength = std::min(a.nTextLength, b.nTextLength);
+    if (nLength > 0) {
+        int nRet = std::char_traits<DString::value_type>::compare(a.pText, b.pText, nLength);
+        if (nRet != 0) {
+            return nRet < 0;
         }
     }
+    return a.nTextLength < b.nTextLength;
 }
 
 void ListCtrlData::SetSortCompareFunction(ListCtrlDataCompareFunc pfnCompareFunc, void* pUserData)
@@ -3,6 +3,8 @@
 
 #include "duilib/Box/VirtualListBox.h"
 #include "duilib/Control/ListCtrlDefs.h"
+#include "duilib/Control/ListCtrlColumnData.h"
+#include "duilib/Control/ListCtrlHeightIndex.h"
 #include <unordered_map>
 
 namespace ui
@@ -14,11 +16,11 @@ struct ListCtrlSubItemData;
 class ListCtrlData : public ui::VirtualListBoxElement
 {
 public:
-    //用于存储的数据结构
+    //用于与视图交换数据的数据结构（仅在填充界面等需要时临时生成，不用于存储）
     typedef ListCtrlSubItemData2 Storage;
     typedef std::shared_ptr<Storage> StoragePtr;
-    typedef std::vector<StoragePtr> StoragePtrList;
-    typedef std::unordered_map<size_t, StoragePtrList> StorageMap;
+    //列式存储的数据，每个列一个存储对象
+    typedef std::unordered_map<size_t, ListCtrlColumnData> ColumnDataMap;
     typedef std::vector<ListCtrlItemData> RowDataList;
 
 public:
@@ -481,6 +483,13 @@ public:
     */
     void SetSortCompareFunction(ListCtrlDataCompareFunc pfnCompareFunc, void* pUserData);
 
+    /** 数据项的内容变化后（或者新添加数据项后），按最近一次的排序方式，将该数据项移动到正确的位置，并刷新界面显示
+    *   其他数据项保持原来的顺序，通过二分查找确定插入位置
+    * @param [in] itemIndex 数据项的索引号, 有效范围：[0, GetDataItemCount())
+    * @return 返回数据项新的索引号，如果未排序过或者失败则返回Box::InvalidIndex
+    */
+    size_t ResortDataItem(size_t itemIndex);
+
 public:
     /** 批量设置选择元素, 不更新界面显示
     * @param [in] selectedIndexs 需要设置选择的元素列表，有效范围：[0, GetElementCount())
@@ -536,19 +545,26 @@ private:
     */
     bool IsValidDataColumnId(size_t nColumnId) const;
 
-    /** 获取指定数据项的数据, 读取
+    /** 获取指定数据项所在列的数据, 读取
     * @param [in] itemIndex 数据项的索引号, 有效范围：[0, GetDataItemCount())
     * @param [in] columnId 列的ID
-    * @return 如果失败则返回nullptr
+    * @param [out] nRowIndex 返回数据项在列数据中的行号
+    * @return 如果失败或者该数据项无数据则返回nullptr
     */
-    StoragePtr GetSubItemStorage(size_t itemIndex, size_t nColumnId) const;
+    const ListCtrlColumnData* GetSubItemColumn(size_t itemIndex, size_t nColumnId, size_t& nRowIndex) const;
 
-    /** 获取指定数据项的数据, 写入
+    /** 获取指定数据项所在列的数据, 写入
     * @param [in] itemIndex 数据项的索引号, 有效范围：[0, GetDataItemCount())
     * @param [in] columnId 列的ID
+    * @param [out] nRowIndex 返回数据项在列数据中的行号
     * @return 如果失败则返回nullptr
     */
-    StoragePtr GetSubItemStorageForWrite(size_t itemIndex, size_t nColumnId);
+    ListCtrlColumnData* GetSubItemColumnForWrite(size_t itemIndex, size_t nColumnId, size_t& nRowIndex);
+
+    /** 生成指定数据项的数据（用于与视图或者比较函数交换数据）
+    * @return 如果该数据项无数据则返回nullptr
+    */
+    StoragePtr MakeSubItemStorage(const ListCtrlColumnData& columnData, size_t nRowIndex) const;
 
     /** 获取各个列的数据，用于UI展示
     * @param [in] itemIndex 数据项的索引号, 有效范围：[0, GetDataItemCount())
@@ -565,27 +581,67 @@ public:
     */
     bool IsNormalMode() const;
 
+    /** 获取行高的前缀和索引（索引失效时自动重建）
+    * @param [in] nDefaultItemHeight 默认行高
+    */
+    const ListCtrlHeightIndex& GetHeightIndex(int32_t nDefaultItemHeight) const;
+
+    /** 获取数据占用的内存（字节），包括行属性数据和所有列的数据
+    */
+    size_t GetMemoryBytes() const;
+
 private:
-    /** 排序数据
+    /** 排序的参数（记录最近一次的排序，用于单个数据项变化后的增量排序）
     */
-    struct StorageData
+    struct SortParam
     {
-        size_t index;       //原来的数据索引号
-        StoragePtr pStorage;
+        bool bValid = false;            //是否已经排序
+        size_t nColumnId = 0;           //列的ID
+        size_t nColumnIndex = 0;        //列的序号
+        bool bSortedUp = true;          //true表示升序，false表示降序
+        uint8_t nSortFlag = 0;          //排序方法标志位，参见 ListCtrlSubItemSortFlag 的枚举值
+        ListCtrlDataCompareFunc pfnCompareFunc = nullptr;   //自定义的数据比较函数
+        void* pUserData = nullptr;      //自定义的数据比较函数的附加数据
     };
 
-    /** 对数据排序
-    * @param [in] dataList 待排序的数据
-    * @param [in] nColumnId 列的ID
-    * @param [in] nColumnIndex 列的序号
-    * @param [in] bSortedUp true表示升序，false表示降序
+    /** 排序关键字（排序前预先计算，比较时不再访问列数据）
+    */
+    struct SortKey
+    {
+        bool bHasData = false;          //是否有数据（无数据的排在最前面）
+        int32_t nSortGroup = 0;         //排序分组
+        uint64_t nNumber = 0;           //整型关键字
+        const DString::value_type* pText = nullptr; //字符串关键字（不区分大小写时，为转换为小写后的字符串）
+        size_t nTextLength = 0;         //字符串关键字的长度
+    };
+
+    /** 获取数据项在列数据中的行号（排序只调整显示顺序，不移动列数据）
+    * @param [in] itemIndex 数据项的索引号, 有效范围：[0, GetDataItemCount())
+    */
+    size_t GetStorageIndex(size_t itemIndex) const;
+
+    /** 按当前的显示顺序重排列数据，并清除排序索引
+    */
+    void ApplyRowOrder();
+
+    /** 计算所有数据项的排序关键字
+    * @param [in] columnData 排序列的数据
     * @param [in] nSortFlag 排序方法标志位，参见 ListCtrlSubItemSortFlag 的枚举值
-    * @param [in] pfnCompareFunc 数据比较函数
-    * @param [in] pUserData 用户自定义数据，调用比较函数的时候，通过参数传回给比较函数
+    * @param [out] sortKeys 每个数据项（按当前显示顺序）的排序关键字
+    * @param [out] keyBuffer 转换为小写后的字符串的存储空间
     */
-    bool SortStorageData(std::vector<StorageData>& dataList, size_t nColumnId, size_t nColumnIndex,
-                         bool bSortedUp, uint8_t nSortFlag,
-                         ListCtrlDataCompareFunc pfnCompareFunc, void* pUserData);
+    void MakeSortKeys(const ListCtrlColumnData& columnData, uint8_t nSortFlag,
+                      std::vector<SortKey>& sortKeys, std::vector<DString::value_type>& keyBuffer) const;
+
+    /** 计算一个数据项的排序关键字
+    * @param [in] columnData 排序列的数据
+    * @param [in] nRowIndex 列数据中的行号
+    * @param [in] nSortFlag 排序方法标志位，参见 ListCtrlSubItemSortFlag 的枚举值
+    * @param [out] sortKey 排序关键字
+    * @param [out] keyBuffer 转换为小写后的字符串的存储空间
+    */
+    void MakeSortKey(const ListCtrlColumnData& columnData, size_t nRowIndex, uint8_t nSortFlag,
+                     SortKey& sortKey, DString& keyBuffer) const;
 
     /** 默认的数据比较函数
     * @param [in] a 第一个比较数据
@@ -593,7 +649,16 @@ private:
     * @param [in] nSortFlag 排序方法标志位，参见 ListCtrlSubItemSortFlag 的枚举值
     * @return 如果 (a < b)，返回true，否则返回false
     */
-    bool SortDataCompareFunc(const ListCtrlSubItemData2& a, const ListCtrlSubItemData2& b, uint8_t nSortFlag) const;
+    static bool SortKeyLess(const SortKey& a, const SortKey& b, uint8_t nSortFlag);
+
+    /** 按排序后的顺序，更新显示顺序和行属性数据
+    * @param [in] sortedIndexs 排序后的数据项索引号：新的第i项为原来的第sortedIndexs[i]项
+    */
+    void ApplySortedIndexs(const std::vector<uint32_t>& sortedIndexs);
+
+    /** 移动一个数据项的显示位置（不移动列数据）
+    */
+    void MoveDataItem(size_t nFromIndex, size_t nToIndex);
 
     /** 更新个性化数据（隐藏行、行高、置顶等）
     */
@@ -608,14 +673,26 @@ private:
     */
     bool m_bAutoCheckSelect;
 
-    /** 数据，按列保存，每个列一个数组
+    /** 数据，按列保存，每个列一个列式存储对象
+    */
+    ColumnDataMap m_dataMap;
+
+    /** 排序索引：第i个数据项对应的列数据中的行号（为空表示未排序，与行号相同）
     */
-    StorageMap m_dataMap;
+    std::vector<uint32_t> m_rowOrder;
+
+    /** 最近一次的排序参数
+    */
+    SortParam m_sortParam;
 
     /** 行的属性数据
     */
     RowDataList m_rowDataList;
 
+    /** 行高的前缀和索引
+    */
+    mutable ListCtrlHeightIndex m_heightIndex;
+
     /** 外部设置的排序函数
     */
     ListCtrlDataCompareFunc m_pfnCompareFunc;
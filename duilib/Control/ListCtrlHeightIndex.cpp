@@ -0,0 +1,220 @@
+#include "ListCtrlHeightIndex.h"
+#include <algorithm>
+
+namespace ui
+{
+ListCtrlHeightIndex::ListCtrlHeightIndex():
+    m_nDefaultItemHeight(0),
+    m_bValid(false)
+{
+}
+
+ListCtrlHeightIndex::~ListCtrlHeightIndex()
+{
+}
+
+void ListCtrlHeightIndex::Build(const std::vector<ListCtrlItemData>& rowDataList, int32_t nDefaultItemHeight)
+{
+    m_nDefaultItemHeight = nDefaultItemHeight;
+    const size_t nRowCount = rowDataList.size();
+    std::vector<int64_t> heights(nRowCount);
+    bool bHasAtTopRows = false;
+    for (size_t index = 0; index < nRowCount; ++index) {
+        const ListCtrlItemData& rowData = rowDataList[index];
+        heights[index] = GetRowHeight(rowData);
+        if (!bHasAtTopRows && (GetAtTopRowHeight(rowData) > 0)) {
+            bHasAtTopRows = true;
+        }
+    }
+    m_allTree.Assign(heights);
+    m_atTopTree.Clear();
+    if (bHasAtTopRows) {
+        for (size_t index = 0; index < nRowCount; ++index) {
+            heights[index] = GetAtTopRowHeight(rowDataList[index]);
+        }
+        m_atTopTree.Assign(heights);
+    }
+    m_bValid = true;
+}
+
+void ListCtrlHeightIndex::Invalidate()
+{
+    m_bValid = false;
+}
+
+bool ListCtrlHeightIndex::IsValid(size_t nRowCount, int32_t nDefaultItemHeight) const
+{
+    return m_bValid && (m_nDefaultItemHeight == nDefaultItemHeight) && (GetRowCount() == nRowCount);
+}
+
+bool ListCtrlHeightIndex::HasAtTopTree() const
+{
+    return m_atTopTree.GetCount() != 0;
+}
+
+void ListCtrlHeightIndex::InitAtTopTree()
+{
+    if (!HasAtTopTree()) {
+        m_atTopTree.Resize(GetRowCount(), 0);
+    }
+}
+
+void ListCtrlHeightIndex::AppendRow(const ListCtrlItemData& rowData)
+{
+    InsertRow(GetRowCount(), rowData);
+}
+
+void ListCtrlHeightIndex::InsertRow(size_t nRowIndex, const ListCtrlItemData& rowData)
+{
+    if (!m_bValid || (nRowIndex > GetRowCount())) {
+        return;
+    }
+    const int32_t nAtTopHeight = GetAtTopRowHeight(rowData);
+    if (nAtTopHeight > 0) {
+        //第一个置顶行：全部为0的树状数组
+        InitAtTopTree();
+    }
+    const bool bHasAtTopTree = HasAtTopTree() || (nAtTopHeight > 0);
+    if (nRowIndex == GetRowCount()) {
+        //在末尾追加：O(logN)
+        m_allTree.PushBack(GetRowHeight(rowData));
+        if (bHasAtTopTree) {
+            m_atTopTree.PushBack(nAtTopHeight);
+        }
+    }
+    else {
+        //在中间插入：重建该行之后的部分
+        m_allTree.InsertElements(nRowIndex, 1, GetRowHeight(rowData));
+        if (bHasAtTopTree) {
+            m_atTopTree.InsertElements(nRowIndex, 1, nAtTopHeight);
+        }
+    }
+}
+
+void ListCtrlHeightIndex::RemoveRow(size_t nRowIndex)
+{
+    if (!m_bValid || (nRowIndex >= GetRowCount())) {
+        return;
+    }
+    m_allTree.RemoveElements(nRowIndex, 1);
+    if (HasAtTopTree()) {
+        m_atTopTree.RemoveElements(nRowIndex, 1);
+    }
+}
+
+void ListCtrlHeightIndex::SetRowCount(size_t nRowCount)
+{
+    if (!m_bValid) {
+        return;
+    }
+    //新增的行为默认属性：可见、默认行高、非置顶
+    const bool bHasAtTopTree = HasAtTopTree();
+    m_allTree.Resize(nRowCount, GetRowHeight(ListCtrlItemData()));
+    if (bHasAtTopTree) {
+        m_atTopTree.Resize(nRowCount, 0);
+    }
+}
+
+void ListCtrlHeightIndex::Clear()
+{
+    m_allTree.Clear();
+    m_atTopTree.Clear();
+}
+
+void ListCtrlHeightIndex::UpdateRow(size_t nRowIndex, const ListCtrlItemData& rowData)
+{
+    if (!m_bValid || (nRowIndex >= GetRowCount())) {
+        return;
+    }
+    const int64_t nOldHeight = m_allTree.GetValue(nRowIndex);
+    const int64_t nNewHeight = GetRowHeight(rowData);
+    if (nNewHeight != nOldHeight) {
+        m_allTree.Add(nRowIndex, nNewHeight - nOldHeight);
+    }
+    const int64_t nNewAtTopHeight = GetAtTopRowHeight(rowData);
+    if (nNewAtTopHeight > 0) {
+        InitAtTopTree();
+    }
+    if (HasAtTopTree()) {
+        const int64_t nOldAtTopHeight = m_atTopTree.GetValue(nRowIndex);
+        if (nNewAtTopHeight != nOldAtTopHeight) {
+            m_atTopTree.Add(nRowIndex, nNewAtTopHeight - nOldAtTopHeight);
+        }
+    }
+}
+
+size_t ListCtrlHeightIndex::GetRowCount() const
+{
+    return m_allTree.GetCount();
+}
+
+int32_t ListCtrlHeightIndex::GetRowHeight(const ListCtrlItemData& rowData) const
+{
+    if (!rowData.bVisible) {
+        return 0;
+    }
+    int32_t nItemHeight = (rowData.nItemHeight < 0) ? m_nDefaultItemHeight : rowData.nItemHeight;
+    return (nItemHeight > 0) ? nItemHeight : 0;
+}
+
+int32_t ListCtrlHeightIndex::GetAtTopRowHeight(const ListCtrlItemData& rowData) const
+{
+    return (rowData.nAlwaysAtTop >= 0) ? GetRowHeight(rowData) : 0;
+}
+
+int64_t ListCtrlHeightIndex::GetScrollHeights(size_t nRowCount) const
+{
+    nRowCount = std::min(nRowCount, GetRowCount());
+    return m_allTree.GetPrefixSum(nRowCount) - m_atTopTree.GetPrefixSum(nRowCount);
+}
+
+int64_t ListCtrlHeightIndex::GetTotalScrollHeights() const
+{
+    return GetScrollHeights(GetRowCount());
+}
+
+int64_t ListCtrlHeightIndex::GetAtTopHeights() const
+{
+    return m_atTopTree.GetPrefixSum(GetRowCount());
+}
+
+int64_t ListCtrlHeightIndex::GetAtTopHeights(size_t nRowCount) const
+{
+    nRowCount = std::min(nRowCount, GetRowCount());
+    return m_atTopTree.GetPrefixSum(nRowCount);
+}
+
+bool ListCtrlHeightIndex::HasAtTopRows() const
+{
+    return GetAtTopHeights() > 0;
+}
+
+size_t ListCtrlHeightIndex::FindScrollRow(int64_t nHeights) const
+{
+    if (!HasAtTopTree()) {
+        return FindRow(nHeights);
+    }
+    return FenwickTreeFindFirstGreater(GetRowCount(), nHeights, [this](size_t i) {
+            return m_allTree.GetNode(i) - m_atTopTree.GetNode(i);
+        });
+}
+
+size_t ListCtrlHeightIndex::FindRow(int64_t nHeights) const
+{
+    return m_allTree.FindFirstGreater(nHeights);
+}
+
+size_t ListCtrlHeightIndex::FindAtTopRow(int64_t nHeights) const
+{
+    if (!HasAtTopTree()) {
+        return GetRowCount();
+    }
+    return m_atTopTree.FindFirstGreater(nHeights);
+}
+
+size_t ListCtrlHeightIndex::GetMemoryBytes() const
+{
+    return m_allTree.GetMemoryBytes() + m_atTopTree.GetMemoryBytes();
+}
+
+}//namespace ui
@@ -0,0 +1,145 @@
+#ifndef UI_CONTROL_LIST_CTRL_HEIGHT_INDEX_H_
+#define UI_CONTROL_LIST_CTRL_HEIGHT_INDEX_H_
+
+#include "duilib/Control/ListCtrlDefs.h"
+#include "duilib/Utils/FenwickTree.h"
+#include <vector>
+
+namespace ui
+{
+/** 列表数据项行高的前缀和索引（树状数组，Fenwick tree）
+*   每行的有效高度：隐藏的行和高度为0的行为0，其他行为该行的行高（-1表示使用默认行高）；
+*   置顶的行单独统计（置顶的行不参与滚动），普通的行高 = 所有行的高度 - 置顶行的高度；
+*   修改单行的属性、在末尾追加行：O(logN)，查询前N行的高度、按滚动位置查找行：O(logN)；
+*   插入、删除行：只重建该行之后的部分，O(N - nRowIndex)；排序等改变行顺序的操作，在下次查询时重建索引：O(N)
+*/
+class ListCtrlHeightIndex
+{
+public:
+    ListCtrlHeightIndex();
+    ~ListCtrlHeightIndex();
+
+public:
+    /** 按行数据重建索引
+    * @param [in] rowDataList 行数据
+    * @param [in] nDefaultItemHeight 默认行高
+    */
+    void Build(const std::vector<ListCtrlItemData>& rowDataList, int32_t nDefaultItemHeight);
+
+    /** 标记索引失效（下次查询时重建）
+    */
+    void Invalidate();
+
+    /** 索引是否有效
+    * @param [in] nRowCount 当前的行数
+    * @param [in] nDefaultItemHeight 当前的默认行高
+    */
+    bool IsValid(size_t nRowCount, int32_t nDefaultItemHeight) const;
+
+    /** 在末尾追加一行（索引无效时忽略）
+    */
+    void AppendRow(const ListCtrlItemData& rowData);
+
+    /** 在指定位置插入一行（索引无效时忽略）
+    * @param [in] nRowIndex 插入位置，有效范围：[0, GetRowCount()]
+    */
+    void InsertRow(size_t nRowIndex, const ListCtrlItemData& rowData);
+
+    /** 删除指定行（索引无效时忽略）
+    * @param [in] nRowIndex 行的索引号，有效范围：[0, GetRowCount())
+    */
+    void RemoveRow(size_t nRowIndex);
+
+    /** 设置行数：新增的行在末尾，为默认属性的行；减少时删除末尾的行（索引无效时忽略）
+    */
+    void SetRowCount(size_t nRowCount);
+
+    /** 删除所有的行（索引保持有效）
+    */
+    void Clear();
+
+    /** 某行的属性（是否可见、行高、置顶）发生变化，更新索引（索引无效时忽略）
+    */
+    void UpdateRow(size_t nRowIndex, const ListCtrlItemData& rowData);
+
+    /** 获取行数
+    */
+    size_t GetRowCount() const;
+
+    /** 获取该行的有效高度（隐藏的行为0）
+    */
+    int32_t GetRowHeight(const ListCtrlItemData& rowData) const;
+
+    /** 获取前nRowCount行中，非置顶行的高度之和
+    */
+    int64_t GetScrollHeights(size_t nRowCount) const;
+
+    /** 获取所有非置顶行的高度之和
+    */
+    int64_t GetTotalScrollHeights() const;
+
+    /** 获取所有置顶行的高度之和
+    */
+    int64_t GetAtTopHeights() const;
+
+    /** 是否有置顶的行
+    */
+    bool HasAtTopRows() const;
+
+    /** 查找非置顶的行：前(N+1)行的高度之和大于nHeights的第一行N
+    * @return 返回行的索引号，未找到时返回GetRowCount()
+    */
+    size_t FindScrollRow(int64_t nHeights) const;
+
+    /** 查找行（包含置顶的行）：前(N+1)行的高度之和大于nHeights的第一行N
+    * @return 返回行的索引号，未找到时返回GetRowCount()
+    */
+    size_t FindRow(int64_t nHeights) const;
+
+    /** 查找置顶的行：前(N+1)个置顶行的高度之和大于nHeights的第一行N
+    * @return 返回行的索引号，未找到时返回GetRowCount()
+    */
+    size_t FindAtTopRow(int64_t nHeights) const;
+
+    /** 获取前nRowCount行中，置顶行的高度之和
+    */
+    int64_t GetAtTopHeights(size_t nRowCount) const;
+
+    /** 获取索引占用的内存（字节）
+    */
+    size_t GetMemoryBytes() const;
+
+private:
+    /** 获取该行置顶部分的有效高度
+    */
+    int32_t GetAtTopRowHeight(const ListCtrlItemData& rowData) const;
+
+    /** 是否记录了置顶行的高度
+    */
+    bool HasAtTopTree() const;
+
+    /** 出现第一个置顶行时，记录置顶行的高度（初始化为全部为0）
+    */
+    void InitAtTopTree();
+
+private:
+    /** 所有行的高度
+    */
+    FenwickTree<int64_t> m_allTree;
+
+    /** 置顶行的高度（没有置顶行时为空，否则与m_allTree的元素个数相同）
+    */
+    FenwickTree<int64_t> m_atTopTree;
+
+    /** 建立索引时的默认行高
+    */
+    int32_t m_nDefaultItemHeight;
+
+    /** 索引是否有效
+    */
+    bool m_bValid;
+};
+
+}//namespace ui
+
+#endif //UI_CONTROL_LIST_CTRL_HEIGHT_INDEX_H_
@@ -215,26 +215,11 @@ size_t ListCtrlReportView::GetTopDataItemIndex(int64_t nScrollPosY) const
     if (pDataProvider == nullptr) {
         return itemIndex;
     }
-    const ListCtrlData::RowDataList& itemDataList = pDataProvider->GetItemDataList();
-    int64_t totalItemHeight = 0;
-    int32_t nItemHeight = 0;
-    const size_t dataItemCount = itemDataList.size();
-    for (size_t index = 0; index < dataItemCount; ++index) {
-        const ListCtrlItemData& rowData = itemDataList[index];
-        nItemHeight = rowData.nItemHeight;
-        if (nItemHeight < 0) {
-            //取默认行高
-            nItemHeight = m_pListCtrl->GetDataItemHeight();
-        }
-        if (!rowData.bVisible || (nItemHeight  == 0)){
-            continue;
-        }
-        totalItemHeight += nItemHeight;
-        //如果每行高度都相同，相当于 nScrollPosY / ItemHeight
-        if (totalItemHeight > nScrollPosY) {
-            itemIndex = index;
-            break;
-        }
+    //查找前(N+1)行的高度之和大于nScrollPosY的第一行（如果每行高度都相同，相当于 nScrollPosY / ItemHeight）
+    const ListCtrlHeightIndex& heightIndex = pDataProvider->GetHeightIndex(m_pListCtrl->GetDataItemHeight());
+    size_t nFoundIndex = heightIndex.FindRow(nScrollPosY);
+    if (nFoundIndex < heightIndex.GetRowCount()) {
+        itemIndex = nFoundIndex;
     }
     return itemIndex;
 }
@@ -299,36 +284,35 @@ void ListCtrlReportView::GetDataItemsToShow(int64_t nScrollPosY, size_t maxCount
     std::vector<AlwaysAtTopData> alwaysAtTopItemList;
     
     const ListCtrlData::RowDataList& itemDataList = pDataProvider->GetItemDataList();
+    const ListCtrlHeightIndex& heightIndex = pDataProvider->GetHeightIndex(nDefaultItemHeight);
+    const size_t dataItemCount = itemDataList.size();
     int64_t totalItemHeight = 0;
     int32_t nItemHeight = 0;
-    const size_t dataItemCount = itemDataList.size();
-    for (size_t index = 0; index < dataItemCount; ++index) {
-        const ListCtrlItemData& rowData = itemDataList[index];
-        nItemHeight = (rowData.nItemHeight < 0) ? nDefaultItemHeight : rowData.nItemHeight;
-        if (!rowData.bVisible || (nItemHeight == 0)) {
-            //不可见的，跳过
-            continue;
-        }
 
-        if (rowData.nAlwaysAtTop >= 0) {
-            //置顶的元素
-            if (alwaysAtTopItemList.size() < maxCount) {
-                alwaysAtTopItemList.push_back({ rowData.nAlwaysAtTop, index, nItemHeight });
-            }
-            continue;
-        }
-
-        if (nTopDataItemIndex == Box::InvalidIndex) {
+    //置顶的元素：按顺序逐个查找
+    if (heightIndex.HasAtTopRows()) {
+        size_t index = heightIndex.FindAtTopRow(totalItemHeight);
+        while ((index < dataItemCount) && (alwaysAtTopItemList.size() < maxCount)) {
+            const ListCtrlItemData& rowData = itemDataList[index];
+            nItemHeight = heightIndex.GetRowHeight(rowData);
+            alwaysAtTopItemList.push_back({ rowData.nAlwaysAtTop, index, nItemHeight });
             totalItemHeight += nItemHeight;
-            //如果每行高度都相同，相当于 nScrollPosY / ItemHeight
-            if (totalItemHeight > nScrollPosY) {
-                nTopDataItemIndex = index;
-                nPrevItemHeights = totalItemHeight - nItemHeight;
-            }
+            index = heightIndex.FindAtTopRow(totalItemHeight);
         }
+    }
 
-        if ((nTopDataItemIndex != Box::InvalidIndex) && (itemIndexList.size() < maxCount)){
+    //顶部可见的第一个元素：前(N+1)行的高度之和大于nScrollPosY的第一行（如果每行高度都相同，相当于 nScrollPosY / ItemHeight）
+    nTopDataItemIndex = heightIndex.FindScrollRow(nScrollPosY);
+    if (nTopDataItemIndex < dataItemCount) {
+        nPrevItemHeights = heightIndex.GetScrollHeights(nTopDataItemIndex);
+        totalItemHeight = nPrevItemHeights;
+        size_t index = nTopDataItemIndex;
+        while ((index < dataItemCount) && (itemIndexList.size() < maxCount)) {
+            nItemHeight = heightIndex.GetRowHeight(itemDataList[index]);
             itemIndexList.push_back({ index, nItemHeight });
+            //跳过不可见的元素和置顶的元素
+            totalItemHeight += nItemHeight;
+            index = heightIndex.FindScrollRow(totalItemHeight);
         }
     }
 
@@ -392,33 +376,38 @@ int32_t ListCtrlReportView::GetMaxDataItemsToShow(int64_t nScrollPosY, int32_t n
     std::vector<size_t> itemIndexList;
 
     const ListCtrlData::RowDataList& itemDataList = pDataProvider->GetItemDataList();
+    const ListCtrlHeightIndex& heightIndex = pDataProvider->GetHeightIndex(nDefaultItemHeight);
+    const size_t dataItemCount = itemDataList.size();
     int64_t totalItemHeight = 0;
     int32_t nItemHeight = 0;
-    const size_t dataItemCount = itemDataList.size();
-    for (size_t index = 0; index < dataItemCount; ++index) {
-        const ListCtrlItemData& rowData = itemDataList[index];
-        nItemHeight = (rowData.nItemHeight < 0) ? nDefaultItemHeight : rowData.nItemHeight;
-        if (!rowData.bVisible || (nItemHeight == 0)) {
-            //不可见的，跳过
-            continue;
-        }
 
-        if (rowData.nAlwaysAtTop >= 0) {
-            //置顶的元素
-            alwaysAtTopItemList.push_back({ rowData.nAlwaysAtTop, index });
-            continue;
-        }
-
-        if (nTopDataItemIndex == Box::InvalidIndex) {
-            totalItemHeight += nItemHeight;
-            //如果每行高度都相同，相当于 nScrollPosY / ItemHeight
-            if (totalItemHeight > nScrollPosY) {
-                nTopDataItemIndex = index;
-            }
-        }
-
-        if (nTopDataItemIndex != Box::InvalidIndex) {
+    //置顶的元素
+    int64_t nAtTopItemHeights = 0;
+    if (heightIndex.HasAtTopRows()) {
+        size_t index = heightIndex.FindAtTopRow(totalItemHeight);
+        while (index < dataItemCount) {
+            alwaysAtTopItemList.push_back({ itemDataList[index].nAlwaysAtTop, index });
+            totalItemHeight += heightIndex.GetRowHeight(itemDataList[index]);
+            index = heightIndex.FindAtTopRow(totalItemHeight);
+        }
+        nAtTopItemHeights = totalItemHeight;
+    }
+
+    //从顶部可见的第一个元素开始，只需要取到填满显示区域为止
+    nTopDataItemIndex = heightIndex.FindScrollRow(nScrollPosY);
+    if (nTopDataItemIndex < dataItemCount) {
+        totalItemHeight = heightIndex.GetScrollHeights(nTopDataItemIndex);
+        int64_t nShowHeights = nAtTopItemHeights;
+        size_t index = nTopDataItemIndex;
+        while (index < dataItemCount) {
             itemIndexList.push_back(index);
+            nItemHeight = heightIndex.GetRowHeight(itemDataList[index]);
+            nShowHeights += nItemHeight;
+            if (nShowHeights >= nRectHeight) {
+                break;
+            }
+            totalItemHeight += nItemHeight;
+            index = heightIndex.FindScrollRow(totalItemHeight);
         }
     }
 
@@ -485,32 +474,12 @@ int64_t ListCtrlReportView::GetDataItemTotalHeights(size_t itemIndex, bool bIncl
         return 0;
     }
     const int32_t nDefaultItemHeight = m_pListCtrl->GetDataItemHeight(); //默认行高
-    const ListCtrlData::RowDataList& itemDataList = pDataProvider->GetItemDataList();
-    int64_t totalItemHeight = 0;
-    int32_t nItemHeight = 0;
-    const size_t dataItemCount = itemDataList.size();
-    for (size_t index = 0; index < dataItemCount; ++index) {
-        const ListCtrlItemData& rowData = itemDataList[index];
-        nItemHeight = (rowData.nItemHeight < 0) ? nDefaultItemHeight : rowData.nItemHeight;
-        if (!rowData.bVisible || (nItemHeight == 0)) {
-            //不可见的，跳过
-            continue;
-        }
-
-        if (rowData.nAlwaysAtTop >= 0) {
-            //置顶的元素，需要统计在内
-            if (bIncludeAtTops) {
-                totalItemHeight += nItemHeight;
-            }            
-        }
-        else if (index < itemIndex) {
-            //符合要求的元素
-            totalItemHeight += nItemHeight;
-        }
-        else if (!bIncludeAtTops) {
-            //已经完成
-            break;
-        }
+    const ListCtrlHeightIndex& heightIndex = pDataProvider->GetHeightIndex(nDefaultItemHeight);
+    //前itemIndex个非置顶元素的高度
+    int64_t totalItemHeight = heightIndex.GetScrollHeights(itemIndex);
+    if (bIncludeAtTops) {
+        //置顶的元素，需要统计在内
+        totalItemHeight += heightIndex.GetAtTopHeights();
     }
     return totalItemHeight;
 }
@@ -1325,27 +1294,12 @@ bool ListCtrlReportView::OnFrameSelection(int64_t left, int64_t /*right*/, int64
     }
 
     const int32_t nDefaultItemHeight = m_pListCtrl->GetDataItemHeight(); //默认行高
-    int32_t nTopItemHeights = m_pListCtrl->GetHeaderHeight(); //Header与置顶元素所占有的高度
+    const ListCtrlHeightIndex& heightIndex = pDataProvider->GetHeightIndex(nDefaultItemHeight);
+    int64_t nTopItemHeights = m_pListCtrl->GetHeaderHeight(); //Header与置顶元素所占有的高度
+    nTopItemHeights += heightIndex.GetAtTopHeights();
 
     std::vector<size_t> itemIndexList;
 
-    int64_t totalItemHeight = 0;
-    int32_t nItemHeight = 0;    
-    for (size_t index = 0; index < dataItemCount; ++index) {
-        const ListCtrlItemData& rowData = itemDataList[index];
-        nItemHeight = (rowData.nItemHeight < 0) ? nDefaultItemHeight : rowData.nItemHeight;
-        if (!rowData.bVisible || (nItemHeight == 0)) {
-            //不可见的，跳过
-            continue;
-        }
-
-        if (rowData.nAlwaysAtTop >= 0) {
-            //置顶的元素
-            nTopItemHeights += nItemHeight;
-            continue;
-        }
-    }
-
     top -= nTopItemHeights;
     bottom -= nTopItemHeights;
     if (top < 0) {
@@ -1354,27 +1308,17 @@ bool ListCtrlReportView::OnFrameSelection(int64_t left, int64_t /*right*/, int64
     if (bottom < 0) {
         bottom = 0;
     }
-    for (size_t index = 0; index < dataItemCount; ++index) {
-        const ListCtrlItemData& rowData = itemDataList[index];
-        nItemHeight = (rowData.nItemHeight < 0) ? nDefaultItemHeight : rowData.nItemHeight;
-        if (!rowData.bVisible || (nItemHeight == 0)) {
-            //不可见的，跳过
-            continue;
-        }
-
-        if (rowData.nAlwaysAtTop >= 0) {
-            //置顶的元素，排除掉
-            continue;
-        }
-        totalItemHeight += nItemHeight;
-        if (totalItemHeight > top) {
-            //开始
-            itemIndexList.push_back(index);
-        }
+    //从框选范围内的第一个元素开始（跳过不可见的元素和置顶的元素）
+    size_t index = heightIndex.FindScrollRow(top);
+    int64_t totalItemHeight = heightIndex.GetScrollHeights(index);
+    while (index < dataItemCount) {
+        itemIndexList.push_back(index);
+        totalItemHeight += heightIndex.GetRowHeight(itemDataList[index]);
         if (totalItemHeight > bottom) {
             //结束
             break;
         }
+        index = heightIndex.FindScrollRow(totalItemHeight);
     }
 
     //选择框选的数据
@@ -1,6 +1,7 @@
 #include "RichEditData.h"
 #include "duilib/Utils/PerformanceUtil.h"
 #include <unordered_set>
+#include <algorithm>
 
 namespace ui
 {
@@ -12,6 +13,7 @@ RichEditData::RichEditData(IRichTextData* pRichTextData):
     m_pRender(nullptr),
     m_pRenderFactory(nullptr),
     m_bCacheDirty(true),
+    m_nCalcLineCount(0),
     m_nUndoLimit(64),
     m_bTextRectYOffsetUpdated(false),
     m_bTextRectXOffsetUpdated(false)
@@ -173,9 +175,10 @@ UiRect RichEditData::EstimateTextDisplayBounds(const UiRect& rcAvailable)
 
     UiRect rcDrawRect = m_pRichText->GetRichTextDrawRect();
     if (rcAvailable.Width() == rcDrawRect.Width()) {
-        //检查并计算字符位置
-        CheckCalcTextRects();
+        //检查并计算字符位置（只计算可见区域，尚未计算的行按平均行高估算，随着计算的进行逐步修正）
+        CheckCalcViewTextRects();
         rect = GetTextRect();
+        rect.bottom += EstimateUncalcTextHeight();
     }
     else {
         //重新估算
@@ -311,6 +314,10 @@ void RichEditData::UpdateRowTextOffsetX(RichTextLineInfoList& lineTextInfo, HorA
 int32_t RichEditData::GetTextRectOfssetY() const
 {
     int32_t yOffset = 0;
+    if (!IsTextRectsCalcCompleted()) {
+        //尚未计算完成时，文本高度未知（只有文本超过一屏时才会分批计算），不做纵向对齐
+        return yOffset;
+    }
     if (m_rcTextRect.Height() < m_rcTextDrawRect.Height()) {
         VerAlignType vAlignType = GetVAlignType();
         if (vAlignType == VerAlignType::kAlignCenter) {
@@ -338,15 +345,125 @@ const UiRect& RichEditData::GetTextRect() const
 }
 
 void RichEditData::CheckCalcTextRects()
+{
+    CheckCalcTextRects((size_t)-1, INT32_MAX);
+}
+
+void RichEditData::CheckCalcViewTextRects()
+{
+    CheckCalcTextRects(0, GetViewCalcBottom());
+}
+
+void RichEditData::CheckCalcCharTextRects(int32_t nCharIndex)
+{
+    //字符位置无效或者在文本末尾时，计算所有的行；否则多计算一行（光标定位时可能会用到下一行）
+    size_t nMinLineCount = (size_t)-1;
+    size_t nLineIndex = 0;
+    size_t nLineStartChar = 0;
+    if (FindCharLine(nCharIndex, nLineIndex, nLineStartChar)) {
+        nMinLineCount = nLineIndex + 2;
+    }
+    CheckCalcTextRects(nMinLineCount, 0);
+}
+
+void RichEditData::CheckCalcTextRects(size_t nMinLineCount, int32_t nMinBottom)
 {
     SetTextDrawRect(m_pRichText->GetRichTextDrawRect(), true);
+    const bool bCacheDirty = m_bCacheDirty;
     if (m_bCacheDirty) {
         CalcTextRects();
         SetCacheDirty(false);
+    }
+    //按需继续计算后续的行
+    const size_t nLineCount = m_lineTextInfo.size();
+    while ((m_nCalcLineCount < nLineCount) &&
+           ((m_nCalcLineCount < nMinLineCount) || (m_rcTextRect.bottom < nMinBottom))) {
+        size_t nEndLine = m_nCalcLineCount + EstimateCalcLineCount(nMinBottom - m_rcTextRect.bottom);
+        if (nEndLine < nMinLineCount) {
+            nEndLine = nMinLineCount;
+        }
+        AppendCalcTextRects(std::min(nEndLine, nLineCount));
+    }
+    if (bCacheDirty) {
         m_pRichText->OnTextRectsChanged();
     }
 }
 
+bool RichEditData::IsTextRectsCalcCompleted() const
+{
+    return m_nCalcLineCount >= m_lineTextInfo.size();
+}
+
+bool RichEditData::CalcMoreTextRects(size_t nLineCount)
+{
+    if (m_bCacheDirty) {
+        CheckCalcViewTextRects();
+    }
+    else if (!IsTextRectsCalcCompleted()) {
+        CheckCalcTextRects(m_nCalcLineCount + std::max(nLineCount, (size_t)1), 0);
+    }
+    return IsTextRectsCalcCompleted();
+}
+
+void RichEditData::GetCalcTextView(std::vector<std::wstring_view>& textView) const
+{
+    GetTextView(textView);
+    if (textView.size() > m_nCalcLineCount) {
+        textView.resize(m_nCalcLineCount);
+    }
+}
+
+void RichEditData::AppendCalcTextRects(size_t nEndLine)
+{
+    ASSERT(!m_bCacheDirty);
+    const size_t nStartLine = m_nCalcLineCount;
+    ASSERT(nEndLine <= m_lineTextInfo.size());
+    if ((nEndLine <= nStartLine) || (nEndLine > m_lineTextInfo.size())) {
+        return;
+    }
+    PerformanceStat statPerformance(_T("RichEditData::AppendCalcTextRects"));
+    //新计算的行，按修改的行进行增量计算
+    std::vector<size_t> modifiedLines;
+    modifiedLines.reserve(nEndLine - nStartLine);
+    for (size_t nIndex = nStartLine; nIndex < nEndLine; ++nIndex) {
+        modifiedLines.push_back(nIndex);
+    }
+    m_nCalcLineCount = nEndLine;
+    CalcTextRects(nStartLine, modifiedLines, std::vector<size_t>(), 0);
+}
+
+int32_t RichEditData::GetViewCalcBottom() const
+{
+    //可见区域，再向下预取一屏
+    const int64_t nViewHeight = m_pRichText->GetRichTextDrawRect().Height();
+    const int64_t nBottom = (int64_t)m_szScrollOffset.cy + nViewHeight * 2;
+    return (int32_t)std::min(nBottom, (int64_t)INT32_MAX);
+}
+
+size_t RichEditData::EstimateCalcLineCount(int32_t nHeight) const
+{
+    //每个物理行至少占一个逻辑行，按行高估算需要计算的行数（每次至少计算一批）
+    constexpr const size_t nMinCalcLineCount = 64;
+    size_t nCalcLineCount = nMinCalcLineCount;
+    const int32_t nRowHeight = m_pRichText->GetTextRowHeight();
+    if ((nRowHeight > 0) && (nHeight > 0)) {
+        nCalcLineCount = std::max(nCalcLineCount, (size_t)(nHeight / nRowHeight) + 1);
+    }
+    return nCalcLineCount;
+}
+
+int32_t RichEditData::EstimateUncalcTextHeight() const
+{
+    const size_t nLineCount = m_lineTextInfo.size();
+    if ((m_nCalcLineCount == 0) || (m_nCalcLineCount >= nLineCount)) {
+        return 0;
+    }
+    //按已计算行的平均高度估算
+    const int64_t nCalcHeight = m_rcTextRect.Height();
+    const int64_t nUncalcHeight = nCalcHeight * (int64_t)(nLineCount - m_nCalcLineCount) / (int64_t)m_nCalcLineCount;
+    return (int32_t)std::min(nUncalcHeight, (int64_t)INT32_MAX / 2);
+}
+
 void RichEditData::CalcTextRects()
 {
     PerformanceStat statPerformance(_T("RichEditData::CalcTextRects"));
@@ -356,6 +473,7 @@ void RichEditData::CalcTextRects()
         pLineInfo->m_rowInfo.clear();
     }
     m_rcTextRect.Clear();
+    m_nCalcLineCount = m_lineTextInfo.size();
 
     ASSERT(m_pRender != nullptr);
     if (m_pRender == nullptr) {
@@ -392,6 +510,14 @@ void RichEditData::CalcTextRects()
         m_bTextRectYOffsetUpdated = false;
         return;
     }
+    if (!m_bSingleLineMode && !m_pRichText->IsTextPasswordMode()) {
+        //只计算可见区域及预取区域所在的行，其余的行按需计算或者在空闲时计算
+        const size_t nViewLineCount = EstimateCalcLineCount(GetViewCalcBottom());
+        if (nViewLineCount < textView.size()) {
+            textView.resize(nViewLineCount);
+            m_nCalcLineCount = nViewLineCount;
+        }
+    }
     //估算的时候，滚动条位置始终为(0,0)
     UiSize szScrollOffset;
     RichTextLineInfoParam lineInfoParam;
@@ -504,7 +630,7 @@ void RichEditData::CalcTextRects(size_t nStartLine,
     }
 
     std::vector<std::wstring_view> textView;
-    GetTextView(textView);
+    GetCalcTextView(textView);
     if (textView.empty()) {
         return;
     }
@@ -619,7 +745,10 @@ void RichEditData::CalcTextRects(size_t nStartLine,
             RichTextLineInfoPtr spLineInfo(new RichTextLineInfo);
             spLineInfo->m_nLineTextLen = pLineInfo->m_nLineTextLen;
             spLineInfo->m_lineText = pLineInfo->m_lineText;
-            textView2.push_back(std::wstring_view(spLineInfo->m_lineText.c_str(), spLineInfo->m_nLineTextLen));
+            if (textView2.size() < m_nCalcLineCount) {
+                //只比较已经计算过的行
+                textView2.push_back(std::wstring_view(spLineInfo->m_lineText.c_str(), spLineInfo->m_nLineTextLen));
+            }
             lineTextInfoList.push_back(spLineInfo);
         }
         std::vector<RichTextData> richTextDataList2;
@@ -743,6 +872,7 @@ bool RichEditData::SetText(const DStringW& text)
             }
         }
         m_lineTextInfo.swap(lineTextInfo);
+        m_lineIndex.Invalidate();
         SetCacheDirty(true);
         ClearUndoList();
     }
@@ -828,14 +958,33 @@ void RichEditData::GetTextView(std::vector<std::wstring_view>& textView) const
 
 size_t RichEditData::GetTextLength() const
 {
-    size_t nTextLen = 0;
-    const size_t nLineCount = m_lineTextInfo.size();
-    for (size_t nIndex = 0; nIndex < nLineCount; ++nIndex) {
-        const RichTextLineInfo& lineText = *m_lineTextInfo[nIndex];
-        ASSERT(lineText.m_nLineTextLen > 0);
-        nTextLen += lineText.m_nLineTextLen;
+    return GetLineIndex().GetTextLength();
+}
+
+const RichEditLineIndex& RichEditData::GetLineIndex() const
+{
+    if (!m_lineIndex.IsValid(m_lineTextInfo.size())) {
+        m_lineIndex.Build(m_lineTextInfo);
     }
-    return nTextLen;
+    return m_lineIndex;
+}
+
+bool RichEditData::FindCharLine(int32_t nCharIndex, size_t& nLineIndex, size_t& nLineStartChar) const
+{
+    if (nCharIndex < 0) {
+        return false;
+    }
+    const RichEditLineIndex& lineIndex = GetLineIndex();
+    const size_t nLineCount = lineIndex.GetLineCount();
+    const size_t nFoundLine = lineIndex.FindLine((size_t)nCharIndex);
+    if (nFoundLine >= nLineCount) {
+        //超出文本的范围
+        return false;
+    }
+    nLineIndex = nFoundLine;
+    nLineStartChar = lineIndex.GetLineStart(nFoundLine);
+    ASSERT(((size_t)nCharIndex >= nLineStartChar) && ((size_t)nCharIndex < nLineStartChar + m_lineTextInfo[nFoundLine]->m_nLineTextLen));
+    return true;
 }
 
 bool RichEditData::IsEmpty() const
@@ -885,56 +1034,21 @@ bool RichEditData::FindLineTextPos(int32_t nStartChar, int32_t nEndChar,
         return false;
     }
 
-    constexpr const size_t nNotFound = (size_t)-1;
-    nStartLine = nNotFound;                 //起始行
-    nEndLine = nNotFound;                   //结束行
-    size_t nStartCharBaseLen = nNotFound;   //在起始行之前的总长度
-    size_t nEndCharBaseLen = nNotFound;     //在结束行之前的总长度
-    nStartCharLineOffset = nNotFound;       //在起始行中，开始字符的偏移量
-    nEndCharLineOffset = nNotFound;         //在结束行中，结束字符的偏移量
-    size_t nTextLen = 0;                    //文本总长度
-    const size_t nLineCount = m_lineTextInfo.size();
-    for (size_t nIndex = 0; nIndex < nLineCount; ++nIndex) {
-        const RichTextLineInfo& lineText = *m_lineTextInfo[nIndex];
-        ASSERT(lineText.m_nLineTextLen > 0);
-        nTextLen += lineText.m_nLineTextLen;
-        if ((nStartChar < (int32_t)nTextLen) && (nStartLine == nNotFound)) {
-            nStartLine = nIndex;
-            nStartCharBaseLen = nTextLen - lineText.m_nLineTextLen;
-            nStartCharLineOffset = (size_t)nStartChar - nStartCharBaseLen;
-            ASSERT(nStartCharLineOffset < lineText.m_nLineTextLen);
-        }
-        if ((nEndChar < (int32_t)nTextLen) && (nEndLine == nNotFound)) {
-            nEndLine = nIndex;
-            nEndCharBaseLen = nTextLen - lineText.m_nLineTextLen;
-            nEndCharLineOffset = (size_t)nEndChar - nEndCharBaseLen;
-            ASSERT(nEndCharLineOffset < lineText.m_nLineTextLen);
-        }
-        if ((nStartLine != nNotFound) && (nEndLine != nNotFound)) {
-            break;
-        }
-        if (nIndex == (nLineCount - 1)) {
-            //最后一行
-            if ((nStartChar == (int32_t)nTextLen) && (nStartLine == nNotFound)) {
-                nStartLine = nIndex;
-                nStartCharBaseLen = nTextLen - lineText.m_nLineTextLen;
-                nStartCharLineOffset = (size_t)nStartChar - nStartCharBaseLen;
-                ASSERT(nStartCharLineOffset == lineText.m_nLineTextLen);
-            }
-            if ((nEndChar == (int32_t)nTextLen) && (nEndLine == nNotFound)) {
-                nEndLine = nIndex;
-                nEndCharBaseLen = nTextLen - lineText.m_nLineTextLen;
-                nEndCharLineOffset = (size_t)nEndChar - nEndCharBaseLen;
-                ASSERT(nEndCharLineOffset == lineText.m_nLineTextLen);
-            }
-        }
-    }
-    if ((nStartLine != nNotFound) && (nEndLine != nNotFound) &&
-        (nStartCharLineOffset != nNotFound) && (nEndCharLineOffset != nNotFound)) {
-        ASSERT(nEndLine >= nStartLine);
-        return true;
+    const RichEditLineIndex& lineIndex = GetLineIndex();
+    const size_t nTextLen = lineIndex.GetTextLength(); //文本总长度
+    if (((size_t)nStartChar > nTextLen) || ((size_t)nEndChar > nTextLen)) {
+        return false;
     }
-    return false;
+    //文本末尾的位置，定位到最后一行的行尾
+    const size_t nLastLine = m_lineTextInfo.size() - 1;
+    nStartLine = std::min(lineIndex.FindLine((size_t)nStartChar), nLastLine);
+    nEndLine = std::min(lineIndex.FindLine((size_t)nEndChar), nLastLine);
+    nStartCharLineOffset = (size_t)nStartChar - lineIndex.GetLineStart(nStartLine);
+    nEndCharLineOffset = (size_t)nEndChar - lineIndex.GetLineStart(nEndLine);
+    ASSERT(nStartCharLineOffset <= m_lineTextInfo[nStartLine]->m_nLineTextLen);
+    ASSERT(nEndCharLineOffset <= m_lineTextInfo[nEndLine]->m_nLineTextLen);
+    ASSERT(nEndLine >= nStartLine);
+    return true;
 }
 
 bool RichEditData::ReplaceText(int32_t nStartChar, int32_t nEndChar, const DStringW& text, bool bCanUndo, bool bClearRedo)
@@ -956,9 +1070,6 @@ bool RichEditData::ReplaceText(int32_t nStartChar, int32_t nEndChar, const DStri
         }
     }
 
-    //检查并计算字符位置
-    CheckCalcTextRects();
-
     constexpr const size_t nNotFound = (size_t)-1;
     size_t nStartLine = nNotFound;              //起始行
     size_t nEndLine = nNotFound;                //结束行
@@ -968,15 +1079,14 @@ bool RichEditData::ReplaceText(int32_t nStartChar, int32_t nEndChar, const DStri
         return false;
     }
 
-    DStringW oldText; //旧文本内容
+    //检查并计算字符位置：只需要计算到修改的结束行，其后的行仍按需计算
+    CheckCalcTextRects(nEndLine + 1, 0);
+    const size_t nOldLineCount = m_lineTextInfo.size();
 
     //是否需要记录撤销操作
     if (m_nUndoLimit == 0) {
         bCanUndo = false;
     }
-    if (bCanUndo && (nEndChar > nStartChar)) {
-        oldText = GetTextRange(nStartChar, nEndChar);
-    }
     //操作结果
     std::wstring_view startLineTextView; //起始行的剩余文本
     std::wstring_view endLineTextView;   //结束行的剩余文本
@@ -1028,6 +1138,19 @@ bool RichEditData::ReplaceText(int32_t nStartChar, int32_t nEndChar, const DStri
     }
     //删除了几行
     size_t nDeletedRows = 0;
+    //旧文本：如果删除的是完整的行，引用删除的行，否则复制删除的文本
+    TTextPiece oldText;
+    if (bCanUndo) {
+        oldText.m_nLength = (size_t)(nEndChar - nStartChar);
+        if (oldText.m_nLength > 0) {
+            if ((nStartCharLineOffset == 0) && (nEndCharLineOffset == m_lineTextInfo[nEndLine]->m_nLineTextLen)) {
+                oldText.m_lines.assign(m_lineTextInfo.begin() + nStartLine, m_lineTextInfo.begin() + nEndLine + 1);
+            }
+            else {
+                oldText.m_text = GetTextRange(nStartChar, nEndChar);
+            }
+        }
+    }
     //倒序删除
     if (!deletedLines.empty()) {
         int32_t nDelIndex = (int32_t)deletedLines.size() - 1;
@@ -1061,6 +1184,16 @@ bool RichEditData::ReplaceText(int32_t nStartChar, int32_t nEndChar, const DStri
         modifiedLines.push_back(nStartLine + nIndex);
     }
 
+    //更新行的起始位置索引：只更新修改的行，行数有变化时重建其后的部分
+    const size_t nRemovedLineCount = nOldLineCount + nNewLineCount - m_lineTextInfo.size();
+    m_lineIndex.ReplaceLines(nStartLine, nRemovedLineCount, nNewLineCount);
+    for (size_t nIndex = 0; nIndex < nNewLineCount; ++nIndex) {
+        m_lineIndex.UpdateLine(nStartLine + nIndex, m_lineTextInfo[nStartLine + nIndex]->m_nLineTextLen);
+    }
+
+    //修改文本前已经计算到结束行（见CheckCalcTextRects），修改的行替换后，其后未计算的行数不变
+    ASSERT((m_nCalcLineCount > nEndLine) || (m_nCalcLineCount >= nOldLineCount));
+    m_nCalcLineCount = std::min(m_nCalcLineCount + m_lineTextInfo.size() - nOldLineCount, m_lineTextInfo.size());
     if (!m_bCacheDirty && (!modifiedLines.empty() || !deletedLines.empty())) {
         //修改的行，需要重新计算(增量计算)
         if ((m_lineTextInfo.size() <= 1) || m_pRichText->IsTextPasswordMode()) {
@@ -1073,8 +1206,18 @@ bool RichEditData::ReplaceText(int32_t nStartChar, int32_t nEndChar, const DStri
         }        
     }
     if (bCanUndo) {
-        //生成撤销列表
-        AddToUndoList(nStartChar, text, oldText);
+        //生成撤销列表：如果新文本是完整的行，引用新插入的行，否则复制新文本
+        TTextPiece newText;
+        newText.m_nLength = text.size();
+        if (newText.m_nLength > 0) {
+            if (startLineTextView.empty() && endLineTextView.empty()) {
+                newText.m_lines.assign(m_lineTextInfo.begin() + nStartLine, m_lineTextInfo.begin() + nStartLine + nNewLineCount);
+            }
+            else {
+                newText.m_text = text;
+            }
+        }
+        AddToUndoList(nStartChar, std::move(newText), std::move(oldText));
     }
     else if (bClearRedo){
         ClearUndoList();
@@ -1185,75 +1328,73 @@ bool RichEditData::GetCharLineRowIndex(int32_t nCharIndex, size_t& nLineNumber,
         return false;
     }
     bool bFound = false;
-    size_t nTextLen = 0; //文本总长度
     const RichTextLineInfoList& lineTextInfoList = m_lineTextInfo;
     const size_t nLineCount = lineTextInfoList.size();
-    for (size_t nLineIndex = 0; nLineIndex < nLineCount; ++nLineIndex) {
+    size_t nLineIndex = 0;      //物理行号
+    size_t nStartBaseLen = 0;   //在该行之前的总长度
+    if (FindCharLine(nCharIndex, nLineIndex, nStartBaseLen)) {
         ASSERT(lineTextInfoList[nLineIndex] != nullptr);
         const RichTextLineInfo& lineTextInfo = *lineTextInfoList[nLineIndex];
         ASSERT(lineTextInfo.m_nLineTextLen > 0);
-        nTextLen += lineTextInfo.m_nLineTextLen;
-        if ((size_t)nCharIndex < nTextLen) {
-            const size_t nStartBaseLen = nTextLen - lineTextInfo.m_nLineTextLen;
-            const size_t nStartLineOffset = (size_t)nCharIndex - nStartBaseLen;
-            ASSERT(nStartLineOffset < lineTextInfo.m_nLineTextLen);
-            //定位在本物理分行中，再定位在哪个逻辑分行中
-            size_t nRowTextLen = 0;
-            const size_t nRowCount = lineTextInfo.m_rowInfo.size();
-            for (size_t nRow = 0; nRow < nRowCount; ++nRow) {
-                ASSERT(lineTextInfo.m_rowInfo[nRow] != nullptr);
-                const RichTextRowInfo& rowInfo = *lineTextInfo.m_rowInfo[nRow];
-                nRowTextLen += rowInfo.m_charInfo.size();
-                if (nStartLineOffset < nRowTextLen) {
-                    //定位在本逻辑分行中
-                    const size_t nStartCharBaseLen = nRowTextLen - rowInfo.m_charInfo.size();
-                    bFound = true;
-                    nStartCharRowOffset = (size_t)nStartLineOffset - nStartCharBaseLen;
-                    nLineNumber = nLineIndex;
-                    nLineRowIndex = nRow;
-                    break;
-                }
-            }
-            break;
-        }
-        else if (((size_t)nCharIndex == nTextLen) && (nLineIndex == (nLineCount - 1))) {
-            //最后一行的最后一个字符之后的位置
-            const size_t nRowCount = lineTextInfo.m_rowInfo.size();
-            ASSERT(nRowCount != 0);
-            if (nRowCount > 0) {
-                const RichTextRowInfo& rowInfo = *lineTextInfo.m_rowInfo[nRowCount - 1];                
-                nStartCharRowOffset = rowInfo.m_charInfo.size();
-                nLineNumber = nLineIndex;
-                nLineRowIndex = nRowCount - 1;
+        const size_t nStartLineOffset = (size_t)nCharIndex - nStartBaseLen;
+        ASSERT(nStartLineOffset < lineTextInfo.m_nLineTextLen);
+        //定位在本物理分行中，再定位在哪个逻辑分行中
+        size_t nRowTextLen = 0;
+        const size_t nRowCount = lineTextInfo.m_rowInfo.size();
+        for (size_t nRow = 0; nRow < nRowCount; ++nRow) {
+            ASSERT(lineTextInfo.m_rowInfo[nRow] != nullptr);
+            const RichTextRowInfo& rowInfo = *lineTextInfo.m_rowInfo[nRow];
+            nRowTextLen += rowInfo.m_charInfo.size();
+            if (nStartLineOffset < nRowTextLen) {
+                //定位在本逻辑分行中
+                const size_t nStartCharBaseLen = nRowTextLen - rowInfo.m_charInfo.size();
                 bFound = true;
+                nStartCharRowOffset = (size_t)nStartLineOffset - nStartCharBaseLen;
+                nLineNumber = nLineIndex;
+                nLineRowIndex = nRow;
                 break;
             }
         }
     }
+    else if ((nLineCount > 0) && ((size_t)nCharIndex == GetLineIndex().GetTextLength())) {
+        //最后一行的最后一个字符之后的位置
+        const RichTextLineInfo& lineTextInfo = *lineTextInfoList[nLineCount - 1];
+        const size_t nRowCount = lineTextInfo.m_rowInfo.size();
+        ASSERT(nRowCount != 0);
+        if (nRowCount > 0) {
+            const RichTextRowInfo& rowInfo = *lineTextInfo.m_rowInfo[nRowCount - 1];
+            nStartCharRowOffset = rowInfo.m_charInfo.size();
+            nLineNumber = nLineCount - 1;
+            nLineRowIndex = nRowCount - 1;
+            bFound = true;
+        }
+    }
     return bFound;
 }
 
 RichTextRowInfoPtr RichEditData::GetRowInfoFromPoint(const UiPoint& pt) const
 {
     ASSERT(!m_bCacheDirty);
+    //逻辑行按从上到下的顺序排列：先二分查找所在的物理行，再在物理行中二分查找所在的逻辑行
     RichTextRowInfoPtr spRowInfo;
     const RichTextLineInfoList& lineTextInfoList = m_lineTextInfo;
-    const size_t nLineCount = lineTextInfoList.size();
-    for (size_t nLineIndex = 0; nLineIndex < nLineCount; ++nLineIndex) {
-        ASSERT(lineTextInfoList[nLineIndex] != nullptr);
-        const RichTextLineInfo& lineTextInfo = *lineTextInfoList[nLineIndex];
-        const size_t nRowCount = lineTextInfo.m_rowInfo.size();
-        for (size_t nRow = 0; nRow < nRowCount; ++nRow) {
-            ASSERT(lineTextInfo.m_rowInfo[nRow] != nullptr);
-            const RichTextRowInfo& rowInfo = *lineTextInfo.m_rowInfo[nRow];
-            const UiRectF& rowRect = rowInfo.m_rowRect;
-            if ((pt.y >= rowRect.top) && (pt.y < rowRect.bottom)) {
-                spRowInfo = lineTextInfo.m_rowInfo[nRow];
-                break;
-            }
-        }
-        if (spRowInfo != nullptr) {
-            break;
+    const size_t nLineCount = std::min(lineTextInfoList.size(), m_nCalcLineCount); //尚未计算的行，没有行数据
+    auto lineIter = std::partition_point(lineTextInfoList.begin(), lineTextInfoList.begin() + nLineCount,
+                                         [&pt](const RichTextLineInfoPtr& spLineInfo) {
+            ASSERT((spLineInfo != nullptr) && !spLineInfo->m_rowInfo.empty());
+            return spLineInfo->m_rowInfo.empty() || (spLineInfo->m_rowInfo.back()->m_rowRect.bottom <= pt.y);
+        });
+    if (lineIter == (lineTextInfoList.begin() + nLineCount)) {
+        return spRowInfo;
+    }
+    const std::vector<RichTextRowInfoPtr>& rowInfoList = (*lineIter)->m_rowInfo;
+    auto rowIter = std::partition_point(rowInfoList.begin(), rowInfoList.end(), [&pt](const RichTextRowInfoPtr& spRow) {
+            return spRow->m_rowRect.bottom <= pt.y;
+        });
+    if (rowIter != rowInfoList.end()) {
+        const UiRectF& rowRect = (*rowIter)->m_rowRect;
+        if ((pt.y >= rowRect.top) && (pt.y < rowRect.bottom)) {
+            spRowInfo = *rowIter;
         }
     }
     return spRowInfo;
@@ -1342,7 +1483,7 @@ size_t RichEditData::GetRowInfoStartIndex(const RichTextRowInfoPtr& spRowInfo) c
 void RichEditData::UpdateRowInfo(size_t nDrawStartLineIndex)
 {
     RichTextLineInfoList& lineTextInfoList = m_lineTextInfo;
-    const size_t nLineCount = lineTextInfoList.size();
+    const size_t nLineCount = std::min(lineTextInfoList.size(), m_nCalcLineCount); //尚未计算的行，没有行数据
     ASSERT(nDrawStartLineIndex < nLineCount);
     if (nDrawStartLineIndex >= nLineCount) {
         return;
@@ -1432,7 +1573,7 @@ UiPoint RichEditData::PosForEmptyText() const
 UiPoint RichEditData::CaretPosFromChar(int32_t nCharIndex)
 {
     //检查并计算字符位置
-    CheckCalcTextRects();
+    CheckCalcCharTextRects(nCharIndex);
 
     if (m_rcTextDrawRect.IsEmpty()) {
         //绘制区域为空
@@ -1491,7 +1632,7 @@ UiPoint RichEditData::CaretPosFromChar(int32_t nCharIndex)
 UiRect RichEditData::GetCharRowRect(int32_t nCharIndex)
 {
     //检查并计算字符位置
-    CheckCalcTextRects();
+    CheckCalcCharTextRects(nCharIndex);
 
     UiRect rowRect;
     if (m_lineTextInfo.empty()) {
@@ -1528,7 +1669,7 @@ UiRect RichEditData::GetCharRowRect(int32_t nCharIndex)
 UiPoint RichEditData::PosFromChar(int32_t nCharIndex)
 {
     //检查并计算字符位置
-    CheckCalcTextRects();
+    CheckCalcCharTextRects(nCharIndex);
 
     UiPoint pt;
     if (m_lineTextInfo.empty()) {
@@ -1585,8 +1726,8 @@ int32_t RichEditData::CharFromPos(UiPoint pt)
         return 0;
     }
 
-    //检查并计算字符位置
-    CheckCalcTextRects();
+    //检查并计算字符位置（可见区域）
+    CheckCalcViewTextRects();
 
     if (m_rcTextDrawRect.IsEmpty()) {
         //文本显示区域为空
@@ -1595,6 +1736,10 @@ int32_t RichEditData::CharFromPos(UiPoint pt)
 
     //转换为内部坐标
     ConvertToInternal(pt);
+    if (!IsTextRectsCalcCompleted() && (pt.y >= m_rcTextRect.bottom)) {
+        //该点在已计算的区域下方，需要计算所有的行
+        CheckCalcTextRects();
+    }
 
     //横向按字符边界对齐，纵向按行高对齐
     int32_t nCharPosIndex = -1;
@@ -1717,41 +1862,36 @@ int32_t RichEditData::GetNextValidCharIndex(const int32_t nCharIndex)
     CheckCalcTextRects();
 
     int32_t nNewCharIndex = nCharIndex;
-    size_t nTextLen = 0; //文本总长度
-    const size_t nLineCount = m_lineTextInfo.size();
-    for (size_t nIndex = 0; nIndex < nLineCount; ++nIndex) {
+    size_t nIndex = 0;              //物理行号
+    size_t nStartCharBaseLen = 0;   //在该行之前的总长度
+    if (FindCharLine(nCharIndex, nIndex, nStartCharBaseLen)) {
         const RichTextLineInfo& lineText = *m_lineTextInfo[nIndex];
         ASSERT(lineText.m_nLineTextLen > 0);
-        nTextLen += lineText.m_nLineTextLen;
-        if (nCharIndex < (int32_t)nTextLen) {
-            const size_t nStartCharBaseLen = nTextLen - lineText.m_nLineTextLen;
-            const size_t nStartCharLineOffset = (size_t)nCharIndex - nStartCharBaseLen;
-            ASSERT(nStartCharLineOffset < lineText.m_nLineTextLen);
-            //在本行中寻找
-            size_t i = nStartCharLineOffset + 1;
-            while ( i < lineText.m_nLineTextLen) {
-                const uint16_t* src = (const uint16_t*)(lineText.m_lineText.c_str() + i);
-                if (SkUTF16_IsHighSurrogate(*src)) {
-                    ASSERT(SkUTF16_IsLowSurrogate(*(src + 1)));
-                    nNewCharIndex = (int32_t)(nStartCharBaseLen + i);
-                    break;
-                }
-                else if (SkUTF16_IsLowSurrogate(*src)) {
-                    i += 1;//跳过该字符
-                }
-                else {
-                    nNewCharIndex = (int32_t)(nStartCharBaseLen + i);
-                    break;
-                }
+        const size_t nStartCharLineOffset = (size_t)nCharIndex - nStartCharBaseLen;
+        ASSERT(nStartCharLineOffset < lineText.m_nLineTextLen);
+        //在本行中寻找
+        size_t i = nStartCharLineOffset + 1;
+        while ( i < lineText.m_nLineTextLen) {
+            const uint16_t* src = (const uint16_t*)(lineText.m_lineText.c_str() + i);
+            if (SkUTF16_IsHighSurrogate(*src)) {
+                ASSERT(SkUTF16_IsLowSurrogate(*(src + 1)));
+                nNewCharIndex = (int32_t)(nStartCharBaseLen + i);
+                break;
             }
-            size_t nNewOffset = (size_t)nNewCharIndex - nStartCharBaseLen;
-            if ((nNewOffset == (lineText.m_nLineTextLen - 1)) && (lineText.m_lineText.data()[nNewOffset] == L'\n')) {
-                //如果已经指向换行符，那么跳到下一个字符(即避免从'\r'跳到'\n')
-                if ((nNewOffset >= 1) && (lineText.m_lineText.data()[nNewOffset - 1] == L'\r')) {
-                    nNewCharIndex += 1;
-                }
+            else if (SkUTF16_IsLowSurrogate(*src)) {
+                i += 1;//跳过该字符
+            }
+            else {
+                nNewCharIndex = (int32_t)(nStartCharBaseLen + i);
+                break;
+            }
+        }
+        size_t nNewOffset = (size_t)nNewCharIndex - nStartCharBaseLen;
+        if ((nNewOffset == (lineText.m_nLineTextLen - 1)) && (lineText.m_lineText.data()[nNewOffset] == L'\n')) {
+            //如果已经指向换行符，那么跳到下一个字符(即避免从'\r'跳到'\n')
+            if ((nNewOffset >= 1) && (lineText.m_lineText.data()[nNewOffset - 1] == L'\r')) {
+                nNewCharIndex += 1;
             }
-            break;
         }
     }
     if (nNewCharIndex == nCharIndex) {
@@ -1783,55 +1923,50 @@ int32_t RichEditData::GetPrevValidCharIndex(int32_t nCharIndex)
     CheckCalcTextRects();
 
     int32_t nNewCharIndex = nCharIndex;
-    size_t nTextLen = 0; //文本总长度
-    const size_t nLineCount = m_lineTextInfo.size();
-    for (size_t nIndex = 0; nIndex < nLineCount; ++nIndex) {
+    size_t nIndex = 0;              //物理行号
+    size_t nStartCharBaseLen = 0;   //在该行之前的总长度
+    if (FindCharLine(nCharIndex, nIndex, nStartCharBaseLen)) {
         const RichTextLineInfo& lineText = *m_lineTextInfo[nIndex];
         ASSERT(lineText.m_nLineTextLen > 0);
-        nTextLen += lineText.m_nLineTextLen;
-        if (nCharIndex < (int32_t)nTextLen) {
-            const size_t nStartCharBaseLen = nTextLen - lineText.m_nLineTextLen;
-            const size_t nStartCharLineOffset = (size_t)nCharIndex - nStartCharBaseLen;
-            ASSERT(nStartCharLineOffset < lineText.m_nLineTextLen);
-            //在本行中寻找
-            int32_t i = (int32_t)nStartCharLineOffset - 1;
-            while (i >= 0) {
-                const uint16_t* src = (const uint16_t*)(lineText.m_lineText.c_str() + i);
-                if (SkUTF16_IsHighSurrogate(*src)) {
-                    ASSERT(SkUTF16_IsLowSurrogate(*(src + 1)));
-                    nNewCharIndex = (int32_t)(nStartCharBaseLen + i);
-                    break;
-                }
-                else if (SkUTF16_IsLowSurrogate(*src)) {
-                    i -= 1;//跳过该字符
-                }
-                else {
-                    nNewCharIndex = (int32_t)(nStartCharBaseLen + i);
-                    break;
-                }
+        const size_t nStartCharLineOffset = (size_t)nCharIndex - nStartCharBaseLen;
+        ASSERT(nStartCharLineOffset < lineText.m_nLineTextLen);
+        //在本行中寻找
+        int32_t i = (int32_t)nStartCharLineOffset - 1;
+        while (i >= 0) {
+            const uint16_t* src = (const uint16_t*)(lineText.m_lineText.c_str() + i);
+            if (SkUTF16_IsHighSurrogate(*src)) {
+                ASSERT(SkUTF16_IsLowSurrogate(*(src + 1)));
+                nNewCharIndex = (int32_t)(nStartCharBaseLen + i);
+                break;
             }
-            if ((nNewCharIndex == nCharIndex) && (i <= 0) && (nIndex >= 1)) {
-                //已经在行首，跳到前一行的最后一个字符
-                const RichTextLineInfo& prevLineText = *m_lineTextInfo[nIndex - 1];
-                ASSERT(prevLineText.m_nLineTextLen > 0);
-                if (prevLineText.m_nLineTextLen > 1) {
-                    ASSERT(prevLineText.m_lineText.data()[prevLineText.m_nLineTextLen - 1] == L'\n');
-                    nNewCharIndex = nCharIndex - 2; //跳过最后一个'\n'字符
-                }
-                else if (prevLineText.m_nLineTextLen == 1) {
-                    nNewCharIndex = nCharIndex - 1; //指向此字符
-                }
+            else if (SkUTF16_IsLowSurrogate(*src)) {
+                i -= 1;//跳过该字符
             }
             else {
-                size_t nNewOffset = (size_t)nNewCharIndex - nStartCharBaseLen;
-                if ((nNewOffset == (lineText.m_nLineTextLen - 1)) && (lineText.m_lineText.data()[nNewOffset] == L'\n')) {
-                    //如果已经指向换行符，那么跳到前面的一个回车字符
-                    if ((nNewOffset >= 1) && (lineText.m_lineText.data()[nNewOffset - 1] == L'\r')) {
-                        nNewCharIndex -= 1;
-                    }
+                nNewCharIndex = (int32_t)(nStartCharBaseLen + i);
+                break;
+            }
+        }
+        if ((nNewCharIndex == nCharIndex) && (i <= 0) && (nIndex >= 1)) {
+            //已经在行首，跳到前一行的最后一个字符
+            const RichTextLineInfo& prevLineText = *m_lineTextInfo[nIndex - 1];
+            ASSERT(prevLineText.m_nLineTextLen > 0);
+            if (prevLineText.m_nLineTextLen > 1) {
+                ASSERT(prevLineText.m_lineText.data()[prevLineText.m_nLineTextLen - 1] == L'\n');
+                nNewCharIndex = nCharIndex - 2; //跳过最后一个'\n'字符
+            }
+            else if (prevLineText.m_nLineTextLen == 1) {
+                nNewCharIndex = nCharIndex - 1; //指向此字符
+            }
+        }
+        else {
+            size_t nNewOffset = (size_t)nNewCharIndex - nStartCharBaseLen;
+            if ((nNewOffset == (lineText.m_nLineTextLen - 1)) && (lineText.m_lineText.data()[nNewOffset] == L'\n')) {
+                //如果已经指向换行符，那么跳到前面的一个回车字符
+                if ((nNewOffset >= 1) && (lineText.m_lineText.data()[nNewOffset - 1] == L'\r')) {
+                    nNewCharIndex -= 1;
                 }
             }
-            break;
         }
     }
     if ((nNewCharIndex == nCharIndex) && (nNewCharIndex > 0)) {
@@ -1869,58 +2004,53 @@ int32_t RichEditData::GetNextValidWordIndex(int32_t nCharIndex)
     CheckCalcTextRects();
 
     int32_t nNewCharIndex = nCharIndex;
-    size_t nTextLen = 0; //文本总长度
-    const size_t nLineCount = m_lineTextInfo.size();
-    for (size_t nIndex = 0; nIndex < nLineCount; ++nIndex) {
+    size_t nIndex = 0;              //物理行号
+    size_t nStartCharBaseLen = 0;   //在该行之前的总长度
+    if (FindCharLine(nCharIndex, nIndex, nStartCharBaseLen)) {
         const RichTextLineInfo& lineText = *m_lineTextInfo[nIndex];
         ASSERT(lineText.m_nLineTextLen > 0);
-        nTextLen += lineText.m_nLineTextLen;
-        if (nCharIndex < (int32_t)nTextLen) {
-            const size_t nStartCharBaseLen = nTextLen - lineText.m_nLineTextLen;
-            const size_t nStartCharLineOffset = (size_t)nCharIndex - nStartCharBaseLen;
-            ASSERT(nStartCharLineOffset < lineText.m_nLineTextLen);
-            //在本行中寻找，直到找到一个分隔符（空格，标点符号等）
-            size_t i = nStartCharLineOffset + 1;
-            bool bFoundBlank = lineText.m_lineText.data()[nStartCharLineOffset] == L' ';
-            while (i < lineText.m_nLineTextLen) {
-                //如果是空格，则跳过连续所有空格
-                while ((i < lineText.m_nLineTextLen) && lineText.m_lineText.data()[i] == L' ') {
-                    bFoundBlank = true;
-                    ++i;
-                }
-                if (i >= lineText.m_nLineTextLen) {
-                    //已经到达行尾
-                    nNewCharIndex = (int32_t)(nStartCharBaseLen + lineText.m_nLineTextLen - 1);
-                    break;
-                }
-                if (bFoundBlank) {
-                    //有空格时，终止在空格后的字符
-                    nNewCharIndex = (int32_t)(nStartCharBaseLen + i);
-                    break;
-                }
-                if (IsSeperatorChar(lineText.m_lineText.data()[nStartCharLineOffset]) ||
-                    IsSeperatorChar(lineText.m_lineText.data()[i])) {
-                    //当前字符是分隔符，终止
-                    nNewCharIndex = (int32_t)(nStartCharBaseLen + i);
-                    break;
-                }
-                const uint16_t* src = (const uint16_t*)(lineText.m_lineText.c_str() + i);
-                if (SkUTF16_IsHighSurrogate(*src)) {
-                    ASSERT(SkUTF16_IsLowSurrogate(*(src + 1)));
-                    i += 2;//跳过该双字节字符
-                }
-                else {
-                    i += 1;//跳过该字符
-                }
+        const size_t nStartCharLineOffset = (size_t)nCharIndex - nStartCharBaseLen;
+        ASSERT(nStartCharLineOffset < lineText.m_nLineTextLen);
+        //在本行中寻找，直到找到一个分隔符（空格，标点符号等）
+        size_t i = nStartCharLineOffset + 1;
+        bool bFoundBlank = lineText.m_lineText.data()[nStartCharLineOffset] == L' ';
+        while (i < lineText.m_nLineTextLen) {
+            //如果是空格，则跳过连续所有空格
+            while ((i < lineText.m_nLineTextLen) && lineText.m_lineText.data()[i] == L' ') {
+                bFoundBlank = true;
+                ++i;
+            }
+            if (i >= lineText.m_nLineTextLen) {
+                //已经到达行尾
+                nNewCharIndex = (int32_t)(nStartCharBaseLen + lineText.m_nLineTextLen - 1);
+                break;
             }
-            size_t nNewOffset = (size_t)nNewCharIndex - nStartCharBaseLen;
-            if ((nNewOffset == (lineText.m_nLineTextLen - 1)) && (lineText.m_lineText.data()[nNewOffset] == L'\n')) {
-                //如果已经指向换行符，那么跳到下一个字符(即避免从'\r'跳到'\n')
-                if ((nNewOffset >= 1) && (lineText.m_lineText.data()[nNewOffset - 1] == L'\r')) {
-                    nNewCharIndex += 1;
-                }
+            if (bFoundBlank) {
+                //有空格时，终止在空格后的字符
+                nNewCharIndex = (int32_t)(nStartCharBaseLen + i);
+                break;
+            }
+            if (IsSeperatorChar(lineText.m_lineText.data()[nStartCharLineOffset]) ||
+                IsSeperatorChar(lineText.m_lineText.data()[i])) {
+                //当前字符是分隔符，终止
+                nNewCharIndex = (int32_t)(nStartCharBaseLen + i);
+                break;
+            }
+            const uint16_t* src = (const uint16_t*)(lineText.m_lineText.c_str() + i);
+            if (SkUTF16_IsHighSurrogate(*src)) {
+                ASSERT(SkUTF16_IsLowSurrogate(*(src + 1)));
+                i += 2;//跳过该双字节字符
+            }
+            else {
+                i += 1;//跳过该字符
+            }
+        }
+        size_t nNewOffset = (size_t)nNewCharIndex - nStartCharBaseLen;
+        if ((nNewOffset == (lineText.m_nLineTextLen - 1)) && (lineText.m_lineText.data()[nNewOffset] == L'\n')) {
+            //如果已经指向换行符，那么跳到下一个字符(即避免从'\r'跳到'\n')
+            if ((nNewOffset >= 1) && (lineText.m_lineText.data()[nNewOffset - 1] == L'\r')) {
+                nNewCharIndex += 1;
             }
-            break;
         }
     }
     if (nNewCharIndex == nCharIndex) {
@@ -1952,75 +2082,70 @@ int32_t RichEditData::GetPrevValidWordIndex(int32_t nCharIndex)
     CheckCalcTextRects();
 
     int32_t nNewCharIndex = nCharIndex;
-    size_t nTextLen = 0; //文本总长度
-    const size_t nLineCount = m_lineTextInfo.size();
-    for (size_t nIndex = 0; nIndex < nLineCount; ++nIndex) {
+    size_t nIndex = 0;              //物理行号
+    size_t nStartCharBaseLen = 0;   //在该行之前的总长度
+    if (FindCharLine(nCharIndex, nIndex, nStartCharBaseLen)) {
         const RichTextLineInfo& lineText = *m_lineTextInfo[nIndex];
         ASSERT(lineText.m_nLineTextLen > 0);
-        nTextLen += lineText.m_nLineTextLen;
-        if (nCharIndex < (int32_t)nTextLen) {
-            const size_t nStartCharBaseLen = nTextLen - lineText.m_nLineTextLen;
-            const size_t nStartCharLineOffset = (size_t)nCharIndex - nStartCharBaseLen;
-            ASSERT(nStartCharLineOffset < lineText.m_nLineTextLen);
-            //在本行中寻找
-            int32_t i = (int32_t)nStartCharLineOffset - 1;            
-            bool bFoundBlank = lineText.m_lineText.data()[nStartCharLineOffset] == L' ';
-            while (i >= 0) {
-                //跳过连续的空格
-                while ((i >= 0) && (lineText.m_lineText.data()[i] == L' ')) {
-                    bFoundBlank = true;
-                    i -= 1;//跳过该字符
-                }
+        const size_t nStartCharLineOffset = (size_t)nCharIndex - nStartCharBaseLen;
+        ASSERT(nStartCharLineOffset < lineText.m_nLineTextLen);
+        //在本行中寻找
+        int32_t i = (int32_t)nStartCharLineOffset - 1;            
+        bool bFoundBlank = lineText.m_lineText.data()[nStartCharLineOffset] == L' ';
+        while (i >= 0) {
+            //跳过连续的空格
+            while ((i >= 0) && (lineText.m_lineText.data()[i] == L' ')) {
+                bFoundBlank = true;
+                i -= 1;//跳过该字符
+            }
 
-                if (i > 0) {
-                    const uint16_t* src = (const uint16_t*)(lineText.m_lineText.c_str() + i);
-                    if (SkUTF16_IsLowSurrogate(*src)) {
-                        i -= 1;//跳过低代理字符
-                    }
+            if (i > 0) {
+                const uint16_t* src = (const uint16_t*)(lineText.m_lineText.c_str() + i);
+                if (SkUTF16_IsLowSurrogate(*src)) {
+                    i -= 1;//跳过低代理字符
                 }
+            }
 
-                if (i <= 0) {
-                    //已经到达行首
-                    nNewCharIndex = (int32_t)nStartCharBaseLen;
-                    break;
-                }
+            if (i <= 0) {
+                //已经到达行首
+                nNewCharIndex = (int32_t)nStartCharBaseLen;
+                break;
+            }
 
-                if (bFoundBlank) {
-                    //有空格时，终止在空格前的字符，但不包含空格前的字符
-                    nNewCharIndex = (int32_t)(nStartCharBaseLen + i + 1);
-                    break;
-                }
+            if (bFoundBlank) {
+                //有空格时，终止在空格前的字符，但不包含空格前的字符
+                nNewCharIndex = (int32_t)(nStartCharBaseLen + i + 1);
+                break;
+            }
 
-                if (IsSeperatorChar(lineText.m_lineText.data()[i])) {
-                    //当前字符是分隔符，终止，但不包含分割字符本身
-                    nNewCharIndex = (int32_t)(nStartCharBaseLen + i + 1);
-                    break;
-                }
-            
-                i -= 1;//跳过该字符
+            if (IsSeperatorChar(lineText.m_lineText.data()[i])) {
+                //当前字符是分隔符，终止，但不包含分割字符本身
+                nNewCharIndex = (int32_t)(nStartCharBaseLen + i + 1);
+                break;
             }
-            if ((nNewCharIndex == nCharIndex) && (i <= 0) && (nIndex >= 1)) {
-                //已经在行首，跳到前一行的最后一个字符
-                const RichTextLineInfo& prevLineText = *m_lineTextInfo[nIndex - 1];
-                ASSERT(prevLineText.m_nLineTextLen > 0);
-                if (prevLineText.m_nLineTextLen > 1) {
-                    ASSERT(prevLineText.m_lineText.data()[prevLineText.m_nLineTextLen - 1] == L'\n');
-                    nNewCharIndex = nCharIndex - 2; //跳过最后一个'\n'字符
-                }
-                else if (prevLineText.m_nLineTextLen == 1) {
-                    nNewCharIndex = nCharIndex - 1; //指向此字符
-                }
+        
+            i -= 1;//跳过该字符
+        }
+        if ((nNewCharIndex == nCharIndex) && (i <= 0) && (nIndex >= 1)) {
+            //已经在行首，跳到前一行的最后一个字符
+            const RichTextLineInfo& prevLineText = *m_lineTextInfo[nIndex - 1];
+            ASSERT(prevLineText.m_nLineTextLen > 0);
+            if (prevLineText.m_nLineTextLen > 1) {
+                ASSERT(prevLineText.m_lineText.data()[prevLineText.m_nLineTextLen - 1] == L'\n');
+                nNewCharIndex = nCharIndex - 2; //跳过最后一个'\n'字符
             }
-            else {
-                size_t nNewOffset = (size_t)nNewCharIndex - nStartCharBaseLen;
-                if ((nNewOffset == (lineText.m_nLineTextLen - 1)) && (lineText.m_lineText.data()[nNewOffset] == L'\n')) {
-                    //如果已经指向换行符，那么跳到前面的一个回车字符
-                    if ((nNewOffset >= 1) && (lineText.m_lineText.data()[nNewOffset - 1] == L'\r')) {
-                        nNewCharIndex -= 1;
-                    }
+            else if (prevLineText.m_nLineTextLen == 1) {
+                nNewCharIndex = nCharIndex - 1; //指向此字符
+            }
+        }
+        else {
+            size_t nNewOffset = (size_t)nNewCharIndex - nStartCharBaseLen;
+            if ((nNewOffset == (lineText.m_nLineTextLen - 1)) && (lineText.m_lineText.data()[nNewOffset] == L'\n')) {
+                //如果已经指向换行符，那么跳到前面的一个回车字符
+                if ((nNewOffset >= 1) && (lineText.m_lineText.data()[nNewOffset - 1] == L'\r')) {
+                    nNewCharIndex -= 1;
                 }
             }
-            break;
         }
     }
     if ((nNewCharIndex == nCharIndex) && (nNewCharIndex > 0)) {
@@ -2053,53 +2178,47 @@ bool RichEditData::GetCurrentWordIndex(int32_t nCharIndex, int32_t& nWordStartIn
     //检查并计算字符位置
     CheckCalcTextRects();
 
-    size_t nTextLen = 0; //文本总长度
-    const size_t nLineCount = m_lineTextInfo.size();
-    for (size_t nIndex = 0; nIndex < nLineCount; ++nIndex) {
+    size_t nIndex = 0;              //物理行号
+    size_t nStartCharBaseLen = 0;   //在该行之前的总长度
+    if (FindCharLine(nCharIndex, nIndex, nStartCharBaseLen)) {
         const RichTextLineInfo& lineText = *m_lineTextInfo[nIndex];
         ASSERT(lineText.m_nLineTextLen > 0);
-        nTextLen += lineText.m_nLineTextLen;
-        if (nCharIndex < (int32_t)nTextLen) {
-            const size_t nStartCharBaseLen = nTextLen - lineText.m_nLineTextLen;
-            const size_t nStartCharLineOffset = (size_t)nCharIndex - nStartCharBaseLen;
-            ASSERT(nStartCharLineOffset < lineText.m_nLineTextLen);
-
-            if (IsSeperatorChar(lineText.m_lineText.data()[nStartCharLineOffset])) {
-                //当前字符是分隔符，选择此分隔符
-                nWordStartIndex = (int32_t)(nStartCharBaseLen + nStartCharLineOffset);
-                nWordEndIndex = (int32_t)(nStartCharBaseLen + nStartCharLineOffset + 1);
+        const size_t nStartCharLineOffset = (size_t)nCharIndex - nStartCharBaseLen;
+        ASSERT(nStartCharLineOffset < lineText.m_nLineTextLen);
+
+        if (IsSeperatorChar(lineText.m_lineText.data()[nStartCharLineOffset])) {
+            //当前字符是分隔符，选择此分隔符
+            nWordStartIndex = (int32_t)(nStartCharBaseLen + nStartCharLineOffset);
+            nWordEndIndex = (int32_t)(nStartCharBaseLen + nStartCharLineOffset + 1);
+        }
+        else if (lineText.m_lineText.data()[nStartCharLineOffset] == L' ') {
+            //当前字符是空格符，选择连续的空格
+            size_t i = nStartCharLineOffset + 1;
+            while (i < lineText.m_nLineTextLen) {
+                if (lineText.m_lineText.data()[i] == L' ') {
+                    ++i;
+                    continue;
+                }
+                nWordEndIndex = (int32_t)(nStartCharBaseLen + i);
                 break;
             }
-            else if (lineText.m_lineText.data()[nStartCharLineOffset] == L' ') {
-                //当前字符是空格符，选择连续的空格
-                size_t i = nStartCharLineOffset + 1;
-                while (i < lineText.m_nLineTextLen) {
-                    if (lineText.m_lineText.data()[i] == L' ') {
-                        ++i;
-                        continue;
-                    }
-                    nWordEndIndex = (int32_t)(nStartCharBaseLen + i);
-                    break;
-                }
-                int32_t j = (int32_t)nStartCharLineOffset - 1;
-                while (j >= 0) {
-                    if (lineText.m_lineText.data()[j] == L' ') {
-                        --j;
-                        continue;
-                    }
-                    nWordStartIndex = (int32_t)(nStartCharBaseLen + j + 1);
-                    break;
-                }
-                if ((nWordEndIndex != -1)) {
-                    if (j < 0) {
-                        nWordStartIndex = (int32_t)nStartCharBaseLen;
-                    }
+            int32_t j = (int32_t)nStartCharLineOffset - 1;
+            while (j >= 0) {
+                if (lineText.m_lineText.data()[j] == L' ') {
+                    --j;
+                    continue;
                 }
-                if ((nWordStartIndex != -1) && (nWordEndIndex != -1)) {
-                    break;
+                nWordStartIndex = (int32_t)(nStartCharBaseLen + j + 1);
+                break;
+            }
+            if ((nWordEndIndex != -1)) {
+                if (j < 0) {
+                    nWordStartIndex = (int32_t)nStartCharBaseLen;
                 }
             }
+        }
 
+        if ((nWordStartIndex == -1) || (nWordEndIndex == -1)) {
             //定位结束字符：向后，直到找到一个分隔符（空格，标点符号等）
             size_t i = nStartCharLineOffset + 1;
             while (i < lineText.m_nLineTextLen) {
@@ -2137,7 +2256,6 @@ bool RichEditData::GetCurrentWordIndex(int32_t nCharIndex, int32_t& nWordStartIn
             if (nWordStartIndex == -1) {
                 nWordStartIndex = (int32_t)nStartCharBaseLen;
             }
-            break;
         }
     }
     return (nWordEndIndex > nWordStartIndex) && (nWordStartIndex >= 0) && (nWordEndIndex >= 0);
@@ -2160,17 +2278,12 @@ int32_t RichEditData::GetRowStartCharIndex(int32_t nCharIndex)
     CheckCalcTextRects();
 
     int32_t nNewCharIndex = nCharIndex;
-    size_t nTextLen = 0; //文本总长度
-    const size_t nLineCount = m_lineTextInfo.size();
-    for (size_t nIndex = 0; nIndex < nLineCount; ++nIndex) {
-        const RichTextLineInfo& lineText = *m_lineTextInfo[nIndex];
-        ASSERT(lineText.m_nLineTextLen > 0);
-        nTextLen += lineText.m_nLineTextLen;
-        if (nCharIndex < (int32_t)nTextLen) {
-            //在本行中寻找
-            nNewCharIndex = (int32_t)nTextLen - lineText.m_nLineTextLen;
-            break;
-        }
+    size_t nIndex = 0;              //物理行号
+    size_t nStartCharBaseLen = 0;   //在该行之前的总长度
+    if (FindCharLine(nCharIndex, nIndex, nStartCharBaseLen)) {
+        ASSERT_UNUSED_VARIABLE(m_lineTextInfo[nIndex]->m_nLineTextLen > 0);
+        //在本行中寻找
+        nNewCharIndex = (int32_t)nStartCharBaseLen;
     }
     if (nNewCharIndex < 0) {
         nNewCharIndex = 0;
@@ -2198,24 +2311,19 @@ int32_t RichEditData::GetRowEndCharIndex(int32_t nCharIndex)
     CheckCalcTextRects();
 
     int32_t nNewCharIndex = nCharIndex;
-    size_t nTextLen = 0; //文本总长度
-    const size_t nLineCount = m_lineTextInfo.size();
-    for (size_t nIndex = 0; nIndex < nLineCount; ++nIndex) {
+    size_t nIndex = 0;              //物理行号
+    size_t nStartCharBaseLen = 0;   //在该行之前的总长度
+    if (FindCharLine(nCharIndex, nIndex, nStartCharBaseLen)) {
         const RichTextLineInfo& lineText = *m_lineTextInfo[nIndex];
         ASSERT(lineText.m_nLineTextLen > 0);
-        nTextLen += lineText.m_nLineTextLen;
-        if (nCharIndex < (int32_t)nTextLen) {
-            //在本行中寻找
-            const size_t nStartCharBaseLen = nTextLen - lineText.m_nLineTextLen;
-            nNewCharIndex = (int32_t)(nTextLen - 1);
-            size_t nNewOffset = (size_t)nNewCharIndex - nStartCharBaseLen;
-            if ((nNewOffset == (lineText.m_nLineTextLen - 1)) && (lineText.m_lineText.data()[nNewOffset] == L'\n')) {
-                //如果已经指向换行符，那么跳到前面的回车符'\r'
-                if ((nNewOffset >= 1) && (lineText.m_lineText.data()[nNewOffset - 1] == L'\r')) {
-                    nNewCharIndex -= 1;
-                }
+        //在本行中寻找
+        nNewCharIndex = (int32_t)(nStartCharBaseLen + lineText.m_nLineTextLen - 1);
+        size_t nNewOffset = (size_t)nNewCharIndex - nStartCharBaseLen;
+        if ((nNewOffset == (lineText.m_nLineTextLen - 1)) && (lineText.m_lineText.data()[nNewOffset] == L'\n')) {
+            //如果已经指向换行符，那么跳到前面的回车符'\r'
+            if ((nNewOffset >= 1) && (lineText.m_lineText.data()[nNewOffset - 1] == L'\r')) {
+                nNewCharIndex -= 1;
             }
-            break;
         }
     }
     if (nNewCharIndex < 0) {
@@ -2230,7 +2338,7 @@ int32_t RichEditData::GetRowEndCharIndex(int32_t nCharIndex)
 int32_t RichEditData::GetCharWidthValue(int32_t nCharIndex)
 {
     //检查并计算字符位置
-    CheckCalcTextRects();
+    CheckCalcCharTextRects(nCharIndex);
 
     int32_t nCharWidth = 0;
     size_t nStartCharRowOffset = 0;
@@ -2254,7 +2362,7 @@ void RichEditData::GetCharRangeRects(int32_t nStartChar, int32_t nEndChar, std::
     }
 
     //检查并计算字符位置
-    CheckCalcTextRects();
+    CheckCalcCharTextRects(std::max(nStartChar, nEndChar));
 
     if ((nStartChar < 0) || (nStartChar >= nTextLength) || (nEndChar <= nStartChar) || (nEndChar > nTextLength)) {
         return;
@@ -2477,7 +2585,7 @@ void RichEditData::EmptyUndoBuffer()
     ClearUndoList();
 }
 
-void RichEditData::AddToUndoList(int32_t nStartChar, const DStringW& newText, const DStringW& oldText)
+void RichEditData::AddToUndoList(int32_t nStartChar, TTextPiece&& newText, TTextPiece&& oldText)
 {
     ASSERT(nStartChar >= 0);
     if (nStartChar < 0) {
@@ -2488,10 +2596,18 @@ void RichEditData::AddToUndoList(int32_t nStartChar, const DStringW& newText, co
         return;
     }
 
+    //旧文本所在的行已经从文本中删除，释放其排版数据，只保留文本
+    for (const RichTextLineInfoPtr& spLineInfo : oldText.m_lines) {
+        if (spLineInfo != nullptr) {
+            std::vector<RichTextRowInfoPtr> rowInfo;
+            spLineInfo->m_rowInfo.swap(rowInfo);
+        }
+    }
+
     TUndoData undoData;
     undoData.m_nStartChar = nStartChar;
-    undoData.m_newText = newText;
-    undoData.m_oldText = oldText;
+    undoData.m_newText = std::move(newText);
+    undoData.m_oldText = std::move(oldText);
 
     while (!m_undoList.empty() && (m_undoList.size() >= m_nUndoLimit)) {
         m_undoList.pop_front();
@@ -2504,6 +2620,30 @@ void RichEditData::AddToUndoList(int32_t nStartChar, const DStringW& newText, co
     m_redoList.clear();
 }
 
+DStringW RichEditData::GetTextPieceText(const TTextPiece& textPiece)
+{
+    if (textPiece.m_lines.empty()) {
+        ASSERT(textPiece.m_text.size() == textPiece.m_nLength);
+        return textPiece.m_text;
+    }
+    DStringW text;
+    text.reserve(textPiece.m_nLength);
+    for (const RichTextLineInfoPtr& spLineInfo : textPiece.m_lines) {
+        ASSERT(spLineInfo != nullptr);
+        if (spLineInfo == nullptr) {
+            continue;
+        }
+        const RichTextLineInfo& lineText = *spLineInfo;
+        const size_t nCount = std::min((size_t)lineText.m_nLineTextLen, textPiece.m_nLength - text.size());
+        text.append(lineText.m_lineText.c_str(), nCount);
+        if (text.size() >= textPiece.m_nLength) {
+            break;
+        }
+    }
+    ASSERT(text.size() == textPiece.m_nLength);
+    return text;
+}
+
 bool RichEditData::CanUndo() const
 {
     return !m_undoList.empty();
@@ -2511,22 +2651,16 @@ bool RichEditData::CanUndo() const
 
 bool RichEditData::Undo(int32_t& nEndCharIndex)
 {
-    //检查并计算字符位置
-    CheckCalcTextRects();
-
     bool bRet = false;
     if (!m_undoList.empty()) {
-        //取出Undo列表尾部的数据
-        TUndoData undoData = m_undoList.back();
-        m_undoList.pop_back();
-
-        //添加到redo列表
-        m_redoList.push_back(undoData);
+        //取出Undo列表尾部的数据，添加到redo列表
+        m_redoList.splice(m_redoList.end(), m_undoList, std::prev(m_undoList.end()));
+        const TUndoData& undoData = m_redoList.back();
 
         //执行Undo操作
-        nEndCharIndex = undoData.m_nStartChar + (int32_t)undoData.m_newText.size();
-        bRet = ReplaceText(undoData.m_nStartChar, nEndCharIndex, undoData.m_oldText, false, false);
-        nEndCharIndex = undoData.m_nStartChar + (int32_t)undoData.m_oldText.size();
+        nEndCharIndex = undoData.m_nStartChar + (int32_t)undoData.m_newText.m_nLength;
+        bRet = ReplaceText(undoData.m_nStartChar, nEndCharIndex, GetTextPieceText(undoData.m_oldText), false, false);
+        nEndCharIndex = undoData.m_nStartChar + (int32_t)undoData.m_oldText.m_nLength;
     }
     if (!bRet) {
         nEndCharIndex = -1;
@@ -2541,22 +2675,16 @@ bool RichEditData::CanRedo() const
 
 bool RichEditData::Redo(int32_t& nEndCharIndex)
 {
-    //检查并计算字符位置
-    CheckCalcTextRects();
-
     bool bRet = false;
     if (!m_redoList.empty()) {
-        //取出Redo列表尾部的数据
-        TUndoData undoData = m_redoList.back();
-        m_redoList.pop_back();
-
-        //添加到undo列表
-        m_undoList.push_back(undoData);
+        //取出Redo列表尾部的数据，添加到undo列表
+        m_undoList.splice(m_undoList.end(), m_redoList, std::prev(m_redoList.end()));
+        const TUndoData& undoData = m_undoList.back();
 
         //执行Redo操作
-        nEndCharIndex = undoData.m_nStartChar + (int32_t)undoData.m_oldText.size();
-        bRet = ReplaceText(undoData.m_nStartChar, nEndCharIndex, undoData.m_newText, false, false);
-        nEndCharIndex = undoData.m_nStartChar + (int32_t)undoData.m_newText.size();
+        nEndCharIndex = undoData.m_nStartChar + (int32_t)undoData.m_oldText.m_nLength;
+        bRet = ReplaceText(undoData.m_nStartChar, nEndCharIndex, GetTextPieceText(undoData.m_newText), false, false);
+        nEndCharIndex = undoData.m_nStartChar + (int32_t)undoData.m_newText.m_nLength;
     }
     if (!bRet) {
         nEndCharIndex = -1;
@@ -2568,6 +2696,8 @@ void RichEditData::Clear()
 {
     RichTextLineInfoList lineTextInfo;
     m_lineTextInfo.swap(lineTextInfo);
+    m_lineIndex.Invalidate();
+    m_nCalcLineCount = 0;
     m_spDrawRichTextCache.reset();
     m_rcTextRect.Clear();
 
@@ -4,6 +4,7 @@
 #include "duilib/Core/UiTypes.h"
 #include "duilib/Core/SharePtr.h"
 #include "duilib/Render/IRender.h"
+#include "duilib/Control/RichEditLineIndex.h"
 #include <unordered_map>
 #include <map>
 #include <list>
@@ -347,10 +348,28 @@ public:
     */
     const std::vector<int32_t>& GetTextRowXOffset() const;
 
-    /** 检查并按需重新计算文本区域
+    /** 检查并按需重新计算文本区域（计算所有的行）
     */
     void CheckCalcTextRects();
 
+    /** 检查并按需重新计算文本区域（只计算到可见区域及预取区域所在的行，其余的行按需计算或者在空闲时计算）
+    */
+    void CheckCalcViewTextRects();
+
+    /** 是否所有行的文本区域都已经计算完成
+    */
+    bool IsTextRectsCalcCompleted() const;
+
+    /** 继续计算后续行的文本区域（用于在空闲时分批计算）
+    * @param [in] nLineCount 本次最多计算的物理行数
+    * @return 如果所有行都已经计算完成返回true，否则返回false
+    */
+    bool CalcMoreTextRects(size_t nLineCount);
+
+    /** 获取已经计算过文本区域的行的文本视图（用于绘制，与绘制缓存中的数据对应）
+    */
+    void GetCalcTextView(std::vector<std::wstring_view>& textView) const;
+
     /** 按字符数限制，截断文本
     */
     void TruncateLimitText(DStringW& text, int32_t nLimitLen) const;
@@ -380,9 +399,20 @@ private:
     */
     void ClearUndoList();
 
+    /** 撤销列表中的文本片段
+    */
+    struct TTextPiece;
+
     /** 记录操作到撤销列表
+    * @param [in] nStartChar 起始下标值
+    * @param [in] newText 新文本所在的片段
+    * @param [in] oldText 旧文本所在的片段
+    */
+    void AddToUndoList(int32_t nStartChar, TTextPiece&& newText, TTextPiece&& oldText);
+
+    /** 获取文本片段的内容
     */
-    void AddToUndoList(int32_t nStartChar, const DStringW& newText, const DStringW& oldText);
+    static DStringW GetTextPieceText(const TTextPiece& textPiece);
 
     /** 从缓存中计算文本所占的矩形区域
     */
@@ -396,10 +426,37 @@ private:
     */
     void UpdateRowTextOffsetX(RichTextLineInfoList& lineTextInfo, HorAlignType hAlignType, std::vector<int32_t>& rowXOffset, bool& bTextRectXOffsetUpdated) const;
 
-    /** 计算文本的区域信息（全部重新计算）
+    /** 计算文本的区域信息（全部重新计算，只计算到可见区域及预取区域所在的行）
     */
     void CalcTextRects();
 
+    /** 检查并按需重新计算文本区域，并且至少计算到指定的行和指定的纵坐标
+    * @param [in] nMinLineCount 至少计算的物理行数
+    * @param [in] nMinBottom 至少计算到的纵坐标（内部坐标）
+    */
+    void CheckCalcTextRects(size_t nMinLineCount, int32_t nMinBottom);
+
+    /** 检查并按需重新计算文本区域，并且至少计算到指定字符所在的行
+    */
+    void CheckCalcCharTextRects(int32_t nCharIndex);
+
+    /** 在已经计算过的行后面，继续计算到指定的行（增量计算）
+    * @param [in] nEndLine 计算到的物理行号（不包含）
+    */
+    void AppendCalcTextRects(size_t nEndLine);
+
+    /** 获取可见区域及预取区域的底部纵坐标（内部坐标）
+    */
+    int32_t GetViewCalcBottom() const;
+
+    /** 按行高估算：计算到指定高度，至少需要计算的物理行数
+    */
+    size_t EstimateCalcLineCount(int32_t nHeight) const;
+
+    /** 估算尚未计算的行所占的高度（按已计算行的平均高度估算）
+    */
+    int32_t EstimateUncalcTextHeight() const;
+
     /** 计算文本的区域信息（只重新计算修改的部分文本）
     * @param [in] nStartLine 重新计算的起始行号
     * @param [in] modifiedLines 有修改的行号
@@ -423,6 +480,17 @@ private:
                          size_t& nStartLine, size_t& nEndLine,
                          size_t& nStartCharLineOffset, size_t& nEndCharLineOffset) const;
 
+    /** 获取物理行的起始位置索引（索引失效时重建）
+    */
+    const RichEditLineIndex& GetLineIndex() const;
+
+    /** 定位字符所属的物理行
+    * @param [in] nCharIndex 字符索引位置，有效范围[0, 文本长度)
+    * @param [out] nLineIndex 物理行号
+    * @param [out] nLineStartChar 物理行的起始字符位置
+    */
+    bool FindCharLine(int32_t nCharIndex, size_t& nLineIndex, size_t& nLineStartChar) const;
+
     /** 判断一个字符是否为分隔符（空格，标点符号等）
     */
     bool IsSeperatorChar(DStringW::value_type ch) const;
@@ -528,6 +596,10 @@ private:
     */
     RichTextLineInfoList m_lineTextInfo;
 
+    /** 物理行的起始位置索引
+    */
+    mutable RichEditLineIndex m_lineIndex;
+
     /** 文本绘制缓存
     */
     std::shared_ptr<DrawRichTextCache> m_spDrawRichTextCache;
@@ -536,14 +608,29 @@ private:
     */
     bool m_bCacheDirty;
 
+    /** 已经计算过文本区域的物理行数（从首行开始连续计算，后面的行尚未计算）
+    */
+    size_t m_nCalcLineCount;
+
 private:
+    /** 文本片段：如果文本由完整的行组成，引用文本所在的行数据，不复制文本
+    *   （行数据创建后文本内容不再修改，修改文本时是删除旧行、插入新行，所以行数据可以安全地共享）；
+    *   否则复制文本内容，避免在长行中编辑少量文本时，撤销列表中的每一步都保留整行的文本
+    */
+    struct TTextPiece
+    {
+        RichTextLineInfoList m_lines;   //文本所在的行（由完整的行组成时有效）
+        DStringW m_text;                //文本内容（不是由完整的行组成时有效）
+        size_t m_nLength = 0;           //文本长度
+    };
+
     /** Undo的数据
     */
     struct TUndoData
     {
         int32_t m_nStartChar = -1;
-        DStringW m_newText;
-        DStringW m_oldText;
+        TTextPiece m_newText;
+        TTextPiece m_oldText;
     };
 
     /** Undo的数据列表
@@ -0,0 +1,89 @@
+#include "RichEditLineIndex.h"
+#include <algorithm>
+
+namespace ui
+{
+RichEditLineIndex::RichEditLineIndex():
+    m_bValid(false)
+{
+}
+
+RichEditLineIndex::~RichEditLineIndex()
+{
+}
+
+void RichEditLineIndex::Build(const RichTextLineInfoList& lineTextInfo)
+{
+    const size_t nLineCount = lineTextInfo.size();
+    std::vector<int64_t> lineTextLens(nLineCount, 0);
+    for (size_t index = 0; index < nLineCount; ++index) {
+        ASSERT(lineTextInfo[index] != nullptr);
+        if (lineTextInfo[index] != nullptr) {
+            lineTextLens[index] = (int64_t)lineTextInfo[index]->m_nLineTextLen;
+        }
+    }
+    m_tree.Assign(lineTextLens);
+    m_bValid = true;
+}
+
+void RichEditLineIndex::Invalidate()
+{
+    m_bValid = false;
+}
+
+bool RichEditLineIndex::IsValid(size_t nLineCount) const
+{
+    return m_bValid && (GetLineCount() == nLineCount);
+}
+
+void RichEditLineIndex::UpdateLine(size_t nLineIndex, size_t nLineTextLen)
+{
+    if (!m_bValid || (nLineIndex >= GetLineCount())) {
+        return;
+    }
+    const int64_t nOldLen = m_tree.GetValue(nLineIndex);
+    const int64_t nNewLen = (int64_t)nLineTextLen;
+    if (nNewLen != nOldLen) {
+        m_tree.Add(nLineIndex, nNewLen - nOldLen);
+    }
+}
+
+void RichEditLineIndex::ReplaceLines(size_t nStartLine, size_t nRemovedCount, size_t nInsertedCount)
+{
+    if (!m_bValid) {
+        return;
+    }
+    if ((nStartLine > GetLineCount()) || (nRemovedCount > (GetLineCount() - nStartLine))) {
+        m_bValid = false;
+        return;
+    }
+    //保留的行原位更新，只在多出（或者减少）的行的位置插入（或者删除）
+    if (nInsertedCount > nRemovedCount) {
+        m_tree.InsertElements(nStartLine + nRemovedCount, nInsertedCount - nRemovedCount, 0);
+    }
+    else if (nRemovedCount > nInsertedCount) {
+        m_tree.RemoveElements(nStartLine + nInsertedCount, nRemovedCount - nInsertedCount);
+    }
+}
+
+size_t RichEditLineIndex::GetLineCount() const
+{
+    return m_tree.GetCount();
+}
+
+size_t RichEditLineIndex::GetTextLength() const
+{
+    return (size_t)m_tree.GetPrefixSum(GetLineCount());
+}
+
+size_t RichEditLineIndex::GetLineStart(size_t nLineIndex) const
+{
+    return (size_t)m_tree.GetPrefixSum(std::min(nLineIndex, GetLineCount()));
+}
+
+size_t RichEditLineIndex::FindLine(size_t nCharIndex) const
+{
+    return m_tree.FindFirstGreater((int64_t)nCharIndex);
+}
+
+}//namespace ui
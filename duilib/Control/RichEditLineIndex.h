@@ -0,0 +1,71 @@
+#ifndef UI_CONTROL_RICHEDIT_LINE_INDEX_H_
+#define UI_CONTROL_RICHEDIT_LINE_INDEX_H_
+
+#include "duilib/Render/IRender.h"
+#include "duilib/Utils/FenwickTree.h"
+
+namespace ui
+{
+/** RichEdit文本物理行的起始位置索引（树状数组，Fenwick tree，以每行的文本长度为元素）
+*   查询某行的起始字符位置、按字符位置查找所在的行：O(logN)；
+*   修改单行的文本长度：O(logN)；行的插入、删除只重建其后的部分：O(N - nLineIndex)
+*/
+class RichEditLineIndex
+{
+public:
+    RichEditLineIndex();
+    ~RichEditLineIndex();
+
+public:
+    /** 按行数据重建索引
+    */
+    void Build(const RichTextLineInfoList& lineTextInfo);
+
+    /** 标记索引失效（下次查询时重建）
+    */
+    void Invalidate();
+
+    /** 索引是否有效
+    * @param [in] nLineCount 当前的行数
+    */
+    bool IsValid(size_t nLineCount) const;
+
+    /** 某行的文本长度发生变化，更新索引（索引无效时忽略）
+    */
+    void UpdateLine(size_t nLineIndex, size_t nLineTextLen);
+
+    /** 从nStartLine开始的nRemovedCount行被替换为nInsertedCount行（索引无效时忽略）
+    *   替换后的行的文本长度需要再调用UpdateLine更新（新增的行的文本长度为0）
+    */
+    void ReplaceLines(size_t nStartLine, size_t nRemovedCount, size_t nInsertedCount);
+
+    /** 获取行数
+    */
+    size_t GetLineCount() const;
+
+    /** 获取文本总长度
+    */
+    size_t GetTextLength() const;
+
+    /** 获取某行的起始字符位置（即前nLineIndex行的文本长度之和）
+    */
+    size_t GetLineStart(size_t nLineIndex) const;
+
+    /** 查找字符所在的行：前(N+1)行的文本长度之和大于nCharIndex的第一行N
+    * @return 返回行号，未找到时返回GetLineCount()
+    */
+    size_t FindLine(size_t nCharIndex) const;
+
+private:
+    /** 每行的文本长度
+    */
+    FenwickTree<int64_t> m_tree;
+
+    /** 索引是否有效
+    */
+    bool m_bValid;
+};
+
+}//namespace ui
+
+#endif //UI_CONTROL_RICHEDIT_LINE_INDEX_H_
@@ -1053,6 +1053,14 @@ private:
     */
     void OnCheckScrollView();
 
+    /** 启动空闲时计算文本区域的定时器（文本区域只计算了可见区域时，其余的行分批计算）
+    */
+    void StartCalcTextRectsTimer();
+
+    /** 空闲时分批计算文本区域，并更新滚动条的范围
+    */
+    void OnCalcTextRectsTimer();
+
     /** 执行了鼠标框选操作(坐标包含了scrollPos值)
     * @param [in] ptMouseDown64 鼠标按下的起点
     * @param [in] ptMouseMove64 鼠标移动的终点
@@ -1297,6 +1305,10 @@ private:
     */
     WeakCallbackFlag m_scrollViewFlag;
 
+    /** 空闲时计算文本区域的定时器取消机制
+    */
+    WeakCallbackFlag m_calcTextRectsFlag;
+
     /** 密码字符闪现功能的定时器取消机制
     */
     WeakCallbackFlag m_falshPasswordFlag;
@@ -8,6 +8,7 @@
 #include "duilib/Utils/StringUtil.h"
 #include "duilib/Utils/StringConvert.h"
 #include "duilib/Utils/AttributeUtil.h"
+#include "duilib/Utils/AttributeTable.h"
 #include "duilib/Utils/BitmapHelper_Windows.h"
 #include "duilib/Utils/PerformanceUtil.h"
 #include "duilib/Render/IRender.h"
@@ -397,303 +398,572 @@ RichEdit::~RichEdit()
     m_pLimitChars.reset();
 }
 
+namespace
+{
+/** RichEdit的属性ID（与属性名称一一对应，兼容的旧属性名称对应相同的属性ID）
+*/
+enum class RichEditAttribute : int32_t
+{
+    kVscrollbar,
+    kHscrollbar,
+    kSingleLine,
+    kMultiLine,
+    kReadonly,
+    kPassword,
+    kShowPassword,
+    kPasswordChar,
+    kFlashPasswordChar,
+    kNumberOnly,
+    kMaxNumber,
+    kMinNumber,
+    kNumberFormat,
+    kTextAlign,
+    kTextPadding,
+    kTextColor,
+    kDisabledTextColor,
+    kCaretColor,
+    kPromptMode,
+    kPromptColor,
+    kPromptText,
+    kPromptTextId,
+    kFocusedImage,
+    kFont,
+    kText,
+    kTextId,
+    kWantTab,
+    kWantReturn,
+    kWantCtrlReturn,
+    kLimitText,
+    kLimitChars,
+    kWordWrap,
+    kNoCaretReadonly,
+    kDefaultContextMenu,
+    kSpinClass,
+    kClearBtnClass,
+    kShowPassowrdBtnClass,
+    kWheelZoom,
+    kHideSelection,
+    kFocusBottomBorderSize,
+    kFocusBottomBorderColor,
+    kSelectAllOnFocus,
+    kRowSpacingMul,
+    kRowSpacingAdd,
+    kZoom,
+    kAutoVscroll,
+    kAutoHscroll,
+    kRichText,
+    kAutoDetectUrl,
+    kAllowBeep,
+    kSaveSelection,
+    kSelectionBkcolor,
+    kInactiveSelectionBkcolor,
+    kCurrentRowBkcolor,
+    kInactiveCurrentRowBkcolor
+};
+
+/** RichEdit的属性表（属性名称 -> 属性ID）
+*/
+constexpr AttributeTableEntry kRichEditAttributeEntries[] = {
+    {"vscrollbar", (int32_t)RichEditAttribute::kVscrollbar},
+    {"hscrollbar", (int32_t)RichEditAttribute::kHscrollbar},
+    {"single_line", (int32_t)RichEditAttribute::kSingleLine},
+    {"singleline", (int32_t)RichEditAttribute::kSingleLine},
+    {"multi_line", (int32_t)RichEditAttribute::kMultiLine},
+    {"multiline", (int32_t)RichEditAttribute::kMultiLine},
+    {"readonly", (int32_t)RichEditAttribute::kReadonly},
+    {"password", (int32_t)RichEditAttribute::kPassword},
+    {"show_password", (int32_t)RichEditAttribute::kShowPassword},
+    {"password_char", (int32_t)RichEditAttribute::kPasswordChar},
+    {"flash_password_char", (int32_t)RichEditAttribute::kFlashPasswordChar},
+    {"number_only", (int32_t)RichEditAttribute::kNumberOnly},
+    {"number", (int32_t)RichEditAttribute::kNumberOnly},
+    {"max_number", (int32_t)RichEditAttribute::kMaxNumber},
+    {"min_number", (int32_t)RichEditAttribute::kMinNumber},
+    {"number_format", (int32_t)RichEditAttribute::kNumberFormat},
+    {"text_align", (int32_t)RichEditAttribute::kTextAlign},
+    {"text_padding", (int32_t)RichEditAttribute::kTextPadding},
+    {"textpadding", (int32_t)RichEditAttribute::kTextPadding},
+    {"text_color", (int32_t)RichEditAttribute::kTextColor},
+    {"normal_text_color", (int32_t)RichEditAttribute::kTextColor},
+    {"normaltextcolor", (int32_t)RichEditAttribute::kTextColor},
+    {"disabled_text_color", (int32_t)RichEditAttribute::kDisabledTextColor},
+    {"disabledtextcolor", (int32_t)RichEditAttribute::kDisabledTextColor},
+    {"caret_color", (int32_t)RichEditAttribute::kCaretColor},
+    {"caretcolor", (int32_t)RichEditAttribute::kCaretColor},
+    {"prompt_mode", (int32_t)RichEditAttribute::kPromptMode},
+    {"promptmode", (int32_t)RichEditAttribute::kPromptMode},
+    {"prompt_color", (int32_t)RichEditAttribute::kPromptColor},
+    {"promptcolor", (int32_t)RichEditAttribute::kPromptColor},
+    {"prompt_text", (int32_t)RichEditAttribute::kPromptText},
+    {"prompttext", (int32_t)RichEditAttribute::kPromptText},
+    {"prompt_text_id", (int32_t)RichEditAttribute::kPromptTextId},
+    {"prompt_textid", (int32_t)RichEditAttribute::kPromptTextId},
+    {"prompttextid", (int32_t)RichEditAttribute::kPromptTextId},
+    {"focused_image", (int32_t)RichEditAttribute::kFocusedImage},
+    {"focusedimage", (int32_t)RichEditAttribute::kFocusedImage},
+    {"font", (int32_t)RichEditAttribute::kFont},
+    {"text", (int32_t)RichEditAttribute::kText},
+    {"text_id", (int32_t)RichEditAttribute::kTextId},
+    {"textid", (int32_t)RichEditAttribute::kTextId},
+    {"want_tab", (int32_t)RichEditAttribute::kWantTab},
+    {"wanttab", (int32_t)RichEditAttribute::kWantTab},
+    {"want_return", (int32_t)RichEditAttribute::kWantReturn},
+    {"want_return_msg", (int32_t)RichEditAttribute::kWantReturn},
+    {"wantreturnmsg", (int32_t)RichEditAttribute::kWantReturn},
+    {"want_ctrl_return", (int32_t)RichEditAttribute::kWantCtrlReturn},
+    {"return_msg_want_ctrl", (int32_t)RichEditAttribute::kWantCtrlReturn},
+    {"returnmsgwantctrl", (int32_t)RichEditAttribute::kWantCtrlReturn},
+    {"limit_text", (int32_t)RichEditAttribute::kLimitText},
+    {"max_char", (int32_t)RichEditAttribute::kLimitText},
+    {"maxchar", (int32_t)RichEditAttribute::kLimitText},
+    {"limit_chars", (int32_t)RichEditAttribute::kLimitChars},
+    {"word_wrap", (int32_t)RichEditAttribute::kWordWrap},
+    {"no_caret_readonly", (int32_t)RichEditAttribute::kNoCaretReadonly},
+    {"default_context_menu", (int32_t)RichEditAttribute::kDefaultContextMenu},
+    {"spin_class", (int32_t)RichEditAttribute::kSpinClass},
+    {"clear_btn_class", (int32_t)RichEditAttribute::kClearBtnClass},
+    {"show_passowrd_btn_class", (int32_t)RichEditAttribute::kShowPassowrdBtnClass},
+    {"wheel_zoom", (int32_t)RichEditAttribute::kWheelZoom},
+    {"hide_selection", (int32_t)RichEditAttribute::kHideSelection},
+    {"focus_bottom_border_size", (int32_t)RichEditAttribute::kFocusBottomBorderSize},
+    {"focus_bottom_border_color", (int32_t)RichEditAttribute::kFocusBottomBorderColor},
+    {"select_all_on_focus", (int32_t)RichEditAttribute::kSelectAllOnFocus},
+    {"row_spacing_mul", (int32_t)RichEditAttribute::kRowSpacingMul},
+    {"row_spacing_add", (int32_t)RichEditAttribute::kRowSpacingAdd},
+    {"zoom", (int32_t)RichEditAttribute::kZoom},
+    {"auto_vscroll", (int32_t)RichEditAttribute::kAutoVscroll},
+    {"autovscroll", (int32_t)RichEditAttribute::kAutoVscroll},
+    {"auto_hscroll", (int32_t)RichEditAttribute::kAutoHscroll},
+    {"autohscroll", (int32_t)RichEditAttribute::kAutoHscroll},
+    {"rich_text", (int32_t)RichEditAttribute::kRichText},
+    {"rich", (int32_t)RichEditAttribute::kRichText},
+    {"auto_detect_url", (int32_t)RichEditAttribute::kAutoDetectUrl},
+    {"allow_beep", (int32_t)RichEditAttribute::kAllowBeep},
+    {"save_selection", (int32_t)RichEditAttribute::kSaveSelection},
+    {"selection_bkcolor", (int32_t)RichEditAttribute::kSelectionBkcolor},
+    {"inactive_selection_bkcolor", (int32_t)RichEditAttribute::kInactiveSelectionBkcolor},
+    {"current_row_bkcolor", (int32_t)RichEditAttribute::kCurrentRowBkcolor},
+    {"inactive_current_row_bkcolor", (int32_t)RichEditAttribute::kInactiveCurrentRowBkcolor},
+};
+constexpr AttributeTable kRichEditAttributeTable(kRichEditAttributeEntries);
+static_assert(kRichEditAttributeTable.IsValid(), "RichEdit attribute table is invalid!");
+}
+
 void RichEdit::SetAttribute(const DString& strName, const DString& strValue)
 {
-    if (strName == _T("vscrollbar")) {
-        //纵向滚动条
-        if (strValue == _T("true")) {
-            EnableScrollBar(true, GetHScrollBar() != nullptr);
-            if (m_pRichHost != nullptr) {
-                m_pRichHost->SetVScrollBar(true);
+    switch ((RichEditAttribute)kRichEditAttributeTable.Find(strName)) {
+    case RichEditAttribute::kVscrollbar:
+        {
+            //纵向滚动条
+            if (strValue == _T("true")) {
+                EnableScrollBar(true, GetHScrollBar() != nullptr);
+                if (m_pRichHost != nullptr) {
+                    m_pRichHost->SetVScrollBar(true);
+                }
             }
-        }
-        else {
-            EnableScrollBar(false, GetHScrollBar() != nullptr);
-            if (m_pRichHost != nullptr) {
-                m_pRichHost->SetVScrollBar(false);
+            else {
+                EnableScrollBar(false, GetHScrollBar() != nullptr);
+                if (m_pRichHost != nullptr) {
+                    m_pRichHost->SetVScrollBar(false);
+                }
             }
         }
-    }
-    else if (strName == _T("hscrollbar")) {
-        //横向滚动条
-        if (strValue == _T("true")) {
-            EnableScrollBar(GetVScrollBar() != nullptr, true);
-            if (m_pRichHost != nullptr) {
-                m_pRichHost->SetHScrollBar(true);
+        break;
+    case RichEditAttribute::kHscrollbar:
+        {
+            //横向滚动条
+            if (strValue == _T("true")) {
+                EnableScrollBar(GetVScrollBar() != nullptr, true);
+                if (m_pRichHost != nullptr) {
+                    m_pRichHost->SetHScrollBar(true);
+                }
             }
-        }
-        else {
-            EnableScrollBar(GetVScrollBar() != nullptr, false);
-            if (m_pRichHost != nullptr) {
-                m_pRichHost->SetHScrollBar(false);
+            else {
+                EnableScrollBar(GetVScrollBar() != nullptr, false);
+                if (m_pRichHost != nullptr) {
+                    m_pRichHost->SetHScrollBar(false);
+                }
             }
         }
-    }
-    else if ((strName == _T("single_line")) || (strName == _T("singleline"))) {
-        SetMultiLine(strValue != _T("true"));
-    }
-    else if ((strName == _T("multi_line")) || (strName == _T("multiline"))) {
-        SetMultiLine(strValue == _T("true"));
-    }
-    else if (strName == _T("readonly")) {
-        SetReadOnly(strValue == _T("true"));
-    }
-    else if (strName == _T("password")) {
-        SetPasswordMode(strValue == _T("true"));
-    }
-    else if (strName == _T("show_password")) {
-        SetShowPassword(strValue == _T("true"));
-    }
-    else if (strName == _T("password_char")) {
-        if (!strValue.empty()) {
-            SetPasswordChar(strValue.front());
-        }
-    }
-    else if (strName == _T("flash_password_char")) {
-        SetFlashPasswordChar(strValue == _T("true"));
-    }
-    else if ((strName == _T("number_only")) || (strName == _T("number"))) {
-        SetNumberOnly(strValue == _T("true"));
-    }
-    else if (strName == _T("max_number")) {
-        SetMaxNumber(StringUtil::StringToInt32(strValue));
-    }
-    else if (strName == _T("min_number")) {
-        SetMinNumber(StringUtil::StringToInt32(strValue));
-    }
-    else if (strName == _T("number_format")) {
-        SetNumberFormat64(strValue);
-    }
-    else if (strName == _T("text_align")) {
-        //水平方向对齐方式
-        if (strValue.find(_T("left")) != DString::npos) {
-            SetTextHAlignType(HorAlignType::kAlignLeft);
-        }
-        else if (strValue.find(_T("hcenter")) != DString::npos) {
-            SetTextHAlignType(HorAlignType::kAlignCenter);
-        }
-        else if (strValue.find(_T("right")) != DString::npos) {
-            SetTextHAlignType(HorAlignType::kAlignRight);
+        break;
+    case RichEditAttribute::kSingleLine:
+        {
+            SetMultiLine(strValue != _T("true"));
+        }
+        break;
+    case RichEditAttribute::kMultiLine:
+        {
+            SetMultiLine(strValue == _T("true"));
+        }
+        break;
+    case RichEditAttribute::kReadonly:
+        {
+            SetReadOnly(strValue == _T("true"));
+        }
+        break;
+    case RichEditAttribute::kPassword:
+        {
+            SetPasswordMode(strValue == _T("true"));
+        }
+        break;
+    case RichEditAttribute::kShowPassword:
+        {
+            SetShowPassword(strValue == _T("true"));
+        }
+        break;
+    case RichEditAttribute::kPasswordChar:
+        {
+            if (!strValue.empty()) {
+                SetPasswordChar(strValue.front());
+            }
         }
+        break;
+    case RichEditAttribute::kFlashPasswordChar:
+        {
+            SetFlashPasswordChar(strValue == _T("true"));
+        }
+        break;
+    case RichEditAttribute::kNumberOnly:
+        {
+            SetNumberOnly(strValue == _T("true"));
+        }
+        break;
+    case RichEditAttribute::kMaxNumber:
+        {
+            SetMaxNumber(StringUtil::StringToInt32(strValue));
+        }
+        break;
+    case RichEditAttribute::kMinNumber:
+        {
+            SetMinNumber(StringUtil::StringToInt32(strValue));
+        }
+        break;
+    case RichEditAttribute::kNumberFormat:
+        {
+            SetNumberFormat64(strValue);
+        }
+        break;
+    case RichEditAttribute::kTextAlign:
+        {
+            //水平方向对齐方式
+            if (strValue.find(_T("left")) != DString::npos) {
+                SetTextHAlignType(HorAlignType::kAlignLeft);
+            }
+            else if (strValue.find(_T("hcenter")) != DString::npos) {
+                SetTextHAlignType(HorAlignType::kAlignCenter);
+            }
+            else if (strValue.find(_T("right")) != DString::npos) {
+                SetTextHAlignType(HorAlignType::kAlignRight);
+            }
 
-        //垂直方向对齐方式
-        if (strValue.find(_T("top")) != DString::npos) {
-            SetTextVAlignType(VerAlignType::kAlignTop);
-        }
-        else if (strValue.find(_T("vcenter")) != DString::npos) {
-            SetTextVAlignType(VerAlignType::kAlignCenter);
-        }
-        else if (strValue.find(_T("bottom")) != DString::npos) {
-            SetTextVAlignType(VerAlignType::kAlignBottom);
+            //垂直方向对齐方式
+            if (strValue.find(_T("top")) != DString::npos) {
+                SetTextVAlignType(VerAlignType::kAlignTop);
+            }
+            else if (strValue.find(_T("vcenter")) != DString::npos) {
+                SetTextVAlignType(VerAlignType::kAlignCenter);
+            }
+            else if (strValue.find(_T("bottom")) != DString::npos) {
+                SetTextVAlignType(VerAlignType::kAlignBottom);
+            }
         }
-    }
-    else if ((strName == _T("text_padding")) || (strName == _T("textpadding"))) {
-        UiPadding rcTextPadding;
-        AttributeUtil::ParsePaddingValue(strValue.c_str(), rcTextPadding);
-        SetTextPadding(rcTextPadding, true);
-    }
-    else if ((strName == _T("text_color")) || (strName == _T("normal_text_color")) || (strName == _T("normaltextcolor"))) {
-        SetTextColor(strValue);
-    }
-    else if ((strName == _T("disabled_text_color")) || (strName == _T("disabledtextcolor"))) {
-        SetDisabledTextColor(strValue);
-    }
-    else if ((strName == _T("caret_color")) || (strName == _T("caretcolor"))) {
-        //设置光标的颜色
-        SetCaretColor(strValue);
-    }
-    else if ((strName == _T("prompt_mode")) || (strName == _T("promptmode"))) {
-        //提示模式
-        m_bAllowPrompt = (strValue == _T("true")) ? true : false;
-    }
-    else if ((strName == _T("prompt_color")) || (strName == _T("promptcolor"))) {
-        //提示文字的颜色
-        m_sPromptColor = strValue;
-    }
-    else if ((strName == _T("prompt_text")) || (strName == _T("prompttext"))) {
-        //提示文字
-        SetPromptText(strValue);
-    }
-    else if ((strName == _T("prompt_text_id")) || (strName == _T("prompt_textid")) || (strName == _T("prompttextid"))) {
-        //提示文字ID
-        SetPromptTextId(strValue);
-    }
-    else if ((strName == _T("focused_image")) || (strName == _T("focusedimage"))) {
-        SetFocusedImage(strValue);
-    }
-    else if (strName == _T("font")) {
-        SetFontId(strValue);
-    }
-    else if (strName == _T("text")) {
-        SetText(strValue);
-    }
-    else if ((strName == _T("text_id")) || (strName == _T("textid"))) {
-        SetTextId(strValue);
-    }
-    else if ((strName == _T("want_tab")) || (strName == _T("wanttab"))) {
-        SetWantTab(strValue == _T("true"));
-    }
-    else if ((strName == _T("want_return")) || (strName == _T("want_return_msg")) || (strName == _T("wantreturnmsg"))) {
-        SetWantReturn(strValue == _T("true"));
-    }
-    else if ((strName == _T("want_ctrl_return")) || (strName == _T("return_msg_want_ctrl")) || (strName == _T("returnmsgwantctrl"))) {
-        SetWantCtrlReturn(strValue == _T("true"));
-    }
-    else if ((strName == _T("limit_text")) || (strName == _T("max_char")) || (strName == _T("maxchar"))) {
-        //限制最多字符数
-        SetLimitText(StringUtil::StringToInt32(strValue));
-    }
-    else if (strName == _T("limit_chars")) {
-        //限制允许输入哪些字符
-        SetLimitChars(strValue);
-    }
-    else if (strName == _T("word_wrap")) {
-        //是否自动换行
-        SetWordWrap(strValue == _T("true"));
-    }
-    else if (strName == _T("no_caret_readonly")) {
-        //只读模式，不显示光标
-        SetNoCaretReadonly();
-    }
-    else if (strName == _T("default_context_menu")) {
-        //是否使用默认的右键菜单
-        SetEnableDefaultContextMenu(strValue == _T("true"));
-    }
-    else if (strName == _T("spin_class")) {
-        SetSpinClass(strValue);
-    }
-    else if (strName == _T("clear_btn_class")) {
-        SetClearBtnClass(strValue);
-    }
-    else if (strName == _T("show_passowrd_btn_class")) {
-        SetShowPasswordBtnClass(strValue);
-    }
-    else if (strName == _T("wheel_zoom")) {
-        //设置是否允许Ctrl + 滚轮来调整缩放比例
-        SetEnableWheelZoom(strValue == _T("true"));
-    }
-    else if (strName == _T("hide_selection")) {
-        //是否隐藏选择内容
-        SetHideSelection(strValue == _T("true"));
-    }
-    else if (strName == _T("focus_bottom_border_size")) {
-        //焦点状态时，底部边框的大小
-        SetFocusBottomBorderSize(StringUtil::StringToInt32(strValue));
-    }
-    else if (strName == _T("focus_bottom_border_color")) {
-        //焦点状态时，底部边框的颜色
-        SetFocusBottomBorderColor(strValue);
-    }
-    else if (strName == _T("select_all_on_focus")) {
-        //获取焦点的时候，是否全选
-        SetSelAllOnFocus(strValue == _T("true"));
-    }
-    else if (strName == _T("row_spacing_mul")) {
-        SetRowSpacingMul(StringUtil::StringToFloat(strValue.c_str(), nullptr));
-    }
-    else if (strName == _T("row_spacing_add")) {
-        //不支持该属性，忽略
-    }
+        break;
+    case RichEditAttribute::kTextPadding:
+        {
+            UiPadding rcTextPadding;
+            AttributeUtil::ParsePaddingValue(strValue.c_str(), rcTextPadding);
+            SetTextPadding(rcTextPadding, true);
+        }
+        break;
+    case RichEditAttribute::kTextColor:
+        {
+            SetTextColor(strValue);
+        }
+        break;
+    case RichEditAttribute::kDisabledTextColor:
+        {
+            SetDisabledTextColor(strValue);
+        }
+        break;
+    case RichEditAttribute::kCaretColor:
+        {
+            //设置光标的颜色
+            SetCaretColor(strValue);
+        }
+        break;
+    case RichEditAttribute::kPromptMode:
+        {
+            //提示模式
+            m_bAllowPrompt = (strValue == _T("true")) ? true : false;
+        }
+        break;
+    case RichEditAttribute::kPromptColor:
+        {
+            //提示文字的颜色
+            m_sPromptColor = strValue;
+        }
+        break;
+    case RichEditAttribute::kPromptText:
+        {
+            //提示文字
+            SetPromptText(strValue);
+        }
+        break;
+    case RichEditAttribute::kPromptTextId:
+        {
+            //提示文字ID
+            SetPromptTextId(strValue);
+        }
+        break;
+    case RichEditAttribute::kFocusedImage:
+        {
+            SetFocusedImage(strValue);
+        }
+        break;
+    case RichEditAttribute::kFont:
+        {
+            SetFontId(strValue);
+        }
+        break;
+    case RichEditAttribute::kText:
+        {
+            SetText(strValue);
+        }
+        break;
+    case RichEditAttribute::kTextId:
+        {
+            SetTextId(strValue);
+        }
+        break;
+    case RichEditAttribute::kWantTab:
+        {
+            SetWantTab(strValue == _T("true"));
+        }
+        break;
+    case RichEditAttribute::kWantReturn:
+        {
+            SetWantReturn(strValue == _T("true"));
+        }
+        break;
+    case RichEditAttribute::kWantCtrlReturn:
+        {
+            SetWantCtrlReturn(strValue == _T("true"));
+        }
+        break;
+    case RichEditAttribute::kLimitText:
+        {
+            //限制最多字符数
+            SetLimitText(StringUtil::StringToInt32(strValue));
+        }
+        break;
+    case RichEditAttribute::kLimitChars:
+        {
+            //限制允许输入哪些字符
+            SetLimitChars(strValue);
+        }
+        break;
+    case RichEditAttribute::kWordWrap:
+        {
+            //是否自动换行
+            SetWordWrap(strValue == _T("true"));
+        }
+        break;
+    case RichEditAttribute::kNoCaretReadonly:
+        {
+            //只读模式，不显示光标
+            SetNoCaretReadonly();
+        }
+        break;
+    case RichEditAttribute::kDefaultContextMenu:
+        {
+            //是否使用默认的右键菜单
+            SetEnableDefaultContextMenu(strValue == _T("true"));
+        }
+        break;
+    case RichEditAttribute::kSpinClass:
+        {
+            SetSpinClass(strValue);
+        }
+        break;
+    case RichEditAttribute::kClearBtnClass:
+        {
+            SetClearBtnClass(strValue);
+        }
+        break;
+    case RichEditAttribute::kShowPassowrdBtnClass:
+        {
+            SetShowPasswordBtnClass(strValue);
+        }
+        break;
+    case RichEditAttribute::kWheelZoom:
+        {
+            //设置是否允许Ctrl + 滚轮来调整缩放比例
+            SetEnableWheelZoom(strValue == _T("true"));
+        }
+        break;
+    case RichEditAttribute::kHideSelection:
+        {
+            //是否隐藏选择内容
+            SetHideSelection(strValue == _T("true"));
+        }
+        break;
+    case RichEditAttribute::kFocusBottomBorderSize:
+        {
+            //焦点状态时，底部边框的大小
+            SetFocusBottomBorderSize(StringUtil::StringToInt32(strValue));
+        }
+        break;
+    case RichEditAttribute::kFocusBottomBorderColor:
+        {
+            //焦点状态时，底部边框的颜色
+            SetFocusBottomBorderColor(strValue);
+        }
+        break;
+    case RichEditAttribute::kSelectAllOnFocus:
+        {
+            //获取焦点的时候，是否全选
+            SetSelAllOnFocus(strValue == _T("true"));
+        }
+        break;
+    case RichEditAttribute::kRowSpacingMul:
+        {
+            SetRowSpacingMul(StringUtil::StringToFloat(strValue.c_str(), nullptr));
+        }
+        break;
+    case RichEditAttribute::kRowSpacingAdd:
+        {
+            //不支持该属性，忽略
+        }
+        break;
 
 #ifdef DUILIB_RICHEDIT_SUPPORT_RICHTEXT
-    else if (strName == _T("zoom")) {
-        //缩放比例：
-        //设置缩放比例：设 wParam：缩放比例的分子，lParam：缩放比例的分母，
-        // "wParam,lParam" 表示按缩放比例分子/分母显示的缩放，取值范围：1/64 < (wParam / lParam) < 64。
-        // 举例：则："0,0"表示关闭缩放功能，"2,1"表示放大到200%，"1,2"表示缩小到50% 
-        UiSize zoomValue;
-        AttributeUtil::ParseSizeValue(strValue.c_str(), zoomValue);
-        if ((zoomValue.cx >= 0) && (zoomValue.cx <= 64) &&
-            (zoomValue.cy >= 0) && (zoomValue.cy <= 64)) {
-            m_richCtrl.SetZoom(zoomValue.cx, zoomValue.cy);
+    case RichEditAttribute::kZoom:
+        {
+            //缩放比例：
+            //设置缩放比例：设 wParam：缩放比例的分子，lParam：缩放比例的分母，
+            // "wParam,lParam" 表示按缩放比例分子/分母显示的缩放，取值范围：1/64 < (wParam / lParam) < 64。
+            // 举例：则："0,0"表示关闭缩放功能，"2,1"表示放大到200%，"1,2"表示缩小到50% 
+            UiSize zoomValue;
+            AttributeUtil::ParseSizeValue(strValue.c_str(), zoomValue);
+            if ((zoomValue.cx >= 0) && (zoomValue.cx <= 64) &&
+                (zoomValue.cy >= 0) && (zoomValue.cy <= 64)) {
+                m_richCtrl.SetZoom(zoomValue.cx, zoomValue.cy);
+            }
         }
-    }
-    else if ((strName == _T("auto_vscroll")) || (strName == _T("autovscroll"))) {
-        //当用户在最后一行按 ENTER 时，自动将文本向上滚动一页。
-        if (m_pRichHost != nullptr) {
-            m_pRichHost->SetAutoVScroll(strValue == _T("true"));
+        break;
+    case RichEditAttribute::kAutoVscroll:
+        {
+            //当用户在最后一行按 ENTER 时，自动将文本向上滚动一页。
+            if (m_pRichHost != nullptr) {
+                m_pRichHost->SetAutoVScroll(strValue == _T("true"));
+            }
         }
-    }
-    else if ((strName == _T("auto_hscroll")) || (strName == _T("autohscroll"))) {
-        //当用户在行尾键入一个字符时，自动将文本向右滚动 10 个字符。
-        //当用户按 Enter 时，控件会将所有文本滚动回零位置。
-        if (m_pRichHost != nullptr) {
-            m_pRichHost->SetAutoHScroll(strValue == _T("true"));
+        break;
+    case RichEditAttribute::kAutoHscroll:
+        {
+            //当用户在行尾键入一个字符时，自动将文本向右滚动 10 个字符。
+            //当用户按 Enter 时，控件会将所有文本滚动回零位置。
+            if (m_pRichHost != nullptr) {
+                m_pRichHost->SetAutoHScroll(strValue == _T("true"));
+            }
         }
-    }
-    else if ((strName == _T("rich_text")) || (strName == _T("rich"))) {
-        //是否为富文本属性
-        SetRichText(strValue == _T("true"));
-    }
-    else if (strName == _T("auto_detect_url")) {
-        //是否自动检测URL，如果是URL则显示为超链接
-        SetAutoURLDetect(strValue == _T("true"));
-    }
-    else if (strName == _T("allow_beep")) {
-        //是否允许发出Beep声音
-        SetAllowBeep(strValue == _T("true"));
-    }
-    else if (strName == _T("save_selection")) {
-        //如果 为 TRUE，则当控件处于非活动状态时，应保存所选内容的边界。
-        //如果 为 FALSE，则当控件再次处于活动状态时，可以选择边界重置为 start = 0，length = 0。
-        SetSaveSelection(strValue == _T("true"));
-    }
+        break;
+    case RichEditAttribute::kRichText:
+        {
+            //是否为富文本属性
+            SetRichText(strValue == _T("true"));
+        }
+        break;
+    case RichEditAttribute::kAutoDetectUrl:
+        {
+            //是否自动检测URL，如果是URL则显示为超链接
+            SetAutoURLDetect(strValue == _T("true"));
+        }
+        break;
+    case RichEditAttribute::kAllowBeep:
+        {
+            //是否允许发出Beep声音
+            SetAllowBeep(strValue == _T("true"));
+        }
+        break;
+    case RichEditAttribute::kSaveSelection:
+        {
+            //如果 为 TRUE，则当控件处于非活动状态时，应保存所选内容的边界。
+            //如果 为 FALSE，则当控件再次处于活动状态时，可以选择边界重置为 start = 0，length = 0。
+            SetSaveSelection(strValue == _T("true"));
+        }
+        break;
 #else
-    else if (strName == _T("zoom")) {
-        //缩放比例：
-        //设置缩放比例：设 wParam：缩放比例的分子，lParam：缩放比例的分母，
-        // "wParam,lParam" 表示按缩放比例分子/分母显示的缩放，取值范围：1/64 < (wParam / lParam) < 64。
-        // 举例：则："0,0"表示关闭缩放功能，"2,1"表示放大到200%，"1,2"表示缩小到50% 
-        //UiSize zoomValue;
-        //AttributeUtil::ParseSizeValue(strValue.c_str(), zoomValue);
-        //if ((zoomValue.cx >= 0) && (zoomValue.cx <= 64) &&
-        //    (zoomValue.cy >= 0) && (zoomValue.cy <= 64)) {
-        //    m_richCtrl.SetZoom(zoomValue.cx, zoomValue.cy);
-        //}
-    }
-    else if ((strName == _T("auto_vscroll")) || (strName == _T("autovscroll"))) {
-        //当用户在最后一行按 ENTER 时，自动将文本向上滚动一页。
-        //if (m_pRichHost != nullptr) {
-        //    m_pRichHost->SetAutoVScroll(strValue == _T("true"));
-        //}
-    }
-    else if ((strName == _T("auto_hscroll")) || (strName == _T("autohscroll"))) {
-        //当用户在行尾键入一个字符时，自动将文本向右滚动 10 个字符。
-        //当用户按 Enter 时，控件会将所有文本滚动回零位置。
-        //if (m_pRichHost != nullptr) {
-        //    m_pRichHost->SetAutoHScroll(strValue == _T("true"));
-        //}
-    }
-    else if ((strName == _T("rich_text")) || (strName == _T("rich"))) {
-        //是否为富文本属性
-        //SetRichText(strValue == _T("true"));
-    }
-    else if (strName == _T("auto_detect_url")) {
-        //是否自动检测URL，如果是URL则显示为超链接
-        //SetAutoURLDetect(strValue == _T("true"));
-    }
-    else if (strName == _T("allow_beep")) {
-        //是否允许发出Beep声音
-        //SetAllowBeep(strValue == _T("true"));
-    }
-    else if (strName == _T("save_selection")) {
-        //如果 为 TRUE，则当控件处于非活动状态时，应保存所选内容的边界。
-        //如果 为 FALSE，则当控件再次处于活动状态时，可以选择边界重置为 start = 0，length = 0。
-        //SetSaveSelection(strValue == _T("true"));
-    }
+    case RichEditAttribute::kZoom:
+        {
+            //缩放比例：
+            //设置缩放比例：设 wParam：缩放比例的分子，lParam：缩放比例的分母，
+            // "wParam,lParam" 表示按缩放比例分子/分母显示的缩放，取值范围：1/64 < (wParam / lParam) < 64。
+            // 举例：则："0,0"表示关闭缩放功能，"2,1"表示放大到200%，"1,2"表示缩小到50% 
+            //UiSize zoomValue;
+            //AttributeUtil::ParseSizeValue(strValue.c_str(), zoomValue);
+            //if ((zoomValue.cx >= 0) && (zoomValue.cx <= 64) &&
+            //    (zoomValue.cy >= 0) && (zoomValue.cy <= 64)) {
+            //    m_richCtrl.SetZoom(zoomValue.cx, zoomValue.cy);
+            //}
+        }
+        break;
+    case RichEditAttribute::kAutoVscroll:
+        {
+            //当用户在最后一行按 ENTER 时，自动将文本向上滚动一页。
+            //if (m_pRichHost != nullptr) {
+            //    m_pRichHost->SetAutoVScroll(strValue == _T("true"));
+            //}
+        }
+        break;
+    case RichEditAttribute::kAutoHscroll:
+        {
+            //当用户在行尾键入一个字符时，自动将文本向右滚动 10 个字符。
+            //当用户按 Enter 时，控件会将所有文本滚动回零位置。
+            //if (m_pRichHost != nullptr) {
+            //    m_pRichHost->SetAutoHScroll(strValue == _T("true"));
+            //}
+        }
+        break;
+    case RichEditAttribute::kRichText:
+        {
+            //是否为富文本属性
+            //SetRichText(strValue == _T("true"));
+        }
+        break;
+    case RichEditAttribute::kAutoDetectUrl:
+        {
+            //是否自动检测URL，如果是URL则显示为超链接
+            //SetAutoURLDetect(strValue == _T("true"));
+        }
+        break;
+    case RichEditAttribute::kAllowBeep:
+        {
+            //是否允许发出Beep声音
+            //SetAllowBeep(strValue == _T("true"));
+        }
+        break;
+    case RichEditAttribute::kSaveSelection:
+        {
+            //如果 为 TRUE，则当控件处于非活动状态时，应保存所选内容的边界。
+            //如果 为 FALSE，则当控件再次处于活动状态时，可以选择边界重置为 start = 0，length = 0。
+            //SetSaveSelection(strValue == _T("true"));
+        }
+        break;
 #endif
 
     //几个SDL版本支持但该版本不支持的属性，需要跳过
-    else if (strName == _T("selection_bkcolor")) {
-    }
-    else if (strName == _T("inactive_selection_bkcolor")) {
-    }
-    else if (strName == _T("current_row_bkcolor")) {
-    }
-    else if (strName == _T("inactive_current_row_bkcolor")) {
-    }
-    else {
+    case RichEditAttribute::kSelectionBkcolor:
+        break;
+    case RichEditAttribute::kInactiveSelectionBkcolor:
+        break;
+    case RichEditAttribute::kCurrentRowBkcolor:
+        break;
+    case RichEditAttribute::kInactiveCurrentRowBkcolor:
+        break;
+    default:
         BaseClass::SetAttribute(strName, strValue);
+        break;
     }
 }
 
@@ -1,9 +1,14 @@
 #include "Box.h"
+#include "duilib/Core/BoxHitTestIndex.h"
 #include "duilib/Core/Window.h"
 #include "duilib/Utils/StringUtil.h"
 
 namespace ui
 {
+/** 启用鼠标命中测试空间索引的子控件个数下限（子控件较少时，逐个查找更快）
+*/
+static const size_t kHitTestIndexMinItemCount = 64;
+
 Box::Box(Window* pWindow, Layout* pLayout) :
     Control(pWindow),
     m_pLayout(pLayout),
@@ -11,7 +16,8 @@ Box::Box(Window* pWindow, Layout* pLayout) :
     m_bMouseChildEnabled(true),
     m_items(),
     m_nDropInId(0),
-    m_nDragOutId(0)
+    m_nDragOutId(0),
+    m_bHitTestIndexEnabled(true)
 {
     ASSERT(m_pLayout != nullptr);
     if (m_pLayout) {
@@ -21,6 +27,7 @@ Box::Box(Window* pWindow, Layout* pLayout) :
 
 Box::~Box()
 {
+    m_pHitTestIndex.reset();
     if (m_bAutoDestroyChild) {
         for (Control* pControl : m_items) {
             if (pControl != nullptr) {
@@ -304,39 +311,50 @@ Control* Box::FindControlInItems(const std::vector<Control*>& items,
     UiPoint boxPt(ptMouse);
     boxPt.Offset(scrollPos);
     UiRect rc = GetRectWithoutPadding();
-    if ((uFlags & UIFIND_TOP_FIRST) != 0) {
+
+    //在一个子控件中查找
+    auto findInItem = [&](Control* pItemControl) -> Control* {
+            if (pItemControl == nullptr) {
+                return nullptr;
+            }
+            Control* pControl = pItemControl->FindControl(Proc, pProcData, uFlags, boxPt);
+            if ((pControl != nullptr) && (uFlags & UIFIND_HITTEST) != 0 &&
+                !pControl->IsFloat() && !rc.ContainsPt(ptMouse)) {
+                pControl = nullptr;
+            }
+            return pControl;
+        };
+
+    //命中测试时，子控件不包含该坐标则查找不到，使用空间索引只查找位置包含该坐标的子控件
+    const std::vector<uint32_t>* pHitItems = nullptr;
+    if (((uFlags & UIFIND_HITTEST) != 0) && (&items == &m_items)) {
+        pHitItems = FindHitTestItems(boxPt);
+    }
+    if (pHitItems != nullptr) {
+        const size_t nHitCount = pHitItems->size();
+        for (size_t i = 0; i < nHitCount; ++i) {
+            const size_t nIndex = ((uFlags & UIFIND_TOP_FIRST) != 0) ? (*pHitItems)[nHitCount - 1 - i] : (*pHitItems)[i];
+            Control* pControl = findInItem(items[nIndex]);
+            if (pControl != nullptr) {
+                return pControl;
+            }
+        }
+    }
+    else if ((uFlags & UIFIND_TOP_FIRST) != 0) {
         //倒序
         for (int32_t it = (int32_t)items.size() - 1; it >= 0; --it) {
-            if (items[it] == nullptr) {
-                continue;
-            }
-            Control* pControl = items[it]->FindControl(Proc, pProcData, uFlags, boxPt);
+            Control* pControl = findInItem(items[it]);
             if (pControl != nullptr) {
-                if ((uFlags & UIFIND_HITTEST) != 0 &&
-                    !pControl->IsFloat() && !rc.ContainsPt(ptMouse)) {
-                    continue;
-                }
-                else {
-                    return pControl;
-                }
+                return pControl;
             }
         }
     }
     else {
         //正常顺序
         for (Control* pItemControl : items) {
-            if (pItemControl == nullptr) {
-                continue;
-            }
-            Control* pControl = pItemControl->FindControl(Proc, pProcData, uFlags, boxPt);
+            Control* pControl = findInItem(pItemControl);
             if (pControl != nullptr) {
-                if ((uFlags & UIFIND_HITTEST) != 0 && 
-                    !pControl->IsFloat() && !rc.ContainsPt(ptMouse)) {
-                    continue;
-                }
-                else {
-                    return pControl;
-                }
+                return pControl;
             }
         }
     }
@@ -348,6 +366,40 @@ Control* Box::FindControlInItems(const std::vector<Control*>& items,
     return pResult;
 }
 
+const std::vector<uint32_t>* Box::FindHitTestItems(const UiPoint& pt)
+{
+    if (!m_bHitTestIndexEnabled || (m_items.size() < kHitTestIndexMinItemCount)) {
+        m_pHitTestIndex.reset();
+        return nullptr;
+    }
+    if (m_pHitTestIndex == nullptr) {
+        m_pHitTestIndex = std::make_unique<BoxHitTestIndex>();
+    }
+    return &m_pHitTestIndex->FindItems(m_items, pt);
+}
+
+void Box::SetHitTestIndexEnabled(bool bEnabled)
+{
+    m_bHitTestIndexEnabled = bEnabled;
+    if (!bEnabled) {
+        m_pHitTestIndex.reset();
+    }
+}
+
+void Box::OnItemRectChanged(const PlaceHolder* pItem)
+{
+    if (m_pHitTestIndex != nullptr) {
+        m_pHitTestIndex->OnItemRectChanged(pItem);
+    }
+}
+
+void Box::InvalidateHitTestIndex()
+{
+    if (m_pHitTestIndex != nullptr) {
+        m_pHitTestIndex->Invalidate();
+    }
+}
+
 Control* Box::FindSubControl(const DString& pstrSubControlName)
 {
     Control* pSubControl = GetWindow()->FindSubControlByName(this, pstrSubControlName);
@@ -431,6 +483,7 @@ bool Box::SetItemIndex(Control* pControl, size_t iIndex)
             Arrange();            
             m_items.erase(it);
             m_items.insert(m_items.begin() + iIndex, pControl);
+            InvalidateHitTestIndex();
             return true;
         }
     }
@@ -463,6 +516,7 @@ bool Box::DoAddItemAt(Control* pControl, size_t iIndex)
         return false;
     }
     m_items.insert(m_items.begin() + iIndex, pControl);
+    InvalidateHitTestIndex();
     Window* pWindow = GetWindow();
     if (pWindow != nullptr) {
         pWindow->InitControls(pControl);
@@ -504,6 +558,7 @@ bool Box::DoRemoveItem(Control* pControl)
     for (auto it = m_items.begin(); it != m_items.end(); ++it) {
         if (*it == pControl) {
             m_items.erase(it);
+            InvalidateHitTestIndex();
             if (m_bAutoDestroyChild) {
                 if (pControl) {
                     if (pControl->HasDestroyEventCallback()) {
@@ -523,6 +578,7 @@ void Box::RemoveAllItems()
 {
     std::vector<Control*> items;
     items.swap(m_items);
+    InvalidateHitTestIndex();
     if (m_bAutoDestroyChild) {
         for(Control* pControl : items) {
             delete pControl;
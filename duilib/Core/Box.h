@@ -6,6 +6,8 @@
 
 namespace ui 
 {
+class BoxHitTestIndex;
+
 /** 容器基类(Container)
 */
 class UILIB_API Box : public Control
@@ -186,6 +188,19 @@ public:
     */
     void FreeLayout(Layout* pLayout);
 
+    /** 设置是否启用鼠标命中测试的空间索引（子控件较多时，按位置快速查找鼠标所在的子控件），默认启用
+    */
+    void SetHitTestIndexEnabled(bool bEnabled);
+
+    /** 获取是否启用鼠标命中测试的空间索引
+    */
+    bool IsHitTestIndexEnabled() const { return m_bHitTestIndexEnabled; }
+
+    /** 子控件的位置发生变化（由子控件调用，用于更新鼠标命中测试的空间索引）
+    * @param [in] pItem 位置发生变化的子控件
+    */
+    void OnItemRectChanged(const PlaceHolder* pItem);
+
 public:
     /** 设置是否支持拖拽投放进入该容器: 如果不等于0，支持拖入，否则不支持拖入(从DragOutId==DropInId的容器拖入到该容器)
     */
@@ -213,6 +228,15 @@ protected:
                                 const UiPoint& ptMouse, 
                                 const UiPoint& scrollPos);
 
+    /** 获取位置包含指定坐标的候选子控件（鼠标命中测试的空间索引）
+    * @return 返回候选子控件在m_items中的索引号（升序排列）；未启用空间索引时返回nullptr
+    */
+    const std::vector<uint32_t>* FindHitTestItems(const UiPoint& pt);
+
+    /** 子控件列表的顺序被直接修改后调用（比如排序），使鼠标命中测试的空间索引失效
+    */
+    void InvalidateHitTestIndex();
+
 protected:
     /** 设置可见状态事件
     * @param [in] bChanged true表示状态发生变化，false表示状态未发生变化
@@ -256,6 +280,12 @@ private:
 
     //是否支持拖拽拖出该容器：如果不等于0，支持拖出，否则不支持拖出（拖出到DropInId==DragOutId的容器）
     uint8_t m_nDragOutId;
+
+    //是否启用鼠标命中测试的空间索引
+    bool m_bHitTestIndexEnabled;
+
+    //鼠标命中测试的空间索引（子控件个数较多时才创建）
+    std::unique_ptr<BoxHitTestIndex> m_pHitTestIndex;
 };
 
 } // namespace ui
@@ -0,0 +1,190 @@
+#include "BoxHitTestIndex.h"
+#include "duilib/Core/Control.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ui
+{
+
+/** 网格的最大列数和行数
+*/
+static const int32_t kMaxHitTestCellCount = 256;
+
+/** 增量更新的子控件个数下限（位置发生变化的子控件超过子控件总数的1/4时，完整重建索引）
+*/
+static const size_t kMinHitTestDirtyCount = 16;
+
+BoxHitTestIndex::BoxHitTestIndex():
+    m_nCellWidth(0),
+    m_nCellHeight(0),
+    m_nColumns(0),
+    m_nRows(0),
+    m_bNeedRebuild(true)
+{
+}
+
+BoxHitTestIndex::~BoxHitTestIndex()
+{
+}
+
+void BoxHitTestIndex::Invalidate()
+{
+    m_bNeedRebuild = true;
+    m_dirtyItems.clear();
+}
+
+void BoxHitTestIndex::OnItemRectChanged(const PlaceHolder* pItem)
+{
+    if (m_bNeedRebuild || (pItem == nullptr)) {
+        return;
+    }
+    m_dirtyItems.push_back(pItem);
+    if (m_dirtyItems.size() > (std::max)(m_itemRects.size() / 4, kMinHitTestDirtyCount)) {
+        //大部分子控件的位置都发生了变化（比如容器重新布局），完整重建比增量更新更快
+        Invalidate();
+    }
+}
+
+const std::vector<uint32_t>& BoxHitTestIndex::FindItems(const std::vector<Control*>& items, const UiPoint& pt)
+{
+    static const std::vector<uint32_t> emptyItems;
+    if (!m_bNeedRebuild && !m_dirtyItems.empty()) {
+        if (!UpdateDirtyItems(items)) {
+            Invalidate();
+        }
+    }
+    if (m_bNeedRebuild || (m_itemRects.size() != items.size())) {
+        Rebuild(items);
+    }
+    if ((m_nColumns <= 0) || (m_nRows <= 0) || !m_rcBounds.ContainsPt(pt)) {
+        return emptyItems;
+    }
+    const int32_t nColumn = (std::min)((pt.x - m_rcBounds.left) / m_nCellWidth, m_nColumns - 1);
+    const int32_t nRow = (std::min)((pt.y - m_rcBounds.top) / m_nCellHeight, m_nRows - 1);
+    return m_cells[(size_t)nRow * m_nColumns + nColumn];
+}
+
+void BoxHitTestIndex::Rebuild(const std::vector<Control*>& items)
+{
+    m_bNeedRebuild = false;
+    m_dirtyItems.clear();
+    m_cells.clear();
+    m_itemIndexMap.clear();
+    m_rcBounds = UiRect();
+    m_nColumns = 0;
+    m_nRows = 0;
+
+    const size_t nItemCount = items.size();
+    m_itemRects.assign(nItemCount, UiRect());
+    m_itemIndexMap.reserve(nItemCount);
+    for (size_t nIndex = 0; nIndex < nItemCount; ++nIndex) {
+        Control* pItem = items[nIndex];
+        if (pItem == nullptr) {
+            continue;
+        }
+        m_itemRects[nIndex] = pItem->GetRect();
+        m_itemIndexMap[pItem] = (uint32_t)nIndex;
+        m_rcBounds.Union(m_itemRects[nIndex]);
+    }
+    if (m_rcBounds.IsEmpty()) {
+        return;
+    }
+
+    //网格个数与子控件个数相当，网格的形状接近正方形
+    const int32_t nWidth = m_rcBounds.Width();
+    const int32_t nHeight = m_rcBounds.Height();
+    const double fColumns = std::sqrt((double)nItemCount * nWidth / nHeight);
+    m_nColumns = std::clamp((int32_t)(fColumns + 0.5), 1, kMaxHitTestCellCount);
+    m_nRows = std::clamp((int32_t)((nItemCount + m_nColumns - 1) / m_nColumns), 1, kMaxHitTestCellCount);
+    m_nCellWidth = (nWidth + m_nColumns - 1) / m_nColumns;
+    m_nCellHeight = (nHeight + m_nRows - 1) / m_nRows;
+    m_nColumns = (nWidth + m_nCellWidth - 1) / m_nCellWidth;
+    m_nRows = (nHeight + m_nCellHeight - 1) / m_nCellHeight;
+    m_cells.resize((size_t)m_nColumns * m_nRows);
+
+    for (size_t nIndex = 0; nIndex < nItemCount; ++nIndex) {
+        if (!m_itemRects[nIndex].IsEmpty()) {
+            AddToCells((uint32_t)nIndex, m_itemRects[nIndex]);
+        }
+    }
+}
+
+bool BoxHitTestIndex::UpdateDirtyItems(const std::vector<Control*>& items)
+{
+    for (const PlaceHolder* pItem : m_dirtyItems) {
+        auto iter = m_itemIndexMap.find(pItem);
+        if (iter == m_itemIndexMap.end()) {
+            //不是子控件列表中的控件（比如滚动条）
+            continue;
+        }
+        const uint32_t nIndex = iter->second;
+        if ((nIndex >= items.size()) || (items[nIndex] != pItem)) {
+            //子控件列表已经变化
+            return false;
+        }
+        const UiRect& rcNew = pItem->GetRect();
+        UiRect& rcOld = m_itemRects[nIndex];
+        if (rcNew == rcOld) {
+            continue;
+        }
+        if (!rcNew.IsEmpty() && !m_rcBounds.ContainsRect(rcNew)) {
+            //超出网格覆盖的区域
+            return false;
+        }
+        if (!rcOld.IsEmpty()) {
+            RemoveFromCells(nIndex, rcOld);
+        }
+        if (!rcNew.IsEmpty()) {
+            AddToCells(nIndex, rcNew);
+        }
+        rcOld = rcNew;
+    }
+    m_dirtyItems.clear();
+    return true;
+}
+
+void BoxHitTestIndex::GetCellRange(const UiRect& rc, int32_t& nLeft, int32_t& nTop, int32_t& nRight, int32_t& nBottom) const
+{
+    nLeft = std::clamp((rc.left - m_rcBounds.left) / m_nCellWidth, 0, m_nColumns - 1);
+    nTop = std::clamp((rc.top - m_rcBounds.top) / m_nCellHeight, 0, m_nRows - 1);
+    nRight = std::clamp((rc.right - 1 - m_rcBounds.left) / m_nCellWidth, 0, m_nColumns - 1);
+    nBottom = std::clamp((rc.bottom - 1 - m_rcBounds.top) / m_nCellHeight, 0, m_nRows - 1);
+}
+
+void BoxHitTestIndex::AddToCells(uint32_t nItemIndex, const UiRect& rc)
+{
+    int32_t nLeft = 0;
+    int32_t nTop = 0;
+    int32_t nRight = 0;
+    int32_t nBottom = 0;
+    GetCellRange(rc, nLeft, nTop, nRight, nBottom);
+    for (int32_t nRow = nTop; nRow <= nBottom; ++nRow) {
+        for (int32_t nColumn = nLeft; nColumn <= nRight; ++nColumn) {
+            std::vector<uint32_t>& cell = m_cells[(size_t)nRow * m_nColumns + nColumn];
+            auto iter = std::lower_bound(cell.begin(), cell.end(), nItemIndex);
+            if ((iter == cell.end()) || (*iter != nItemIndex)) {
+                cell.insert(iter, nItemIndex);
+            }
+        }
+    }
+}
+
+void BoxHitTestIndex::RemoveFromCells(uint32_t nItemIndex, const UiRect& rc)
+{
+    int32_t nLeft = 0;
+    int32_t nTop = 0;
+    int32_t nRight = 0;
+    int32_t nBottom = 0;
+    GetCellRange(rc, nLeft, nTop, nRight, nBottom);
+    for (int32_t nRow = nTop; nRow <= nBottom; ++nRow) {
+        for (int32_t nColumn = nLeft; nColumn <= nRight; ++nColumn) {
+            std::vector<uint32_t>& cell = m_cells[(size_t)nRow * m_nColumns + nColumn];
+            auto iter = std::lower_bound(cell.begin(), cell.end(), nItemIndex);
+            if ((iter != cell.end()) && (*iter == nItemIndex)) {
+                cell.erase(iter);
+            }
+        }
+    }
+}
+
+} // namespace ui
@@ -0,0 +1,103 @@
+#ifndef UI_CORE_BOX_HIT_TEST_INDEX_H_
+#define UI_CORE_BOX_HIT_TEST_INDEX_H_
+
+#include "duilib/Core/UiRect.h"
+#include "duilib/Core/UiPoint.h"
+#include <vector>
+#include <unordered_map>
+
+namespace ui
+{
+class Control;
+class PlaceHolder;
+
+/** 容器子控件的空间索引（均匀网格），用于鼠标命中测试时快速找到位置包含指定坐标的子控件
+*   将所有子控件的外接矩形划分为若干个大小相同的网格，每个网格记录与其相交的子控件（按在子控件列表中的顺序排列）；
+*   查找时只需要定位到坐标所在的网格，无需逐个检查所有子控件；
+*   子控件位置变化时只记录该子控件，下次查找时增量更新；子控件列表变化（添加、删除、调整顺序）时完整重建
+*/
+class BoxHitTestIndex
+{
+public:
+    BoxHitTestIndex();
+    ~BoxHitTestIndex();
+    BoxHitTestIndex(const BoxHitTestIndex&) = delete;
+    BoxHitTestIndex& operator = (const BoxHitTestIndex&) = delete;
+
+public:
+    /** 子控件列表发生变化（添加、删除、调整顺序），下次查找时完整重建索引
+    */
+    void Invalidate();
+
+    /** 子控件的位置发生变化，下次查找时增量更新索引
+    * @param [in] pItem 位置发生变化的子控件
+    */
+    void OnItemRectChanged(const PlaceHolder* pItem);
+
+    /** 查找位置包含指定坐标的候选子控件
+    * @param [in] items 子控件列表（与建立索引时的子控件列表相同）
+    * @param [in] pt 坐标（与子控件的GetRect()使用相同的坐标系）
+    * @return 返回候选子控件在子控件列表中的索引号（升序排列），候选子控件以外的子控件不包含该坐标
+    */
+    const std::vector<uint32_t>& FindItems(const std::vector<Control*>& items, const UiPoint& pt);
+
+private:
+    /** 完整重建索引
+    */
+    void Rebuild(const std::vector<Control*>& items);
+
+    /** 增量更新位置发生变化的子控件，返回false表示需要完整重建
+    */
+    bool UpdateDirtyItems(const std::vector<Control*>& items);
+
+    /** 获取矩形覆盖的网格范围（包含right和bottom）
+    */
+    void GetCellRange(const UiRect& rc, int32_t& nLeft, int32_t& nTop, int32_t& nRight, int32_t& nBottom) const;
+
+    /** 将子控件添加到矩形覆盖的网格中
+    */
+    void AddToCells(uint32_t nItemIndex, const UiRect& rc);
+
+    /** 将子控件从矩形覆盖的网格中删除
+    */
+    void RemoveFromCells(uint32_t nItemIndex, const UiRect& rc);
+
+private:
+    /** 网格覆盖的区域（所有子控件的外接矩形）
+    */
+    UiRect m_rcBounds;
+
+    /** 网格的宽度和高度
+    */
+    int32_t m_nCellWidth;
+    int32_t m_nCellHeight;
+
+    /** 网格的列数和行数
+    */
+    int32_t m_nColumns;
+    int32_t m_nRows;
+
+    /** 每个网格中的子控件索引号（按行存储，索引号升序排列）
+    */
+    std::vector<std::vector<uint32_t>> m_cells;
+
+    /** 建立索引时每个子控件的位置
+    */
+    std::vector<UiRect> m_itemRects;
+
+    /** 子控件与其索引号的映射表
+    */
+    std::unordered_map<const PlaceHolder*, uint32_t> m_itemIndexMap;
+
+    /** 位置发生变化、尚未更新到索引中的子控件
+    */
+    std::vector<const PlaceHolder*> m_dirtyItems;
+
+    /** 是否需要完整重建索引
+    */
+    bool m_bNeedRebuild;
+};
+
+} // namespace ui
+
+#endif // UI_CORE_BOX_HIT_TEST_INDEX_H_
@@ -4,6 +4,24 @@
 
 namespace ui 
 {
+/** 分配一个新的颜色表版本号（0表示颜色值未解析，所以从1开始）
+*   所有颜色表的版本号互不相同，窗口销毁后新窗口即使复用相同的地址，其颜色表的版本号也不同
+*/
+static uint32_t NewColorMapVersion()
+{
+    static uint32_t s_nColorMapVersion = 0;
+    ++s_nColorMapVersion;
+    if (s_nColorMapVersion == 0) {
+        s_nColorMapVersion = 1;
+    }
+    return s_nColorMapVersion;
+}
+
+ColorMap::ColorMap():
+    m_nVersion(NewColorMapVersion())
+{
+}
+
 void ColorMap::AddColor(const DString& strName, const DString& strValue)
 {
     ASSERT(!strName.empty() && !strValue.empty());
@@ -28,6 +46,7 @@ void ColorMap::AddColor(const DString& strName, UiColor argb)
     }
 #endif
     m_colorMap[strName] = argb;
+    m_nVersion = NewColorMapVersion();
 }
 
 UiColor ColorMap::GetColor(const DString& strName) const
@@ -44,12 +63,21 @@ void ColorMap::RemoveColor(const DString& strName)
     auto it = m_colorMap.find(strName);
     if (it != m_colorMap.end()) {
         m_colorMap.erase(it);
+        m_nVersion = NewColorMapVersion();
     }
 }
 
 void ColorMap::RemoveAllColors()
 {
-    m_colorMap.clear();
+    if (!m_colorMap.empty()) {
+        m_colorMap.clear();
+        m_nVersion = NewColorMapVersion();
+    }
+}
+
+uint32_t ColorMap::GetVersion() const
+{
+    return m_nVersion;
 }
 
 ColorManager::ColorManager()
@@ -120,6 +148,11 @@ UiColor ColorManager::GetColor(const DString& strName) const
     return m_colorMap.GetColor(strName);
 }
 
+uint32_t ColorManager::GetColorVersion() const
+{
+    return m_colorMap.GetVersion();
+}
+
 UiColor ColorManager::GetStandardColor(const DString& strName) const
 {
     //名称不区分大小写
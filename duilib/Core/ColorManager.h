@@ -11,6 +11,9 @@ namespace ui
 */
 class UILIB_API ColorMap
 {
+public:
+    ColorMap();
+
 public:
     /** 添加一个颜色值
     * @param[in] strName 颜色名称（如 white）
@@ -39,10 +42,19 @@ public:
     */
     void RemoveAllColors();
 
+    /** 获取颜色表的版本号：每个颜色表的版本号互不相同，颜色表发生变化时，分配新的版本号
+    *   预先解析的颜色值（参见UiNamedColor），通过比较版本号判断是否需要重新解析
+    */
+    uint32_t GetVersion() const;
+
 private:
     /** 颜色名称与颜色值的映射关系
     */
     std::unordered_map<DString, UiColor> m_colorMap;
+
+    /** 颜色表的版本号
+    */
+    uint32_t m_nVersion;
 };
 
 /** 颜色值的管理类
@@ -78,6 +90,10 @@ public:
      */
     UiColor GetColor(const DString& strName) const;
 
+    /** 获取全局颜色表的版本号（全局颜色表发生变化，比如切换主题时，版本号变化）
+    */
+    uint32_t GetColorVersion() const;
+
     /** 根据名称获取一个标准颜色的具体数值
      * @param[in] strName 要获取的颜色名称，比如"blue"，详细列表参见：ui::UiColors::UiColorConsts函数中的定义
      * @return 返回 ARGB 格式的颜色描述值
@@ -14,6 +14,7 @@
 #include "duilib/Utils/StringConvert.h"
 #include "duilib/Utils/StringUtil.h"
 #include "duilib/Utils/AttributeUtil.h"
+#include "duilib/Utils/AttributeTable.h"
 #include "duilib/Utils/PerformanceUtil.h"
 
 #if defined (DUILIB_BUILD_FOR_WIN) && !defined (DUILIB_BUILD_FOR_SDL)
@@ -41,7 +42,8 @@ Control::Control(Window* pWindow) :
     m_bShowFocusRect(false),
     m_nPaintOrder(0),
     m_bBordersOnTop(true),
-    m_bMouseEnter(false)
+    m_bMouseEnter(false),
+    m_bRetainedLayer(false)
 {
 }
 
@@ -77,508 +79,967 @@ Control::~Control()
 
 DString Control::GetType() const { return DUI_CTR_CONTROL; }
 
+void Control::SetWindow(Window* pWindow)
+{
+    Window* pOldWindow = GetWindow();
+    if ((pOldWindow != nullptr) && (pOldWindow != pWindow)) {
+        //图层和布局记录在原窗口中，需要删除
+        pOldWindow->GetLayerCache().RemoveLayer(this);
+        pOldWindow->RemoveArrangeControl(this);
+        m_pTempRender.reset();
+    }
+    BaseClass::SetWindow(pWindow);
+    if ((pWindow != nullptr) && (pOldWindow != pWindow) && IsArranged()) {
+        //在新的窗口中重新布局
+        pWindow->AddArrangeControl(this);
+    }
+}
+
+namespace
+{
+/** Control的属性ID（与属性名称一一对应，兼容的旧属性名称对应相同的属性ID）
+*/
+enum class ControlAttribute : int32_t
+{
+    kClass,
+    kHalign,
+    kValign,
+    kAlign,
+    kMargin,
+    kPadding,
+    kControlPadding,
+    kBkcolor,
+    kBkcolor2,
+    kBkcolor2Direction,
+    kForeColor,
+    kBorderSize,
+    kBorderDashStyle,
+    kBordersOnTop,
+    kBorderRound,
+    kBoxShadow,
+    kWidth,
+    kHeight,
+    kState,
+    kCursorType,
+    kRenderOffset,
+    kNormalColor,
+    kHotColor,
+    kPushedColor,
+    kDisabledColor,
+    kNormalColorMargin,
+    kHotColorMargin,
+    kPushedColorMargin,
+    kDisabledColorMargin,
+    kNormalColorRound,
+    kHotColorRound,
+    kPushedColorRound,
+    kDisabledColorRound,
+    kBorderColor,
+    kNormalBorderColor,
+    kHotBorderColor,
+    kPushedBorderColor,
+    kDisabledBorderColor,
+    kFocusBorderColor,
+    kLeftBorderSize,
+    kTopBorderSize,
+    kRightBorderSize,
+    kBottomBorderSize,
+    kBkimage,
+    kMinWidth,
+    kMaxWidth,
+    kMinHeight,
+    kMaxHeight,
+    kName,
+    kTooltipText,
+    kTooltipTextId,
+    kTooltipWidth,
+    kDataId,
+    kUserDataId,
+    kEnabled,
+    kMouseEnabled,
+    kKeyboardEnabled,
+    kVisible,
+    kFadeVisible,
+    kFloat,
+    kKeepFloatPos,
+    kCache,
+    kNoFocus,
+    kAlpha,
+    kRetainedLayer,
+    kNormalImage,
+    kHotImage,
+    kPushedImage,
+    kDisabledImage,
+    kForeNormalImage,
+    kForeHotImage,
+    kForePushedImage,
+    kForeDisabledImage,
+    kFadeAlpha,
+    kFadeHot,
+    kFadeWidth,
+    kFadeHeight,
+    kFadeInOutXFromLeft,
+    kFadeInOutXFromRight,
+    kFadeInOutYFromTop,
+    kFadeInOutYFromBottom,
+    kTabStop,
+    kLoading,
+    kShowFocusRect,
+    kFocusRectColor,
+    kPaintOrder,
+    kStartImageAnimation,
+    kStopImageAnimation,
+    kSetImageAnimationFrame,
+    kEnableDragDrop,
+    kEnableDropFile,
+    kDropFileTypes,
+    kRowSpan,
+    kColSpan
+};
+
+/** Control的属性表（属性名称 -> 属性ID）
+*/
+constexpr AttributeTableEntry kControlAttributeEntries[] = {
+    {"class", (int32_t)ControlAttribute::kClass},
+    {"halign", (int32_t)ControlAttribute::kHalign},
+    {"valign", (int32_t)ControlAttribute::kValign},
+    {"align", (int32_t)ControlAttribute::kAlign},
+    {"margin", (int32_t)ControlAttribute::kMargin},
+    {"padding", (int32_t)ControlAttribute::kPadding},
+    {"control_padding", (int32_t)ControlAttribute::kControlPadding},
+    {"bkcolor", (int32_t)ControlAttribute::kBkcolor},
+    {"bkcolor2", (int32_t)ControlAttribute::kBkcolor2},
+    {"bkcolor2_direction", (int32_t)ControlAttribute::kBkcolor2Direction},
+    {"fore_color", (int32_t)ControlAttribute::kForeColor},
+    {"border_size", (int32_t)ControlAttribute::kBorderSize},
+    {"bordersize", (int32_t)ControlAttribute::kBorderSize},
+    {"border_dash_style", (int32_t)ControlAttribute::kBorderDashStyle},
+    {"borders_on_top", (int32_t)ControlAttribute::kBordersOnTop},
+    {"border_round", (int32_t)ControlAttribute::kBorderRound},
+    {"borderround", (int32_t)ControlAttribute::kBorderRound},
+    {"box_shadow", (int32_t)ControlAttribute::kBoxShadow},
+    {"boxshadow", (int32_t)ControlAttribute::kBoxShadow},
+    {"width", (int32_t)ControlAttribute::kWidth},
+    {"height", (int32_t)ControlAttribute::kHeight},
+    {"state", (int32_t)ControlAttribute::kState},
+    {"cursor_type", (int32_t)ControlAttribute::kCursorType},
+    {"cursortype", (int32_t)ControlAttribute::kCursorType},
+    {"render_offset", (int32_t)ControlAttribute::kRenderOffset},
+    {"renderoffset", (int32_t)ControlAttribute::kRenderOffset},
+    {"normal_color", (int32_t)ControlAttribute::kNormalColor},
+    {"normalcolor", (int32_t)ControlAttribute::kNormalColor},
+    {"hot_color", (int32_t)ControlAttribute::kHotColor},
+    {"hotcolor", (int32_t)ControlAttribute::kHotColor},
+    {"pushed_color", (int32_t)ControlAttribute::kPushedColor},
+    {"pushedcolor", (int32_t)ControlAttribute::kPushedColor},
+    {"disabled_color", (int32_t)ControlAttribute::kDisabledColor},
+    {"disabledcolor", (int32_t)ControlAttribute::kDisabledColor},
+    {"normal_color_margin", (int32_t)ControlAttribute::kNormalColorMargin},
+    {"hot_color_margin", (int32_t)ControlAttribute::kHotColorMargin},
+    {"pushed_color_margin", (int32_t)ControlAttribute::kPushedColorMargin},
+    {"disabled_color_margin", (int32_t)ControlAttribute::kDisabledColorMargin},
+    {"normal_color_round", (int32_t)ControlAttribute::kNormalColorRound},
+    {"hot_color_round", (int32_t)ControlAttribute::kHotColorRound},
+    {"pushed_color_round", (int32_t)ControlAttribute::kPushedColorRound},
+    {"disabled_color_round", (int32_t)ControlAttribute::kDisabledColorRound},
+    {"border_color", (int32_t)ControlAttribute::kBorderColor},
+    {"bordercolor", (int32_t)ControlAttribute::kBorderColor},
+    {"normal_border_color", (int32_t)ControlAttribute::kNormalBorderColor},
+    {"hot_border_color", (int32_t)ControlAttribute::kHotBorderColor},
+    {"pushed_border_color", (int32_t)ControlAttribute::kPushedBorderColor},
+    {"disabled_border_color", (int32_t)ControlAttribute::kDisabledBorderColor},
+    {"focus_border_color", (int32_t)ControlAttribute::kFocusBorderColor},
+    {"left_border_size", (int32_t)ControlAttribute::kLeftBorderSize},
+    {"leftbordersize", (int32_t)ControlAttribute::kLeftBorderSize},
+    {"top_border_size", (int32_t)ControlAttribute::kTopBorderSize},
+    {"topbordersize", (int32_t)ControlAttribute::kTopBorderSize},
+    {"right_border_size", (int32_t)ControlAttribute::kRightBorderSize},
+    {"rightbordersize", (int32_t)ControlAttribute::kRightBorderSize},
+    {"bottom_border_size", (int32_t)ControlAttribute::kBottomBorderSize},
+    {"bottombordersize", (int32_t)ControlAttribute::kBottomBorderSize},
+    {"bkimage", (int32_t)ControlAttribute::kBkimage},
+    {"min_width", (int32_t)ControlAttribute::kMinWidth},
+    {"minwidth", (int32_t)ControlAttribute::kMinWidth},
+    {"max_width", (int32_t)ControlAttribute::kMaxWidth},
+    {"maxwidth", (int32_t)ControlAttribute::kMaxWidth},
+    {"min_height", (int32_t)ControlAttribute::kMinHeight},
+    {"minheight", (int32_t)ControlAttribute::kMinHeight},
+    {"max_height", (int32_t)ControlAttribute::kMaxHeight},
+    {"maxheight", (int32_t)ControlAttribute::kMaxHeight},
+    {"name", (int32_t)ControlAttribute::kName},
+    {"tooltip_text", (int32_t)ControlAttribute::kTooltipText},
+    {"tooltiptext", (int32_t)ControlAttribute::kTooltipText},
+    {"tooltip_text_id", (int32_t)ControlAttribute::kTooltipTextId},
+    {"tooltip_textid", (int32_t)ControlAttribute::kTooltipTextId},
+    {"tooltiptextid", (int32_t)ControlAttribute::kTooltipTextId},
+    {"tooltip_width", (int32_t)ControlAttribute::kTooltipWidth},
+    {"data_id", (int32_t)ControlAttribute::kDataId},
+    {"dataid", (int32_t)ControlAttribute::kDataId},
+    {"user_data_id", (int32_t)ControlAttribute::kUserDataId},
+    {"user_dataid", (int32_t)ControlAttribute::kUserDataId},
+    {"enabled", (int32_t)ControlAttribute::kEnabled},
+    {"mouse_enabled", (int32_t)ControlAttribute::kMouseEnabled},
+    {"mouse", (int32_t)ControlAttribute::kMouseEnabled},
+    {"keyboard_enabled", (int32_t)ControlAttribute::kKeyboardEnabled},
+    {"keyboard", (int32_t)ControlAttribute::kKeyboardEnabled},
+    {"visible", (int32_t)ControlAttribute::kVisible},
+    {"fade_visible", (int32_t)ControlAttribute::kFadeVisible},
+    {"fadevisible", (int32_t)ControlAttribute::kFadeVisible},
+    {"float", (int32_t)ControlAttribute::kFloat},
+    {"keep_float_pos", (int32_t)ControlAttribute::kKeepFloatPos},
+    {"cache", (int32_t)ControlAttribute::kCache},
+    {"no_focus", (int32_t)ControlAttribute::kNoFocus},
+    {"nofocus", (int32_t)ControlAttribute::kNoFocus},
+    {"alpha", (int32_t)ControlAttribute::kAlpha},
+    {"retained_layer", (int32_t)ControlAttribute::kRetainedLayer},
+    {"normal_image", (int32_t)ControlAttribute::kNormalImage},
+    {"normalimage", (int32_t)ControlAttribute::kNormalImage},
+    {"hot_image", (int32_t)ControlAttribute::kHotImage},
+    {"hotimage", (int32_t)ControlAttribute::kHotImage},
+    {"pushed_image", (int32_t)ControlAttribute::kPushedImage},
+    {"pushedimage", (int32_t)ControlAttribute::kPushedImage},
+    {"disabled_image", (int32_t)ControlAttribute::kDisabledImage},
+    {"disabledimage", (int32_t)ControlAttribute::kDisabledImage},
+    {"fore_normal_image", (int32_t)ControlAttribute::kForeNormalImage},
+    {"forenormalimage", (int32_t)ControlAttribute::kForeNormalImage},
+    {"fore_hot_image", (int32_t)ControlAttribute::kForeHotImage},
+    {"forehotimage", (int32_t)ControlAttribute::kForeHotImage},
+    {"fore_pushed_image", (int32_t)ControlAttribute::kForePushedImage},
+    {"forepushedimage", (int32_t)ControlAttribute::kForePushedImage},
+    {"fore_disabled_image", (int32_t)ControlAttribute::kForeDisabledImage},
+    {"foredisabledimage", (int32_t)ControlAttribute::kForeDisabledImage},
+    {"fade_alpha", (int32_t)ControlAttribute::kFadeAlpha},
+    {"fadealpha", (int32_t)ControlAttribute::kFadeAlpha},
+    {"fade_hot", (int32_t)ControlAttribute::kFadeHot},
+    {"fadehot", (int32_t)ControlAttribute::kFadeHot},
+    {"fade_width", (int32_t)ControlAttribute::kFadeWidth},
+    {"fadewidth", (int32_t)ControlAttribute::kFadeWidth},
+    {"fade_height", (int32_t)ControlAttribute::kFadeHeight},
+    {"fadeheight", (int32_t)ControlAttribute::kFadeHeight},
+    {"fade_in_out_x_from_left", (int32_t)ControlAttribute::kFadeInOutXFromLeft},
+    {"fadeinoutxfromleft", (int32_t)ControlAttribute::kFadeInOutXFromLeft},
+    {"fade_in_out_x_from_right", (int32_t)ControlAttribute::kFadeInOutXFromRight},
+    {"fadeinoutxfromright", (int32_t)ControlAttribute::kFadeInOutXFromRight},
+    {"fade_in_out_y_from_top", (int32_t)ControlAttribute::kFadeInOutYFromTop},
+    {"fadeinoutyfromtop", (int32_t)ControlAttribute::kFadeInOutYFromTop},
+    {"fade_in_out_y_from_bottom", (int32_t)ControlAttribute::kFadeInOutYFromBottom},
+    {"fadeinoutyfrombottom", (int32_t)ControlAttribute::kFadeInOutYFromBottom},
+    {"tab_stop", (int32_t)ControlAttribute::kTabStop},
+    {"tabstop", (int32_t)ControlAttribute::kTabStop},
+    {"loading", (int32_t)ControlAttribute::kLoading},
+    {"show_focus_rect", (int32_t)ControlAttribute::kShowFocusRect},
+    {"focus_rect_color", (int32_t)ControlAttribute::kFocusRectColor},
+    {"paint_order", (int32_t)ControlAttribute::kPaintOrder},
+    {"start_image_animation", (int32_t)ControlAttribute::kStartImageAnimation},
+    {"start_gif_play", (int32_t)ControlAttribute::kStartImageAnimation},
+    {"stop_image_animation", (int32_t)ControlAttribute::kStopImageAnimation},
+    {"stop_gif_play", (int32_t)ControlAttribute::kStopImageAnimation},
+    {"set_image_animation_frame", (int32_t)ControlAttribute::kSetImageAnimationFrame},
+    {"enable_drag_drop", (int32_t)ControlAttribute::kEnableDragDrop},
+    {"enable_drop_file", (int32_t)ControlAttribute::kEnableDropFile},
+    {"drop_file_types", (int32_t)ControlAttribute::kDropFileTypes},
+    {"row_span", (int32_t)ControlAttribute::kRowSpan},
+    {"col_span", (int32_t)ControlAttribute::kColSpan},
+};
+constexpr AttributeTable kControlAttributeTable(kControlAttributeEntries);
+static_assert(kControlAttributeTable.IsValid(), "Control attribute table is invalid!");
+}
+
 void Control::SetAttribute(const DString& strName, const DString& strValue)
 {
     ASSERT(GetWindow() != nullptr);//由于需要做DPI感知功能，所以必须先设置关联窗口
-    if (strName == _T("class")) {
-        SetClass(strValue);
-    }
-    else if (strName == _T("halign")) {
-        if (strValue == _T("left")) {
-            SetHorAlignType(HorAlignType::kAlignLeft);
+    switch ((ControlAttribute)kControlAttributeTable.Find(strName)) {
+    case ControlAttribute::kClass:
+        {
+            SetClass(strValue);
         }
-        else if (strValue == _T("center")) {
-            SetHorAlignType(HorAlignType::kAlignCenter);
+        break;
+    case ControlAttribute::kHalign:
+        {
+            if (strValue == _T("left")) {
+                SetHorAlignType(HorAlignType::kAlignLeft);
+            }
+            else if (strValue == _T("center")) {
+                SetHorAlignType(HorAlignType::kAlignCenter);
+            }
+            else if (strValue == _T("right")) {
+                SetHorAlignType(HorAlignType::kAlignRight);
+            }
+            else {
+                ASSERT(0);
+            }
         }
-        else if (strValue == _T("right")) {
-            SetHorAlignType(HorAlignType::kAlignRight);
+        break;
+    case ControlAttribute::kValign:
+        {
+            if (strValue == _T("top")) {
+                SetVerAlignType(VerAlignType::kAlignTop);
+            }
+            else if (strValue == _T("center")) {
+                SetVerAlignType(VerAlignType::kAlignCenter);
+            }
+            else if (strValue == _T("bottom")) {
+                SetVerAlignType(VerAlignType::kAlignBottom);
+            }
+            else {
+                ASSERT(0);
+            }
         }
-        else {
-            ASSERT(0);
+        break;
+    case ControlAttribute::kAlign:
+        {
+            //水平方向对齐方式
+            if (strValue.find(_T("left")) != DString::npos) {
+                SetHorAlignType(HorAlignType::kAlignLeft);
+            }
+            else if (strValue.find(_T("hcenter")) != DString::npos) {
+                SetHorAlignType(HorAlignType::kAlignCenter);
+            }
+            else if (strValue.find(_T("right")) != DString::npos) {
+                SetHorAlignType(HorAlignType::kAlignRight);
+            }
+            //垂直方向对齐方式
+            if (strValue.find(_T("top")) != DString::npos) {
+                SetVerAlignType(VerAlignType::kAlignTop);
+            }
+            else if (strValue.find(_T("vcenter")) != DString::npos) {
+                SetVerAlignType(VerAlignType::kAlignCenter);
+            }
+            else if (strValue.find(_T("bottom")) != DString::npos) {
+                SetVerAlignType(VerAlignType::kAlignBottom);
+            }
         }
-    }
-    else if (strName == _T("valign")) {
-        if (strValue == _T("top")) {
-            SetVerAlignType(VerAlignType::kAlignTop);
+        break;
+    case ControlAttribute::kMargin:
+        {
+            UiMargin rcMargin;
+            AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
+            SetMargin(rcMargin, true);
         }
-        else if (strValue == _T("center")) {
-            SetVerAlignType(VerAlignType::kAlignCenter);
+        break;
+    case ControlAttribute::kPadding:
+        {
+            UiPadding rcPadding;
+            AttributeUtil::ParsePaddingValue(strValue.c_str(), rcPadding);
+            SetPadding(rcPadding, true);
         }
-        else if (strValue == _T("bottom")) {
-            SetVerAlignType(VerAlignType::kAlignBottom);
+        break;
+    case ControlAttribute::kControlPadding:
+        {
+            SetEnableControlPadding(strValue == _T("true"));
         }
-        else {
-            ASSERT(0);
+        break;
+    case ControlAttribute::kBkcolor:
+        {
+            //背景色
+            SetBkColor(strValue);
         }
-    }
-    else if (strName == _T("align")) {
-        //水平方向对齐方式
-        if (strValue.find(_T("left")) != DString::npos) {
-            SetHorAlignType(HorAlignType::kAlignLeft);
+        break;
+    case ControlAttribute::kBkcolor2:
+        {
+            //第二背景色（实现渐变背景色）
+            SetBkColor2(strValue);
+        }
+        break;
+    case ControlAttribute::kBkcolor2Direction:
+        {
+            //第二背景色的方向："1": 左->右，"2": 上->下，"3": 左上->右下，"4": 右上->左下
+            SetBkColor2Direction(strValue);
+        }
+        break;
+    case ControlAttribute::kForeColor:
+        {
+            //前景色
+            SetForeColor(strValue);
         }
-        else if (strValue.find(_T("hcenter")) != DString::npos) {
-            SetHorAlignType(HorAlignType::kAlignCenter);
+        break;
+    case ControlAttribute::kBorderSize:
+        {
+            //边线宽度
+            DString nValue = strValue;
+            if (nValue.find(_T(',')) == DString::npos) {
+                int32_t nBorderSize = StringUtil::StringToInt32(strValue);
+                if (nBorderSize < 0) {
+                    nBorderSize = 0;
+                }
+                UiRectF rcBorder((float)nBorderSize, (float)nBorderSize, (float)nBorderSize, (float)nBorderSize);
+                SetBorderSize(rcBorder, true);
+            }
+            else {
+                UiMargin rcMargin;
+                AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
+                UiRectF rcBorder((float)rcMargin.left, (float)rcMargin.top, (float)rcMargin.right, (float)rcMargin.bottom);
+                SetBorderSize(rcBorder, true);
+            }
         }
-        else if (strValue.find(_T("right")) != DString::npos) {
-            SetHorAlignType(HorAlignType::kAlignRight);
+        break;
+    case ControlAttribute::kBorderDashStyle:
+        {
+            //边线的线形（四个边的边线的线形只能一致，不支持分开设置）
+            IPen::DashStyle dashStyle = IPen::kDashStyleSolid;
+            if (strValue == _T("solid")) {
+                dashStyle = IPen::kDashStyleSolid;
+            }
+            else if (strValue == _T("dash")) {
+                dashStyle = IPen::kDashStyleDash;
+            }
+            else if (strValue == _T("dot")) {
+                dashStyle = IPen::kDashStyleDot;
+            }
+            else if (strValue == _T("dash_dot")) {
+                dashStyle = IPen::kDashStyleDashDot;
+            }
+            else if (strValue == _T("dash_dot_dot")) {
+                dashStyle = IPen::kDashStyleDashDotDot;
+            }
+            SetBorderDashStyle((int8_t)dashStyle);
         }
-        //垂直方向对齐方式
-        if (strValue.find(_T("top")) != DString::npos) {
-            SetVerAlignType(VerAlignType::kAlignTop);
+        break;
+    case ControlAttribute::kBordersOnTop:
+        {
+            //边框是否在顶层（即先绘制子控件，后绘制边框，避免边框被子控件覆盖）
+            SetBordersOnTop(strValue == _T("true"));
         }
-        else if (strValue.find(_T("vcenter")) != DString::npos) {
-            SetVerAlignType(VerAlignType::kAlignCenter);
+        break;
+    case ControlAttribute::kBorderRound:
+        {
+            //圆角大小
+            UiSize cxyRound;
+            AttributeUtil::ParseSizeValue(strValue.c_str(), cxyRound);
+            SetBorderRound(cxyRound);
         }
-        else if (strValue.find(_T("bottom")) != DString::npos) {
-            SetVerAlignType(VerAlignType::kAlignBottom);
+        break;
+    case ControlAttribute::kBoxShadow:
+        {
+            SetBoxShadow(strValue);
         }
-    }
-    else if (strName == _T("margin")) {
-        UiMargin rcMargin;
-        AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
-        SetMargin(rcMargin, true);
-    }
-    else if (strName == _T("padding")) {
-        UiPadding rcPadding;
-        AttributeUtil::ParsePaddingValue(strValue.c_str(), rcPadding);
-        SetPadding(rcPadding, true);
-    }
-    else if (strName == _T("control_padding")) {
-        SetEnableControlPadding(strValue == _T("true"));
-    }
-    else if (strName == _T("bkcolor")) {
-        //背景色
-        SetBkColor(strValue);
-    }
-    else if (strName == _T("bkcolor2")) {
-        //第二背景色（实现渐变背景色）
-        SetBkColor2(strValue);
-    }
-    else if (strName == _T("bkcolor2_direction")) {
-        //第二背景色的方向："1": 左->右，"2": 上->下，"3": 左上->右下，"4": 右上->左下
-        SetBkColor2Direction(strValue);
-    }
-    else if (strName == _T("fore_color")) {
-        //前景色
-        SetForeColor(strValue);
-    }
-    else if ((strName == _T("border_size")) || (strName == _T("bordersize"))) {
-        //边线宽度
-        DString nValue = strValue;
-        if (nValue.find(_T(',')) == DString::npos) {
-            int32_t nBorderSize = StringUtil::StringToInt32(strValue);
-            if (nBorderSize < 0) {
-                nBorderSize = 0;
+        break;
+    case ControlAttribute::kWidth:
+        {
+            if (strValue == _T("stretch")) {
+                //宽度为拉伸：由父容器负责分配宽度
+                SetFixedWidth(UiFixedInt::MakeStretch(), true, true);
+            }
+            else if (strValue == _T("auto")) {
+                //宽度为自动：根据控件的文本、图片等自动计算宽度
+                SetFixedWidth(UiFixedInt::MakeAuto(), true, true);
+            }
+            else if (!strValue.empty()) {
+                if (strValue.back() == _T('%')) {
+                    //宽度为拉伸：由父容器负责按百分比分配宽度，比如 width="30%"，代表该控件的宽度期望值为父控件宽度的30%
+                    int32_t iValue = StringUtil::StringToInt32(strValue);
+                    if ((iValue <= 0) || (iValue > 100)) {
+                        iValue = 100;
+                    }
+                    SetFixedWidth(UiFixedInt::MakeStretch(iValue), true, false);
+                }
+                else {
+                    //宽度为固定值
+                    ASSERT(StringUtil::StringToInt32(strValue) >= 0);
+                    SetFixedWidth(UiFixedInt(StringUtil::StringToInt32(strValue)), true, true);
+                }
+            }
+            else {
+                SetFixedWidth(UiFixedInt(0), true, true);
             }
-            UiRectF rcBorder((float)nBorderSize, (float)nBorderSize, (float)nBorderSize, (float)nBorderSize);
-            SetBorderSize(rcBorder, true);
         }
-        else {
+        break;
+    case ControlAttribute::kHeight:
+        {
+            if (strValue == _T("stretch")) {
+                //高度为拉伸：由父容器负责分配高度
+                SetFixedHeight(UiFixedInt::MakeStretch(), true, true);
+            }
+            else if (strValue == _T("auto")) {
+                //高度为自动：根据控件的文本、图片等自动计算高度
+                SetFixedHeight(UiFixedInt::MakeAuto(), true, true);
+            }
+            else if (!strValue.empty()) {
+                if (strValue.back() == _T('%')) {
+                    //高度为拉伸：由父容器负责按百分比分配高度，比如 height="30%"，代表该控件的高度期望值为父控件高度的30%
+                    int32_t iValue = StringUtil::StringToInt32(strValue);
+                    if ((iValue <= 0) || (iValue > 100)) {
+                        iValue = 100;
+                    }
+                    SetFixedHeight(UiFixedInt::MakeStretch(iValue), true, false);
+                }
+                else {
+                    //高度为固定值
+                    ASSERT(StringUtil::StringToInt32(strValue) >= 0);
+                    SetFixedHeight(UiFixedInt(StringUtil::StringToInt32(strValue)), true, true);
+                }
+            }
+            else {
+                SetFixedHeight(UiFixedInt(0), true, true);
+            }
+        }
+        break;
+    case ControlAttribute::kState:
+        {
+            if (strValue == _T("normal")) {
+                SetState(kControlStateNormal);
+            }
+            else if (strValue == _T("hot")) {
+                SetState(kControlStateHot);
+            }
+            else if (strValue == _T("pushed")) {
+                SetState(kControlStatePushed);
+            }
+            else if (strValue == _T("disabled")) {
+                SetState(kControlStateDisabled);
+            }
+            else {
+                ASSERT(0);
+            }
+        }
+        break;
+    case ControlAttribute::kCursorType:
+        {
+            if (strValue == _T("arrow")) {
+                SetCursorType(CursorType::kCursorArrow);
+            }
+            else if (strValue == _T("ibeam")) {
+                SetCursorType(CursorType::kCursorIBeam);
+            }
+            else if (strValue == _T("hand")) {
+                SetCursorType(CursorType::kCursorHand);
+            }
+            else if (strValue == _T("wait")) {
+                SetCursorType(CursorType::kCursorWait);
+            }
+            else if (strValue == _T("cross")) {
+                SetCursorType(CursorType::kCursorCross);
+            }
+            else if (strValue == _T("size_we")) {
+                SetCursorType(CursorType::kCursorSizeWE);
+            }
+            else if (strValue == _T("size_ns")) {
+                SetCursorType(CursorType::kCursorSizeNS);
+            }
+            else if (strValue == _T("size_nwse")) {
+                SetCursorType(CursorType::kCursorSizeNWSE);
+            }
+            else if (strValue == _T("size_nesw")) {
+                SetCursorType(CursorType::kCursorSizeNESW);
+            }
+            else if (strValue == _T("size_all")) {
+                SetCursorType(CursorType::kCursorSizeAll);
+            }
+            else if (strValue == _T("no")) {
+                SetCursorType(CursorType::kCursorNo);
+            }
+            else if (strValue == _T("progress")) {
+                SetCursorType(CursorType::kCursorProgress);
+            }
+            else {
+                ASSERT(0);
+            }
+        }
+        break;
+    case ControlAttribute::kRenderOffset:
+        {
+            UiPoint renderOffset;
+            AttributeUtil::ParsePointValue(strValue.c_str(), renderOffset);
+            SetRenderOffset(renderOffset, true);
+        }
+        break;
+    case ControlAttribute::kNormalColor:
+        {
+            SetStateColor(kControlStateNormal, strValue);
+        }
+        break;
+    case ControlAttribute::kHotColor:
+        {
+            SetStateColor(kControlStateHot, strValue);
+        }
+        break;
+    case ControlAttribute::kPushedColor:
+        {
+            SetStateColor(kControlStatePushed, strValue);
+        }
+        break;
+    case ControlAttribute::kDisabledColor:
+        {
+            SetStateColor(kControlStateDisabled, strValue);
+        }
+        break;
+    case ControlAttribute::kNormalColorMargin:
+        {
             UiMargin rcMargin;
             AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
-            UiRectF rcBorder((float)rcMargin.left, (float)rcMargin.top, (float)rcMargin.right, (float)rcMargin.bottom);
-            SetBorderSize(rcBorder, true);
+            SetStateColorMargin(kControlStateNormal, rcMargin, true);
         }
-    }
-    else if (strName == _T("border_dash_style")) {
-        //边线的线形（四个边的边线的线形只能一致，不支持分开设置）
-        IPen::DashStyle dashStyle = IPen::kDashStyleSolid;
-        if (strValue == _T("solid")) {
-            dashStyle = IPen::kDashStyleSolid;
+        break;
+    case ControlAttribute::kHotColorMargin:
+        {
+            UiMargin rcMargin;
+            AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
+            SetStateColorMargin(kControlStateHot, rcMargin, true);
         }
-        else if (strValue == _T("dash")) {
-            dashStyle = IPen::kDashStyleDash;
+        break;
+    case ControlAttribute::kPushedColorMargin:
+        {
+            UiMargin rcMargin;
+            AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
+            SetStateColorMargin(kControlStatePushed, rcMargin, true);
         }
-        else if (strValue == _T("dot")) {
-            dashStyle = IPen::kDashStyleDot;
+        break;
+    case ControlAttribute::kDisabledColorMargin:
+        {
+            UiMargin rcMargin;
+            AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
+            SetStateColorMargin(kControlStateDisabled, rcMargin, true);
         }
-        else if (strValue == _T("dash_dot")) {
-            dashStyle = IPen::kDashStyleDashDot;
+        break;
+    case ControlAttribute::kNormalColorRound:
+        {
+            UiSize szRound;
+            AttributeUtil::ParseSizeValue(strValue.c_str(), szRound);
+            SetStateColorRound(kControlStateNormal, szRound, true);
         }
-        else if (strValue == _T("dash_dot_dot")) {
-            dashStyle = IPen::kDashStyleDashDotDot;
+        break;
+    case ControlAttribute::kHotColorRound:
+        {
+            UiSize szRound;
+            AttributeUtil::ParseSizeValue(strValue.c_str(), szRound);
+            SetStateColorRound(kControlStateHot, szRound, true);
         }
-        SetBorderDashStyle((int8_t)dashStyle);
-    }
-    else if (strName == _T("borders_on_top")) {
-        //边框是否在顶层（即先绘制子控件，后绘制边框，避免边框被子控件覆盖）
-        SetBordersOnTop(strValue == _T("true"));
-    }
-    else if ((strName == _T("border_round")) || (strName == _T("borderround"))) {
-        //圆角大小
-        UiSize cxyRound;
-        AttributeUtil::ParseSizeValue(strValue.c_str(), cxyRound);
-        SetBorderRound(cxyRound);
-    }
-    else if ((strName == _T("box_shadow")) || (strName == _T("boxshadow"))) {
-        SetBoxShadow(strValue);
-    }
-    else if (strName == _T("width")) {
-        if (strValue == _T("stretch")) {
-            //宽度为拉伸：由父容器负责分配宽度
-            SetFixedWidth(UiFixedInt::MakeStretch(), true, true);
+        break;
+    case ControlAttribute::kPushedColorRound:
+        {
+            UiSize szRound;
+            AttributeUtil::ParseSizeValue(strValue.c_str(), szRound);
+            SetStateColorRound(kControlStatePushed, szRound, true);
+        }
+        break;
+    case ControlAttribute::kDisabledColorRound:
+        {
+            UiSize szRound;
+            AttributeUtil::ParseSizeValue(strValue.c_str(), szRound);
+            SetStateColorRound(kControlStateDisabled, szRound, true);
         }
-        else if (strValue == _T("auto")) {
-            //宽度为自动：根据控件的文本、图片等自动计算宽度
-            SetFixedWidth(UiFixedInt::MakeAuto(), true, true);
+        break;
+    case ControlAttribute::kBorderColor:
+        {
+            SetBorderColor(strValue);
         }
-        else if (!strValue.empty()) {
-            if (strValue.back() == _T('%')) {
-                //宽度为拉伸：由父容器负责按百分比分配宽度，比如 width="30%"，代表该控件的宽度期望值为父控件宽度的30%
-                int32_t iValue = StringUtil::StringToInt32(strValue);
-                if ((iValue <= 0) || (iValue > 100)) {
-                    iValue = 100;
-                }
-                SetFixedWidth(UiFixedInt::MakeStretch(iValue), true, false);
-            }
-            else {
-                //宽度为固定值
-                ASSERT(StringUtil::StringToInt32(strValue) >= 0);
-                SetFixedWidth(UiFixedInt(StringUtil::StringToInt32(strValue)), true, true);
-            }
+        break;
+    case ControlAttribute::kNormalBorderColor:
+        {
+            SetBorderColor(kControlStateNormal, strValue);
         }
-        else {
-            SetFixedWidth(UiFixedInt(0), true, true);
+        break;
+    case ControlAttribute::kHotBorderColor:
+        {
+            SetBorderColor(kControlStateHot, strValue);
         }
-    }
-    else if (strName == _T("height")) {
-        if (strValue == _T("stretch")) {
-            //高度为拉伸：由父容器负责分配高度
-            SetFixedHeight(UiFixedInt::MakeStretch(), true, true);
+        break;
+    case ControlAttribute::kPushedBorderColor:
+        {
+            SetBorderColor(kControlStatePushed, strValue);
+        }
+        break;
+    case ControlAttribute::kDisabledBorderColor:
+        {
+            SetBorderColor(kControlStateDisabled, strValue);
+        }
+        break;
+    case ControlAttribute::kFocusBorderColor:
+        {
+            SetFocusBorderColor(strValue);
+        }
+        break;
+    case ControlAttribute::kLeftBorderSize:
+        {
+            SetLeftBorderSize((float)StringUtil::StringToInt32(strValue), true);
+        }
+        break;
+    case ControlAttribute::kTopBorderSize:
+        {
+            SetTopBorderSize((float)StringUtil::StringToInt32(strValue), true);
+        }
+        break;
+    case ControlAttribute::kRightBorderSize:
+        {
+            SetRightBorderSize((float)StringUtil::StringToInt32(strValue), true);
+        }
+        break;
+    case ControlAttribute::kBottomBorderSize:
+        {
+            SetBottomBorderSize((float)StringUtil::StringToInt32(strValue), true);
+        }
+        break;
+    case ControlAttribute::kBkimage:
+        {
+            SetBkImage(strValue);
+        }
+        break;
+    case ControlAttribute::kMinWidth:
+        {
+            SetMinWidth(StringUtil::StringToInt32(strValue), true);
+        }
+        break;
+    case ControlAttribute::kMaxWidth:
+        {
+            SetMaxWidth(StringUtil::StringToInt32(strValue), true);
+        }
+        break;
+    case ControlAttribute::kMinHeight:
+        {
+            SetMinHeight(StringUtil::StringToInt32(strValue), true);
+        }
+        break;
+    case ControlAttribute::kMaxHeight:
+        {
+            SetMaxHeight(StringUtil::StringToInt32(strValue), true);
+        }
+        break;
+    case ControlAttribute::kName:
+        {
+            SetName(strValue);
+        }
+        break;
+    case ControlAttribute::kTooltipText:
+        {
+            SetToolTipText(strValue);
+        }
+        break;
+    case ControlAttribute::kTooltipTextId:
+        {
+            SetToolTipTextId(strValue);
+        }
+        break;
+    case ControlAttribute::kTooltipWidth:
+        {
+            SetToolTipWidth(StringUtil::StringToInt32(strValue), true);
+        }
+        break;
+    case ControlAttribute::kDataId:
+        {
+            SetDataID(strValue);
+        }
+        break;
+    case ControlAttribute::kUserDataId:
+        {
+            SetUserDataID(StringUtil::StringToInt32(strValue));
+        }
+        break;
+    case ControlAttribute::kEnabled:
+        {
+            SetEnabled(strValue == _T("true"));
+        }
+        break;
+    case ControlAttribute::kMouseEnabled:
+        {
+            SetMouseEnabled(strValue == _T("true"));
+        }
+        break;
+    case ControlAttribute::kKeyboardEnabled:
+        {
+            SetKeyboardEnabled(strValue == _T("true"));
+        }
+        break;
+    case ControlAttribute::kVisible:
+        {
+            SetVisible(strValue == _T("true"));
+        }
+        break;
+    case ControlAttribute::kFadeVisible:
+        {
+            SetFadeVisible(strValue == _T("true"));
+        }
+        break;
+    case ControlAttribute::kFloat:
+        {
+            SetFloat(strValue == _T("true"));
+        }
+        break;
+    case ControlAttribute::kKeepFloatPos:
+        {
+            SetKeepFloatPos(strValue == _T("true"));
+        }
+        break;
+    case ControlAttribute::kCache:
+        {
+            //忽略该选项：对应功能已经删除
+        }
+        break;
+    case ControlAttribute::kNoFocus:
+        {
+            SetNoFocus();
+        }
+        break;
+    case ControlAttribute::kAlpha:
+        {
+            SetAlpha(StringUtil::StringToInt32(strValue));
+        }
+        break;
+    case ControlAttribute::kRetainedLayer:
+        {
+            SetRetainedLayer(strValue == _T("true"));
+        }
+        break;
+    case ControlAttribute::kNormalImage:
+        {
+            SetStateImage(kControlStateNormal, strValue);
+        }
+        break;
+    case ControlAttribute::kHotImage:
+        {
+            SetStateImage(kControlStateHot, strValue);
+        }
+        break;
+    case ControlAttribute::kPushedImage:
+        {
+            SetStateImage(kControlStatePushed, strValue);
+        }
+        break;
+    case ControlAttribute::kDisabledImage:
+        {
+            SetStateImage(kControlStateDisabled, strValue);
+        }
+        break;
+    case ControlAttribute::kForeNormalImage:
+        {
+            SetForeStateImage(kControlStateNormal, strValue);
+        }
+        break;
+    case ControlAttribute::kForeHotImage:
+        {
+            SetForeStateImage(kControlStateHot, strValue);
+        }
+        break;
+    case ControlAttribute::kForePushedImage:
+        {
+            SetForeStateImage(kControlStatePushed, strValue);
         }
-        else if (strValue == _T("auto")) {
-            //高度为自动：根据控件的文本、图片等自动计算高度
-            SetFixedHeight(UiFixedInt::MakeAuto(), true, true);
+        break;
+    case ControlAttribute::kForeDisabledImage:
+        {
+            SetForeStateImage(kControlStateDisabled, strValue);
         }
-        else if (!strValue.empty()) {
-            if (strValue.back() == _T('%')) {
-                //高度为拉伸：由父容器负责按百分比分配高度，比如 height="30%"，代表该控件的高度期望值为父控件高度的30%
-                int32_t iValue = StringUtil::StringToInt32(strValue);
-                if ((iValue <= 0) || (iValue > 100)) {
-                    iValue = 100;
+        break;
+    case ControlAttribute::kFadeAlpha:
+        {
+            bool bFadeVisible = strValue != _T("false");
+            int32_t nEndAlpha = GetAlpha();
+            if (bFadeVisible) {
+                if (strValue != _T("true")) {
+                    nEndAlpha = StringUtil::StringToInt32(strValue);
                 }
-                SetFixedHeight(UiFixedInt::MakeStretch(iValue), true, false);
-            }
-            else {
-                //高度为固定值
-                ASSERT(StringUtil::StringToInt32(strValue) >= 0);
-                SetFixedHeight(UiFixedInt(StringUtil::StringToInt32(strValue)), true, true);
             }
+            GetAnimationManager().SetFadeAlpha(bFadeVisible, nEndAlpha);
         }
-        else {
-            SetFixedHeight(UiFixedInt(0), true, true);
+        break;
+    case ControlAttribute::kFadeHot:
+        {
+            GetAnimationManager().SetFadeHot(strValue == _T("true"));
         }
-    }
-    else if (strName == _T("state")) {
-        if (strValue == _T("normal")) {
-            SetState(kControlStateNormal);
+        break;
+    case ControlAttribute::kFadeWidth:
+        {
+            GetAnimationManager().SetFadeWidth(strValue == _T("true"));
         }
-        else if (strValue == _T("hot")) {
-            SetState(kControlStateHot);
+        break;
+    case ControlAttribute::kFadeHeight:
+        {
+            GetAnimationManager().SetFadeHeight(strValue == _T("true"));
         }
-        else if (strValue == _T("pushed")) {
-            SetState(kControlStatePushed);
+        break;
+    case ControlAttribute::kFadeInOutXFromLeft:
+        {
+            GetAnimationManager().SetFadeInOutX(strValue == _T("true"), false);
         }
-        else if (strValue == _T("disabled")) {
-            SetState(kControlStateDisabled);
+        break;
+    case ControlAttribute::kFadeInOutXFromRight:
+        {
+            GetAnimationManager().SetFadeInOutX(strValue == _T("true"), true);
         }
-        else {
-            ASSERT(0);
+        break;
+    case ControlAttribute::kFadeInOutYFromTop:
+        {
+            GetAnimationManager().SetFadeInOutY(strValue == _T("true"), false);
         }
-    }
-    else if ((strName == _T("cursor_type")) || (strName == _T("cursortype"))) {
-        if (strValue == _T("arrow")) {
-            SetCursorType(CursorType::kCursorArrow);
+        break;
+    case ControlAttribute::kFadeInOutYFromBottom:
+        {
+            GetAnimationManager().SetFadeInOutY(strValue == _T("true"), true);
         }
-        else if (strValue == _T("ibeam")) {
-            SetCursorType(CursorType::kCursorIBeam);
+        break;
+    case ControlAttribute::kTabStop:
+        {
+            SetTabStop(strValue == _T("true"));
         }
-        else if (strValue == _T("hand")) {
-            SetCursorType(CursorType::kCursorHand);
+        break;
+    case ControlAttribute::kLoading:
+        {
+            SetLoadingAttribute(strValue);
         }
-        else if (strValue == _T("wait")) {
-            SetCursorType(CursorType::kCursorWait);
+        break;
+    case ControlAttribute::kShowFocusRect:
+        {
+            SetShowFocusRect(strValue == _T("true"));
         }
-        else if (strValue == _T("cross")) {
-            SetCursorType(CursorType::kCursorCross);
+        break;
+    case ControlAttribute::kFocusRectColor:
+        {
+            SetFocusRectColor(strValue);
         }
-        else if (strValue == _T("size_we")) {
-            SetCursorType(CursorType::kCursorSizeWE);
+        break;
+    case ControlAttribute::kPaintOrder:
+        {
+            uint8_t nPaintOrder = TruncateToUInt8(StringUtil::StringToInt32(strValue));
+            SetPaintOrder(nPaintOrder);
         }
-        else if (strValue == _T("size_ns")) {
-            SetCursorType(CursorType::kCursorSizeNS);
+        break;
+    case ControlAttribute::kStartImageAnimation:
+        {
+            ParseStartImageAnimation(strValue);
         }
-        else if (strValue == _T("size_nwse")) {
-            SetCursorType(CursorType::kCursorSizeNWSE);
+        break;
+    case ControlAttribute::kStopImageAnimation:
+        {
+            ParseStopImageAnimation(strValue);
         }
-        else if (strValue == _T("size_nesw")) {
-            SetCursorType(CursorType::kCursorSizeNESW);
+        break;
+    case ControlAttribute::kSetImageAnimationFrame:
+        {
+            ParseSetImageAnimationFrame(strValue);
         }
-        else if (strValue == _T("size_all")) {
-            SetCursorType(CursorType::kCursorSizeAll);
+        break;
+    case ControlAttribute::kEnableDragDrop:
+        {
+            //是否允许拖放操作
+            SetEnableDragDrop(strValue == _T("true"));
         }
-        else if (strValue == _T("no")) {
-            SetCursorType(CursorType::kCursorNo);
+        break;
+    case ControlAttribute::kEnableDropFile:
+        {
+            //是否允许拖放文件操作
+            SetEnableDropFile(strValue == _T("true"));
         }
-        else if (strValue == _T("progress")) {
-            SetCursorType(CursorType::kCursorProgress);
+        break;
+    case ControlAttribute::kDropFileTypes:
+        {
+            //拖放文件的扩展名列表
+            SetDropFileTypes(strValue);
         }
-        else {
-            ASSERT(0);
+        break;
+    case ControlAttribute::kRowSpan:
+        {
+            //设置单元格合并属性（占几行），仅在GridLayout布局中生效
+            SetRowSpan(StringUtil::StringToInt32(strValue));
         }
-    }
-    else if ((strName == _T("render_offset")) || (strName == _T("renderoffset"))) {
-        UiPoint renderOffset;
-        AttributeUtil::ParsePointValue(strValue.c_str(), renderOffset);
-        SetRenderOffset(renderOffset, true);
-    }
-    else if ((strName == _T("normal_color")) || (strName == _T("normalcolor"))) {
-        SetStateColor(kControlStateNormal, strValue);
-    }
-    else if ((strName == _T("hot_color")) || (strName == _T("hotcolor"))) {
-        SetStateColor(kControlStateHot, strValue);
-    }
-    else if ((strName == _T("pushed_color")) || (strName == _T("pushedcolor"))) {
-        SetStateColor(kControlStatePushed, strValue);
-    }
-    else if ((strName == _T("disabled_color")) || (strName == _T("disabledcolor"))) {
-        SetStateColor(kControlStateDisabled, strValue);
-    }
-    else if (strName == _T("normal_color_margin")) {
-        UiMargin rcMargin;
-        AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
-        SetStateColorMargin(kControlStateNormal, rcMargin, true);
-    }
-    else if (strName == _T("hot_color_margin")) {
-        UiMargin rcMargin;
-        AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
-        SetStateColorMargin(kControlStateHot, rcMargin, true);
-    }
-    else if (strName == _T("pushed_color_margin")) {
-        UiMargin rcMargin;
-        AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
-        SetStateColorMargin(kControlStatePushed, rcMargin, true);
-    }
-    else if (strName == _T("disabled_color_margin")) {
-        UiMargin rcMargin;
-        AttributeUtil::ParseMarginValue(strValue.c_str(), rcMargin);
-        SetStateColorMargin(kControlStateDisabled, rcMargin, true);
-    }
-    else if (strName == _T("normal_color_round")) {
-        UiSize szRound;
-        AttributeUtil::ParseSizeValue(strValue.c_str(), szRound);
-        SetStateColorRound(kControlStateNormal, szRound, true);
-    }
-    else if (strName == _T("hot_color_round")) {
-        UiSize szRound;
-        AttributeUtil::ParseSizeValue(strValue.c_str(), szRound);
-        SetStateColorRound(kControlStateHot, szRound, true);
-    }
-    else if (strName == _T("pushed_color_round")) {
-        UiSize szRound;
-        AttributeUtil::ParseSizeValue(strValue.c_str(), szRound);
-        SetStateColorRound(kControlStatePushed, szRound, true);
-    }
-    else if (strName == _T("disabled_color_round")) {
-        UiSize szRound;
-        AttributeUtil::ParseSizeValue(strValue.c_str(), szRound);
-        SetStateColorRound(kControlStateDisabled, szRound, true);
-    }
-    else if ((strName == _T("border_color")) || (strName == _T("bordercolor"))) {
-        SetBorderColor(strValue);
-    }
-    else if (strName == _T("normal_border_color")) {
-        SetBorderColor(kControlStateNormal, strValue);
-    }
-    else if (strName == _T("hot_border_color")) {
-        SetBorderColor(kControlStateHot, strValue);
-    }
-    else if (strName == _T("pushed_border_color")) {
-        SetBorderColor(kControlStatePushed, strValue);
-    }
-    else if (strName == _T("disabled_border_color")) {
-        SetBorderColor(kControlStateDisabled, strValue);
-    }
-    else if (strName == _T("focus_border_color")) {
-        SetFocusBorderColor(strValue);
-    }
-    else if ((strName == _T("left_border_size")) || (strName == _T("leftbordersize"))) {
-        SetLeftBorderSize((float)StringUtil::StringToInt32(strValue), true);
-    }
-    else if ((strName == _T("top_border_size")) || (strName == _T("topbordersize"))) {
-        SetTopBorderSize((float)StringUtil::StringToInt32(strValue), true);
-    }
-    else if ((strName == _T("right_border_size")) || (strName == _T("rightbordersize"))) {
-        SetRightBorderSize((float)StringUtil::StringToInt32(strValue), true);
-    }
-    else if ((strName == _T("bottom_border_size")) || (strName == _T("bottombordersize"))) {
-        SetBottomBorderSize((float)StringUtil::StringToInt32(strValue), true);
-    }
-    else if (strName == _T("bkimage")) {
-        SetBkImage(strValue);
-    }
-    else if ((strName == _T("min_width")) || (strName == _T("minwidth"))) {
-        SetMinWidth(StringUtil::StringToInt32(strValue), true);
-    }
-    else if ((strName == _T("max_width")) || (strName == _T("maxwidth"))) {
-        SetMaxWidth(StringUtil::StringToInt32(strValue), true);
-    }
-    else if ((strName == _T("min_height")) || (strName == _T("minheight"))) {
-        SetMinHeight(StringUtil::StringToInt32(strValue), true);
-    }
-    else if ((strName == _T("max_height")) || (strName == _T("maxheight"))) {
-        SetMaxHeight(StringUtil::StringToInt32(strValue), true);
-    }
-    else if (strName == _T("name")) {
-        SetName(strValue);
-    }
-    else if ((strName == _T("tooltip_text")) || (strName == _T("tooltiptext"))) {
-        SetToolTipText(strValue);
-    }
-    else if ((strName == _T("tooltip_text_id")) || (strName == _T("tooltip_textid")) || (strName == _T("tooltiptextid"))) {
-        SetToolTipTextId(strValue);
-    }
-    else if (strName == _T("tooltip_width")) {
-        SetToolTipWidth(StringUtil::StringToInt32(strValue), true);
-    }
-    else if ((strName == _T("data_id")) || (strName == _T("dataid"))) {
-        SetDataID(strValue);
-    }
-    else if ((strName == _T("user_data_id")) || (strName == _T("user_dataid"))) {
-        SetUserDataID(StringUtil::StringToInt32(strValue));
-    }
-    else if (strName == _T("enabled")) {
-        SetEnabled(strValue == _T("true"));
-    }
-    else if ((strName == _T("mouse_enabled")) || (strName == _T("mouse"))) {
-        SetMouseEnabled(strValue == _T("true"));
-    }
-    else if ((strName == _T("keyboard_enabled")) || (strName == _T("keyboard"))) {
-        SetKeyboardEnabled(strValue == _T("true"));
-    }
-    else if (strName == _T("visible")) {
-        SetVisible(strValue == _T("true"));
-    }
-    else if ((strName == _T("fade_visible")) || (strName == _T("fadevisible"))) {
-        SetFadeVisible(strValue == _T("true"));
-    }
-    else if (strName == _T("float")) {
-        SetFloat(strValue == _T("true"));
-    }
-    else if (strName == _T("keep_float_pos")) {
-        SetKeepFloatPos(strValue == _T("true"));
-    }
-    else if (strName == _T("cache")) {
-        //忽略该选项：对应功能已经删除
-    }
-    else if ((strName == _T("no_focus")) || (strName == _T("nofocus"))) {
-        SetNoFocus();
-    }
-    else if (strName == _T("alpha")) {
-        SetAlpha(StringUtil::StringToInt32(strValue));
-    }
-    else if ((strName == _T("normal_image")) || (strName == _T("normalimage"))) {
-        SetStateImage(kControlStateNormal, strValue);
-    }
-    else if ((strName == _T("hot_image")) || (strName == _T("hotimage"))) {
-        SetStateImage(kControlStateHot, strValue);
-    }
-    else if ((strName == _T("pushed_image")) || (strName == _T("pushedimage"))) {
-        SetStateImage(kControlStatePushed, strValue);
-    }
-    else if ((strName == _T("disabled_image")) || (strName == _T("disabledimage"))) {
-        SetStateImage(kControlStateDisabled, strValue);
-    }
-    else if ((strName == _T("fore_normal_image")) || (strName == _T("forenormalimage"))) {
-        SetForeStateImage(kControlStateNormal, strValue);
-    }
-    else if ((strName == _T("fore_hot_image")) || (strName == _T("forehotimage"))) {
-        SetForeStateImage(kControlStateHot, strValue);
-    }
-    else if ((strName == _T("fore_pushed_image")) || (strName == _T("forepushedimage"))) {
-        SetForeStateImage(kControlStatePushed, strValue);
-    }
-    else if ((strName == _T("fore_disabled_image")) || (strName == _T("foredisabledimage"))) {
-        SetForeStateImage(kControlStateDisabled, strValue);
-    }
-    else if ((strName == _T("fade_alpha")) || (strName == _T("fadealpha"))) {
-        bool bFadeVisible = strValue != _T("false");
-        int32_t nEndAlpha = GetAlpha();
-        if (bFadeVisible) {
-            if (strValue != _T("true")) {
-                nEndAlpha = StringUtil::StringToInt32(strValue);
-            }
+        break;
+    case ControlAttribute::kColSpan:
+        {
+            //设置单元格合并属性（占几列），仅在GridLayout布局中生效
+            SetColumnSpan(StringUtil::StringToInt32(strValue));
         }
-        GetAnimationManager().SetFadeAlpha(bFadeVisible, nEndAlpha);
-    }
-    else if ((strName == _T("fade_hot")) || (strName == _T("fadehot"))) {
-        GetAnimationManager().SetFadeHot(strValue == _T("true"));
-    }
-    else if ((strName == _T("fade_width")) || (strName == _T("fadewidth"))) {
-        GetAnimationManager().SetFadeWidth(strValue == _T("true"));
-    }
-    else if ((strName == _T("fade_height")) || (strName == _T("fadeheight"))) {
-        GetAnimationManager().SetFadeHeight(strValue == _T("true"));
-    }
-    else if ((strName == _T("fade_in_out_x_from_left")) || (strName == _T("fadeinoutxfromleft"))) {
-        GetAnimationManager().SetFadeInOutX(strValue == _T("true"), false);
-    }
-    else if ((strName == _T("fade_in_out_x_from_right")) || (strName == _T("fadeinoutxfromright"))) {
-        GetAnimationManager().SetFadeInOutX(strValue == _T("true"), true);
-    }
-    else if ((strName == _T("fade_in_out_y_from_top")) || (strName == _T("fadeinoutyfromtop"))) {
-        GetAnimationManager().SetFadeInOutY(strValue == _T("true"), false);
-    }
-    else if ((strName == _T("fade_in_out_y_from_bottom")) || (strName == _T("fadeinoutyfrombottom"))) {
-        GetAnimationManager().SetFadeInOutY(strValue == _T("true"), true);
-    }
-    else if ((strName == _T("tab_stop")) || (strName == _T("tabstop"))) {
-        SetTabStop(strValue == _T("true"));
-    }
-    else if (strName == _T("loading")) {
-        SetLoadingAttribute(strValue);
-    }
-    else if (strName == _T("show_focus_rect")) {
-        SetShowFocusRect(strValue == _T("true"));
-    }
-    else if (strName == _T("focus_rect_color")) {
-        SetFocusRectColor(strValue);
-    }
-    else if (strName == _T("paint_order")) {
-        uint8_t nPaintOrder = TruncateToUInt8(StringUtil::StringToInt32(strValue));
-        SetPaintOrder(nPaintOrder);
-    }
-    else if ((strName == _T("start_image_animation")) || (strName == _T("start_gif_play"))) {
-        ParseStartImageAnimation(strValue);
-    }
-    else if ((strName == _T("stop_image_animation")) || (strName == _T("stop_gif_play"))) {
-        ParseStopImageAnimation(strValue);
-    }
-    else if (strName == _T("set_image_animation_frame")) {
-        ParseSetImageAnimationFrame(strValue);
-    }
-    else if (strName == _T("enable_drag_drop")) {
-        //是否允许拖放操作
-        SetEnableDragDrop(strValue == _T("true"));
-    }
-    else if (strName == _T("enable_drop_file")) {
-        //是否允许拖放文件操作
-        SetEnableDropFile(strValue == _T("true"));
-    }
-    else if (strName == _T("drop_file_types")) {
-        //拖放文件的扩展名列表
-        SetDropFileTypes(strValue);
-    }
-    else if (strName == _T("row_span")) {
-        //设置单元格合并属性（占几行），仅在GridLayout布局中生效
-        SetRowSpan(StringUtil::StringToInt32(strValue));
-    }
-    else if (strName == _T("col_span")) {
-        //设置单元格合并属性（占几列），仅在GridLayout布局中生效
-        SetColumnSpan(StringUtil::StringToInt32(strValue));
-    }
-    else {
+        break;
+    default:
         ASSERT(!"Control::SetAttribute失败: 发现不能识别的属性");
+        break;
     }
 }
 
@@ -1419,6 +1880,17 @@ DString Control::GetBorderColor(ControlStateType stateType) const
     return borderColor;
 }
 
+ControlStateType Control::GetPaintBorderColorState(ControlStateType stateType) const
+{
+    return stateType;
+}
+
+bool Control::HasBorderColor(ControlStateType stateType) const
+{
+    return (m_pBorderData != nullptr) && (m_pBorderData->m_pBorderColorMap != nullptr) &&
+           m_pBorderData->m_pBorderColorMap->HasStateColor(stateType);
+}
+
 void Control::SetBorderColor(const DString& strBorderColor)
 {
     SetBorderColor(kControlStateNormal, strBorderColor);
@@ -2004,6 +2476,9 @@ void Control::SetPos(UiRect rc)
     //有很多类似的代码：SetPos(GetPos()), 代表设置位置，并重新绘制
     rc.Validate();
     SetArranged(false);
+    if (GetWindow() != nullptr) {
+        GetWindow()->AddLayoutVisitCount();
+    }
     std::weak_ptr<WeakFlag> weakFlag = GetWeakFlag();
     bool bPosChanged = (GetRect().Left() != rc.Left()) || (GetRect().Top() != rc.Top());
     bool bSizeChanged = (GetRect().Width() != rc.Width()) || (GetRect().Height() != rc.Height());
@@ -2983,6 +3458,20 @@ bool Control::PaintImage(IRender* pRender,
 
     LoadImageInfo(duiImage, true);
     std::shared_ptr<ImageInfo> imageInfo = duiImage.GetImageInfo();
+    if ((imageInfo == nullptr) && duiImage.IsImageLoading()) {
+        //图片正在子线程中加载，加载完成后会重绘：绘制占位颜色
+        const UiColor& placeholderColor = GlobalManager::Instance().Image().GetImageLoadingPlaceholderColor();
+        if (!placeholderColor.IsEmpty()) {
+            UiRect rcPlaceholder = GetRect();
+            rcPlaceholder.Deflate(GetControlPadding());//去掉内边距
+            if (pDestRect != nullptr) {
+                rcPlaceholder = *pDestRect;
+            }
+            uint8_t iFade = (nFade == DUI_NOSET_VALUE) ? duiImage.GetImageAttribute().m_bFade : static_cast<uint8_t>(nFade);
+            pRender->FillRect(rcPlaceholder, placeholderColor, iFade);
+        }
+        return false;
+    }
     if (duiImage.GetImageAttribute().IsAssertEnabled()) {
         ASSERT(imageInfo != nullptr);
     }
@@ -3287,7 +3776,12 @@ void Control::AlphaPaint(IRender* pRender, const UiRect& rcPaint)
     }
 
     UiRect rcTemp; //本控件范围内的脏区域，本次需要绘制的区域
-    if (!UiRect::Intersect(rcTemp, rcPaint, GetBoxShadowExpandedRect(GetRect()))) {//如果包含box-shadow的区域内为脏区域，就需要进行绘制
+    const UiRect rcShadowExpanded = GetBoxShadowExpandedRect(GetRect());
+    if (!UiRect::Intersect(rcTemp, rcPaint, rcShadowExpanded)) {//如果包含box-shadow的区域内为脏区域，就需要进行绘制
+        return;
+    }
+    if ((GetWindow() != nullptr) && !GetWindow()->IsRectNeedPaint(pRender, rcShadowExpanded)) {
+        //多区域绘制时，本控件与所有脏区域均不相交（只在脏区域的外接矩形内），不需要绘制
         return;
     }
     UiRect::Intersect(m_rcPaint, rcPaint, GetRect()); //设置m_rcPaint的值
@@ -3326,8 +3820,15 @@ void Control::AlphaPaint(IRender* pRender, const UiRect& rcPaint)
                 return;
             }
         }
+
+        //开启保留图层功能时，如果图层内容有效，不需要重新绘制控件及子控件
+        bool bLayerValid = false;
+        if (m_bRetainedLayer && (GetWindow() != nullptr)) {
+            const UiSize layerSize(pTempRender->GetWidth(), pTempRender->GetHeight());
+            bLayerValid = GetWindow()->GetLayerCache().AcquireLayer(this, layerSize);
+        }
         
-        if ((pTempRender->GetWidth() > 0) && (pTempRender->GetHeight() > 0)) {
+        if (!bLayerValid && (pTempRender->GetWidth() > 0) && (pTempRender->GetHeight() > 0)) {
             // 将控件（如果是容器，则包含子控件），完整绘制到缓存新的render中
             // 绘制前，首先清除原内容
             pTempRender->Clear(UiColor());
@@ -3476,7 +3977,7 @@ void Control::PaintBkColor(IRender* pRender)
         return;
     }
 
-    UiColor dwBackColor = GetUiColor(m_pColorData->m_strBkColor.c_str());
+    UiColor dwBackColor = m_pColorData->m_strBkColor.GetColor(this);
     if(dwBackColor.GetARGB() != 0) {
         int32_t nBorderSize = 0;
         if ((m_pBorderData != nullptr) && (m_pBorderData->m_rcBorderSize.left > 0.001f) &&
@@ -3505,7 +4006,7 @@ void Control::PaintBkColor(IRender* pRender)
         else {            
             UiColor dwBackColor2;
             if ((m_pColorData != nullptr) && !m_pColorData->m_strBkColor2.empty()) {
-                dwBackColor2 = GetUiColor(m_pColorData->m_strBkColor2.c_str());
+                dwBackColor2 = m_pColorData->m_strBkColor2.GetColor(this);
             }
             if (!dwBackColor2.IsEmpty()) {
                 //渐变背景色
@@ -3532,7 +4033,7 @@ void Control::PaintForeColor(IRender* pRender)
         return;
     }
 
-    UiColor dwForeColor = GetUiColor(m_pColorData->m_strForeColor.c_str());
+    UiColor dwForeColor = m_pColorData->m_strForeColor.GetColor(this);
     if (dwForeColor.GetARGB() != 0) {
         int32_t nBorderSize = 0;
         if ((m_pBorderData != nullptr) && (m_pBorderData->m_rcBorderSize.left > 0.001f) &&
@@ -3571,17 +4072,14 @@ void Control::PaintBorder(IRender* pRender)
         return;
     }
     UiColor dwBorderColor;
-    DString borderColor;
-    if (IsFocused()) {
-        if (borderColor.empty()) {
-            borderColor = GetFocusBorderColor();
+    if (m_pBorderData != nullptr) {
+        if (IsFocused() && !m_pBorderData->m_focusBorderColor.empty()) {
+            dwBorderColor = m_pBorderData->m_focusBorderColor.GetColor(this);
+        }
+        else if (m_pBorderData->m_pBorderColorMap != nullptr) {
+            //各个状态的边框颜色都是预先解析的颜色值，子类通过GetPaintBorderColorState选择使用哪个状态的颜色
+            dwBorderColor = m_pBorderData->m_pBorderColorMap->GetStateUiColor(GetPaintBorderColorState(GetState()));
         }
-    }
-    if (borderColor.empty()) {
-        borderColor = GetBorderColor(GetState());
-    }
-    if (!borderColor.empty()) {
-        dwBorderColor = GetUiColor(borderColor);
     }
     if (dwBorderColor.GetARGB() == 0) {
         return;
@@ -3780,9 +4278,8 @@ void Control::DoPaintFocusRect(IRender* pRender)
     }
     float fWidth =  Dpi().GetScaleFloat(1.0f); //画笔宽度
     UiColor dwBorderColor;//画笔颜色
-    DString focusRectColor = GetFocusRectColor();
-    if (!focusRectColor.empty()) {
-        dwBorderColor = GetUiColor(focusRectColor);
+    if ((m_pColorData != nullptr) && !m_pColorData->m_focusRectColor.empty()) {
+        dwBorderColor = m_pColorData->m_focusRectColor.GetColor(this);
     }
     if(dwBorderColor.IsEmpty()) {
         dwBorderColor = UiColor(UiColors::Gray);
@@ -3893,7 +4390,7 @@ void Control::FillRoundRect(IRender* pRender, const UiRect& rc, float rx, float
     }
     UiColor dwBackColor2;
     if ((m_pColorData != nullptr) && !m_pColorData->m_strBkColor2.empty()) {
-        dwBackColor2 = GetUiColor(m_pColorData->m_strBkColor2.c_str());
+        dwBackColor2 = m_pColorData->m_strBkColor2.GetColor(this);
     }
     if (!dwBackColor2.IsEmpty()) {
         //渐变背景色
@@ -3957,10 +4454,44 @@ void Control::SetAlpha(int64_t alpha)
     ASSERT(alpha >= 0 && alpha <= 255);
     if (m_nAlpha != (uint8_t)alpha) {
         m_nAlpha = (uint8_t)alpha;
+        Window* pWindow = GetWindow();
+        if (m_bRetainedLayer && (pWindow != nullptr)) {
+            //只有透明度变化，控件自身的图层内容不变，只需要重新AlphaBlend（父控件的图层需要重新绘制）
+            pWindow->GetLayerCache().SetKeepLayer(this);
+            Invalidate();
+            pWindow->GetLayerCache().SetKeepLayer(nullptr);
+        }
+        else {
+            Invalidate();
+        }
+    }
+}
+
+void Control::SetRetainedLayer(bool bRetainedLayer)
+{
+    if (m_bRetainedLayer != bRetainedLayer) {
+        m_bRetainedLayer = bRetainedLayer;
+        if (!bRetainedLayer) {
+            ReleaseLayer();
+        }
         Invalidate();
     }
 }
 
+bool Control::IsRetainedLayer() const
+{
+    return m_bRetainedLayer;
+}
+
+void Control::ReleaseLayer()
+{
+    Window* pWindow = GetWindow();
+    if (pWindow != nullptr) {
+        pWindow->GetLayerCache().RemoveLayer(this);
+    }
+    m_pTempRender.reset();
+}
+
 void Control::SetHotAlpha(int64_t nHotAlpha)
 {
     ASSERT(nHotAlpha >= 0 && nHotAlpha <= 255);
@@ -4207,7 +4738,8 @@ void Control::AsyncDecodeImageData(std::shared_ptr<TAsyncImageDecode> pAsyncDeco
         threadIdentifiers.push_back(ui::kThreadWorker);
     }
     else {
-        //单帧图片
+        //单帧图片（优先使用线程池，多个图片可并行解码）
+        threadIdentifiers.push_back(ui::kThreadPool);
         threadIdentifiers.push_back(ui::kThreadImage1);
         threadIdentifiers.push_back(ui::kThreadImage2);
         threadIdentifiers.push_back(ui::kThreadWorker);
@@ -4460,8 +4992,17 @@ bool Control::LoadImageInfo(Image& duiImage, bool bPaintImage) const
             imageLoadParam.SetMaxDestRectSize(UiSize(GetRect().Width(), GetRect().Height()));
         }
 
+        ImageManager& imageManager = GlobalManager::Instance().Image();
+        if (bPaintImage && duiImage.GetImageAttribute().m_bAsyncLoad &&
+            imageManager.LoadImageAsync(imageLoadParam, const_cast<Control*>(this), &duiImage)) {
+            //绘制阶段加载的图片：在子线程中读取并解码，加载完成后重绘该图片
+            duiImage.SetImageLoading(true);
+            return false;
+        }
+        duiImage.SetImageLoading(false);
+
         bool bImageDataFromCache = false;
-        imageInfo = GlobalManager::Instance().Image().GetImage(imageLoadParam, bImageDataFromCache);
+        imageInfo = imageManager.GetImage(imageLoadParam, bImageDataFromCache);
         duiImage.SetImageInfo(imageInfo);
         if (imageInfo != nullptr) {
             //检查并启动多线程解码，在子线程中解码图片数据
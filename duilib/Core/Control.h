@@ -5,6 +5,7 @@
 #include "duilib/Core/BoxShadow.h"
 #include "duilib/Core/Keyboard.h"
 #include "duilib/Core/EventArgs.h"
+#include "duilib/Core/UiNamedColor.h"
 
 namespace ui 
 {
@@ -42,6 +43,10 @@ public:
     */
     virtual DString GetType() const override;
 
+    /** 设置关联的窗口
+    */
+    virtual void SetWindow(Window* pWindow) override;
+
     /// 图形相关
     /** 获取背景颜色
      * @return 返回背景颜色的字符串，该值在 global.xml 中定义
@@ -672,6 +677,21 @@ public:
      */
     bool IsAlpha() const { return m_nAlpha != 255; }
 
+    /** 设置是否开启保留图层功能（仅当设置了透明度时生效）
+    *   开启后，控件（包含子控件）绘制到离屏图层中，只要控件范围内没有重绘请求，图层的内容就一直有效，
+    *   透明度变化时（比如渐变动画）不再重新绘制控件及子控件，只需要将图层AlphaBlend到窗口上
+    * @param [in] bRetainedLayer true表示开启，false表示关闭
+    */
+    void SetRetainedLayer(bool bRetainedLayer);
+
+    /** 是否开启了保留图层功能
+    */
+    bool IsRetainedLayer() const;
+
+    /** 释放控件的图层（由窗口的图层缓存管理调用，图层缓存超出内存预算时释放）
+    */
+    void ReleaseLayer();
+
     /**
      * @brief 设置焦点状态透明度
      * @param[in] alpha 0 ~ 255 的透明度值，255 为不透明
@@ -1332,6 +1352,17 @@ protected:
     virtual void PaintFocusRect(IRender* pRender);      //绘制焦点状态下的虚框
     virtual void PaintLoading(IRender* pRender, const UiRect& rcPaint);//绘制控件loading状态
 
+    /** 获取实际使用哪个状态的边框颜色（子类可重写，比如选择状态的CheckBox使用按下状态的边框颜色）
+    *   绘制边框时按返回的状态，使用预先解析的边框颜色值，不需要每次绘制时获取颜色名称
+    * @param [in] stateType 控件状态
+    */
+    virtual ControlStateType GetPaintBorderColorState(ControlStateType stateType) const;
+
+    /** 是否设置了指定状态下的边框颜色
+    * @param [in] stateType 控件状态
+    */
+    bool HasBorderColor(ControlStateType stateType) const;
+
 protected:
     /** 是否状态图片, 只要含有任意状态图片，即返回true
     */
@@ -1656,7 +1687,7 @@ private:
         std::unique_ptr<StateColorMap> m_pBorderColorMap;
 
         //焦点状态下的边框颜色
-        UiString m_focusBorderColor;
+        UiNamedColor m_focusBorderColor;
 
         /** 边框圆角大小(与m_rcBorderSize联合应用)或者阴影的圆角大小(与m_boxShadow联合应用)
             仅当 m_rcBorderSize 四个边框值都有效, 并且都相同时
@@ -1669,19 +1700,19 @@ private:
     struct TColorData
     {
         //控件的背景颜色
-        UiString m_strBkColor;
+        UiNamedColor m_strBkColor;
 
         //控件的第二背景色(实现渐变背景色)
-        UiString m_strBkColor2;
+        UiNamedColor m_strBkColor2;
 
         //控件的第二背景色方向：："1": 左->右，"2": 上->下，"3": 左上->右下，"4": 右上->左下
         int8_t m_nBkColor2Direction = 1;
 
         //控件的前景颜色
-        UiString m_strForeColor;
+        UiNamedColor m_strForeColor;
 
         //焦点状态虚线矩形的颜色
-        UiString m_focusRectColor;
+        UiNamedColor m_focusRectColor;
     };
 
     //拖放相关数据
@@ -1832,6 +1863,9 @@ private:
 
     //是否处于MouseEnter状态（用于触发事件的标志）
     bool m_bMouseEnter;
+
+    //是否开启保留图层功能（设置透明度时，缓存的图层内容在控件重绘前一直有效）
+    bool m_bRetainedLayer;
 };
 
 } // namespace ui
@@ -0,0 +1,171 @@
+#include "ControlLayerCache.h"
+#include "duilib/Core/Control.h"
+
+namespace ui
+{
+
+ControlLayerCache::ControlLayerCache():
+    m_nMaxBytes(128 * 1024 * 1024),
+    m_nTotalBytes(0),
+    m_pKeepControl(nullptr),
+    m_nHitCount(0),
+    m_nMissCount(0),
+    m_nEvictCount(0)
+{
+}
+
+ControlLayerCache::~ControlLayerCache()
+{
+}
+
+void ControlLayerCache::SetMemoryBudget(size_t nMaxBytes)
+{
+    m_nMaxBytes = nMaxBytes;
+    EvictLayers(nullptr);
+}
+
+size_t ControlLayerCache::GetMemoryBudget() const
+{
+    return m_nMaxBytes;
+}
+
+size_t ControlLayerCache::GetLayerBytes(const UiSize& layerSize)
+{
+    if ((layerSize.cx <= 0) || (layerSize.cy <= 0)) {
+        return 0;
+    }
+    return (size_t)layerSize.cx * (size_t)layerSize.cy * sizeof(uint32_t);
+}
+
+bool ControlLayerCache::AcquireLayer(Control* pControl, const UiSize& layerSize)
+{
+    ASSERT(pControl != nullptr);
+    if (pControl == nullptr) {
+        return false;
+    }
+    bool bLayerValid = false;
+    auto iter = m_layerMap.find(pControl);
+    if (iter != m_layerMap.end()) {
+        LayerList::iterator itLayer = iter->second;
+        bLayerValid = !itLayer->m_bDirty && (itLayer->m_layerSize == layerSize);
+        m_nTotalBytes -= itLayer->m_nBytes;
+        itLayer->m_layerSize = layerSize;
+        itLayer->m_nBytes = GetLayerBytes(layerSize);
+        itLayer->m_bDirty = false;
+        m_nTotalBytes += itLayer->m_nBytes;
+        //移动到表头（最近使用）
+        m_layerList.splice(m_layerList.begin(), m_layerList, itLayer);
+    }
+    else {
+        LayerItem item;
+        item.m_pControl = pControl;
+        item.m_layerSize = layerSize;
+        item.m_nBytes = GetLayerBytes(layerSize);
+        item.m_bDirty = false;
+        m_layerList.push_front(item);
+        m_layerMap[pControl] = m_layerList.begin();
+        m_nTotalBytes += item.m_nBytes;
+    }
+    if (bLayerValid) {
+        ++m_nHitCount;
+    }
+    else {
+        ++m_nMissCount;
+    }
+    EvictLayers(pControl);
+    return bLayerValid;
+}
+
+void ControlLayerCache::RemoveLayer(const Control* pControl)
+{
+    auto iter = m_layerMap.find(pControl);
+    if (iter != m_layerMap.end()) {
+        m_nTotalBytes -= iter->second->m_nBytes;
+        m_layerList.erase(iter->second);
+        m_layerMap.erase(iter);
+    }
+    if (m_pKeepControl == pControl) {
+        m_pKeepControl = nullptr;
+    }
+}
+
+void ControlLayerCache::InvalidateRect(const UiRect& rcItem)
+{
+    for (LayerItem& item : m_layerList) {
+        if (item.m_bDirty || (item.m_pControl == m_pKeepControl)) {
+            continue;
+        }
+        //图层的范围，转换为客户区坐标
+        UiRect rcLayer = item.m_pControl->GetRect();
+        UiPoint scrollBoxOffset = item.m_pControl->GetScrollOffsetInScrollBox();
+        rcLayer.Offset(-scrollBoxOffset.x, -scrollBoxOffset.y);
+        UiRect rcTemp;
+        if (UiRect::Intersect(rcTemp, rcLayer, rcItem)) {
+            item.m_bDirty = true;
+        }
+    }
+}
+
+void ControlLayerCache::InvalidateAll()
+{
+    for (LayerItem& item : m_layerList) {
+        item.m_bDirty = true;
+    }
+}
+
+void ControlLayerCache::SetKeepLayer(const Control* pControl)
+{
+    m_pKeepControl = pControl;
+}
+
+void ControlLayerCache::Clear()
+{
+    m_layerList.clear();
+    m_layerMap.clear();
+    m_nTotalBytes = 0;
+    m_pKeepControl = nullptr;
+}
+
+bool ControlLayerCache::IsEmpty() const
+{
+    return m_layerList.empty();
+}
+
+ControlLayerCacheStat ControlLayerCache::GetStat() const
+{
+    ControlLayerCacheStat stat;
+    stat.m_nHitCount = m_nHitCount;
+    stat.m_nMissCount = m_nMissCount;
+    stat.m_nEvictCount = m_nEvictCount;
+    stat.m_nLayerCount = m_layerList.size();
+    stat.m_nTotalBytes = m_nTotalBytes;
+    return stat;
+}
+
+void ControlLayerCache::ResetStat()
+{
+    m_nHitCount = 0;
+    m_nMissCount = 0;
+    m_nEvictCount = 0;
+}
+
+void ControlLayerCache::EvictLayers(const Control* pExcludeControl)
+{
+    //从表尾（最久未使用）开始释放
+    auto iter = m_layerList.end();
+    while ((m_nTotalBytes > m_nMaxBytes) && (iter != m_layerList.begin())) {
+        --iter;
+        if (iter->m_pControl == pExcludeControl) {
+            continue;
+        }
+        Control* pControl = iter->m_pControl;
+        m_nTotalBytes -= iter->m_nBytes;
+        m_layerMap.erase(pControl);
+        iter = m_layerList.erase(iter);
+        ++m_nEvictCount;
+        //先删除记录，再释放控件的图层
+        pControl->ReleaseLayer();
+    }
+}
+
+} // namespace ui
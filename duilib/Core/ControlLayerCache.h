@@ -0,0 +1,154 @@
+#ifndef UI_CORE_CONTROL_LAYER_CACHE_H_
+#define UI_CORE_CONTROL_LAYER_CACHE_H_
+
+#include "duilib/Core/UiRect.h"
+#include "duilib/Core/UiSize.h"
+#include <list>
+#include <unordered_map>
+
+namespace ui
+{
+class Control;
+
+/** 图层缓存的统计数据
+*/
+struct ControlLayerCacheStat
+{
+    //命中次数（缓存的图层内容有效，只需要AlphaBlend）
+    size_t m_nHitCount = 0;
+
+    //未命中次数（需要重新绘制图层内容）
+    size_t m_nMissCount = 0;
+
+    //因超出内存预算而被淘汰的图层个数
+    size_t m_nEvictCount = 0;
+
+    //当前缓存的图层个数
+    size_t m_nLayerCount = 0;
+
+    //当前缓存的图层占用的内存（字节）
+    size_t m_nTotalBytes = 0;
+};
+
+/** 窗口内设置了透明度的控件的保留图层（retained layer）缓存管理
+*   控件设置了透明度且开启了保留图层功能时，控件（包含子控件）绘制到离屏的图层中，
+*   只要控件范围内没有重绘请求，图层的内容就一直有效，透明度变化时（比如渐变动画）只需要AlphaBlend一次；
+*   所有图层按最近使用顺序（LRU）管理，总内存超出预算时，释放最久未使用的图层
+*/
+class UILIB_API ControlLayerCache
+{
+public:
+    ControlLayerCache();
+    ~ControlLayerCache();
+    ControlLayerCache(const ControlLayerCache&) = delete;
+    ControlLayerCache& operator = (const ControlLayerCache&) = delete;
+
+public:
+    /** 设置图层缓存的内存预算（字节）
+    */
+    void SetMemoryBudget(size_t nMaxBytes);
+
+    /** 获取图层缓存的内存预算（字节）
+    */
+    size_t GetMemoryBudget() const;
+
+    /** 控件绘制图层前调用：记录图层的使用，并判断缓存的图层内容是否可以直接使用
+    * @param [in] pControl 控件接口
+    * @param [in] layerSize 图层的大小
+    * @return 返回true表示图层内容有效，可直接使用；返回false表示需要重新绘制图层内容（同时将图层标记为有效）
+    */
+    bool AcquireLayer(Control* pControl, const UiSize& layerSize);
+
+    /** 从缓存中删除控件的图层记录（不释放控件的图层）
+    */
+    void RemoveLayer(const Control* pControl);
+
+    /** 窗口的重绘请求：与该区域相交的图层，标记为需要重新绘制
+    * @param [in] rcItem 重绘范围，为客户区坐标
+    */
+    void InvalidateRect(const UiRect& rcItem);
+
+    /** 所有图层标记为需要重新绘制
+    */
+    void InvalidateAll();
+
+    /** 设置重绘时保持图层内容有效的控件（控件只有透明度变化时，其自身的图层内容不变）
+    * @param [in] pControl 控件接口，为nullptr时表示取消设置
+    */
+    void SetKeepLayer(const Control* pControl);
+
+    /** 清空所有图层记录（不释放控件的图层）
+    */
+    void Clear();
+
+    /** 是否没有缓存的图层
+    */
+    bool IsEmpty() const;
+
+    /** 获取统计数据
+    */
+    ControlLayerCacheStat GetStat() const;
+
+    /** 重置命中、未命中、淘汰计数
+    */
+    void ResetStat();
+
+private:
+    /** 超出内存预算时，释放最久未使用的图层
+    * @param [in] pExcludeControl 不释放该控件的图层（当前正在使用的图层）
+    */
+    void EvictLayers(const Control* pExcludeControl);
+
+    /** 计算图层占用的内存（字节）
+    */
+    static size_t GetLayerBytes(const UiSize& layerSize);
+
+private:
+    /** 图层记录
+    */
+    struct LayerItem
+    {
+        //图层所属的控件
+        Control* m_pControl;
+
+        //图层的大小
+        UiSize m_layerSize;
+
+        //图层占用的内存（字节）
+        size_t m_nBytes;
+
+        //图层内容是否需要重新绘制
+        bool m_bDirty;
+    };
+    typedef std::list<LayerItem> LayerList;
+
+    /** 图层列表，按最近使用顺序排列（表头为最近使用的图层）
+    */
+    LayerList m_layerList;
+
+    /** 控件与图层的映射表
+    */
+    std::unordered_map<const Control*, LayerList::iterator> m_layerMap;
+
+    /** 内存预算（字节）
+    */
+    size_t m_nMaxBytes;
+
+    /** 当前缓存的图层占用的内存（字节）
+    */
+    size_t m_nTotalBytes;
+
+    /** 重绘时保持图层内容有效的控件
+    */
+    const Control* m_pKeepControl;
+
+    /** 统计数据
+    */
+    size_t m_nHitCount;
+    size_t m_nMissCount;
+    size_t m_nEvictCount;
+};
+
+} // namespace ui
+
+#endif // UI_CORE_CONTROL_LAYER_CACHE_H_
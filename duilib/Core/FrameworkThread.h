@@ -25,6 +25,7 @@ enum ThreadIdentifier
     kThreadNetwork  = 2,    //工作线程(内部使用，用该线程处理网络相关的业务)
     kThreadImage1   = 3,    //工作线程(内部使用，用该线程处理图片解码等相关业务)
     kThreadImage2   = 4,    //工作线程(内部使用，用该线程处理图片解码等相关业务)
+    kThreadPool     = 5,    //工作线程池(内部使用，多个线程并行执行任务，用于图片解码、文件读取等可并行的业务)
 
     //以下为用户应用层自定义线程标识符
     kThreadUser     = 100   //用户自定义线程的起始标识号（低于此值的线程标识标识号内部使用）
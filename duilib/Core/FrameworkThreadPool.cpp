@@ -0,0 +1,251 @@
+#include "FrameworkThreadPool.h"
+#include "duilib/Core/GlobalManager.h"
+#include <algorithm>
+
+namespace ui
+{
+/** 当前线程所属的线程池，及其在线程池中的索引号（不是线程池的工作线程时为nullptr）
+*/
+static thread_local FrameworkThreadPool* t_pCurrentThreadPool = nullptr;
+static thread_local size_t t_nCurrentThreadIndex = 0;
+
+FrameworkThreadPool::FrameworkThreadPool(const DString& threadName, int32_t nThreadIdentifier, size_t nThreadCount):
+    m_threadName(threadName),
+    m_nThreadIdentifier(nThreadIdentifier),
+    m_nThreadCount(nThreadCount),
+    m_nPendingCount(0),
+    m_bRunning(false)
+{
+    if (m_nThreadCount == 0) {
+        m_nThreadCount = GetDefaultThreadCount();
+    }
+}
+
+FrameworkThreadPool::~FrameworkThreadPool()
+{
+    ASSERT(!m_bRunning);
+    if (m_bRunning) {
+        Stop();
+    }
+}
+
+size_t FrameworkThreadPool::GetDefaultThreadCount()
+{
+    //保留一个核给UI线程，最少2个工作线程
+    size_t nCoreCount = (size_t)std::thread::hardware_concurrency();
+    if (nCoreCount > 1) {
+        nCoreCount -= 1;
+    }
+    return (std::max)(nCoreCount, (size_t)2);
+}
+
+bool FrameworkThreadPool::Start()
+{
+    ASSERT(!m_bRunning);
+    if (m_bRunning) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> poolGuard(m_poolMutex);
+        m_bRunning = true;
+        m_nPendingCount = 0;
+        m_workerQueues.clear();
+        for (size_t nIndex = 0; nIndex < m_nThreadCount; ++nIndex) {
+            m_workerQueues.push_back(std::make_unique<TaskQueue>());
+        }
+        for (size_t nIndex = 0; nIndex < m_nThreadCount; ++nIndex) {
+            m_workerThreads.emplace_back(&FrameworkThreadPool::WorkerThreadProc, this, nIndex);
+        }
+    }
+    //注册到线程管理器（不能在持有m_poolMutex时注册，避免与线程管理器的锁形成死锁）
+    if (m_nThreadIdentifier != kThreadNone) {
+        GlobalManager::Instance().Thread().RegisterThreadPool(m_nThreadIdentifier, this);
+    }
+    return true;
+}
+
+bool FrameworkThreadPool::Stop()
+{
+    if (m_nThreadIdentifier != kThreadNone) {
+        GlobalManager::Instance().Thread().UnregisterThreadPool(m_nThreadIdentifier);
+    }
+    ASSERT(!IsPoolThread());
+    if (IsPoolThread()) {
+        //不能在工作线程中停止线程池
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> idleGuard(m_idleMutex);
+        if (!m_bRunning) {
+            return false;
+        }
+        m_bRunning = false;
+    }
+    m_idleCv.notify_all();
+    //等待工作线程退出（不持有m_poolMutex，正在执行的任务可以取消其他任务）
+    for (std::thread& workerThread : m_workerThreads) {
+        if (workerThread.joinable()) {
+            workerThread.join();
+        }
+    }
+    std::lock_guard<std::mutex> poolGuard(m_poolMutex);
+    m_workerThreads.clear();
+    m_workerQueues.clear();
+    {
+        std::lock_guard<std::mutex> taskGuard(m_sharedQueue.m_taskMutex);
+        m_sharedQueue.m_tasks.clear();
+    }
+    m_nPendingCount = 0;
+    return true;
+}
+
+bool FrameworkThreadPool::IsRunning() const
+{
+    return m_bRunning;
+}
+
+size_t FrameworkThreadPool::GetThreadCount() const
+{
+    return m_nThreadCount;
+}
+
+bool FrameworkThreadPool::IsPoolThread() const
+{
+    return t_pCurrentThreadPool == this;
+}
+
+int32_t FrameworkThreadPool::GetThreadIdentifier() const
+{
+    return m_nThreadIdentifier;
+}
+
+const DString& FrameworkThreadPool::GetThreadName() const
+{
+    return m_threadName;
+}
+
+size_t FrameworkThreadPool::PostTask(const StdClosure& task)
+{
+    ASSERT(task != nullptr);
+    if ((task == nullptr) || !m_bRunning) {
+        return 0;
+    }
+    TaskInfo taskInfo;
+    taskInfo.m_nTaskId = GlobalManager::Instance().Thread().GetNextTaskId();
+    taskInfo.m_task = task;
+    const size_t nTaskId = taskInfo.m_nTaskId;
+
+    //工作线程中添加的任务放入自己的队列，其他线程添加的任务放入共享队列
+    TaskQueue* pTaskQueue = &m_sharedQueue;
+    if (IsPoolThread() && (t_nCurrentThreadIndex < m_workerQueues.size())) {
+        pTaskQueue = m_workerQueues[t_nCurrentThreadIndex].get();
+    }
+    {
+        //在队列锁内先增加计数再放入任务，工作线程取出任务时计数已经包含该任务，不会减到0以下
+        std::lock_guard<std::mutex> taskGuard(pTaskQueue->m_taskMutex);
+        ++m_nPendingCount;
+        pTaskQueue->m_tasks.push_back(std::move(taskInfo));
+    }
+    {
+        //加锁后再通知，避免工作线程在检查等待条件之后、进入等待之前错过通知
+        std::lock_guard<std::mutex> idleGuard(m_idleMutex);
+    }
+    m_idleCv.notify_one();
+    return nTaskId;
+}
+
+bool FrameworkThreadPool::CancelTask(size_t nTaskId)
+{
+    if (nTaskId == 0) {
+        return false;
+    }
+    std::lock_guard<std::mutex> poolGuard(m_poolMutex);
+    bool bCancelTask = RemoveTask(m_sharedQueue, nTaskId);
+    for (size_t nIndex = 0; !bCancelTask && (nIndex < m_workerQueues.size()); ++nIndex) {
+        bCancelTask = RemoveTask(*m_workerQueues[nIndex], nTaskId);
+    }
+    return bCancelTask;
+}
+
+bool FrameworkThreadPool::RemoveTask(TaskQueue& taskQueue, size_t nTaskId)
+{
+    std::lock_guard<std::mutex> taskGuard(taskQueue.m_taskMutex);
+    for (auto iter = taskQueue.m_tasks.begin(); iter != taskQueue.m_tasks.end(); ++iter) {
+        if (iter->m_nTaskId == nTaskId) {
+            taskQueue.m_tasks.erase(iter);
+            --m_nPendingCount;
+            return true;
+        }
+    }
+    return false;
+}
+
+void FrameworkThreadPool::OnInit()
+{
+}
+
+void FrameworkThreadPool::OnCleanup()
+{
+}
+
+void FrameworkThreadPool::WorkerThreadProc(size_t nThreadIndex)
+{
+    t_pCurrentThreadPool = this;
+    t_nCurrentThreadIndex = nThreadIndex;
+    OnInit();
+    while (m_bRunning) {
+        TaskInfo taskInfo;
+        if (TakeTask(nThreadIndex, taskInfo)) {
+            if (taskInfo.m_task != nullptr) {
+                taskInfo.m_task();
+            }
+            continue;
+        }
+        std::unique_lock<std::mutex> idleGuard(m_idleMutex);
+        m_idleCv.wait(idleGuard, [this]() {
+                return !m_bRunning || (m_nPendingCount > 0);
+            });
+    }
+    OnCleanup();
+    t_pCurrentThreadPool = nullptr;
+}
+
+bool FrameworkThreadPool::TakeTask(size_t nThreadIndex, TaskInfo& taskInfo)
+{
+    //自己的队列：从尾部获取（后进先出，数据在缓存中的可能性更大）
+    TaskQueue& ownQueue = *m_workerQueues[nThreadIndex];
+    {
+        std::lock_guard<std::mutex> taskGuard(ownQueue.m_taskMutex);
+        if (!ownQueue.m_tasks.empty()) {
+            taskInfo = std::move(ownQueue.m_tasks.back());
+            ownQueue.m_tasks.pop_back();
+            --m_nPendingCount;
+            return true;
+        }
+    }
+    //共享队列：从头部获取（按添加顺序执行）
+    {
+        std::lock_guard<std::mutex> taskGuard(m_sharedQueue.m_taskMutex);
+        if (!m_sharedQueue.m_tasks.empty()) {
+            taskInfo = std::move(m_sharedQueue.m_tasks.front());
+            m_sharedQueue.m_tasks.pop_front();
+            --m_nPendingCount;
+            return true;
+        }
+    }
+    //从其他工作线程的队列头部窃取任务
+    const size_t nQueueCount = m_workerQueues.size();
+    for (size_t nOffset = 1; nOffset < nQueueCount; ++nOffset) {
+        TaskQueue& otherQueue = *m_workerQueues[(nThreadIndex + nOffset) % nQueueCount];
+        std::lock_guard<std::mutex> taskGuard(otherQueue.m_taskMutex);
+        if (!otherQueue.m_tasks.empty()) {
+            taskInfo = std::move(otherQueue.m_tasks.front());
+            otherQueue.m_tasks.pop_front();
+            --m_nPendingCount;
+            return true;
+        }
+    }
+    return false;
+}
+
+}//namespace ui
@@ -0,0 +1,163 @@
+#ifndef UI_CORE_FRAMEWORK_THREAD_POOL_H_
+#define UI_CORE_FRAMEWORK_THREAD_POOL_H_
+
+#include "duilib/Core/Callback.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <deque>
+
+namespace ui
+{
+/** 框架线程池（工作窃取模式）：多个工作线程并行执行任务，用于图片解码、文件读取等可以并行执行的业务
+*   1. 工作线程的个数默认按CPU核数确定；
+*   2. 从池外添加的任务放入共享队列，按添加顺序执行；工作线程中添加的任务放入该线程自己的队列，优先由该线程执行（后进先出）；
+*   3. 工作线程自己的队列和共享队列都为空时，从其他工作线程的队列头部窃取任务执行，避免部分线程繁忙、部分线程空闲；
+*   4. 注册到线程管理器后，可以通过线程标识ID向线程池发送任务（只支持立即执行的任务，不支持延迟执行和重复执行的任务）
+*/
+class UILIB_API FrameworkThreadPool
+{
+public:
+    /** 使用线程池名称和线程识别ID构造线程池对象
+    * @param [in] threadName 线程池名称
+    * @param [in] nThreadIdentifier 线程标识ID，跨线程通信时需要用到此值
+    * @param [in] nThreadCount 工作线程的个数，为0时按CPU核数确定
+    */
+    FrameworkThreadPool(const DString& threadName, int32_t nThreadIdentifier, size_t nThreadCount = 0);
+    virtual ~FrameworkThreadPool();
+    FrameworkThreadPool(const FrameworkThreadPool&) = delete;
+    FrameworkThreadPool& operator = (const FrameworkThreadPool&) = delete;
+
+public:
+    /** 启动线程池的工作线程
+    */
+    bool Start();
+
+    /** 停止线程池（丢弃等待执行的任务，等待正在执行的任务完成后返回）
+    */
+    bool Stop();
+
+    /** 是否正在运行中
+    */
+    bool IsRunning() const;
+
+    /** 获取工作线程的个数
+    */
+    size_t GetThreadCount() const;
+
+    /** 判断当前线程是否为该线程池的工作线程
+    */
+    bool IsPoolThread() const;
+
+    /** 获取线程标识符(线程池构造时初始化的值)
+    */
+    int32_t GetThreadIdentifier() const;
+
+    /** 返回线程池名称(线程池构造时初始化的值)
+    */
+    const DString& GetThreadName() const;
+
+    /** 获取默认的工作线程个数（按CPU核数确定）
+    */
+    static size_t GetDefaultThreadCount();
+
+public:
+    /** 向线程池发送一个任务，立即执行
+    * @param [in] task 任务回调函数
+    * @return 成功返回任务ID(大于0)，如果失败则返回0
+    */
+    size_t PostTask(const StdClosure& task);
+
+    /** 取消一个等待执行的任务（已经开始执行的任务不受影响）
+    * @param [in] nTaskId 任务ID，即PostTask函数的返回值
+    * @return 取消成功返回true，否则返回false
+    */
+    bool CancelTask(size_t nTaskId);
+
+protected:
+    /** 工作线程运行前初始化，在每个工作线程中调用
+    */
+    virtual void OnInit();
+
+    /** 工作线程退出时清理，在每个工作线程中调用
+    */
+    virtual void OnCleanup();
+
+private:
+    /** 任务信息
+    */
+    struct TaskInfo
+    {
+        size_t m_nTaskId = 0;   //任务ID
+        StdClosure m_task;      //任务回调函数
+    };
+
+    /** 任务队列
+    */
+    struct TaskQueue
+    {
+        std::deque<TaskInfo> m_tasks;   //等待执行的任务
+        std::mutex m_taskMutex;         //任务队列的多线程同步锁
+    };
+
+    /** 工作线程的线程函数
+    * @param [in] nThreadIndex 工作线程的索引号
+    */
+    void WorkerThreadProc(size_t nThreadIndex);
+
+    /** 获取一个任务：依次从自己的队列尾部、共享队列头部、其他工作线程的队列头部获取
+    */
+    bool TakeTask(size_t nThreadIndex, TaskInfo& taskInfo);
+
+    /** 从任务队列中删除指定ID的任务（删除成功时减少待执行任务的计数）
+    */
+    bool RemoveTask(TaskQueue& taskQueue, size_t nTaskId);
+
+private:
+    /** 线程池名称
+    */
+    DString m_threadName;
+
+    /** 线程标识ID，跨线程通信时需要用到此值
+    */
+    int32_t m_nThreadIdentifier;
+
+    /** 工作线程的个数
+    */
+    size_t m_nThreadCount;
+
+    /** 工作线程
+    */
+    std::vector<std::thread> m_workerThreads;
+
+    /** 每个工作线程自己的任务队列
+    */
+    std::vector<std::unique_ptr<TaskQueue>> m_workerQueues;
+
+    /** 共享的任务队列（从池外添加的任务）
+    */
+    TaskQueue m_sharedQueue;
+
+    /** 等待执行的任务个数
+    */
+    std::atomic<size_t> m_nPendingCount;
+
+    /** 是否正在运行中
+    */
+    std::atomic<bool> m_bRunning;
+
+    /** 空闲的工作线程等待任务的同步锁和事件通知机制
+    */
+    std::mutex m_idleMutex;
+    std::condition_variable m_idleCv;
+
+    /** 工作线程和任务队列列表的多线程同步锁（启动、停止线程池和取消任务时使用）
+    */
+    std::mutex m_poolMutex;
+};
+
+}
+#endif //UI_CORE_FRAMEWORK_THREAD_POOL_H_
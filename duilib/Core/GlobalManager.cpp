@@ -72,6 +72,37 @@ private:
     }
 };
 
+/** 库内部的工作线程池
+*/
+class UiWorkerThreadPool : public ui::FrameworkThreadPool
+{
+public:
+    UiWorkerThreadPool(const DString& threadName, int32_t nThreadIdentifier):
+        FrameworkThreadPool(threadName, nThreadIdentifier)
+    { }
+    virtual ~UiWorkerThreadPool() override {}
+
+private:
+    /** 工作线程运行前初始化，在每个工作线程中调用
+    */
+    virtual void OnInit() override
+    {
+#if defined (DUILIB_BUILD_FOR_WIN)
+        HRESULT hr = ::CoInitialize(nullptr);
+        ASSERT_UNUSED_VARIABLE((hr == S_OK) || (hr == S_FALSE));
+#endif
+    }
+
+    /** 工作线程退出时清理，在每个工作线程中调用
+    */
+    virtual void OnCleanup() override
+    {
+#if defined (DUILIB_BUILD_FOR_WIN)
+        ::CoUninitialize();
+#endif
+    }
+};
+
 GlobalManager::GlobalManager():
     m_platformData(nullptr),
     m_renderType(RenderType::kRenderType_Skia)
@@ -193,6 +224,7 @@ bool GlobalManager::Startup(const ResourceParam& resParam,
     StartInnerThread(ThreadIdentifier::kThreadWorker);
     StartInnerThread(ThreadIdentifier::kThreadImage1);
     StartInnerThread(ThreadIdentifier::kThreadImage2);
+    StartInnerThread(ThreadIdentifier::kThreadPool);
 
     //加载资源
     if (!ReloadResource(resParam, false)) {
@@ -211,8 +243,13 @@ void GlobalManager::Shutdown()
         }
     }
     m_threadList.clear();
+    if (m_pThreadPool != nullptr) {
+        m_pThreadPool->Stop();
+        m_pThreadPool.reset();
+    }
 
     m_threadManager.Clear();
+    m_frameClock.Clear();
     m_timerManager.Clear();
     m_colorManager.Clear();    
     m_fontManager.RemoveAllFonts();
@@ -253,13 +290,23 @@ bool GlobalManager::StopInnerThread(int32_t nThreadIdentifier)
     ASSERT((nThreadIdentifier == ui::kThreadWorker)  ||
            (nThreadIdentifier == ui::kThreadNetwork) ||
            (nThreadIdentifier == ui::kThreadImage1)  ||
-           (nThreadIdentifier == ui::kThreadImage2));
+           (nThreadIdentifier == ui::kThreadImage2)  ||
+           (nThreadIdentifier == ui::kThreadPool));
     if ((nThreadIdentifier != ui::kThreadWorker)  &&
         (nThreadIdentifier != ui::kThreadNetwork) &&
         (nThreadIdentifier != ui::kThreadImage1)  &&
-        (nThreadIdentifier != ui::kThreadImage2)) {
+        (nThreadIdentifier != ui::kThreadImage2)  &&
+        (nThreadIdentifier != ui::kThreadPool)) {
         return false;
     }
+    if (nThreadIdentifier == ui::kThreadPool) {
+        if (m_pThreadPool == nullptr) {
+            return false;
+        }
+        m_pThreadPool->Stop();
+        m_pThreadPool.reset();
+        return true;
+    }
     bool bRet = false;
     for (auto iter = m_threadList.begin(); iter != m_threadList.end(); ++iter) {
         auto pThread = *iter;
@@ -279,13 +326,22 @@ bool GlobalManager::StartInnerThread(int32_t nThreadIdentifier)
     ASSERT((nThreadIdentifier == ui::kThreadWorker)  ||
            (nThreadIdentifier == ui::kThreadNetwork) ||
            (nThreadIdentifier == ui::kThreadImage1)  ||
-           (nThreadIdentifier == ui::kThreadImage2));
+           (nThreadIdentifier == ui::kThreadImage2)  ||
+           (nThreadIdentifier == ui::kThreadPool));
     if ((nThreadIdentifier != ui::kThreadWorker)  &&
         (nThreadIdentifier != ui::kThreadNetwork) &&
         (nThreadIdentifier != ui::kThreadImage1)  &&
-        (nThreadIdentifier != ui::kThreadImage2)) {
+        (nThreadIdentifier != ui::kThreadImage2)  &&
+        (nThreadIdentifier != ui::kThreadPool)) {
         return false;
     }
+    if (nThreadIdentifier == ui::kThreadPool) {
+        if (m_pThreadPool == nullptr) {
+            m_pThreadPool = std::make_shared<UiWorkerThreadPool>(_T("WorkerPool"), ThreadIdentifier::kThreadPool);
+            m_pThreadPool->Start();
+        }
+        return true;
+    }
     bool bRet = false;
     for (auto iter = m_threadList.begin(); iter != m_threadList.end(); ++iter) {
         auto pThread = *iter;
@@ -847,6 +903,11 @@ TimerManager& GlobalManager::Timer()
     return m_timerManager;
 }
 
+AnimationFrameClock& GlobalManager::FrameClock()
+{
+    return m_frameClock;
+}
+
 ThreadManager& GlobalManager::Thread()
 {
     return m_threadManager;
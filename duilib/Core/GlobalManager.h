@@ -14,6 +14,7 @@
 #include "duilib/Core/CursorManager.h"
 #include "duilib/Core/IconManager.h"
 #include "duilib/Core/WindowManager.h"
+#include "duilib/Animation/AnimationFrameClock.h"
 #include "duilib/Image/ImageDecoderFactory.h"
 #include "duilib/Render/IRender.h"
 
@@ -158,11 +159,11 @@ public:
     void RemoveAllClasss();
 
 public:
-    /** 停止一个内部线程(内部默认启动kThreadWorker/kThreadImage1/kThreadImage2这3个线程，如果不需要可停止掉)
+    /** 停止一个内部线程(内部默认启动kThreadWorker/kThreadImage1/kThreadImage2这3个线程和kThreadPool线程池，如果不需要可停止掉)
     */
     bool StopInnerThread(int32_t nThreadIdentifier);
 
-    /** 启动一个内部线程（kThreadWorker/kThreadNetwork/kThreadImage1/kThreadImage2）
+    /** 启动一个内部线程（kThreadWorker/kThreadNetwork/kThreadImage1/kThreadImage2）或者线程池（kThreadPool）
     */
     bool StartInnerThread(int32_t nThreadIdentifier);
 
@@ -212,6 +213,10 @@ public:
     */
     TimerManager& Timer();
 
+    /** 获取动画的帧时钟
+    */
+    AnimationFrameClock& FrameClock();
+
     /** 获取线程管理器
     */
     ThreadManager& Thread();
@@ -471,6 +476,10 @@ private:
     */
     TimerManager m_timerManager;
 
+    /** 动画的帧时钟
+    */
+    AnimationFrameClock m_frameClock;
+
     /** 线程管理器
     */
     ThreadManager m_threadManager;
@@ -498,6 +507,10 @@ private:
     /** 库内部使用的线程池
     */
     std::vector <std::shared_ptr<FrameworkThread>> m_threadList;
+
+    /** 库内部使用的工作线程池（工作窃取模式，多个线程并行执行任务）
+    */
+    std::shared_ptr<FrameworkThreadPool> m_pThreadPool;
 };
 
 } // namespace ui
@@ -165,14 +165,16 @@ public:
     virtual LRESULT OnNativeShowWindowMsg(bool bShow, const NativeMsg& nativeMsg, bool& bHandled) = 0;
 
     /** 窗口绘制(SDL_EVENT_WINDOW_EXPOSED/WM_PAINT)
-    * @param [in] rcPaint 本次绘制，需要更新的矩形区域
+    * @param [in] rcPaint 本次绘制，需要更新的矩形区域（多区域绘制时为所有区域的外接矩形）
+    * @param [in] paintRects 本次绘制，需要更新的矩形区域列表（各个矩形之间互不相交），为空时表示更新整个rcPaint区域
     * @param [in] nativeMsg 从系统接收到的原始消息内容
     *             SDL实现：nativeMsg.uMsg值为SDL_EVENT_WINDOW_EXPOSED，nativeMsg.wParam的值为SDL_Window*指针
     *             Windows实现：nativeMsg.uMsg值为WM_PAINT，nativeMsg.wParam的值为窗口的HWND句柄
     * @param [out] bHandled 消息是否已经处理，返回 true 表明已经成功处理消息，不需要再传递给窗口过程；返回 false 表示将消息继续传递给窗口过程处理
     * @return 返回消息的处理结果，如果应用程序处理此消息，应返回零
     */    
-    virtual LRESULT OnNativePaintMsg(const UiRect& rcPaint, const NativeMsg& nativeMsg, bool& bHandled) = 0;
+    virtual LRESULT OnNativePaintMsg(const UiRect& rcPaint, const std::vector<UiRect>& paintRects,
+                                     const NativeMsg& nativeMsg, bool& bHandled) = 0;
 
     /** 窗口获得焦点(WM_SETFOCUS)
     * @param [in] pLostFocusWindow 已失去键盘焦点的窗口（可以为nullptr）
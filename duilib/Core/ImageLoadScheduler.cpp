@@ -0,0 +1,187 @@
+#include "ImageLoadScheduler.h"
+#include "duilib/Core/GlobalManager.h"
+
+namespace ui
+{
+
+ImageLoadScheduler::ImageLoadScheduler():
+    m_pTaskQueue(std::make_shared<TTaskQueue>())
+{
+}
+
+ImageLoadScheduler::~ImageLoadScheduler()
+{
+    Stop();
+}
+
+void ImageLoadScheduler::GetPumpThreads(std::vector<int32_t>& pumpThreads)
+{
+    //优先使用框架的线程池，泵任务的个数与线程池的工作线程个数相同；
+    //线程池未启动时，使用图片线程（每个线程一个泵任务）；图片线程也都未启动时，使用工作线程
+    pumpThreads.clear();
+    ThreadManager& threadManager = GlobalManager::Instance().Thread();
+    const size_t nPoolThreadCount = threadManager.GetThreadPoolThreadCount(ui::kThreadPool);
+    if (nPoolThreadCount > 0) {
+        pumpThreads.assign(nPoolThreadCount, ui::kThreadPool);
+        return;
+    }
+    const int32_t imageThreads[] = { ui::kThreadImage1, ui::kThreadImage2 };
+    for (int32_t nThread : imageThreads) {
+        if (threadManager.HasThread(nThread)) {
+            pumpThreads.push_back(nThread);
+        }
+    }
+    if (pumpThreads.empty() && threadManager.HasThread(ui::kThreadWorker)) {
+        pumpThreads.push_back(ui::kThreadWorker);
+    }
+}
+
+bool ImageLoadScheduler::HasWorkerThread()
+{
+    std::vector<int32_t> pumpThreads;
+    GetPumpThreads(pumpThreads);
+    return !pumpThreads.empty();
+}
+
+bool ImageLoadScheduler::AddTask(const DString& taskKey, const StdClosure& task)
+{
+    ASSERT(!taskKey.empty() && (task != nullptr));
+    if (taskKey.empty() || (task == nullptr)) {
+        return false;
+    }
+    std::vector<int32_t> pumpThreads;
+    GetPumpThreads(pumpThreads);
+
+    TTaskQueue& taskQueue = *m_pTaskQueue;
+    bool bNewTask = true;
+    size_t nPumpIndex = pumpThreads.size();
+    {
+        std::lock_guard<std::mutex> threadGuard(taskQueue.m_taskMutex);
+        if (RaiseTaskPriorityLocked(taskQueue, taskKey)) {
+            //任务已经存在：只提高优先级
+            bNewTask = false;
+        }
+        else {
+            const uint64_t nPriority = taskQueue.m_nNextPriority++;
+            TTask& newTask = taskQueue.m_tasks[nPriority];
+            newTask.m_taskKey = taskKey;
+            newTask.m_task = task;
+            taskQueue.m_taskPriorityMap[taskKey] = nPriority;
+
+            //在没有泵任务的线程中投递一个泵任务
+            if (taskQueue.m_activePumps.size() < pumpThreads.size()) {
+                taskQueue.m_activePumps.resize(pumpThreads.size(), false);
+            }
+            for (size_t nIndex = 0; nIndex < pumpThreads.size(); ++nIndex) {
+                if (!taskQueue.m_activePumps[nIndex]) {
+                    taskQueue.m_activePumps[nIndex] = true;
+                    nPumpIndex = nIndex;
+                    break;
+                }
+            }
+        }
+    }
+    if (nPumpIndex < pumpThreads.size()) {
+        PostPumpTask(m_pTaskQueue, nPumpIndex, pumpThreads[nPumpIndex]);
+    }
+    return bNewTask;
+}
+
+void ImageLoadScheduler::PostPumpTask(const std::shared_ptr<TTaskQueue>& pTaskQueue, size_t nPumpIndex, int32_t nThreadIdentifier)
+{
+    auto pumpTask = [pTaskQueue, nPumpIndex, nThreadIdentifier]() {
+            RunPumpTask(pTaskQueue, nPumpIndex, nThreadIdentifier);
+        };
+    if (GlobalManager::Instance().Thread().PostTask(nThreadIdentifier, pumpTask) == 0) {
+        //投递失败（线程已经退出）：任务保留在队列中，由其他泵任务或者下次添加任务时执行
+        std::lock_guard<std::mutex> threadGuard(pTaskQueue->m_taskMutex);
+        pTaskQueue->m_activePumps[nPumpIndex] = false;
+    }
+}
+
+void ImageLoadScheduler::RunPumpTask(const std::shared_ptr<TTaskQueue>& pTaskQueue, size_t nPumpIndex, int32_t nThreadIdentifier)
+{
+    TTaskQueue& taskQueue = *pTaskQueue;
+    StdClosure task;
+    {
+        std::lock_guard<std::mutex> threadGuard(taskQueue.m_taskMutex);
+        if (taskQueue.m_tasks.empty()) {
+            taskQueue.m_activePumps[nPumpIndex] = false;
+            return;
+        }
+        //优先级最高的任务（队尾）
+        auto iter = taskQueue.m_tasks.end();
+        --iter;
+        task = std::move(iter->second.m_task);
+        taskQueue.m_taskPriorityMap.erase(iter->second.m_taskKey);
+        taskQueue.m_tasks.erase(iter);
+    }
+    if (task != nullptr) {
+        task();
+    }
+    bool bHasTask = false;
+    {
+        std::lock_guard<std::mutex> threadGuard(taskQueue.m_taskMutex);
+        bHasTask = !taskQueue.m_tasks.empty();
+        if (!bHasTask) {
+            taskQueue.m_activePumps[nPumpIndex] = false;
+        }
+    }
+    if (bHasTask) {
+        //再次投递，让出线程给该线程（或者线程池）中的其他任务
+        PostPumpTask(pTaskQueue, nPumpIndex, nThreadIdentifier);
+    }
+}
+
+bool ImageLoadScheduler::RaiseTaskPriority(const DString& taskKey)
+{
+    std::lock_guard<std::mutex> threadGuard(m_pTaskQueue->m_taskMutex);
+    return RaiseTaskPriorityLocked(*m_pTaskQueue, taskKey);
+}
+
+bool ImageLoadScheduler::RaiseTaskPriorityLocked(TTaskQueue& taskQueue, const DString& taskKey)
+{
+    auto iter = taskQueue.m_taskPriorityMap.find(taskKey);
+    if (iter == taskQueue.m_taskPriorityMap.end()) {
+        return false;
+    }
+    auto iterTask = taskQueue.m_tasks.find(iter->second);
+    ASSERT(iterTask != taskQueue.m_tasks.end());
+    if (iterTask == taskQueue.m_tasks.end()) {
+        return false;
+    }
+    const uint64_t nPriority = taskQueue.m_nNextPriority++;
+    TTask task = std::move(iterTask->second);
+    taskQueue.m_tasks.erase(iterTask);
+    taskQueue.m_tasks[nPriority] = std::move(task);
+    iter->second = nPriority;
+    return true;
+}
+
+bool ImageLoadScheduler::RemoveTask(const DString& taskKey)
+{
+    std::lock_guard<std::mutex> threadGuard(m_pTaskQueue->m_taskMutex);
+    auto iter = m_pTaskQueue->m_taskPriorityMap.find(taskKey);
+    if (iter == m_pTaskQueue->m_taskPriorityMap.end()) {
+        return false;
+    }
+    m_pTaskQueue->m_tasks.erase(iter->second);
+    m_pTaskQueue->m_taskPriorityMap.erase(iter);
+    return true;
+}
+
+void ImageLoadScheduler::Stop()
+{
+    //已投递的泵任务发现队列为空后自行退出
+    std::lock_guard<std::mutex> threadGuard(m_pTaskQueue->m_taskMutex);
+    m_pTaskQueue->m_tasks.clear();
+    m_pTaskQueue->m_taskPriorityMap.clear();
+}
+
+size_t ImageLoadScheduler::GetPendingTaskCount() const
+{
+    std::lock_guard<std::mutex> threadGuard(m_pTaskQueue->m_taskMutex);
+    return m_pTaskQueue->m_tasks.size();
+}
+
+} // namespace ui
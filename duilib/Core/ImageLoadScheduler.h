@@ -0,0 +1,118 @@
+#ifndef UI_CORE_IMAGE_LOAD_SCHEDULER_H_
+#define UI_CORE_IMAGE_LOAD_SCHEDULER_H_
+
+#include "duilib/Core/Callback.h"
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include <memory>
+#include <mutex>
+
+namespace ui
+{
+
+/** 图片加载任务的调度器：按优先级排列等待执行的任务，在框架的线程池中执行图片文件的读取和解码
+*   1. 调度器不创建线程：有等待执行的任务时，向框架的线程池投递"泵"任务（最多与工作线程个数相同），
+*      线程池未启动时改为向图片线程投递（每个线程最多一个）；
+*      泵任务每次取出优先级最高的一个任务执行，队列不为空时再次投递自己，不长时间独占共享的线程；
+*   2. 同一个KEY的任务只保留一个，重复添加时只提高该任务的优先级；
+*   3. 最近添加（或者最近重复添加）的任务优先执行：绘制时请求加载的图片在可见区域内，滚动后新的可见图片优先加载；
+*   4. 停止时只清空等待执行的任务，不等待正在执行的任务完成（由任务自己检查取消标志），不阻塞调用线程
+*/
+class ImageLoadScheduler
+{
+public:
+    ImageLoadScheduler();
+    ~ImageLoadScheduler();
+    ImageLoadScheduler(const ImageLoadScheduler&) = delete;
+    ImageLoadScheduler& operator = (const ImageLoadScheduler&) = delete;
+
+public:
+    /** 添加一个任务（如果该KEY的任务已经在队列中等待执行，则提高该任务的优先级）
+    * @param [in] taskKey 任务的KEY
+    * @param [in] task 任务函数（在工作线程中执行）
+    * @return 返回true表示添加了新任务，返回false表示任务已经存在
+    */
+    bool AddTask(const DString& taskKey, const StdClosure& task);
+
+    /** 提高一个等待执行的任务的优先级（变为最优先执行的任务）
+    * @param [in] taskKey 任务的KEY
+    * @return 如果任务在队列中返回true，否则返回false（任务不存在或者已经开始执行）
+    */
+    bool RaiseTaskPriority(const DString& taskKey);
+
+    /** 删除一个等待执行的任务（已经开始执行的任务不受影响）
+    * @param [in] taskKey 任务的KEY
+    * @return 如果任务在队列中，删除后返回true，否则返回false
+    */
+    bool RemoveTask(const DString& taskKey);
+
+    /** 删除所有等待执行的任务（不等待正在执行的任务完成）
+    */
+    void Stop();
+
+    /** 获取等待执行的任务个数
+    */
+    size_t GetPendingTaskCount() const;
+
+    /** 是否有可以执行任务的工作线程（没有时添加的任务不会被执行，调用方需同步加载）
+    */
+    static bool HasWorkerThread();
+
+private:
+    /** 等待执行的任务
+    */
+    struct TTask
+    {
+        DString m_taskKey;      //任务的KEY
+        StdClosure m_task;      //任务函数
+    };
+
+    /** 任务队列（泵任务持有其智能指针，调度器销毁后，已投递的泵任务仍可安全退出）
+    */
+    struct TTaskQueue
+    {
+        //等待执行的任务（KEY为任务的优先级，值越大越优先执行）
+        std::map<uint64_t, TTask> m_tasks;
+
+        //任务的KEY与优先级的映射表
+        std::unordered_map<DString, uint64_t> m_taskPriorityMap;
+
+        //下一个任务的优先级
+        uint64_t m_nNextPriority = 1;
+
+        //已经投递了泵任务的线程（泵任务的序号，对应GetPumpThreads返回的线程）
+        std::vector<bool> m_activePumps;
+
+        //多线程同步锁
+        std::mutex m_taskMutex;
+    };
+
+    /** 提高任务的优先级（调用时需要已经加锁）
+    */
+    static bool RaiseTaskPriorityLocked(TTaskQueue& taskQueue, const DString& taskKey);
+
+    /** 获取执行泵任务的线程（每个元素对应一个泵任务，线程池有多个工作线程时，包含多个相同的线程池标识ID）
+    */
+    static void GetPumpThreads(std::vector<int32_t>& pumpThreads);
+
+    /** 投递一个泵任务
+    * @param [in] pTaskQueue 任务队列
+    * @param [in] nPumpIndex 泵任务的序号
+    * @param [in] nThreadIdentifier 执行泵任务的线程标识ID
+    */
+    static void PostPumpTask(const std::shared_ptr<TTaskQueue>& pTaskQueue, size_t nPumpIndex, int32_t nThreadIdentifier);
+
+    /** 泵任务：执行一个优先级最高的任务
+    */
+    static void RunPumpTask(const std::shared_ptr<TTaskQueue>& pTaskQueue, size_t nPumpIndex, int32_t nThreadIdentifier);
+
+private:
+    /** 任务队列
+    */
+    std::shared_ptr<TTaskQueue> m_pTaskQueue;
+};
+
+} // namespace ui
+
+#endif // UI_CORE_IMAGE_LOAD_SCHEDULER_H_
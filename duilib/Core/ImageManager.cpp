@@ -9,6 +9,8 @@
 #include "duilib/Utils/StringConvert.h"
 #include "duilib/Utils/FileUtil.h"
 #include "duilib/Utils/FilePathUtil.h"
+#include "duilib/Image/ImageUtil.h"
+#include <algorithm>
 
 #ifdef DUILIB_BUILD_FOR_WIN
     //#define OUTPUT_IMAGE_LOG 1
@@ -19,6 +21,8 @@ namespace ui
 ImageManager::ImageManager():
     m_bAutoMatchScaleImage(true),
     m_bImageAsyncLoad(true),
+    m_nImageCacheBudget(128 * 1024 * 1024),
+    m_nAnimationCacheBudget(64 * 1024 * 1024),
     m_releaseImageCallback(nullptr)
 {
 }
@@ -43,6 +47,74 @@ std::shared_ptr<ImageInfo> ImageManager::GetImage(const ImageLoadParam& loadPara
     }
 
     //重新加载资源
+    TImageDataLoadParam dataLoadParam;
+    PrepareImageDataLoad(loadParam, dataLoadParam);
+    const DString& imageKey = dataLoadParam.m_imageKey;
+    const float fImageSizeScale = dataLoadParam.m_fImageSizeScale;
+
+    std::shared_ptr<IImage> spImageData;
+    bool bAsyncLoaded = false;
+    auto iterAsyncLoaded = m_asyncLoadedImageMap.find(imageKey);
+    if (iterAsyncLoaded != m_asyncLoadedImageMap.end()) {
+        //子线程中异步加载完成的原图数据（如果已经被缓存淘汰，则重新加载）
+        const bool bLoadFailed = iterAsyncLoaded->second.m_bLoadFailed;
+        spImageData = iterAsyncLoaded->second.m_pImageData.lock();
+        m_asyncLoadedImageMap.erase(iterAsyncLoaded);
+        if (bLoadFailed) {
+            //异步加载失败
+            return nullptr;
+        }
+        if ((spImageData != nullptr) && !ImageUtil::IsSameImageScale(spImageData->GetImageSizeScale(), fImageSizeScale)) {
+            spImageData.reset();
+        }
+        else if (spImageData != nullptr) {
+            bAsyncLoaded = true;
+        }
+    }
+    if (spImageData == nullptr) {
+        //查询缓存，如果缓存存在，则可共享图片资源，无需重复加载
+        spImageData = FindImageData(imageKey, fImageSizeScale);
+    }
+    bImageDataFromCache = (spImageData != nullptr) && !bAsyncLoaded; //标记是否从缓存中获取的ImageData共享图片资源
+    if (bImageDataFromCache) {
+        ++m_cacheStatistics.m_nHitCount;
+    }
+    else if (!bAsyncLoaded) {
+        ++m_cacheStatistics.m_nMissCount;
+    }
+    if (spImageData == nullptr) {
+        //从内存数据加载图片
+        if (!ReadImageFileData(dataLoadParam)) {
+            //加载失败
+            return nullptr;
+        }
+        std::unique_ptr<IImage> pImageData = DecodeImageData(dataLoadParam.m_decodeParam);
+        if (pImageData == nullptr) {
+            //加载失败
+            return nullptr;
+        }
+        //赋值, 添加到容器(替换删除函数)
+        spImageData = AddImageData(imageKey, std::move(pImageData), fImageSizeScale);
+    }
+    if (spImageData != nullptr) {
+        std::shared_ptr<ImageInfo> imageInfo(new ImageInfo, &ImageManager::CallImageInfoDestroy);
+        imageInfo->SetImageKey(imageKey);
+        bool bRet = imageInfo->SetImageData(loadParam, spImageData, loadParam.IsImageDpiScaleEnabled(), dataLoadParam.m_nImageFileDpiScale);
+        ASSERT(bRet);
+        if (bRet) {
+            ASSERT(loadKey == imageInfo->GetLoadKey());
+            OnImageInfoCreate(imageInfo);
+
+            //原图被使用：从LRU队列中移出，直到不再使用
+            AcquireImageData(imageKey, spImageData);
+            return imageInfo;
+        }
+    }
+    return nullptr;
+}
+
+void ImageManager::PrepareImageDataLoad(const ImageLoadParam& loadParam, TImageDataLoadParam& dataLoadParam) const
+{
     const ImageLoadPath& imageLoadPath = loadParam.GetImageLoadPath();
     DString imageFullPath = imageLoadPath.m_imageFullPath.ToString();   //图片的路径（本地路径或者压缩包内相对路径）
     uint32_t nImageFileDpiScale = 100;                                  //原始图片，未经DPI缩放时，DPI缩放比例是100
@@ -76,9 +148,30 @@ std::shared_ptr<ImageInfo> ImageManager::GetImage(const ImageLoadParam& loadPara
         fImageSizeScale = static_cast<float>(loadParam.GetLoadDpiScale()) / static_cast<float>(nImageFileDpiScale);
     }
 
+    dataLoadParam.m_imageKey = imageFullPath;
+    dataLoadParam.m_nImageFileDpiScale = nImageFileDpiScale;
+    dataLoadParam.m_fImageSizeScale = fImageSizeScale;
+    dataLoadParam.m_pathType = imageLoadPath.m_pathType;
+
+    ImageDecodeParam& decodeParam = dataLoadParam.m_decodeParam;
+    decodeParam.m_imageFilePath = imageFullPath;//前面的流程，当是本地文件时，已经确保文件存在
+    if (nImageFileDpiScale == 100) {//针对DPI自适应的原图，不开启该项优化，避免计算原图大小时出现异常
+        decodeParam.m_rcMaxDestRectSize = loadParam.GetMaxDestRectSize();
+    }
+    decodeParam.m_fImageSizeScale = fImageSizeScale;
+
+    decodeParam.m_bAsyncDecode = loadParam.IsAsyncDecodeEnabled();    //是否支持多线程图片解码 
+    decodeParam.m_bIconAsAnimation = loadParam.IsIconAsAnimation();   //ICO格式相关参数
+    decodeParam.m_nIconSize = loadParam.GetIconSize();                //ICO格式相关参数
+    decodeParam.m_nIconFrameDelayMs = loadParam.GetIconFrameDelayMs();//ICO格式相关参数
+    decodeParam.m_fPagMaxFrameRate = loadParam.GetPagMaxFrameRate();  //PAG格式相关参数
+    decodeParam.m_bLoadAllFrames = true; //所有多帧图片相关参数
+    decodeParam.m_bAssertEnabled = loadParam.IsAssertEnabled();       //加载图片失败时是否允许断言（一般只影响图片数据错误导致的问题）
+}
+
+std::shared_ptr<IImage> ImageManager::FindImageData(const DString& imageKey, float fImageSizeScale)
+{
     std::shared_ptr<IImage> spImageData;
-    //查询缓存，如果缓存存在，则可共享图片资源，无需重复加载
-    const DString imageKey = imageFullPath;
     auto iterImageData = m_imageDataMap.find(imageKey);
     if (iterImageData != m_imageDataMap.end()) {
         spImageData = iterImageData->second.m_pImage.lock();
@@ -89,144 +182,292 @@ std::shared_ptr<ImageInfo> ImageManager::GetImage(const ImageLoadParam& loadPara
         if (spImageData != nullptr) {
             if (!ImageUtil::IsSameImageScale(iterImageData->second.m_fImageSizeScale, fImageSizeScale)) {
                 //在动态切换DPI后，比例会发生变化，需要重新加载，不可共享原来加载的图片
-                m_imageDataMap.erase(iterImageData);
+                RemoveCachedImageData(imageKey);
+                m_imageDataMap.erase(imageKey);
                 spImageData.reset();
             }
         }
     }
-    bImageDataFromCache = spImageData != nullptr ? true : false; //标记是否从缓存中获取的ImageData共享图片资源
-    if (spImageData == nullptr) {
-        //从内存数据加载图片
-        ImageDecoderFactory& ImageDecoders = GlobalManager::Instance().ImageDecoders();
-        std::vector<uint8_t> fileData;
-        std::vector<uint8_t> fileHeaderData;
-        if (imageLoadPath.m_pathType != ImageLoadPathType::kVirtualPath) {
-            //实体图片文件，必须有图片数据用于解码图片
-            FilePath imageFilePath(imageFullPath);
-            if (isUseZip && !imageFilePath.IsAbsolutePath()) {
-                GlobalManager::Instance().Zip().GetZipData(imageFilePath, fileData);
-                ASSERT(!fileData.empty());
-                if (fileData.empty()) {
-                    //加载失败
-                    return nullptr;
-                }
+    return spImageData;
+}
+
+bool ImageManager::ReadImageFileData(TImageDataLoadParam& dataLoadParam)
+{
+    if (dataLoadParam.m_pathType == ImageLoadPathType::kVirtualPath) {
+        //虚拟路径（ICON图标数据），没有图片文件
+        return true;
+    }
+    ImageDecodeParam& decodeParam = dataLoadParam.m_decodeParam;
+    //实体图片文件，必须有图片数据用于解码图片
+    const FilePath& imageFilePath = decodeParam.m_imageFilePath;
+    std::vector<uint8_t> fileData;
+    std::vector<uint8_t> fileHeaderData;
+    const bool isUseZip = GlobalManager::Instance().Zip().IsUseZip();
+    if (isUseZip && !imageFilePath.IsAbsolutePath()) {
+        ZipManager& zipManager = GlobalManager::Instance().Zip();
+        size_t nStoredDataSize = 0;
+        std::shared_ptr<const uint8_t> pStoredData = zipManager.GetZipStoredData(imageFilePath, nStoredDataSize);
+        if (pStoredData != nullptr) {
+            //未压缩的文件：从映射的内存中直接复制，无需加锁（解码器需要持有文件数据，用于延迟解码）
+            fileData.assign(pStoredData.get(), pStoredData.get() + nStoredDataSize);
+        }
+        else {
+            zipManager.GetZipData(imageFilePath, fileData);
+        }
+        ASSERT(!fileData.empty());
+        if (fileData.empty()) {
+            //加载失败
+            return false;
+        }
+    }
+    else {
+        bool bReadFileData = true;//是否读取完整文件内容到内存（默认将图片文件的数据全部读取到内存，然后再加载并解码图片数据）
+        if (dataLoadParam.m_pathType == ImageLoadPathType::kLocalPath) {
+            //本地文件（非程序的resources目录，可能存在较大的文件，比如几MB或者更大的文件）
+            uint64_t nFileSize = imageFilePath.GetFileSize();
+            if (nFileSize > 128 * 1024) {//128KB
+                //大文件
+                bReadFileData = false;
             }
-            else {
-                bool bReadFileData = true;//是否读取完整文件内容到内存（默认将图片文件的数据全部读取到内存，然后再加载并解码图片数据）
-                if (imageLoadPath.m_pathType == ImageLoadPathType::kLocalPath) {
-                    //本地文件（非程序的resources目录，可能存在较大的文件，比如几MB或者更大的文件）
-                    uint64_t nFileSize = imageFilePath.GetFileSize();
-                    if (nFileSize > 128 * 1024) {//128KB
-                        //大文件
-                        bReadFileData = false;
-                    }
-                }
-                if (bReadFileData) {
-                    //小文件/程序的resources目录文件等，读取文件全部数据
-                    FileUtil::ReadFileData(imageFilePath, fileData);
-                    if (loadParam.IsAssertEnabled()) {
-                        ASSERT(!fileData.empty());
-                    }                    
-                    if (fileData.empty()) {
-                        //加载失败
-                        return nullptr;
-                    }
-                }
-                else {
-                    //大文件，只读取文件头的部分数据，用作签名校验(读取4KB数据)
-                    FileUtil::ReadFileHeaderData(imageFilePath, 4 * 1024, fileHeaderData);
-                    if (loadParam.IsAssertEnabled()) {
-                        ASSERT(!fileHeaderData.empty());
-                    }
-                    if (fileHeaderData.empty()) {
-                        //加载失败
-                        return nullptr;
-                    }
-                }
-            }           
         }
-        ImageDecodeParam decodeParam;
-        decodeParam.m_imageFilePath = imageFullPath;//前面的流程，当是本地文件时，已经确保文件存在
-        if (!fileData.empty()) {
-            decodeParam.m_pFileData = std::make_shared<std::vector<uint8_t>>();
-            decodeParam.m_pFileData->swap(fileData);
+        if (bReadFileData) {
+            //小文件/程序的resources目录文件等，读取文件全部数据
+            FileUtil::ReadFileData(imageFilePath, fileData);
+            if (decodeParam.m_bAssertEnabled) {
+                ASSERT(!fileData.empty());
+            }                    
+            if (fileData.empty()) {
+                //加载失败
+                return false;
+            }
         }
-        else if (!fileHeaderData.empty()) {
-            decodeParam.m_fileHeaderData.swap(fileHeaderData);
+        else {
+            //大文件，只读取文件头的部分数据，用作签名校验(读取4KB数据)
+            FileUtil::ReadFileHeaderData(imageFilePath, 4 * 1024, fileHeaderData);
+            if (decodeParam.m_bAssertEnabled) {
+                ASSERT(!fileHeaderData.empty());
+            }
+            if (fileHeaderData.empty()) {
+                //加载失败
+                return false;
+            }
         }
-        if (nImageFileDpiScale == 100) {//针对DPI自适应的原图，不开启该项优化，避免计算原图大小时出现异常
-            decodeParam.m_rcMaxDestRectSize = loadParam.GetMaxDestRectSize();
+    }
+    if (!fileData.empty()) {
+        decodeParam.m_pFileData = std::make_shared<std::vector<uint8_t>>();
+        decodeParam.m_pFileData->swap(fileData);
+    }
+    else if (!fileHeaderData.empty()) {
+        decodeParam.m_fileHeaderData.swap(fileHeaderData);
+    }
+    return true;
+}
+
+std::unique_ptr<IImage> ImageManager::DecodeImageData(const ImageDecodeParam& decodeParam)
+{
+    //加载图片     
+    ImageDecoderFactory& ImageDecoders = GlobalManager::Instance().ImageDecoders();
+    std::unique_ptr<IImage> pImageData = ImageDecoders.LoadImageData(decodeParam);
+    bool bEnableAssert = true;
+#ifndef DUILIB_IMAGE_SUPPORT_LIB_PAG        
+    if (pImageData == nullptr) {
+        DString fileExt = FilePathUtil::GetFileExtension(decodeParam.m_imageFilePath.ToString());
+        StringUtil::MakeUpperString(fileExt);
+        if (fileExt == _T("PAG")) {
+            //当不支持PAG时，禁止断言报错
+            bEnableAssert = false;
         }
-        decodeParam.m_fImageSizeScale = fImageSizeScale;
+    }
+#endif
+    if (decodeParam.m_bAssertEnabled && bEnableAssert) {
+        ASSERT(pImageData != nullptr); //图片加载失败时，断言
+    }        
+    if (pImageData == nullptr) {
+        //加载失败
+        return nullptr;
+    }
 
-        decodeParam.m_bAsyncDecode = loadParam.IsAsyncDecodeEnabled();    //是否支持多线程图片解码 
-        decodeParam.m_bIconAsAnimation = loadParam.IsIconAsAnimation();   //ICO格式相关参数
-        decodeParam.m_nIconSize = loadParam.GetIconSize();                //ICO格式相关参数
-        decodeParam.m_nIconFrameDelayMs = loadParam.GetIconFrameDelayMs();//ICO格式相关参数
-        decodeParam.m_fPagMaxFrameRate = loadParam.GetPagMaxFrameRate();  //PAG格式相关参数
-        decodeParam.m_bLoadAllFrames = true; //所有多帧图片相关参数
-        decodeParam.m_bAssertEnabled = loadParam.IsAssertEnabled();       //加载图片失败时是否允许断言（一般只影响图片数据错误导致的问题）
+    ASSERT((pImageData->GetWidth() > 0) && (pImageData->GetHeight() > 0));
+    if ((pImageData->GetWidth() <= 0) || (pImageData->GetHeight() <= 0)) {
+        //加载失败
+        return nullptr;
+    }
+    return pImageData;
+}
 
-        //加载图片     
-        std::unique_ptr<IImage> pImageData = ImageDecoders.LoadImageData(decodeParam);
-        bool bEnableAssert = true;
-#ifndef DUILIB_IMAGE_SUPPORT_LIB_PAG        
-        if (pImageData == nullptr) {
-            DString fileExt = FilePathUtil::GetFileExtension(decodeParam.m_imageFilePath.ToString());
-            StringUtil::MakeUpperString(fileExt);
-            if (fileExt == _T("PAG")) {
-                //当不支持PAG时，禁止断言报错
-                bEnableAssert = false;
+std::shared_ptr<IImage> ImageManager::AddImageData(const DString& imageKey, std::unique_ptr<IImage> pImageData, float fImageSizeScale)
+{
+    ASSERT(pImageData != nullptr);
+    if (pImageData == nullptr) {
+        return nullptr;
+    }
+    std::shared_ptr<IImage> spImageData;
+    spImageData.reset(pImageData.release(), [imageKey](IImage* pImage) {
+            ImageManager& imageManager = GlobalManager::Instance().Image();
+            imageManager.OnImageDataDestroy(imageKey, pImage);
+        });
+    OnImageDataCreate(imageKey, spImageData, fImageSizeScale);
+    return spImageData;
+}
+
+bool ImageManager::LoadImageAsync(const ImageLoadParam& loadParam, Control* pControl, Image* pImage)
+{
+    GlobalManager::Instance().AssertUIThread();
+    ASSERT((pControl != nullptr) && (pImage != nullptr));
+    if ((pControl == nullptr) || (pImage == nullptr)) {
+        return false;
+    }
+    if (loadParam.GetImageLoadPath().m_pathType == ImageLoadPathType::kVirtualPath) {
+        //ICON图标数据，在UI线程中加载
+        return false;
+    }
+    const DString loadKey = loadParam.GetLoadKey(loadParam.GetLoadDpiScale());
+    auto iter = m_imageInfoMap.find(loadKey);
+    if ((iter != m_imageInfoMap.end()) && !iter->second.expired()) {
+        //已经在缓存中
+        return false;
+    }
+
+    std::shared_ptr<TAsyncImageLoadTask> pTask = std::make_shared<TAsyncImageLoadTask>();
+    TImageDataLoadParam& dataLoadParam = pTask->m_dataLoadParam;
+    PrepareImageDataLoad(loadParam, dataLoadParam);
+    const DString imageKey = dataLoadParam.m_imageKey;
+    if (m_asyncLoadedImageMap.find(imageKey) != m_asyncLoadedImageMap.end()) {
+        //异步加载已经完成（成功或者失败）
+        return false;
+    }
+    if (FindImageData(imageKey, dataLoadParam.m_fImageSizeScale) != nullptr) {
+        //原图已经在缓存中
+        return false;
+    }
+    if (!ImageLoadScheduler::HasWorkerThread()) {
+        //没有可用的工作线程，同步加载
+        return false;
+    }
+
+    //加载完成后，通知控件重绘
+    AddDelayPaintData(pControl, pImage, imageKey);
+
+    auto iterTask = m_asyncLoadTaskMap.find(imageKey);
+    if (iterTask != m_asyncLoadTaskMap.end()) {
+        //该图片正在加载中：提高优先级（如果已经开始加载，则等待加载完成）
+        m_imageLoadScheduler.RaiseTaskPriority(imageKey);
+        return true;
+    }
+
+    //在子线程中读取图片文件数据（本地文件或者压缩包内的文件）并解码
+    auto AsyncLoadImageFunction = [pTask]() {
+            if (!pTask->m_bCanceled && ReadImageFileData(pTask->m_dataLoadParam)) {
+                pTask->m_pImageData = DecodeImageData(pTask->m_dataLoadParam.m_decodeParam);
+                std::unique_ptr<IImage>& pImageData = pTask->m_pImageData;
+                if ((pImageData != nullptr) &&
+                    (pImageData->GetImageType() != ImageType::kImageAnimation) &&
+                    pImageData->IsAsyncDecodeEnabled() && !pImageData->IsAsyncDecodeFinished()) {
+                    //单帧图片：在当前线程中完成解码，避免再次切换到图片解码线程
+                    auto IsAborted = [pTask]() {
+                            return pTask->m_bCanceled.load();
+                        };
+                    bool bDecodeError = false;
+                    pTask->m_bDecoded = pImageData->AsyncDecode(0, IsAborted, &bDecodeError);
+                }
             }
+            //通知UI线程（原图数据需要在UI线程中放入缓存）
+            GlobalManager::Instance().Thread().PostTask(ui::kThreadUI, [pTask]() {
+                    GlobalManager::Instance().Image().OnAsyncImageLoaded(pTask);
+                });
+        };
+    m_asyncLoadTaskMap[imageKey] = pTask;
+    m_imageLoadScheduler.AddTask(imageKey, AsyncLoadImageFunction);
+    return true;
+}
+
+void ImageManager::OnAsyncImageLoaded(const std::shared_ptr<TAsyncImageLoadTask>& pTask)
+{
+    GlobalManager::Instance().AssertUIThread();
+    if ((pTask == nullptr) || pTask->m_bCanceled) {
+        return;
+    }
+    const DString imageKey = pTask->m_dataLoadParam.m_imageKey;
+    auto iter = m_asyncLoadTaskMap.find(imageKey);
+    if ((iter == m_asyncLoadTaskMap.end()) || (iter->second != pTask)) {
+        return;
+    }
+    m_asyncLoadTaskMap.erase(iter);
+
+    //等待期间可能已经同步加载过（比如计算控件大小时），优先使用缓存中的原图
+    std::shared_ptr<IImage> spImageData = FindImageData(imageKey, pTask->m_dataLoadParam.m_fImageSizeScale);
+    if ((spImageData == nullptr) && (pTask->m_pImageData != nullptr)) {
+        if (pTask->m_bDecoded) {
+            //合并子线程中解码的数据
+            pTask->m_pImageData->MergeAsyncDecodeData();
         }
-#endif
-        if (loadParam.IsAssertEnabled() && bEnableAssert) {
-            ASSERT(pImageData != nullptr); //图片加载失败时，断言
-        }        
-        if (pImageData == nullptr) {
-            //加载失败
-            return nullptr;
+        spImageData = AddImageData(imageKey, std::move(pTask->m_pImageData), pTask->m_dataLoadParam.m_fImageSizeScale);
+        //尚未被使用：放入缓存，等待关联的控件重绘时获取
+        TouchImageData(imageKey, spImageData);
+    }
+    //保留加载结果，直到关联的控件重绘时获取（加载失败时，由GetImage返回失败）
+    bool bHasDelayPaint = false;
+    for (const TImageDelayPaintData& delayPaint : m_delayPaintImageList) {
+        if ((delayPaint.m_imageKey == imageKey) && (delayPaint.m_pControl != nullptr) && (delayPaint.m_pImage != nullptr)) {
+            bHasDelayPaint = true;
+            break;
         }
+    }
+    RemoveExpiredAsyncLoadedImages();
+    if (bHasDelayPaint) {
+        TAsyncLoadedImage& asyncLoaded = m_asyncLoadedImageMap[imageKey];
+        asyncLoaded.m_pImageData = spImageData;
+        asyncLoaded.m_bLoadFailed = (spImageData == nullptr);
+        asyncLoaded.m_loadedTime = std::chrono::steady_clock::now();
+    }
+    //通知相关的控件，重绘界面
+    DelayPaintImage(imageKey);
+}
 
-        ASSERT((pImageData->GetWidth() > 0) && (pImageData->GetHeight() > 0));
-        if ((pImageData->GetWidth() <= 0) || (pImageData->GetHeight() <= 0)) {
-            //加载失败
-            return nullptr;
+void ImageManager::RemoveExpiredAsyncLoadedImages()
+{
+    //关联的控件在加载完成后会立即重绘，超过有效期仍未被获取的结果不再需要保留
+    const std::chrono::seconds kExpireTime(10);
+    const auto nowTime = std::chrono::steady_clock::now();
+    auto iter = m_asyncLoadedImageMap.begin();
+    while (iter != m_asyncLoadedImageMap.end()) {
+        const TAsyncLoadedImage& asyncLoaded = iter->second;
+        if ((!asyncLoaded.m_bLoadFailed && asyncLoaded.m_pImageData.expired()) ||
+            ((nowTime - asyncLoaded.m_loadedTime) > kExpireTime)) {
+            iter = m_asyncLoadedImageMap.erase(iter);
+        }
+        else {
+            ++iter;
         }
-        //赋值, 添加到容器(替换删除函数)
-        ASSERT(imageKey == imageFullPath);
-        spImageData.reset(pImageData.release(), ImageManager::CallImageDataDestroy);//TODO：待验证，或许有平台兼容性问题
-        OnImageDataCreate(imageKey, spImageData, fImageSizeScale);        
     }
-    if (spImageData != nullptr) {
-        std::shared_ptr<ImageInfo> imageInfo(new ImageInfo, &ImageManager::CallImageInfoDestroy);
-        imageInfo->SetImageKey(imageKey);
-        bool bRet = imageInfo->SetImageData(loadParam, spImageData, bImageDpiScaleEnabled, nImageFileDpiScale);
-        ASSERT(bRet);
-        if (bRet) {
-            ASSERT(loadKey == imageInfo->GetLoadKey());
-            OnImageInfoCreate(imageInfo);
+}
 
-            if (bImageDataFromCache) {
-                //如果是重用缓存中的ImageData数据，需要移除待删除队列的数据
-                CancelReleaseImage(spImageData);
-            }
-            return imageInfo;
+void ImageManager::CancelAsyncImageLoad()
+{
+    for (auto& iter : m_asyncLoadTaskMap) {
+        if (iter.second != nullptr) {
+            iter.second->m_bCanceled = true;
         }
     }
-    return nullptr;
+    m_asyncLoadTaskMap.clear();
+    m_asyncLoadedImageMap.clear();
+    m_imageLoadScheduler.Stop();
 }
 
-void ImageManager::CallImageInfoDestroy(ImageInfo* pImageInfo)
+void ImageManager::SetImageLoadingPlaceholderColor(const UiColor& color)
 {
-    ImageManager& imageManager = GlobalManager::Instance().Image();
-    imageManager.OnImageInfoDestroy(pImageInfo);
+    m_imageLoadingPlaceholderColor = color;
+}
+
+const UiColor& ImageManager::GetImageLoadingPlaceholderColor() const
+{
+    return m_imageLoadingPlaceholderColor;
 }
 
-void ImageManager::CallImageDataDestroy(IImage* pImage)
+void ImageManager::CallImageInfoDestroy(ImageInfo* pImageInfo)
 {
     ImageManager& imageManager = GlobalManager::Instance().Image();
-    imageManager.OnImageDataDestroy(pImage);
+    imageManager.OnImageInfoDestroy(pImageInfo);
 }
 
 void ImageManager::OnImageInfoCreate(std::shared_ptr<ImageInfo>& pImageInfo)
@@ -270,7 +511,13 @@ void ImageManager::OnImageDataCreate(const DString& imageKey, std::shared_ptr<II
 {
     ASSERT(!imageKey.empty() && (pImage != nullptr));
     if (!imageKey.empty() && (pImage != nullptr)) {
-        m_imageDataMap[imageKey] = TImageData(pImage, fImageSizeScale);
+        RemoveCachedImageData(imageKey);
+        TImageData& imageData = m_imageDataMap[imageKey];
+        imageData.m_pImage = pImage;
+        imageData.m_fImageSizeScale = fImageSizeScale;
+        imageData.m_nImageBytes = GetImageDataBytes(pImage);
+        imageData.m_nUseCount = 0;
+        imageData.m_bAnimation = (pImage->GetImageType() == ImageType::kImageAnimation);
 #ifdef OUTPUT_IMAGE_LOG
         DString log = _T("Created ImageData: ") + imageKey + _T("\n");
         ::OutputDebugString(log.c_str());
@@ -278,23 +525,19 @@ void ImageManager::OnImageDataCreate(const DString& imageKey, std::shared_ptr<II
     }
 }
 
-void ImageManager::OnImageDataDestroy(IImage* pImage)
+void ImageManager::OnImageDataDestroy(const DString& imageKey, IImage* pImage)
 {
     ASSERT(ui::GlobalManager::Instance().IsInUIThread());
     ASSERT(pImage != nullptr);
     if (pImage != nullptr) {
-        auto iter = m_imageDataMap.begin();
-        while (iter != m_imageDataMap.end()) {
-            if (iter->second.m_pImage.expired()) {
+        //同一个KEY可能已经对应新加载的原图（比如切换DPI后重新加载），只移除已经失效的原图数据
+        auto iter = m_imageDataMap.find(imageKey);
+        if ((iter != m_imageDataMap.end()) && !iter->second.m_bCached && iter->second.m_pImage.expired()) {
 #ifdef OUTPUT_IMAGE_LOG
-                DString log = _T("Removed ImageData: ") + iter->first + _T("\n");
-                ::OutputDebugString(log.c_str());
+            DString log = _T("Removed ImageData: ") + iter->first + _T("\n");
+            ::OutputDebugString(log.c_str());
 #endif
-                iter = m_imageDataMap.erase(iter);
-            }
-            else {
-                ++iter;
-            }
+            m_imageDataMap.erase(iter);
         }
         delete pImage;
     }
@@ -302,66 +545,218 @@ void ImageManager::OnImageDataDestroy(IImage* pImage)
 
 void ImageManager::RemoveAllImages()
 {
+    //取消所有异步加载的任务（正在执行的任务完成后，其结果被丢弃）
+    CancelAsyncImageLoad();
+
+    //先清除缓存的队列，再释放缓存持有的原图（原图释放时会回调OnImageDataDestroy）
+    std::vector<std::shared_ptr<IImage>> cachedImages;
+    for (auto& iter : m_imageDataMap) {
+        if (iter.second.m_pCachedImage != nullptr) {
+            cachedImages.push_back(iter.second.m_pCachedImage);
+        }
+    }
+    m_imageLruList.clear();
+    m_animationLruList.clear();
     m_imageDataMap.clear();
-    m_delayReleaseImageList.clear();
+    m_cacheStatistics.m_nImageCount = 0;
+    m_cacheStatistics.m_nImageBytes = 0;
+    m_cacheStatistics.m_nAnimationCount = 0;
+    m_cacheStatistics.m_nAnimationBytes = 0;
+    cachedImages.clear();
     m_imageInfoMap.clear();
 }
 
-void ImageManager::ReleaseImage(const std::shared_ptr<IImage>& pImageData, const DString& imageFullPath)
+void ImageManager::ReleaseImage(const std::shared_ptr<IImage>& pImageData,
+                                const DString& imageKey,
+                                const DString& imageFullPath)
 {
-    //先移除队列中的元素，从而确保只有一个元素在队列中
-    CancelReleaseImage(pImageData);
+    if (pImageData == nullptr) {
+        return;
+    }
+    auto iter = m_imageDataMap.find(imageKey);
+    if ((iter == m_imageDataMap.end()) || (iter->second.m_pImage.lock() != pImageData)) {
+        //该KEY对应的原图已经被替换（比如切换DPI后重新加载）
+        return;
+    }
+
+    TImageData& imageData = iter->second;
+    ASSERT(imageData.m_nUseCount > 0);
+    if (imageData.m_nUseCount > 0) {
+        --imageData.m_nUseCount;
+    }
+    if (imageData.m_nUseCount > 0) {
+        //仍在使用中
+        return;
+    }
 
-    //通过回调函数，可以避免放入延迟释放队列
+    //通过回调函数，可以不放入缓存，立即释放
     if (m_releaseImageCallback != nullptr) {
         bool bAllowRelease = m_releaseImageCallback(pImageData, imageFullPath);
         if (!bAllowRelease) {
+            RemoveCachedImageData(imageKey);
             return;
         }
     }
+    TouchImageData(imageKey, pImageData);
+}
 
-    if (pImageData != nullptr) {
-        TReleaseImageData imageData;
-        imageData.m_pImage = pImageData;
-        imageData.m_releaseTime = std::chrono::steady_clock::now();
-        m_delayReleaseImageList.push_back(imageData);
+void ImageManager::ReleaseImage(const std::shared_ptr<IImage>& pImageData, const DString& imageFullPath)
+{
+    DString imageKey;
+    if (FindImageDataKey(pImageData, imageKey)) {
+        ReleaseImage(pImageData, imageKey, imageFullPath);
     }
+}
 
-    const int32_t nDelaySeconds = 35;
-    auto delayReleaseImage = []() {
-        ImageManager& imageManager = GlobalManager::Instance().Image();
-        auto nowTime = std::chrono::steady_clock::now();
-        auto iter = imageManager.m_delayReleaseImageList.begin();
-        while (iter != imageManager.m_delayReleaseImageList.end()) {
-            const TReleaseImageData& imageData = *iter;
-            //检查并释放图片资源(间隔：30秒，释放原图，以避免影响图片共享)
-            auto seconds = std::chrono::duration_cast<std::chrono::seconds>(nowTime - imageData.m_releaseTime);
-            if (seconds.count() > (nDelaySeconds - 5)) {
-                iter = imageManager.m_delayReleaseImageList.erase(iter);
-            }
-            else {
-                ++iter;
-            }
+void ImageManager::CancelReleaseImage(const std::shared_ptr<IImage>& pImageData)
+{
+    DString imageKey;
+    if (FindImageDataKey(pImageData, imageKey)) {
+        AcquireImageData(imageKey, pImageData);
+    }
+}
+
+bool ImageManager::FindImageDataKey(const std::shared_ptr<IImage>& pImage, DString& imageKey) const
+{
+    if (pImage == nullptr) {
+        return false;
+    }
+    for (const auto& iter : m_imageDataMap) {
+        if (iter.second.m_pImage.lock() == pImage) {
+            imageKey = iter.first;
+            return true;
         }
-    };
-    GlobalManager::Instance().Thread().PostDelayedTask(ui::kThreadUI, delayReleaseImage, nDelaySeconds * 1000);
+    }
+    return false;
 }
 
-void ImageManager::CancelReleaseImage(const std::shared_ptr<IImage>& pImageData)
+void ImageManager::AcquireImageData(const DString& imageKey, const std::shared_ptr<IImage>& pImage)
 {
-    if ((pImageData != nullptr) && !m_delayReleaseImageList.empty()) {
-        auto iter = m_delayReleaseImageList.begin();
-        while (iter != m_delayReleaseImageList.end()) {
-            const TReleaseImageData& imageData = *iter;
-            if (imageData.m_pImage == pImageData) {
-                iter = m_delayReleaseImageList.erase(iter);
-                break;
-            }
-            else {
-                ++iter;
-            }
+    ASSERT(pImage != nullptr);
+    auto iter = m_imageDataMap.find(imageKey);
+    if ((pImage == nullptr) || (iter == m_imageDataMap.end())) {
+        return;
+    }
+    ++iter->second.m_nUseCount;
+    //调用方持有原图，从缓存中移除时不会被释放
+    RemoveCachedImageData(imageKey);
+}
+
+size_t ImageManager::GetImageDataBytes(const std::shared_ptr<IImage>& pImage)
+{
+    if (pImage == nullptr) {
+        return 0;
+    }
+    const size_t nWidth = (size_t)std::max(pImage->GetWidth(), 0);
+    const size_t nHeight = (size_t)std::max(pImage->GetHeight(), 0);
+    size_t nFrameCount = 1;
+    if (pImage->GetImageType() == ImageType::kImageAnimation) {
+        std::shared_ptr<IAnimationImage> pAnimationImage = pImage->GetImageAnimation();
+        if ((pAnimationImage != nullptr) && (pAnimationImage->GetFrameCount() > 1)) {
+            nFrameCount = (size_t)pAnimationImage->GetFrameCount();
         }
     }
+    //按32位色的像素数据估算
+    return nWidth * nHeight * sizeof(uint32_t) * nFrameCount;
+}
+
+void ImageManager::TouchImageData(const DString& imageKey, const std::shared_ptr<IImage>& pImage)
+{
+    ASSERT(pImage != nullptr);
+    auto iter = m_imageDataMap.find(imageKey);
+    if ((pImage == nullptr) || (iter == m_imageDataMap.end())) {
+        return;
+    }
+    TImageData& imageData = iter->second;
+    ImageLruList& lruList = imageData.m_bAnimation ? m_animationLruList : m_imageLruList;
+    if (imageData.m_bCached) {
+        //已经在缓存中：移动到队首
+        lruList.splice(lruList.begin(), lruList, imageData.m_lruIter);
+        return;
+    }
+    imageData.m_pCachedImage = pImage;
+    imageData.m_lruIter = lruList.insert(lruList.begin(), imageKey);
+    imageData.m_bCached = true;
+    if (imageData.m_bAnimation) {
+        m_cacheStatistics.m_nAnimationCount += 1;
+        m_cacheStatistics.m_nAnimationBytes += imageData.m_nImageBytes;
+    }
+    else {
+        m_cacheStatistics.m_nImageCount += 1;
+        m_cacheStatistics.m_nImageBytes += imageData.m_nImageBytes;
+    }
+    EvictImageData(imageData.m_bAnimation);
+}
+
+void ImageManager::RemoveCachedImageData(const DString& imageKey)
+{
+    auto iter = m_imageDataMap.find(imageKey);
+    if ((iter == m_imageDataMap.end()) || !iter->second.m_bCached) {
+        return;
+    }
+    TImageData& imageData = iter->second;
+    if (imageData.m_bAnimation) {
+        m_animationLruList.erase(imageData.m_lruIter);
+        m_cacheStatistics.m_nAnimationCount -= 1;
+        m_cacheStatistics.m_nAnimationBytes -= imageData.m_nImageBytes;
+    }
+    else {
+        m_imageLruList.erase(imageData.m_lruIter);
+        m_cacheStatistics.m_nImageCount -= 1;
+        m_cacheStatistics.m_nImageBytes -= imageData.m_nImageBytes;
+    }
+    imageData.m_bCached = false;
+    //缓存持有的原图最后释放：如果没有其他引用，释放时会回调OnImageDataDestroy，并从m_imageDataMap中删除
+    std::shared_ptr<IImage> pCachedImage;
+    pCachedImage.swap(imageData.m_pCachedImage);
+    pCachedImage.reset();
+}
+
+void ImageManager::EvictImageData(bool bAnimation)
+{
+    ImageLruList& lruList = bAnimation ? m_animationLruList : m_imageLruList;
+    const size_t nBudgetBytes = bAnimation ? m_nAnimationCacheBudget : m_nImageCacheBudget;
+    const size_t& nCacheBytes = bAnimation ? m_cacheStatistics.m_nAnimationBytes : m_cacheStatistics.m_nImageBytes;
+    while ((nCacheBytes > nBudgetBytes) && !lruList.empty()) {
+        //从队尾淘汰最久未使用的原图（KEY需要复制，因为移除时会删除队列元素）
+        const DString imageKey = lruList.back();
+        RemoveCachedImageData(imageKey);
+        ++m_cacheStatistics.m_nEvictCount;
+    }
+}
+
+void ImageManager::SetImageCacheBudget(size_t nBudgetBytes)
+{
+    m_nImageCacheBudget = nBudgetBytes;
+    EvictImageData(false);
+}
+
+size_t ImageManager::GetImageCacheBudget() const
+{
+    return m_nImageCacheBudget;
+}
+
+void ImageManager::SetAnimationCacheBudget(size_t nBudgetBytes)
+{
+    m_nAnimationCacheBudget = nBudgetBytes;
+    EvictImageData(true);
+}
+
+size_t ImageManager::GetAnimationCacheBudget() const
+{
+    return m_nAnimationCacheBudget;
+}
+
+ImageCacheStatistics ImageManager::GetImageCacheStatistics() const
+{
+    return m_cacheStatistics;
+}
+
+void ImageManager::ResetImageCacheStatistics()
+{
+    m_cacheStatistics.m_nHitCount = 0;
+    m_cacheStatistics.m_nMissCount = 0;
+    m_cacheStatistics.m_nEvictCount = 0;
 }
 
 void ImageManager::SetReleaseImageCallback(ReleaseImageCallback callback)
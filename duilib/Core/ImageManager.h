@@ -3,32 +3,64 @@
 
 #include "duilib/Core/Callback.h"
 #include "duilib/Core/ControlPtrT.h"
+#include "duilib/Core/ImageLoadScheduler.h"
+#include "duilib/Core/UiColor.h"
 #include "duilib/Image/ImageDecoder.h"
+#include "duilib/Image/ImageLoadParam.h"
 #include <string>
 #include <vector>
 #include <list>
 #include <unordered_map>
 #include <memory>
+#include <atomic>
 #include <chrono>
 
 namespace ui 
 {
 class ImageInfo;
-class ImageLoadParam;
 class DpiManager;
 class Window;
 class Control;
 class Image;
 
-/** 延迟释放图片的回调函数类型
+/** 释放图片的回调函数类型
  * @param [in] pImageData 原图的图像数据接口
  * @param [in] imageFullPath 该图片的完整路径
- * @return 返回true表示允许放入延迟释放队列，返回false表示组织放入延迟释放队列
+ * @return 返回true表示允许保留在原图缓存中，返回false表示立即从原图缓存中移除
  */
 using ReleaseImageCallback = std::function<bool (const std::shared_ptr<ui::IImage>& pImageData,
                                                  const DString& imageFullPath)>;
 
-/** 图片管理器（对于图片资源的释放：延迟释放，内部有个原图图片队列，如果需要立即释放图片，则需要ReleaseImageCallback回调函数阻止放入延迟释放队列）
+/** 原图缓存的统计数据
+ */
+struct UILIB_API ImageCacheStatistics
+{
+    //命中次数（从缓存中获取到原图数据）
+    uint64_t m_nHitCount = 0;
+
+    //未命中次数（需要重新加载并解码原图数据）
+    uint64_t m_nMissCount = 0;
+
+    //因超出内存预算而被淘汰的次数
+    uint64_t m_nEvictCount = 0;
+
+    //缓存中（已不再使用、可被淘汰的）静态图片（位图、SVG）的个数
+    size_t m_nImageCount = 0;
+
+    //缓存中（已不再使用、可被淘汰的）静态图片（位图、SVG）占用的内存（字节，按解码后的像素数据估算）
+    size_t m_nImageBytes = 0;
+
+    //缓存中（已不再使用、可被淘汰的）动画图片的个数
+    size_t m_nAnimationCount = 0;
+
+    //缓存中（已不再使用、可被淘汰的）动画图片占用的内存（字节，按所有帧解码后的像素数据估算）
+    size_t m_nAnimationBytes = 0;
+};
+
+/** 图片管理器
+ *  原图数据的缓存：按内存占用（字节）计算的LRU缓存，超出内存预算时淘汰最久未使用的原图，静态图片与动画图片分别设置内存预算；
+ *  正在使用中的原图不在LRU队列中（不计入内存预算，可继续共享），不再使用时才放入LRU队列；
+ *  如果需要立即释放图片，则需要ReleaseImageCallback回调函数将原图从缓存中移除
  */
 class UILIB_API ImageManager
 {
@@ -46,26 +78,81 @@ public:
      */
     std::shared_ptr<ImageInfo> GetImage(const ImageLoadParam& loadParam, bool& bImageDataFromCache);
 
+    /** 在子线程中异步加载图片（读取图片文件数据并解码），加载完成后通知关联的控件重绘
+     *   同一个图片同时只加载一次；最近请求的图片优先加载（绘制时请求的图片在可见区域内）
+     * @param [in] loadParam 图片的加载属性，包含图片路径等信息
+     * @param [in] pControl 图片关联的控件
+     * @param [in] pImage 图片接口
+     * @return 返回true表示图片正在子线程中加载；
+     *         返回false表示不需要异步加载（图片已经在缓存中、异步加载已经完成或者该图片不支持异步加载），需要调用GetImage加载图片
+     */
+    bool LoadImageAsync(const ImageLoadParam& loadParam, Control* pControl, Image* pImage);
+
+    /** 设置图片异步加载完成前，绘制时显示的占位符颜色（默认为空，表示不绘制占位符）
+     */
+    void SetImageLoadingPlaceholderColor(const UiColor& color);
+
+    /** 获取图片异步加载完成前，绘制时显示的占位符颜色
+     */
+    const UiColor& GetImageLoadingPlaceholderColor() const;
+
     /** 从缓存中删除所有图片
      */
     void RemoveAllImages();
 
-    /** 从缓存中释放一个原图图片（延迟释放）
+    /** 释放一个原图图片（不再使用时，原图保留在缓存中，直到因超出内存预算而被淘汰）
+    * @param [in] pImageData 原图的图像数据接口
+    * @param [in] imageKey 原图数据的KEY（即ImageInfo::GetImageKey()）
+    * @param [in] imageFullPath 该图片的完整路径
+    */
+    void ReleaseImage(const std::shared_ptr<IImage>& pImageData,
+                      const DString& imageKey,
+                      const DString& imageFullPath);
+
+    /** 释放一个原图图片（兼容原有接口：需要按原图数据查找KEY，建议使用带imageKey参数的版本）
     * @param [in] pImageData 原图的图像数据接口
     * @param [in] imageFullPath 该图片的完整路径
     */
     void ReleaseImage(const std::shared_ptr<IImage>& pImageData, const DString& imageFullPath);
 
-    /** 取消释放原图图片
+    /** 取消释放原图图片：原图重新标记为使用中（从LRU队列中移出），使用完毕后需要调用ReleaseImage释放
+    * @param [in] pImageData 原图的图像数据接口
     */
     void CancelReleaseImage(const std::shared_ptr<IImage>& pImageData);
 
-    /** 设置延迟释放图片的回调函数，可以用来阻止图片资源放入延迟释放队列，立即释放图片资源
+    /** 设置释放图片的回调函数，可以用来将图片资源从原图缓存中移除，立即释放图片资源
      *   备注：如果图片资源是在虚表的子项中使用，立即释放原图资源会导致性能降低，因为虚表的元素是每次刷新都重新填充
-     * @param [in] callback 延迟释放图片的回调函数
+     * @param [in] callback 释放图片的回调函数
      */
     void SetReleaseImageCallback(ReleaseImageCallback callback);
 
+public:
+    /** 设置静态图片（位图、SVG）原图缓存的内存预算（字节），超出时淘汰最久未使用的原图
+    * @param [in] nBudgetBytes 内存预算，为0时表示不缓存不再使用的原图
+    */
+    void SetImageCacheBudget(size_t nBudgetBytes);
+
+    /** 获取静态图片（位图、SVG）原图缓存的内存预算（字节）
+    */
+    size_t GetImageCacheBudget() const;
+
+    /** 设置动画图片原图缓存的内存预算（字节），超出时淘汰最久未使用的原图
+    * @param [in] nBudgetBytes 内存预算，为0时表示不缓存不再使用的原图
+    */
+    void SetAnimationCacheBudget(size_t nBudgetBytes);
+
+    /** 获取动画图片原图缓存的内存预算（字节）
+    */
+    size_t GetAnimationCacheBudget() const;
+
+    /** 获取原图缓存的统计数据
+    */
+    ImageCacheStatistics GetImageCacheStatistics() const;
+
+    /** 重置原图缓存的统计数据（命中次数、未命中次数、淘汰次数）
+    */
+    void ResetImageCacheStatistics();
+
 public:
     /** 设置是否智能匹配临近的缩放百分比图片
     *   比如当dpiScale为120的时候，如果无图片匹配，但存在缩放百分比为125的图片，会自动匹配到
@@ -111,11 +198,6 @@ private:
     */
     static void CallImageInfoDestroy(ImageInfo* pImageInfo);
 
-    /** 图片数据被销毁的回调函数，用于释放图片资源的数据
-    * @param[in] pImage 图片数据接口
-    */
-    static void CallImageDataDestroy(IImage* pImage);
-
 private:
     /** 图片信息被创建的回调函数
     * @param[in] pImageInfo 图片对应的 ImageInfo 对象
@@ -135,9 +217,123 @@ private:
     void OnImageDataCreate(const DString& imageKey, std::shared_ptr<IImage>& pImage, float fImageSizeScale);
 
     /** 图片数据被销毁的回调函数，用于释放图片资源的数据
+     * @param[in] imageKey 图片的KEY
      * @param[in] pImage 图片数据接口
      */
-    void OnImageDataDestroy(IImage* pImage);
+    void OnImageDataDestroy(const DString& imageKey, IImage* pImage);
+
+private:
+    /** 原图数据的加载参数
+    */
+    struct TImageDataLoadParam
+    {
+        //原图数据的KEY（图片的完整路径，DPI自适应的图片为对应DPI下的图片路径）
+        DString m_imageKey;
+
+        //图片文件对应的DPI缩放百分比
+        uint32_t m_nImageFileDpiScale = 100;
+
+        //加载的缩放比例
+        float m_fImageSizeScale = 1.0f;
+
+        //图片路径的类型
+        ImageLoadPathType m_pathType = ImageLoadPathType::kUnknownPath;
+
+        //图片的解码参数
+        ImageDecodeParam m_decodeParam;
+    };
+
+    /** 异步加载图片的任务
+    */
+    struct TAsyncImageLoadTask
+    {
+        //原图数据的加载参数
+        TImageDataLoadParam m_dataLoadParam;
+
+        //加载结果：原图数据（加载失败时为空）
+        std::unique_ptr<IImage> m_pImageData;
+
+        //是否已经在子线程中完成单帧图片的解码
+        bool m_bDecoded = false;
+
+        //任务是否已经取消
+        std::atomic<bool> m_bCanceled{ false };
+    };
+
+    /** 计算原图数据的加载参数（在UI线程中调用）
+    * @param [in] loadParam 图片的加载属性
+    * @param [out] dataLoadParam 返回原图数据的加载参数（不包含图片文件数据）
+    */
+    void PrepareImageDataLoad(const ImageLoadParam& loadParam, TImageDataLoadParam& dataLoadParam) const;
+
+    /** 从缓存中查找原图数据
+    * @param [in] imageKey 原图数据的KEY
+    * @param [in] fImageSizeScale 加载的缩放比例，如果与缓存中原图的缩放比例不同，则不可共享
+    */
+    std::shared_ptr<IImage> FindImageData(const DString& imageKey, float fImageSizeScale);
+
+    /** 读取图片文件数据（可以在子线程中调用）
+    * @param [in,out] dataLoadParam 原图数据的加载参数，读取的数据保存在解码参数中
+    * @return 成功返回true，失败返回false
+    */
+    static bool ReadImageFileData(TImageDataLoadParam& dataLoadParam);
+
+    /** 解码图片数据（可以在子线程中调用）
+    * @param [in] decodeParam 图片的解码参数
+    */
+    static std::unique_ptr<IImage> DecodeImageData(const ImageDecodeParam& decodeParam);
+
+    /** 将新加载的原图数据放入缓存
+    * @param [in] imageKey 原图数据的KEY
+    * @param [in] pImageData 原图数据
+    * @param [in] fImageSizeScale 加载的缩放比例
+    */
+    std::shared_ptr<IImage> AddImageData(const DString& imageKey, std::unique_ptr<IImage> pImageData, float fImageSizeScale);
+
+    /** 异步加载图片完成（在UI线程中调用）
+    * @param [in] pTask 异步加载图片的任务
+    */
+    void OnAsyncImageLoaded(const std::shared_ptr<TAsyncImageLoadTask>& pTask);
+
+    /** 取消所有异步加载图片的任务
+    */
+    void CancelAsyncImageLoad();
+
+private:
+    /** 原图缓存的LRU队列（队首为最近使用的原图，队尾为最久未使用的原图），元素为原图数据的KEY
+    */
+    typedef std::list<DString> ImageLruList;
+
+    /** 估算原图数据占用的内存（字节）
+    * @param [in] pImage 图片数据接口
+    */
+    static size_t GetImageDataBytes(const std::shared_ptr<IImage>& pImage);
+
+    /** 将不再使用的原图放入缓存，或者标记为最近使用（O(1)）
+    * @param [in] imageKey 原图数据的KEY
+    * @param [in] pImage 图片数据接口
+    */
+    void TouchImageData(const DString& imageKey, const std::shared_ptr<IImage>& pImage);
+
+    /** 原图被使用（增加使用计数，并从LRU队列中移出，不再计入内存预算）
+    * @param [in] imageKey 原图数据的KEY
+    * @param [in] pImage 图片数据接口，调用方需持有，从LRU队列中移出时不会被释放
+    */
+    void AcquireImageData(const DString& imageKey, const std::shared_ptr<IImage>& pImage);
+
+    /** 按原图数据查找原图数据的KEY（遍历所有原图，用于兼容原有接口）
+    */
+    bool FindImageDataKey(const std::shared_ptr<IImage>& pImage, DString& imageKey) const;
+
+    /** 将原图从缓存中移除（不影响正在使用中的原图）
+    * @param [in] imageKey 原图数据的KEY
+    */
+    void RemoveCachedImageData(const DString& imageKey);
+
+    /** 淘汰最久未使用的原图，直到缓存占用的内存不超过内存预算
+    * @param [in] bAnimation true表示动画图片的缓存，false表示静态图片的缓存
+    */
+    void EvictImageData(bool bAnimation);
 
 private:
     /** 查找指定DPI缩放百分比下的图片，可以每个DPI设置一个图片，以提高不同DPI下的图片质量
@@ -194,20 +390,37 @@ private:
     {
         //构造函数
         TImageData() :
-            m_fImageSizeScale(1.0f)
-        {
-        }
-        TImageData(const std::shared_ptr<IImage>& pImage, float fImageSizeScale) :
-            m_pImage(pImage),
-            m_fImageSizeScale(fImageSizeScale)
+            m_fImageSizeScale(1.0f),
+            m_nImageBytes(0),
+            m_nUseCount(0),
+            m_bAnimation(false),
+            m_bCached(false)
         {
         }
 
-        //释放的图片接口
+        //图片接口（正在使用中的原图可共享，不论是否在缓存中）
         std::weak_ptr<IImage> m_pImage;
 
+        //缓存中持有的图片接口（不在缓存中时为空）
+        std::shared_ptr<IImage> m_pCachedImage;
+
         //加载时输入的图片缩放比例
         float m_fImageSizeScale;
+
+        //原图占用的内存（字节）
+        size_t m_nImageBytes;
+
+        //使用计数（使用该原图的ImageInfo个数），为0时放入LRU队列
+        size_t m_nUseCount;
+
+        //是否为动画图片
+        bool m_bAnimation;
+
+        //是否在缓存中（不再使用、在LRU队列中）
+        bool m_bCached;
+
+        //在LRU队列中的位置（仅当m_bCached为true时有效）
+        ImageLruList::iterator m_lruIter;
     };
 
     /** 图片资源映射表（原图数据Key与图片数据的映射表）
@@ -215,21 +428,63 @@ private:
     */
     std::unordered_map<DString, TImageData> m_imageDataMap;
 
-    /** 等待释放的原图数据
+    /** 静态图片（位图、SVG）原图缓存的LRU队列
+    */
+    ImageLruList m_imageLruList;
+
+    /** 动画图片原图缓存的LRU队列
+    */
+    ImageLruList m_animationLruList;
+
+    /** 静态图片原图缓存的内存预算（字节）
+    */
+    size_t m_nImageCacheBudget;
+
+    /** 动画图片原图缓存的内存预算（字节）
+    */
+    size_t m_nAnimationCacheBudget;
+
+    /** 原图缓存的统计数据
+    */
+    ImageCacheStatistics m_cacheStatistics;
+
+    /** 释放图片的回调函数
+    */
+    ReleaseImageCallback m_releaseImageCallback;
+
+    /** 异步加载图片的调度器
+    */
+    ImageLoadScheduler m_imageLoadScheduler;
+
+    /** 正在异步加载的图片任务（KEY为原图数据的KEY）
+    */
+    std::unordered_map<DString, std::shared_ptr<TAsyncImageLoadTask>> m_asyncLoadTaskMap;
+
+    /** 异步加载完成、尚未被GetImage获取的加载结果
     */
-    struct TReleaseImageData
+    struct TAsyncLoadedImage
     {
-        //释放的图片接口
-        std::shared_ptr<IImage> m_pImage;
+        //原图数据（弱引用：原图由缓存持有，计入缓存的内存预算，被淘汰后由GetImage重新加载）
+        std::weak_ptr<IImage> m_pImageData;
+
+        //是否加载失败
+        bool m_bLoadFailed = false;
 
-        //数据释放的时间
-        std::chrono::steady_clock::time_point m_releaseTime;
+        //加载完成的时间（超过有效期未被获取的结果会被清除，比如关联的控件已经不再绘制）
+        std::chrono::steady_clock::time_point m_loadedTime;
     };
-    std::vector<TReleaseImageData> m_delayReleaseImageList;
 
-    /** 延迟释放图片的回调函数
+    /** 清除超过有效期的异步加载结果
     */
-    ReleaseImageCallback m_releaseImageCallback;
+    void RemoveExpiredAsyncLoadedImages();
+
+    /** 异步加载完成、尚未被GetImage获取的加载结果（KEY为原图数据的KEY）
+    */
+    std::unordered_map<DString, TAsyncLoadedImage> m_asyncLoadedImageMap;
+
+    /** 图片异步加载完成前，绘制时显示的占位符颜色
+    */
+    UiColor m_imageLoadingPlaceholderColor;
 
 private:
     /** 图片延迟绘制相关数据（图片资源在子线程加载完成后，需要通知界面重新绘制该图片）
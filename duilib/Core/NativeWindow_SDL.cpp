@@ -172,11 +172,12 @@ public:
 public:
     /** 通过回调接口，完成绘制
     * @param [in] rcPaint 需要绘制的区域（客户区坐标）
+    * @param [in] paintRects 需要绘制的区域列表（客户区坐标），为空时表示绘制整个rcPaint区域
     */
-    virtual bool DoPaint(const UiRect& rcPaint) override
+    virtual bool DoPaint(const UiRect& rcPaint, const std::vector<UiRect>& paintRects) override
     {
         if (m_pOwner != nullptr) {
-            m_pOwner->OnNativePaintMsg(rcPaint, m_nativeMsg, m_bHandled);
+            m_pOwner->OnNativePaintMsg(rcPaint, paintRects, m_nativeMsg, m_bHandled);
             return true;
         }
         return false;
@@ -198,6 +199,16 @@ public:
         rcUpdate = m_pNativeWindow->GetUpdateRect();
         return !rcUpdate.IsEmpty();
     }
+
+    /** 获取界面需要绘制的区域列表（各个矩形之间互不相交），以实现多区域的局部绘制
+    * @param [out] updateRects 返回需要绘制的区域矩形列表
+    * @return 返回true表示支持局部绘制，返回false表示不支持局部绘制
+    */
+    virtual bool GetUpdateRects(std::vector<UiRect>& updateRects) const override
+    {
+        updateRects = m_pNativeWindow->GetUpdateRegion().GetRects();
+        return !updateRects.empty();
+    }
 };
 
 void NativeWindow_SDL::CheckWindowSnap(SDL_Window* window)
@@ -257,6 +268,11 @@ bool NativeWindow_SDL::OnSDLWindowEvent(const SDL_Event& sdlEvent)
     //接口的生命周期标志
     std::weak_ptr<WeakFlag> ownerFlag = pOwner->GetWeakFlag();
 
+    if (sdlEvent.type == WM_USER_PAINT_MSG) {
+        //队列中的绘制消息已经取出（即使被过滤器处理也需要复位），此后如有新的脏区域，需要重新发送绘制消息
+        m_bPaintPending = false;
+    }
+
     //消息首先转给过滤器(全部消息)
     bool bHandled = false;
     LRESULT lResult = pOwner->OnNativeWindowMessage(sdlEvent.type, (WPARAM)&sdlEvent, 0, bHandled);
@@ -716,7 +732,8 @@ NativeWindow_SDL::NativeWindow_SDL(INativeWindow* pOwner):
     m_bFullscreenExiting(false),
     m_bFullscreenMaximized(false),
     m_ptLastMousePos(-1, -1),
-    m_bInitWindowPosFlag(false)
+    m_bInitWindowPosFlag(false),
+    m_bPaintPending(false)
 {
     ASSERT(m_pOwner != nullptr);    
 }
@@ -2587,50 +2604,25 @@ bool NativeWindow_SDL::IsCaptured() const
     return m_bMouseCapture;
 }
 
-struct NativeWindowExposedEvent
-{
-    SDL_Window* m_sdlWindow = nullptr;
-    bool m_bFoundExposedEvent = false;
-};
-
-static bool SDLCALL FilterNativeWindowExposedEvent(void* userdata, SDL_Event* event)
-{
-    if ((userdata != nullptr) && (event != nullptr)) {
-        NativeWindowExposedEvent* data = (NativeWindowExposedEvent*)userdata;
-        if (!data->m_bFoundExposedEvent && (event->type == WM_USER_PAINT_MSG)) {
-            if (data->m_sdlWindow == SDL_GetWindowFromEvent(event)) {
-                data->m_bFoundExposedEvent = true;
-            }
-        }
-    }
-    return true;
-}
-
 void NativeWindow_SDL::Invalidate(const UiRect& rcItem)
 {
-    if (m_rcUpdateRect.IsZero()) {
-        m_rcUpdateRect = rcItem;
-    }
-    else {
-        m_rcUpdateRect.Union(rcItem);
-    }
+    //记录脏区域：多个互不相交的矩形，避免相距较远的区域合并为一个大的外接矩形
+    m_updateRegion.AddRect(rcItem);
 
-    //暂时没有此功能, 只能发送一个绘制消息，触发界面绘制
-    if (m_sdlWindow != nullptr) {
-        NativeWindowExposedEvent data;
-        data.m_bFoundExposedEvent = false;
-        data.m_sdlWindow = m_sdlWindow;
-        SDL_FilterEvents(FilterNativeWindowExposedEvent, &data);
-        if (!data.m_bFoundExposedEvent) {
-            //如果队列中没有该窗口的绘制消息，则添加一个；但如果有的话，就不重复添加，避免重复绘制而影响性能
-            SDL_Event sdlEvent;
-            sdlEvent.type = WM_USER_PAINT_MSG;
-            sdlEvent.common.timestamp = 0;
-            sdlEvent.user.data1 = 0;
-            sdlEvent.user.data2 = 0;
-            sdlEvent.user.windowID = SDL_GetWindowID(m_sdlWindow);
-            bool nRet = SDL_PushEvent(&sdlEvent);
-            ASSERT_UNUSED_VARIABLE(nRet);
+    //发送一个绘制消息，触发界面绘制
+    if ((m_sdlWindow != nullptr) && !m_bPaintPending) {
+        //如果队列中没有该窗口的绘制消息，则添加一个；但如果有的话，就不重复添加，避免重复绘制而影响性能
+        //（通过标志判断，无需遍历消息队列，在拖动或者动画过程中大量调用本函数时，开销为O(1)）
+        SDL_Event sdlEvent;
+        sdlEvent.type = WM_USER_PAINT_MSG;
+        sdlEvent.common.timestamp = 0;
+        sdlEvent.user.data1 = 0;
+        sdlEvent.user.data2 = 0;
+        sdlEvent.user.windowID = SDL_GetWindowID(m_sdlWindow);
+        bool nRet = SDL_PushEvent(&sdlEvent);
+        ASSERT_UNUSED_VARIABLE(nRet);
+        if (nRet) {
+            m_bPaintPending = true;
         }
     }
 }
@@ -2640,7 +2632,7 @@ void NativeWindow_SDL::PaintWindow(bool bPaintAll)
     PerformanceStat statPerformance(_T("PaintWindow, NativeWindow_SDL::PaintWindow(Total)"));
     if (bPaintAll) {
         //绘制全部
-        m_rcUpdateRect.Clear();
+        m_updateRegion.Clear();
     }
     INativeWindow* pOwner = m_pOwner;
     ASSERT(pOwner != nullptr);
@@ -2655,9 +2647,10 @@ void NativeWindow_SDL::PaintWindow(bool bPaintAll)
             //子窗口模式，完全由应用层负责绘制
             if (pOwner != nullptr) {
                 UiRect rcPaint = GetUpdateRect();
+                std::vector<UiRect> paintRects = m_updateRegion.GetRects();
                 bool bHandled = false;
                 NativeMsg nativeMsg = NativeMsg(SDL_EVENT_WINDOW_EXPOSED, (WPARAM)m_sdlWindow, 0);
-                pOwner->OnNativePaintMsg(rcPaint, nativeMsg, bHandled);
+                pOwner->OnNativePaintMsg(rcPaint, paintRects, nativeMsg, bHandled);
             }
         }
         else {
@@ -2674,12 +2667,17 @@ void NativeWindow_SDL::PaintWindow(bool bPaintAll)
             }
         }
     }
-    m_rcUpdateRect.Clear();
+    m_updateRegion.Clear();
 }
 
 const UiRect& NativeWindow_SDL::GetUpdateRect() const
 {
-    return m_rcUpdateRect;
+    return m_updateRegion.GetBounds();
+}
+
+const UiDamageRegion& NativeWindow_SDL::GetUpdateRegion() const
+{
+    return m_updateRegion;
 }
 
 void NativeWindow_SDL::SetImeOpenStatus(bool bOpen)
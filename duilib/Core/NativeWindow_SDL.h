@@ -4,6 +4,7 @@
 #include "duilib/Core/INativeWindow.h"
 #include "duilib/Core/WindowCreateParam.h"
 #include "duilib/Core/WindowCreateAttributes.h"
+#include "duilib/Core/UiDamageRegion.h"
 #include "duilib/Utils/FilePath.h"
 
 #ifdef DUILIB_BUILD_FOR_SDL
@@ -572,10 +573,14 @@ public:
     */
     void PaintWindow(bool bPaintAll);
 
-    /** 窗口更新的区域（需要绘制）
+    /** 窗口更新的区域（需要绘制），返回所有脏区域的外接矩形
     */
     const UiRect& GetUpdateRect() const;
 
+    /** 窗口更新的区域（需要绘制），由若干个互不相交的矩形组成
+    */
+    const UiDamageRegion& GetUpdateRegion() const;
+
     /** 设置输入法的开关状态（关闭再打开以后，能够保持原输入法状态）
     * @param [in] bOpen true标识打开输入法，false标识关闭输入法
     */
@@ -830,7 +835,11 @@ private:
 
     /** 窗口更新的区域（需要绘制）
     */
-    UiRect m_rcUpdateRect;
+    UiDamageRegion m_updateRegion;
+
+    /** 消息队列中是否已有该窗口的绘制消息（WM_USER_PAINT_MSG），避免重复发送绘制消息
+    */
+    bool m_bPaintPending;
 
     /** 拖放的支持
     */
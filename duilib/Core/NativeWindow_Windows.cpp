@@ -1690,12 +1690,13 @@ public:
 public:
     /** 通过回调接口，完成绘制
     * @param [in] rcPaint 需要绘制的区域（客户区坐标）
+    * @param [in] paintRects 需要绘制的区域列表（客户区坐标），为空时表示绘制整个rcPaint区域
     */
-    virtual bool DoPaint(const UiRect& rcPaint) override
+    virtual bool DoPaint(const UiRect& rcPaint, const std::vector<UiRect>& paintRects) override
     {
         if (m_pOwner != nullptr) {
             NativeMsg nativeMsg = NativeMsg(WM_PAINT, (WPARAM)m_pNativeWindow->GetHWND(), 0);
-            m_pOwner->OnNativePaintMsg(rcPaint, nativeMsg, m_bHandled);
+            m_pOwner->OnNativePaintMsg(rcPaint, paintRects, nativeMsg, m_bHandled);
             return true;
         }
         return false;
@@ -1726,6 +1727,20 @@ public:
         }
         return !rcUpdate.IsEmpty();
     }
+
+    /** 获取界面需要绘制的区域列表，以实现多区域的局部绘制（Windows平台由系统维护更新区域，只返回一个矩形）
+    * @param [out] updateRects 返回需要绘制的区域矩形列表
+    * @return 返回true表示支持局部绘制，返回false表示不支持局部绘制
+    */
+    virtual bool GetUpdateRects(std::vector<UiRect>& updateRects) const override
+    {
+        updateRects.clear();
+        UiRect rcUpdate;
+        if (GetUpdateRect(rcUpdate)) {
+            updateRects.push_back(rcUpdate);
+        }
+        return !updateRects.empty();
+    }
 };
 
 LRESULT NativeWindow_Windows::OnPaintMsg(UINT uMsg, WPARAM wParam, LPARAM lParam, bool& bHandled)
@@ -1744,7 +1759,7 @@ LRESULT NativeWindow_Windows::OnPaintMsg(UINT uMsg, WPARAM wParam, LPARAM lParam
             if (m_pOwner != nullptr) {
                 UiRect rcPaint(rectUpdate.left, rectUpdate.top, rectUpdate.right, rectUpdate.bottom);
                 NativeMsg nativeMsg = NativeMsg(WM_PAINT, (WPARAM)m_hWnd, 0);
-                m_pOwner->OnNativePaintMsg(rcPaint, nativeMsg, bHandled);
+                m_pOwner->OnNativePaintMsg(rcPaint, std::vector<UiRect>(), nativeMsg, bHandled);
                 bPaint = true;
             }
         }
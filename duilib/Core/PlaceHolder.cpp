@@ -593,6 +593,7 @@ void PlaceHolder::ArrangeSelf()
     Invalidate();
 
     if (m_pWindow != nullptr) {
+        m_pWindow->AddArrangeControl(this);
         m_pWindow->SetArrange(true);
     }
 }
@@ -624,6 +625,10 @@ void PlaceHolder::SetRect(const UiRect& rc)
             m_pData->m_uiFloatPos = UiSize(INT32_MIN, INT32_MIN);
         }
     }
+    if (GetParent() != nullptr) {
+        //通知父容器更新鼠标命中测试的空间索引
+        GetParent()->OnItemRectChanged(this);
+    }
 }
 
 void PlaceHolder::SetRowSpan(int32_t rowSpan)
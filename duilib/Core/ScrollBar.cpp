@@ -4,6 +4,7 @@
 #include "duilib/Core/GlobalManager.h"
 #include "duilib/Image/Image.h"
 #include "duilib/Utils/StringUtil.h"
+#include "duilib/Utils/AttributeTable.h"
 
 namespace ui
 {
@@ -67,94 +68,250 @@ void ScrollBar::SetOwner(ScrollBox* pOwner)
 
 DString ScrollBar::GetType() const { return DUI_CTR_SCROLLBAR; }
 
+namespace
+{
+/** ScrollBar的属性ID（与属性名称一一对应，兼容的旧属性名称对应相同的属性ID）
+*/
+enum class ScrollBarAttribute : int32_t
+{
+    kButton1NormalImage,
+    kButton1HotImage,
+    kButton1PushedImage,
+    kButton1DisabledImage,
+    kButton2NormalImage,
+    kButton2HotImage,
+    kButton2PushedImage,
+    kButton2DisabledImage,
+    kThumbNormalImage,
+    kThumbHotImage,
+    kThumbPushedImage,
+    kThumbDisabledImage,
+    kRailNormalImage,
+    kRailHotImage,
+    kRailPushedImage,
+    kRailDisabledImage,
+    kBkNormalImage,
+    kBkHotImage,
+    kBkPushedImage,
+    kBkDisabledImage,
+    kHorizontal,
+    kLineSize,
+    kThumbMinLength,
+    kRange,
+    kValue,
+    kShowButton1,
+    kShowButton2,
+    kAutoHideScroll
+};
+
+/** ScrollBar的属性表（属性名称 -> 属性ID）
+*/
+constexpr AttributeTableEntry kScrollBarAttributeEntries[] = {
+    {"button1_normal_image", (int32_t)ScrollBarAttribute::kButton1NormalImage},
+    {"button1normalimage", (int32_t)ScrollBarAttribute::kButton1NormalImage},
+    {"button1_hot_image", (int32_t)ScrollBarAttribute::kButton1HotImage},
+    {"button1hotimage", (int32_t)ScrollBarAttribute::kButton1HotImage},
+    {"button1_pushed_image", (int32_t)ScrollBarAttribute::kButton1PushedImage},
+    {"button1pushedimage", (int32_t)ScrollBarAttribute::kButton1PushedImage},
+    {"button1_disabled_image", (int32_t)ScrollBarAttribute::kButton1DisabledImage},
+    {"button1disabledimage", (int32_t)ScrollBarAttribute::kButton1DisabledImage},
+    {"button2_normal_image", (int32_t)ScrollBarAttribute::kButton2NormalImage},
+    {"button2normalimage", (int32_t)ScrollBarAttribute::kButton2NormalImage},
+    {"button2_hot_image", (int32_t)ScrollBarAttribute::kButton2HotImage},
+    {"button2hotimage", (int32_t)ScrollBarAttribute::kButton2HotImage},
+    {"button2_pushed_image", (int32_t)ScrollBarAttribute::kButton2PushedImage},
+    {"button2pushedimage", (int32_t)ScrollBarAttribute::kButton2PushedImage},
+    {"button2_disabled_image", (int32_t)ScrollBarAttribute::kButton2DisabledImage},
+    {"button2disabledimage", (int32_t)ScrollBarAttribute::kButton2DisabledImage},
+    {"thumb_normal_image", (int32_t)ScrollBarAttribute::kThumbNormalImage},
+    {"thumbnormalimage", (int32_t)ScrollBarAttribute::kThumbNormalImage},
+    {"thumb_hot_image", (int32_t)ScrollBarAttribute::kThumbHotImage},
+    {"thumbhotimage", (int32_t)ScrollBarAttribute::kThumbHotImage},
+    {"thumb_pushed_image", (int32_t)ScrollBarAttribute::kThumbPushedImage},
+    {"thumbpushedimage", (int32_t)ScrollBarAttribute::kThumbPushedImage},
+    {"thumb_disabled_image", (int32_t)ScrollBarAttribute::kThumbDisabledImage},
+    {"thumbdisabledimage", (int32_t)ScrollBarAttribute::kThumbDisabledImage},
+    {"rail_normal_image", (int32_t)ScrollBarAttribute::kRailNormalImage},
+    {"railnormalimage", (int32_t)ScrollBarAttribute::kRailNormalImage},
+    {"rail_hot_image", (int32_t)ScrollBarAttribute::kRailHotImage},
+    {"railhotimage", (int32_t)ScrollBarAttribute::kRailHotImage},
+    {"rail_pushed_image", (int32_t)ScrollBarAttribute::kRailPushedImage},
+    {"railpushedimage", (int32_t)ScrollBarAttribute::kRailPushedImage},
+    {"rail_disabled_image", (int32_t)ScrollBarAttribute::kRailDisabledImage},
+    {"raildisabledimage", (int32_t)ScrollBarAttribute::kRailDisabledImage},
+    {"bk_normal_image", (int32_t)ScrollBarAttribute::kBkNormalImage},
+    {"bknormalimage", (int32_t)ScrollBarAttribute::kBkNormalImage},
+    {"bk_hot_image", (int32_t)ScrollBarAttribute::kBkHotImage},
+    {"bkhotimage", (int32_t)ScrollBarAttribute::kBkHotImage},
+    {"bk_pushed_image", (int32_t)ScrollBarAttribute::kBkPushedImage},
+    {"bkpushedimage", (int32_t)ScrollBarAttribute::kBkPushedImage},
+    {"bk_disabled_image", (int32_t)ScrollBarAttribute::kBkDisabledImage},
+    {"bkdisabledimage", (int32_t)ScrollBarAttribute::kBkDisabledImage},
+    {"horizontal", (int32_t)ScrollBarAttribute::kHorizontal},
+    {"hor", (int32_t)ScrollBarAttribute::kHorizontal},
+    {"line_size", (int32_t)ScrollBarAttribute::kLineSize},
+    {"linesize", (int32_t)ScrollBarAttribute::kLineSize},
+    {"thumb_min_length", (int32_t)ScrollBarAttribute::kThumbMinLength},
+    {"thumbminlength", (int32_t)ScrollBarAttribute::kThumbMinLength},
+    {"range", (int32_t)ScrollBarAttribute::kRange},
+    {"value", (int32_t)ScrollBarAttribute::kValue},
+    {"show_button1", (int32_t)ScrollBarAttribute::kShowButton1},
+    {"showbutton1", (int32_t)ScrollBarAttribute::kShowButton1},
+    {"show_button2", (int32_t)ScrollBarAttribute::kShowButton2},
+    {"showbutton2", (int32_t)ScrollBarAttribute::kShowButton2},
+    {"auto_hide_scroll", (int32_t)ScrollBarAttribute::kAutoHideScroll},
+    {"autohidescroll", (int32_t)ScrollBarAttribute::kAutoHideScroll},
+};
+constexpr AttributeTable kScrollBarAttributeTable(kScrollBarAttributeEntries);
+static_assert(kScrollBarAttributeTable.IsValid(), "ScrollBar attribute table is invalid!");
+}
+
 void ScrollBar::SetAttribute(const DString& strName, const DString& strValue)
 {
-    if ((strName == _T("button1_normal_image")) || (strName == _T("button1normalimage"))) {
-        SetButton1StateImage(kControlStateNormal, strValue);
-    }
-    else if ((strName == _T("button1_hot_image")) || (strName == _T("button1hotimage"))) {
-        SetButton1StateImage(kControlStateHot, strValue);
-    }
-    else if ((strName == _T("button1_pushed_image")) || (strName == _T("button1pushedimage"))) {
-        SetButton1StateImage(kControlStatePushed, strValue);
-    }
-    else if ((strName == _T("button1_disabled_image")) || (strName == _T("button1disabledimage"))) {
-        SetButton1StateImage(kControlStateDisabled, strValue);
-    }
-    else if ((strName == _T("button2_normal_image")) || (strName == _T("button2normalimage"))) {
-        SetButton2StateImage(kControlStateNormal, strValue);
-    }
-    else if ((strName == _T("button2_hot_image")) || (strName == _T("button2hotimage"))) {
-        SetButton2StateImage(kControlStateHot, strValue);
-    }
-    else if ((strName == _T("button2_pushed_image")) || (strName == _T("button2pushedimage"))) {
-        SetButton2StateImage(kControlStatePushed, strValue);
-    }
-    else if ((strName == _T("button2_disabled_image")) || (strName == _T("button2disabledimage"))) {
-        SetButton2StateImage(kControlStateDisabled, strValue);
-    }
-    else if ((strName == _T("thumb_normal_image")) || (strName == _T("thumbnormalimage"))) {
-        SetThumbStateImage(kControlStateNormal, strValue);
-    }
-    else if ((strName == _T("thumb_hot_image")) || (strName == _T("thumbhotimage"))) {
-        SetThumbStateImage(kControlStateHot, strValue);
-    }
-    else if ((strName == _T("thumb_pushed_image")) || (strName == _T("thumbpushedimage"))) {
-        SetThumbStateImage(kControlStatePushed, strValue);
-    }
-    else if ((strName == _T("thumb_disabled_image")) || (strName == _T("thumbdisabledimage"))) {
-        SetThumbStateImage(kControlStateDisabled, strValue);
-    }
-    else if ((strName == _T("rail_normal_image")) || (strName == _T("railnormalimage"))) {
-        SetRailStateImage(kControlStateNormal, strValue);
-    }
-    else if ((strName == _T("rail_hot_image")) || (strName == _T("railhotimage"))) {
-        SetRailStateImage(kControlStateHot, strValue);
-    }
-    else if ((strName == _T("rail_pushed_image")) || (strName == _T("railpushedimage"))) {
-        SetRailStateImage(kControlStatePushed, strValue);
-    }
-    else if ((strName == _T("rail_disabled_image")) || (strName == _T("raildisabledimage"))) {
-        SetRailStateImage(kControlStateDisabled, strValue);
-    }
-    else if ((strName == _T("bk_normal_image")) || (strName == _T("bknormalimage"))) {
-        SetBkStateImage(kControlStateNormal, strValue);
-    }
-    else if ((strName == _T("bk_hot_image")) || (strName == _T("bkhotimage"))) {
-        SetBkStateImage(kControlStateHot, strValue);
-    }
-    else if ((strName == _T("bk_pushed_image")) || (strName == _T("bkpushedimage"))) {
-        SetBkStateImage(kControlStatePushed, strValue);
-    }
-    else if ((strName == _T("bk_disabled_image")) || (strName == _T("bkdisabledimage"))) {
-        SetBkStateImage(kControlStateDisabled, strValue);
-    }
-    else if ((strName == _T("horizontal")) || (strName == _T("hor"))) {
-        SetHorizontal(strValue == _T("true"));
-    }
-    else if ((strName == _T("line_size")) || (strName == _T("linesize"))) {
-        SetLineSize(StringUtil::StringToInt32(strValue), true);
-    }
-    else if ((strName == _T("thumb_min_length")) || (strName == _T("thumbminlength"))) {
-        SetThumbMinLength(StringUtil::StringToInt32(strValue), true);
-    }
-    else if (strName == _T("range")) {
-        SetScrollRange(StringUtil::StringToInt32(strValue));
-    }
-    else if (strName == _T("value")) {
-        SetScrollPos(StringUtil::StringToInt32(strValue));
-    }
-    else if ((strName == _T("show_button1")) || (strName == _T("showbutton1"))) {
-        SetShowButton1(strValue == _T("true"));
-    }
-    else if ((strName == _T("show_button2")) || (strName == _T("showbutton2"))) {
-        SetShowButton2(strValue == _T("true"));
-    }
-    else if ((strName == _T("auto_hide_scroll")) || (strName == _T("autohidescroll"))) {
-        SetAutoHideScroll(strValue == _T("true"));
-    }
-    else {
+    switch ((ScrollBarAttribute)kScrollBarAttributeTable.Find(strName)) {
+    case ScrollBarAttribute::kButton1NormalImage:
+        {
+            SetButton1StateImage(kControlStateNormal, strValue);
+        }
+        break;
+    case ScrollBarAttribute::kButton1HotImage:
+        {
+            SetButton1StateImage(kControlStateHot, strValue);
+        }
+        break;
+    case ScrollBarAttribute::kButton1PushedImage:
+        {
+            SetButton1StateImage(kControlStatePushed, strValue);
+        }
+        break;
+    case ScrollBarAttribute::kButton1DisabledImage:
+        {
+            SetButton1StateImage(kControlStateDisabled, strValue);
+        }
+        break;
+    case ScrollBarAttribute::kButton2NormalImage:
+        {
+            SetButton2StateImage(kControlStateNormal, strValue);
+        }
+        break;
+    case ScrollBarAttribute::kButton2HotImage:
+        {
+            SetButton2StateImage(kControlStateHot, strValue);
+        }
+        break;
+    case ScrollBarAttribute::kButton2PushedImage:
+        {
+            SetButton2StateImage(kControlStatePushed, strValue);
+        }
+        break;
+    case ScrollBarAttribute::kButton2DisabledImage:
+        {
+            SetButton2StateImage(kControlStateDisabled, strValue);
+        }
+        break;
+    case ScrollBarAttribute::kThumbNormalImage:
+        {
+            SetThumbStateImage(kControlStateNormal, strValue);
+        }
+        break;
+    case ScrollBarAttribute::kThumbHotImage:
+        {
+            SetThumbStateImage(kControlStateHot, strValue);
+        }
+        break;
+    case ScrollBarAttribute::kThumbPushedImage:
+        {
+            SetThumbStateImage(kControlStatePushed, strValue);
+        }
+        break;
+    case ScrollBarAttribute::kThumbDisabledImage:
+        {
+            SetThumbStateImage(kControlStateDisabled, strValue);
+        }
+        break;
+    case ScrollBarAttribute::kRailNormalImage:
+        {
+            SetRailStateImage(kControlStateNormal, strValue);
+        }
+        break;
+    case ScrollBarAttribute::kRailHotImage:
+        {
+            SetRailStateImage(kControlStateHot, strValue);
+        }
+        break;
+    case ScrollBarAttribute::kRailPushedImage:
+        {
+            SetRailStateImage(kControlStatePushed, strValue);
+        }
+        break;
+    case ScrollBarAttribute::kRailDisabledImage:
+        {
+            SetRailStateImage(kControlStateDisabled, strValue);
+        }
+        break;
+    case ScrollBarAttribute::kBkNormalImage:
+        {
+            SetBkStateImage(kControlStateNormal, strValue);
+        }
+        break;
+    case ScrollBarAttribute::kBkHotImage:
+        {
+            SetBkStateImage(kControlStateHot, strValue);
+        }
+        break;
+    case ScrollBarAttribute::kBkPushedImage:
+        {
+            SetBkStateImage(kControlStatePushed, strValue);
+        }
+        break;
+    case ScrollBarAttribute::kBkDisabledImage:
+        {
+            SetBkStateImage(kControlStateDisabled, strValue);
+        }
+        break;
+    case ScrollBarAttribute::kHorizontal:
+        {
+            SetHorizontal(strValue == _T("true"));
+        }
+        break;
+    case ScrollBarAttribute::kLineSize:
+        {
+            SetLineSize(StringUtil::StringToInt32(strValue), true);
+        }
+        break;
+    case ScrollBarAttribute::kThumbMinLength:
+        {
+            SetThumbMinLength(StringUtil::StringToInt32(strValue), true);
+        }
+        break;
+    case ScrollBarAttribute::kRange:
+        {
+            SetScrollRange(StringUtil::StringToInt32(strValue));
+        }
+        break;
+    case ScrollBarAttribute::kValue:
+        {
+            SetScrollPos(StringUtil::StringToInt32(strValue));
+        }
+        break;
+    case ScrollBarAttribute::kShowButton1:
+        {
+            SetShowButton1(strValue == _T("true"));
+        }
+        break;
+    case ScrollBarAttribute::kShowButton2:
+        {
+            SetShowButton2(strValue == _T("true"));
+        }
+        break;
+    case ScrollBarAttribute::kAutoHideScroll:
+        {
+            SetAutoHideScroll(strValue == _T("true"));
+        }
+        break;
+    default:
         Control::SetAttribute(strName, strValue);
+        break;
     }
 }
 
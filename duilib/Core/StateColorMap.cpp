@@ -28,7 +28,7 @@ bool StateColorMap::HasHotColor() const
 
 bool StateColorMap::HasStateColors() const
 {
-    for (const UiString& color : m_stateColors) {
+    for (const UiNamedColor& color : m_stateColors) {
         if (!color.empty()) {
             return true;
         }
@@ -54,6 +54,15 @@ DString StateColorMap::GetStateColor(ControlStateType stateType) const
     return DString();
 }
 
+UiColor StateColorMap::GetStateUiColor(ControlStateType stateType) const
+{
+    size_t nIndex = (size_t)stateType;
+    if (nIndex < m_stateColors.size()) {
+        return m_stateColors[nIndex].GetColor(m_pControl);
+    }
+    return UiColor();
+}
+
 void StateColorMap::PaintStateColor(IRender* pRender, const UiRect& rcPaint, ControlStateType stateType) const
 {
     ASSERT(pRender != nullptr);
@@ -65,12 +74,11 @@ void StateColorMap::PaintStateColor(IRender* pRender, const UiRect& rcPaint, Con
         int32_t nHotAlpha = m_pControl->GetHotAlpha();
         if (bFadeHot) {
             if ((stateType == kControlStateNormal || stateType == kControlStateHot) && HasStateColor(kControlStateHot)) {
-                DString strColor = GetStateColor(kControlStateNormal);
-                if (!strColor.empty()) {
-                    pRender->FillRect(rcPaint, m_pControl->GetUiColor(strColor));
+                if (HasStateColor(kControlStateNormal)) {
+                    pRender->FillRect(rcPaint, GetStateUiColor(kControlStateNormal));
                 }
                 if (nHotAlpha > 0) {
-                    pRender->FillRect(rcPaint, m_pControl->GetUiColor(GetStateColor(kControlStateHot)), static_cast<uint8_t>(nHotAlpha));
+                    pRender->FillRect(rcPaint, GetStateUiColor(kControlStateHot), static_cast<uint8_t>(nHotAlpha));
                 }
                 return;
             }
@@ -86,11 +94,8 @@ void StateColorMap::PaintStateColor(IRender* pRender, const UiRect& rcPaint, Con
     if (stateType == kControlStateDisabled && !HasStateColor(kControlStateDisabled)) {
         stateType = kControlStateNormal;
     }
-    DString strColor = GetStateColor(stateType);
-    if (!strColor.empty()) {
-        UiColor color = m_pControl ? m_pControl->GetUiColor(strColor) :
-                                     GlobalManager::Instance().Color().GetColor(strColor);
-        pRender->FillRect(rcPaint, color);
+    if (HasStateColor(stateType)) {
+        pRender->FillRect(rcPaint, GetStateUiColor(stateType));
     }
 }
 } // namespace ui
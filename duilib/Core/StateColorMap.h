@@ -3,6 +3,7 @@
 
 #include "duilib/Render/IRender.h"
 #include "duilib/Core/UiTypes.h"
+#include "duilib/Core/UiNamedColor.h"
 
 namespace ui 
 {
@@ -23,6 +24,10 @@ public:
     */
     void SetStateColor(ControlStateType stateType, const DString& color);
 
+    /** 获取颜色值（预先解析的颜色值，不需要每次查找颜色表），如果不包含此颜色，则返回空
+    */
+    UiColor GetStateUiColor(ControlStateType stateType) const;
+
 public:
     /** 是否包含Hot状态的颜色
     */
@@ -48,7 +53,7 @@ private:
 
     /** 状态与颜色值的映射表
     */
-    std::vector<UiString> m_stateColors;
+    std::vector<UiNamedColor> m_stateColors;
 };
 
 } // namespace ui
@@ -78,6 +78,15 @@ DString StateColorMap2::GetStateColor(ControlStateType stateType) const
     return DString();
 }
 
+UiColor StateColorMap2::GetStateUiColor(ControlStateType stateType) const
+{
+    size_t nIndex = (size_t)stateType;
+    if (nIndex < m_stateColors.size()) {
+        return m_stateColors[nIndex].m_colorStr.GetColor(m_pControl);
+    }
+    return UiColor();
+}
+
 UiMargin StateColorMap2::GetStateColorMargin(ControlStateType stateType) const
 {
     size_t nIndex = (size_t)stateType;
@@ -117,12 +126,11 @@ void StateColorMap2::PaintStateColor(IRender* pRender, const UiRect& rcPaint, Co
         int32_t nHotAlpha = m_pControl->GetHotAlpha();
         if (bFadeHot) {
             if ((stateType == kControlStateNormal || stateType == kControlStateHot) && HasStateColor(kControlStateHot)) {
-                DString strColor = GetStateColor(kControlStateNormal);
-                if (!strColor.empty()) {
-                    DoPaintStateColor(pRender, rcPaint, kControlStateNormal, m_pControl->GetUiColor(strColor));
+                if (HasStateColor(kControlStateNormal)) {
+                    DoPaintStateColor(pRender, rcPaint, kControlStateNormal, GetStateUiColor(kControlStateNormal));
                 }
                 if (nHotAlpha > 0) {
-                    DoPaintStateColor(pRender, rcPaint, kControlStateHot, m_pControl->GetUiColor(GetStateColor(kControlStateHot)), nHotAlpha);
+                    DoPaintStateColor(pRender, rcPaint, kControlStateHot, GetStateUiColor(kControlStateHot), nHotAlpha);
                 }
                 return;
             }
@@ -138,11 +146,8 @@ void StateColorMap2::PaintStateColor(IRender* pRender, const UiRect& rcPaint, Co
     if (stateType == kControlStateDisabled && !HasStateColor(kControlStateDisabled)) {
         stateType = kControlStateNormal;
     }
-    DString strColor = GetStateColor(stateType);
-    if (!strColor.empty()) {
-        UiColor color = m_pControl ? m_pControl->GetUiColor(strColor) :
-                                     GlobalManager::Instance().Color().GetColor(strColor);
-        DoPaintStateColor(pRender, rcPaint, stateType, color);
+    if (HasStateColor(stateType)) {
+        DoPaintStateColor(pRender, rcPaint, stateType, GetStateUiColor(stateType));
     }
 }
 
@@ -3,6 +3,7 @@
 
 #include "duilib/Render/IRender.h"
 #include "duilib/Core/UiTypes.h"
+#include "duilib/Core/UiNamedColor.h"
 
 namespace ui 
 {
@@ -40,6 +41,10 @@ public:
      * @param [in] colorRound 要设置的颜色矩形圆角大小，如果不设置，则颜色矩形跟随控件矩形的形状
      */
     void SetStateColor(ControlStateType stateType, const DString& color);
+
+    /** 获取颜色值（预先解析的颜色值，不需要每次查找颜色表），如果不包含此颜色，则返回空
+    */
+    UiColor GetStateUiColor(ControlStateType stateType) const;
     void SetStateColorMargin(ControlStateType stateType, const UiMargin& colorMargin);
     void SetStateColorRound(ControlStateType stateType, const UiSize& colorRound);
 
@@ -72,7 +77,7 @@ private:
     struct TColorProperty
     {
         //颜色字符串
-        UiString m_colorStr;
+        UiNamedColor m_colorStr;
 
         //该颜色的外边距
         UiMargin16 m_colorMargin;
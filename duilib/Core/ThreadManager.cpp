@@ -28,15 +28,67 @@ bool ThreadManager::RegisterThread(int32_t nThreadIdentifier, FrameworkThread* p
     if (iter != m_threadsMap.end()) {
         return false;
     }
+    ASSERT(m_threadPoolsMap.find(nThreadIdentifier) == m_threadPoolsMap.end());
+    if (m_threadPoolsMap.find(nThreadIdentifier) != m_threadPoolsMap.end()) {
+        return false;
+    }
     m_threadsMap[nThreadIdentifier] = pThread;
     return true;
 }
 
+bool ThreadManager::RegisterThreadPool(int32_t nThreadIdentifier, FrameworkThreadPool* pThreadPool)
+{
+    ASSERT(nThreadIdentifier >= 0);
+    ASSERT(pThreadPool != nullptr);
+    if (pThreadPool == nullptr) {
+        return false;
+    }
+
+    ScopedLock threadGuard(m_threadMutex);
+    ASSERT(m_threadsMap.find(nThreadIdentifier) == m_threadsMap.end());
+    if (m_threadsMap.find(nThreadIdentifier) != m_threadsMap.end()) {
+        return false;
+    }
+    auto iter = m_threadPoolsMap.find(nThreadIdentifier);
+    ASSERT(iter == m_threadPoolsMap.end());
+    if (iter != m_threadPoolsMap.end()) {
+        return false;
+    }
+    m_threadPoolsMap[nThreadIdentifier] = pThreadPool;
+    return true;
+}
+
+bool ThreadManager::UnregisterThreadPool(int32_t nThreadIdentifier)
+{
+    ScopedLock threadGuard(m_threadMutex);
+    auto iter = m_threadPoolsMap.find(nThreadIdentifier);
+    if (iter == m_threadPoolsMap.end()) {
+        return false;
+    }
+    else {
+        m_threadPoolsMap.erase(iter);
+        return true;
+    }
+}
+
+size_t ThreadManager::GetThreadPoolThreadCount(int32_t nThreadIdentifier) const
+{
+    ScopedLock threadGuard(m_threadMutex);
+    auto iter = m_threadPoolsMap.find(nThreadIdentifier);
+    if ((iter == m_threadPoolsMap.end()) || (iter->second == nullptr)) {
+        return 0;
+    }
+    return iter->second->GetThreadCount();
+}
+
 bool ThreadManager::HasThread(int32_t nThreadIdentifier) const
 {
     ScopedLock threadGuard(m_threadMutex);
     auto iter = m_threadsMap.find(nThreadIdentifier);
-    return iter != m_threadsMap.end();
+    if (iter != m_threadsMap.end()) {
+        return true;
+    }
+    return m_threadPoolsMap.find(nThreadIdentifier) != m_threadPoolsMap.end();
 }
 
 bool ThreadManager::UnregisterThread(int32_t nThreadIdentifier)
@@ -67,6 +119,14 @@ int32_t ThreadManager::GetCurrentThreadIdentifier() const
             break;
         }
     }
+    if (nThreadIdentifier == kThreadNone) {
+        for (auto iter = m_threadPoolsMap.begin(); iter != m_threadPoolsMap.end(); ++iter) {
+            if ((iter->second != nullptr) && iter->second->IsPoolThread()) {
+                nThreadIdentifier = iter->first;
+                break;
+            }
+        }
+    }
     return nThreadIdentifier;
 }
 
@@ -88,6 +148,12 @@ size_t ThreadManager::PostTask(int32_t nThreadIdentifier, const StdClosure& task
             nTaskId = spFrameworkThread->PostTask(task, unlockClosure);
         }
     }
+    else {
+        auto iterPool = m_threadPoolsMap.find(nThreadIdentifier);
+        if ((iterPool != m_threadPoolsMap.end()) && (iterPool->second != nullptr)) {
+            nTaskId = iterPool->second->PostTask(task);
+        }
+    }
     ASSERT(nTaskId != 0);
     return nTaskId;
 }
@@ -100,6 +166,10 @@ size_t ThreadManager::PostDelayedTask(int32_t nThreadIdentifier, const StdClosur
     }
     size_t nTaskId = 0;
     ScopedLock threadGuard(m_threadMutex);
+    if (m_threadPoolsMap.find(nThreadIdentifier) != m_threadPoolsMap.end()) {
+        //线程池不支持定时任务
+        return 0;
+    }
     auto iter = m_threadsMap.find(nThreadIdentifier);
     if (iter != m_threadsMap.end()) {
         FrameworkThreadPtr spFrameworkThread = iter->second;
@@ -120,6 +190,10 @@ size_t ThreadManager::PostRepeatedTask(int32_t nThreadIdentifier, const StdClosu
     }
     size_t nTaskId = 0;
     ScopedLock threadGuard(m_threadMutex);
+    if (m_threadPoolsMap.find(nThreadIdentifier) != m_threadPoolsMap.end()) {
+        //线程池不支持定时任务
+        return 0;
+    }
     auto iter = m_threadsMap.find(nThreadIdentifier);
     if (iter != m_threadsMap.end()) {
         FrameworkThreadPtr spFrameworkThread = iter->second;
@@ -145,6 +219,14 @@ bool ThreadManager::CancelTask(size_t nTaskId)
             break;
         }
     }
+    if (!bCancelTask) {
+        for (auto iter = m_threadPoolsMap.begin(); iter != m_threadPoolsMap.end(); ++iter) {
+            if ((iter->second != nullptr) && iter->second->CancelTask(nTaskId)) {
+                bCancelTask = true;
+                break;
+            }
+        }
+    }
     return bCancelTask;
 }
 
@@ -152,6 +234,7 @@ void ThreadManager::Clear()
 {
     ScopedLock threadGuard(m_threadMutex);
     m_threadsMap.clear();
+    m_threadPoolsMap.clear();
 }
 
 size_t ThreadManager::GetNextTaskId()
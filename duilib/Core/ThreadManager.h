@@ -2,6 +2,7 @@
 #define UI_CORE_THREAD_MANAGER_H_
 
 #include "duilib/Core/FrameworkThread.h"
+#include "duilib/Core/FrameworkThreadPool.h"
 #include "duilib/Core/ControlPtrT.h"
 #include <map>
 
@@ -24,7 +25,7 @@ public:
     */
     bool RegisterThread(int32_t nThreadIdentifier, FrameworkThread* pThread);
 
-    /** 判断是否包含指定标识符的线程
+    /** 判断是否包含指定标识符的线程（或者线程池）
     * @param [in] nThreadIdentifier 线程标识ID
     */
     bool HasThread(int32_t nThreadIdentifier) const;
@@ -34,33 +35,50 @@ public:
     */
     bool UnregisterThread(int32_t nThreadIdentifier);
 
-    /** 获取当前线程的线程标识ID
+    /** 注册一个线程池到管理器（注册后可通过线程标识ID向线程池发送任务）
+    * @param [in] nThreadIdentifier 线程标识ID（不能与已注册的线程相同）
+    * @param [in] pThreadPool 线程池的接口（在取消注册前需保证对象有效）
+    */
+    bool RegisterThreadPool(int32_t nThreadIdentifier, FrameworkThreadPool* pThreadPool);
+
+    /** 从管理器中取消注册一个线程池
+    * @param [in] nThreadIdentifier 线程标识ID
+    */
+    bool UnregisterThreadPool(int32_t nThreadIdentifier);
+
+    /** 获取线程池的工作线程个数
+    * @param [in] nThreadIdentifier 线程池的线程标识ID
+    * @return 返回工作线程个数，如果线程池未注册则返回0
+    */
+    size_t GetThreadPoolThreadCount(int32_t nThreadIdentifier) const;
+
+    /** 获取当前线程的线程标识ID（如果当前线程是线程池的工作线程，返回线程池的标识ID）
     * @return 成功返回线程标识ID，失败则返回kThreadNone(值为-1)
     */
     int32_t GetCurrentThreadIdentifier() const;
 
 public:
-    /** 向线程发送一个任务，立即执行
+    /** 向线程发送一个任务，立即执行（线程标识ID可以是线程池的标识ID）
     * @param [in] nThreadIdentifier 线程标识ID
     * @param [in] task 任务回调函数
     * @return 成功返回任务ID(大于0)，如果失败则返回0
     */
     size_t PostTask(int32_t nThreadIdentifier, const StdClosure& task);
 
-    /** 向线程发送一个任务，延迟执行
+    /** 向线程发送一个任务，延迟执行（不支持线程池）
     * @param [in] nThreadIdentifier 线程标识ID
     * @param [in] task 任务回调函数
     * @param [in] nDelayMs 延迟的时间（单位：毫秒）
-    * @return 成功返回任务ID(大于0)，如果失败则返回0
+    * @return 成功返回任务ID(大于0)，如果失败或者线程标识ID为线程池则返回0
     */
     size_t PostDelayedTask(int32_t nThreadIdentifier, const StdClosure& task, int32_t nDelayMs);
 
-    /** 向线程发送一个任务，可定时重复执行
+    /** 向线程发送一个任务，可定时重复执行（不支持线程池）
     * @param [in] nThreadIdentifier 线程标识ID
     * @param [in] task 任务回调函数
     * @param [in] nIntervalMs 间隔的时间（单位：毫秒）
     * @param [in] nTimes 重复的次数，如果为-1表示一直执行
-    * @return 成功返回任务ID(大于0)，如果失败则返回0
+    * @return 成功返回任务ID(大于0)，如果失败或者线程标识ID为线程池则返回0
     */
     size_t PostRepeatedTask(int32_t nThreadIdentifier, const StdClosure& task,
                             int32_t nIntervalMs, int32_t nTimes = -1);
@@ -98,6 +116,10 @@ private:
     */
     std::map<int32_t, FrameworkThreadPtr> m_threadsMap;
 
+    /** 线程池信息映射表
+    */
+    std::map<int32_t, FrameworkThreadPool*> m_threadPoolsMap;
+
     /** 多线程同步锁
     */
     mutable std::mutex m_threadMutex;
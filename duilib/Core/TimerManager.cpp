@@ -3,6 +3,8 @@
 #include "duilib/Utils/LogUtil.h"
 #include "duilib/Utils/StringUtil.h"
 #include "duilib/Core/WindowMessage.h"
+#include <unordered_map>
+#include <bit>
 
 #if defined (DUILIB_BUILD_FOR_SDL)
     #include <SDL3/SDL.h>
@@ -19,24 +21,29 @@
 namespace ui 
 {
 
+/** 定时器在时间轮槽位链表中的链接节点
+*/
+struct TimerLink
+{
+    TimerLink* m_pPrev = nullptr;
+    TimerLink* m_pNext = nullptr;
+};
+
 /** 定时器的数据
 */
-class TimerInfo
+class TimerInfo: public TimerLink
 {
 public:
     TimerInfo(): 
+        m_nTimerId(0),
         timerCallback(nullptr),
         uElapseMs(0),
         uRepeatTime(0),
-        m_nTimerId(0)
+        m_nExpireTick(0),
+        m_nSlot(0)
     {
     }
 
-    bool operator < (const TimerInfo& r) const {
-        //排序条件：最先触发的排在前面
-        return trigerTime > r.trigerTime;
-    }
-
     //定时器ID
     size_t m_nTimerId;
 
@@ -52,15 +59,317 @@ public:
     //重复次数
     uint32_t uRepeatTime;
 
-    //定时器的触发时间
-    std::chrono::steady_clock::time_point trigerTime;
+    //定时器的触发时间（时间刻度，单位：毫秒）
+    uint64_t m_nExpireTick;
+
+    //定时器所在的槽位（在时间轮所有槽位中的序号）
+    uint32_t m_nSlot;
+};
+
+/** 分层时间轮：添加和删除定时器的时间复杂度均为O(1)
+*   第0层有256个槽位，每个槽位对应1毫秒；第1~4层各有64个槽位，每个槽位分别对应256毫秒、16秒、17分钟、18小时，
+*   高层的槽位到期时，将其中的定时器重新分配到低层的槽位中（级联），第0层槽位中的定时器即为该时刻到期的定时器；
+*   每个槽位是否有定时器记录在位图中，推进时间轮时直接跳到下一个有定时器的槽位，耗时与经过的时间无关
+*/
+class TimerWheel
+{
+public:
+    explicit TimerWheel(uint64_t nCurrentTick):
+        m_nCurrentTick(nCurrentTick)
+    {
+        for (TimerLink& slot : m_slots) {
+            slot.m_pPrev = &slot;
+            slot.m_pNext = &slot;
+        }
+        for (uint64_t& nBits : m_slotBits) {
+            nBits = 0;
+        }
+    }
+
+    ~TimerWheel()
+    {
+        Clear();
+    }
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator = (const TimerWheel&) = delete;
+
+public:
+    /** 添加一个定时器（pTimer->m_nExpireTick为触发时间）
+    */
+    void AddTimer(std::unique_ptr<TimerInfo> pTimer)
+    {
+        ASSERT(pTimer != nullptr);
+        if (pTimer == nullptr) {
+            return;
+        }
+        TimerInfo* pTimerInfo = pTimer.get();
+        m_timers[pTimerInfo->m_nTimerId] = std::move(pTimer);
+        LinkTimer(pTimerInfo);
+    }
+
+    /** 重新设置定时器的触发时间（定时器必须已经不在时间轮中）
+    */
+    bool ResetTimer(size_t nTimerId, uint64_t nExpireTick)
+    {
+        TimerInfo* pTimer = FindTimer(nTimerId);
+        if ((pTimer == nullptr) || (pTimer->m_pNext != nullptr)) {
+            return false;
+        }
+        pTimer->m_nExpireTick = nExpireTick;
+        LinkTimer(pTimer);
+        return true;
+    }
+
+    /** 删除一个定时器（从时间轮中移除，并释放其资源）
+    */
+    void RemoveTimer(size_t nTimerId)
+    {
+        auto iter = m_timers.find(nTimerId);
+        if (iter != m_timers.end()) {
+            UnlinkTimer(iter->second.get());
+            m_timers.erase(iter);
+        }
+    }
+
+    /** 查找一个定时器
+    */
+    TimerInfo* FindTimer(size_t nTimerId) const
+    {
+        auto iter = m_timers.find(nTimerId);
+        if (iter != m_timers.end()) {
+            return iter->second.get();
+        }
+        return nullptr;
+    }
+
+    /** 推进时间轮到指定的时间刻度，到期的定时器从时间轮中移出（但不删除），其ID按到期时间顺序添加到dueTimerIds中
+    */
+    void Advance(uint64_t nTick, std::vector<size_t>& dueTimerIds)
+    {
+        while (m_nCurrentTick < nTick) {
+            //直接跳到下一个有定时器到期或者需要级联的时间刻度，中间的空槽位无需逐个处理
+            uint64_t nNextTick = 0;
+            if (!GetNextTick(nNextTick) || (nNextTick > nTick)) {
+                m_nCurrentTick = nTick;
+                break;
+            }
+            m_nCurrentTick = nNextTick - 1;
+            if ((nNextTick & kLevel0Mask) == 0) {
+                //低层转完一圈，将高层对应槽位的定时器级联到低层
+                for (uint32_t nLevel = 1; nLevel < kLevelCount; ++nLevel) {
+                    const uint32_t nIndex = GetSlotIndex(nLevel, nNextTick);
+                    CascadeSlot(nLevel, nIndex);
+                    if (nIndex != 0) {
+                        break;
+                    }
+                }
+            }
+            TimerLink& slot = GetSlot(0, GetSlotIndex(0, nNextTick));
+            while (slot.m_pNext != &slot) {
+                TimerInfo* pTimer = static_cast<TimerInfo*>(slot.m_pNext);
+                ASSERT(pTimer->m_nExpireTick == nNextTick);
+                UnlinkTimer(pTimer);
+                dueTimerIds.push_back(pTimer->m_nTimerId);
+            }
+            m_nCurrentTick = nNextTick;
+        }
+    }
+
+    /** 获取下一次需要推进时间轮的时间刻度（最早到期的定时器，或者最早需要级联的高层槽位）
+    * @return 如果时间轮中没有定时器，返回false
+    */
+    bool GetNextTick(uint64_t& nNextTick) const
+    {
+        if (m_timers.empty()) {
+            return false;
+        }
+        bool bFound = false;
+        //第0层：槽位中的定时器，触发时间是精确的
+        const uint64_t nFirstTick = m_nCurrentTick + 1;
+        const uint32_t nDistance0 = FindOccupiedSlot(0, GetSlotIndex(0, nFirstTick));
+        if (nDistance0 < kLevel0Slots) {
+            nNextTick = nFirstTick + nDistance0;
+            bFound = true;
+        }
+        //高层：槽位需要级联的时间
+        for (uint32_t nLevel = 1; nLevel < kLevelCount; ++nLevel) {
+            const uint32_t nShift = GetLevelShift(nLevel);
+            const uint64_t nFirstBlock = (m_nCurrentTick >> nShift) + 1;
+            const uint32_t nDistance = FindOccupiedSlot(nLevel, (uint32_t)(nFirstBlock & kLevelMask));
+            if (nDistance < kLevelSlots) {
+                const uint64_t nTick = (nFirstBlock + nDistance) << nShift;
+                if (!bFound || (nTick < nNextTick)) {
+                    nNextTick = nTick;
+                    bFound = true;
+                }
+            }
+        }
+        return bFound;
+    }
+
+    /** 定时器的个数
+    */
+    size_t GetTimerCount() const
+    {
+        return m_timers.size();
+    }
+
+    /** 删除所有定时器
+    */
+    void Clear()
+    {
+        for (TimerLink& slot : m_slots) {
+            slot.m_pPrev = &slot;
+            slot.m_pNext = &slot;
+        }
+        for (uint64_t& nBits : m_slotBits) {
+            nBits = 0;
+        }
+        m_timers.clear();
+    }
+
+private:
+    /** 将定时器链接到对应的槽位中
+    */
+    void LinkTimer(TimerInfo* pTimer)
+    {
+        //已经过期的定时器，在下一个时间刻度触发
+        const uint64_t nBaseTick = m_nCurrentTick + 1;
+        const uint64_t nExpireTick = std::max(pTimer->m_nExpireTick, nBaseTick);
+        pTimer->m_nExpireTick = nExpireTick;
+        const uint64_t nDelta = nExpireTick - nBaseTick;
+        uint32_t nLevel = 0;
+        while ((nLevel + 1 < kLevelCount) && (nDelta >= (1ull << GetLevelShift(nLevel + 1)))) {
+            ++nLevel;
+        }
+        const uint32_t nSlot = GetSlotPos(nLevel, GetSlotIndex(nLevel, nExpireTick));
+        TimerLink& slot = m_slots[nSlot];
+        //添加到槽位链表的尾部，保持添加的顺序
+        pTimer->m_pPrev = slot.m_pPrev;
+        pTimer->m_pNext = &slot;
+        slot.m_pPrev->m_pNext = pTimer;
+        slot.m_pPrev = pTimer;
+        pTimer->m_nSlot = nSlot;
+        m_slotBits[nSlot >> 6] |= (1ull << (nSlot & 63));
+    }
+
+    /** 将定时器从所在的槽位中移除
+    */
+    void UnlinkTimer(TimerInfo* pTimer)
+    {
+        if (pTimer->m_pNext != nullptr) {
+            pTimer->m_pPrev->m_pNext = pTimer->m_pNext;
+            pTimer->m_pNext->m_pPrev = pTimer->m_pPrev;
+            pTimer->m_pPrev = nullptr;
+            pTimer->m_pNext = nullptr;
+            const uint32_t nSlot = pTimer->m_nSlot;
+            const TimerLink& slot = m_slots[nSlot];
+            if (slot.m_pNext == &slot) {
+                //槽位已经为空
+                m_slotBits[nSlot >> 6] &= ~(1ull << (nSlot & 63));
+            }
+        }
+    }
+
+    /** 从指定的槽位开始（按槽位序号循环）查找第一个有定时器的槽位
+    * @return 返回该槽位与起始槽位的距离，如果该层所有槽位都为空，返回该层的槽位个数
+    */
+    uint32_t FindOccupiedSlot(uint32_t nLevel, uint32_t nStartIndex) const
+    {
+        //每层的槽位个数都是64的整数倍，所以位图的每个64位整数只对应同一层的槽位
+        const uint32_t nSlotCount = (nLevel == 0) ? kLevel0Slots : kLevelSlots;
+        const uint32_t nFirstSlot = GetSlotPos(nLevel, 0);
+        uint32_t nDistance = 0;
+        while (nDistance < nSlotCount) {
+            const uint32_t nSlot = nFirstSlot + ((nStartIndex + nDistance) & (nSlotCount - 1));
+            const uint64_t nBits = m_slotBits[nSlot >> 6] >> (nSlot & 63);
+            if (nBits != 0) {
+                return nDistance + (uint32_t)std::countr_zero(nBits);
+            }
+            nDistance += 64 - (nSlot & 63);
+        }
+        return nSlotCount;
+    }
+
+    /** 将高层槽位中的定时器，重新分配到低层的槽位中
+    */
+    void CascadeSlot(uint32_t nLevel, uint32_t nIndex)
+    {
+        const uint32_t nSlot = GetSlotPos(nLevel, nIndex);
+        TimerLink& slot = m_slots[nSlot];
+        TimerLink* pLink = slot.m_pNext;
+        slot.m_pPrev = &slot;
+        slot.m_pNext = &slot;
+        m_slotBits[nSlot >> 6] &= ~(1ull << (nSlot & 63));
+        while (pLink != &slot) {
+            TimerInfo* pTimer = static_cast<TimerInfo*>(pLink);
+            pLink = pLink->m_pNext;
+            LinkTimer(pTimer);
+        }
+    }
+
+    /** 每层的时间刻度位移：第0层为0，第1层为8，第2层为14，以此类推
+    */
+    static uint32_t GetLevelShift(uint32_t nLevel)
+    {
+        return (nLevel == 0) ? 0 : (kLevel0Bits + (nLevel - 1) * kLevelBits);
+    }
+
+    /** 时间刻度在指定层中的槽位序号
+    */
+    static uint32_t GetSlotIndex(uint32_t nLevel, uint64_t nTick)
+    {
+        const uint64_t nMask = (nLevel == 0) ? kLevel0Mask : kLevelMask;
+        return (uint32_t)((nTick >> GetLevelShift(nLevel)) & nMask);
+    }
+
+    /** 指定层的槽位在所有槽位中的序号
+    */
+    static uint32_t GetSlotPos(uint32_t nLevel, uint32_t nIndex)
+    {
+        return (nLevel == 0) ? nIndex : (kLevel0Slots + (nLevel - 1) * kLevelSlots + nIndex);
+    }
+
+    TimerLink& GetSlot(uint32_t nLevel, uint32_t nIndex)
+    {
+        return m_slots[GetSlotPos(nLevel, nIndex)];
+    }
+
+private:
+    static constexpr uint32_t kLevel0Bits = 8;
+    static constexpr uint32_t kLevelBits = 6;
+    static constexpr uint32_t kLevelCount = 5;
+    static constexpr uint32_t kLevel0Slots = 1u << kLevel0Bits;
+    static constexpr uint32_t kLevelSlots = 1u << kLevelBits;
+    static constexpr uint64_t kLevel0Mask = kLevel0Slots - 1;
+    static constexpr uint64_t kLevelMask = kLevelSlots - 1;
+
+    /** 所有层的槽位（链表头），第0层在前，然后依次是第1~4层
+    */
+    TimerLink m_slots[kLevel0Slots + (kLevelCount - 1) * kLevelSlots];
+
+    /** 槽位是否有定时器的位图（每个槽位对应1位，序号与m_slots相同）
+    */
+    uint64_t m_slotBits[(kLevel0Slots + (kLevelCount - 1) * kLevelSlots) / 64];
+
+    /** 定时器ID与定时器数据的映射表（定时器数据的所有者）
+    */
+    std::unordered_map<size_t, std::unique_ptr<TimerInfo>> m_timers;
+
+    /** 时间轮已经推进到的时间刻度（该时刻及之前到期的定时器已经处理）
+    */
+    uint64_t m_nCurrentTick;
 };
 
 TimerManager::TimerManager():
     m_nNextTimerId(1),
+    m_nFrameIntervalMs(0),
     m_bRunning(false),
     m_bHasPenddingPoll(false)
 {
+    m_startTime = std::chrono::steady_clock::now();
+    m_pTimerWheel = std::make_unique<TimerWheel>(GetCurrentTick());
 }
 
 TimerManager::~TimerManager()
@@ -78,10 +387,8 @@ void TimerManager::Clear()
 {
     std::unique_lock<std::mutex> guard(m_taskMutex);
     m_threadMsg.Clear();
-    while (!m_aTimers.empty()) {
-        m_aTimers.pop();
-    }
-    m_removedTimerIds.clear();
+    m_pTimerWheel->Clear();
+    m_dueTimerIds.clear();
     m_bRunning = false;
     if (m_pWorkerThread != nullptr) {
         m_cv.notify_one();
@@ -91,6 +398,20 @@ void TimerManager::Clear()
     }
 }
 
+uint64_t TimerManager::GetCurrentTick() const
+{
+    auto nElapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_startTime);
+    return (uint64_t)nElapsedMs.count();
+}
+
+uint64_t TimerManager::GetAdvanceTick(uint64_t nCurrentTick) const
+{
+    if (m_nFrameIntervalMs > 0) {
+        return nCurrentTick - (nCurrentTick % m_nFrameIntervalMs);
+    }
+    return nCurrentTick;
+}
+
 size_t TimerManager::AddTimer(const std::weak_ptr<WeakFlag>& weakFlag, const TimerCallback& callback,
                               uint32_t uElapseMs, int32_t iRepeatTime)
 {
@@ -101,19 +422,17 @@ size_t TimerManager::AddTimer(const std::weak_ptr<WeakFlag>& weakFlag, const Tim
     if (iRepeatTime < 0) {
         iRepeatTime = -1;
     }
-    size_t nTimerId = m_nNextTimerId++;
-    TimerInfo pTimer;
-    pTimer.m_nTimerId = nTimerId;
-
-    pTimer.timerCallback = callback;
-    pTimer.uElapseMs = uElapseMs;
-    pTimer.trigerTime = std::chrono::steady_clock::now();
-    pTimer.trigerTime += std::chrono::milliseconds(uElapseMs); //计算出下次触发时间(当前时间 + 间隔的毫秒数)
-    pTimer.uRepeatTime = static_cast<uint32_t>(iRepeatTime);
-    pTimer.weakFlag = weakFlag;
+    std::unique_ptr<TimerInfo> pTimer = std::make_unique<TimerInfo>();
+    pTimer->timerCallback = callback;
+    pTimer->uElapseMs = uElapseMs;
+    pTimer->m_nExpireTick = GetCurrentTick() + uElapseMs; //计算出下次触发时间(当前时间 + 间隔的毫秒数)
+    pTimer->uRepeatTime = static_cast<uint32_t>(iRepeatTime);
+    pTimer->weakFlag = weakFlag;
 
     std::lock_guard<std::mutex> threadGuard(m_taskMutex);
-    m_aTimers.push(pTimer);
+    size_t nTimerId = m_nNextTimerId++;
+    pTimer->m_nTimerId = nTimerId;
+    m_pTimerWheel->AddTimer(std::move(pTimer));
     if (m_pWorkerThread == nullptr) {
         //启动线程
         m_bRunning = true;
@@ -128,22 +447,22 @@ size_t TimerManager::AddTimer(const std::weak_ptr<WeakFlag>& weakFlag, const Tim
 void TimerManager::RemoveTimer(size_t nTimerId)
 {
     std::lock_guard<std::mutex> threadGuard(m_taskMutex);
-    m_removedTimerIds.insert(nTimerId);
+    m_pTimerWheel->RemoveTimer(nTimerId);
 }
 
-bool TimerManager::IsTimerRemoved(size_t nTimerId) const
+void TimerManager::SetFrameInterval(uint32_t nFrameIntervalMs)
 {
-    if (!m_removedTimerIds.empty()) {
-        return m_removedTimerIds.find(nTimerId) != m_removedTimerIds.end();
-    }
-    else {
-        return false;
+    std::lock_guard<std::mutex> threadGuard(m_taskMutex);
+    if (m_nFrameIntervalMs != nFrameIntervalMs) {
+        m_nFrameIntervalMs = nFrameIntervalMs;
+        //唤醒工作线程，重新计算等待时间
+        m_cv.notify_one();
     }
 }
 
-void TimerManager::ClearRemovedTimerId(size_t nTimerId)
+uint32_t TimerManager::GetFrameInterval() const
 {
-    m_removedTimerIds.erase(nTimerId);
+    return m_nFrameIntervalMs;
 }
 
 void TimerManager::OnTimerMessage(uint32_t msgId, WPARAM /*wParam*/, LPARAM /*lParam*/)
@@ -160,48 +479,59 @@ void TimerManager::Poll()
 {
     //该函数在UI线程中调用
     std::unique_lock<std::mutex> taskGuard(m_taskMutex);
-    while (!m_aTimers.empty()) {
-        if (m_aTimers.top().weakFlag.expired() || IsTimerRemoved(m_aTimers.top().m_nTimerId)) {
-            //删除已经失效或者取消的定时器
-            ClearRemovedTimerId(m_aTimers.top().m_nTimerId);
-            m_aTimers.pop();
+    m_pTimerWheel->Advance(GetAdvanceTick(GetCurrentTick()), m_dueTimerIds);
+    std::vector<size_t> dueTimerIds;
+    dueTimerIds.swap(m_dueTimerIds);
+    for (size_t nTimerId : dueTimerIds) {
+        TimerInfo* pTimer = m_pTimerWheel->FindTimer(nTimerId);
+        if (pTimer == nullptr) {
+            //定时器已经取消
+            continue;
         }
-        else if (std::chrono::steady_clock::now() >= m_aTimers.top().trigerTime) {
-            //队列顶的定时器：已经达到定时器触发条件
-            TimerInfo timerTask = m_aTimers.top();
-            m_aTimers.pop();
-
-            if (!timerTask.weakFlag.expired()) {
-                //调用定时器的回调函数
-                taskGuard.unlock();
-                timerTask.timerCallback();
-                //LogUtil::OutputLine(StringUtil::Printf(_T("timerTask.timerCallback(): exec. TimerId: %u, ElapseMs: %u"), timerTask.m_nTimerId, timerTask.uElapseMs));
-                taskGuard.lock();
-            }
-            if (timerTask.uRepeatTime > 0) {
-                timerTask.uRepeatTime--;
-            }
-            if ((timerTask.uRepeatTime > 0) &&
-                !timerTask.weakFlag.expired() &&
-                !IsTimerRemoved(timerTask.m_nTimerId)) {
-                //如果未达到触发次数限制，重新设置下次触发的时间
-                timerTask.trigerTime = std::chrono::steady_clock::now();
-                timerTask.trigerTime += std::chrono::milliseconds(timerTask.uElapseMs); //计算出下次触发时间(当前时间 + 间隔的毫秒数)
-                m_aTimers.push(timerTask);
-            }
-            else {
-                //执行已完成或者已经失效
-                ClearRemovedTimerId(timerTask.m_nTimerId);
+        if (pTimer->weakFlag.expired()) {
+            //删除已经失效的定时器
+            m_pTimerWheel->RemoveTimer(nTimerId);
+            continue;
+        }
+        //调用定时器的回调函数（回调函数中可能会删除该定时器，所以先复制回调函数）
+        TimerCallback timerCallback = pTimer->timerCallback;
+        std::weak_ptr<WeakFlag> weakFlag = pTimer->weakFlag;
+        taskGuard.unlock();
+        if (!weakFlag.expired()) {
+            timerCallback();
+        }
+        //LogUtil::OutputLine(StringUtil::Printf(_T("timerTask.timerCallback(): exec. TimerId: %u"), nTimerId));
+        taskGuard.lock();
+
+        pTimer = m_pTimerWheel->FindTimer(nTimerId);
+        if (pTimer == nullptr) {
+            //回调函数中已经删除了该定时器
+            continue;
+        }
+        if (pTimer->uRepeatTime > 0) {
+            pTimer->uRepeatTime--;
+        }
+        if ((pTimer->uRepeatTime > 0) && !pTimer->weakFlag.expired()) {
+            //如果未达到触发次数限制，重新设置下次触发的时间(当前时间 + 间隔的毫秒数)
+            const uint64_t nCurrentTick = GetCurrentTick();
+            uint64_t nExpireTick = nCurrentTick + pTimer->uElapseMs;
+            if (m_nFrameIntervalMs > 0) {
+                //按帧对齐时，从上次的触发时间开始计算，避免定时器在帧的边界之后回调，下次触发被推迟到再下一帧
+                nExpireTick = pTimer->m_nExpireTick + pTimer->uElapseMs;
+                if (nExpireTick <= nCurrentTick) {
+                    nExpireTick = nCurrentTick + pTimer->uElapseMs;
+                }
             }
+            m_pTimerWheel->ResetTimer(nTimerId, nExpireTick);
         }
         else {
-            //已经没有触发的定时器任务
-            break;
+            //执行已完成或者已经失效
+            m_pTimerWheel->RemoveTimer(nTimerId);
         }
     }
     //唤醒工作线程，检查任务状态
-    m_cv.notify_one();
     m_bHasPenddingPoll = false;
+    m_cv.notify_one();
 }
 
 void TimerManager::WorkerThreadProc()
@@ -211,78 +541,79 @@ void TimerManager::WorkerThreadProc()
         if (!m_bRunning) {
             break;
         }
-        if (m_aTimers.empty()) {
-            //为空，等待任务
+        if (m_bHasPenddingPoll) {
+            //等待主线程处理定时器的回调事件
             m_cv.wait(taskGuard);
-            if (!m_bRunning) {
-                break;
-            }
+            continue;
         }
-        else {
-            //计算最早的任务，等待超时
-            uint32_t nDetaTimeMs = 0;
-            auto currentTime = std::chrono::steady_clock::now();
-            if (m_aTimers.top().weakFlag.expired() || IsTimerRemoved(m_aTimers.top().m_nTimerId)) {
-                //删除已经失效或者取消的定时器
-                nDetaTimeMs = 0;
-            }
-            else if (currentTime >= m_aTimers.top().trigerTime) {
-                //队列顶的定时器：已经达到定时器触发条件
-                nDetaTimeMs = 0;
+
+        //推进时间轮（高层槽位的级联在工作线程中完成，只有存在到期的定时器时才通知主线程）
+        const uint64_t nCurrentTick = GetCurrentTick();
+        m_pTimerWheel->Advance(GetAdvanceTick(nCurrentTick), m_dueTimerIds);
+        if (m_dueTimerIds.empty()) {
+            uint64_t nNextTick = 0;
+            if (!m_pTimerWheel->GetNextTick(nNextTick)) {
+                //为空，等待任务
+                m_cv.wait(taskGuard);
+                continue;
             }
-            else {
-                //已经没有触发的定时器任务
-                auto nDiffTimeMs = std::chrono::duration_cast<std::chrono::milliseconds>(m_aTimers.top().trigerTime - currentTime);
-                nDetaTimeMs = (uint32_t)nDiffTimeMs.count();
+            if (m_nFrameIntervalMs > 0) {
+                //按帧对齐：等待到下一帧的边界，同一帧内到期的定时器一起触发
+                nNextTick = ((nNextTick + m_nFrameIntervalMs - 1) / m_nFrameIntervalMs) * m_nFrameIntervalMs;
             }
-
-            if (nDetaTimeMs > 0) {
+            if (nNextTick > nCurrentTick) {
                 //延迟等待超时
-                //LogUtil::OutputLine(StringUtil::Printf(_T("condition_variable: wait_for timer event(%u ms)"), nDetaTimeMs));
+                //LogUtil::OutputLine(StringUtil::Printf(_T("condition_variable: wait_for timer event(%u ms)"), (uint32_t)(nNextTick - nCurrentTick)));
                 //该函数精确度10ms左右
                 //注意事项：发现gcc版本和glibc版本对wait_for都有问题（使用的时系统时间），gcc >=10 且 glibc >= 2.30 才会对程序行为没有影响。
-                m_cv.wait_for(taskGuard, std::chrono::milliseconds(nDetaTimeMs));
+                m_cv.wait_for(taskGuard, std::chrono::milliseconds(nNextTick - nCurrentTick));
             }
-            //通知处理(发送到主线程执行, 此时不能加锁，避免出现死锁问题)
-            m_bHasPenddingPoll = true;
-            taskGuard.unlock();
+            continue;
+        }
+
+        //通知处理(发送到主线程执行, 此时不能加锁，避免出现死锁问题)
+        m_bHasPenddingPoll = true;
+        taskGuard.unlock();
 
-            uint32_t nErrorCode = 0;
-            bool bRet = m_threadMsg.PostMsg(WM_USER_DEFINED_TIMER, 0, 0, &nErrorCode);
+        uint32_t nErrorCode = 0;
+        bool bRet = m_threadMsg.PostMsg(WM_USER_DEFINED_TIMER, 0, 0, &nErrorCode);
 #if defined (DUILIB_BUILD_FOR_WIN) && !defined (DUILIB_BUILD_FOR_SDL)
-            if (!bRet) {
-                if ((nErrorCode == ERROR_NOT_ENOUGH_QUOTA) && !GlobalManager::Instance().IsInUIThread()) {
-                    //在程序启动时，如果在子线程向主线程Post消息，会遇到此错误
-                    for (int32_t i = 0; i < 200; ++i) {
-                        ::Sleep(50);
-                        if (!m_bRunning) {
-                            break;
-                        }
-                        bRet = m_threadMsg.PostMsg(WM_USER_DEFINED_TIMER, 0, 0, &nErrorCode);
-                        if (bRet || (nErrorCode != ERROR_NOT_ENOUGH_QUOTA)) {
-                            break;
-                        }
+        if (!bRet) {
+            if ((nErrorCode == ERROR_NOT_ENOUGH_QUOTA) && !GlobalManager::Instance().IsInUIThread()) {
+                //在程序启动时，如果在子线程向主线程Post消息，会遇到此错误
+                for (int32_t i = 0; i < 200; ++i) {
+                    ::Sleep(50);
+                    if (!m_bRunning) {
+                        break;
+                    }
+                    bRet = m_threadMsg.PostMsg(WM_USER_DEFINED_TIMER, 0, 0, &nErrorCode);
+                    if (bRet || (nErrorCode != ERROR_NOT_ENOUGH_QUOTA)) {
+                        break;
                     }
                 }
-                if (m_bRunning) {
-                    ASSERT_UNUSED_VARIABLE(bRet);
-                }                
             }
-#else
             if (m_bRunning) {
                 ASSERT_UNUSED_VARIABLE(bRet);
-            }
+            }                
+        }
+#else
+        if (m_bRunning) {
+            ASSERT_UNUSED_VARIABLE(bRet);
+        }
 #endif
-            taskGuard.lock();
-            if (m_bRunning) {
-                ASSERT_UNUSED_VARIABLE(bRet);
-            }            
-            //LogUtil::OutputLine(StringUtil::Printf(_T("PostMessage: send timer event")));
+        taskGuard.lock();
+        //LogUtil::OutputLine(StringUtil::Printf(_T("PostMessage: send timer event")));
 
-            if (m_bRunning && m_bHasPenddingPoll) {
-                m_cv.wait(taskGuard);
+        if (!bRet) {
+            //通知失败，稍后重试
+            m_bHasPenddingPoll = false;
+            if (m_bRunning) {
+                m_cv.wait_for(taskGuard, std::chrono::milliseconds(10));
             }
-        }        
+        }
+        else if (m_bRunning && m_bHasPenddingPoll) {
+            m_cv.wait(taskGuard);
+        }
     }
     m_bRunning = false;
 }
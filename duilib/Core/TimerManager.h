@@ -3,8 +3,7 @@
 
 #include "duilib/Core/Callback.h"
 #include "duilib/Core/ThreadMessage.h"
-#include <queue>
-#include <set>
+#include <vector>
 #include <chrono>
 #include <thread>
 #include <mutex>
@@ -16,7 +15,7 @@ namespace ui
 /** 定时器回调函数原型：void FunctionName();
 */
 typedef std::function<void()> TimerCallback;
-class TimerInfo;
+class TimerWheel;
 
 /** 定时器管理器
 */
@@ -52,6 +51,16 @@ public:
     */
     void RemoveTimer(size_t nTimerId);
 
+    /** 设置按帧对齐的时间间隔：同一帧内到期的所有定时器，合并为一次UI线程唤醒（在帧的边界处统一触发）
+    *   动画的帧时钟（AnimationFrameClock）运行期间，按其帧间隔设置，帧时钟停止时恢复为0
+    * @param [in] nFrameIntervalMs 每帧的时间间隔，单位为毫秒（比如60Hz的显示器为16毫秒），为0表示不按帧对齐（默认）
+    */
+    void SetFrameInterval(uint32_t nFrameIntervalMs);
+
+    /** 获取按帧对齐的时间间隔，单位为毫秒，为0表示不按帧对齐
+    */
+    uint32_t GetFrameInterval() const;
+
     /** 关闭定时器管理器，释放资源
      */
     void Clear();
@@ -65,13 +74,13 @@ private:
     */
     void Poll();
 
-    /** 是否定时器任务已经被取消
+    /** 获取当前时间对应的时间刻度（从定时器管理器创建开始计算的毫秒数）
     */
-    bool IsTimerRemoved(size_t nTimerId) const;
+    uint64_t GetCurrentTick() const;
 
-    /** 移除已经取消的定时器任务ID
+    /** 获取本次需要推进到的时间刻度（按帧对齐时，只推进到当前帧的起始位置）
     */
-    void ClearRemovedTimerId(size_t nTimerId);
+    uint64_t GetAdvanceTick(uint64_t nCurrentTick) const;
 
 private:
     /** 消息窗口函数
@@ -79,17 +88,25 @@ private:
     void OnTimerMessage(uint32_t msgId, WPARAM wParam, LPARAM lParam);
 
 private:
-    /** 所有注册的定时器
+    /** 所有注册的定时器（分层时间轮）
     */
-    std::priority_queue<TimerInfo> m_aTimers;
+    std::unique_ptr<TimerWheel> m_pTimerWheel;
+
+    /** 已经到期，等待在UI线程中回调的定时器任务ID（按到期时间排序）
+    */
+    std::vector<size_t> m_dueTimerIds;
 
     /** 下一个定时器任务ID
     */
     size_t m_nNextTimerId;
 
-    /** 移除的定时器任务ID
+    /** 按帧对齐的时间间隔，单位为毫秒，为0表示不按帧对齐
+    */
+    uint32_t m_nFrameIntervalMs;
+
+    /** 时间刻度的起始时间
     */
-    std::set<size_t> m_removedTimerIds;
+    std::chrono::steady_clock::time_point m_startTime;
 
 private:
     /** 是否正在运行中
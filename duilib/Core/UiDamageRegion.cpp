@@ -0,0 +1,165 @@
+#include "UiDamageRegion.h"
+
+namespace ui
+{
+UiDamageRegion::UiDamageRegion(size_t nMaxRectCount):
+    m_nMaxRectCount(nMaxRectCount)
+{
+    if (m_nMaxRectCount < 1) {
+        m_nMaxRectCount = 1;
+    }
+}
+
+void UiDamageRegion::AddRect(const UiRect& rc)
+{
+    if (rc.IsEmpty()) {
+        return;
+    }
+    for (const UiRect& rcExist : m_rects) {
+        if (rcExist.ContainsRect(rc)) {
+            //已经包含在脏区域中
+            return;
+        }
+    }
+    InsertRect(rc);
+    MergeToLimit();
+}
+
+void UiDamageRegion::InsertRect(const UiRect& rc)
+{
+    UiRect rcNew = rc;
+    bool bMerged = true;
+    while (bMerged) {
+        bMerged = false;
+        for (size_t nIndex = 0; nIndex < m_rects.size(); ++nIndex) {
+            if (ShouldMerge(m_rects[nIndex], rcNew)) {
+                //合并后的矩形可能与其他矩形相交，需要重新检查
+                rcNew.Union(m_rects[nIndex]);
+                m_rects.erase(m_rects.begin() + nIndex);
+                bMerged = true;
+                break;
+            }
+        }
+    }
+    m_rects.push_back(rcNew);
+    m_rcBounds.Union(rcNew);
+}
+
+void UiDamageRegion::Clear()
+{
+    m_rects.clear();
+    m_rcBounds.Clear();
+}
+
+bool UiDamageRegion::IsEmpty() const
+{
+    return m_rects.empty();
+}
+
+const std::vector<UiRect>& UiDamageRegion::GetRects() const
+{
+    return m_rects;
+}
+
+const UiRect& UiDamageRegion::GetBounds() const
+{
+    return m_rcBounds;
+}
+
+int64_t UiDamageRegion::GetArea() const
+{
+    int64_t nArea = 0;
+    for (const UiRect& rc : m_rects) {
+        nArea += RectArea(rc);
+    }
+    return nArea;
+}
+
+void UiDamageRegion::Intersect(const UiRect& rc)
+{
+    auto iter = m_rects.begin();
+    while (iter != m_rects.end()) {
+        if (!iter->Intersect(rc)) {
+            iter = m_rects.erase(iter);
+        }
+        else {
+            ++iter;
+        }
+    }
+    UpdateBounds();
+}
+
+void UiDamageRegion::SetMaxRectCount(size_t nMaxRectCount)
+{
+    m_nMaxRectCount = (nMaxRectCount < 1) ? 1 : nMaxRectCount;
+    MergeToLimit();
+}
+
+size_t UiDamageRegion::GetMaxRectCount() const
+{
+    return m_nMaxRectCount;
+}
+
+int64_t UiDamageRegion::RectArea(const UiRect& rc)
+{
+    if (rc.IsEmpty()) {
+        return 0;
+    }
+    return (int64_t)rc.Width() * rc.Height();
+}
+
+int64_t UiDamageRegion::MergeCost(const UiRect& a, const UiRect& b)
+{
+    UiRect rcUnion = a;
+    rcUnion.Union(b);
+    UiRect rcIntersect;
+    UiRect::Intersect(rcIntersect, a, b);
+    return RectArea(rcUnion) - (RectArea(a) + RectArea(b) - RectArea(rcIntersect));
+}
+
+bool UiDamageRegion::ShouldMerge(const UiRect& a, const UiRect& b)
+{
+    UiRect rcIntersect;
+    if (UiRect::Intersect(rcIntersect, a, b)) {
+        //相交的矩形必须合并，保证各个矩形之间互不相交
+        return true;
+    }
+    //合并后浪费的面积不超过两个矩形面积之和的1/4时，合并（比如相邻的两个矩形）
+    const int64_t nCost = MergeCost(a, b);
+    return (nCost * 4) <= (RectArea(a) + RectArea(b));
+}
+
+void UiDamageRegion::MergeToLimit()
+{
+    while (m_rects.size() > m_nMaxRectCount) {
+        //选择合并后浪费面积最小的两个矩形
+        size_t nFirst = 0;
+        size_t nSecond = 1;
+        int64_t nMinCost = -1;
+        for (size_t i = 0; i < m_rects.size(); ++i) {
+            for (size_t j = i + 1; j < m_rects.size(); ++j) {
+                const int64_t nCost = MergeCost(m_rects[i], m_rects[j]);
+                if ((nMinCost < 0) || (nCost < nMinCost)) {
+                    nMinCost = nCost;
+                    nFirst = i;
+                    nSecond = j;
+                }
+            }
+        }
+        UiRect rcMerged = m_rects[nFirst];
+        rcMerged.Union(m_rects[nSecond]);
+        m_rects.erase(m_rects.begin() + nSecond);
+        m_rects.erase(m_rects.begin() + nFirst);
+        InsertRect(rcMerged);
+    }
+}
+
+void UiDamageRegion::UpdateBounds()
+{
+    m_rcBounds.Clear();
+    for (const UiRect& rc : m_rects) {
+        m_rcBounds.Union(rc);
+    }
+}
+
+} // namespace ui
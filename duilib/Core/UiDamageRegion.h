@@ -0,0 +1,103 @@
+#ifndef UI_CORE_UIDAMAGE_REGION_H_
+#define UI_CORE_UIDAMAGE_REGION_H_
+
+#include "duilib/Core/UiRect.h"
+#include <vector>
+
+namespace ui
+{
+/** 窗口的脏区域（需要重绘的区域），由若干个互不相交的矩形组成
+*   添加矩形时按以下规则合并：
+*   (1) 与已有矩形相交或者合并后浪费的面积较小时，合并为一个矩形；
+*   (2) 矩形个数超过上限时，合并浪费面积最小的两个矩形。
+*   这样，相距较远的多个小区域（比如左上角的光标和右下角的进度条）不会被合并为一个大的外接矩形，
+*   绘制和提交到屏幕的数据量与实际变化的像素数量相当
+*/
+class UILIB_API UiDamageRegion
+{
+public:
+    /** 构造函数
+    * @param [in] nMaxRectCount 矩形个数的上限，超过上限时会合并矩形
+    */
+    explicit UiDamageRegion(size_t nMaxRectCount = 8);
+
+    /** 添加一个脏区域
+    * @param [in] rc 需要重绘的矩形区域
+    */
+    void AddRect(const UiRect& rc);
+
+    /** 清空脏区域
+    */
+    void Clear();
+
+    /** 判断是否为空
+    */
+    bool IsEmpty() const;
+
+    /** 获取脏区域的矩形列表（各个矩形之间互不相交）
+    */
+    const std::vector<UiRect>& GetRects() const;
+
+    /** 获取所有脏区域的外接矩形
+    */
+    const UiRect& GetBounds() const;
+
+    /** 获取所有脏区域的总面积
+    */
+    int64_t GetArea() const;
+
+    /** 与指定的矩形取交集，并删除交集为空的矩形
+    * @param [in] rc 限定的矩形范围（比如窗口的客户区）
+    */
+    void Intersect(const UiRect& rc);
+
+    /** 设置矩形个数的上限
+    */
+    void SetMaxRectCount(size_t nMaxRectCount);
+
+    /** 获取矩形个数的上限
+    */
+    size_t GetMaxRectCount() const;
+
+private:
+    /** 插入一个矩形，并与相交或者相邻的矩形合并
+    */
+    void InsertRect(const UiRect& rc);
+
+    /** 计算矩形的面积
+    */
+    static int64_t RectArea(const UiRect& rc);
+
+    /** 两个矩形合并后浪费的面积（外接矩形的面积 - 两个矩形覆盖的面积）
+    */
+    static int64_t MergeCost(const UiRect& a, const UiRect& b);
+
+    /** 判断两个矩形是否应该合并
+    */
+    static bool ShouldMerge(const UiRect& a, const UiRect& b);
+
+    /** 合并浪费面积最小的两个矩形，直到矩形个数不超过上限
+    */
+    void MergeToLimit();
+
+    /** 重新计算外接矩形
+    */
+    void UpdateBounds();
+
+private:
+    /** 矩形列表（互不相交）
+    */
+    std::vector<UiRect> m_rects;
+
+    /** 外接矩形
+    */
+    UiRect m_rcBounds;
+
+    /** 矩形个数的上限
+    */
+    size_t m_nMaxRectCount;
+};
+
+} // namespace ui
+
+#endif // UI_CORE_UIDAMAGE_REGION_H_
@@ -0,0 +1,45 @@
+#include "UiNamedColor.h"
+#include "duilib/Core/Control.h"
+#include "duilib/Core/Window.h"
+#include "duilib/Core/GlobalManager.h"
+
+namespace ui
+{
+
+UiNamedColor::UiNamedColor():
+    m_nGlobalVersion(0),
+    m_nWindowVersion(0)
+{
+}
+
+UiNamedColor& UiNamedColor::operator = (const DString& colorName)
+{
+    m_colorName = colorName;
+    m_color = UiColor();
+    m_nGlobalVersion = 0;
+    m_nWindowVersion = 0;
+    return *this;
+}
+
+UiColor UiNamedColor::GetColor(const Control* pControl) const
+{
+    if (m_colorName.empty()) {
+        return UiColor();
+    }
+    const uint32_t nGlobalVersion = GlobalManager::Instance().Color().GetColorVersion();
+    const Window* pWindow = (pControl != nullptr) ? pControl->GetWindow() : nullptr;
+    const uint32_t nWindowVersion = (pWindow != nullptr) ? pWindow->GetTextColorVersion() : 0;
+    if ((m_nGlobalVersion != nGlobalVersion) || (m_nWindowVersion != nWindowVersion)) {
+        if (pControl != nullptr) {
+            m_color = pControl->GetUiColor(m_colorName.c_str());
+        }
+        else {
+            m_color = GlobalManager::Instance().Color().GetColor(m_colorName.c_str());
+        }
+        m_nGlobalVersion = nGlobalVersion;
+        m_nWindowVersion = nWindowVersion;
+    }
+    return m_color;
+}
+
+} // namespace ui
@@ -0,0 +1,63 @@
+#ifndef UI_CORE_UINAMED_COLOR_H_
+#define UI_CORE_UINAMED_COLOR_H_
+
+#include "duilib/Core/UiColor.h"
+#include "duilib/Core/UiString.h"
+
+namespace ui
+{
+class Control;
+
+/** 颜色名称及其预先解析的颜色值
+*   颜色名称（如"white"或者"#FFFFFFFF"）在第一次使用时解析为颜色值并缓存，
+*   之后仅在解析时使用的颜色表变化（全局颜色表或者控件所在窗口的颜色表的版本号变化，参见ColorMap::GetVersion）时重新解析，
+*   避免每次绘制时都要解析颜色字符串和查找颜色表
+*/
+class UILIB_API UiNamedColor
+{
+public:
+    UiNamedColor();
+
+    /** 设置颜色名称（缓存的颜色值失效）
+    */
+    UiNamedColor& operator = (const DString& colorName);
+
+    /** 颜色名称是否为空
+    */
+    bool empty() const { return m_colorName.empty(); }
+
+    /** 获取颜色名称
+    */
+    const DString::value_type* c_str() const { return m_colorName.c_str(); }
+
+    /** 获取颜色值
+    * @param [in] pControl 关联的控件（颜色名称按控件所在窗口的颜色表解析），为nullptr时按全局颜色表解析
+    */
+    UiColor GetColor(const Control* pControl) const;
+
+    /** 比较颜色名称
+    */
+    friend bool operator == (const UiNamedColor& a, const DString& b) { return a.m_colorName == b; }
+    friend bool operator != (const UiNamedColor& a, const DString& b) { return a.m_colorName != b; }
+
+private:
+    /** 颜色名称
+    */
+    UiString m_colorName;
+
+    /** 解析后的颜色值
+    */
+    mutable UiColor m_color;
+
+    /** 解析颜色值时全局颜色表的版本号，0表示未解析
+    */
+    mutable uint32_t m_nGlobalVersion;
+
+    /** 解析颜色值时控件所在窗口的颜色表的版本号，0表示没有窗口（颜色名称优先按窗口的颜色表解析）
+    */
+    mutable uint32_t m_nWindowVersion;
+};
+
+} // namespace ui
+
+#endif // UI_CORE_UINAMED_COLOR_H_
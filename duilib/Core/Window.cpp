@@ -26,11 +26,14 @@ Window::Window() :
     m_bFirstLayout(false),
     m_bInitLayout(false),
     m_bIsArranged(false),
+    m_nLayoutVisitCount(0),
+    m_nLastLayoutVisitCount(0),
     m_bPostQuitMsgWhenClosed(false),
     m_renderBackendType(RenderBackendType::kRaster_BackendType),
     m_bWindowAttributesApplied(false),
     m_bCheckSetWindowFocus(false),
-    m_bControlFullscreen(false)
+    m_bControlFullscreen(false),
+    m_pPaintRects(nullptr)
 {
     m_toolTip = std::make_unique<ToolTip>();
 }
@@ -425,6 +428,8 @@ void Window::ClearWindow()
         delete pRoot;
         pRoot = nullptr;
     }
+    m_layerCache.Clear();
+    m_arrangeControls.clear();
 
     RemoveAllClass();
     RemoveAllOptionGroups();
@@ -511,6 +516,8 @@ void Window::ReapObjects(Control* pControl)
         bFocusChanged = (m_pFocus != nullptr) ? true : false;
         m_pFocus = nullptr;        
     }
+    m_layerCache.RemoveLayer(pControl);
+    m_arrangeControls.erase(pControl);
     if (!IsClosingWnd()) {
         m_controlFinder.RemoveControl(pControl);
         if (bFocusChanged) {
@@ -599,6 +606,11 @@ void Window::RemoveTextColor(const DString& strName)
     m_colorMap.RemoveColor(strName);
 }
 
+uint32_t Window::GetTextColorVersion() const
+{
+    return m_colorMap.GetVersion();
+}
+
 bool Window::AddOptionGroup(const DString& strGroupName, Control* pControl)
 {
     ASSERT(!strGroupName.empty());
@@ -773,14 +785,45 @@ void Window::InvalidateAll()
 {
     UiRect rcClient;
     GetClientRect(rcClient);
+    m_layerCache.InvalidateAll();
     Invalidate(rcClient);
 }
 
+ControlLayerCache& Window::GetLayerCache()
+{
+    return m_layerCache;
+}
+
+bool Window::IsRectNeedPaint(IRender* pRender, const UiRect& rc) const
+{
+    if ((m_pPaintRects == nullptr) || (pRender == nullptr) || (pRender != m_render.get())) {
+        return true;
+    }
+    //转换为客户区坐标后，与各个脏区域逐个比较
+    const UiPoint ptOrg = pRender->GetWindowOrg();
+    UiRect rcClient = rc;
+    rcClient.Offset(ptOrg.x, ptOrg.y);
+    UiRect rcTemp;
+    for (const UiRect& rcPaint : *m_pPaintRects) {
+        if (UiRect::Intersect(rcTemp, rcClient, rcPaint)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void Window::OnWindowAlphaChanged()
 {
     InvalidateAll();
 }
 
+void Window::OnWindowInvalidate(const UiRect& rcItem)
+{
+    if (!m_layerCache.IsEmpty()) {
+        m_layerCache.InvalidateRect(rcItem);
+    }
+}
+
 void Window::OnWindowEnterFullscreen()
 {
 }
@@ -1220,16 +1263,16 @@ LRESULT Window::OnPaintMsg(const UiRect& rcPaint, const NativeMsg& /*nativeMsg*/
         //首次绘制的时候，需要完整绘制（避免初始窗口部分在屏幕外时，然后拖动窗口到屏幕中间时，界面显示不完整的问题）
         UiRect rc;
         GetClientRect(rc);
-        bHandled = Paint(rc);
+        bHandled = Paint(rc, std::vector<UiRect>());
     }
     else {
         //非首次绘制时，只绘制脏区域
-        bHandled = Paint(rcPaint);
+        bHandled = Paint(rcPaint, GetPaintRects());
     }
     return 0;
 }
 
-bool Window::Paint(const UiRect& rcPaint)
+bool Window::Paint(const UiRect& rcPaint, const std::vector<UiRect>& paintRects)
 {
     GlobalManager::Instance().AssertUIThread();
     IRender* pRender = GetRender();
@@ -1253,7 +1296,10 @@ bool Window::Paint(const UiRect& rcPaint)
         PerformanceStat statPerformance(_T("PaintWindow, Window::Paint Paint/PaintChild"));
         AutoClip rectClip(pRender, rcPaint, true);
         UiPoint ptOldWindOrg = pRender->OffsetWindowOrg(m_renderOffset);
+        //多区域绘制时，控件在绘制前与各个脏区域比较，不与脏区域相交的控件（及其子控件）不需要绘制
+        m_pPaintRects = (paintRects.size() > 1) ? &paintRects : nullptr;
         pRoot->AlphaPaint(pRender, rcPaint);
+        m_pPaintRects = nullptr;
         pRender->SetWindowOrg(ptOldWindOrg);
     }
     else {
@@ -2273,6 +2319,29 @@ void Window::SetArrange(bool bArrange)
     m_bIsArranged = bArrange;
 }
 
+void Window::AddArrangeControl(PlaceHolder* pControl)
+{
+    ASSERT(pControl != nullptr);
+    if (pControl != nullptr) {
+        m_arrangeControls.insert(pControl);
+    }
+}
+
+void Window::RemoveArrangeControl(PlaceHolder* pControl)
+{
+    m_arrangeControls.erase(pControl);
+}
+
+void Window::AddLayoutVisitCount()
+{
+    ++m_nLayoutVisitCount;
+}
+
+size_t Window::GetLayoutVisitCount() const
+{
+    return m_nLastLayoutVisitCount;
+}
+
 void Window::PostQuitMsgWhenClosed(bool bPostQuitMsg)
 {
     m_bPostQuitMsgWhenClosed = bPostQuitMsg;
@@ -2431,19 +2500,14 @@ void Window::ArrangeRoot()
     }
     if (m_bIsArranged) {
         m_bIsArranged = false;
+        m_nLayoutVisitCount = 0;
         if (pRoot->IsArranged() || (pRoot->GetPos() != rcClient)) {
             //所有控件的布局全部重排
             pRoot->SetPos(rcClient);
         }
-        else {
-            //仅对有更新的控件的布局全部重排
-            Control* pControl = pRoot->FindControl(ControlFinder::FindControlFromUpdate, nullptr, UIFIND_VISIBLE | UIFIND_ME_FIRST);
-            while (pControl != nullptr) {
-                pControl->SetPos(pControl->GetPos());
-                //ASSERT(!pControl->IsArranged());
-                pControl = pRoot->FindControl(ControlFinder::FindControlFromUpdate, nullptr, UIFIND_VISIBLE | UIFIND_ME_FIRST);
-            }
-        }
+        //仅对有更新的控件的布局全部重排（根容器重排后，剩余的控件为不可见的控件，或者是未被父容器布局的控件）
+        ArrangeDirtyControls(pRoot);
+        m_nLastLayoutVisitCount = m_nLayoutVisitCount;
         if (!m_bFirstLayout) {
             m_bFirstLayout = true;
             OnFirstLayout();
@@ -2451,7 +2515,65 @@ void Window::ArrangeRoot()
     }
     else if (pRoot->GetPos() != rcClient) {
         //所有控件的布局全部重排
+        m_nLayoutVisitCount = 0;
         pRoot->SetPos(rcClient);
+        m_nLastLayoutVisitCount = m_nLayoutVisitCount;
+    }
+}
+
+void Window::ArrangeDirtyControls(Box* pRoot)
+{
+    //需要布局的控件，及其在控件树中的层级
+    struct ArrangeItem
+    {
+        PlaceHolder* m_pControl;
+        std::weak_ptr<WeakFlag> m_weakFlag;
+        size_t m_nDepth;
+    };
+    std::vector<ArrangeItem> arrangeItems;
+    while (!m_arrangeControls.empty()) {
+        arrangeItems.clear();
+        for (auto iter = m_arrangeControls.begin(); iter != m_arrangeControls.end();) {
+            PlaceHolder* pControl = *iter;
+            if (!pControl->IsArranged()) {
+                //已经完成布局（比如父容器布局时，已经对其进行了布局）
+                iter = m_arrangeControls.erase(iter);
+                continue;
+            }
+            //计算层级：控件及其所有父容器可见，并且位于根容器中时，才进行布局，否则留待下次布局时处理
+            bool bArrange = pControl->IsVisible();
+            size_t nDepth = 0;
+            PlaceHolder* pParent = pControl;
+            while (bArrange && (pParent != pRoot)) {
+                pParent = pParent->GetParent();
+                if ((pParent == nullptr) || !pParent->IsVisible()) {
+                    bArrange = false;
+                }
+                ++nDepth;
+            }
+            if (bArrange) {
+                arrangeItems.push_back({ pControl, pControl->GetWeakFlag(), nDepth });
+            }
+            ++iter;
+        }
+        if (arrangeItems.empty()) {
+            break;
+        }
+
+        //按层级由浅到深进行布局：父容器布局时，会对子控件布局，子控件布局完成后不需要再重复布局
+        std::stable_sort(arrangeItems.begin(), arrangeItems.end(),
+                         [](const ArrangeItem& a, const ArrangeItem& b) {
+                             return a.m_nDepth < b.m_nDepth;
+                         });
+        for (const ArrangeItem& item : arrangeItems) {
+            if (item.m_weakFlag.expired()) {
+                //布局过程中，控件已经被删除
+                continue;
+            }
+            if (item.m_pControl->IsArranged()) {
+                item.m_pControl->SetPos(item.m_pControl->GetPos());
+            }
+        }
     }
 }
 
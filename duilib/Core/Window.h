@@ -4,16 +4,19 @@
 #include "duilib/Core/WindowBase.h"
 #include "duilib/Core/Shadow.h"
 #include "duilib/Core/ControlFinder.h"
+#include "duilib/Core/ControlLayerCache.h"
 #include "duilib/Core/ColorManager.h"
 #include "duilib/Core/ControlPtrT.h"
 #include "duilib/Render/IRender.h"
 #include "duilib/Utils/FilePath.h"
+#include <unordered_set>
 
 namespace ui
 {
 
 class Box;
 class Control;
+class PlaceHolder;
 class ToolTip;
 class WindowBuilder;
 
@@ -233,6 +236,24 @@ public:
     */
     void SetArrange(bool bArrange);
 
+    /** 添加一个需要重新布局的控件（在下次布局时，仅对这些控件进行布局调整）
+    * @param [in] pControl 需要重新布局的控件
+    */
+    void AddArrangeControl(PlaceHolder* pControl);
+
+    /** 删除一个需要重新布局的控件
+    * @param [in] pControl 需要删除的控件
+    */
+    void RemoveArrangeControl(PlaceHolder* pControl);
+
+    /** 控件进行了一次布局调整（用于统计每次布局访问的控件个数）
+    */
+    void AddLayoutVisitCount();
+
+    /** 获取最近一次布局时，进行布局调整的控件个数
+    */
+    size_t GetLayoutVisitCount() const;
+
     /** 清理图片缓存
     */
     void ClearImageCache();
@@ -241,6 +262,16 @@ public:
     */
     void InvalidateAll();
 
+    /** 获取窗口内控件的保留图层缓存管理接口
+    */
+    ControlLayerCache& GetLayerCache();
+
+    /** 判断矩形区域是否需要绘制（多区域绘制时，只有与某个脏区域相交的区域才需要绘制）
+    * @param [in] pRender 绘制接口，如果不是窗口的绘制接口（比如控件的缓存绘制），则总是返回true
+    * @param [in] rc 需要判断的矩形区域（pRender的逻辑坐标）
+    */
+    bool IsRectNeedPaint(IRender* pRender, const UiRect& rc) const;
+
     /** @} */
 
 public:
@@ -368,6 +399,10 @@ public:
     */
     void RemoveTextColor(const DString& strName);
 
+    /** 获取窗口颜色表的版本号（窗口颜色表发生变化时，版本号变化）
+    */
+    uint32_t GetTextColorVersion() const;
+
     /** 添加一个选项组
     * @param [in] strGroupName 组名称
     * @param [in] pControl 控件指针
@@ -539,6 +574,11 @@ protected:
     */
     virtual void OnWindowAlphaChanged() override;
 
+    /** 窗口区域标记为需要重绘（在发出重绘消息前调用）
+    * @param [in] rcItem 重绘范围，为客户区坐标
+    */
+    virtual void OnWindowInvalidate(const UiRect& rcItem) override;
+
     /** 进入全屏状态
     */
     virtual void OnWindowEnterFullscreen() override;
@@ -971,6 +1011,11 @@ private:
     */
     void ArrangeRoot();
 
+    /** 仅对需要重新布局的控件进行布局调整（按控件的层级由浅到深进行，父控件布局后，其子控件不再重复布局）
+    * @param [in] pRoot 根容器
+    */
+    void ArrangeDirtyControls(Box* pRoot);
+
     /** 清理窗口资源
     */
     void ClearWindow();
@@ -989,9 +1034,10 @@ private:
 
     /** 绘制函数体
     * @param [in] rcPaint 本次绘制更新的矩形区域
+    * @param [in] paintRects 本次绘制更新的矩形区域列表（各个矩形之间互不相交），为空时表示更新整个rcPaint区域
     * @return 如果执行了绘制返回true，否则返回false
     */
-    bool Paint(const UiRect& rcPaint);
+    bool Paint(const UiRect& rcPaint, const std::vector<UiRect>& paintRects);
 
     /** 调整Render的尺寸，与当前客户区的大小一致
     */
@@ -1064,6 +1110,10 @@ private:
     */
     ControlFinder m_controlFinder;
 
+    /** 控件的保留图层缓存管理
+    */
+    ControlLayerCache m_layerCache;
+
     /** 窗口关联的容器，根节点
     */
     BoxPtr m_pRoot;
@@ -1083,6 +1133,15 @@ private:
     //布局是否变化，如果变化(true)则需要重新计算布局
     bool m_bIsArranged;
 
+    //需要重新布局的控件
+    std::unordered_set<PlaceHolder*> m_arrangeControls;
+
+    //当前布局过程中，进行布局调整的控件个数
+    size_t m_nLayoutVisitCount;
+
+    //最近一次布局时，进行布局调整的控件个数
+    size_t m_nLastLayoutVisitCount;
+
     //布局是否已经初始化
     bool m_bFirstLayout;
 
@@ -1095,6 +1154,9 @@ private:
     //绘制时的偏移量（动画用）
     UiPoint m_renderOffset;
 
+    //多区域绘制时，本次绘制更新的矩形区域列表（仅在绘制过程中有效）
+    const std::vector<UiRect>* m_pPaintRects;
+
     //窗口最大化状态下的外边距（Windows平台，窗口最大化时，窗口的区域是溢出屏幕区域的，所以需要增加外边距，避免窗口的内容也溢出屏幕）
     UiMargin m_rcWindowMaximizedMargin;
 
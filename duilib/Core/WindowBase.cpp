@@ -707,6 +707,7 @@ void WindowBase::ClearWindowRgn(bool bRedraw)
 void WindowBase::Invalidate(const UiRect& rcItem)
 {
     GlobalManager::Instance().AssertUIThread();
+    OnWindowInvalidate(rcItem);
     m_pNativeWindow->Invalidate(rcItem);
 }
 
@@ -1137,13 +1138,16 @@ LRESULT WindowBase::OnNativeShowWindowMsg(bool bShow, const NativeMsg& nativeMsg
     return lResult;
 }
 
-LRESULT WindowBase::OnNativePaintMsg(const UiRect& rcPaint, const NativeMsg& nativeMsg, bool& bHandled)
+LRESULT WindowBase::OnNativePaintMsg(const UiRect& rcPaint, const std::vector<UiRect>& paintRects,
+                                     const NativeMsg& nativeMsg, bool& bHandled)
 {
     std::weak_ptr<WeakFlag> windowFlag = GetWeakFlag();
+    m_paintRects = paintRects;
     LRESULT lResult = OnPaintMsg(rcPaint, nativeMsg, bHandled);
     if (windowFlag.expired()) {
         return lResult;
     }
+    m_paintRects.clear();
     SendWindowEvent(kWindowPaintMsg);
     if (windowFlag.expired()) {
         return lResult;
@@ -1508,6 +1512,11 @@ bool WindowBase::IsWindowFirstShown() const
     return m_bWindowFirstShown;
 }
 
+const std::vector<UiRect>& WindowBase::GetPaintRects() const
+{
+    return m_paintRects;
+}
+
 bool WindowBase::SendWindowEvent(EventType eventType, WPARAM wParam, LPARAM lParam)
 {
     if (m_windowEventMap.empty()) {
@@ -581,6 +581,11 @@ public:
     */
     bool IsWindowFirstShown() const;
 
+    /** 获取本次绘制需要更新的矩形区域列表（各个矩形之间互不相交，仅在OnPaintMsg中有效）
+    *   如果返回空列表，表示需要更新OnPaintMsg中rcPaint的整个区域
+    */
+    const std::vector<UiRect>& GetPaintRects() const;
+
 public:
     /** 监听窗口创建事件
     * @param [in] callback 指定的回调函数，wParam是1表示为通过DoModal函数显示的模态对话框，wParam为0表示为普通窗口
@@ -862,6 +867,11 @@ protected:
     */
     virtual void OnWindowAlphaChanged() = 0;
 
+    /** 窗口区域标记为需要重绘（在发出重绘消息前调用）
+    * @param [in] rcItem 重绘范围，为客户区坐标
+    */
+    virtual void OnWindowInvalidate(const UiRect& rcItem) = 0;
+
     /** 进入全屏状态
     */
     virtual void OnWindowEnterFullscreen() = 0;
@@ -1323,7 +1333,8 @@ private:
     virtual LRESULT OnNativeSizeMsg(WindowSizeType sizeType, const UiSize& newWindowSize, const NativeMsg& nativeMsg, bool& bHandled) override final;
     virtual LRESULT OnNativeMoveMsg(const UiPoint& ptTopLeft, const NativeMsg& nativeMsg, bool& bHandled) override final;
     virtual LRESULT OnNativeShowWindowMsg(bool bShow, const NativeMsg& nativeMsg, bool& bHandled) override final;
-    virtual LRESULT OnNativePaintMsg(const UiRect& rcPaint, const NativeMsg& nativeMsg, bool& bHandled) override;
+    virtual LRESULT OnNativePaintMsg(const UiRect& rcPaint, const std::vector<UiRect>& paintRects,
+                                     const NativeMsg& nativeMsg, bool& bHandled) override;
     virtual LRESULT OnNativeSetFocusMsg(INativeWindow* pLostFocusWindow, const NativeMsg& nativeMsg, bool& bHandled) override final;
     virtual LRESULT OnNativeKillFocusMsg(INativeWindow* pSetFocusWindow, const NativeMsg& nativeMsg, bool& bHandled) override final;
     virtual LRESULT OnNativeImeStartCompositionMsg(const NativeMsg& nativeMsg, bool& bHandled) override final;
@@ -1413,6 +1424,9 @@ private:
     //界面是否完成首次显示
     bool m_bWindowFirstShown;
 
+    //本次绘制需要更新的矩形区域列表（仅在绘制过程中有效）
+    std::vector<UiRect> m_paintRects;
+
     //窗口大小变化事件是否触发
     bool m_bWindowSized;
 
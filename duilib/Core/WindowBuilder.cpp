@@ -60,6 +60,7 @@
 
 #include "duilib/third_party/xml/pugixml.hpp"
 #include <set>
+#include <unordered_map>
 
 namespace ui 
 {
@@ -77,7 +78,7 @@ WindowBuilder::~WindowBuilder()
 Control* WindowBuilder::CreateControlByClass(const DString& strControlClass, Window* pWindow)
 {
     typedef std::function<Control* (Window* pWindow)> CreateControlFunction;
-    static std::map<DString, CreateControlFunction> createControlMap =
+    static std::unordered_map<DString, CreateControlFunction> createControlMap =
     {
         {DUI_CTR_BOX,  [](Window* pWindow) { return new Box(pWindow); }},
         {DUI_CTR_HBOX, [](Window* pWindow) { return new HBox(pWindow); }},
@@ -0,0 +1,350 @@
+#include "ZipFileIndex.h"
+#include "duilib/Utils/StringUtil.h"
+#include "duilib/Utils/StringConvert.h"
+
+#include "duilib/third_party/zlib/zlib.h"
+#include <cstring>
+
+#ifndef DUILIB_BUILD_FOR_WIN
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace ui
+{
+/** ZIP格式的签名
+*/
+static const uint32_t kZipLocalHeaderSignature = 0x04034b50;
+static const uint32_t kZipCentralHeaderSignature = 0x02014b50;
+static const uint32_t kZipEndOfCentralDirSignature = 0x06054b50;
+
+/** ZIP格式各个数据块的固定长度
+*/
+static const size_t kZipLocalHeaderSize = 30;
+static const size_t kZipCentralHeaderSize = 46;
+static const size_t kZipEndOfCentralDirSize = 22;
+
+/** 读取小端格式的整型数据
+*/
+static inline uint16_t ReadZipUInt16(const uint8_t* p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t ReadZipUInt32(const uint8_t* p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+ZipFileIndex::ZipFileIndex():
+    m_pData(nullptr),
+    m_nDataSize(0),
+    m_pMappedData(nullptr)
+{
+}
+
+ZipFileIndex::~ZipFileIndex()
+{
+    Close();
+}
+
+bool ZipFileIndex::OpenFile(const FilePath& path)
+{
+    Close();
+#ifdef DUILIB_BUILD_FOR_WIN
+    HANDLE hFile = ::CreateFileW(path.ToStringW().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize = { 0, };
+    if (!::GetFileSizeEx(hFile, &fileSize) || (fileSize.QuadPart <= 0)) {
+        ::CloseHandle(hFile);
+        return false;
+    }
+    HANDLE hFileMapping = ::CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    ::CloseHandle(hFile);
+    if (hFileMapping == nullptr) {
+        return false;
+    }
+    //映射视图保持对映射对象的引用，映射句柄可以立即关闭
+    void* pMappedData = ::MapViewOfFile(hFileMapping, FILE_MAP_READ, 0, 0, 0);
+    ::CloseHandle(hFileMapping);
+    if (pMappedData == nullptr) {
+        return false;
+    }
+    m_pMappedData = pMappedData;
+    m_nDataSize = (size_t)fileSize.QuadPart;
+#else
+    const DStringA nativePath = path.NativePathA();
+    if (nativePath.empty()) {
+        return false;
+    }
+    int fd = ::open(nativePath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat fileStat;
+    if ((::fstat(fd, &fileStat) != 0) || (fileStat.st_size <= 0)) {
+        ::close(fd);
+        return false;
+    }
+    void* pMappedData = ::mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (pMappedData == MAP_FAILED) {
+        return false;
+    }
+    m_pMappedData = pMappedData;
+    m_nDataSize = (size_t)fileStat.st_size;
+#endif
+    m_pData = (const uint8_t*)m_pMappedData;
+    if (!BuildIndex()) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+bool ZipFileIndex::OpenData(const uint8_t* pData, size_t nDataSize)
+{
+    Close();
+    ASSERT((pData != nullptr) && (nDataSize > 0));
+    if ((pData == nullptr) || (nDataSize == 0)) {
+        return false;
+    }
+    m_pData = pData;
+    m_nDataSize = nDataSize;
+    if (!BuildIndex()) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void ZipFileIndex::Close()
+{
+    m_entryMap.clear();
+    UnmapFile();
+    m_pData = nullptr;
+    m_nDataSize = 0;
+}
+
+void ZipFileIndex::UnmapFile()
+{
+    if (m_pMappedData != nullptr) {
+#ifdef DUILIB_BUILD_FOR_WIN
+        ::UnmapViewOfFile(m_pMappedData);
+#else
+        ::munmap(m_pMappedData, m_nDataSize);
+#endif
+        m_pMappedData = nullptr;
+    }
+}
+
+bool ZipFileIndex::IsOpened() const
+{
+    return m_pData != nullptr;
+}
+
+const uint8_t* ZipFileIndex::GetArchiveData() const
+{
+    return m_pData;
+}
+
+size_t ZipFileIndex::GetArchiveSize() const
+{
+    return m_nDataSize;
+}
+
+bool ZipFileIndex::BuildIndex()
+{
+    m_entryMap.clear();
+    if ((m_pData == nullptr) || (m_nDataSize < kZipEndOfCentralDirSize)) {
+        return false;
+    }
+    //从文件尾部向前查找中央目录结束标记（其后最多有65535字节的注释）
+    size_t nEndPos = m_nDataSize - kZipEndOfCentralDirSize;
+    const size_t nMinEndPos = (nEndPos > 0xFFFF) ? (nEndPos - 0xFFFF) : 0;
+    bool bFound = false;
+    while (true) {
+        if (ReadZipUInt32(m_pData + nEndPos) == kZipEndOfCentralDirSignature) {
+            bFound = true;
+            break;
+        }
+        if (nEndPos == nMinEndPos) {
+            break;
+        }
+        --nEndPos;
+    }
+    if (!bFound) {
+        return false;
+    }
+    const uint8_t* pEnd = m_pData + nEndPos;
+    const uint16_t nEntryCount = ReadZipUInt16(pEnd + 10);
+    const uint32_t nCentralDirSize = ReadZipUInt32(pEnd + 12);
+    const uint32_t nCentralDirOffset = ReadZipUInt32(pEnd + 16);
+    if ((nEntryCount == 0xFFFF) || (nCentralDirSize == 0xFFFFFFFF) || (nCentralDirOffset == 0xFFFFFFFF)) {
+        //ZIP64格式，不支持
+        return false;
+    }
+    if (((size_t)nCentralDirOffset + nCentralDirSize) > nEndPos) {
+        return false;
+    }
+    //压缩包前面可能有其他数据（比如自解压程序），文件偏移需要加上这部分数据的长度
+    const size_t nBytesBefore = nEndPos - ((size_t)nCentralDirOffset + nCentralDirSize);
+
+    m_entryMap.reserve(nEntryCount);
+    size_t nPos = nBytesBefore + nCentralDirOffset;
+    for (uint16_t nIndex = 0; nIndex < nEntryCount; ++nIndex) {
+        if ((nPos + kZipCentralHeaderSize) > nEndPos) {
+            return false;
+        }
+        const uint8_t* pHeader = m_pData + nPos;
+        if (ReadZipUInt32(pHeader) != kZipCentralHeaderSignature) {
+            return false;
+        }
+        TZipEntry entry;
+        entry.m_nFlag = ReadZipUInt16(pHeader + 8);
+        entry.m_nMethod = ReadZipUInt16(pHeader + 10);
+        entry.m_nCompressedSize = ReadZipUInt32(pHeader + 20);
+        entry.m_nUncompressedSize = ReadZipUInt32(pHeader + 24);
+        const uint16_t nFileNameLen = ReadZipUInt16(pHeader + 28);
+        const uint16_t nExtraLen = ReadZipUInt16(pHeader + 30);
+        const uint16_t nCommentLen = ReadZipUInt16(pHeader + 32);
+        const uint32_t nLocalHeaderOffset = ReadZipUInt32(pHeader + 42);
+        if ((entry.m_nCompressedSize == 0xFFFFFFFF) ||
+            (entry.m_nUncompressedSize == 0xFFFFFFFF) ||
+            (nLocalHeaderOffset == 0xFFFFFFFF)) {
+            //ZIP64格式，不支持
+            return false;
+        }
+        if ((nBytesBefore + nLocalHeaderOffset) > 0xFFFFFFFF) {
+            return false;
+        }
+        entry.m_nLocalHeaderOffset = (uint32_t)(nBytesBefore + nLocalHeaderOffset);
+        const size_t nHeaderSize = kZipCentralHeaderSize + nFileNameLen + nExtraLen + nCommentLen;
+        if ((nPos + nHeaderSize) > nEndPos) {
+            return false;
+        }
+
+        //文件名的编码是否为UTF8格式
+        const bool bUtf8 = entry.m_nFlag & (1 << 11);
+        const std::string fileName((const char*)pHeader + kZipCentralHeaderSize, nFileNameLen);
+#ifdef DUILIB_BUILD_FOR_WIN
+        DStringW innerFilePath = StringConvert::MBCSToUnicode(fileName, bUtf8 ? CP_UTF8 : CP_ACP);
+#else
+        UNUSED_VARIABLE(bUtf8);
+        DStringW innerFilePath = StringConvert::UTF8ToWString(fileName);
+#endif
+        //压缩包内的文件名，都不区分大小写，转换为小写再比较
+        innerFilePath = StringUtil::MakeLowerString(innerFilePath);
+        for (wchar_t& ch : innerFilePath) {
+            if (ch == L'\\') {
+                ch = L'/';
+            }
+        }
+        //同名文件只保留第一个（与minizip的查找结果一致）
+        m_entryMap.emplace(innerFilePath, entry);
+        nPos += nHeaderSize;
+    }
+    return true;
+}
+
+const ZipFileIndex::TZipEntry* ZipFileIndex::FindEntry(const DStringW& innerFilePath) const
+{
+    auto iter = m_entryMap.find(innerFilePath);
+    if (iter != m_entryMap.end()) {
+        return &iter->second;
+    }
+    return nullptr;
+}
+
+bool ZipFileIndex::GetEntryData(const TZipEntry& entry, const uint8_t*& pData) const
+{
+    pData = nullptr;
+    const size_t nHeaderPos = entry.m_nLocalHeaderOffset;
+    if ((m_pData == nullptr) || ((nHeaderPos + kZipLocalHeaderSize) > m_nDataSize)) {
+        return false;
+    }
+    const uint8_t* pHeader = m_pData + nHeaderPos;
+    if (ReadZipUInt32(pHeader) != kZipLocalHeaderSignature) {
+        return false;
+    }
+    //本地文件头中的文件名和扩展字段长度，可能与中央目录中的不同
+    const uint16_t nFileNameLen = ReadZipUInt16(pHeader + 26);
+    const uint16_t nExtraLen = ReadZipUInt16(pHeader + 28);
+    const size_t nDataPos = nHeaderPos + kZipLocalHeaderSize + nFileNameLen + nExtraLen;
+    if ((nDataPos + entry.m_nCompressedSize) > m_nDataSize) {
+        return false;
+    }
+    pData = m_pData + nDataPos;
+    return true;
+}
+
+bool ZipFileIndex::GetStoredData(const TZipEntry& entry, const uint8_t*& pData, size_t& nDataSize) const
+{
+    pData = nullptr;
+    nDataSize = 0;
+    if ((entry.m_nFlag & 1) || (entry.m_nMethod != 0) || (entry.m_nCompressedSize != entry.m_nUncompressedSize)) {
+        //加密的文件或者压缩的文件
+        return false;
+    }
+    if (!GetEntryData(entry, pData)) {
+        return false;
+    }
+    nDataSize = entry.m_nUncompressedSize;
+    return true;
+}
+
+bool ZipFileIndex::ReadData(const TZipEntry& entry, std::vector<uint8_t>& fileData) const
+{
+    fileData.clear();
+    if (entry.m_nFlag & 1) {
+        //加密的文件，不支持
+        return false;
+    }
+    if (entry.m_nMethod == 0) {
+        //未压缩的文件
+        const uint8_t* pData = nullptr;
+        size_t nDataSize = 0;
+        if (!GetStoredData(entry, pData, nDataSize)) {
+            return false;
+        }
+        fileData.assign(pData, pData + nDataSize);
+        return true;
+    }
+    if (entry.m_nMethod != Z_DEFLATED) {
+        //不支持的压缩算法
+        return false;
+    }
+    const uint8_t* pData = nullptr;
+    if (!GetEntryData(entry, pData)) {
+        return false;
+    }
+    fileData.resize(entry.m_nUncompressedSize);
+    if (fileData.empty()) {
+        return true;
+    }
+    //每次解压使用独立的解压状态，可以在多个线程中同时解压
+    z_stream stream;
+    ::memset(&stream, 0, sizeof(stream));
+    if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+        fileData.clear();
+        return false;
+    }
+    stream.next_in = (Bytef*)pData;
+    stream.avail_in = (uInt)entry.m_nCompressedSize;
+    stream.next_out = (Bytef*)fileData.data();
+    stream.avail_out = (uInt)fileData.size();
+    int nRet = ::inflate(&stream, Z_FINISH);
+    const uLong nTotalOut = stream.total_out;
+    ::inflateEnd(&stream);
+    if ((nRet != Z_STREAM_END) || (nTotalOut != (uLong)fileData.size())) {
+        fileData.clear();
+        return false;
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,132 @@
+#ifndef UI_CORE_ZIP_FILE_INDEX_H_
+#define UI_CORE_ZIP_FILE_INDEX_H_
+
+#include "duilib/Utils/FilePath.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace ui
+{
+/** ZIP压缩包的文件索引（打开压缩包时解析一次中央目录，建立文件路径的哈希索引）
+ * 说明：
+ * （1）本地压缩包文件通过内存映射的方式访问，资源压缩包直接访问内存数据，读取文件时不需要定位和移动文件指针；
+ * （2）未压缩（Stored）的文件可以直接访问内存数据，无需复制；Deflate算法压缩的文件，每次读取时使用独立的解压状态；
+ * （3）打开后索引是只读的，可以在多个线程中同时读取文件（打开和关闭操作，不能与读取操作同时进行）；
+ * （4）不支持加密的文件和ZIP64格式的压缩包，这些文件需要使用minizip读取。
+ */
+class ZipFileIndex
+{
+public:
+    ZipFileIndex();
+    ~ZipFileIndex();
+    ZipFileIndex(const ZipFileIndex&) = delete;
+    ZipFileIndex& operator = (const ZipFileIndex&) = delete;
+
+public:
+    /** 压缩包内的文件信息（来自中央目录）
+    */
+    struct TZipEntry
+    {
+        //本地文件头在压缩包中的偏移
+        uint32_t m_nLocalHeaderOffset = 0;
+
+        //压缩后的数据长度
+        uint32_t m_nCompressedSize = 0;
+
+        //原始数据长度
+        uint32_t m_nUncompressedSize = 0;
+
+        //压缩算法（0：未压缩，8：Deflate算法）
+        uint16_t m_nMethod = 0;
+
+        //标志位（第0位表示文件已加密）
+        uint16_t m_nFlag = 0;
+    };
+
+public:
+    /** 打开一个本地文件压缩包（通过内存映射的方式访问）
+     * @param[in] path 压缩包文件路径
+     * @return 打开成功并且建立索引成功返回true，否则返回false
+     */
+    bool OpenFile(const FilePath& path);
+
+    /** 打开一个内存压缩包（内存数据由调用方管理，关闭前必须保持有效）
+     * @param[in] pData 压缩包数据的起始地址
+     * @param[in] nDataSize 压缩包数据的长度
+     * @return 建立索引成功返回true，否则返回false
+     */
+    bool OpenData(const uint8_t* pData, size_t nDataSize);
+
+    /** 关闭压缩包
+    */
+    void Close();
+
+    /** 是否已经打开压缩包
+    */
+    bool IsOpened() const;
+
+    /** 获取压缩包的数据（内存映射的地址或者内存压缩包的地址）
+    */
+    const uint8_t* GetArchiveData() const;
+
+    /** 获取压缩包的数据长度
+    */
+    size_t GetArchiveSize() const;
+
+    /** 查找文件
+    * @param [in] innerFilePath 压缩包内的文件路径（小写，路径分隔符为'/'）
+    * @return 返回文件信息，如果文件不存在返回nullptr
+    */
+    const TZipEntry* FindEntry(const DStringW& innerFilePath) const;
+
+    /** 获取未压缩文件的数据（直接访问压缩包的内存数据，无需复制，关闭压缩包前有效）
+    * @param [in] entry 文件信息
+    * @param [out] pData 返回文件数据的起始地址
+    * @param [out] nDataSize 返回文件数据的长度
+    * @return 仅当文件是未压缩、未加密的文件时返回true
+    */
+    bool GetStoredData(const TZipEntry& entry, const uint8_t*& pData, size_t& nDataSize) const;
+
+    /** 读取文件的数据（未压缩的文件复制数据，Deflate算法压缩的文件解压数据，可以在多线程中同时调用）
+    * @param [in] entry 文件信息
+    * @param [out] fileData 返回文件数据
+    * @return 成功返回true，如果失败或者不支持该文件（比如加密的文件）返回false
+    */
+    bool ReadData(const TZipEntry& entry, std::vector<uint8_t>& fileData) const;
+
+private:
+    /** 解析中央目录，建立文件索引
+    */
+    bool BuildIndex();
+
+    /** 获取文件压缩数据的起始位置（跳过本地文件头）
+    * @param [in] entry 文件信息
+    * @param [out] pData 返回压缩数据的起始地址
+    */
+    bool GetEntryData(const TZipEntry& entry, const uint8_t*& pData) const;
+
+    /** 解除本地文件的内存映射
+    */
+    void UnmapFile();
+
+private:
+    /** 压缩包数据的起始地址
+    */
+    const uint8_t* m_pData;
+
+    /** 压缩包数据的长度
+    */
+    size_t m_nDataSize;
+
+    /** 内存映射的数据地址（OpenData打开时为空）
+    */
+    void* m_pMappedData;
+
+    /** 文件索引表（KEY为小写的文件路径，路径分隔符为'/'）
+    */
+    std::unordered_map<DStringW, TZipEntry> m_entryMap;
+};
+
+}
+#endif //UI_CORE_ZIP_FILE_INDEX_H_
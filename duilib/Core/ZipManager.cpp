@@ -1,6 +1,7 @@
 #include "ZipManager.h"
 #include "duilib/Core/GlobalManager.h"
 #include "duilib/Core/ZipStreamIO.h"
+#include "duilib/Core/ZipFileIndex.h"
 #include "duilib/Utils/StringUtil.h"
 #include "duilib/Utils/StringConvert.h"
 #include "duilib/Utils/FilePathUtil.h"
@@ -27,6 +28,7 @@ ZipManager::~ZipManager()
 
 bool ZipManager::IsUseZip() const
 {
+    std::shared_lock<std::shared_mutex> stateGuard(m_zipStateMutex);
     return m_hzip != nullptr;
 }
 
@@ -45,37 +47,103 @@ bool ZipManager::OpenResZip(HMODULE hModule, LPCTSTR resourceName, LPCTSTR resou
     if ((pData == nullptr) || (nDataSize == 0)) {
         return false;
     }
-    CloseResZip();
+    std::unique_lock<std::shared_mutex> stateGuard(m_zipStateMutex);
+    CloseResZipLocked();
     m_password = password;
     m_pZipStreamIO = std::make_unique<ZipStreamIO>(pData, nDataSize);
     zlib_filefunc_def pzlib_filefunc_def;
     m_pZipStreamIO->FillFopenFileFunc(&pzlib_filefunc_def);
     m_hzip = ::unzOpen2(nullptr, &pzlib_filefunc_def);
+    if (m_hzip != nullptr) {
+        //建立文件索引（失败时使用minizip读取）
+        std::shared_ptr<ZipFileIndex> pZipIndex = std::make_shared<ZipFileIndex>();
+        if (pZipIndex->OpenData(pData, nDataSize)) {
+            m_pZipIndex = pZipIndex;
+        }
+    }
     return m_hzip != nullptr;
 }
 #endif
 
 bool ZipManager::OpenZipFile(const FilePath& path, const DString& password)
 {
-    CloseResZip();
+    std::unique_lock<std::shared_mutex> stateGuard(m_zipStateMutex);
+    CloseResZipLocked();
     DStringA nativePath = path.NativePathA();
     if (nativePath.empty()) {
         return false;
     }
     m_password = password;
-    m_hzip = ::unzOpen(nativePath.c_str());
+    //通过内存映射访问压缩包，并建立文件索引（失败时使用minizip读取）
+    std::shared_ptr<ZipFileIndex> pZipIndex = std::make_shared<ZipFileIndex>();
+    if (pZipIndex->OpenFile(path)) {
+        m_pZipIndex = pZipIndex;
+    }
+    if ((m_pZipIndex != nullptr) && (m_pZipIndex->GetArchiveSize() <= (size_t)INT32_MAX)) {
+        //minizip也使用内存映射的数据，避免重复打开文件
+        m_pZipStreamIO = std::make_unique<ZipStreamIO>((uint8_t*)m_pZipIndex->GetArchiveData(), (uint32_t)m_pZipIndex->GetArchiveSize());
+        zlib_filefunc_def pzlib_filefunc_def;
+        m_pZipStreamIO->FillFopenFileFunc(&pzlib_filefunc_def);
+        m_hzip = ::unzOpen2(nullptr, &pzlib_filefunc_def);
+    }
+    if (m_hzip == nullptr) {
+        m_pZipStreamIO.reset();
+        m_hzip = ::unzOpen(nativePath.c_str());
+    }
+    if (m_hzip == nullptr) {
+        m_pZipIndex.reset();
+    }
     return m_hzip != nullptr;
 }
 
 bool ZipManager::GetZipData(const FilePath& path, std::vector<unsigned char>& fileData) const
 {
     fileData.clear();
-    GlobalManager::Instance().AssertUIThread();
+    std::shared_lock<std::shared_mutex> stateGuard(m_zipStateMutex);
     ASSERT(m_hzip != nullptr);
     if (m_hzip == nullptr) {
         return false;
     }
     const FilePath normalizePath = FilePathUtil::NormalizeFilePath(path);
+    if (m_pZipIndex != nullptr) {
+        //通过文件索引读取，无需定位文件，可以在多线程中同时读取
+        const ZipFileIndex::TZipEntry* pEntry = m_pZipIndex->FindEntry(GetZipIndexPath(normalizePath));
+        if ((pEntry == nullptr) || (pEntry->m_nUncompressedSize == 0)) {
+            return false;
+        }
+        if (m_pZipIndex->ReadData(*pEntry, fileData)) {
+            return true;
+        }
+        //加密的文件等，使用minizip读取
+    }
+    std::lock_guard<std::mutex> threadGuard(m_zipMutex);
+    return GetZipDataLocked(normalizePath, fileData);
+}
+
+std::shared_ptr<const uint8_t> ZipManager::GetZipStoredData(const FilePath& path, size_t& nDataSize) const
+{
+    nDataSize = 0;
+    std::shared_lock<std::shared_mutex> stateGuard(m_zipStateMutex);
+    if ((m_hzip == nullptr) || (m_pZipIndex == nullptr)) {
+        return nullptr;
+    }
+    const FilePath normalizePath = FilePathUtil::NormalizeFilePath(path);
+    const ZipFileIndex::TZipEntry* pEntry = m_pZipIndex->FindEntry(GetZipIndexPath(normalizePath));
+    if ((pEntry == nullptr) || (pEntry->m_nUncompressedSize == 0)) {
+        return nullptr;
+    }
+    const uint8_t* pData = nullptr;
+    if (!m_pZipIndex->GetStoredData(*pEntry, pData, nDataSize)) {
+        nDataSize = 0;
+        return nullptr;
+    }
+    //与文件索引共享引用计数：返回的数据持有文件索引，关闭压缩包后仍然有效
+    return std::shared_ptr<const uint8_t>(m_pZipIndex, pData);
+}
+
+bool ZipManager::GetZipDataLocked(const FilePath& normalizePath, std::vector<unsigned char>& fileData) const
+{
+    fileData.clear();
     std::string filePathA;
     if (!LocateFile(normalizePath, filePathA)) {
         return false;
@@ -136,10 +204,15 @@ bool ZipManager::GetZipData(const FilePath& path, std::vector<unsigned char>& fi
 
 bool ZipManager::IsZipResExist(const FilePath& path) const
 {
-    GlobalManager::Instance().AssertUIThread();
+    std::shared_lock<std::shared_mutex> stateGuard(m_zipStateMutex);
     if ((m_hzip == nullptr) || path.IsEmpty()) {
         return false;
     }
+    const FilePath normalizePath = FilePathUtil::NormalizeFilePath(path);
+    if (m_pZipIndex != nullptr) {
+        return m_pZipIndex->FindEntry(GetZipIndexPath(normalizePath)) != nullptr;
+    }
+    std::lock_guard<std::mutex> threadGuard(m_zipMutex);
     if (m_zipPathCache.empty()) {
         //首次查询时，建立缓存，避免每次都需要遍历整个压缩包的文件（::unzLocateFile函数是采用遍历所有文件的方式实现的，性能比较差）
         int nRet = ::unzGoToFirstFile(m_hzip);
@@ -170,11 +243,7 @@ bool ZipManager::IsZipResExist(const FilePath& path) const
         }
     }
 
-    const FilePath normalizePath = FilePathUtil::NormalizeFilePath(path);
-    DStringW innerFilePath = normalizePath.ToStringW();
-    innerFilePath = StringUtil::MakeLowerString(innerFilePath);
-    NormalizeZipFilePath(innerFilePath);
-    auto it = m_zipPathCache.find(innerFilePath);
+    auto it = m_zipPathCache.find(GetZipIndexPath(normalizePath));
     if (it != m_zipPathCache.end()) {
         return true;
     }
@@ -215,20 +284,38 @@ bool ZipManager::LocateFile(const FilePath& normalizePath, std::string& filePath
     return false;
 }
 
+DStringW ZipManager::GetZipIndexPath(const FilePath& normalizePath) const
+{
+    DStringW innerFilePath = normalizePath.ToStringW();
+    innerFilePath = StringUtil::MakeLowerString(innerFilePath);
+    NormalizeZipFilePath(innerFilePath);
+    return innerFilePath;
+}
+
 void ZipManager::CloseResZip()
 {
+    std::unique_lock<std::shared_mutex> stateGuard(m_zipStateMutex);
+    CloseResZipLocked();
+}
+
+void ZipManager::CloseResZipLocked()
+{
+    //已经加独占锁，没有其他线程在访问压缩包
     if (m_hzip != nullptr) {
         ::unzClose(m_hzip);
         m_hzip = nullptr;
     }
     m_zipPathCache.clear();
     m_pZipStreamIO.reset();
+    //GetZipStoredData返回的数据仍在使用时，文件索引（包括内存映射）在最后一个引用释放时关闭
+    m_pZipIndex.reset();
 }
 
 bool ZipManager::GetZipFileList(const FilePath& dirPath, std::vector<DString>& fileList) const
 {
     fileList.clear();
-    GlobalManager::Instance().AssertUIThread();
+    std::shared_lock<std::shared_mutex> stateGuard(m_zipStateMutex);
+    std::lock_guard<std::mutex> threadGuard(m_zipMutex);
     DString filePath = dirPath.NativePath();
     if (!filePath.empty() &&
         (filePath[filePath.size() - 1] != _T('\\')) &&
@@ -6,16 +6,22 @@
 #include <vector>
 #include <unordered_set>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 
 namespace ui 
 {
 class ZipStreamIO;
+class ZipFileIndex;
 
 /**ZIP压缩包管理器
  * 说明：
  * （1）Zip压缩包支持的压缩算法是：Deflate算法，其他算法均不支持(也不支持Deflate64算法)
  * （2）使用7-Zip做压缩包的时候，如果自定义参数：cu=on，可以制作出文件名编码为UTF-8的压缩包；若不设置，默认文件名编码是本机编码
  * （3）如果设置了密码，需要使用传统的密码加密算法，否则无法解压。（使用"ZIP legacy encryption"模式 或者 "ZipCrypto"算法的密码）
+ * （4）打开压缩包时建立文件索引（本地压缩包文件使用内存映射），读取文件和查询文件是否存在的操作可以在多线程中同时调用；
+ *      加密的文件和ZIP64格式的压缩包，使用minizip读取（多线程调用时串行执行）；
+ *      打开和关闭压缩包时，会等待正在进行中的读取操作完成
  */
 class UILIB_API ZipManager
 {
@@ -47,13 +53,22 @@ public:
      */
     bool OpenZipFile(const FilePath& path, const DString& password);
 
-    /** 获取压缩包中的内容到内存
+    /** 获取压缩包中的内容到内存（可以在多线程中调用）
      * @param [in] path 要获取的文件的路径(压缩包内路径)
      * @param [out] fileData 要获取的文件的路径
      */
     bool GetZipData(const FilePath& path, std::vector<unsigned char>& fileData) const;
 
-    /** 判断资源是否存在zip当中
+    /** 直接获取压缩包中未压缩文件的数据，无需复制（可以在多线程中调用）
+     *  返回的智能指针持有压缩包的文件索引（包括内存映射的数据），即使压缩包已经关闭，在智能指针释放前数据仍然有效；
+     *  压缩的文件或者加密的文件返回nullptr，需要使用GetZipData获取
+     * @param [in] path 要获取的文件的路径(压缩包内路径)
+     * @param [out] nDataSize 返回文件数据的长度
+     * @return 返回文件数据的起始地址，失败返回nullptr
+     */
+    std::shared_ptr<const uint8_t> GetZipStoredData(const FilePath& path, size_t& nDataSize) const;
+
+    /** 判断资源是否存在zip当中（可以在多线程中调用）
      * @param[in] path 要判断的资源路径(压缩包内路径)
      */
     bool IsZipResExist(const FilePath& path) const;
@@ -69,6 +84,10 @@ public:
     void CloseResZip();
 
 private:
+    /** 关闭压缩包（调用时需要已经加独占锁）
+    */
+    void CloseResZipLocked();
+
     /** 对Zip格式的路径进行规范化处理（'\\'替换成'/'）
     */
     void NormalizeZipFilePath(std::string& innerFilePath) const;
@@ -81,6 +100,14 @@ private:
     */
     bool LocateFile(const FilePath& normalizePath, std::string& filePathA) const;
 
+    /** 使用minizip获取压缩包中的内容到内存（调用时需要已经加锁）
+    */
+    bool GetZipDataLocked(const FilePath& normalizePath, std::vector<unsigned char>& fileData) const;
+
+    /** 获取压缩包内的文件路径（小写，路径分隔符为'/'），用于查询文件索引
+    */
+    DStringW GetZipIndexPath(const FilePath& normalizePath) const;
+
     /** 获取压缩包内的路径(转换字符串编码)
     * @param [in] szInZipFilePath 要获取的文件路径(压缩包内路径)
     * @param [in] bUtf8 true表示UTF8编码，否则为Ansi编码
@@ -101,9 +128,22 @@ private:
     */
     std::unique_ptr<ZipStreamIO> m_pZipStreamIO;
 
-    /** 路径缓存
+    /** 路径缓存（文件索引不可用时使用）
     */
     mutable std::unordered_set<DStringW> m_zipPathCache;
+
+    /** 压缩包的文件索引（GetZipStoredData返回的数据也持有其引用，关闭压缩包时只释放本对象持有的引用）
+    */
+    std::shared_ptr<ZipFileIndex> m_pZipIndex;
+
+    /** 压缩包状态的读写锁：打开和关闭压缩包时加独占锁，读取和查询时加共享锁
+    *   （保护m_hzip、m_pZipStreamIO、m_pZipIndex，避免关闭压缩包时其他线程仍在访问文件索引和映射的数据）
+    */
+    mutable std::shared_mutex m_zipStateMutex;
+
+    /** minizip访问压缩包的多线程同步锁（m_hzip句柄只能串行访问，需要在m_zipStateMutex之后加锁）
+    */
+    mutable std::mutex m_zipMutex;
 };
 
 }
@@ -12,7 +12,8 @@ Image::Image() :
     m_pImagePlayer(nullptr),
     m_nCurrentFrame(0),
     m_bImageError(false),
-    m_bDecodeEventFired(false)
+    m_bDecodeEventFired(false),
+    m_bImageLoading(false)
 {
 }
 
@@ -122,6 +123,9 @@ const std::shared_ptr<ImageInfo>& Image::GetImageInfo() const
 void Image::SetImageInfo(const std::shared_ptr<ImageInfo>& imageInfo)
 {
     m_imageInfo = imageInfo;
+    if (m_imageInfo != nullptr) {
+        m_bImageLoading = false;
+    }
 }
 
 void Image::ClearImageCache()
@@ -136,6 +140,7 @@ void Image::ClearImageCache()
     m_nCurrentFrame = 0;
     m_imageInfo.reset();
     m_rcDrawDestRect.Clear();
+    m_bImageLoading = false;
 }
 
 void Image::SetCurrentFrameIndex(uint32_t nCurrentFrame)
@@ -440,4 +445,14 @@ bool Image::IsDecodeEventFired() const
     return m_bDecodeEventFired;
 }
 
+void Image::SetImageLoading(bool bImageLoading)
+{
+    m_bImageLoading = bImageLoading;
+}
+
+bool Image::IsImageLoading() const
+{
+    return m_bImageLoading;
+}
+
 }
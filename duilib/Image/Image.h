@@ -224,6 +224,14 @@ public:
     */
     bool IsDecodeEventFired() const;
 
+    /** 设置图片是否正在子线程中加载（加载完成前，绘制时显示占位符）
+    */
+    void SetImageLoading(bool bImageLoading);
+
+    /** 获取图片是否正在子线程中加载
+    */
+    bool IsImageLoading() const;
+
 private:
     /** 初始化动画播放器
     */
@@ -275,6 +283,10 @@ private:
     /** 图片解码完成的事件是否已经通知(避免重用原图时，此事件不触发)
     */
     bool m_bDecodeEventFired;
+
+    /** 图片是否正在子线程中加载
+    */
+    bool m_bImageLoading;
 };
 
 } // namespace ui
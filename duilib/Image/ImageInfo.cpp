@@ -32,7 +32,7 @@ void ImageInfo::ReleaseImage()
 {
     if (m_pImageData != nullptr) {
         DString imageFullPath = m_loadParam.GetImageLoadPath().m_imageFullPath.ToString();
-        GlobalManager::Instance().Image().ReleaseImage(m_pImageData, imageFullPath);
+        GlobalManager::Instance().Image().ReleaseImage(m_pImageData, GetImageKey(), imageFullPath);
         m_pImageData.reset();
     }
 }
@@ -4,7 +4,8 @@
 namespace ui 
 {
 VirtualHLayout::VirtualHLayout():
-    m_bAutoCalcItemHeight(false)
+    m_bAutoCalcItemHeight(false),
+    m_variableLayout(false)
 {
     //默认居中对齐
     SetChildVAlignType(VerAlignType::kAlignCenter);
@@ -124,6 +125,8 @@ void VirtualHLayout::ChangeDpiScale(const DpiManager& dpiManager, uint32_t nOldD
 {
     UiSize szItem = GetItemSize();
     szItem = dpiManager.GetScaleSize(szItem, nOldDpiScale);
+    //已测量的宽度与DPI相关，需要重新测量
+    m_variableLayout.Clear();
     SetItemSize(szItem);
     BaseClass::ChangeDpiScale(dpiManager, nOldDpiScale);
 }
@@ -134,6 +137,10 @@ void VirtualHLayout::SetItemSize(UiSize szItem, bool bArrange)
     szItem.cy = std::max(szItem.cy, 0);
     ASSERT((szItem.cx > 0) && (szItem.cy > 0));
     if ((m_szItem.cx != szItem.cx) || (m_szItem.cy != szItem.cy)) {
+        if (m_szItem.cy != szItem.cy) {
+            //高度变化后，已测量的宽度可能失效
+            m_variableLayout.Clear();
+        }
         m_szItem = szItem;
         if (bArrange && (GetOwner() != nullptr)) {
             GetOwner()->Arrange();
@@ -168,6 +175,10 @@ int64_t VirtualHLayout::GetElementsWidth(UiRect /*rc*/, size_t nCount) const
     if ((szItem.cx <= 0) || (szItem.cy <= 0)) {
         return 0;
     }
+    if (IsVariableItemWidth()) {
+        //可变宽度：已测量的使用实际宽度，未测量的使用估计值
+        return m_variableLayout.GetElementsSize(GetOwnerBox(), nCount, szItem, std::max(GetChildMarginX(), 0));
+    }
     if (nCount <= 1) {
         return (int64_t)szItem.cx + GetChildMarginX();
     }
@@ -207,6 +218,22 @@ void VirtualHLayout::LazyArrangeChild(UiRect rc) const
         return;
     }
 
+    if (IsVariableItemWidth()) {
+        //子项的顶部起始位置
+        int32_t iPosTop = rc.top;
+        if (szItem.cy < rc.Height()) {
+            VerAlignType vAlign = GetChildVAlignType();
+            if (vAlign == VerAlignType::kAlignCenter) {
+                iPosTop = rc.CenterY() - szItem.cy / 2;
+            }
+            else if (vAlign == VerAlignType::kAlignBottom) {
+                iPosTop = rc.bottom - szItem.cy;
+            }
+        }
+        m_variableLayout.LazyArrangeChild(pOwnerBox, rc, iPosTop, szItem, std::max(GetChildMarginX(), 0));
+        return;
+    }
+
     //X轴坐标的偏移，需要保持，避免滚动位置变动后，重新刷新界面出现偏差
     int32_t xOffset = 0;
     int64_t itemWidth = GetElementsWidth(rc, 1);
@@ -296,6 +323,13 @@ size_t VirtualHLayout::AjustMaxItem(UiRect rc) const
     if (rc.IsEmpty()) {
         return 0;
     }
+    if (IsVariableItemWidth()) {
+        //可变宽度：按测量过的最小宽度估算（最小不低于子项宽度的1/4，避免创建过多的控件）
+        int32_t nMinWidth = m_variableLayout.GetMinMeasuredSize();
+        if ((nMinWidth >= 0) && (nMinWidth < szItem.cx)) {
+            szItem.cx = std::max(nMinWidth, std::max(szItem.cx / 4, 1));
+        }
+    }
     int32_t nColumns = rc.Width() / (szItem.cx + GetChildMarginX() / 2);
     //验证并修正
     if (nColumns > 1) {
@@ -315,6 +349,9 @@ size_t VirtualHLayout::GetTopElementIndex(UiRect rc) const
     if (pOwnerBox == nullptr) {
         return 0;
     }
+    if (IsVariableItemWidth()) {
+        return m_variableLayout.GetTopElementIndex(pOwnerBox, GetItemSize(), std::max(GetChildMarginX(), 0));
+    }
     int64_t nPos = pOwnerBox->GetScrollPos().cx;
     if (nPos < 0) {
         nPos = 0;
@@ -338,6 +375,9 @@ bool VirtualHLayout::IsElementDisplay(UiRect rc, size_t iIndex) const
         return false;
     }
 
+    if (IsVariableItemWidth()) {
+        return m_variableLayout.IsElementDisplay(pOwnerBox, iIndex, GetItemSize(), std::max(GetChildMarginX(), 0));
+    }
     int64_t nScrollPos = pOwnerBox->GetScrollPos().cx;
     int64_t nElementPos = GetElementsWidth(rc, iIndex + 1);
     int64_t nElementWidth = GetElementsWidth(rc, 1);
@@ -390,6 +430,11 @@ void VirtualHLayout::GetDisplayElements(UiRect rc, std::vector<size_t>& collecti
         return;
     }
 
+    if (IsVariableItemWidth()) {
+        m_variableLayout.GetDisplayElements(pOwnerBox, rc, GetItemSize(), std::max(GetChildMarginX(), 0), collection);
+        return;
+    }
+
     int64_t nEleWidth = GetElementsWidth(rc, 1);
     if (nEleWidth <= 0) {
         return;
@@ -425,6 +470,10 @@ void VirtualHLayout::EnsureVisible(UiRect rc, size_t iIndex, bool bToTop) const
     if (pOwnerBox->GetHScrollBar() == nullptr) {
         return;
     }
+    if (IsVariableItemWidth()) {
+        m_variableLayout.EnsureVisible(pOwnerBox, iIndex, bToTop, GetItemSize(), std::max(GetChildMarginX(), 0));
+        return;
+    }
     int64_t nPos = pOwnerBox->GetScrollPos().cx;
     int64_t elementWidth = GetElementsWidth(rc, 1);
     if (elementWidth <= 0) {
@@ -466,4 +515,28 @@ void VirtualHLayout::EnsureVisible(UiRect rc, size_t iIndex, bool bToTop) const
     ui::UiSize64 sz(nNewPos, 0);
     pOwnerBox->SetScrollPos(sz);
 }
+
+void VirtualHLayout::InvalidateElementSize(size_t nStartIndex, size_t nEndIndex) const
+{
+    VirtualListBox* pOwnerBox = dynamic_cast<VirtualListBox*>(GetOwner());
+    if ((pOwnerBox == nullptr) || !pOwnerBox->HasDataProvider()) {
+        return;
+    }
+    m_variableLayout.InvalidateElementSize(pOwnerBox, nStartIndex, nEndIndex);
+}
+
+void VirtualHLayout::OnElementCountChanged(size_t nStartIndex, size_t nRemovedCount, size_t nInsertedCount) const
+{
+    VirtualListBox* pOwnerBox = dynamic_cast<VirtualListBox*>(GetOwner());
+    if ((pOwnerBox == nullptr) || !pOwnerBox->HasDataProvider()) {
+        return;
+    }
+    m_variableLayout.OnElementCountChanged(pOwnerBox, nStartIndex, nRemovedCount, nInsertedCount);
+}
+
+bool VirtualHLayout::IsVariableItemWidth() const
+{
+    return VirtualVariableSizeLayout::IsVariableSize(dynamic_cast<VirtualListBox*>(GetOwner()));
+}
+
 } // namespace ui
@@ -55,6 +55,19 @@ public:
     * @param[in] bToTop 是否在最上方
     */
     virtual void EnsureVisible(UiRect rc, size_t iIndex, bool bToTop) const = 0;
+
+    /** 数据元素的大小发生变化（仅支持可变大小元素的布局需要实现）
+    * @param [in] nStartIndex 数据元素的开始索引号
+    * @param [in] nEndIndex 数据元素的结束索引号（包含）
+    */
+    virtual void InvalidateElementSize(size_t /*nStartIndex*/, size_t /*nEndIndex*/) const {}
+
+    /** 数据元素的个数发生变化（仅支持可变大小元素的布局需要实现）
+    * @param [in] nStartIndex 插入或者删除的起始位置，如果为Box::InvalidIndex表示变化的位置未知
+    * @param [in] nRemovedCount 在起始位置删除的元素个数
+    * @param [in] nInsertedCount 在起始位置插入的元素个数
+    */
+    virtual void OnElementCountChanged(size_t /*nStartIndex*/, size_t /*nRemovedCount*/, size_t /*nInsertedCount*/) const {}
 };
 
 } // namespace ui
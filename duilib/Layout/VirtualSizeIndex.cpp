@@ -0,0 +1,178 @@
+#include "VirtualSizeIndex.h"
+#include <algorithm>
+
+namespace ui
+{
+VirtualSizeIndex::VirtualSizeIndex()
+{
+}
+
+VirtualSizeIndex::~VirtualSizeIndex()
+{
+}
+
+void VirtualSizeIndex::SetElementCount(size_t nCount)
+{
+    const size_t nOldCount = m_sizes.size();
+    if (nCount == nOldCount) {
+        return;
+    }
+    for (size_t index = nCount; index < nOldCount; ++index) {
+        RemoveMeasuredSize(m_sizes[index]);
+    }
+    m_sizes.resize(nCount, -1);
+    //在末尾增删元素：前面的树节点不受影响，新增的元素为未测量状态
+    m_sizeTree.Resize(nCount, 0);
+    m_countTree.Resize(nCount, 0);
+}
+
+size_t VirtualSizeIndex::GetElementCount() const
+{
+    return m_sizes.size();
+}
+
+void VirtualSizeIndex::InsertElements(size_t nStartIndex, size_t nCount)
+{
+    ASSERT(nStartIndex <= m_sizes.size());
+    if ((nCount == 0) || (nStartIndex > m_sizes.size())) {
+        return;
+    }
+    if (nStartIndex == m_sizes.size()) {
+        SetElementCount(m_sizes.size() + nCount);
+        return;
+    }
+    m_sizes.insert(m_sizes.begin() + nStartIndex, nCount, -1);
+    m_sizeTree.InsertElements(nStartIndex, nCount, 0);
+    m_countTree.InsertElements(nStartIndex, nCount, 0);
+}
+
+void VirtualSizeIndex::RemoveElements(size_t nStartIndex, size_t nCount)
+{
+    ASSERT(nStartIndex < m_sizes.size());
+    if ((nCount == 0) || (nStartIndex >= m_sizes.size())) {
+        return;
+    }
+    nCount = std::min(nCount, m_sizes.size() - nStartIndex);
+    if ((nStartIndex + nCount) == m_sizes.size()) {
+        SetElementCount(nStartIndex);
+        return;
+    }
+    for (size_t index = nStartIndex; index < (nStartIndex + nCount); ++index) {
+        RemoveMeasuredSize(m_sizes[index]);
+    }
+    m_sizes.erase(m_sizes.begin() + nStartIndex, m_sizes.begin() + nStartIndex + nCount);
+    m_sizeTree.RemoveElements(nStartIndex, nCount);
+    m_countTree.RemoveElements(nStartIndex, nCount);
+}
+
+void VirtualSizeIndex::Clear()
+{
+    m_sizes.clear();
+    m_sizeTree.Clear();
+    m_countTree.Clear();
+    m_measuredSizes.clear();
+}
+
+bool VirtualSizeIndex::SetElementSize(size_t nElementIndex, int32_t nSize)
+{
+    ASSERT(nElementIndex < m_sizes.size());
+    if (nElementIndex >= m_sizes.size()) {
+        return false;
+    }
+    if (nSize < 0) {
+        nSize = -1;
+    }
+    const int32_t nOldSize = m_sizes[nElementIndex];
+    if (nOldSize == nSize) {
+        return false;
+    }
+    m_sizes[nElementIndex] = nSize;
+    const int64_t nDeltaSize = (int64_t)std::max(nSize, 0) - (int64_t)std::max(nOldSize, 0);
+    if (nDeltaSize != 0) {
+        m_sizeTree.Add(nElementIndex, nDeltaSize);
+    }
+    if ((nOldSize < 0) && (nSize >= 0)) {
+        m_countTree.Add(nElementIndex, 1);
+    }
+    else if ((nOldSize >= 0) && (nSize < 0)) {
+        m_countTree.Add(nElementIndex, (uint32_t)-1);
+    }
+    RemoveMeasuredSize(nOldSize);
+    AddMeasuredSize(nSize);
+    return true;
+}
+
+void VirtualSizeIndex::ResetElementSize(size_t nStartIndex, size_t nEndIndex)
+{
+    for (size_t index = nStartIndex; (index <= nEndIndex) && (index < m_sizes.size()); ++index) {
+        SetElementSize(index, -1);
+    }
+}
+
+bool VirtualSizeIndex::IsElementMeasured(size_t nElementIndex) const
+{
+    return (nElementIndex < m_sizes.size()) && (m_sizes[nElementIndex] >= 0);
+}
+
+int32_t VirtualSizeIndex::GetElementSize(size_t nElementIndex, int32_t nEstimateSize) const
+{
+    if ((nElementIndex < m_sizes.size()) && (m_sizes[nElementIndex] >= 0)) {
+        return m_sizes[nElementIndex];
+    }
+    return std::max(nEstimateSize, 0);
+}
+
+int64_t VirtualSizeIndex::GetElementsSize(size_t nCount, int32_t nEstimateSize, int32_t nMargin) const
+{
+    nCount = std::min(nCount, m_sizes.size());
+    const int64_t nMeasuredSize = m_sizeTree.GetPrefixSum(nCount);
+    const int64_t nMeasuredCount = m_countTree.GetPrefixSum(nCount);
+    return nMeasuredSize + ((int64_t)nCount - nMeasuredCount) * std::max(nEstimateSize, 0) +
+           (int64_t)nCount * std::max(nMargin, 0);
+}
+
+size_t VirtualSizeIndex::FindElement(int64_t nPos, int32_t nEstimateSize, int32_t nMargin) const
+{
+    nEstimateSize = std::max(nEstimateSize, 0);
+    nMargin = std::max(nMargin, 0);
+    return FenwickTreeFindFirstGreater(m_sizes.size(), nPos, [this, nEstimateSize, nMargin](size_t nNode) {
+            //树节点nNode覆盖的元素个数为lowbit(nNode)
+            const int64_t nNodeCount = (int64_t)(nNode & (0 - nNode));
+            return m_sizeTree.GetNode(nNode) + (nNodeCount - m_countTree.GetNode(nNode)) * nEstimateSize +
+                   nNodeCount * nMargin;
+        });
+}
+
+int32_t VirtualSizeIndex::GetMinMeasuredSize() const
+{
+    if (m_measuredSizes.empty()) {
+        return -1;
+    }
+    return m_measuredSizes.begin()->first;
+}
+
+void VirtualSizeIndex::AddMeasuredSize(int32_t nSize)
+{
+    if (nSize >= 0) {
+        ++m_measuredSizes[nSize];
+    }
+}
+
+void VirtualSizeIndex::RemoveMeasuredSize(int32_t nSize)
+{
+    if (nSize < 0) {
+        return;
+    }
+    auto iter = m_measuredSizes.find(nSize);
+    ASSERT(iter != m_measuredSizes.end());
+    if (iter != m_measuredSizes.end()) {
+        if (iter->second > 1) {
+            --iter->second;
+        }
+        else {
+            m_measuredSizes.erase(iter);
+        }
+    }
+}
+
+} // namespace ui
@@ -0,0 +1,116 @@
+#ifndef UI_LAYOUT_VIRTUAL_SIZE_INDEX_H_
+#define UI_LAYOUT_VIRTUAL_SIZE_INDEX_H_
+
+#include "duilib/duilib_defs.h"
+#include "duilib/Utils/FenwickTree.h"
+#include <vector>
+#include <map>
+
+namespace ui
+{
+/** 虚表中大小可变的元素（纵向布局为高度，横向布局为宽度）的前缀和索引
+*   已测量的元素使用实际大小，未测量的元素使用估计值（估计值在查询时传入，修改估计值不需要重建索引）；
+*   内部使用树状数组（Fenwick tree）分别记录已测量元素的大小之和与个数：
+*   修改单个元素的大小、查询前N个元素的总大小、按位置查找元素、在末尾增删元素，时间复杂度均为O(logN)；
+*   在中间插入、删除元素时，只重建插入（删除）位置之后的部分
+*/
+class UILIB_API VirtualSizeIndex
+{
+public:
+    VirtualSizeIndex();
+    ~VirtualSizeIndex();
+
+public:
+    /** 设置元素个数（新增的元素在末尾，为未测量状态；减少时删除末尾的元素）
+    */
+    void SetElementCount(size_t nCount);
+
+    /** 获取元素个数
+    */
+    size_t GetElementCount() const;
+
+    /** 在指定位置插入元素（新插入的元素为未测量状态，其后的元素依次后移）
+    * @param [in] nStartIndex 插入位置，有效范围：[0, GetElementCount()]
+    * @param [in] nCount 插入的元素个数
+    */
+    void InsertElements(size_t nStartIndex, size_t nCount);
+
+    /** 删除指定位置的元素（其后的元素依次前移）
+    * @param [in] nStartIndex 删除的起始位置，有效范围：[0, GetElementCount())
+    * @param [in] nCount 删除的元素个数
+    */
+    void RemoveElements(size_t nStartIndex, size_t nCount);
+
+    /** 清除所有元素
+    */
+    void Clear();
+
+    /** 设置元素的实际大小
+    * @param [in] nElementIndex 元素索引号，有效范围：[0, GetElementCount())
+    * @param [in] nSize 元素的实际大小，如果小于0表示恢复为未测量状态
+    * @return 如果元素的大小有变化返回true，否则返回false
+    */
+    bool SetElementSize(size_t nElementIndex, int32_t nSize);
+
+    /** 将一个范围内的元素恢复为未测量状态
+    * @param [in] nStartIndex 起始元素索引号
+    * @param [in] nEndIndex 结束元素索引号（包含）
+    */
+    void ResetElementSize(size_t nStartIndex, size_t nEndIndex);
+
+    /** 元素是否已经测量过
+    */
+    bool IsElementMeasured(size_t nElementIndex) const;
+
+    /** 获取元素的大小（未测量的元素返回估计值）
+    * @param [in] nElementIndex 元素索引号，有效范围：[0, GetElementCount())
+    * @param [in] nEstimateSize 未测量元素的估计大小
+    */
+    int32_t GetElementSize(size_t nElementIndex, int32_t nEstimateSize) const;
+
+    /** 获取前nCount个元素的总大小（每个元素的大小加上元素间隔）
+    * @param [in] nCount 元素个数
+    * @param [in] nEstimateSize 未测量元素的估计大小
+    * @param [in] nMargin 元素之间的间隔
+    */
+    int64_t GetElementsSize(size_t nCount, int32_t nEstimateSize, int32_t nMargin) const;
+
+    /** 按位置查找元素：返回满足 GetElementsSize(N + 1) > nPos 的第一个元素N
+    * @param [in] nPos 位置（与GetElementsSize的值对应）
+    * @param [in] nEstimateSize 未测量元素的估计大小
+    * @param [in] nMargin 元素之间的间隔
+    * @return 返回元素索引号，如果位置超出所有元素的范围，返回GetElementCount()
+    */
+    size_t FindElement(int64_t nPos, int32_t nEstimateSize, int32_t nMargin) const;
+
+    /** 获取测量过的元素中的最小大小（用于估算需要的控件个数），如果没有测量过元素返回-1
+    */
+    int32_t GetMinMeasuredSize() const;
+
+private:
+    /** 记录或者删除一个已测量元素的大小（用于维护最小大小）
+    */
+    void AddMeasuredSize(int32_t nSize);
+    void RemoveMeasuredSize(int32_t nSize);
+
+private:
+    /** 每个元素的实际大小，-1表示未测量
+    */
+    std::vector<int32_t> m_sizes;
+
+    /** 已测量元素的大小之和（每个元素的值：已测量元素为其大小，未测量元素为0）
+    */
+    FenwickTree<int64_t> m_sizeTree;
+
+    /** 已测量元素的个数（每个元素的值：已测量元素为1，未测量元素为0）
+    */
+    FenwickTree<uint32_t> m_countTree;
+
+    /** 已测量元素的大小及该大小的元素个数（第一个元素即为最小大小）
+    */
+    std::map<int32_t, size_t> m_measuredSizes;
+};
+
+} // namespace ui
+
+#endif // UI_LAYOUT_VIRTUAL_SIZE_INDEX_H_
@@ -6,7 +6,8 @@ namespace ui
 {
 
 VirtualVLayout::VirtualVLayout():
-    m_bAutoCalcItemWidth(false)
+    m_bAutoCalcItemWidth(false),
+    m_variableLayout(true)
 {
     //默认居中对齐
     SetChildHAlignType(HorAlignType::kAlignCenter);
@@ -126,6 +127,8 @@ void VirtualVLayout::ChangeDpiScale(const DpiManager& dpiManager, uint32_t nOldD
 {
     UiSize szItem = GetItemSize();
     szItem = dpiManager.GetScaleSize(szItem, nOldDpiScale);
+    //已测量的高度与DPI相关，需要重新测量
+    m_variableLayout.Clear();
     SetItemSize(szItem);
     BaseClass::ChangeDpiScale(dpiManager, nOldDpiScale);
 }
@@ -136,6 +139,10 @@ void VirtualVLayout::SetItemSize(UiSize szItem, bool bArrange)
     szItem.cy = std::max(szItem.cy, 0);
     ASSERT((szItem.cx > 0) && (szItem.cy > 0));
     if ((m_szItem.cx != szItem.cx) || (m_szItem.cy != szItem.cy)) {
+        if (m_szItem.cx != szItem.cx) {
+            //宽度变化后，已测量的高度（比如多行文本）可能失效
+            m_variableLayout.Clear();
+        }
         m_szItem = szItem;
         if (bArrange && (GetOwner() != nullptr)) {
             GetOwner()->Arrange();
@@ -170,6 +177,10 @@ int64_t VirtualVLayout::GetElementsHeight(UiRect /*rc*/, size_t nCount) const
     if ((szItem.cx <= 0) || (szItem.cy <= 0)) {
         return 0;
     }
+    if (IsVariableItemHeight()) {
+        //可变高度：已测量的使用实际高度，未测量的使用估计值
+        return m_variableLayout.GetElementsSize(GetOwnerBox(), nCount, szItem, std::max(GetChildMarginY(), 0));
+    }
     if (nCount <= 1) {
         return (int64_t)szItem.cy + GetChildMarginY();
     }
@@ -223,6 +234,11 @@ void VirtualVLayout::LazyArrangeChild(UiRect rc) const
         }
     }
 
+    if (IsVariableItemHeight()) {
+        m_variableLayout.LazyArrangeChild(pOwnerBox, rc, iPosLeft, szItem, std::max(GetChildMarginY(), 0));
+        return;
+    }
+
     //Y轴坐标的偏移，需要保持，避免滚动位置变动后，重新刷新界面出现偏差
     int32_t yOffset = 0;
     int64_t itemHeight = GetElementsHeight(rc, 1);
@@ -298,6 +314,13 @@ size_t VirtualVLayout::AjustMaxItem(UiRect rc) const
     if (rc.IsEmpty()) {
         return 0;
     }
+    if (IsVariableItemHeight()) {
+        //可变高度：按测量过的最小高度估算（最小不低于子项高度的1/4，避免创建过多的控件）
+        int32_t nMinHeight = m_variableLayout.GetMinMeasuredSize();
+        if ((nMinHeight >= 0) && (nMinHeight < szItem.cy)) {
+            szItem.cy = std::max(nMinHeight, std::max(szItem.cy / 4, 1));
+        }
+    }
     int32_t nRows = rc.Height() / (szItem.cy + GetChildMarginY() / 2);
     //验证并修正
     if (nRows > 1) {
@@ -317,6 +340,9 @@ size_t VirtualVLayout::GetTopElementIndex(UiRect rc) const
     if (pOwnerBox == nullptr) {
         return 0;
     }
+    if (IsVariableItemHeight()) {
+        return m_variableLayout.GetTopElementIndex(pOwnerBox, GetItemSize(), std::max(GetChildMarginY(), 0));
+    }
     int64_t nPos = pOwnerBox->GetScrollPos().cy;
     if (nPos < 0) {
         nPos = 0;
@@ -340,6 +366,9 @@ bool VirtualVLayout::IsElementDisplay(UiRect rc, size_t iIndex) const
         return false;
     }
 
+    if (IsVariableItemHeight()) {
+        return m_variableLayout.IsElementDisplay(pOwnerBox, iIndex, GetItemSize(), std::max(GetChildMarginY(), 0));
+    }
     int64_t nScrollPos = pOwnerBox->GetScrollPos().cy;
     int64_t nElementPos = GetElementsHeight(rc, iIndex + 1);
     int64_t nElementHeight = GetElementsHeight(rc, 1);
@@ -392,6 +421,11 @@ void VirtualVLayout::GetDisplayElements(UiRect rc, std::vector<size_t>& collecti
         return;
     }
 
+    if (IsVariableItemHeight()) {
+        m_variableLayout.GetDisplayElements(pOwnerBox, rc, GetItemSize(), std::max(GetChildMarginY(), 0), collection);
+        return;
+    }
+
     int64_t nEleHeight = GetElementsHeight(rc, 1);
     if (nEleHeight <= 0) {
         return;
@@ -427,6 +461,10 @@ void VirtualVLayout::EnsureVisible(UiRect rc, size_t iIndex, bool bToTop) const
     if (pOwnerBox->GetVScrollBar() == nullptr) {
         return;
     }
+    if (IsVariableItemHeight()) {
+        m_variableLayout.EnsureVisible(pOwnerBox, iIndex, bToTop, GetItemSize(), std::max(GetChildMarginY(), 0));
+        return;
+    }
     int64_t nPos = pOwnerBox->GetScrollPos().cy;
     int64_t elementHeight = GetElementsHeight(rc, 1);
     if (elementHeight <= 0) {
@@ -471,4 +509,28 @@ void VirtualVLayout::EnsureVisible(UiRect rc, size_t iIndex, bool bToTop) const
     ui::UiSize64 sz(0, nNewPos);
     pOwnerBox->SetScrollPos(sz);
 }
+
+void VirtualVLayout::InvalidateElementSize(size_t nStartIndex, size_t nEndIndex) const
+{
+    VirtualListBox* pOwnerBox = dynamic_cast<VirtualListBox*>(GetOwner());
+    if ((pOwnerBox == nullptr) || !pOwnerBox->HasDataProvider()) {
+        return;
+    }
+    m_variableLayout.InvalidateElementSize(pOwnerBox, nStartIndex, nEndIndex);
+}
+
+void VirtualVLayout::OnElementCountChanged(size_t nStartIndex, size_t nRemovedCount, size_t nInsertedCount) const
+{
+    VirtualListBox* pOwnerBox = dynamic_cast<VirtualListBox*>(GetOwner());
+    if ((pOwnerBox == nullptr) || !pOwnerBox->HasDataProvider()) {
+        return;
+    }
+    m_variableLayout.OnElementCountChanged(pOwnerBox, nStartIndex, nRemovedCount, nInsertedCount);
+}
+
+bool VirtualVLayout::IsVariableItemHeight() const
+{
+    return VirtualVariableSizeLayout::IsVariableSize(dynamic_cast<VirtualListBox*>(GetOwner()));
+}
+
 } // namespace ui
@@ -3,6 +3,7 @@
 
 #include "duilib/Layout/VLayout.h"
 #include "duilib/Layout/VirtualLayout.h"
+#include "duilib/Layout/VirtualVariableSizeLayout.h"
 
 namespace ui 
 {
@@ -94,6 +95,19 @@ public:
     */
     virtual void EnsureVisible(UiRect rc, size_t iIndex, bool bToTop) const override;
 
+    /** 数据元素的大小发生变化（仅当数据项的高度可变时有效）
+    * @param [in] nStartIndex 数据元素的开始索引号
+    * @param [in] nEndIndex 数据元素的结束索引号（包含）
+    */
+    virtual void InvalidateElementSize(size_t nStartIndex, size_t nEndIndex) const override;
+
+    /** 数据元素的个数发生变化（仅当数据项的高度可变时有效）
+    * @param [in] nStartIndex 插入或者删除的起始位置，如果为Box::InvalidIndex表示变化的位置未知
+    * @param [in] nRemovedCount 在起始位置删除的元素个数
+    * @param [in] nInsertedCount 在起始位置插入的元素个数
+    */
+    virtual void OnElementCountChanged(size_t nStartIndex, size_t nRemovedCount, size_t nInsertedCount) const override;
+
 public:
     /** 设置子项大小
      * @param [in] szItem 子项大小数据，该宽度和高度，是包含了控件的外边距和内边距的
@@ -121,6 +135,11 @@ private:
     */
     int64_t GetElementsHeight(UiRect rc, size_t nCount) const;
 
+private:
+    /** 数据项的高度是否可变（由数据代理对象决定）
+    */
+    bool IsVariableItemHeight() const;
+
 private:
     /** 获取关联的Box接口
     */
@@ -132,6 +151,9 @@ private:
 
     //是否自动计算子项的宽度（根据父控件总体宽度自动适应，仅当设置为固定列时有效）
     bool m_bAutoCalcItemWidth;
+
+    //数据项高度可变时的布局实现
+    mutable VirtualVariableSizeLayout m_variableLayout;
 };
 } // namespace ui
 
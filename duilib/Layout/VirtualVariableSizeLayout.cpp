@@ -0,0 +1,387 @@
+#include "VirtualVariableSizeLayout.h"
+#include "duilib/Box/VirtualListBox.h"
+
+namespace ui
+{
+
+VirtualVariableSizeLayout::VirtualVariableSizeLayout(bool bVertical):
+    m_bVertical(bVertical),
+    m_nAnchorIndex(Box::InvalidIndex),
+    m_nAnchorPos(0)
+{
+}
+
+bool VirtualVariableSizeLayout::IsVariableSize(const VirtualListBox* pOwnerBox)
+{
+    return (pOwnerBox != nullptr) && pOwnerBox->IsVariableElementSize();
+}
+
+void VirtualVariableSizeLayout::Clear()
+{
+    m_sizeIndex.Clear();
+    m_nAnchorIndex = Box::InvalidIndex;
+}
+
+int32_t VirtualVariableSizeLayout::GetMinMeasuredSize() const
+{
+    return m_sizeIndex.GetMinMeasuredSize();
+}
+
+void VirtualVariableSizeLayout::InvalidateElementSize(VirtualListBox* pOwnerBox, size_t nStartIndex, size_t nEndIndex)
+{
+    ASSERT(pOwnerBox != nullptr);
+    if (pOwnerBox == nullptr) {
+        return;
+    }
+    const size_t nElementCount = m_sizeIndex.GetElementCount();
+    //从数据代理对象重新获取大小（未知的大小恢复为未测量状态，在下次显示时重新测量）
+    for (size_t nElementIndex = nStartIndex; (nElementIndex <= nEndIndex) && (nElementIndex < nElementCount); ++nElementIndex) {
+        m_sizeIndex.SetElementSize(nElementIndex, pOwnerBox->QueryElementSize(nElementIndex));
+    }
+}
+
+void VirtualVariableSizeLayout::OnElementCountChanged(VirtualListBox* pOwnerBox, size_t nStartIndex,
+                                                      size_t nRemovedCount, size_t nInsertedCount)
+{
+    ASSERT(pOwnerBox != nullptr);
+    if (pOwnerBox == nullptr) {
+        return;
+    }
+    if (!Box::IsValidItemIndex(nStartIndex)) {
+        //只知道元素个数发生变化：增加时按在末尾追加处理，减少时按删除末尾的元素处理，已测量的大小保留
+        SyncElementCount(pOwnerBox);
+        return;
+    }
+    const size_t nOldCount = m_sizeIndex.GetElementCount();
+    const size_t nNewCount = pOwnerBox->GetElementCount();
+    bool bValidRange = (nStartIndex <= nOldCount) &&
+                       (nRemovedCount <= (nOldCount - nStartIndex)) &&
+                       ((nOldCount - nRemovedCount + nInsertedCount) == nNewCount);
+    if (!bValidRange) {
+        //变化的范围与当前的元素个数不一致：所有元素的大小均失效，在下次布局时重新获取
+        Clear();
+        return;
+    }
+
+    //删除和插入元素后，其后元素的大小依次移动，新插入的元素从数据代理对象获取大小
+    m_sizeIndex.RemoveElements(nStartIndex, nRemovedCount);
+    m_sizeIndex.InsertElements(nStartIndex, nInsertedCount);
+    for (size_t nElementIndex = nStartIndex; nElementIndex < (nStartIndex + nInsertedCount); ++nElementIndex) {
+        m_sizeIndex.SetElementSize(nElementIndex, pOwnerBox->QueryElementSize(nElementIndex));
+    }
+
+    //锚点元素随之移动，如果锚点元素已被删除，则锚点失效
+    if (Box::IsValidItemIndex(m_nAnchorIndex) && (m_nAnchorIndex >= nStartIndex)) {
+        if (m_nAnchorIndex < (nStartIndex + nRemovedCount)) {
+            m_nAnchorIndex = Box::InvalidIndex;
+        }
+        else {
+            m_nAnchorIndex = m_nAnchorIndex - nRemovedCount + nInsertedCount;
+        }
+    }
+}
+
+void VirtualVariableSizeLayout::SyncElementCount(VirtualListBox* pOwnerBox)
+{
+    ASSERT(pOwnerBox != nullptr);
+    if (pOwnerBox == nullptr) {
+        return;
+    }
+    //在末尾追加或者删除元素（比如首次布局、只通知了元素个数变化），新增的元素从数据代理对象获取大小
+    const size_t nOldCount = m_sizeIndex.GetElementCount();
+    const size_t nNewCount = pOwnerBox->GetElementCount();
+    if (nOldCount != nNewCount) {
+        m_sizeIndex.SetElementCount(nNewCount);
+        for (size_t nElementIndex = nOldCount; nElementIndex < nNewCount; ++nElementIndex) {
+            m_sizeIndex.SetElementSize(nElementIndex, pOwnerBox->QueryElementSize(nElementIndex));
+        }
+        if (Box::IsValidItemIndex(m_nAnchorIndex) && (m_nAnchorIndex >= nNewCount)) {
+            m_nAnchorIndex = Box::InvalidIndex;
+        }
+    }
+}
+
+int64_t VirtualVariableSizeLayout::GetElementPos(size_t nElementIndex, const UiSize& szItem, int32_t nChildMargin) const
+{
+    return m_sizeIndex.GetElementsSize(nElementIndex, GetMainSize(szItem), nChildMargin);
+}
+
+int32_t VirtualVariableSizeLayout::GetElementSize(size_t nElementIndex, const UiSize& szItem) const
+{
+    return m_sizeIndex.GetElementSize(nElementIndex, GetMainSize(szItem));
+}
+
+int64_t VirtualVariableSizeLayout::GetScrollPos(const VirtualListBox* pOwnerBox) const
+{
+    return m_bVertical ? pOwnerBox->GetScrollPos().cy : pOwnerBox->GetScrollPos().cx;
+}
+
+ScrollBar* VirtualVariableSizeLayout::GetScrollBar(const VirtualListBox* pOwnerBox) const
+{
+    return m_bVertical ? pOwnerBox->GetVScrollBar() : pOwnerBox->GetHScrollBar();
+}
+
+int32_t VirtualVariableSizeLayout::MeasureElementSize(VirtualListBox* pOwnerBox, Control* pControl, size_t nElementIndex,
+                                                      const UiRect& rc, const UiSize& szItem) const
+{
+    int32_t nSize = pOwnerBox->QueryElementSize(nElementIndex);
+    if ((nSize < 0) && (pControl != nullptr)) {
+        //数据代理对象未提供大小：按控件填充数据后的实际大小测量
+        UiMargin rcMargin = pControl->GetMargin();
+        UiSize szAvailable;
+        if (m_bVertical) {
+            szAvailable = UiSize(szItem.cx - rcMargin.left - rcMargin.right, rc.Height());
+        }
+        else {
+            szAvailable = UiSize(rc.Width(), szItem.cy - rcMargin.top - rcMargin.bottom);
+        }
+        szAvailable.Validate();
+        UiEstSize estSize = pControl->EstimateSize(szAvailable);
+        const UiEstInt& estMain = m_bVertical ? estSize.cy : estSize.cx;
+        if (estMain.IsStretch()) {
+            //拉伸类型的控件，使用子项大小
+            nSize = GetMainSize(szItem);
+        }
+        else if (m_bVertical) {
+            nSize = std::clamp(estMain.GetInt32(), pControl->GetMinHeight(), pControl->GetMaxHeight());
+            nSize += (rcMargin.top + rcMargin.bottom);
+        }
+        else {
+            nSize = std::clamp(estMain.GetInt32(), pControl->GetMinWidth(), pControl->GetMaxWidth());
+            nSize += (rcMargin.left + rcMargin.right);
+        }
+        nSize = std::max(nSize, 0);
+    }
+    return nSize;
+}
+
+int64_t VirtualVariableSizeLayout::GetElementsSize(VirtualListBox* pOwnerBox, size_t nCount,
+                                                   const UiSize& szItem, int32_t nChildMargin)
+{
+    //已测量的使用实际大小，未测量的使用估计值
+    SyncElementCount(pOwnerBox);
+    if (!Box::IsValidItemIndex(nCount)) {
+        nCount = m_sizeIndex.GetElementCount();
+    }
+    if (nCount == 0) {
+        return 0;
+    }
+    return GetElementPos(nCount, szItem, nChildMargin) - nChildMargin;
+}
+
+size_t VirtualVariableSizeLayout::GetTopElementIndex(VirtualListBox* pOwnerBox, const UiSize& szItem, int32_t nChildMargin)
+{
+    SyncElementCount(pOwnerBox);
+    int64_t nPos = std::max(GetScrollPos(pOwnerBox), (int64_t)0);
+    const size_t nElementCount = m_sizeIndex.GetElementCount();
+    size_t nTopIndex = m_sizeIndex.FindElement(nPos, GetMainSize(szItem), nChildMargin);
+    if ((nElementCount > 0) && (nTopIndex >= nElementCount)) {
+        nTopIndex = nElementCount - 1;
+    }
+    return nTopIndex;
+}
+
+bool VirtualVariableSizeLayout::IsElementDisplay(VirtualListBox* pOwnerBox, size_t iIndex,
+                                                 const UiSize& szItem, int32_t nChildMargin)
+{
+    SyncElementCount(pOwnerBox);
+    if (iIndex >= m_sizeIndex.GetElementCount()) {
+        return false;
+    }
+    const int64_t nScrollPos = GetScrollPos(pOwnerBox);
+    const int64_t nBoxSize = m_bVertical ? pOwnerBox->GetHeight() : pOwnerBox->GetWidth();
+    int64_t nElementStart = GetElementPos(iIndex, szItem, nChildMargin);
+    int64_t nElementEnd = nElementStart + GetElementSize(iIndex, szItem);
+    return (nElementStart >= nScrollPos) && (nElementEnd <= (nScrollPos + nBoxSize));
+}
+
+void VirtualVariableSizeLayout::GetDisplayElements(VirtualListBox* pOwnerBox, const UiRect& rc,
+                                                   const UiSize& szItem, int32_t nChildMargin,
+                                                   std::vector<size_t>& collection)
+{
+    //可见范围内的元素：[顶部元素, 底部元素]
+    SyncElementCount(pOwnerBox);
+    const size_t nElementCount = m_sizeIndex.GetElementCount();
+    if (nElementCount == 0) {
+        return;
+    }
+    const int32_t nEstimateSize = GetMainSize(szItem);
+    int64_t nScrollPos = std::max(GetScrollPos(pOwnerBox), (int64_t)0);
+    size_t nMin = m_sizeIndex.FindElement(nScrollPos, nEstimateSize, nChildMargin);
+    size_t nMax = m_sizeIndex.FindElement(nScrollPos + std::max(GetMainSize(rc) - 1, 0), nEstimateSize, nChildMargin);
+    nMin = std::min(nMin, nElementCount - 1);
+    nMax = std::min(nMax, nElementCount - 1);
+    for (size_t i = nMin; i <= nMax; ++i) {
+        collection.push_back(i);
+    }
+}
+
+void VirtualVariableSizeLayout::EnsureVisible(VirtualListBox* pOwnerBox, size_t iIndex, bool bToTop,
+                                              const UiSize& szItem, int32_t nChildMargin)
+{
+    ScrollBar* pScrollBar = GetScrollBar(pOwnerBox);
+    if (pScrollBar == nullptr) {
+        return;
+    }
+    //元素的实际大小在显示后才能测量，测量后如果仍不可见，再调整一次
+    for (int32_t nRetry = 0; nRetry < 2; ++nRetry) {
+        SyncElementCount(pOwnerBox);
+        if (iIndex >= m_sizeIndex.GetElementCount()) {
+            return;
+        }
+        int64_t nScrollPos = GetScrollPos(pOwnerBox);
+        int64_t nElementPos = GetElementPos(iIndex, szItem, nChildMargin);
+        int64_t nNewPos = nElementPos;
+        if (!bToTop) {
+            if (IsElementDisplay(pOwnerBox, iIndex, szItem, nChildMargin)) {
+                return;
+            }
+            if (nElementPos > nScrollPos) {
+                // 向下（横向布局时为向右）
+                nNewPos = nElementPos + GetElementSize(iIndex, szItem) - GetMainSize(pOwnerBox->GetRect());
+            }
+        }
+        nNewPos = std::max(nNewPos, (int64_t)0);
+        nNewPos = std::min(nNewPos, pScrollBar->GetScrollRange());
+        if (nNewPos == nScrollPos) {
+            return;
+        }
+        UiSize64 szScrollPos = pOwnerBox->GetScrollPos();
+        if (m_bVertical) {
+            szScrollPos.cy = nNewPos;
+        }
+        else {
+            szScrollPos.cx = nNewPos;
+        }
+        pOwnerBox->SetScrollPos(szScrollPos);
+    }
+}
+
+void VirtualVariableSizeLayout::LazyArrangeChild(VirtualListBox* pOwnerBox, const UiRect& rc, int32_t nCrossPos,
+                                                 const UiSize& szItem, int32_t nChildMargin)
+{
+    SyncElementCount(pOwnerBox);
+    const size_t nElementCount = m_sizeIndex.GetElementCount();
+    const size_t nItemCount = pOwnerBox->m_items.size();
+    const int64_t nOldTotalSize = GetElementsSize(pOwnerBox, Box::InvalidIndex, szItem, nChildMargin);
+
+    int64_t nScrollPos = std::max(GetScrollPos(pOwnerBox), (int64_t)0);
+    size_t nTopIndex = 0;
+
+    //每个子项控件已填充的数据元素：再次调整时，只填充和测量数据元素有变化的子项控件
+    std::vector<size_t> filledElements(nItemCount, Box::InvalidIndex);
+
+    //填充数据并测量实际大小；如果测量后锚点元素的位置发生变化，调整滚动位置，使界面内容保持不动
+    const int32_t nMaxPass = 3;
+    for (int32_t nPass = 0; nPass < nMaxPass; ++nPass) {
+        const size_t nOldTopIndex = nTopIndex;
+        nTopIndex = GetTopElementIndex(pOwnerBox, szItem, nChildMargin);
+        if ((nPass > 0) && (nTopIndex == nOldTopIndex)) {
+            //顶部元素不变，已填充的数据均有效
+            break;
+        }
+        for (size_t nItemIndex = 0; nItemIndex < nItemCount; ++nItemIndex) {
+            Control* pControl = pOwnerBox->m_items[nItemIndex];
+            if (pControl == nullptr) {
+                continue;
+            }
+            size_t nElementIndex = nTopIndex + nItemIndex;
+            if (nElementIndex < nElementCount) {
+                if (filledElements[nItemIndex] == nElementIndex) {
+                    continue;
+                }
+                if (!pControl->IsVisible()) {
+                    pControl->SetVisible(true);
+                }
+                pOwnerBox->FillElementData(pControl, nElementIndex);
+                m_sizeIndex.SetElementSize(nElementIndex, MeasureElementSize(pOwnerBox, pControl, nElementIndex, rc, szItem));
+                filledElements[nItemIndex] = nElementIndex;
+            }
+            else {
+                if (pControl->IsVisible()) {
+                    pControl->SetVisible(false);
+                }
+                //需要清除ElementIndex
+                IListBoxItem* pListBoxItem = dynamic_cast<IListBoxItem*>(pControl);
+                if (pListBoxItem != nullptr) {
+                    pListBoxItem->SetElementIndex(Box::InvalidIndex);
+                }
+                filledElements[nItemIndex] = Box::InvalidIndex;
+            }
+        }
+
+        //锚点：上次布局时的顶部元素，仅在逐步滚动时（锚点仍在附近）保持稳定，滚动到顶部时不调整
+        if ((m_nAnchorIndex >= nElementCount) || (nScrollPos <= 0) ||
+            ((m_nAnchorIndex + nItemCount) < nTopIndex) || (m_nAnchorIndex > (nTopIndex + nItemCount))) {
+            break;
+        }
+        const int64_t nAnchorPos = GetElementPos(m_nAnchorIndex, szItem, nChildMargin);
+        const int64_t nDelta = nAnchorPos - m_nAnchorPos;
+        m_nAnchorPos = nAnchorPos;
+        ScrollBar* pScrollBar = GetScrollBar(pOwnerBox);
+        if ((nDelta == 0) || (pScrollBar == nullptr)) {
+            break;
+        }
+        //直接修改滚动条的位置，避免重入布局
+        pScrollBar->SetScrollPos(nScrollPos + nDelta);
+        int64_t nNewScrollPos = GetScrollPos(pOwnerBox);
+        if (nNewScrollPos == nScrollPos) {
+            break;
+        }
+        nScrollPos = nNewScrollPos;
+        pOwnerBox->Invalidate();
+    }
+
+    //设置虚拟偏移，否则当数据量较大时，rc这个32位的矩形会越界，需要64位整型才能容纳
+    if (m_bVertical) {
+        pOwnerBox->SetScrollVirtualOffsetY(pOwnerBox->GetScrollPos().cy);
+    }
+    else {
+        pOwnerBox->SetScrollVirtualOffsetX(pOwnerBox->GetScrollPos().cx);
+    }
+
+    //按实际大小设置控件的位置
+    int64_t nStart = (nTopIndex < nElementCount) ? GetElementPos(nTopIndex, szItem, nChildMargin) : 0;
+    int32_t iPos = (m_bVertical ? rc.top : rc.left) - TruncateToInt32(nScrollPos - nStart);
+    for (size_t nItemIndex = 0; nItemIndex < nItemCount; ++nItemIndex) {
+        Control* pControl = pOwnerBox->m_items[nItemIndex];
+        if (pControl == nullptr) {
+            continue;
+        }
+        size_t nElementIndex = nTopIndex + nItemIndex;
+        int32_t nSize = (nElementIndex < nElementCount) ? GetElementSize(nElementIndex, szItem) : GetMainSize(szItem);
+        ui::UiRect rcTile;
+        if (m_bVertical) {
+            rcTile = UiRect(nCrossPos, iPos, nCrossPos + szItem.cx, iPos + nSize);
+        }
+        else {
+            rcTile = UiRect(iPos, nCrossPos, iPos + nSize, nCrossPos + szItem.cy);
+        }
+        pControl->SetPos(rcTile);
+        iPos += nSize + nChildMargin;
+    }
+
+    m_nAnchorIndex = (nTopIndex < nElementCount) ? nTopIndex : Box::InvalidIndex;
+    m_nAnchorPos = nStart;
+
+    VirtualListBox::RefreshDataList refreshDataList;
+    VirtualListBox::RefreshData refreshData;
+    for (size_t nItemIndex = 0; nItemIndex < nItemCount; ++nItemIndex) {
+        if (filledElements[nItemIndex] != Box::InvalidIndex) {
+            refreshData.nItemIndex = nItemIndex;
+            refreshData.pControl = pOwnerBox->m_items[nItemIndex];
+            refreshData.nElementIndex = filledElements[nItemIndex];
+            refreshDataList.push_back(refreshData);
+        }
+    }
+    if (!refreshDataList.empty()) {
+        pOwnerBox->OnRefreshElements(refreshDataList);
+        pOwnerBox->OnFilledElements(refreshDataList);
+    }
+    if (GetElementsSize(pOwnerBox, Box::InvalidIndex, szItem, nChildMargin) != nOldTotalSize) {
+        //总大小发生变化，需要更新滚动条的范围
+        pOwnerBox->Arrange();
+    }
+}
+
+} // namespace ui
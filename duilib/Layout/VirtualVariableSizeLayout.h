@@ -0,0 +1,131 @@
+#ifndef UI_LAYOUT_VIRTUAL_VARIABLE_SIZE_LAYOUT_H_
+#define UI_LAYOUT_VIRTUAL_VARIABLE_SIZE_LAYOUT_H_
+
+#include "duilib/Core/UiTypes.h"
+#include "duilib/Layout/VirtualSizeIndex.h"
+
+namespace ui
+{
+class Control;
+class ScrollBar;
+class VirtualListBox;
+
+/** 虚表中大小可变的数据元素的布局实现（VirtualVLayout和VirtualHLayout共用）
+*   纵向布局时处理元素的高度，横向布局时处理元素的宽度；元素的大小优先从数据代理对象获取，
+*   未提供时在显示后按控件填充数据后的实际大小测量，未测量的元素按子项大小(item_size)估算
+*/
+class UILIB_API VirtualVariableSizeLayout
+{
+public:
+    /** 构造函数
+    * @param [in] bVertical true表示纵向布局（元素的高度可变），false表示横向布局（元素的宽度可变）
+    */
+    explicit VirtualVariableSizeLayout(bool bVertical);
+
+public:
+    /** 数据项的大小是否可变（由数据代理对象决定）
+    */
+    static bool IsVariableSize(const VirtualListBox* pOwnerBox);
+
+    /** 清除所有元素的测量结果（比如DPI或者子项大小发生变化时）
+    */
+    void Clear();
+
+    /** 获取测量过的元素中的最小大小，如果没有测量过元素返回-1
+    */
+    int32_t GetMinMeasuredSize() const;
+
+    /** 数据元素的大小发生变化：从数据代理对象重新获取大小（未知的大小恢复为未测量状态）
+    * @param [in] nStartIndex 数据元素的开始索引号
+    * @param [in] nEndIndex 数据元素的结束索引号（包含）
+    */
+    void InvalidateElementSize(VirtualListBox* pOwnerBox, size_t nStartIndex, size_t nEndIndex);
+
+    /** 数据元素的个数发生变化
+    * @param [in] nStartIndex 插入或者删除的起始位置，如果为Box::InvalidIndex表示变化的位置未知（按在末尾追加或者删除元素处理）
+    * @param [in] nRemovedCount 在起始位置删除的元素个数
+    * @param [in] nInsertedCount 在起始位置插入的元素个数
+    */
+    void OnElementCountChanged(VirtualListBox* pOwnerBox, size_t nStartIndex,
+                               size_t nRemovedCount, size_t nInsertedCount);
+
+public:
+    /** 获取前nCount个元素的总大小（不含最后一个元素之后的间隔）
+    * @param [in] nCount 元素个数，如果为Box::InvalidIndex，则获取所有元素的总大小
+    * @param [in] szItem 子项大小（未测量元素的估计值）
+    * @param [in] nChildMargin 子项之间的间隔
+    */
+    int64_t GetElementsSize(VirtualListBox* pOwnerBox, size_t nCount, const UiSize& szItem, int32_t nChildMargin);
+
+    /** 得到可见范围内第一个元素的索引
+    */
+    size_t GetTopElementIndex(VirtualListBox* pOwnerBox, const UiSize& szItem, int32_t nChildMargin);
+
+    /** 判断某个元素是否完整显示在可见范围内
+    */
+    bool IsElementDisplay(VirtualListBox* pOwnerBox, size_t iIndex, const UiSize& szItem, int32_t nChildMargin);
+
+    /** 获取当前所有可见控件的数据元素索引
+    * @param [in] rc 当前显示区域的矩形，不包含内边距
+    */
+    void GetDisplayElements(VirtualListBox* pOwnerBox, const UiRect& rc, const UiSize& szItem, int32_t nChildMargin,
+                            std::vector<size_t>& collection);
+
+    /** 让元素在可见范围内
+    * @param [in] bToTop 是否在最上方（横向布局时为最左侧）
+    */
+    void EnsureVisible(VirtualListBox* pOwnerBox, size_t iIndex, bool bToTop, const UiSize& szItem, int32_t nChildMargin);
+
+    /** 延迟加载展示数据：填充数据、测量实际大小，并设置子控件的位置
+    * @param [in] rc 当前容器大小信息，不包含内边距
+    * @param [in] nCrossPos 子项在另一个方向的起始位置（纵向布局为左侧位置，横向布局为顶部位置）
+    */
+    void LazyArrangeChild(VirtualListBox* pOwnerBox, const UiRect& rc, int32_t nCrossPos,
+                          const UiSize& szItem, int32_t nChildMargin);
+
+private:
+    /** 同步大小索引中的元素个数（新增的元素从数据代理对象获取大小）
+    */
+    void SyncElementCount(VirtualListBox* pOwnerBox);
+
+    /** 获取数据元素的起始位置（纵向布局为顶部位置，横向布局为左侧位置）
+    */
+    int64_t GetElementPos(size_t nElementIndex, const UiSize& szItem, int32_t nChildMargin) const;
+
+    /** 获取数据元素的大小（未测量的元素返回估计值）
+    */
+    int32_t GetElementSize(size_t nElementIndex, const UiSize& szItem) const;
+
+    /** 测量已填充数据的控件大小（包含控件的外边距）
+    */
+    int32_t MeasureElementSize(VirtualListBox* pOwnerBox, Control* pControl, size_t nElementIndex,
+                               const UiRect& rc, const UiSize& szItem) const;
+
+    /** 按布局方向取值
+    */
+    int32_t GetMainSize(const UiSize& sz) const { return m_bVertical ? sz.cy : sz.cx; }
+    int32_t GetMainSize(const UiRect& rc) const { return m_bVertical ? rc.Height() : rc.Width(); }
+
+    /** 获取布局方向的滚动位置和滚动条
+    */
+    int64_t GetScrollPos(const VirtualListBox* pOwnerBox) const;
+    ScrollBar* GetScrollBar(const VirtualListBox* pOwnerBox) const;
+
+private:
+    /** true表示纵向布局，false表示横向布局
+    */
+    bool m_bVertical;
+
+    /** 数据元素大小的前缀和索引
+    */
+    VirtualSizeIndex m_sizeIndex;
+
+    /** 上次布局时最前面的数据元素及其起始位置（用于在测量出实际大小后保持滚动位置稳定）
+    */
+    size_t m_nAnchorIndex;
+    int64_t m_nAnchorPos;
+};
+
+} // namespace ui
+
+#endif // UI_LAYOUT_VIRTUAL_VARIABLE_SIZE_LAYOUT_H_
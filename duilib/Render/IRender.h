@@ -136,8 +136,9 @@ public:
     virtual void* LockPixelBits() = 0;
 
     /** 释放位图数据
+    * @param [in] bPixelsChanged 锁定期间是否修改了位图数据（只读取时传入false，可避免位图相关的缓存失效）
     */
-    virtual void UnLockPixelBits() = 0;
+    virtual void UnLockPixelBits(bool bPixelsChanged = true) = 0;
 
     /** 克隆生成新的的位图
     *@return 返回新生成的位图接口，由调用方释放资源
@@ -433,9 +434,10 @@ class UILIB_API IRenderPaint
 {
 public:
     /** 通过回调接口，完成绘制
-    * @param [in] rcPaint 需要绘制的区域（客户区坐标）
+    * @param [in] rcPaint 需要绘制的区域（客户区坐标），多区域绘制时为所有区域的外接矩形
+    * @param [in] paintRects 需要绘制的区域列表（客户区坐标，各个矩形之间互不相交），为空时表示绘制整个rcPaint区域
     */
-    virtual bool DoPaint(const UiRect& rcPaint) = 0;
+    virtual bool DoPaint(const UiRect& rcPaint, const std::vector<UiRect>& paintRects) = 0;
 
     /** 回调接口，获取当前窗口的透明度值
     */
@@ -446,6 +448,12 @@ public:
     * @return 返回true表示支持局部绘制，返回false表示不支持局部绘制
     */
     virtual bool GetUpdateRect(UiRect& rcUpdate) const = 0;
+
+    /** 获取界面需要绘制的区域列表（各个矩形之间互不相交），以实现多区域的局部绘制
+    * @param [out] updateRects 返回需要绘制的区域矩形列表
+    * @return 返回true表示支持局部绘制，返回false表示不支持局部绘制
+    */
+    virtual bool GetUpdateRects(std::vector<UiRect>& updateRects) const = 0;
 };
 
 /** 光栅操作代码
@@ -0,0 +1,329 @@
+#include "PixelConvert.h"
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    #define DUILIB_PIXEL_CONVERT_X86 1
+    #include <immintrin.h>
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+    #endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define DUILIB_PIXEL_CONVERT_NEON 1
+    #include <arm_neon.h>
+#endif
+
+//GCC/Clang需要为使用SIMD指令的函数单独开启指令集（编译选项中未开启），MSVC无需设置
+#if defined(__GNUC__) || defined(__clang__)
+    #define PIXEL_CONVERT_TARGET(x) __attribute__((target(x)))
+#else
+    #define PIXEL_CONVERT_TARGET(x)
+#endif
+
+namespace ui
+{
+
+/** 逐个像素处理（无SIMD指令）
+*/
+static void ConvertRowScalar(const uint8_t* shuffle, uint8_t nAlpha,
+                             uint32_t* pDst, const uint32_t* pSrc, int32_t nPixels)
+{
+    for (int32_t i = 0; i < nPixels; ++i) {
+        uint32_t srcValue = pSrc[i];
+        const uint8_t* src = (const uint8_t*)&srcValue;
+        uint8_t dst[4];
+        dst[0] = src[shuffle[0]];
+        dst[1] = src[shuffle[1]];
+        dst[2] = src[shuffle[2]];
+        dst[3] = src[shuffle[3]];
+        if (nAlpha != 255) {
+            dst[0] = (uint8_t)(dst[0] * nAlpha / 255);
+            dst[1] = (uint8_t)(dst[1] * nAlpha / 255);
+            dst[2] = (uint8_t)(dst[2] * nAlpha / 255);
+            dst[3] = (uint8_t)(dst[3] * nAlpha / 255);
+        }
+        ::memcpy(pDst + i, dst, sizeof(uint32_t));
+    }
+}
+
+#ifdef DUILIB_PIXEL_CONVERT_X86
+
+/** SSE2：8位数据乘以nAlpha/255
+*   x / 255（向下取整）按 (x + (x >> 8) + 1) >> 8 计算，x的取值范围为[0, 255*255]时，结果与整数除法完全一致
+*/
+PIXEL_CONVERT_TARGET("sse2")
+static inline __m128i ScaleAlphaSSE2(__m128i v, __m128i alpha16, __m128i one16)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(v, zero), alpha16);
+    __m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(v, zero), alpha16);
+    lo = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), one16), 8);
+    hi = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), one16), 8);
+    return _mm_packus_epi16(lo, hi);
+}
+
+/** SSE2：只支持颜色通道顺序不变，或者R与B交换
+*/
+PIXEL_CONVERT_TARGET("sse2")
+static void ConvertRowSSE2(const uint8_t* shuffle, uint8_t nAlpha, bool bSwapRB,
+                           uint32_t* pDst, const uint32_t* pSrc, int32_t nPixels)
+{
+    const __m128i maskRB = _mm_set1_epi32(0x00FF00FF);
+    const __m128i maskGA = _mm_set1_epi32((int)0xFF00FF00);
+    const __m128i alpha16 = _mm_set1_epi16(nAlpha);
+    const __m128i one16 = _mm_set1_epi16(1);
+    int32_t i = 0;
+    for (; i + 4 <= nPixels; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(pSrc + i));
+        if (bSwapRB) {
+            __m128i rb = _mm_and_si128(v, maskRB);
+            rb = _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16));
+            v = _mm_or_si128(_mm_and_si128(v, maskGA), rb);
+        }
+        if (nAlpha != 255) {
+            v = ScaleAlphaSSE2(v, alpha16, one16);
+        }
+        _mm_storeu_si128((__m128i*)(pDst + i), v);
+    }
+    ConvertRowScalar(shuffle, nAlpha, pDst + i, pSrc + i, nPixels - i);
+}
+
+/** SSSE3：支持任意的颜色通道顺序
+*/
+PIXEL_CONVERT_TARGET("ssse3")
+static void ConvertRowSSSE3(const uint8_t* shuffle, uint8_t nAlpha,
+                            uint32_t* pDst, const uint32_t* pSrc, int32_t nPixels)
+{
+    const __m128i shuffleMask = _mm_loadu_si128((const __m128i*)shuffle);
+    const __m128i alpha16 = _mm_set1_epi16(nAlpha);
+    const __m128i one16 = _mm_set1_epi16(1);
+    const __m128i zero = _mm_setzero_si128();
+    int32_t i = 0;
+    for (; i + 4 <= nPixels; i += 4) {
+        __m128i v = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(pSrc + i)), shuffleMask);
+        if (nAlpha != 255) {
+            __m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(v, zero), alpha16);
+            __m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(v, zero), alpha16);
+            lo = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), one16), 8);
+            hi = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), one16), 8);
+            v = _mm_packus_epi16(lo, hi);
+        }
+        _mm_storeu_si128((__m128i*)(pDst + i), v);
+    }
+    ConvertRowScalar(shuffle, nAlpha, pDst + i, pSrc + i, nPixels - i);
+}
+
+/** AVX2：支持任意的颜色通道顺序，每次处理8个像素
+*/
+PIXEL_CONVERT_TARGET("avx2")
+static void ConvertRowAVX2(const uint8_t* shuffle, uint8_t nAlpha,
+                           uint32_t* pDst, const uint32_t* pSrc, int32_t nPixels)
+{
+    const __m128i shuffle128 = _mm_loadu_si128((const __m128i*)shuffle);
+    const __m256i shuffleMask = _mm256_broadcastsi128_si256(shuffle128);
+    const __m256i alpha16 = _mm256_set1_epi16(nAlpha);
+    const __m256i one16 = _mm256_set1_epi16(1);
+    const __m256i zero = _mm256_setzero_si256();
+    int32_t i = 0;
+    for (; i + 8 <= nPixels; i += 8) {
+        //字节重排和拆分/打包均在128位通道内进行，不会改变像素的顺序
+        __m256i v = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(pSrc + i)), shuffleMask);
+        if (nAlpha != 255) {
+            __m256i lo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(v, zero), alpha16);
+            __m256i hi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(v, zero), alpha16);
+            lo = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(lo, _mm256_srli_epi16(lo, 8)), one16), 8);
+            hi = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(hi, _mm256_srli_epi16(hi, 8)), one16), 8);
+            v = _mm256_packus_epi16(lo, hi);
+        }
+        _mm256_storeu_si256((__m256i*)(pDst + i), v);
+    }
+    ConvertRowScalar(shuffle, nAlpha, pDst + i, pSrc + i, nPixels - i);
+}
+
+#endif //DUILIB_PIXEL_CONVERT_X86
+
+#ifdef DUILIB_PIXEL_CONVERT_NEON
+
+/** NEON：支持任意的颜色通道顺序
+*/
+static void ConvertRowNEON(const uint8_t* shuffle, uint8_t nAlpha,
+                           uint32_t* pDst, const uint32_t* pSrc, int32_t nPixels)
+{
+    const uint8x16_t shuffleMask = vld1q_u8(shuffle);
+    const uint8x8_t alpha8 = vdup_n_u8(nAlpha);
+    const uint16x8_t one16 = vdupq_n_u16(1);
+    int32_t i = 0;
+    for (; i + 4 <= nPixels; i += 4) {
+        uint8x16_t v = vqtbl1q_u8(vld1q_u8((const uint8_t*)(pSrc + i)), shuffleMask);
+        if (nAlpha != 255) {
+            uint16x8_t lo = vmull_u8(vget_low_u8(v), alpha8);
+            uint16x8_t hi = vmull_u8(vget_high_u8(v), alpha8);
+            lo = vaddq_u16(vaddq_u16(lo, vshrq_n_u16(lo, 8)), one16);
+            hi = vaddq_u16(vaddq_u16(hi, vshrq_n_u16(hi, 8)), one16);
+            v = vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8));
+        }
+        vst1q_u8((uint8_t*)(pDst + i), v);
+    }
+    ConvertRowScalar(shuffle, nAlpha, pDst + i, pSrc + i, nPixels - i);
+}
+
+#endif //DUILIB_PIXEL_CONVERT_NEON
+
+/** 检测CPU支持的最佳指令集
+*/
+static PixelConvertSimd DetectBestSimd()
+{
+#if defined(DUILIB_PIXEL_CONVERT_X86)
+#if defined(_MSC_VER) && !defined(__clang__)
+    int cpuInfo[4] = { 0, };
+    __cpuid(cpuInfo, 0);
+    const int nMaxLeaf = cpuInfo[0];
+    __cpuid(cpuInfo, 1);
+    const bool bSSE2 = (cpuInfo[3] & (1 << 26)) != 0;
+    const bool bSSSE3 = (cpuInfo[2] & (1 << 9)) != 0;
+    const bool bOSXSAVE = (cpuInfo[2] & (1 << 27)) != 0;
+    const bool bAVX = (cpuInfo[2] & (1 << 28)) != 0;
+    bool bAVX2 = false;
+    if ((nMaxLeaf >= 7) && bOSXSAVE && bAVX) {
+        //操作系统需要支持保存YMM寄存器的状态
+        const unsigned long long xcr0 = _xgetbv(0);
+        if ((xcr0 & 0x6) == 0x6) {
+            __cpuidex(cpuInfo, 7, 0);
+            bAVX2 = (cpuInfo[1] & (1 << 5)) != 0;
+        }
+    }
+#else
+    __builtin_cpu_init();
+    const bool bSSE2 = __builtin_cpu_supports("sse2");
+    const bool bSSSE3 = __builtin_cpu_supports("ssse3");
+    const bool bAVX2 = __builtin_cpu_supports("avx2");
+#endif
+    if (bAVX2) {
+        return PixelConvertSimd::kAVX2;
+    }
+    if (bSSSE3) {
+        return PixelConvertSimd::kSSSE3;
+    }
+    if (bSSE2) {
+        return PixelConvertSimd::kSSE2;
+    }
+    return PixelConvertSimd::kScalar;
+#elif defined(DUILIB_PIXEL_CONVERT_NEON)
+    return PixelConvertSimd::kNEON;
+#else
+    return PixelConvertSimd::kScalar;
+#endif
+}
+
+/** CPU支持的最佳指令集（程序启动时检测一次）
+*/
+static const PixelConvertSimd s_bestSimd = DetectBestSimd();
+
+PixelConvert::PixelConvert(int32_t srcR, int32_t srcG, int32_t srcB, int32_t srcA,
+                           int32_t dstR, int32_t dstG, int32_t dstB, int32_t dstA,
+                           uint8_t nAlpha):
+    m_nAlpha(nAlpha),
+    m_bIdentity(false),
+    m_bSwapRB(false),
+    m_bValid(false),
+    m_simd(s_bestSimd)
+{
+    const int32_t srcOrder[4] = { srcR, srcG, srcB, srcA };
+    const int32_t dstOrder[4] = { dstR, dstG, dstB, dstA };
+    uint8_t pixelShuffle[4] = { 0, 1, 2, 3 };
+    uint32_t nDstMask = 0;
+    m_bValid = true;
+    for (int32_t i = 0; i < 4; ++i) {
+        if ((srcOrder[i] < 0) || (srcOrder[i] > 3) || (dstOrder[i] < 0) || (dstOrder[i] > 3)) {
+            m_bValid = false;
+            break;
+        }
+        pixelShuffle[dstOrder[i]] = (uint8_t)srcOrder[i];
+        nDstMask |= (1u << dstOrder[i]);
+    }
+    if (nDstMask != 0xF) {
+        //目标数据的通道序号有重复
+        m_bValid = false;
+    }
+    ASSERT(m_bValid);
+    for (int32_t i = 0; i < 16; ++i) {
+        m_shuffle[i] = (uint8_t)((i / 4) * 4 + pixelShuffle[i % 4]);
+    }
+    m_bIdentity = (pixelShuffle[0] == 0) && (pixelShuffle[1] == 1) && (pixelShuffle[2] == 2) && (pixelShuffle[3] == 3);
+    m_bSwapRB = (pixelShuffle[0] == 2) && (pixelShuffle[1] == 1) && (pixelShuffle[2] == 0) && (pixelShuffle[3] == 3);
+    if ((m_simd == PixelConvertSimd::kSSE2) && !m_bIdentity && !m_bSwapRB) {
+        //SSE2不支持任意的字节重排
+        m_simd = PixelConvertSimd::kScalar;
+    }
+}
+
+bool PixelConvert::IsValid() const
+{
+    return m_bValid;
+}
+
+PixelConvertSimd PixelConvert::GetSimd() const
+{
+    return m_simd;
+}
+
+PixelConvertSimd PixelConvert::GetBestSimd()
+{
+    return s_bestSimd;
+}
+
+void PixelConvert::ConvertRow(uint32_t* pDst, const uint32_t* pSrc, int32_t nPixels) const
+{
+    if (!m_bValid || (pDst == nullptr) || (pSrc == nullptr) || (nPixels <= 0)) {
+        return;
+    }
+    if (m_bIdentity && (m_nAlpha == 255)) {
+        //无需转换，只复制数据
+        if (pDst != pSrc) {
+            ::memmove(pDst, pSrc, (size_t)nPixels * sizeof(uint32_t));
+        }
+        return;
+    }
+    switch (m_simd) {
+#ifdef DUILIB_PIXEL_CONVERT_X86
+    case PixelConvertSimd::kAVX2:
+        ConvertRowAVX2(m_shuffle, m_nAlpha, pDst, pSrc, nPixels);
+        break;
+    case PixelConvertSimd::kSSSE3:
+        ConvertRowSSSE3(m_shuffle, m_nAlpha, pDst, pSrc, nPixels);
+        break;
+    case PixelConvertSimd::kSSE2:
+        if (m_bIdentity || m_bSwapRB) {
+            ConvertRowSSE2(m_shuffle, m_nAlpha, m_bSwapRB, pDst, pSrc, nPixels);
+        }
+        else {
+            ConvertRowScalar(m_shuffle, m_nAlpha, pDst, pSrc, nPixels);
+        }
+        break;
+#endif
+#ifdef DUILIB_PIXEL_CONVERT_NEON
+    case PixelConvertSimd::kNEON:
+        ConvertRowNEON(m_shuffle, m_nAlpha, pDst, pSrc, nPixels);
+        break;
+#endif
+    default:
+        ConvertRowScalar(m_shuffle, m_nAlpha, pDst, pSrc, nPixels);
+        break;
+    }
+}
+
+void PixelConvert::ConvertRect(uint32_t* pDst, int32_t nDstStride,
+                               const uint32_t* pSrc, int32_t nSrcStride,
+                               const UiRect& rc) const
+{
+    if ((pDst == nullptr) || (pSrc == nullptr) || rc.IsEmpty()) {
+        return;
+    }
+    const int32_t nWidth = rc.Width();
+    for (int32_t nRow = rc.top; nRow < rc.bottom; ++nRow) {
+        ConvertRow(pDst + (size_t)nRow * nDstStride + rc.left,
+                   pSrc + (size_t)nRow * nSrcStride + rc.left,
+                   nWidth);
+    }
+}
+
+} // namespace ui
@@ -0,0 +1,99 @@
+#ifndef UI_RENDER_PIXEL_CONVERT_H_
+#define UI_RENDER_PIXEL_CONVERT_H_
+
+#include "duilib/Core/UiRect.h"
+
+namespace ui
+{
+
+/** 像素转换使用的指令集
+*/
+enum class PixelConvertSimd
+{
+    kScalar,    //无SIMD指令，逐个像素处理
+    kSSE2,      //SSE2指令集（只支持颜色通道顺序不变，或者R与B交换）
+    kSSSE3,     //SSSE3指令集
+    kAVX2,      //AVX2指令集
+    kNEON       //ARM NEON指令集（ARM64）
+};
+
+/** 32位像素数据的转换：在一次遍历中完成数据复制、颜色通道顺序调整和Alpha缩放（预乘Alpha格式，每个通道乘以nAlpha/255）
+*   运行时根据CPU支持的指令集，自动选择SIMD实现，计算结果与逐个像素处理的结果完全一致
+*/
+class PixelConvert
+{
+public:
+    /** 构造函数
+    * @param [in] srcR 源数据中R通道的字节序号（0-3）
+    * @param [in] srcG 源数据中G通道的字节序号（0-3）
+    * @param [in] srcB 源数据中B通道的字节序号（0-3）
+    * @param [in] srcA 源数据中A通道的字节序号（0-3）
+    * @param [in] dstR 目标数据中R通道的字节序号（0-3）
+    * @param [in] dstG 目标数据中G通道的字节序号（0-3）
+    * @param [in] dstB 目标数据中B通道的字节序号（0-3）
+    * @param [in] dstA 目标数据中A通道的字节序号（0-3）
+    * @param [in] nAlpha 透明度，255表示不需要进行Alpha缩放
+    */
+    PixelConvert(int32_t srcR, int32_t srcG, int32_t srcB, int32_t srcA,
+                 int32_t dstR, int32_t dstG, int32_t dstB, int32_t dstA,
+                 uint8_t nAlpha);
+
+    /** 参数是否有效（目标数据的4个通道序号必须互不相同）
+    */
+    bool IsValid() const;
+
+    /** 转换一行像素数据
+    * @param [out] pDst 目标数据
+    * @param [in] pSrc 源数据（可以与目标数据相同，即原地转换）
+    * @param [in] nPixels 像素个数
+    */
+    void ConvertRow(uint32_t* pDst, const uint32_t* pSrc, int32_t nPixels) const;
+
+    /** 转换一个矩形区域内的像素数据
+    * @param [out] pDst 目标数据的起始地址（图像左上角）
+    * @param [in] nDstStride 目标数据每行的像素个数
+    * @param [in] pSrc 源数据的起始地址（图像左上角）
+    * @param [in] nSrcStride 源数据每行的像素个数
+    * @param [in] rc 需要转换的矩形区域
+    */
+    void ConvertRect(uint32_t* pDst, int32_t nDstStride,
+                     const uint32_t* pSrc, int32_t nSrcStride,
+                     const UiRect& rc) const;
+
+    /** 获取当前使用的指令集
+    */
+    PixelConvertSimd GetSimd() const;
+
+    /** 获取CPU支持的最佳指令集（运行时检测）
+    */
+    static PixelConvertSimd GetBestSimd();
+
+private:
+    /** 字节映射表：目标像素的第i个字节 = 源像素的第m_shuffle[i]个字节（重复4次，对应4个像素）
+    */
+    uint8_t m_shuffle[16];
+
+    /** 透明度
+    */
+    uint8_t m_nAlpha;
+
+    /** 颜色通道顺序是否不变
+    */
+    bool m_bIdentity;
+
+    /** 是否只是R与B交换（字节0与字节2交换）
+    */
+    bool m_bSwapRB;
+
+    /** 参数是否有效
+    */
+    bool m_bValid;
+
+    /** 当前使用的指令集
+    */
+    PixelConvertSimd m_simd;
+};
+
+} // namespace ui
+
+#endif // UI_RENDER_PIXEL_CONVERT_H_
@@ -156,7 +156,7 @@ void* Bitmap_GDI::LockPixelBits()
     return m_pLockedBitmapData->Scan0;
 }
 
-void Bitmap_GDI::UnLockPixelBits()
+void Bitmap_GDI::UnLockPixelBits(bool /*bPixelsChanged*/)
 {
     if (m_pBitmap != nullptr && m_pLockedBitmapData != nullptr) {
         m_pBitmap->UnlockBits(m_pLockedBitmapData);
@@ -201,7 +201,7 @@ IBitmap* Bitmap_GDI::Clone()
     }
 
     // 解锁源位图
-    UnLockPixelBits();
+    UnLockPixelBits(false);
 
     return pNewBitmap;
 }
@@ -31,7 +31,7 @@ public:
     virtual UiSize GetSize() const override;
 
     virtual void* LockPixelBits() override;
-    virtual void UnLockPixelBits() override;
+    virtual void UnLockPixelBits(bool bPixelsChanged = true) override;
 
     virtual IBitmap* Clone() override;
 
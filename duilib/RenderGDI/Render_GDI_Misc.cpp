@@ -578,7 +578,7 @@ bool Render_GDI::PaintAndSwapBuffers(IRenderPaint* pRenderPaint)
     HDC hPaintDC = ::BeginPaint(m_hWnd, &ps);
     UiRect rcPaint(ps.rcPaint.left, ps.rcPaint.top, ps.rcPaint.right, ps.rcPaint.bottom);
     if (!rcPaint.IsEmpty() && (hPaintDC != nullptr)) {
-        bRet = pRenderPaint->DoPaint(rcPaint);
+        bRet = pRenderPaint->DoPaint(rcPaint, std::vector<UiRect>());
         if (bRet) {
             bRet = doSwap(hPaintDC, rcPaint);
         }
@@ -590,7 +590,7 @@ bool Render_GDI::PaintAndSwapBuffers(IRenderPaint* pRenderPaint)
         ::EndPaint(m_hWnd, &ps);
         UiRect rcUpdate(rectUpdate.left, rectUpdate.top, rectUpdate.right, rectUpdate.bottom);
 
-        bRet = pRenderPaint->DoPaint(rcUpdate);
+        bRet = pRenderPaint->DoPaint(rcUpdate, std::vector<UiRect>());
         if (bRet) {
             hPaintDC = ::GetDC(m_hWnd);
             bRet = doSwap(hPaintDC, rcUpdate);
@@ -128,8 +128,11 @@ void* Bitmap_Skia::LockPixelBits()
     return pPixelBits;
 }
 
-void Bitmap_Skia::UnLockPixelBits()
+void Bitmap_Skia::UnLockPixelBits(bool bPixelsChanged)
 {
+    if (!bPixelsChanged) {
+        return;
+    }
     void* pPixelBits = nullptr;
     SkPixmap pixmap;
     if (m_pSkBitmap->peekPixels(&pixmap)) {
@@ -138,7 +141,9 @@ void Bitmap_Skia::UnLockPixelBits()
     ASSERT(pPixelBits != nullptr);
     if (pPixelBits != nullptr) {
         UpdateAlphaFlag((uint8_t*)pPixelBits);
-    }    
+    }
+    //像素数据已修改：更新位图的Generation ID，使缩放后的图片缓存失效
+    m_pSkBitmap->notifyPixelsChanged();
 }
 
 IBitmap* Bitmap_Skia::Clone()
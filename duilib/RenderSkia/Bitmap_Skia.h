@@ -46,8 +46,9 @@ public:
     virtual void* LockPixelBits() override;
 
     /** 释放位图数据
+    * @param [in] bPixelsChanged 锁定期间是否修改了位图数据（只读取时传入false，可避免位图相关的缓存失效）
     */
-    virtual void UnLockPixelBits() override;
+    virtual void UnLockPixelBits(bool bPixelsChanged = true) override;
 
     /** 克隆生成新的的位图
     *@return 返回新生成的位图接口，由调用方释放资源
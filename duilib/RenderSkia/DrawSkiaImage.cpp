@@ -1,4 +1,5 @@
 #include "DrawSkiaImage.h"
+#include "SkiaScaledImageCache.h"
 
 #include "duilib/Utils/PerformanceUtil.h"
 
@@ -12,6 +13,7 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkData.h"
+#include "include/core/SkPixmap.h"
 #include "SkiaHeaderEnd.h"
 
 //定义DUILIB_HAVE_OPENCV这个宏，表示启用OpenCV，使用OpenCV对图片进行缩放，速度是最快的
@@ -117,64 +119,123 @@ static bool ResizeSkiaImageByOpenCV(const sk_sp<SkImage>& skImage, const UiRect&
     skNewImage = SkiaResizeWithOpenCV_Opt(skImage, rcDest.Width(), rcDest.Height());
     return skNewImage != nullptr;
 }
-#else
+#endif //end of OpenCV
+
 /** 对Skia的图片进行resize操作，以适配绘制目标大小，避免绘制时缩放导致速度降低(stb_image实现)
+*   支持缩放源图片中的部分区域（比如九宫格图片的各个部分）
 */
-static bool ResizeSkiaImageByStbImage(const sk_sp<SkImage>& /*skImage*/, const UiRect& /*rcSrc*/, const UiRect& /*rcDest*/, sk_sp<SkImage>& /*skNewImage*/)
+static bool ResizeSkiaImageByStbImage(const sk_sp<SkImage>& skImage, const UiRect& rcSrc, const UiRect& rcDest, sk_sp<SkImage>& skNewImage)
 {
-    //屏蔽该功能，经测试发现，按目前的代码，这项开启后，绘制性能明显下降，主要因为这个函数的缩放耗时比Skia自身的缩放耗时要多很多（可能最新版本skia的缩放性能有改进）。
-    return false;
-    //if ((skImage == nullptr) || (rcSrc.left != 0) || (rcSrc.top != 0) || (rcSrc.Width() < 10) || (rcSrc.Height() < 10) || (rcDest.Width() < 10) || (rcDest.Height() < 10)) {
-    //    return false;
-    //}
-    //if ((rcSrc.Width() == rcDest.Width()) && (rcSrc.Height() == rcDest.Height())) {
-    //    //区域相同，无缩放
-    //    return false;
-    //}
-    //if ((skImage->width() != rcSrc.Width()) || (skImage->height() != rcSrc.Height())) {
-    //    //不是整个图片绘制
-    //    return false;
-    //}
-    //SkPixmap srcPixmap;
-    //if (!skImage->peekPixels(&srcPixmap)) {
-    //    return false;
-    //}
-    //if ((srcPixmap.width() != rcSrc.Width()) || (srcPixmap.height() != rcSrc.Height())) {
-    //    //有错误
-    //    return false;
-    //}
-    //PerformanceStat statPerformance(_T("Render_Skia::DrawSkiaImage::ResizeSkiaImageByStbImage"));
-
-    //sk_sp<SkData> skData = SkData::MakeUninitialized(rcDest.Height() * rcDest.Width() * sizeof(uint32_t));
-    //const unsigned char* input_pixels = (const unsigned char*)srcPixmap.addr();
-    //int input_w = srcPixmap.width();
-    //int input_h = srcPixmap.height();
-    //int input_stride_in_bytes = 0;
-    //unsigned char* output_pixels = (unsigned char*)skData->writable_data();
-    //int output_w = rcDest.Width();
-    //int output_h = rcDest.Height();
-    //int output_stride_in_bytes = 0;
-    //stbir_pixel_layout num_channels = STBIR_RGBA;
-    //unsigned char* result = stbir_resize_uint8_linear(input_pixels, input_w, input_h, input_stride_in_bytes,
-    //                                                  output_pixels, output_w, output_h, output_stride_in_bytes,
-    //                                                  num_channels);
-    //if (result != nullptr) {
-    //    skNewImage = SkImages::RasterFromData(SkImageInfo::Make(SkISize::Make(output_w, output_h), skImage->imageInfo().colorInfo()), skData, rcDest.Width() * sizeof(uint32_t));
-    //    if ((skNewImage->height() == rcDest.Height()) && (skNewImage->width() == rcDest.Width())) {
-    //        return (skNewImage != nullptr);
-    //    }
-    //}
-    //return false;
+    if ((skImage == nullptr) || rcSrc.IsEmpty() || rcDest.IsEmpty()) {
+        return false;
+    }
+    SkPixmap srcPixmap;
+    if (!skImage->peekPixels(&srcPixmap)) {
+        return false;
+    }
+    SkPixmap srcSubPixmap;
+    SkIRect rcSubset = SkIRect::MakeLTRB(rcSrc.left, rcSrc.top, rcSrc.right, rcSrc.bottom);
+    if (!srcPixmap.extractSubset(&srcSubPixmap, rcSubset)) {
+        return false;
+    }
+    if ((srcSubPixmap.width() != rcSrc.Width()) || (srcSubPixmap.height() != rcSrc.Height())) {
+        //源区域超出图片范围
+        return false;
+    }
+    stbir_pixel_layout pixelLayout = STBIR_RGBA;
+    if (srcSubPixmap.colorType() == kRGBA_8888_SkColorType) {
+        pixelLayout = (srcSubPixmap.alphaType() == kPremul_SkAlphaType) ? STBIR_RGBA_PM : STBIR_RGBA;
+    }
+    else if (srcSubPixmap.colorType() == kBGRA_8888_SkColorType) {
+        pixelLayout = (srcSubPixmap.alphaType() == kPremul_SkAlphaType) ? STBIR_BGRA_PM : STBIR_BGRA;
+    }
+    else {
+        return false;
+    }
+    PerformanceStat statPerformance(_T("Render_Skia::DrawSkiaImage::ResizeSkiaImageByStbImage"));
+
+    SkImageInfo dstInfo = srcSubPixmap.info().makeWH(rcDest.Width(), rcDest.Height());
+    const size_t nDstRowBytes = dstInfo.minRowBytes();
+    sk_sp<SkData> skData = SkData::MakeUninitialized(dstInfo.computeMinByteSize());
+    unsigned char* result = stbir_resize_uint8_linear((const unsigned char*)srcSubPixmap.addr(),
+                                                      srcSubPixmap.width(), srcSubPixmap.height(), (int)srcSubPixmap.rowBytes(),
+                                                      (unsigned char*)skData->writable_data(),
+                                                      dstInfo.width(), dstInfo.height(), (int)nDstRowBytes,
+                                                      pixelLayout);
+    if (result == nullptr) {
+        return false;
+    }
+    skNewImage = SkImages::RasterFromData(dstInfo, skData, nDstRowBytes);
+    return (skNewImage != nullptr) && (skNewImage->width() == rcDest.Width()) && (skNewImage->height() == rcDest.Height());
 }
-#endif //end of OpenCV
 
+/** 对Skia的图片进行resize操作（优先使用OpenCV，不支持时使用stb_image）
+*/
+static bool ResizeSkiaImage(const sk_sp<SkImage>& skImage, const UiRect& rcSrc, const UiRect& rcDest, sk_sp<SkImage>& skNewImage)
+{
+#ifdef DUILIB_HAVE_OPENCV
+    if (ResizeSkiaImageByOpenCV(skImage, rcSrc, rcDest, skNewImage)) {
+        return true;
+    }
+#endif
+    return ResizeSkiaImageByStbImage(skImage, rcSrc, rcDest, skNewImage);
+}
+
+/** 获取缓存中缩放后的图片（如果缓存中没有，并且该图片已经第二次以相同大小绘制，则缩放后放入缓存）
+*/
+static sk_sp<SkImage> GetScaledSkiaImage(SkCanvas* pSkCanvas,
+                                         uint32_t nImageId,
+                                         const sk_sp<SkImage>& skSrcImage,
+                                         const UiRect& rcSrc,
+                                         const UiRect& rcDest)
+{
+    if ((nImageId == 0) || (rcSrc.Width() <= 0) || (rcSrc.Height() <= 0) || (rcDest.Width() <= 0) || (rcDest.Height() <= 0)) {
+        return nullptr;
+    }
+    if ((rcSrc.Width() == rcDest.Width()) && (rcSrc.Height() == rcDest.Height())) {
+        //区域相同，无缩放
+        return nullptr;
+    }
+    if (!pSkCanvas->getTotalMatrix().isTranslate()) {
+        //画布有缩放或者旋转等变换，绘制时仍需Skia缩放
+        return nullptr;
+    }
+    SkiaScaledImageCache& scaledImageCache = SkiaScaledImageCache::Instance();
+    if (!scaledImageCache.IsCacheableSize(rcDest.Width(), rcDest.Height())) {
+        return nullptr;
+    }
+    SkiaScaledImageKey key;
+    key.m_nImageId = nImageId;
+    key.m_nSrcLeft = rcSrc.left;
+    key.m_nSrcTop = rcSrc.top;
+    key.m_nSrcRight = rcSrc.right;
+    key.m_nSrcBottom = rcSrc.bottom;
+    key.m_nDestWidth = rcDest.Width();
+    key.m_nDestHeight = rcDest.Height();
+#ifdef DUILIB_HAVE_OPENCV
+    key.m_nFilter = 1;
+#endif
+    bool bCreateImage = false;
+    sk_sp<SkImage> skScaledImage = scaledImageCache.FindImage(key, bCreateImage);
+    if ((skScaledImage == nullptr) && bCreateImage) {
+        if (ResizeSkiaImage(skSrcImage, rcSrc, rcDest, skScaledImage)) {
+            scaledImageCache.AddImage(key, skScaledImage);
+        }
+        else {
+            skScaledImage.reset();
+        }
+    }
+    return skScaledImage;
+}
 
 void DrawSkiaImage::DrawImage(SkCanvas* pSkCanvas,
                               const UiRect& rcDest,
                               const SkPoint& skPointOrg,
                               const sk_sp<SkImage>& skSrcImage,
                               const UiRect& rcSrc,
-                              const SkPaint& skPaint)
+                              const SkPaint& skPaint,
+                              uint32_t nImageId,
+                              const UiRect* pClipDest)
 {
     if ((pSkCanvas == nullptr) || (skSrcImage == nullptr)) {
         return;
@@ -186,27 +247,44 @@ void DrawSkiaImage::DrawImage(SkCanvas* pSkCanvas,
     SkIRect rcSkSrcI = { rcSrc.left, rcSrc.top, rcSrc.right, rcSrc.bottom };
     SkRect rcSkSrc = SkRect::Make(rcSkSrcI);
 
-#ifdef DUILIB_HAVE_OPENCV
-    sk_sp<SkImage> skNewImage;
-    if (ResizeSkiaImageByOpenCV(skSrcImage, rcSrc, rcDest, skNewImage)) {
-        PerformanceStat statPerformance(_T("Render_Skia::DrawSkiaImage::DrawImage drawImageRect(OpenCV)"));
-        rcSkSrc.fRight = rcSkSrc.fLeft + skNewImage->width();
-        rcSkSrc.fBottom = rcSkSrc.fTop + skNewImage->height();
-        pSkCanvas->drawImageRect(skNewImage, rcSkSrc, rcSkDest, SkSamplingOptions(), &skPaint, SkCanvas::kStrict_SrcRectConstraint);
-    }
-#else
-    sk_sp<SkImage> skNewImage;
-    if (ResizeSkiaImageByStbImage(skSrcImage, rcSrc, rcDest, skNewImage)) {
-        PerformanceStat statPerformance(_T("Render_Skia::DrawSkiaImage::DrawImage drawImageRect(StbImage)"));
-        rcSkSrc.fRight = rcSkSrc.fLeft + skNewImage->width();
-        rcSkSrc.fBottom = rcSkSrc.fTop + skNewImage->height();
-        pSkCanvas->drawImageRect(skNewImage, rcSkSrc, rcSkDest, SkSamplingOptions(), &skPaint, SkCanvas::kStrict_SrcRectConstraint);
+    if (pClipDest != nullptr) {
+        SkIRect rcSkClipI = { pClipDest->left, pClipDest->top, pClipDest->right, pClipDest->bottom };
+        SkRect rcSkClip = SkRect::Make(rcSkClipI);
+        rcSkClip.offset(skPointOrg);
+        pSkCanvas->save();
+        pSkCanvas->clipRect(rcSkClip);
+    }
+
+    sk_sp<SkImage> skScaledImage = GetScaledSkiaImage(pSkCanvas, nImageId, skSrcImage, rcSrc, rcDest);
+    if (skScaledImage != nullptr) {
+        //使用缓存中缩放后的图片，按原大小绘制
+        PerformanceStat statPerformance(_T("Render_Skia::DrawSkiaImage::DrawImage drawImage(Scaled Cache)"));
+        pSkCanvas->drawImage(skScaledImage, rcSkDest.fLeft, rcSkDest.fTop, SkSamplingOptions(), &skPaint);
     }
-#endif
     else {
+        //与缓存路径的缩放效果保持一致（缓存路径为线性插值缩放），避免首次绘制与后续绘制的效果不同
         PerformanceStat statPerformance(_T("Render_Skia::DrawSkiaImage::DrawImage drawImageRect(Skia Only)"));
-        pSkCanvas->drawImageRect(skSrcImage, rcSkSrc, rcSkDest, SkSamplingOptions(), &skPaint, SkCanvas::kStrict_SrcRectConstraint);
+        pSkCanvas->drawImageRect(skSrcImage, rcSkSrc, rcSkDest, SkSamplingOptions(SkFilterMode::kLinear), &skPaint, SkCanvas::kStrict_SrcRectConstraint);
     }
+
+    if (pClipDest != nullptr) {
+        pSkCanvas->restore();
+    }
+}
+
+void DrawSkiaImage::SetScaledImageCacheBudget(size_t nBudgetBytes)
+{
+    SkiaScaledImageCache::Instance().SetBudget(nBudgetBytes);
+}
+
+size_t DrawSkiaImage::GetScaledImageCacheBudget()
+{
+    return SkiaScaledImageCache::Instance().GetBudget();
+}
+
+void DrawSkiaImage::ClearScaledImageCache()
+{
+    SkiaScaledImageCache::Instance().Clear();
 }
 
 } // namespace ui
@@ -19,19 +19,37 @@ class DrawSkiaImage
 public:
 
     /** 调用Canvas绘制Skia的图片，如果图片有缩放，会进行优化（因Skia自身的图片缩放速度较慢）
+    *   以相同大小反复绘制的缩放图片，缩放结果会放入缓存，后续绘制时直接使用
     * @param [in] pSkCanvas canvas接口
     * @param [in] rcDest 图片绘制的目标矩形区域
     * @param [in] skPointOrg 目标区域在canvas中的视图偏移坐标（左上角）
     * @param [in] skSrcImage 需要绘制的图片接口
     * @param [in] rcSrc 需要绘制的图片内容在源图片中的矩形区域
     * @param [in] skPaint paint属性
+    * @param [in] nImageId 源图片的ID（位图的SkBitmap::getGenerationID()），用于缓存缩放后的图片，为0时表示不使用缓存
+    * @param [in] pClipDest 目标区域的裁剪矩形（比如平铺绘制时超出范围的最后一块），为nullptr时表示不裁剪
+    *             按完整的rcDest缩放后再裁剪，使被裁剪的图块与其他图块共用同一个缩放缓存
     */
     static void DrawImage(SkCanvas* pSkCanvas,
                           const UiRect& rcDest,
                           const SkPoint& skPointOrg,
                           const sk_sp<SkImage>& skSrcImage,
                           const UiRect& rcSrc,
-                          const SkPaint& skPaint);
+                          const SkPaint& skPaint,
+                          uint32_t nImageId,
+                          const UiRect* pClipDest = nullptr);
+
+    /** 设置缩放后的图片缓存的内存预算（字节），为0时表示禁用缓存
+    */
+    static void SetScaledImageCacheBudget(size_t nBudgetBytes);
+
+    /** 获取缩放后的图片缓存的内存预算（字节）
+    */
+    static size_t GetScaledImageCacheBudget();
+
+    /** 清空缩放后的图片缓存
+    */
+    static void ClearScaledImageCache();
 
 };
 
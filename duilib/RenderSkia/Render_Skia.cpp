@@ -10,6 +10,9 @@
 #include "duilib/RenderSkia/Font_Skia.h"
 #include "duilib/RenderSkia/SkTextBox.h"
 #include "duilib/RenderSkia/DrawSkiaImage.h"
+#include "duilib/RenderSkia/SkiaTextMeasureCache.h"
+#include "duilib/RenderSkia/SkiaTextDrawCache.h"
+#include "duilib/RenderSkia/SkiaBoxShadowCache.h"
 #include "duilib/Render/BitmapAlpha.h"
 
 #include "duilib/Utils/StringUtil.h"
@@ -32,6 +35,7 @@
 #include "include/core/SkFontStyle.h"
 #include "include/core/SkFontMetrics.h"
 #include "include/core/SkPathEffect.h"
+#include "include/core/SkPictureRecorder.h"
 #include "include/effects/SkDashPathEffect.h"
 #include "include/effects/SkGradientShader.h"
 #include "include/effects/SkImageFilters.h"
@@ -162,10 +166,24 @@ IBitmap* Render_Skia::MakeImageSnapshot()
 void Render_Skia::ClearAlpha(const UiRect& rcDirty, uint8_t alpha)
 {
     void* pPixelBits = GetPixelBits();
-    if (pPixelBits != nullptr) {
-        BitmapAlpha bitmapAlpha((uint8_t*)pPixelBits, GetWidth(), GetHeight(), sizeof(uint32_t));
-        bitmapAlpha.ClearAlpha(rcDirty, alpha);
+    if (pPixelBits == nullptr) {
+        return;
+    }
+    SkCanvas* skCanvas = GetSkCanvas();
+    if ((skCanvas != nullptr) && !skCanvas->isClipRect() && !skCanvas->isClipEmpty()) {
+        //裁剪区域由多个矩形组成（多区域局部绘制），只清除裁剪区域内的数据，避免清除不在绘制范围内的像素
+        //颜色(alpha,255,255,255)预乘后，每个字节的值均为alpha，与BitmapAlpha::ClearAlpha的结果一致
+        SkPaint skPaint;
+        skPaint.setBlendMode(SkBlendMode::kSrc);
+        skPaint.setColor(SkColorSetARGB(alpha, 255, 255, 255));
+        skCanvas->save();
+        skCanvas->resetMatrix();
+        skCanvas->drawIRect(SkIRect::MakeLTRB(rcDirty.left, rcDirty.top, rcDirty.right, rcDirty.bottom), skPaint);
+        skCanvas->restore();
+        return;
     }
+    BitmapAlpha bitmapAlpha((uint8_t*)pPixelBits, GetWidth(), GetHeight(), sizeof(uint32_t));
+    bitmapAlpha.ClearAlpha(rcDirty, alpha);
 }
 
 void Render_Skia::RestoreAlpha(const UiRect& rcDirty, const UiPadding& rcShadowPadding, uint8_t alpha)
@@ -529,6 +547,8 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
     if (skImage == nullptr) {
         skImage = skSrcBitmap.asImage();
     }
+    //源图片的ID，用于缓存缩放后的图片
+    const uint32_t nImageId = skSrcBitmap.getGenerationID();
 
     UiRect rcTemp;
     UiRect rcDrawSource;
@@ -586,7 +606,7 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
         //绘制中间部分
         if (!bTiledX && !bTiledY) {
             //拉伸的方式绘制
-            DrawSkiaImage::DrawImage(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint);
+            DrawSkiaImage::DrawImage(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint, nImageId);
         }
         else if (bTiledX && bTiledY) {
             //平铺：横向和纵向均平铺绘制
@@ -624,17 +644,21 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
                         lDestRight = rcDrawDest.right;
                     }
 
+                    //超出范围的图块：按完整图块绘制后裁剪，与其他图块共用缩放缓存
                     rcDrawSource.left = rcSource.left + rcSourceCorners.left;
                     rcDrawSource.top = rcSource.top + rcSourceCorners.top;
-                    rcDrawSource.right = rcDrawSource.left + lDrawWidth;
-                    rcDrawSource.bottom = rcDrawSource.top + lDrawHeight;
+                    rcDrawSource.right = rcDrawSource.left + nImageWidth;
+                    rcDrawSource.bottom = rcDrawSource.top + nImageHeight;
 
                     UiRect rcDestTemp;
                     rcDestTemp.left = lDestLeft;
-                    rcDestTemp.right = lDestRight;
+                    rcDestTemp.right = lDestLeft + nImageWidth;
                     rcDestTemp.top = lDestTop;
-                    rcDestTemp.bottom = lDestBottom;
-                    DrawSkiaImage::DrawImage(skCanvas, rcDestTemp, *m_pSkPointOrg, skImage, rcDrawSource, skPaint);
+                    rcDestTemp.bottom = lDestTop + nImageHeight;
+                    const UiRect rcClipTemp(lDestLeft, lDestTop, lDestRight, lDestBottom);
+                    const bool bClipped = (lDrawWidth != nImageWidth) || (lDrawHeight != nImageHeight);
+                    DrawSkiaImage::DrawImage(skCanvas, rcDestTemp, *m_pSkPointOrg, skImage, rcDrawSource, skPaint, nImageId,
+                                             bClipped ? &rcClipTemp : nullptr);
 
                     nPosX += lDrawWidth;
                 }
@@ -660,19 +684,21 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
                     lDestRight = rcDrawDest.right;
                 }
 
-                //源区域：如果设置了边角，则仅包含中间区域
+                //源区域：如果设置了边角，则仅包含中间区域（超出范围的图块按完整图块绘制后裁剪，与其他图块共用缩放缓存）
                 rcDrawSource.left = rcSource.left + rcSourceCorners.left;
                 rcDrawSource.top = rcSource.top + rcSourceCorners.top;
-                rcDrawSource.right = rcDrawSource.left + lDrawWidth;
+                rcDrawSource.right = rcDrawSource.left + nImageWidth;
                 rcDrawSource.bottom = rcSource.bottom - rcSourceCorners.bottom;
 
                 UiRect rcDestTemp;
                 rcDestTemp.top = rcDrawDest.top;
                 rcDestTemp.bottom = rcDrawDest.bottom;
                 rcDestTemp.left = lDestLeft;
-                rcDestTemp.right = lDestRight;
+                rcDestTemp.right = lDestLeft + nImageWidth;
 
-                DrawSkiaImage::DrawImage(skCanvas, rcDestTemp, *m_pSkPointOrg, skImage, rcDrawSource, skPaint);
+                const UiRect rcClipTemp(lDestLeft, rcDrawDest.top, lDestRight, rcDrawDest.bottom);
+                DrawSkiaImage::DrawImage(skCanvas, rcDestTemp, *m_pSkPointOrg, skImage, rcDrawSource, skPaint, nImageId,
+                                         (lDrawWidth != nImageWidth) ? &rcClipTemp : nullptr);
 
                 nPosX += lDrawWidth;
             }
@@ -697,18 +723,21 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
                     lDestBottom = rcDrawDest.bottom;
                 }
 
+                //超出范围的图块：按完整图块绘制后裁剪，与其他图块共用缩放缓存
                 rcDrawSource.left = rcSource.left + rcSourceCorners.left;
                 rcDrawSource.top = rcSource.top + rcSourceCorners.top;
                 rcDrawSource.right = rcSource.right - rcSourceCorners.right;
-                rcDrawSource.bottom = rcDrawSource.top + lDrawHeight;
+                rcDrawSource.bottom = rcDrawSource.top + nImageHeight;
 
                 UiRect rcDestTemp;
                 rcDestTemp.left = rcDrawDest.left;
                 rcDestTemp.right = rcDrawDest.right;
                 rcDestTemp.top = lDestTop;
-                rcDestTemp.bottom = lDestBottom;
+                rcDestTemp.bottom = lDestTop + nImageHeight;
 
-                DrawSkiaImage::DrawImage(skCanvas, rcDestTemp, *m_pSkPointOrg, skImage, rcDrawSource, skPaint);
+                const UiRect rcClipTemp(rcDrawDest.left, lDestTop, rcDrawDest.right, lDestBottom);
+                DrawSkiaImage::DrawImage(skCanvas, rcDestTemp, *m_pSkPointOrg, skImage, rcDrawSource, skPaint, nImageId,
+                                         (lDrawHeight != nImageHeight) ? &rcClipTemp : nullptr);
                 nPosY += lDrawHeight;
             }
         }
@@ -727,7 +756,7 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
         rcDrawSource.right = rcSource.left + rcSourceCorners.left;
         rcDrawSource.bottom = rcSource.top + rcSourceCorners.top;
         if (UiRect::Intersect(rcTemp, rcPaint, rcDrawDest)) {
-            DrawSkiaImage::DrawImage(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint);
+            DrawSkiaImage::DrawImage(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint, nImageId);
         }
     }
     // top
@@ -743,7 +772,7 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
         rcDrawSource.right = rcSource.right - rcSourceCorners.right;
         rcDrawSource.bottom = rcSource.top + rcSourceCorners.top;
         if (UiRect::Intersect(rcTemp, rcPaint, rcDrawDest)) {
-            DrawSkiaImage::DrawImage(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint);
+            DrawSkiaImage::DrawImage(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint, nImageId);
         }
     }
     // right-top
@@ -759,7 +788,7 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
         rcDrawSource.right = rcSource.right;
         rcDrawSource.bottom = rcSource.top + rcSourceCorners.top;
         if (UiRect::Intersect(rcTemp, rcPaint, rcDrawDest)) {
-            DrawSkiaImage::DrawImage(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint);
+            DrawSkiaImage::DrawImage(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint, nImageId);
         }
     }
     // left
@@ -775,7 +804,7 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
         rcDrawSource.right = rcSource.left + rcSourceCorners.left;
         rcDrawSource.bottom = rcSource.bottom - rcSourceCorners.bottom;
         if (UiRect::Intersect(rcTemp, rcPaint, rcDrawDest)) {
-            DrawSkiaImage::DrawImage(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint);
+            DrawSkiaImage::DrawImage(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint, nImageId);
         }
     }
     // right
@@ -791,7 +820,7 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
         rcDrawSource.right = rcSource.right;
         rcDrawSource.bottom = rcSource.bottom - rcSourceCorners.bottom;
         if (UiRect::Intersect(rcTemp, rcPaint, rcDrawDest)) {
-            DrawSkiaImage::DrawImage(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint);
+            DrawSkiaImage::DrawImage(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint, nImageId);
         }
     }
     // left-bottom
@@ -807,7 +836,7 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
         rcDrawSource.right = rcSource.left + rcSourceCorners.left;
         rcDrawSource.bottom = rcSource.bottom;
         if (UiRect::Intersect(rcTemp, rcPaint, rcDrawDest)) {
-            DrawSkiaImage::DrawImage(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint);
+            DrawSkiaImage::DrawImage(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint, nImageId);
         }
     }
     // bottom
@@ -823,7 +852,7 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
         rcDrawSource.right = rcSource.right - rcSourceCorners.right;
         rcDrawSource.bottom = rcSource.bottom;
         if (UiRect::Intersect(rcTemp, rcPaint, rcDrawDest)) {
-            DrawSkiaImage::DrawImage(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint);
+            DrawSkiaImage::DrawImage(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint, nImageId);
         }
     }
     // right-bottom
@@ -839,7 +868,7 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
         rcDrawSource.right = rcSource.right;
         rcDrawSource.bottom = rcSource.bottom;
         if (UiRect::Intersect(rcTemp, rcPaint, rcDrawDest)) {
-            DrawSkiaImage::DrawImage(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint);
+            DrawSkiaImage::DrawImage(skCanvas, rcDrawDest, *m_pSkPointOrg, skImage, rcDrawSource, skPaint, nImageId);
         }
     }
 }
@@ -915,7 +944,7 @@ void Render_Skia::DrawImageRect(const UiRect& rcPaint, IBitmap* pBitmap,
             isMatrixSet = true;
         }
     }
-    DrawSkiaImage::DrawImage(skCanvas, rcDest, *m_pSkPointOrg, skImage, rcSource, skPaint);
+    DrawSkiaImage::DrawImage(skCanvas, rcDest, *m_pSkPointOrg, skImage, rcSource, skPaint, skSrcBitmap.getGenerationID());
     if (isMatrixSet) {
         skCanvas->resetMatrix();
     }
@@ -1601,20 +1630,17 @@ void Render_Skia::FillPath(const IPath* path, const UiRect& rc, UiColor dwColor,
     }
 }
 
-void Render_Skia::DrawString(const DString& strText, const DrawStringParam& drawParam)
+void Render_Skia::DrawStringImpl(SkCanvas* skCanvas, SkPoint* pPointOrg,
+                                 const DString& strText, const DrawStringParam& drawParam)
 {
-    if ((GetWidth() <= 0) || (GetHeight() <= 0)) {
-        //这种情况是窗口大小为0的情况，返回，不加断言
-        return;
-    }
     if (drawParam.uFormat & TEXT_VERTICAL) {
         //纵向绘制文本
-        VerticalDrawText drawTextUtil(GetSkCanvas(), m_pSkPaint, m_pSkPointOrg);
+        VerticalDrawText drawTextUtil(skCanvas, m_pSkPaint, pPointOrg);
         return drawTextUtil.DrawString(strText, drawParam);
     }
     else if ((drawParam.uFormat & TEXT_HJUSTIFY) || (drawParam.fWordSpacing > 0.0001f)) {
         //当横向文本，对齐方式设置为两端对齐时，或者设置了字间距时，使用该实现方案（因为修改SkTextBox的实现比较困难，维护难度高）
-        HorizontalDrawText drawTextUtil(GetSkCanvas(), m_pSkPaint, m_pSkPointOrg);
+        HorizontalDrawText drawTextUtil(skCanvas, m_pSkPaint, pPointOrg);
         return drawTextUtil.DrawString(strText, drawParam);
     }
 
@@ -1632,7 +1658,6 @@ void Render_Skia::DrawString(const DString& strText, const DrawStringParam& draw
         return;
     }
 
-    SkCanvas* skCanvas = GetSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas == nullptr) {
         return;
@@ -1666,7 +1691,7 @@ void Render_Skia::DrawString(const DString& strText, const DrawStringParam& draw
     SkIRect rcSkDestI = { drawParam.textRect.left, drawParam.textRect.top,
                           drawParam.textRect.right, drawParam.textRect.bottom };
     SkRect rcSkDest = SkRect::Make(rcSkDestI);
-    rcSkDest.offset(*m_pSkPointOrg);
+    rcSkDest.offset(*pPointOrg);
 
     //设置绘制属性
     SkTextBox skTextBox;
@@ -1734,12 +1759,148 @@ void Render_Skia::DrawString(const DString& strText, const DrawStringParam& draw
                    skPaint);
 }
 
+/** 生成文本测量结果缓存的KEY
+* @return 如果该文本的测量结果可以缓存返回true，否则返回false
+*/
+static bool GetTextMeasureKey(const DString& strText, const MeasureStringParam& measureParam, SkiaTextMeasureKey& measureKey)
+{
+    if (!SkiaTextMeasureCache::IsCacheableText(strText.size())) {
+        return false;
+    }
+    Font_Skia* pSkiaFont = dynamic_cast<Font_Skia*>(measureParam.pFont);
+    if (pSkiaFont == nullptr) {
+        return false;
+    }
+    const SkFont* pSkFont = pSkiaFont->GetFontHandle();
+    if ((pSkFont == nullptr) || (pSkFont->getTypeface() == nullptr)) {
+        return false;
+    }
+    measureKey.m_nTypefaceId = pSkFont->getTypeface()->uniqueID();
+    measureKey.m_fFontSize = pSkFont->getSize();
+    measureKey.m_fFontScaleX = pSkFont->getScaleX();
+    measureKey.m_fFontSkewX = pSkFont->getSkewX();
+    measureKey.m_bFontEmbolden = pSkFont->isEmbolden();
+    measureKey.m_nFontEdging = (uint8_t)pSkFont->getEdging();
+    measureKey.m_nRectSize = measureParam.rectSize;
+    measureKey.m_uFormat = measureParam.uFormat;
+    measureKey.m_fSpacingMul = measureParam.fSpacingMul;
+    measureKey.m_fSpacingAdd = measureParam.fSpacingAdd;
+    measureKey.m_fWordSpacing = measureParam.fWordSpacing;
+    measureKey.m_bUseFontHeight = measureParam.bUseFontHeight;
+    measureKey.m_bRotate90ForAscii = measureParam.bRotate90ForAscii;
+    if ((measureParam.uFormat & DrawStringFormat::TEXT_SINGLELINE) &&
+        !(measureParam.uFormat & (TEXT_VERTICAL | TEXT_HJUSTIFY)) && (measureParam.fWordSpacing <= 0.0001f)) {
+        //横向单行文本（SkTextBox的实现）：测量结果与限制宽度无关
+        measureKey.m_nRectSize = DUI_NOSET_VALUE;
+    }
+    //KEY中的文本指向调用方的字符串，只在放入缓存时才复制
+    measureKey.m_text = strText;
+    measureKey.m_nTextHash = std::hash<SkiaTextMeasureKey::TextView>()(measureKey.m_text);
+    return true;
+}
+
+/** 生成文本绘制结果缓存的KEY
+* @return 如果该文本的绘制结果可以缓存返回true，否则返回false
+*/
+static bool GetTextDrawKey(const DString& strText, const DrawStringParam& drawParam, SkiaTextDrawKey& drawKey)
+{
+    if (drawParam.textRect.IsEmpty() || (drawParam.pFont == nullptr)) {
+        return false;
+    }
+    MeasureStringParam measureParam;
+    measureParam.pFont = drawParam.pFont;
+    measureParam.uFormat = drawParam.uFormat;
+    measureParam.fSpacingMul = drawParam.fSpacingMul;
+    measureParam.fSpacingAdd = drawParam.fSpacingAdd;
+    measureParam.fWordSpacing = drawParam.fWordSpacing;
+    measureParam.bUseFontHeight = drawParam.bUseFontHeight;
+    measureParam.bRotate90ForAscii = drawParam.bRotate90ForAscii;
+    if (!GetTextMeasureKey(strText, measureParam, drawKey.m_textKey)) {
+        return false;
+    }
+    //绘制结果与绘制区域的大小有关（对齐方式、断行、省略号、裁剪），但与绘制区域的位置无关
+    drawKey.m_textKey.m_nRectSize = drawParam.textRect.Width();
+    drawKey.m_nRectHeight = drawParam.textRect.Height();
+
+    //文字颜色（与绘制时的处理一致：设置了透明度时，替换文字颜色的透明度）
+    UiColor textColor = drawParam.dwTextColor;
+    if (drawParam.uFade != 0xFF) {
+        textColor = UiColor(drawParam.uFade, textColor.GetR(), textColor.GetG(), textColor.GetB());
+    }
+    drawKey.m_nTextColor = textColor.GetARGB();
+    drawKey.m_bUnderline = drawParam.pFont->IsUnderline();
+    drawKey.m_bStrikeOut = drawParam.pFont->IsStrikeOut();
+    return true;
+}
+
+void Render_Skia::DrawString(const DString& strText, const DrawStringParam& drawParam)
+{
+    if ((GetWidth() <= 0) || (GetHeight() <= 0)) {
+        //这种情况是窗口大小为0的情况，返回，不加断言
+        return;
+    }
+    SkCanvas* skCanvas = GetSkCanvas();
+    ASSERT(skCanvas != nullptr);
+    if (skCanvas == nullptr) {
+        return;
+    }
+    //优先回放缓存的绘制结果（字体、文本、绘制区域的大小、颜色和绘制参数都相同时，绘制结果相同）
+    SkiaTextDrawKey drawKey;
+    if (!GetTextDrawKey(strText, drawParam, drawKey)) {
+        DrawStringImpl(skCanvas, m_pSkPointOrg, strText, drawParam);
+        return;
+    }
+    bool bRecordPicture = false;
+    sk_sp<SkPicture> skPicture = SkiaTextDrawCache::Instance().FindPicture(drawKey, bRecordPicture);
+    if ((skPicture == nullptr) && bRecordPicture) {
+        //以绘制区域的左上角为原点录制绘制结果（不设置裁剪时，文字可能绘制到区域以外，所以录制区域不限于绘制区域）
+        DrawStringParam recordParam = drawParam;
+        recordParam.textRect.Offset(-drawParam.textRect.left, -drawParam.textRect.top);
+        SkPoint recordPointOrg = SkPoint::Make(0, 0);
+        const SkScalar fMaxBounds = 65536.0f;
+        SkPictureRecorder skRecorder;
+        SkCanvas* pRecordCanvas = skRecorder.beginRecording(SkRect::MakeLTRB(-fMaxBounds, -fMaxBounds, fMaxBounds, fMaxBounds));
+        ASSERT(pRecordCanvas != nullptr);
+        if (pRecordCanvas != nullptr) {
+            DrawStringImpl(pRecordCanvas, &recordPointOrg, strText, recordParam);
+            skPicture = skRecorder.finishRecordingAsPicture();
+            if (skPicture != nullptr) {
+                SkiaTextDrawCache::Instance().AddPicture(drawKey, skPicture);
+            }
+        }
+    }
+    if (skPicture != nullptr) {
+        SkMatrix skMatrix = SkMatrix::Translate(drawParam.textRect.left + m_pSkPointOrg->fX,
+                                                drawParam.textRect.top + m_pSkPointOrg->fY);
+        skCanvas->drawPicture(skPicture, &skMatrix, nullptr);
+    }
+    else {
+        DrawStringImpl(skCanvas, m_pSkPointOrg, strText, drawParam);
+    }
+}
+
 UiRect Render_Skia::MeasureString(const DString& strText, const MeasureStringParam& measureParam)
 {
     if ((GetWidth() <= 0) || (GetHeight() <= 0)) {
         //这种情况是窗口大小为0的情况，返回空，不加断言
         return UiRect();
     }
+    //优先从缓存中获取测量结果（字体、文本和测量参数都相同时，测量结果相同）
+    SkiaTextMeasureKey measureKey;
+    const bool bCacheable = GetTextMeasureKey(strText, measureParam, measureKey);
+    UiRect rcMeasure;
+    if (bCacheable && SkiaTextMeasureCache::Instance().FindRect(measureKey, rcMeasure)) {
+        return rcMeasure;
+    }
+    rcMeasure = MeasureStringImpl(strText, measureParam);
+    if (bCacheable) {
+        SkiaTextMeasureCache::Instance().AddRect(measureKey, rcMeasure);
+    }
+    return rcMeasure;
+}
+
+UiRect Render_Skia::MeasureStringImpl(const DString& strText, const MeasureStringParam& measureParam)
+{
     if (measureParam.uFormat & TEXT_VERTICAL) {
         //纵向绘制文本
         VerticalDrawText drawTextUtil(GetSkCanvas(), m_pSkPaint, m_pSkPointOrg);
@@ -2006,6 +2167,60 @@ size_t Render_Skia::GetUTF16CharCount(const DStringW::value_type* srcPtr, size_t
     return 1;
 }
 
+/** 获取阴影的九宫格图片：对一个最小尺寸的圆角矩形做一次模糊，图片的中间一行（一列）沿边的方向是均匀的，可以按九宫格方式拉伸
+* @param [in] key 阴影的KEY
+* @param [in] nShadowWidth 阴影区域（模糊前）的宽度
+* @param [in] nShadowHeight 阴影区域（模糊前）的高度
+* @param [in] skPaint 绘制阴影的属性
+* @return 如果阴影区域太小（无法按九宫格拉伸）或者图片太大，返回nullptr
+*/
+static sk_sp<SkImage> GetBoxShadowImage(const SkiaBoxShadowKey& key,
+                                        int32_t nShadowWidth, int32_t nShadowHeight,
+                                        const SkPaint& skPaint)
+{
+    //模糊的扩展范围（3倍sigma以外的模糊效果可以忽略）
+    const int32_t nBlurExtent = key.m_nBlurRadius * 3;
+    //最小的圆角矩形：四个角及其模糊范围以外，中间保留1个像素
+    const int32_t nShapeWidth = (key.m_nRoundWidth + nBlurExtent) * 2 + 1;
+    const int32_t nShapeHeight = (key.m_nRoundHeight + nBlurExtent) * 2 + 1;
+    if ((nShadowWidth < nShapeWidth) || (nShadowHeight < nShapeHeight)) {
+        return nullptr;
+    }
+    const int32_t nImageWidth = nShapeWidth + nBlurExtent * 2;
+    const int32_t nImageHeight = nShapeHeight + nBlurExtent * 2;
+    SkiaBoxShadowCache& boxShadowCache = SkiaBoxShadowCache::Instance();
+    if (!boxShadowCache.IsCacheableSize(nImageWidth, nImageHeight)) {
+        return nullptr;
+    }
+    sk_sp<SkImage> skImage = boxShadowCache.FindImage(key);
+    if (skImage != nullptr) {
+        return skImage;
+    }
+
+    PerformanceStat statPerformance(_T("Render_Skia::DrawBoxShadow CreateBoxShadowImage"));
+    SkBitmap skBitmap;
+    if (!skBitmap.tryAllocN32Pixels(nImageWidth, nImageHeight)) {
+        return nullptr;
+    }
+    skBitmap.eraseColor(SK_ColorTRANSPARENT);
+    SkCanvas skCanvas(skBitmap);
+    SkPaint paint = skPaint;
+    paint.setAntiAlias(true);
+    paint.setStyle(SkPaint::kStrokeAndFill_Style);
+    paint.setColor(key.m_nColor);
+    paint.setImageFilter(SkImageFilters::Blur((SkScalar)key.m_nBlurRadius, (SkScalar)key.m_nBlurRadius, SkTileMode::kDecal, nullptr));
+    SkPath shadowPath;
+    shadowPath.addRoundRect(SkRect::MakeXYWH((SkScalar)nBlurExtent, (SkScalar)nBlurExtent, (SkScalar)nShapeWidth, (SkScalar)nShapeHeight),
+                            (SkScalar)key.m_nRoundWidth, (SkScalar)key.m_nRoundHeight);
+    skCanvas.drawPath(shadowPath, paint);
+    skBitmap.setImmutable();
+    skImage = skBitmap.asImage();
+    if (skImage != nullptr) {
+        boxShadowCache.AddImage(key, skImage);
+    }
+    return skImage;
+}
+
 void Render_Skia::DrawBoxShadow(const UiRect& rc,
                                 const UiSize& roundSize, 
                                 const UiPoint& cpOffset, 
@@ -2056,6 +2271,27 @@ void Render_Skia::DrawBoxShadow(const UiRect& rc,
     excludePath.offset(m_pSkPointOrg->fX, m_pSkPointOrg->fY, &skPathExclude);
     skCanvas->clipPath(skPathExclude, SkClipOp::kDifference);
 
+    //优先使用九宫格图片绘制阴影（画布有缩放或者旋转等变换时，九宫格图片的模糊效果不准确，不使用）
+    if (skCanvas->getTotalMatrix().isTranslate()) {
+        SkiaBoxShadowKey shadowKey;
+        shadowKey.m_nBlurRadius = nBlurRadius;
+        shadowKey.m_nRoundWidth = std::max(roundSize.cx, 0);
+        shadowKey.m_nRoundHeight = std::max(roundSize.cy, 0);
+        shadowKey.m_nColor = dwColor.GetARGB();
+        sk_sp<SkImage> skShadowImage = GetBoxShadowImage(shadowKey, destRc.Width(), destRc.Height(), *m_pSkPaint);
+        if (skShadowImage != nullptr) {
+            const int32_t nBlurExtent = nBlurRadius * 3;
+            SkRect rcShadow = srcRc;
+            rcShadow.offset(m_pSkPointOrg->fX + cpOffset.x, m_pSkPointOrg->fY + cpOffset.y);
+            rcShadow.outset((SkScalar)nBlurExtent, (SkScalar)nBlurExtent);
+            const SkIRect rcCenter = SkIRect::MakeXYWH(shadowKey.m_nRoundWidth + nBlurExtent * 2,
+                                                       shadowKey.m_nRoundHeight + nBlurExtent * 2,
+                                                       1, 1);
+            skCanvas->drawImageNine(skShadowImage.get(), rcCenter, rcShadow, SkFilterMode::kNearest, nullptr);
+            return;
+        }
+    }
+
     SkPath skPath;
     shadowPath.offset(m_pSkPointOrg->fX, m_pSkPointOrg->fY, &skPath);
 
@@ -226,6 +226,16 @@ private:
     */
     SkTextEncoding GetTextEncoding() const;
 
+    /** 计算指定文本字符串的宽度和高度（不使用缓存）
+    */
+    UiRect MeasureStringImpl(const DString& strText, const MeasureStringParam& measureParam);
+
+    /** 绘制文字（不使用缓存）
+    * @param [in] skCanvas 绘制的画布
+    * @param [in] pPointOrg 绘制的原点坐标
+    */
+    void DrawStringImpl(SkCanvas* skCanvas, SkPoint* pPointOrg, const DString& strText, const DrawStringParam& drawParam);
+
     /** 获取位图数据
     * @return 返回位图数据的地址, 数据长度为: 高度*宽度*sizeof(uint32_t)
     */
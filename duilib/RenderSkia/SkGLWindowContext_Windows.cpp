@@ -196,7 +196,7 @@ bool SkGLWindowContext_Windows::PaintAndSwapBuffers(IRender* /*pRender*/, IRende
     ::EndPaint(hWnd, &ps);
 
     //执行绘制
-    pRenderPaint->DoPaint(rcPaint);
+    pRenderPaint->DoPaint(rcPaint, std::vector<UiRect>());
 
     //标记绘制区域为有效区域
     ::ValidateRect(hWnd, nullptr);
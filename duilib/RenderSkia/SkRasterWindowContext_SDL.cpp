@@ -1,5 +1,6 @@
 #include "SkRasterWindowContext_SDL.h"
 #include "duilib/Render/IRender.h"
+#include "duilib/Render/PixelConvert.h"
 #include "duilib/Utils/PerformanceUtil.h"
 
 #ifdef DUILIB_BUILD_FOR_SDL
@@ -120,20 +121,28 @@ bool SkRasterWindowContext_SDL::PaintAndSwapBuffers(IRender* pRender, IRenderPai
         return false;
     }
 
-    //获取需要绘制的区域
-    UiRect rcPaint;
-    bool bUpdateRect = pRenderPaint->GetUpdateRect(rcPaint); //返回true表示支持局部绘制，只绘制更新的部分区域，以提高效率
-    if (bUpdateRect && !rcPaint.IsEmpty()) {
+    //获取需要绘制的区域（多个互不相交的矩形）
+    UiRect rcClient;
+    GetClientRect(rcClient);
+    std::vector<UiRect> paintRects;
+    bool bUpdateRect = pRenderPaint->GetUpdateRects(paintRects); //返回true表示支持局部绘制，只绘制更新的部分区域，以提高效率
+    if (bUpdateRect) {
         //确保区域的有效性
-        UiRect rcClient;
-        GetClientRect(rcClient);
-        rcPaint.Intersect(rcClient);
+        auto iter = paintRects.begin();
+        while (iter != paintRects.end()) {
+            if (!iter->Intersect(rcClient)) {
+                iter = paintRects.erase(iter);
+            }
+            else {
+                ++iter;
+            }
+        }
     }
-    if (rcPaint.IsEmpty()) {
+    if (paintRects.empty()) {
         //不支持局部绘制，每次都是需要重绘整个窗口的客户区域
-        GetClientRect(rcPaint);
+        paintRects.push_back(rcClient);
     }
-    if (rcPaint.IsEmpty()) {
+    if (rcClient.IsEmpty()) {
         //无需绘制
         return false;
     }
@@ -141,41 +150,45 @@ bool SkRasterWindowContext_SDL::PaintAndSwapBuffers(IRender* pRender, IRenderPai
     //窗口透明度
     uint8_t nLayeredWindowAlpha = pRenderPaint->GetLayeredWindowAlpha();
 
-    //是否为完全绘制
-    const bool bFullPaint = (rcPaint.Width() == width()) && (rcPaint.Height() == height());
-    SkCanvas* skCanvas = nullptr;
-    if (!bFullPaint) {
+    //执行绘制：裁剪区域设置为所有脏区域的并集，只遍历一次控件树，只绘制与脏区域相交的控件
+    UiRect rcPaintBounds = paintRects.front();
+    for (const UiRect& rcPaint : paintRects) {
+        rcPaintBounds.Union(rcPaint);
+    }
+    SkCanvas* skCanvas = m_fBackbufferSurface->getCanvas();
+    const bool bClip = !IsFullPaint(paintRects) && (skCanvas != nullptr);
+    if (bClip) {
         //使用裁剪区域，避免绘制其他无关区域的数据
-        skCanvas = m_fBackbufferSurface->getCanvas();
-        if (skCanvas != nullptr) {
-            skCanvas->save();
-            skCanvas->clipIRect(SkIRect::MakeLTRB(rcPaint.left, rcPaint.top, rcPaint.right, rcPaint.bottom));
+        SkRegion clipRegion;
+        for (const UiRect& rcPaint : paintRects) {
+            clipRegion.op(SkIRect::MakeLTRB(rcPaint.left, rcPaint.top, rcPaint.right, rcPaint.bottom), SkRegion::kUnion_Op);
         }
+        skCanvas->save();
+        skCanvas->clipRegion(clipRegion);
+    }
+    bool bRet = pRenderPaint->DoPaint(rcPaintBounds, bClip ? paintRects : std::vector<UiRect>());
+    if (bClip) {
+        skCanvas->restore();
     }
-
-    //执行绘制
-    bool bRet = pRenderPaint->DoPaint(rcPaint);
     if (bRet) {
         //绘制完成后，更新到窗口
-        SwapPaintBuffers(rcPaint, nLayeredWindowAlpha);
+        SwapPaintBuffers(paintRects, nLayeredWindowAlpha);
     }
 
     //绘制完成后，将已经绘制的区域标记为有效区域
     if (bUpdateRect) {
-        ValidateRect(rcPaint);
-    }
-
-    if (skCanvas != nullptr) {
-        skCanvas->restore();
+        for (UiRect& rcPaint : paintRects) {
+            ValidateRect(rcPaint);
+        }
     }
     return bRet;
 }
 
-bool SkRasterWindowContext_SDL::SwapPaintBuffers(const UiRect& rcPaint, uint8_t nLayeredWindowAlpha)
+bool SkRasterWindowContext_SDL::SwapPaintBuffers(const std::vector<UiRect>& paintRects, uint8_t nLayeredWindowAlpha)
 {
     PerformanceStat statPerformance(_T("PaintWindow, SkRasterWindowContext_SDL::SwapPaintBuffers"));
-    ASSERT(!rcPaint.IsEmpty());
-    if (rcPaint.IsEmpty()) {
+    ASSERT(!paintRects.empty());
+    if (paintRects.empty()) {
         return false;
     }
     ASSERT(m_sdlWindow != nullptr);
@@ -191,7 +204,7 @@ bool SkRasterWindowContext_SDL::SwapPaintBuffers(const UiRect& rcPaint, uint8_t
         return false;
     }
 
-    if (SwapPaintBuffersFast(rcPaint, nLayeredWindowAlpha)) {
+    if (SwapPaintBuffersFast(paintRects, nLayeredWindowAlpha)) {
         //直接通过窗口的Surface更新绘制数据到窗口设备(不使用GPU，速度更快)
         return true;
     }
@@ -219,20 +232,20 @@ bool SkRasterWindowContext_SDL::SwapPaintBuffers(const UiRect& rcPaint, uint8_t
 
     //将界面数据复制到纹理
     bool bDrawOk = false;
-    if ((rcPaint.Width() != width()) || (rcPaint.Height() != height())) {
-        //局部绘制：只绘制更新的部分
-        SDL_Rect rect;
-        rect.x = rcPaint.left;
-        rect.y = rcPaint.top;
-        rect.w = rcPaint.Width();
-        rect.h = rcPaint.Height();        
-        SkIRect bounds = SkIRect::MakeLTRB(rcPaint.left, rcPaint.top, rcPaint.right, rcPaint.bottom);
-        sk_sp<SkImage> snapshotImage = m_fBackbufferSurface->makeImageSnapshot(bounds);
-        if (snapshotImage != nullptr) {
-            SkPixmap pixmap;
-            if (snapshotImage->peekPixels(&pixmap) && (pixmap.addr() != nullptr) && (pixmap.width() == rcPaint.Width()) && (pixmap.height() == rcPaint.Height())) {
-                SDL_UpdateTexture(m_sdlTextrue, &rect, pixmap.addr(), (int)pixmap.rowBytes());
-                bDrawOk = true;
+    if (!IsFullPaint(paintRects)) {
+        //局部绘制：只绘制更新的部分（逐个区域更新）
+        bDrawOk = true;
+        for (const UiRect& rcPaint : paintRects) {
+            SDL_Rect rect;
+            rect.x = rcPaint.left;
+            rect.y = rcPaint.top;
+            rect.w = rcPaint.Width();
+            rect.h = rcPaint.Height();
+            //直接引用后台缓存中的数据，按行距更新，无需复制
+            const uint32_t* pPixels = (const uint32_t*)m_fSurfaceMemory.get() + rcPaint.top * width() + rcPaint.left;
+            if (!SDL_UpdateTexture(m_sdlTextrue, &rect, pPixels, width() * (int)sizeof(uint32_t))) {
+                bDrawOk = false;
+                break;
             }
         }
         ASSERT(bDrawOk);
@@ -257,10 +270,10 @@ bool SkRasterWindowContext_SDL::SwapPaintBuffers(const UiRect& rcPaint, uint8_t
     return true;
 }
 
-bool SkRasterWindowContext_SDL::SwapPaintBuffersFast(const UiRect& rcPaint, uint8_t nLayeredWindowAlpha)
+bool SkRasterWindowContext_SDL::SwapPaintBuffersFast(const std::vector<UiRect>& paintRects, uint8_t nLayeredWindowAlpha)
 {
-    ASSERT(!rcPaint.IsEmpty());
-    if (rcPaint.IsEmpty()) {
+    ASSERT(!paintRects.empty());
+    if (paintRects.empty()) {
         return false;
     }
     ASSERT(m_sdlWindow != nullptr);
@@ -304,38 +317,42 @@ bool SkRasterWindowContext_SDL::SwapPaintBuffersFast(const UiRect& rcPaint, uint
         return false;
     }
 
+    //像素数据的转换：复制数据、调整颜色顺序、窗口透明度在一次遍历中完成（根据CPU支持的指令集自动选择SIMD实现）
+    PixelConvert pixelConvert(backR, backG, backB, backA, sdlR, sdlG, sdlB, sdlA, nLayeredWindowAlpha);
+    if (!pixelConvert.IsValid()) {
+        return false;
+    }
+
     //统计性能
     PerformanceStat statPerformance(_T("PaintWindow, SkRasterWindowContext_SDL::SwapPaintBuffersFast"));
 
     bool bDrawOk = false;
-    if ((rcPaint.Width() != width()) || (rcPaint.Height() != height())) {
-        //局部绘制：只绘制更新的部分
-        SDL_Rect rect;
-        rect.x = rcPaint.left;
-        rect.y = rcPaint.top;
-        rect.w = rcPaint.Width();
-        rect.h = rcPaint.Height();
-        //按行复制数据(每次复制1行数据)
-        const int32_t nMaxRow = rcPaint.top + rcPaint.Height();
-        const int32_t nWidth = rcPaint.Width();
-        for (int32_t nRow = rcPaint.top; nRow < nMaxRow; ++nRow) {
-            ::memcpy((uint32_t*)sdlSurface->pixels + nRow * sdlSurface->w + rcPaint.left,
-                     (uint32_t*)m_fSurfaceMemory.get() + nRow * sdlSurface->w + rcPaint.left,
-                     nWidth * sizeof(uint32_t));
+    if (!IsFullPaint(paintRects)) {
+        //局部绘制：只绘制更新的部分（各个区域互不相交，逐个区域复制数据）
+        std::vector<SDL_Rect> sdlRects;
+        sdlRects.reserve(paintRects.size());
+        const int32_t nTotalCount = (int32_t)paintRects.size();
+        for (const UiRect& rcPaint : paintRects) {
+            SDL_Rect rect;
+            rect.x = rcPaint.left;
+            rect.y = rcPaint.top;
+            rect.w = rcPaint.Width();
+            rect.h = rcPaint.Height();
+            sdlRects.push_back(rect);
+
+            //按行复制数据，同时处理颜色顺序和窗口透明度
+            pixelConvert.ConvertRect((uint32_t*)sdlSurface->pixels, sdlSurface->w,
+                                     (const uint32_t*)m_fSurfaceMemory.get(), sdlSurface->w,
+                                     rcPaint);
         }
-
-        //处理颜色顺序
-        UpdateColorByteOrder(sdlSurface->pixels, sdlSurface->w, rcPaint, backR, backG, backB, backA, sdlR, sdlG, sdlB, sdlA);
-        UpdateColorAlpha(sdlSurface->pixels, sdlSurface->w, rcPaint, nLayeredWindowAlpha, sdlR, sdlG, sdlB, sdlA);
-        SDL_UpdateWindowSurfaceRects(m_sdlWindow, &rect, 1);
+        SDL_UpdateWindowSurfaceRects(m_sdlWindow, sdlRects.data(), nTotalCount);
         bDrawOk = true;
         ASSERT(bDrawOk);
     }
     if (!bDrawOk) {
         //完整绘制
-        ::memcpy(sdlSurface->pixels, m_fSurfaceMemory.get(), sdlSurface->h * sdlSurface->pitch);
-        UpdateColorByteOrder(sdlSurface->pixels, sdlSurface->w, rcPaint, backR, backG, backB, backA, sdlR, sdlG, sdlB, sdlA);
-        UpdateColorAlpha(sdlSurface->pixels, sdlSurface->w, rcPaint, nLayeredWindowAlpha, sdlR, sdlG, sdlB, sdlA);
+        //数据连续存储，按一行处理
+        pixelConvert.ConvertRow((uint32_t*)sdlSurface->pixels, (const uint32_t*)m_fSurfaceMemory.get(), sdlSurface->w * sdlSurface->h);
         SDL_UpdateWindowSurface(m_sdlWindow);
     }
     return true;
@@ -405,65 +422,13 @@ int32_t SkRasterWindowContext_SDL::GetColorByteOrder(uint32_t mask) const
     return colorOrder;
 }
 
-void SkRasterWindowContext_SDL::UpdateColorByteOrder(void* surfacePixels, int32_t nSurfaceWidth, const UiRect& rcPaint,
-                                                     int32_t backR, int32_t backG, int32_t backB, int32_t backA,
-                                                     int32_t sdlR, int32_t sdlG, int32_t sdlB, int32_t sdlA) const
+bool SkRasterWindowContext_SDL::IsFullPaint(const std::vector<UiRect>& paintRects) const
 {
-    if ((surfacePixels == nullptr) || (nSurfaceWidth < 1) || rcPaint.IsEmpty()) {
-        return;
-    }
-    bool bDiffR = sdlR != backR;
-    bool bDiffG = sdlG != backG;
-    bool bDiffB = sdlB != backB;
-    bool bDiffA = sdlA != backA;
-    if (!bDiffR && !bDiffG && !bDiffB && !bDiffA) {
-        //颜色格式相同，无需更新颜色数据
-        return;
-    }
-    uint32_t colorValue = 0;
-    const int32_t nMaxRow = rcPaint.top + rcPaint.Height();
-    const int32_t nWidth = rcPaint.Width();
-    for (int32_t nRow = rcPaint.top; nRow < nMaxRow; ++nRow) {
-        for (int32_t nCol = 0; nCol < nWidth; ++nCol) {
-            uint32_t* pColorValue = (uint32_t*)surfacePixels + nRow * nSurfaceWidth + rcPaint.left + nCol;
-            colorValue = *pColorValue;
-            if (bDiffR) {
-                ((uint8_t*)pColorValue)[sdlR] = ((uint8_t*)&colorValue)[backR];
-            }
-            if (bDiffG) {
-                ((uint8_t*)pColorValue)[sdlG] = ((uint8_t*)&colorValue)[backG];
-            }
-            if (bDiffB) {
-                ((uint8_t*)pColorValue)[sdlB] = ((uint8_t*)&colorValue)[backB];
-            }
-            if (bDiffA) {
-                ((uint8_t*)pColorValue)[sdlA] = ((uint8_t*)&colorValue)[backA];
-            }
-        }
-    }
-}
-
-void SkRasterWindowContext_SDL::UpdateColorAlpha(void* surfacePixels, int32_t nSurfaceWidth, const UiRect& rcPaint, uint8_t nLayeredWindowAlpha,
-                                                 int32_t sdlR, int32_t sdlG, int32_t sdlB, int32_t sdlA)
-{
-    if ((surfacePixels == nullptr) || (nSurfaceWidth < 1) || rcPaint.IsEmpty() || (nLayeredWindowAlpha == 255)) {
-        return;
-    }
-    const int32_t nMaxRow = rcPaint.top + rcPaint.Height();
-    const int32_t nWidth = rcPaint.Width();
-    for (int32_t nRow = rcPaint.top; nRow < nMaxRow; ++nRow) {
-        for (int32_t nCol = 0; nCol < nWidth; ++nCol) {
-            uint32_t* pColorValue = (uint32_t*)surfacePixels + nRow * nSurfaceWidth + rcPaint.left + nCol;
-            uint8_t& r = ((uint8_t*)pColorValue)[sdlR];
-            uint8_t& g = ((uint8_t*)pColorValue)[sdlG];
-            uint8_t& b = ((uint8_t*)pColorValue)[sdlB];
-            uint8_t& a = ((uint8_t*)pColorValue)[sdlA];
-            r = r * nLayeredWindowAlpha / 255;
-            g = g * nLayeredWindowAlpha / 255;
-            b = b * nLayeredWindowAlpha / 255;
-            a = a * nLayeredWindowAlpha / 255;
-        }
+    if (paintRects.size() != 1) {
+        return false;
     }
+    const UiRect& rcPaint = paintRects.front();
+    return (rcPaint.Width() == width()) && (rcPaint.Height() == height());
 }
 
 void SkRasterWindowContext_SDL::GetClientRect(UiRect& rcClient) const
@@ -9,6 +9,7 @@
 
 #include "include/core/SkSurface.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkRegion.h"
 #include "src/base/SkAutoMalloc.h"
 #include "tools/window/RasterWindowContext.h"
 
@@ -20,6 +21,8 @@
 
 #include "SkiaHeaderEnd.h"
 
+#include <vector>
+
 //SDL的类型，提前声明
 struct SDL_Window;
 struct SDL_Texture;
@@ -58,22 +61,22 @@ protected:
     virtual void onSwapBuffers() override;
 
     /** 绘制结束后，绘制数据从渲染引擎更新到窗口
-    * @param [in] hPaintDC 当前绘制的DC
-    * @param [in] rcPaint 绘制的区域
-    * @param [in] pRender 绘制引擎接口，用于将绘制结果应用到窗口
+    * @param [in] paintRects 绘制的区域列表（各个矩形之间互不相交）
     * @param [in] nLayeredWindowAlpha 窗口透明度，在UpdateLayeredWindow函数中作为参数使用
     * @return 成功返回true，失败则返回false
     */
-    bool SwapPaintBuffers(const UiRect& rcPaint, uint8_t nLayeredWindowAlpha);
+    bool SwapPaintBuffers(const std::vector<UiRect>& paintRects, uint8_t nLayeredWindowAlpha);
 
     /** 绘制结束后，绘制数据从渲染引擎更新到窗口(直接通过窗口的Surface更新绘制数据到窗口设备)
-    * @param [in] hPaintDC 当前绘制的DC
-    * @param [in] rcPaint 绘制的区域
-    * @param [in] pRender 绘制引擎接口，用于将绘制结果应用到窗口
+    * @param [in] paintRects 绘制的区域列表（各个矩形之间互不相交）
     * @param [in] nLayeredWindowAlpha 窗口透明度，在UpdateLayeredWindow函数中作为参数使用
     * @return 成功返回true，失败则返回false
     */
-    bool SwapPaintBuffersFast(const UiRect& rcPaint, uint8_t nLayeredWindowAlpha);
+    bool SwapPaintBuffersFast(const std::vector<UiRect>& paintRects, uint8_t nLayeredWindowAlpha);
+
+    /** 判断绘制区域是否为整个窗口的客户区
+    */
+    bool IsFullPaint(const std::vector<UiRect>& paintRects) const;
 
     /** 获取当前窗口的客户区矩形
     * @param [out] rcClient 返回窗口的客户区坐标
@@ -101,17 +104,6 @@ private:
     */
     int32_t GetColorByteOrder(uint32_t mask) const;
 
-    /** 更新颜值的顺序
-    */
-    void UpdateColorByteOrder(void* surfacePixels, int32_t nSurfaceWidth, const UiRect& rcPaint,
-                              int32_t backR, int32_t backG, int32_t backB, int32_t backA,
-                              int32_t sdlR, int32_t sdlG, int32_t sdlB, int32_t sdlA) const;
-
-    /** 更新颜色中的Alpha值
-    */
-    void UpdateColorAlpha(void* surfacePixels, int32_t nSurfaceWidth, const UiRect& rcPaint, uint8_t nLayeredWindowAlpha,
-                          int32_t sdlR, int32_t sdlG, int32_t sdlB, int32_t sdlA);
-
 private:
     /** Surface数据
     */
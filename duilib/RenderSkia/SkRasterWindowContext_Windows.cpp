@@ -152,7 +152,7 @@ bool SkRasterWindowContext_Windows::PaintAndSwapBuffers(IRender* pRender, IRende
     rcPaint.bottom = ps.rcPaint.bottom;
     if (!rcPaint.IsEmpty() && (hPaintDC != nullptr)) {
         //执行绘制
-        bRet = pRenderPaint->DoPaint(rcPaint);
+        bRet = pRenderPaint->DoPaint(rcPaint, std::vector<UiRect>());
 
         //绘制完成后，更新到窗口
         SwapPaintBuffers(hPaintDC, rcPaint, pRender, nLayeredWindowAlpha);
@@ -174,7 +174,7 @@ bool SkRasterWindowContext_Windows::PaintAndSwapBuffers(IRender* pRender, IRende
         rcUpdate.bottom = rectUpdate.bottom;
 
         //执行绘制
-        bRet = pRenderPaint->DoPaint(rcUpdate);
+        bRet = pRenderPaint->DoPaint(rcUpdate, std::vector<UiRect>());
 
         //绘制完成后，更新到窗口
         hPaintDC = ::GetDC(hWnd);
@@ -0,0 +1,85 @@
+#include "SkiaBoxShadowCache.h"
+
+namespace ui
+{
+
+/** 缓存的最大元素个数
+*/
+static const size_t kMaxBoxShadowItemCount = 256;
+
+SkiaBoxShadowCache::SkiaBoxShadowCache():
+    m_imageCache(kMaxBoxShadowItemCount, 8 * 1024 * 1024)
+{
+}
+
+SkiaBoxShadowCache::~SkiaBoxShadowCache()
+{
+}
+
+SkiaBoxShadowCache& SkiaBoxShadowCache::Instance()
+{
+    static SkiaBoxShadowCache self;
+    return self;
+}
+
+size_t SkiaBoxShadowCache::TKeyHash::operator()(const SkiaBoxShadowKey& key) const
+{
+    size_t nHash = std::hash<uint32_t>()(key.m_nColor);
+    SkiaHashCombine(nHash, std::hash<int32_t>()(key.m_nBlurRadius));
+    SkiaHashCombine(nHash, std::hash<int32_t>()(key.m_nRoundWidth));
+    SkiaHashCombine(nHash, std::hash<int32_t>()(key.m_nRoundHeight));
+    return nHash;
+}
+
+sk_sp<SkImage> SkiaBoxShadowCache::FindImage(const SkiaBoxShadowKey& key)
+{
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    const sk_sp<SkImage>* pImage = m_imageCache.Find(key);
+    return (pImage != nullptr) ? *pImage : nullptr;
+}
+
+void SkiaBoxShadowCache::AddImage(const SkiaBoxShadowKey& key, const sk_sp<SkImage>& skImage)
+{
+    ASSERT(skImage != nullptr);
+    if (skImage == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    m_imageCache.Put(key, skImage, skImage->imageInfo().computeMinByteSize());
+}
+
+bool SkiaBoxShadowCache::IsCacheableSize(int32_t nWidth, int32_t nHeight) const
+{
+    if ((nWidth <= 0) || (nHeight <= 0)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    const size_t nImageBytes = (size_t)nWidth * (size_t)nHeight * sizeof(uint32_t);
+    return nImageBytes <= (m_imageCache.GetBudget() / 4);
+}
+
+void SkiaBoxShadowCache::SetBudget(size_t nBudgetBytes)
+{
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    m_imageCache.SetBudget(nBudgetBytes);
+}
+
+size_t SkiaBoxShadowCache::GetBudget() const
+{
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    return m_imageCache.GetBudget();
+}
+
+size_t SkiaBoxShadowCache::GetCacheBytes() const
+{
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    return m_imageCache.GetCacheBytes();
+}
+
+void SkiaBoxShadowCache::Clear()
+{
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    m_imageCache.Clear();
+}
+
+} // namespace ui
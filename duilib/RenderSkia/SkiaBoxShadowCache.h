@@ -0,0 +1,112 @@
+#ifndef UI_RENDER_SKIA_BOX_SHADOW_CACHE_H_
+#define UI_RENDER_SKIA_BOX_SHADOW_CACHE_H_
+
+#include "duilib/Core/UiRect.h"
+#include "duilib/RenderSkia/SkiaLruCache.h"
+
+#include "SkiaHeaderBegin.h"
+#include "include/core/SkImage.h"
+#include "SkiaHeaderEnd.h"
+
+#include <mutex>
+
+namespace ui
+{
+
+/** 阴影九宫格图片缓存的KEY
+*   扩展半径只影响阴影的绘制区域大小，不影响九宫格图片，所以不包含在KEY中
+*/
+struct SkiaBoxShadowKey
+{
+    //模糊半径
+    int32_t m_nBlurRadius = 0;
+
+    //阴影的圆角宽度和高度
+    int32_t m_nRoundWidth = 0;
+    int32_t m_nRoundHeight = 0;
+
+    //阴影的颜色
+    uint32_t m_nColor = 0;
+
+    bool operator == (const SkiaBoxShadowKey& r) const
+    {
+        return (m_nBlurRadius == r.m_nBlurRadius) &&
+               (m_nRoundWidth == r.m_nRoundWidth) && (m_nRoundHeight == r.m_nRoundHeight) &&
+               (m_nColor == r.m_nColor);
+    }
+};
+
+/** 阴影九宫格图片缓存（按内存占用计算的LRU缓存，超出内存预算时淘汰最久未使用的图片）
+*   绘制阴影时，每次都需要对整个阴影区域做高斯模糊，耗时较多；模糊后的圆角矩形，四个角以外的边缘部分沿边的方向是均匀的，
+*   所以只需对一个小的圆角矩形做一次模糊，生成九宫格图片，再按九宫格方式拉伸到任意大小的阴影区域；
+*   同一种阴影（模糊半径、圆角、颜色相同）的所有控件共用一个图片
+*   （支持多线程访问）
+*/
+class SkiaBoxShadowCache
+{
+public:
+    SkiaBoxShadowCache();
+    ~SkiaBoxShadowCache();
+    SkiaBoxShadowCache(const SkiaBoxShadowCache&) = delete;
+    SkiaBoxShadowCache& operator = (const SkiaBoxShadowCache&) = delete;
+
+    /** 获取单例对象
+    */
+    static SkiaBoxShadowCache& Instance();
+
+public:
+    /** 查找阴影的九宫格图片
+    * @param [in] key 阴影的KEY
+    * @return 返回缓存中的图片，如果不在缓存中返回nullptr
+    */
+    sk_sp<SkImage> FindImage(const SkiaBoxShadowKey& key);
+
+    /** 将阴影的九宫格图片放入缓存
+    * @param [in] key 阴影的KEY
+    * @param [in] skImage 阴影的九宫格图片
+    */
+    void AddImage(const SkiaBoxShadowKey& key, const sk_sp<SkImage>& skImage);
+
+    /** 单个图片是否可以放入缓存（单个图片的大小不超过内存预算的1/4）
+    * @param [in] nWidth 图片的宽度
+    * @param [in] nHeight 图片的高度
+    */
+    bool IsCacheableSize(int32_t nWidth, int32_t nHeight) const;
+
+    /** 设置缓存的内存预算（字节），为0时表示禁用缓存
+    */
+    void SetBudget(size_t nBudgetBytes);
+
+    /** 获取缓存的内存预算（字节）
+    */
+    size_t GetBudget() const;
+
+    /** 获取缓存中的图片占用的内存（字节）
+    */
+    size_t GetCacheBytes() const;
+
+    /** 清空缓存
+    */
+    void Clear();
+
+private:
+    /** KEY的哈希函数
+    */
+    struct TKeyHash
+    {
+        size_t operator()(const SkiaBoxShadowKey& key) const;
+    };
+
+private:
+    /** 阴影九宫格图片的LRU缓存
+    */
+    SkiaLruCache<SkiaBoxShadowKey, sk_sp<SkImage>, TKeyHash> m_imageCache;
+
+    /** 多线程同步锁
+    */
+    mutable std::mutex m_cacheMutex;
+};
+
+} // namespace ui
+
+#endif // UI_RENDER_SKIA_BOX_SHADOW_CACHE_H_
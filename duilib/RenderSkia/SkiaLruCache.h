@@ -0,0 +1,218 @@
+#ifndef UI_RENDER_SKIA_LRU_CACHE_H_
+#define UI_RENDER_SKIA_LRU_CACHE_H_
+
+#include <list>
+#include <unordered_map>
+#include <functional>
+#include <cstddef>
+
+namespace ui
+{
+
+/** 将一个值的哈希值合并到已有的哈希值中（用于计算缓存KEY的哈希值）
+*/
+inline void SkiaHashCombine(size_t& nHash, size_t nValue)
+{
+    nHash ^= nValue + 0x9e3779b9 + (nHash << 6) + (nHash >> 2);
+}
+
+/** LRU缓存中保存的KEY（默认实现：保存KEY的副本）
+*   如果KEY中引用了外部数据（比如文本），需要提供自定义的实现，在缓存元素中保存外部数据的副本，并让KEY指向该副本
+*/
+template<typename TKey>
+class SkiaLruStoredKey
+{
+public:
+    explicit SkiaLruStoredKey(const TKey& key): m_key(key) {}
+    const TKey& GetKey() const { return m_key; }
+
+private:
+    TKey m_key;
+};
+
+/** 按元素个数和内存占用限制的LRU缓存（超出限制时淘汰最久未使用的元素），Skia渲染相关的各个缓存共用
+*   1. 映射表的KEY指向LRU队列元素中保存的KEY，KEY只存储一份；
+*   2. 每个元素记录其占用的内存（由调用方计算），元素个数或者内存占用超出限制时，从队尾开始淘汰；
+*   3. 不支持多线程访问，由调用方加锁
+* @param TKey 查找时使用的KEY，需要支持 == 运算符
+* @param TValue 缓存的值
+* @param TKeyHash KEY的哈希函数
+* @param TStoredKey 缓存元素中保存的KEY，需要支持从TKey构造，并提供GetKey()函数
+*/
+template<typename TKey, typename TValue, typename TKeyHash, typename TStoredKey = SkiaLruStoredKey<TKey>>
+class SkiaLruCache
+{
+public:
+    /** 构造函数
+    * @param [in] nMaxCount 最大元素个数
+    * @param [in] nBudgetBytes 内存预算（字节），为0时表示禁用缓存
+    */
+    SkiaLruCache(size_t nMaxCount, size_t nBudgetBytes):
+        m_nMaxCount(nMaxCount),
+        m_nBudgetBytes(nBudgetBytes),
+        m_nCacheBytes(0)
+    {
+    }
+    SkiaLruCache(const SkiaLruCache&) = delete;
+    SkiaLruCache& operator = (const SkiaLruCache&) = delete;
+
+public:
+    /** 查找元素，找到后移动到队首
+    * @return 返回缓存中的值，如果不在缓存中返回nullptr
+    */
+    TValue* Find(const TKey& key)
+    {
+        auto iter = m_itemMap.find(&key);
+        if (iter == m_itemMap.end()) {
+            return nullptr;
+        }
+        m_itemList.splice(m_itemList.begin(), m_itemList, iter->second);
+        return &iter->second->m_value;
+    }
+
+    /** 添加元素（如果已经存在，则更新值），并移动到队首，然后淘汰超出限制的元素
+    * @param [in] key 元素的KEY
+    * @param [in] value 元素的值
+    * @param [in] nItemBytes 元素占用的内存（字节）
+    */
+    void Put(const TKey& key, const TValue& value, size_t nItemBytes)
+    {
+        if ((m_nBudgetBytes == 0) || (m_nMaxCount == 0)) {
+            return;
+        }
+        auto iter = m_itemMap.find(&key);
+        if (iter == m_itemMap.end()) {
+            //在队列中直接构造元素（元素不再移动，映射表的KEY指向元素中保存的KEY）
+            m_itemList.emplace_front(key);
+            iter = m_itemMap.emplace(&m_itemList.front().m_storedKey.GetKey(), m_itemList.begin()).first;
+        }
+        else {
+            m_itemList.splice(m_itemList.begin(), m_itemList, iter->second);
+        }
+        TCacheItem& item = *iter->second;
+        m_nCacheBytes -= item.m_nItemBytes;
+        item.m_value = value;
+        item.m_nItemBytes = nItemBytes;
+        m_nCacheBytes += item.m_nItemBytes;
+        EvictItems();
+    }
+
+    /** 设置最大元素个数
+    */
+    void SetMaxCount(size_t nMaxCount)
+    {
+        m_nMaxCount = nMaxCount;
+        EvictItems();
+    }
+
+    /** 获取最大元素个数
+    */
+    size_t GetMaxCount() const { return m_nMaxCount; }
+
+    /** 设置内存预算（字节），为0时表示禁用缓存
+    */
+    void SetBudget(size_t nBudgetBytes)
+    {
+        m_nBudgetBytes = nBudgetBytes;
+        if (m_nBudgetBytes == 0) {
+            Clear();
+        }
+        else {
+            EvictItems();
+        }
+    }
+
+    /** 获取内存预算（字节）
+    */
+    size_t GetBudget() const { return m_nBudgetBytes; }
+
+    /** 获取元素占用的内存（字节）
+    */
+    size_t GetCacheBytes() const { return m_nCacheBytes; }
+
+    /** 获取元素个数
+    */
+    size_t GetCount() const { return m_itemList.size(); }
+
+    /** 清空缓存
+    */
+    void Clear()
+    {
+        m_itemMap.clear();
+        m_itemList.clear();
+        m_nCacheBytes = 0;
+    }
+
+private:
+    /** 缓存的元素
+    */
+    struct TCacheItem
+    {
+        explicit TCacheItem(const TKey& key): m_storedKey(key), m_value(), m_nItemBytes(0) {}
+        TCacheItem(const TCacheItem&) = delete;
+        TCacheItem& operator = (const TCacheItem&) = delete;
+
+        //元素的KEY
+        TStoredKey m_storedKey;
+
+        //元素的值
+        TValue m_value;
+
+        //元素占用的内存（字节）
+        size_t m_nItemBytes;
+    };
+    typedef std::list<TCacheItem> CacheItemList;
+
+    /** KEY的哈希函数（映射表的KEY为指针）
+    */
+    struct TKeyPtrHash
+    {
+        size_t operator()(const TKey* pKey) const { return TKeyHash()(*pKey); }
+    };
+
+    /** KEY的比较函数（映射表的KEY为指针）
+    */
+    struct TKeyPtrEqual
+    {
+        bool operator()(const TKey* pKey1, const TKey* pKey2) const { return *pKey1 == *pKey2; }
+    };
+
+    /** 淘汰最久未使用的元素，直到占用的内存和元素个数不超过限制
+    */
+    void EvictItems()
+    {
+        while (!m_itemList.empty() &&
+               ((m_nCacheBytes > m_nBudgetBytes) || (m_itemList.size() > m_nMaxCount))) {
+            auto iter = m_itemList.end();
+            --iter;
+            m_nCacheBytes -= iter->m_nItemBytes;
+            m_itemMap.erase(&iter->m_storedKey.GetKey());
+            m_itemList.erase(iter);
+        }
+    }
+
+private:
+    /** LRU队列（队首为最近使用的元素）
+    */
+    CacheItemList m_itemList;
+
+    /** KEY与LRU队列元素的映射表
+    */
+    std::unordered_map<const TKey*, typename CacheItemList::iterator, TKeyPtrHash, TKeyPtrEqual> m_itemMap;
+
+    /** 最大元素个数
+    */
+    size_t m_nMaxCount;
+
+    /** 内存预算（字节）
+    */
+    size_t m_nBudgetBytes;
+
+    /** 元素占用的内存（字节）
+    */
+    size_t m_nCacheBytes;
+};
+
+} // namespace ui
+
+#endif // UI_RENDER_SKIA_LRU_CACHE_H_
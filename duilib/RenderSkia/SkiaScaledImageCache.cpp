@@ -0,0 +1,103 @@
+#include "SkiaScaledImageCache.h"
+
+namespace ui
+{
+
+/** 缓存的最大元素个数（包含只请求过一次、尚未缓存图片的元素）
+*/
+static const size_t kMaxScaledImageItemCount = 1024;
+
+SkiaScaledImageCache::SkiaScaledImageCache():
+    m_imageCache(kMaxScaledImageItemCount, 32 * 1024 * 1024)
+{
+}
+
+SkiaScaledImageCache::~SkiaScaledImageCache()
+{
+}
+
+SkiaScaledImageCache& SkiaScaledImageCache::Instance()
+{
+    static SkiaScaledImageCache self;
+    return self;
+}
+
+size_t SkiaScaledImageCache::TKeyHash::operator()(const SkiaScaledImageKey& key) const
+{
+    size_t nHash = std::hash<uint32_t>()(key.m_nImageId);
+    SkiaHashCombine(nHash, std::hash<int32_t>()(key.m_nSrcLeft));
+    SkiaHashCombine(nHash, std::hash<int32_t>()(key.m_nSrcTop));
+    SkiaHashCombine(nHash, std::hash<int32_t>()(key.m_nSrcRight));
+    SkiaHashCombine(nHash, std::hash<int32_t>()(key.m_nSrcBottom));
+    SkiaHashCombine(nHash, std::hash<int32_t>()(key.m_nDestWidth));
+    SkiaHashCombine(nHash, std::hash<int32_t>()(key.m_nDestHeight));
+    SkiaHashCombine(nHash, std::hash<uint8_t>()(key.m_nFilter));
+    return nHash;
+}
+
+sk_sp<SkImage> SkiaScaledImageCache::FindImage(const SkiaScaledImageKey& key, bool& bCreateImage)
+{
+    bCreateImage = false;
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    if (m_imageCache.GetBudget() == 0) {
+        return nullptr;
+    }
+    const sk_sp<SkImage>* pImage = m_imageCache.Find(key);
+    if (pImage != nullptr) {
+        if (*pImage != nullptr) {
+            return *pImage;
+        }
+        //第二次请求：需要缩放后放入缓存
+        bCreateImage = true;
+        return nullptr;
+    }
+    //第一次请求：只记录KEY
+    m_imageCache.Put(key, nullptr, 0);
+    return nullptr;
+}
+
+void SkiaScaledImageCache::AddImage(const SkiaScaledImageKey& key, const sk_sp<SkImage>& skImage)
+{
+    ASSERT(skImage != nullptr);
+    if (skImage == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    m_imageCache.Put(key, skImage, skImage->imageInfo().computeMinByteSize());
+}
+
+bool SkiaScaledImageCache::IsCacheableSize(int32_t nWidth, int32_t nHeight) const
+{
+    if ((nWidth <= 0) || (nHeight <= 0)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    const size_t nImageBytes = (size_t)nWidth * (size_t)nHeight * sizeof(uint32_t);
+    return nImageBytes <= (m_imageCache.GetBudget() / 4);
+}
+
+void SkiaScaledImageCache::SetBudget(size_t nBudgetBytes)
+{
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    m_imageCache.SetBudget(nBudgetBytes);
+}
+
+size_t SkiaScaledImageCache::GetBudget() const
+{
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    return m_imageCache.GetBudget();
+}
+
+size_t SkiaScaledImageCache::GetCacheBytes() const
+{
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    return m_imageCache.GetCacheBytes();
+}
+
+void SkiaScaledImageCache::Clear()
+{
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    m_imageCache.Clear();
+}
+
+} // namespace ui
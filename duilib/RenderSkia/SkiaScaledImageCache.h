@@ -0,0 +1,120 @@
+#ifndef UI_RENDER_SKIA_SCALED_IMAGE_CACHE_H_
+#define UI_RENDER_SKIA_SCALED_IMAGE_CACHE_H_
+
+#include "duilib/Core/UiRect.h"
+#include "duilib/RenderSkia/SkiaLruCache.h"
+
+#include "SkiaHeaderBegin.h"
+#include "include/core/SkImage.h"
+#include "SkiaHeaderEnd.h"
+
+#include <mutex>
+
+namespace ui
+{
+
+/** 缩放后的图片缓存的KEY
+*/
+struct SkiaScaledImageKey
+{
+    //源图片的ID（位图像素数据的Generation ID，像素数据修改后会变化）
+    uint32_t m_nImageId = 0;
+
+    //源图片中需要绘制的矩形区域
+    int32_t m_nSrcLeft = 0;
+    int32_t m_nSrcTop = 0;
+    int32_t m_nSrcRight = 0;
+    int32_t m_nSrcBottom = 0;
+
+    //缩放后的图片宽度和高度
+    int32_t m_nDestWidth = 0;
+    int32_t m_nDestHeight = 0;
+
+    //图片缩放的算法
+    uint8_t m_nFilter = 0;
+
+    bool operator == (const SkiaScaledImageKey& r) const
+    {
+        return (m_nImageId == r.m_nImageId) &&
+               (m_nSrcLeft == r.m_nSrcLeft) && (m_nSrcTop == r.m_nSrcTop) &&
+               (m_nSrcRight == r.m_nSrcRight) && (m_nSrcBottom == r.m_nSrcBottom) &&
+               (m_nDestWidth == r.m_nDestWidth) && (m_nDestHeight == r.m_nDestHeight) &&
+               (m_nFilter == r.m_nFilter);
+    }
+};
+
+/** 缩放后的图片缓存（按内存占用计算的LRU缓存，超出内存预算时淘汰最久未使用的图片）
+*   图片拉伸绘制时，Skia每次绘制都需要对源图片进行重采样；对于反复以相同大小绘制的图片（比如窗口背景、九宫格图片的各个部分），
+*   缩放一次后缓存缩放结果，后续绘制时直接使用，无需缩放；
+*   同一个KEY第二次请求时才执行缩放并放入缓存，避免窗口大小变化过程中、动画播放过程中缓存只使用一次的图片
+*   （支持多线程访问）
+*/
+class SkiaScaledImageCache
+{
+public:
+    SkiaScaledImageCache();
+    ~SkiaScaledImageCache();
+    SkiaScaledImageCache(const SkiaScaledImageCache&) = delete;
+    SkiaScaledImageCache& operator = (const SkiaScaledImageCache&) = delete;
+
+    /** 获取单例对象
+    */
+    static SkiaScaledImageCache& Instance();
+
+public:
+    /** 查找缩放后的图片
+    * @param [in] key 图片的KEY
+    * @param [out] bCreateImage 当返回nullptr时，返回true表示该图片需要缩放后放入缓存（该KEY已经请求过）
+    * @return 返回缓存中的图片，如果不在缓存中返回nullptr
+    */
+    sk_sp<SkImage> FindImage(const SkiaScaledImageKey& key, bool& bCreateImage);
+
+    /** 将缩放后的图片放入缓存
+    * @param [in] key 图片的KEY
+    * @param [in] skImage 缩放后的图片
+    */
+    void AddImage(const SkiaScaledImageKey& key, const sk_sp<SkImage>& skImage);
+
+    /** 单个图片是否可以放入缓存（单个图片的大小不超过内存预算的1/4）
+    * @param [in] nWidth 图片的宽度
+    * @param [in] nHeight 图片的高度
+    */
+    bool IsCacheableSize(int32_t nWidth, int32_t nHeight) const;
+
+    /** 设置缓存的内存预算（字节），为0时表示禁用缓存
+    */
+    void SetBudget(size_t nBudgetBytes);
+
+    /** 获取缓存的内存预算（字节）
+    */
+    size_t GetBudget() const;
+
+    /** 获取缓存中的图片占用的内存（字节）
+    */
+    size_t GetCacheBytes() const;
+
+    /** 清空缓存
+    */
+    void Clear();
+
+private:
+    /** KEY的哈希函数
+    */
+    struct TKeyHash
+    {
+        size_t operator()(const SkiaScaledImageKey& key) const;
+    };
+
+private:
+    /** 缩放后的图片的LRU缓存（图片为空时表示该KEY只请求过一次）
+    */
+    SkiaLruCache<SkiaScaledImageKey, sk_sp<SkImage>, TKeyHash> m_imageCache;
+
+    /** 多线程同步锁
+    */
+    mutable std::mutex m_cacheMutex;
+};
+
+} // namespace ui
+
+#endif // UI_RENDER_SKIA_SCALED_IMAGE_CACHE_H_
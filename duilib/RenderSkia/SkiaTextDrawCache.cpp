@@ -0,0 +1,123 @@
+#include "SkiaTextDrawCache.h"
+
+namespace ui
+{
+
+/** 缓存的最大元素个数（包含只请求过一次、尚未录制绘制结果的元素）
+*/
+static const size_t kMaxTextDrawItemCount = 8192;
+
+SkiaTextDrawCache::SkiaTextDrawCache():
+    m_pictureCache(kMaxTextDrawItemCount, 16 * 1024 * 1024),
+    m_nHitCount(0),
+    m_nMissCount(0)
+{
+}
+
+SkiaTextDrawCache::~SkiaTextDrawCache()
+{
+}
+
+SkiaTextDrawCache& SkiaTextDrawCache::Instance()
+{
+    static SkiaTextDrawCache self;
+    return self;
+}
+
+size_t SkiaTextDrawCache::TKeyHash::operator()(const SkiaTextDrawKey& key) const
+{
+    size_t nHash = SkiaTextMeasureCache::TKeyHash()(key.m_textKey);
+    SkiaHashCombine(nHash, std::hash<int32_t>()(key.m_nRectHeight));
+    SkiaHashCombine(nHash, std::hash<uint32_t>()(key.m_nTextColor));
+    return nHash;
+}
+
+SkiaTextDrawCache::TStoredKey::TStoredKey(const SkiaTextDrawKey& key):
+    m_text(key.m_textKey.m_text.data(), key.m_textKey.m_text.size()),
+    m_key(key)
+{
+    m_key.m_textKey.m_text = m_text;
+}
+
+size_t SkiaTextDrawCache::GetItemBytes(const SkiaTextDrawKey& key, const sk_sp<SkPicture>& skPicture)
+{
+    size_t nItemBytes = sizeof(TStoredKey) + key.m_textKey.m_text.size() * sizeof(DString::value_type);
+    if (skPicture != nullptr) {
+        nItemBytes += skPicture->approximateBytesUsed();
+    }
+    return nItemBytes;
+}
+
+sk_sp<SkPicture> SkiaTextDrawCache::FindPicture(const SkiaTextDrawKey& key, bool& bRecordPicture)
+{
+    bRecordPicture = false;
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    if (m_pictureCache.GetBudget() == 0) {
+        return nullptr;
+    }
+    const sk_sp<SkPicture>* pPicture = m_pictureCache.Find(key);
+    if (pPicture != nullptr) {
+        if (*pPicture != nullptr) {
+            ++m_nHitCount;
+            return *pPicture;
+        }
+        //第二次请求：需要录制后放入缓存
+        ++m_nMissCount;
+        bRecordPicture = true;
+        return nullptr;
+    }
+    //第一次请求：只记录KEY
+    ++m_nMissCount;
+    m_pictureCache.Put(key, nullptr, GetItemBytes(key, nullptr));
+    return nullptr;
+}
+
+void SkiaTextDrawCache::AddPicture(const SkiaTextDrawKey& key, const sk_sp<SkPicture>& skPicture)
+{
+    ASSERT(skPicture != nullptr);
+    if (skPicture == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    m_pictureCache.Put(key, skPicture, GetItemBytes(key, skPicture));
+}
+
+void SkiaTextDrawCache::SetBudget(size_t nBudgetBytes)
+{
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    m_pictureCache.SetBudget(nBudgetBytes);
+}
+
+size_t SkiaTextDrawCache::GetBudget() const
+{
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    return m_pictureCache.GetBudget();
+}
+
+size_t SkiaTextDrawCache::GetCacheBytes() const
+{
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    return m_pictureCache.GetCacheBytes();
+}
+
+uint64_t SkiaTextDrawCache::GetHitCount() const
+{
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    return m_nHitCount;
+}
+
+uint64_t SkiaTextDrawCache::GetMissCount() const
+{
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    return m_nMissCount;
+}
+
+void SkiaTextDrawCache::Clear()
+{
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    m_pictureCache.Clear();
+    m_nHitCount = 0;
+    m_nMissCount = 0;
+}
+
+} // namespace ui
@@ -0,0 +1,143 @@
+#ifndef UI_RENDER_SKIA_TEXT_DRAW_CACHE_H_
+#define UI_RENDER_SKIA_TEXT_DRAW_CACHE_H_
+
+#include "duilib/RenderSkia/SkiaTextMeasureCache.h"
+
+#include "SkiaHeaderBegin.h"
+#include "include/core/SkPicture.h"
+#include "SkiaHeaderEnd.h"
+
+#include <mutex>
+
+namespace ui
+{
+
+/** 文本绘制结果缓存的KEY
+*/
+struct SkiaTextDrawKey
+{
+    //字体、文本内容和排版参数（其中m_nRectSize为绘制区域的宽度）
+    SkiaTextMeasureKey m_textKey;
+
+    //绘制区域的高度
+    int32_t m_nRectHeight = 0;
+
+    //文字颜色（包含透明度）
+    uint32_t m_nTextColor = 0;
+
+    //下划线和删除线
+    bool m_bUnderline = false;
+    bool m_bStrikeOut = false;
+
+    bool operator == (const SkiaTextDrawKey& r) const
+    {
+        return (m_nRectHeight == r.m_nRectHeight) && (m_nTextColor == r.m_nTextColor) &&
+               (m_bUnderline == r.m_bUnderline) && (m_bStrikeOut == r.m_bStrikeOut) &&
+               (m_textKey == r.m_textKey);
+    }
+};
+
+/** 文本绘制结果缓存（按内存占用计算的LRU缓存，超出内存预算时淘汰最久未使用的结果）
+*   每次绘制文本时，都需要断行、计算每行（或每个字符）的位置、转换字形（Glyph）；对于内容不变的文本，
+*   以绘制区域的左上角为原点，将绘制命令录制为SkPicture（文字在其中以SkTextBlob的形式保存），重绘时直接回放；
+*   同一个KEY第二次请求时才录制并放入缓存，避免缓存只绘制一次的文本
+*   （支持多线程访问）
+*/
+class SkiaTextDrawCache
+{
+public:
+    SkiaTextDrawCache();
+    ~SkiaTextDrawCache();
+    SkiaTextDrawCache(const SkiaTextDrawCache&) = delete;
+    SkiaTextDrawCache& operator = (const SkiaTextDrawCache&) = delete;
+
+    /** 获取单例对象
+    */
+    static SkiaTextDrawCache& Instance();
+
+public:
+    /** 查找文本的绘制结果
+    * @param [in] key 文本绘制的KEY（需要已经计算好文本的哈希值），放入缓存时保存文本的副本
+    * @param [out] bRecordPicture 当返回nullptr时，返回true表示需要录制绘制结果后放入缓存（该KEY已经请求过）
+    * @return 返回缓存中的绘制结果，如果不在缓存中返回nullptr
+    */
+    sk_sp<SkPicture> FindPicture(const SkiaTextDrawKey& key, bool& bRecordPicture);
+
+    /** 将文本的绘制结果放入缓存
+    * @param [in] key 文本绘制的KEY（需要已经计算好文本的哈希值）
+    * @param [in] skPicture 录制的绘制结果
+    */
+    void AddPicture(const SkiaTextDrawKey& key, const sk_sp<SkPicture>& skPicture);
+
+    /** 设置缓存的内存预算（字节），为0时表示禁用缓存
+    */
+    void SetBudget(size_t nBudgetBytes);
+
+    /** 获取缓存的内存预算（字节）
+    */
+    size_t GetBudget() const;
+
+    /** 获取缓存占用的内存（字节）
+    */
+    size_t GetCacheBytes() const;
+
+    /** 获取缓存命中的次数
+    */
+    uint64_t GetHitCount() const;
+
+    /** 获取缓存未命中的次数
+    */
+    uint64_t GetMissCount() const;
+
+    /** 清空缓存（同时清零命中统计）
+    */
+    void Clear();
+
+private:
+    /** KEY的哈希函数
+    */
+    struct TKeyHash
+    {
+        size_t operator()(const SkiaTextDrawKey& key) const;
+    };
+
+    /** 缓存中保存的KEY（保存文本的副本，KEY中的文本指向该副本；元素在缓存中构造后不再移动）
+    */
+    class TStoredKey
+    {
+    public:
+        explicit TStoredKey(const SkiaTextDrawKey& key);
+        TStoredKey(const TStoredKey&) = delete;
+        TStoredKey& operator = (const TStoredKey&) = delete;
+        const SkiaTextDrawKey& GetKey() const { return m_key; }
+
+    private:
+        //文本内容
+        DString m_text;
+
+        //文本绘制的KEY（其中的文本指向m_text）
+        SkiaTextDrawKey m_key;
+    };
+
+    /** 计算元素占用的内存（字节）
+    */
+    static size_t GetItemBytes(const SkiaTextDrawKey& key, const sk_sp<SkPicture>& skPicture);
+
+private:
+    /** 录制的绘制结果的LRU缓存（绘制结果为空时表示该KEY只请求过一次）
+    */
+    SkiaLruCache<SkiaTextDrawKey, sk_sp<SkPicture>, TKeyHash, TStoredKey> m_pictureCache;
+
+    /** 缓存命中和未命中的次数
+    */
+    uint64_t m_nHitCount;
+    uint64_t m_nMissCount;
+
+    /** 多线程同步锁
+    */
+    mutable std::mutex m_cacheMutex;
+};
+
+} // namespace ui
+
+#endif // UI_RENDER_SKIA_TEXT_DRAW_CACHE_H_
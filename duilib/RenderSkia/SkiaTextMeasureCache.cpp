@@ -0,0 +1,94 @@
+#include "SkiaTextMeasureCache.h"
+#include <limits>
+
+namespace ui
+{
+
+/** 缓存的默认最大元素个数
+*/
+static const size_t kDefaultTextMeasureItemCount = 8192;
+
+/** 可以缓存的文本最大长度（字符个数）
+*/
+static const size_t kMaxTextMeasureTextLen = 1024;
+
+SkiaTextMeasureCache::SkiaTextMeasureCache():
+    m_rectCache(kDefaultTextMeasureItemCount, std::numeric_limits<size_t>::max())
+{
+}
+
+SkiaTextMeasureCache::~SkiaTextMeasureCache()
+{
+}
+
+SkiaTextMeasureCache& SkiaTextMeasureCache::Instance()
+{
+    static SkiaTextMeasureCache self;
+    return self;
+}
+
+bool SkiaTextMeasureCache::IsCacheableText(size_t nTextLen)
+{
+    return (nTextLen > 0) && (nTextLen <= kMaxTextMeasureTextLen);
+}
+
+size_t SkiaTextMeasureCache::TKeyHash::operator()(const SkiaTextMeasureKey& key) const
+{
+    size_t nHash = key.m_nTextHash;
+    SkiaHashCombine(nHash, std::hash<uint32_t>()(key.m_nTypefaceId));
+    SkiaHashCombine(nHash, std::hash<float>()(key.m_fFontSize));
+    SkiaHashCombine(nHash, std::hash<int32_t>()(key.m_nRectSize));
+    SkiaHashCombine(nHash, std::hash<uint32_t>()(key.m_uFormat));
+    return nHash;
+}
+
+SkiaTextMeasureCache::TStoredKey::TStoredKey(const SkiaTextMeasureKey& key):
+    m_text(key.m_text.data(), key.m_text.size()),
+    m_key(key)
+{
+    m_key.m_text = m_text;
+}
+
+bool SkiaTextMeasureCache::FindRect(const SkiaTextMeasureKey& key, UiRect& rcMeasure)
+{
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    const UiRect* pRect = m_rectCache.Find(key);
+    if (pRect == nullptr) {
+        return false;
+    }
+    rcMeasure = *pRect;
+    return true;
+}
+
+void SkiaTextMeasureCache::AddRect(const SkiaTextMeasureKey& key, const UiRect& rcMeasure)
+{
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    //按元素个数限制，不计算内存占用
+    m_rectCache.Put(key, rcMeasure, 0);
+}
+
+void SkiaTextMeasureCache::SetMaxCount(size_t nMaxCount)
+{
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    m_rectCache.SetMaxCount(nMaxCount);
+}
+
+size_t SkiaTextMeasureCache::GetMaxCount() const
+{
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    return m_rectCache.GetMaxCount();
+}
+
+size_t SkiaTextMeasureCache::GetCount() const
+{
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    return m_rectCache.GetCount();
+}
+
+void SkiaTextMeasureCache::Clear()
+{
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    m_rectCache.Clear();
+}
+
+} // namespace ui
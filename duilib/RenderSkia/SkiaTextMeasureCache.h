@@ -0,0 +1,146 @@
+#ifndef UI_RENDER_SKIA_TEXT_MEASURE_CACHE_H_
+#define UI_RENDER_SKIA_TEXT_MEASURE_CACHE_H_
+
+#include "duilib/Core/UiRect.h"
+#include "duilib/RenderSkia/SkiaLruCache.h"
+
+#include <string_view>
+#include <mutex>
+
+namespace ui
+{
+
+/** 文本测量结果缓存的KEY
+*/
+struct SkiaTextMeasureKey
+{
+    typedef std::basic_string_view<DString::value_type> TextView;
+
+    //字体的标识：字体（Typeface）的唯一ID、字体大小（已经包含DPI缩放）、横向缩放比例、倾斜度、是否模拟粗体、边缘渲染方式
+    uint32_t m_nTypefaceId = 0;
+    float m_fFontSize = 0;
+    float m_fFontScaleX = 1.0f;
+    float m_fFontSkewX = 0;
+    bool m_bFontEmbolden = false;
+    uint8_t m_nFontEdging = 0;
+
+    //测量参数（参见MeasureStringParam）
+    int32_t m_nRectSize = 0;
+    uint32_t m_uFormat = 0;
+    float m_fSpacingMul = 1.0f;
+    float m_fSpacingAdd = 0;
+    float m_fWordSpacing = 0;
+    bool m_bUseFontHeight = true;
+    bool m_bRotate90ForAscii = true;
+
+    //文本内容及其哈希值（查找时指向调用方的字符串，不复制文本；放入缓存时指向缓存元素中保存的文本）
+    TextView m_text;
+    size_t m_nTextHash = 0;
+
+    bool operator == (const SkiaTextMeasureKey& r) const
+    {
+        return (m_nTypefaceId == r.m_nTypefaceId) &&
+               (m_fFontSize == r.m_fFontSize) && (m_fFontScaleX == r.m_fFontScaleX) &&
+               (m_fFontSkewX == r.m_fFontSkewX) && (m_bFontEmbolden == r.m_bFontEmbolden) &&
+               (m_nFontEdging == r.m_nFontEdging) &&
+               (m_nRectSize == r.m_nRectSize) && (m_uFormat == r.m_uFormat) &&
+               (m_fSpacingMul == r.m_fSpacingMul) && (m_fSpacingAdd == r.m_fSpacingAdd) &&
+               (m_fWordSpacing == r.m_fWordSpacing) &&
+               (m_bUseFontHeight == r.m_bUseFontHeight) && (m_bRotate90ForAscii == r.m_bRotate90ForAscii) &&
+               (m_nTextHash == r.m_nTextHash) && (m_text == r.m_text);
+    }
+};
+
+/** 文本测量结果缓存（按元素个数限制的LRU缓存，超出限制时淘汰最久未使用的结果）
+*   控件布局时，每次都需要测量文本的大小（多行文本还需要断行计算），而文本内容通常很少变化；
+*   测量结果只与字体、文本内容和测量参数有关，以这些数据为KEY缓存测量结果，
+*   字体变化、DPI变化（字体大小变化）或者文本变化时KEY随之变化，无需主动清除缓存
+*   （支持多线程访问）
+*/
+class SkiaTextMeasureCache
+{
+public:
+    SkiaTextMeasureCache();
+    ~SkiaTextMeasureCache();
+    SkiaTextMeasureCache(const SkiaTextMeasureCache&) = delete;
+    SkiaTextMeasureCache& operator = (const SkiaTextMeasureCache&) = delete;
+
+    /** 获取单例对象
+    */
+    static SkiaTextMeasureCache& Instance();
+
+public:
+    /** 文本是否可以放入缓存（过长的文本不缓存）
+    * @param [in] nTextLen 文本的长度（字符个数）
+    */
+    static bool IsCacheableText(size_t nTextLen);
+
+    /** 查找文本测量结果
+    * @param [in] key 文本测量的KEY（需要已经计算好文本的哈希值）
+    * @param [out] rcMeasure 返回测量结果
+    * @return 如果在缓存中找到返回true，否则返回false
+    */
+    bool FindRect(const SkiaTextMeasureKey& key, UiRect& rcMeasure);
+
+    /** 将文本测量结果放入缓存
+    * @param [in] key 文本测量的KEY（需要已经计算好文本的哈希值），缓存中保存文本的副本
+    * @param [in] rcMeasure 测量结果
+    */
+    void AddRect(const SkiaTextMeasureKey& key, const UiRect& rcMeasure);
+
+    /** 设置缓存的最大元素个数，为0时表示禁用缓存
+    */
+    void SetMaxCount(size_t nMaxCount);
+
+    /** 获取缓存的最大元素个数
+    */
+    size_t GetMaxCount() const;
+
+    /** 获取缓存的元素个数
+    */
+    size_t GetCount() const;
+
+    /** 清空缓存
+    */
+    void Clear();
+
+public:
+    /** KEY的哈希函数（文本绘制结果缓存的KEY中包含文本测量的KEY，共用此函数）
+    */
+    struct TKeyHash
+    {
+        size_t operator()(const SkiaTextMeasureKey& key) const;
+    };
+
+private:
+    /** 缓存中保存的KEY（保存文本的副本，KEY中的文本指向该副本；元素在缓存中构造后不再移动）
+    */
+    class TStoredKey
+    {
+    public:
+        explicit TStoredKey(const SkiaTextMeasureKey& key);
+        TStoredKey(const TStoredKey&) = delete;
+        TStoredKey& operator = (const TStoredKey&) = delete;
+        const SkiaTextMeasureKey& GetKey() const { return m_key; }
+
+    private:
+        //文本内容
+        DString m_text;
+
+        //文本测量的KEY（其中的文本指向m_text）
+        SkiaTextMeasureKey m_key;
+    };
+
+private:
+    /** 文本测量结果的LRU缓存
+    */
+    SkiaLruCache<SkiaTextMeasureKey, UiRect, TKeyHash, TStoredKey> m_rectCache;
+
+    /** 多线程同步锁
+    */
+    mutable std::mutex m_cacheMutex;
+};
+
+} // namespace ui
+
+#endif // UI_RENDER_SKIA_TEXT_MEASURE_CACHE_H_
@@ -0,0 +1,245 @@
+#ifndef UI_UTILS_ATTRIBUTE_TABLE_H_
+#define UI_UTILS_ATTRIBUTE_TABLE_H_
+
+#include "duilib/duilib_defs.h"
+#include <cstdint>
+#include <type_traits>
+
+namespace ui
+{
+/** 获取不小于nValue的2的幂（属性表的容量计算）
+*/
+constexpr size_t AttributeTablePowerOfTwo(size_t nValue)
+{
+    size_t nPower = 1;
+    while (nPower < nValue) {
+        nPower <<= 1;
+    }
+    return nPower;
+}
+
+/** 属性表的一项：属性名称及对应的属性ID（多个属性名称可以对应同一个属性ID，比如兼容旧的属性名称）
+*/
+struct AttributeTableEntry
+{
+    //属性名称（只能包含ASCII字符）
+    const char* m_name;
+
+    //属性ID（非负整数）
+    int32_t m_id;
+};
+
+/** 属性表：编译期生成的属性名称到属性ID的完美哈希表，用于替代SetAttribute中逐个比较属性名称的分支判断
+ *  使用方法：在实现文件中定义属性名称列表和属性表（constexpr），SetAttribute函数中通过属性ID分发（switch），
+ *           查找不到的属性，交给基类处理。
+ *  实现原理（Hash and Displace）：
+ *  （1）每个属性名称计算哈希值，按哈希值分配到若干个桶中；
+ *  （2）编译期按桶的大小从大到小，为每个桶选择一个偏移值，使得桶内的所有属性名称经偏移后映射到互不冲突的空闲位置；
+ *  （3）查找时，计算一次哈希值，读取所在桶的偏移值，即可定位到唯一的位置，最多比较一次字符串。
+ *  如果属性名称有重复，或者无法生成完美哈希表，IsValid()返回false，定义属性表时需要使用static_assert检查。
+ */
+template<size_t N>
+class AttributeTable
+{
+public:
+    /** 桶的个数（2的幂，约为属性个数的一半）
+    */
+    static constexpr size_t kBucketCount = AttributeTablePowerOfTwo((N + 1) / 2);
+
+    /** 哈希表的位置个数（2的幂，负载因子不超过2/3）
+    */
+    static constexpr size_t kSlotCount = AttributeTablePowerOfTwo(N + (N + 1) / 2);
+
+    constexpr explicit AttributeTable(const AttributeTableEntry (&entries)[N]):
+        m_entries(),
+        m_hashes(),
+        m_displaces(),
+        m_slots(),
+        m_bValid(false)
+    {
+        for (size_t nIndex = 0; nIndex < N; ++nIndex) {
+            m_entries[nIndex] = entries[nIndex];
+            m_hashes[nIndex] = HashName(entries[nIndex].m_name);
+        }
+        m_bValid = BuildTable();
+    }
+
+    /** 属性表是否有效（属性名称无重复，并且成功生成完美哈希表）
+    */
+    constexpr bool IsValid() const
+    {
+        return m_bValid;
+    }
+
+    /** 查找属性名称对应的属性ID
+    * @param [in] name 属性名称
+    * @param [in] nNameLen 属性名称的长度
+    * @return 返回属性ID，如果属性名称不在属性表中，返回-1
+    */
+    template<typename CharType>
+    int32_t Find(const CharType* name, size_t nNameLen) const
+    {
+        const uint32_t nHash = HashName(name, nNameLen);
+        const uint16_t nSlot = m_slots[GetSlotIndex(nHash, m_displaces[GetBucketIndex(nHash)])];
+        if (nSlot == 0) {
+            return -1;
+        }
+        const size_t nIndex = nSlot - 1;
+        if (m_hashes[nIndex] != nHash) {
+            return -1;
+        }
+        const char* entryName = m_entries[nIndex].m_name;
+        for (size_t nPos = 0; nPos < nNameLen; ++nPos) {
+            if ((entryName[nPos] == '\0') || ((uint32_t)(uint8_t)entryName[nPos] != GetCharValue(name[nPos]))) {
+                return -1;
+            }
+        }
+        return (entryName[nNameLen] == '\0') ? m_entries[nIndex].m_id : -1;
+    }
+
+    /** 查找属性名称对应的属性ID
+    * @param [in] name 属性名称
+    * @return 返回属性ID，如果属性名称不在属性表中，返回-1
+    */
+    int32_t Find(const DString& name) const
+    {
+        return Find(name.c_str(), name.size());
+    }
+
+private:
+    /** 获取字符的编码值（兼容char和wchar_t等字符类型）
+    */
+    template<typename CharType>
+    static constexpr uint32_t GetCharValue(CharType ch)
+    {
+        return (uint32_t)(typename std::make_unsigned<CharType>::type)ch;
+    }
+
+    /** 计算属性名称的哈希值（FNV-1a算法，按字符计算，不同字符类型的相同ASCII字符串哈希值相同）
+    */
+    template<typename CharType>
+    static constexpr uint32_t HashName(const CharType* name, size_t nNameLen)
+    {
+        uint32_t nHash = 2166136261u;
+        for (size_t nPos = 0; nPos < nNameLen; ++nPos) {
+            nHash ^= GetCharValue(name[nPos]);
+            nHash *= 16777619u;
+        }
+        return nHash;
+    }
+
+    static constexpr uint32_t HashName(const char* name)
+    {
+        size_t nNameLen = 0;
+        while (name[nNameLen] != '\0') {
+            ++nNameLen;
+        }
+        return HashName(name, nNameLen);
+    }
+
+    /** 获取哈希值所在的桶
+    */
+    static constexpr size_t GetBucketIndex(uint32_t nHash)
+    {
+        return (size_t)((nHash ^ (nHash >> 15)) & (kBucketCount - 1));
+    }
+
+    /** 获取哈希值经偏移后的位置
+    */
+    static constexpr size_t GetSlotIndex(uint32_t nHash, uint16_t nDisplace)
+    {
+        uint32_t nValue = nHash ^ (nDisplace * 0x9E3779B9u);
+        nValue ^= nValue >> 16;
+        nValue *= 0x85EBCA6Bu;
+        nValue ^= nValue >> 13;
+        return (size_t)(nValue & (kSlotCount - 1));
+    }
+
+    /** 生成完美哈希表
+    */
+    constexpr bool BuildTable()
+    {
+        //按桶排序（计数排序），同一个桶的属性在数组中连续存放
+        size_t bucketStart[kBucketCount + 1] = {};
+        for (size_t nIndex = 0; nIndex < N; ++nIndex) {
+            ++bucketStart[GetBucketIndex(m_hashes[nIndex]) + 1];
+        }
+        size_t nMaxBucketSize = 0;
+        for (size_t nBucket = 0; nBucket < kBucketCount; ++nBucket) {
+            if (bucketStart[nBucket + 1] > nMaxBucketSize) {
+                nMaxBucketSize = bucketStart[nBucket + 1];
+            }
+            bucketStart[nBucket + 1] += bucketStart[nBucket];
+        }
+        size_t bucketPos[kBucketCount] = {};
+        size_t sortedIndex[N] = {};
+        for (size_t nBucket = 0; nBucket < kBucketCount; ++nBucket) {
+            bucketPos[nBucket] = bucketStart[nBucket];
+        }
+        for (size_t nIndex = 0; nIndex < N; ++nIndex) {
+            sortedIndex[bucketPos[GetBucketIndex(m_hashes[nIndex])]++] = nIndex;
+        }
+
+        //按桶的大小从大到小，为每个桶选择偏移值
+        for (size_t nBucketSize = nMaxBucketSize; nBucketSize > 0; --nBucketSize) {
+            for (size_t nBucket = 0; nBucket < kBucketCount; ++nBucket) {
+                const size_t nStart = bucketStart[nBucket];
+                const size_t nEnd = bucketStart[nBucket + 1];
+                if ((nEnd - nStart) != nBucketSize) {
+                    continue;
+                }
+                bool bPlaced = false;
+                for (uint32_t nDisplace = 0; (nDisplace <= 0xFFFF) && !bPlaced; ++nDisplace) {
+                    size_t nPos = nStart;
+                    for (; nPos < nEnd; ++nPos) {
+                        const size_t nSlotIndex = GetSlotIndex(m_hashes[sortedIndex[nPos]], (uint16_t)nDisplace);
+                        if (m_slots[nSlotIndex] != 0) {
+                            break;
+                        }
+                        m_slots[nSlotIndex] = (uint16_t)(sortedIndex[nPos] + 1);
+                    }
+                    if (nPos == nEnd) {
+                        m_displaces[nBucket] = (uint16_t)nDisplace;
+                        bPlaced = true;
+                    }
+                    else {
+                        //冲突：撤销本次已经占用的位置
+                        for (size_t nUndo = nStart; nUndo < nPos; ++nUndo) {
+                            m_slots[GetSlotIndex(m_hashes[sortedIndex[nUndo]], (uint16_t)nDisplace)] = 0;
+                        }
+                    }
+                }
+                if (!bPlaced) {
+                    //属性名称重复（哈希值相同，永远冲突）
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+private:
+    /** 属性名称列表
+    */
+    AttributeTableEntry m_entries[N];
+
+    /** 属性名称的哈希值
+    */
+    uint32_t m_hashes[N];
+
+    /** 每个桶的偏移值
+    */
+    uint16_t m_displaces[kBucketCount];
+
+    /** 哈希表：每个位置存放属性的索引号加1（0表示空闲位置）
+    */
+    uint16_t m_slots[kSlotCount];
+
+    /** 属性表是否有效
+    */
+    bool m_bValid;
+};
+
+} // namespace ui
+
+#endif // UI_UTILS_ATTRIBUTE_TABLE_H_
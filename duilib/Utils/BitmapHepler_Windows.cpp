@@ -120,7 +120,7 @@ namespace BitmapHelper {
         if ((hBitmap != nullptr) && (pBitmapBits != nullptr)){
             memcpy(pBitmapBits, pLockBits, pBitmap->GetWidth() * pBitmap->GetHeight() * 4);
         }        
-        pBitmap->UnLockPixelBits();
+        pBitmap->UnLockPixelBits(false);
         return hBitmap;
     }
 
@@ -0,0 +1,250 @@
+#ifndef UI_UTILS_FENWICK_TREE_H_
+#define UI_UTILS_FENWICK_TREE_H_
+
+#include "duilib/duilib_defs.h"
+#include <vector>
+#include <algorithm>
+
+namespace ui
+{
+/** 树状数组的查找：从高位到低位逐步确定前pos个元素的和不大于nValue的最大pos（要求所有元素非负）
+*   即前(N+1)个元素的和大于nValue的第一个元素N，未找到时返回nCount
+* @param [in] nCount 元素个数
+* @param [in] nValue 查找的值
+* @param [in] nodeValue 获取树节点值的函数，参数为节点的下标（从1开始，节点i覆盖的元素为(i - lowbit(i), i]）
+*/
+template<typename V, typename NodeValueFunc>
+size_t FenwickTreeFindFirstGreater(size_t nCount, V nValue, const NodeValueFunc& nodeValue)
+{
+    if ((nCount == 0) || (nValue < 0)) {
+        return 0;
+    }
+    size_t nStep = 1;
+    while ((nStep << 1) <= nCount) {
+        nStep <<= 1;
+    }
+    size_t pos = 0;
+    V nLeft = nValue;
+    for (; nStep > 0; nStep >>= 1) {
+        const size_t next = pos + nStep;
+        if (next <= nCount) {
+            const V nNodeValue = nodeValue(next);
+            if (nNodeValue <= nLeft) {
+                pos = next;
+                nLeft -= nNodeValue;
+            }
+        }
+    }
+    return pos;
+}
+
+/** 树状数组（Fenwick tree）：元素的前缀和索引
+*   修改单个元素、查询前N个元素的和、在末尾追加元素：O(logN)；整体建立：O(N)；
+*   在中间插入、删除元素时，只重建插入（删除）位置之后的部分：O(N - nIndex + logN * logN)
+*/
+template<typename T>
+class FenwickTree
+{
+public:
+    /** 获取元素个数
+    */
+    size_t GetCount() const
+    {
+        return m_tree.empty() ? 0 : (m_tree.size() - 1);
+    }
+
+    /** 清除所有元素
+    */
+    void Clear()
+    {
+        m_tree.clear();
+    }
+
+    /** 按元素的值整体建立
+    */
+    void Assign(const std::vector<T>& values)
+    {
+        const size_t nCount = values.size();
+        m_tree.resize(nCount + 1);
+        m_tree[0] = 0;
+        std::copy(values.begin(), values.end(), m_tree.begin() + 1);
+        //线性时间建树：每个节点加到其父节点上
+        for (size_t i = 1; i <= nCount; ++i) {
+            const size_t j = i + (i & (0 - i));
+            if (j <= nCount) {
+                m_tree[j] += m_tree[i];
+            }
+        }
+    }
+
+    /** 设置元素个数（新增的元素在末尾，值为nValue；减少时删除末尾的元素，前面的树节点不受影响）
+    */
+    void Resize(size_t nCount, T nValue)
+    {
+        const size_t nOldCount = GetCount();
+        if (nCount < nOldCount) {
+            m_tree.resize(nCount + 1);
+        }
+        else if (nCount > nOldCount) {
+            const T nOldSum = GetPrefixSum(nOldCount);
+            RebuildSuffix(nOldCount, nCount, [nOldSum, nOldCount, nValue](size_t q) {
+                    return nOldSum + (T)(q - nOldCount) * nValue;
+                });
+        }
+    }
+
+    /** 在末尾追加一个元素
+    */
+    void PushBack(T nValue)
+    {
+        if (m_tree.empty()) {
+            m_tree.push_back(0);
+        }
+        //新节点n覆盖的范围为(n - lowbit(n), n]
+        const size_t n = m_tree.size();
+        const size_t nLowBit = n & (0 - n);
+        nValue += GetPrefixSum(n - 1) - GetPrefixSum(n - nLowBit);
+        m_tree.push_back(nValue);
+    }
+
+    /** 在指定位置插入元素（其后的元素依次后移）
+    * @param [in] nIndex 插入位置，有效范围：[0, GetCount()]
+    * @param [in] nCount 插入的元素个数
+    * @param [in] nValue 插入的元素的值
+    */
+    void InsertElements(size_t nIndex, size_t nCount, T nValue)
+    {
+        ASSERT(nIndex <= GetCount());
+        if ((nCount == 0) || (nIndex > GetCount())) {
+            return;
+        }
+        std::vector<T> sums;
+        GetSuffixPrefixSums(nIndex, sums);
+        const T nInsertSum = (T)nCount * nValue;
+        RebuildSuffix(nIndex, GetCount() + nCount, [&sums, nIndex, nCount, nValue, nInsertSum](size_t q) {
+                if (q <= (nIndex + nCount)) {
+                    return sums[0] + (T)(q - nIndex) * nValue;
+                }
+                return sums[q - nCount - nIndex] + nInsertSum;
+            });
+    }
+
+    /** 删除指定位置的元素（其后的元素依次前移）
+    * @param [in] nIndex 删除的起始位置，有效范围：[0, GetCount())
+    * @param [in] nCount 删除的元素个数
+    */
+    void RemoveElements(size_t nIndex, size_t nCount)
+    {
+        ASSERT(nIndex < GetCount());
+        if ((nCount == 0) || (nIndex >= GetCount())) {
+            return;
+        }
+        if (nCount >= (GetCount() - nIndex)) {
+            m_tree.resize(nIndex + 1);
+            return;
+        }
+        std::vector<T> sums;
+        GetSuffixPrefixSums(nIndex, sums);
+        const T nRemoveSum = sums[nCount] - sums[0];
+        RebuildSuffix(nIndex, GetCount() - nCount, [&sums, nIndex, nCount, nRemoveSum](size_t q) {
+                return sums[q + nCount - nIndex] - nRemoveSum;
+            });
+    }
+
+    /** 单个元素增加nDelta
+    */
+    void Add(size_t nIndex, T nDelta)
+    {
+        const size_t nTreeSize = m_tree.size();
+        for (size_t i = nIndex + 1; i < nTreeSize; i += (i & (0 - i))) {
+            m_tree[i] += nDelta;
+        }
+    }
+
+    /** 获取前nCount个元素的和
+    */
+    T GetPrefixSum(size_t nCount) const
+    {
+        T nSum = 0;
+        if (nCount >= m_tree.size()) {
+            nCount = GetCount();
+        }
+        for (size_t i = nCount; i > 0; i -= (i & (0 - i))) {
+            nSum += m_tree[i];
+        }
+        return nSum;
+    }
+
+    /** 获取单个元素的值
+    */
+    T GetValue(size_t nIndex) const
+    {
+        return GetPrefixSum(nIndex + 1) - GetPrefixSum(nIndex);
+    }
+
+    /** 获取树节点的值（下标从1开始，节点i覆盖的元素为(i - lowbit(i), i]）
+    */
+    T GetNode(size_t nNode) const
+    {
+        return m_tree[nNode];
+    }
+
+    /** 查找前(N+1)个元素的和大于nValue的第一个元素N（要求所有元素非负）
+    * @return 返回元素的索引号，未找到时返回GetCount()
+    */
+    size_t FindFirstGreater(T nValue) const
+    {
+        return FenwickTreeFindFirstGreater(GetCount(), nValue, [this](size_t i) {
+                return m_tree[i];
+            });
+    }
+
+    /** 获取占用的内存（字节）
+    */
+    size_t GetMemoryBytes() const
+    {
+        return m_tree.capacity() * sizeof(T);
+    }
+
+private:
+    /** 获取前nIndex个元素及之后每个位置的前缀和：sums[i] = GetPrefixSum(nIndex + i)
+    *   前缀和按节点顺序递推：prefix(j) = node(j) + prefix(j - lowbit(j))，
+    *   只有覆盖了第nIndex个元素的O(logN)个节点需要单独查询前缀和
+    */
+    void GetSuffixPrefixSums(size_t nIndex, std::vector<T>& sums) const
+    {
+        const size_t nCount = GetCount();
+        sums.resize(nCount - nIndex + 1);
+        sums[0] = GetPrefixSum(nIndex);
+        for (size_t j = nIndex + 1; j <= nCount; ++j) {
+            const size_t p = j - (j & (0 - j));
+            sums[j - nIndex] = m_tree[j] + ((p >= nIndex) ? sums[p - nIndex] : GetPrefixSum(p));
+        }
+    }
+
+    /** 重建从nIndex开始的所有树节点（前nIndex个元素及其树节点不受影响）：节点j的值 = prefix(j) - prefix(j - lowbit(j))
+    * @param [in] nIndex 起始位置
+    * @param [in] nNewCount 新的元素个数
+    * @param [in] newPrefixSum 新的前缀和（参数q的范围：[nIndex, nNewCount]）
+    */
+    template<typename PrefixSumFunc>
+    void RebuildSuffix(size_t nIndex, size_t nNewCount, const PrefixSumFunc& newPrefixSum)
+    {
+        ASSERT(nIndex <= GetCount());
+        m_tree.resize(nNewCount + 1);
+        m_tree[0] = 0;
+        for (size_t j = nIndex + 1; j <= nNewCount; ++j) {
+            const size_t p = j - (j & (0 - j));
+            m_tree[j] = newPrefixSum(j) - ((p >= nIndex) ? newPrefixSum(p) : GetPrefixSum(p));
+        }
+    }
+
+private:
+    /** 树节点（下标从1开始，m_tree[0]不使用）
+    */
+    std::vector<T> m_tree;
+};
+
+} // namespace ui
+
+#endif // UI_UTILS_FENWICK_TREE_H_
@@ -34,6 +34,7 @@ PerformanceUtil& PerformanceUtil::Instance()
 void PerformanceUtil::BeginStat(const DString& name)
 {
     ASSERT(!name.empty());
+    std::lock_guard<std::mutex> threadGuard(m_statMutex);
     TStat& stat = m_stat[name];
     stat.startTime = std::chrono::steady_clock::now();
     ASSERT(stat.nStartRefCount >= 0);
@@ -43,6 +44,7 @@ void PerformanceUtil::BeginStat(const DString& name)
 void PerformanceUtil::EndStat(const DString& name)
 {
     ASSERT(!name.empty());
+    std::lock_guard<std::mutex> threadGuard(m_statMutex);
     TStat& stat = m_stat[name];
     ASSERT(stat.nStartRefCount > 0);
     if (stat.nStartRefCount <= 0) {
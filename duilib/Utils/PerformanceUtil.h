@@ -6,6 +6,7 @@
 #include <map>
 #include <chrono>
 #include <algorithm>
+#include <mutex>
 
 namespace ui 
 {
@@ -58,6 +59,10 @@ private:
     };
 
     std::map<DString, TStat> m_stat;
+
+    /** 多线程同步锁（图片等资源可以在子线程中加载）
+    */
+    std::mutex m_statMutex;
 };
 
 class PerformanceStat
@@ -1507,7 +1507,7 @@ static bool ConvertFavIconImageData(std::vector<uint8_t>& imageFileData, uint32_
     size_t nDataSize = nHeight * nWidth * 4;
     imageData.resize(nDataSize);
     memcpy(imageData.data(), pBits, nDataSize);
-    pBitmap->UnLockPixelBits();
+    pBitmap->UnLockPixelBits(false);
     pBits = 0;
     return true;
 }
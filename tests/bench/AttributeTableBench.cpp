@@ -0,0 +1,115 @@
+#include "tests/common/TestFramework.h"
+#include "duilib/duilib.h"
+
+namespace
+{
+/** 性能测试窗口的XML内容
+*/
+const DString kAttributeBenchXml = _T("<?xml version=\"1.0\" encoding=\"UTF-8\"?>")
+                                   _T("<Window size=\"800,600\"><VBox bkcolor=\"white\"/></Window>");
+
+/** 原实现：按属性名称逐个比较（if/else if链），返回属性ID
+*/
+int32_t PreviousFindAttribute(const std::vector<std::pair<DString, int32_t>>& attributeList, const DString& strName)
+{
+    for (const std::pair<DString, int32_t>& attribute : attributeList) {
+        if (strName == attribute.first) {
+            return attribute.second;
+        }
+    }
+    return -1;
+}
+
+/** 菜单的控件创建函数（菜单项，与Menu::CreateControl一致）
+*/
+ui::Control* CreateMenuControl(ui::Window* pWindow, const DString& strClass)
+{
+    if (strClass == DUI_CTR_MENU_ITEM) {
+        return new ui::MenuItem(pWindow);
+    }
+    return nullptr;
+}
+
+} // namespace
+
+/** CheckBox属性名称的查找性能：原实现逐个比较属性名称 / 完美哈希属性表
+*   （属性名称按属性表中的顺序依次查找，另加一个不存在的属性名称，由基类处理的属性都属于这种情况）
+*/
+DUILIB_BENCH(BenchCheckBoxAttributeLookup)
+{
+    std::vector<std::pair<DString, int32_t>> attributeList;
+    std::vector<DString> attributeNames;
+    for (const ui::AttributeTableEntry& entry : ui::detail::kCheckBoxAttributeEntries) {
+        const DString strName = ui::StringConvert::UTF8ToT(entry.m_name);
+        attributeList.push_back({ strName, entry.m_id });
+        attributeNames.push_back(strName);
+    }
+    attributeNames.push_back(_T("bkcolor"));
+
+    const int32_t nRepeatCount = 20000;
+    const double nLookupCount = (double)nRepeatCount * attributeNames.size();
+    int64_t nPreviousSum = 0;
+    ui_test::BenchTimer timer;
+    for (int32_t i = 0; i < nRepeatCount; ++i) {
+        for (const DString& strName : attributeNames) {
+            nPreviousSum += PreviousFindAttribute(attributeList, strName);
+        }
+    }
+    ui_test::ReportValue("CheckBox attribute lookup (previous, compare chain)",
+                         timer.GetElapsedSeconds() * 1.0e9 / nLookupCount, "ns/lookup");
+    ui_test::DoNotOptimize(&nPreviousSum);
+
+    int64_t nTableSum = 0;
+    timer.Restart();
+    for (int32_t i = 0; i < nRepeatCount; ++i) {
+        for (const DString& strName : attributeNames) {
+            nTableSum += ui::detail::kCheckBoxAttributeTable.Find(strName);
+        }
+    }
+    ui_test::ReportValue("CheckBox attribute lookup (perfect hash table)",
+                         timer.GetElapsedSeconds() * 1.0e9 / nLookupCount, "ns/lookup");
+    ui_test::DoNotOptimize(&nTableSum);
+    TEST_CHECK_EQ(nTableSum, nPreviousSum);
+}
+
+/** 典型布局文件的解析和创建控件的耗时（属性设置是其中的主要部分）：PropertyGrid测试页面、菜单
+*/
+DUILIB_BENCH(BenchLayoutParse)
+{
+    const DString xmlFiles[] = {
+        _T("render/page_property_grid.xml"),
+        _T("public/menu/rich_edit_menu.xml")
+    };
+    ui::Window* pWindow = new ui::Window;
+    pWindow->InitSkin(_T(""), kAttributeBenchXml);
+    if (!pWindow->CreateWnd(nullptr, ui::WindowCreateParam(_T("AttributeTableBench"), true))) {
+        return;
+    }
+    //菜单XML文件中的窗口属性，不应用到测试窗口上
+    pWindow->SetWindowAttributesApplied(true);
+    ui::CreateControlCallback createControlCallback = [pWindow](const DString& strClass) {
+            return CreateMenuControl(pWindow, strClass);
+        };
+
+    const int32_t nParseCount = 20;
+    for (const DString& xmlFile : xmlFiles) {
+        const ui::FilePath xmlFilePath(xmlFile);
+        const ui::FilePath xmlFullPath = ui::FilePathUtil::JoinFilePath(ui::GlobalManager::Instance().GetResourcePath(), xmlFilePath);
+        if (!xmlFullPath.IsExistsFile()) {
+            continue;
+        }
+        size_t nCreatedCount = 0;
+        ui_test::BenchTimer timer;
+        for (int32_t i = 0; i < nParseCount; ++i) {
+            ui::Box* pBox = ui::GlobalManager::Instance().CreateBox(pWindow, xmlFilePath, createControlCallback);
+            if (pBox != nullptr) {
+                ++nCreatedCount;
+                delete pBox;
+            }
+        }
+        ui_test::ReportValue("Parse and create controls, " + ui::StringConvert::TToUTF8(xmlFile),
+                             timer.GetElapsedSeconds() * 1000.0 / nParseCount, "ms");
+        TEST_CHECK_EQ(nCreatedCount, (size_t)nParseCount);
+    }
+    pWindow->CloseWnd();
+}
@@ -0,0 +1,88 @@
+#include "tests/common/TestFramework.h"
+#include "duilib/duilib.h"
+
+#ifdef DUILIB_BUILD_FOR_SDL
+    #include <SDL3/SDL.h>
+#endif
+
+namespace
+{
+/** 性能测试窗口的XML内容
+*/
+const DString kInvalidateBenchXml = _T("<?xml version=\"1.0\" encoding=\"UTF-8\"?>")
+                                    _T("<Window size=\"800,600\"><VBox bkcolor=\"white\"/></Window>");
+
+#ifdef DUILIB_BUILD_FOR_SDL
+/** 向SDL消息队列中添加鼠标移动消息，模拟拖动或者动画过程中的消息积压
+*/
+void PushMouseMotionEvents(int32_t nCount)
+{
+    for (int32_t i = 0; i < nCount; ++i) {
+        SDL_Event sdlEvent;
+        SDL_zero(sdlEvent);
+        sdlEvent.type = SDL_EVENT_MOUSE_MOTION;
+        sdlEvent.motion.x = static_cast<float>(i % 800);
+        sdlEvent.motion.y = static_cast<float>(i % 600);
+        SDL_PushEvent(&sdlEvent);
+    }
+}
+
+/** 原实现中每次Invalidate都会用此过滤函数遍历整个消息队列，查找窗口的绘制消息
+*/
+bool SDLCALL ScanQueuedEvent(void* userdata, SDL_Event* event)
+{
+    if ((userdata != nullptr) && (event != nullptr)) {
+        size_t* pCount = static_cast<size_t*>(userdata);
+        ++(*pCount);
+    }
+    return true;
+}
+#endif
+
+} // namespace
+
+/** 不同消息队列深度下，每秒可以执行的Window::Invalidate次数
+*   SDL平台同时给出原实现（每次调用遍历一次消息队列）的对比数据
+*/
+DUILIB_BENCH(BenchWindowInvalidate)
+{
+    ui::Window* pWindow = new ui::Window;
+    pWindow->InitSkin(_T(""), kInvalidateBenchXml);
+    if (!pWindow->CreateWnd(nullptr, ui::WindowCreateParam(_T("InvalidateBench"), true))) {
+        return;
+    }
+    pWindow->ShowWindow(ui::kSW_SHOW_NORMAL);
+
+    const int32_t nInvalidateCount = 200000;
+    const int32_t queueDepths[] = { 0, 100, 1000, 10000 };
+    for (int32_t nQueueDepth : queueDepths) {
+#ifdef DUILIB_BUILD_FOR_SDL
+        PushMouseMotionEvents(nQueueDepth);
+#endif
+        ui_test::BenchTimer timer;
+        for (int32_t i = 0; i < nInvalidateCount; ++i) {
+            const int32_t x = (i * 37) % 780;
+            const int32_t y = (i * 53) % 580;
+            pWindow->Invalidate(ui::UiRect(x, y, x + 20, y + 20));
+        }
+        ui_test::ReportThroughput("Window::Invalidate, queue depth " + std::to_string(nQueueDepth),
+                                  nInvalidateCount, timer.GetElapsedSeconds());
+
+#ifdef DUILIB_BUILD_FOR_SDL
+        //原实现：每次调用都通过SDL_FilterEvents遍历消息队列
+        const int32_t nScanCount = 2000;
+        size_t nScannedEvents = 0;
+        timer.Restart();
+        for (int32_t i = 0; i < nScanCount; ++i) {
+            SDL_FilterEvents(ScanQueuedEvent, &nScannedEvents);
+        }
+        ui_test::ReportThroughput("SDL_FilterEvents scan (previous Invalidate), queue depth " + std::to_string(nQueueDepth),
+                                  nScanCount, timer.GetElapsedSeconds());
+        ui_test::DoNotOptimize(&nScannedEvents);
+
+        //只清除模拟的鼠标消息，保留窗口的绘制消息
+        SDL_FlushEvent(SDL_EVENT_MOUSE_MOTION);
+#endif
+    }
+    pWindow->CloseWnd();
+}
@@ -0,0 +1,116 @@
+#include "tests/common/TestFramework.h"
+#include "duilib/duilib.h"
+#include "duilib/Control/ListCtrlData.h"
+
+namespace
+{
+/** 列的个数（列的ID为1到kColumnCount）
+*/
+const size_t kColumnCount = 5;
+
+/** 生成单元格的文本（长度不等的文本，模拟文件列表等常见数据）
+*/
+DString MakeCellText(size_t nRow, size_t nColumn)
+{
+    DString text = _T("Item_");
+    text += ui::StringUtil::UInt64ToString(nRow * 7919 % 1000003);
+    text += _T("_");
+    text += ui::StringUtil::UInt64ToString(nColumn);
+    return text;
+}
+
+/** 原实现：每个单元格一个独立分配的数据对象
+*/
+typedef std::vector<std::shared_ptr<ui::ListCtrlSubItemData2>> PreviousColumnData;
+
+/** 原实现中一个单元格占用的内存（估算值：智能指针、引用计数控制块、数据对象、文本的堆内存，不含内存分配器的额外开销）
+*/
+size_t GetPreviousCellBytes(const ui::ListCtrlSubItemData2& storage)
+{
+    size_t nBytes = sizeof(std::shared_ptr<ui::ListCtrlSubItemData2>);
+    nBytes += sizeof(ui::ListCtrlSubItemData2) + sizeof(void*) * 2;
+    if (!storage.text.empty()) {
+        nBytes += (ui::StringUtil::StringLen(storage.text.c_str()) + 1) * sizeof(DString::value_type);
+    }
+    return nBytes;
+}
+
+/** 自定义的比较函数：按文本比较
+*/
+bool CompareSubItemText(const ui::ListCtrlSubItemData2& a, const ui::ListCtrlSubItemData2& b,
+                        const ui::ListCtrlCompareParam& /*param*/)
+{
+    return ui::StringUtil::StringCompare(a.text.c_str(), b.text.c_str()) < 0;
+}
+
+} // namespace
+
+/** ListCtrl数据存储的性能：
+*   （1）添加数据的速度和每行数据占用的内存，与原实现（每个单元格一个独立分配的数据对象）比较
+*   （2）使用自定义比较函数排序的耗时
+*/
+DUILIB_BENCH(BenchListCtrlDataInsert)
+{
+    const size_t nRowCount = 1000000;
+    std::vector<DString> cellTexts;
+    cellTexts.reserve(nRowCount * kColumnCount);
+    for (size_t nRow = 0; nRow < nRowCount; ++nRow) {
+        for (size_t nColumn = 0; nColumn < kColumnCount; ++nColumn) {
+            cellTexts.push_back(MakeCellText(nRow, nColumn));
+        }
+    }
+
+    //原实现：每个单元格一个数据对象
+    ui_test::BenchTimer timer;
+    std::vector<PreviousColumnData> previousColumns(kColumnCount);
+    for (size_t nRow = 0; nRow < nRowCount; ++nRow) {
+        for (size_t nColumn = 0; nColumn < kColumnCount; ++nColumn) {
+            auto pStorage = std::make_shared<ui::ListCtrlSubItemData2>();
+            pStorage->text = cellTexts[nRow * kColumnCount + nColumn];
+            previousColumns[nColumn].push_back(pStorage);
+        }
+    }
+    ui_test::ReportThroughput("Insert rows (previous, " + std::to_string(kColumnCount) + " columns)",
+                              nRowCount, timer.GetElapsedSeconds());
+    size_t nPreviousBytes = 0;
+    for (const PreviousColumnData& columnData : previousColumns) {
+        nPreviousBytes += columnData.capacity() * sizeof(std::shared_ptr<ui::ListCtrlSubItemData2>);
+        for (const auto& pStorage : columnData) {
+            nPreviousBytes += GetPreviousCellBytes(*pStorage) - sizeof(std::shared_ptr<ui::ListCtrlSubItemData2>);
+        }
+    }
+    ui_test::ReportValue("Memory per row (previous, estimated)", (double)nPreviousBytes / nRowCount, "bytes");
+    previousColumns.clear();
+
+    //列式存储
+    timer.Restart();
+    ui::ListCtrlData listCtrlData;
+    for (size_t nColumn = 0; nColumn < kColumnCount; ++nColumn) {
+        listCtrlData.AddColumn(nColumn + 1);
+    }
+    ui::ListCtrlSubItemData subItemData;
+    for (size_t nRow = 0; nRow < nRowCount; ++nRow) {
+        subItemData.text = cellTexts[nRow * kColumnCount];
+        const size_t itemIndex = listCtrlData.AddDataItem(1, subItemData);
+        for (size_t nColumn = 1; nColumn < kColumnCount; ++nColumn) {
+            listCtrlData.SetSubItemText(itemIndex, nColumn + 1, cellTexts[nRow * kColumnCount + nColumn]);
+        }
+    }
+    ui_test::ReportThroughput("Insert rows (columnar, " + std::to_string(kColumnCount) + " columns)",
+                              nRowCount, timer.GetElapsedSeconds());
+    ui_test::ReportValue("Memory per row (columnar)", (double)listCtrlData.GetMemoryBytes() / nRowCount, "bytes");
+
+    //修改文本（长度变化，旧文本成为无用数据，触发缓冲区整理）
+    timer.Restart();
+    for (size_t nRow = 0; nRow < nRowCount; ++nRow) {
+        listCtrlData.SetSubItemText(nRow, 2, cellTexts[nRow * kColumnCount + 1] + _T("_modified"));
+    }
+    ui_test::ReportThroughput("Update text (columnar)", nRowCount, timer.GetElapsedSeconds());
+
+    //自定义比较函数排序
+    timer.Restart();
+    listCtrlData.SortDataItems(1, 0, true, ui::ListCtrlSubItemSortFlag::kDefault, CompareSubItemText, nullptr);
+    ui_test::ReportValue("Sort " + std::to_string(nRowCount) + " rows with custom compare function",
+                         timer.GetElapsedSeconds() * 1000.0, "ms");
+    TEST_CHECK_EQ(listCtrlData.GetDataItemCount(), nRowCount);
+}
@@ -0,0 +1,119 @@
+#include "tests/common/TestFramework.h"
+#include "duilib/duilib.h"
+#include "duilib/Control/ListCtrlHeightIndex.h"
+
+namespace
+{
+/** 默认行高
+*/
+const int32_t kDefaultItemHeight = 24;
+
+/** 生成行数据：部分行设置了行高，部分行隐藏，少量行置顶（非标准模式，需要按行高计算滚动位置）
+*/
+std::vector<ui::ListCtrlItemData> MakeRowDataList(size_t nRowCount)
+{
+    std::vector<ui::ListCtrlItemData> rowDataList(nRowCount);
+    uint32_t nSeed = 0x1234567;
+    for (size_t index = 0; index < nRowCount; ++index) {
+        nSeed = nSeed * 1664525u + 1013904223u;
+        ui::ListCtrlItemData& rowData = rowDataList[index];
+        if ((nSeed >> 24) < 32) {
+            rowData.nItemHeight = (int16_t)(16 + (nSeed >> 8) % 48);
+        }
+        if ((nSeed >> 24) == 255) {
+            rowData.bVisible = false;
+        }
+        if ((index % 1000000) == 0) {
+            rowData.nAlwaysAtTop = 0;
+        }
+    }
+    return rowDataList;
+}
+
+/** 原实现：每次滚动时从第一行开始累加行高，查找滚动位置所在的行
+*/
+size_t PreviousFindScrollRow(const std::vector<ui::ListCtrlItemData>& rowDataList, int64_t nScrollPosY)
+{
+    int64_t nTotalHeight = 0;
+    const size_t nRowCount = rowDataList.size();
+    for (size_t index = 0; index < nRowCount; ++index) {
+        const ui::ListCtrlItemData& rowData = rowDataList[index];
+        const int32_t nItemHeight = (rowData.nItemHeight < 0) ? kDefaultItemHeight : rowData.nItemHeight;
+        if (!rowData.bVisible || (nItemHeight == 0) || (rowData.nAlwaysAtTop >= 0)) {
+            continue;
+        }
+        nTotalHeight += nItemHeight;
+        if (nTotalHeight > nScrollPosY) {
+            return index;
+        }
+    }
+    return nRowCount;
+}
+
+} // namespace
+
+/** 500万行数据的列表滚动：
+*   （1）每次滚动查找第一个可见行的耗时（原实现逐行累加 / 前缀和索引）
+*   （2）建立索引、在中间插入和删除行的耗时（原实现插入删除后整体重建索引 / 只重建插入位置之后的部分）
+*/
+DUILIB_BENCH(BenchListCtrlScroll5MRows)
+{
+    const size_t nRowCount = 5000000;
+    std::vector<ui::ListCtrlItemData> rowDataList = MakeRowDataList(nRowCount);
+
+    ui::ListCtrlHeightIndex heightIndex;
+    ui_test::BenchTimer timer;
+    heightIndex.Build(rowDataList, kDefaultItemHeight);
+    ui_test::ReportValue("Build height index, 5M rows", timer.GetElapsedSeconds() * 1000.0, "ms");
+    const int64_t nTotalHeight = heightIndex.GetTotalScrollHeights();
+
+    //滚动：从顶部均匀滚动到底部
+    const int32_t nPreviousSteps = 50;
+    size_t nFoundRows = 0;
+    timer.Restart();
+    for (int32_t nStep = 0; nStep < nPreviousSteps; ++nStep) {
+        nFoundRows += PreviousFindScrollRow(rowDataList, nTotalHeight * nStep / nPreviousSteps);
+    }
+    ui_test::DoNotOptimize(&nFoundRows);
+    ui_test::ReportValue("Scroll step, 5M rows (previous, linear scan)",
+                         timer.GetElapsedSeconds() * 1000000.0 / nPreviousSteps, "us/step");
+
+    const int32_t nSteps = 1000000;
+    timer.Restart();
+    for (int32_t nStep = 0; nStep < nSteps; ++nStep) {
+        const size_t nTopRow = heightIndex.FindScrollRow(nTotalHeight * nStep / nSteps);
+        nFoundRows += nTopRow + (size_t)heightIndex.GetScrollHeights(nTopRow);
+    }
+    ui_test::DoNotOptimize(&nFoundRows);
+    ui_test::ReportValue("Scroll step, 5M rows (height index)",
+                         timer.GetElapsedSeconds() * 1000000.0 / nSteps, "us/step");
+
+    //在中间、末尾附近插入删除行
+    const size_t insertPositions[] = { nRowCount / 2, nRowCount - 1000 };
+    for (size_t nInsertIndex : insertPositions) {
+        const int32_t nEditCount = 20;
+        //只统计重建索引的耗时（行数据的插入删除两种实现相同）
+        double fRebuildSeconds = 0;
+        for (int32_t i = 0; i < nEditCount; ++i) {
+            rowDataList.insert(rowDataList.begin() + nInsertIndex, ui::ListCtrlItemData());
+            timer.Restart();
+            heightIndex.Build(rowDataList, kDefaultItemHeight);
+            fRebuildSeconds += timer.GetElapsedSeconds();
+            rowDataList.erase(rowDataList.begin() + nInsertIndex);
+            timer.Restart();
+            heightIndex.Build(rowDataList, kDefaultItemHeight);
+            fRebuildSeconds += timer.GetElapsedSeconds();
+        }
+        ui_test::ReportValue("Insert + delete row at " + std::to_string(nInsertIndex) + " (previous, rebuild)",
+                             fRebuildSeconds * 1000.0 / nEditCount, "ms");
+
+        timer.Restart();
+        for (int32_t i = 0; i < nEditCount; ++i) {
+            heightIndex.InsertRow(nInsertIndex, ui::ListCtrlItemData());
+            heightIndex.RemoveRow(nInsertIndex);
+        }
+        ui_test::ReportValue("Insert + delete row at " + std::to_string(nInsertIndex) + " (suffix rebuild)",
+                             timer.GetElapsedSeconds() * 1000.0 / nEditCount, "ms");
+    }
+    TEST_CHECK_EQ(heightIndex.GetTotalScrollHeights(), nTotalHeight);
+}
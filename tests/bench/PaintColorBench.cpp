@@ -0,0 +1,98 @@
+#include "tests/common/TestFramework.h"
+#include "duilib/duilib.h"
+
+namespace
+{
+/** 控件的个数（每行20个控件）
+*/
+const int32_t kControlCount = 2000;
+
+/** 生成测试窗口的XML内容：每个控件都设置了背景色、边框颜色和状态颜色
+*   颜色名称分别使用窗口颜色表、全局颜色表、标准颜色和颜色值
+*/
+DString MakePaintColorBenchXml()
+{
+    DString xml = _T("<?xml version=\"1.0\" encoding=\"UTF-8\"?>")
+                  _T("<Window size=\"1600,1000\">")
+                  _T("<TextColor name=\"bench_window_color\" value=\"#FF336699\"/>")
+                  _T("<VBox bkcolor=\"white\">");
+    for (int32_t nRow = 0; nRow < kControlCount / 20; ++nRow) {
+        xml += _T("<HBox height=\"10\">");
+        for (int32_t nCol = 0; nCol < 20; ++nCol) {
+            xml += _T("<Control width=\"80\" height=\"10\" bkcolor=\"bench_window_color\" border_size=\"1\" ")
+                   _T("border_color=\"default_font_color\" hot_border_color=\"blue\" ")
+                   _T("normal_color=\"#FFF0F0F0\" hot_color=\"#FFE0E0E0\"/>");
+        }
+        xml += _T("</HBox>");
+    }
+    xml += _T("</VBox></Window>");
+    return xml;
+}
+
+} // namespace
+
+/** 控件绘制颜色（背景色、边框颜色、状态颜色）的性能：
+*   （1）整个窗口的控件绘制到离屏Render的耗时
+*   （2）一次颜色获取的耗时：原实现每次绘制按颜色名称查找颜色表，新实现使用预先解析的颜色值
+*/
+DUILIB_BENCH(BenchPaintColors)
+{
+    ui::Window* pWindow = new ui::Window;
+    pWindow->InitSkin(_T(""), MakePaintColorBenchXml());
+    if (!pWindow->CreateWnd(nullptr, ui::WindowCreateParam(_T("PaintColorBench"), true))) {
+        return;
+    }
+    pWindow->ShowWindow(ui::kSW_SHOW_NORMAL);
+
+    ui::Box* pRoot = pWindow->GetRoot();
+    ui::IRenderFactory* pRenderFactory = ui::GlobalManager::Instance().GetRenderFactory();
+    if ((pRoot == nullptr) || (pRenderFactory == nullptr)) {
+        pWindow->CloseWnd();
+        return;
+    }
+    std::unique_ptr<ui::IRender> spRender(pRenderFactory->CreateRender(pWindow->GetRenderDpi()));
+    ui::UiRect rcPaint = pRoot->GetRect();
+    if ((spRender == nullptr) || !spRender->Resize(rcPaint.Width(), rcPaint.Height())) {
+        pWindow->CloseWnd();
+        return;
+    }
+
+    //整个窗口的绘制
+    const int32_t nPaintCount = 50;
+    pRoot->AlphaPaint(spRender.get(), rcPaint);
+    ui_test::BenchTimer timer;
+    for (int32_t i = 0; i < nPaintCount; ++i) {
+        pRoot->AlphaPaint(spRender.get(), rcPaint);
+    }
+    ui_test::ReportValue("Paint " + std::to_string(kControlCount) + " controls with colors",
+                         timer.GetElapsedSeconds() * 1000.0 / nPaintCount, "ms/frame");
+
+    //颜色获取：每个控件每次绘制需要获取背景色、边框颜色和状态颜色
+    ui::Control* pControl = pWindow->FindControl(ui::UiPoint(rcPaint.left + 1, rcPaint.top + 1));
+    if (pControl == nullptr) {
+        pControl = pRoot;
+    }
+    const DString colorNames[] = { _T("bench_window_color"), _T("default_font_color"), _T("blue"), _T("#FFF0F0F0") };
+    const int32_t nLookupCount = 1000000;
+    for (const DString& colorName : colorNames) {
+        ui::UiColor color;
+        timer.Restart();
+        for (int32_t i = 0; i < nLookupCount; ++i) {
+            color = pControl->GetUiColor(colorName);
+        }
+        ui_test::DoNotOptimize(&color);
+        ui_test::ReportThroughput("Control::GetUiColor (previous), " + ui::StringConvert::TToUTF8(colorName),
+                                  nLookupCount, timer.GetElapsedSeconds());
+
+        ui::UiNamedColor namedColor;
+        namedColor = colorName;
+        timer.Restart();
+        for (int32_t i = 0; i < nLookupCount; ++i) {
+            color = namedColor.GetColor(pControl);
+        }
+        ui_test::DoNotOptimize(&color);
+        ui_test::ReportThroughput("UiNamedColor::GetColor, " + ui::StringConvert::TToUTF8(colorName),
+                                  nLookupCount, timer.GetElapsedSeconds());
+    }
+    pWindow->CloseWnd();
+}
@@ -0,0 +1,105 @@
+#include "tests/common/TestFramework.h"
+#include "duilib/Render/PixelConvert.h"
+#include <cstring>
+
+namespace
+{
+/** 指令集的名称
+*/
+const char* GetSimdName(ui::PixelConvertSimd simd)
+{
+    switch (simd) {
+    case ui::PixelConvertSimd::kSSE2:
+        return "SSE2";
+    case ui::PixelConvertSimd::kSSSE3:
+        return "SSSE3";
+    case ui::PixelConvertSimd::kAVX2:
+        return "AVX2";
+    case ui::PixelConvertSimd::kNEON:
+        return "NEON";
+    default:
+        return "Scalar";
+    }
+}
+
+/** 原实现：先复制数据，再逐像素调整颜色通道顺序，最后逐像素进行Alpha缩放（每个步骤各遍历一次数据）
+*/
+void PreviousConvertFrame(uint32_t* pDst, const uint32_t* pSrc, size_t nPixels,
+                          const int32_t srcOrder[4], const int32_t dstOrder[4], uint8_t nAlpha)
+{
+    ::memcpy(pDst, pSrc, nPixels * sizeof(uint32_t));
+    const bool bSameOrder = ::memcmp(srcOrder, dstOrder, sizeof(int32_t) * 4) == 0;
+    for (size_t i = 0; (i < nPixels) && !bSameOrder; ++i) {
+        uint32_t colorValue = pDst[i];
+        for (int32_t nChannel = 0; nChannel < 4; ++nChannel) {
+            if (srcOrder[nChannel] != dstOrder[nChannel]) {
+                ((uint8_t*)(pDst + i))[dstOrder[nChannel]] = ((uint8_t*)&colorValue)[srcOrder[nChannel]];
+            }
+        }
+    }
+    if (nAlpha != 255) {
+        for (size_t i = 0; i < nPixels; ++i) {
+            uint8_t* pBytes = (uint8_t*)(pDst + i);
+            for (int32_t nChannel = 0; nChannel < 4; ++nChannel) {
+                pBytes[nChannel] = (uint8_t)(pBytes[nChannel] * nAlpha / 255);
+            }
+        }
+    }
+}
+
+} // namespace
+
+/** 一帧4K图像（3840x2160）的像素转换耗时：SDL窗口绘制时，Skia位图数据复制到SDL Surface的过程
+*/
+DUILIB_BENCH(BenchPixelConvert4KFrame)
+{
+    const int32_t nWidth = 3840;
+    const int32_t nHeight = 2160;
+    const size_t nPixels = (size_t)nWidth * nHeight;
+    std::vector<uint32_t> srcPixels(nPixels);
+    std::vector<uint32_t> dstPixels(nPixels);
+    uint32_t nSeed = 0x12345678;
+    for (uint32_t& pixel : srcPixels) {
+        nSeed = nSeed * 1664525u + 1013904223u;
+        pixel = nSeed;
+    }
+
+    struct BenchCase
+    {
+        const char* m_name;
+        int32_t m_srcOrder[4];
+        int32_t m_dstOrder[4];
+        uint8_t m_nAlpha;
+    };
+    const BenchCase benchCases[] = {
+        { "copy",             { 0, 1, 2, 3 }, { 0, 1, 2, 3 }, 255 },
+        { "swap RB",          { 0, 1, 2, 3 }, { 2, 1, 0, 3 }, 255 },
+        { "swap RB + alpha",  { 0, 1, 2, 3 }, { 2, 1, 0, 3 }, 200 },
+        { "shuffle + alpha",  { 0, 1, 2, 3 }, { 3, 2, 1, 0 }, 200 }
+    };
+
+    const int32_t nFrames = 20;
+    const char* simdName = GetSimdName(ui::PixelConvert::GetBestSimd());
+    for (const BenchCase& benchCase : benchCases) {
+        const int32_t* srcOrder = benchCase.m_srcOrder;
+        const int32_t* dstOrder = benchCase.m_dstOrder;
+        ui_test::BenchTimer timer;
+        for (int32_t i = 0; i < nFrames; ++i) {
+            PreviousConvertFrame(dstPixels.data(), srcPixels.data(), nPixels, srcOrder, dstOrder, benchCase.m_nAlpha);
+        }
+        ui_test::DoNotOptimize(dstPixels.data());
+        ui_test::ReportValue(std::string("4K frame, previous, ") + benchCase.m_name,
+                             timer.GetElapsedSeconds() * 1000.0 / nFrames, "ms/frame");
+
+        ui::PixelConvert pixelConvert(srcOrder[0], srcOrder[1], srcOrder[2], srcOrder[3],
+                                      dstOrder[0], dstOrder[1], dstOrder[2], dstOrder[3],
+                                      benchCase.m_nAlpha);
+        timer.Restart();
+        for (int32_t i = 0; i < nFrames; ++i) {
+            pixelConvert.ConvertRect(dstPixels.data(), nWidth, srcPixels.data(), nWidth, ui::UiRect(0, 0, nWidth, nHeight));
+        }
+        ui_test::DoNotOptimize(dstPixels.data());
+        ui_test::ReportValue(std::string("4K frame, PixelConvert (") + GetSimdName(pixelConvert.GetSimd()) + "/" + simdName + "), " + benchCase.m_name,
+                             timer.GetElapsedSeconds() * 1000.0 / nFrames, "ms/frame");
+    }
+}
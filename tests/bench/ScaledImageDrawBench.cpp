@@ -0,0 +1,95 @@
+#include "tests/common/TestFramework.h"
+#include "duilib/duilib.h"
+
+namespace
+{
+/** 源图片的大小、绘制目标的大小
+*/
+const int32_t kImageWidth = 400;
+const int32_t kImageHeight = 300;
+const int32_t kDestWidth = 1600;
+const int32_t kDestHeight = 1000;
+
+/** 生成源图片（渐变色，不透明）
+*/
+ui::IBitmap* MakeBenchBitmap(ui::IRenderFactory* pRenderFactory)
+{
+    std::vector<uint32_t> pixels((size_t)kImageWidth * kImageHeight);
+    for (int32_t y = 0; y < kImageHeight; ++y) {
+        for (int32_t x = 0; x < kImageWidth; ++x) {
+            pixels[(size_t)y * kImageWidth + x] = 0xFF000000 | ((uint32_t)(x & 0xFF) << 16) | ((uint32_t)(y & 0xFF) << 8);
+        }
+    }
+    ui::IBitmap* pBitmap = pRenderFactory->CreateBitmap();
+    if ((pBitmap != nullptr) && !pBitmap->Init(kImageWidth, kImageHeight, pixels.data())) {
+        delete pBitmap;
+        pBitmap = nullptr;
+    }
+    return pBitmap;
+}
+
+} // namespace
+
+/** 图片拉伸绘制（缩放后的图片缓存）的性能：
+*   （1）每帧只读访问位图像素后拉伸绘制：原实现LockPixelBits即使缓存失效（每帧重新缩放） / 只有修改像素后缓存才失效
+*   （2）横向平铺、纵向拉伸绘制，目标宽度每帧变化（比如调整窗口大小）：
+*        原实现最后一个被裁剪的图块按裁剪后的大小缩放（每帧不同，无法命中缓存） / 按完整图块缩放后裁剪（与其他图块共用缓存）
+*/
+DUILIB_BENCH(BenchScaledImageDraw)
+{
+    ui::IRenderFactory* pRenderFactory = ui::GlobalManager::Instance().GetRenderFactory();
+    if (pRenderFactory == nullptr) {
+        return;
+    }
+    std::unique_ptr<ui::IRender> spRender(pRenderFactory->CreateRender(nullptr));
+    std::unique_ptr<ui::IBitmap> spBitmap(MakeBenchBitmap(pRenderFactory));
+    if ((spRender == nullptr) || (spBitmap == nullptr) || !spRender->Resize(kDestWidth, kDestHeight)) {
+        return;
+    }
+    const ui::UiRect rcPaint(0, 0, kDestWidth, kDestHeight);
+    const ui::UiRect rcSource(0, 0, kImageWidth, kImageHeight);
+    const int32_t nFrameCount = 50;
+
+    //（1）每帧读取像素后拉伸绘制
+    const bool bPixelsChangedValues[] = { true, false };
+    for (bool bPixelsChanged : bPixelsChangedValues) {
+        ui_test::BenchTimer timer;
+        for (int32_t i = 0; i < nFrameCount; ++i) {
+            const uint32_t* pPixelBits = (const uint32_t*)spBitmap->LockPixelBits();
+            uint32_t nPixel = (pPixelBits != nullptr) ? pPixelBits[0] : 0;
+            ui_test::DoNotOptimize(&nPixel);
+            spBitmap->UnLockPixelBits(bPixelsChanged);
+            spRender->DrawImage(rcPaint, spBitmap.get(), rcPaint, rcSource);
+        }
+        ui_test::ReportValue(bPixelsChanged ? "Stretch draw after pixel read (previous, cache invalidated)" :
+                                              "Stretch draw after pixel read (read-only unlock)",
+                             timer.GetElapsedSeconds() * 1000.0 / nFrameCount, "ms/frame");
+    }
+
+    //（2）横向平铺、纵向拉伸绘制，目标宽度每帧变化
+    ui::TiledDrawParam tiledParam;
+    tiledParam.m_bTiledX = true;
+    ui_test::BenchTimer timer;
+    for (int32_t i = 0; i < nFrameCount; ++i) {
+        //原实现：完整的图块与被裁剪的最后一个图块分别按各自的大小缩放
+        const int32_t nDestWidth = kDestWidth - 1 - i;
+        const int32_t nFullTiles = nDestWidth / kImageWidth;
+        for (int32_t nTile = 0; nTile < nFullTiles; ++nTile) {
+            const ui::UiRect rcTile(nTile * kImageWidth, 0, (nTile + 1) * kImageWidth, kDestHeight);
+            spRender->DrawImage(rcPaint, spBitmap.get(), rcTile, rcSource);
+        }
+        const int32_t nLastWidth = nDestWidth - nFullTiles * kImageWidth;
+        const ui::UiRect rcLastTile(nFullTiles * kImageWidth, 0, nDestWidth, kDestHeight);
+        spRender->DrawImage(rcPaint, spBitmap.get(), rcLastTile, ui::UiRect(0, 0, nLastWidth, kImageHeight));
+    }
+    ui_test::ReportValue("Tiled-X draw while resizing (previous, clipped tile scaled separately)",
+                         timer.GetElapsedSeconds() * 1000.0 / nFrameCount, "ms/frame");
+
+    timer.Restart();
+    for (int32_t i = 0; i < nFrameCount; ++i) {
+        const ui::UiRect rcDest(0, 0, kDestWidth - 1 - i, kDestHeight);
+        spRender->DrawImage(rcPaint, spBitmap.get(), rcDest, rcSource, 255, &tiledParam);
+    }
+    ui_test::ReportValue("Tiled-X draw while resizing (full tile scaled, then clipped)",
+                         timer.GetElapsedSeconds() * 1000.0 / nFrameCount, "ms/frame");
+}
@@ -0,0 +1,159 @@
+#include "tests/common/TestFramework.h"
+#include "duilib/duilib.h"
+#include "duilib/third_party/zlib/contrib/minizip/unzip.h"
+
+namespace
+{
+/** 压缩包内的文件信息
+*/
+struct ZipEntryInfo
+{
+    std::string m_innerPath;        //压缩包内的路径（UTF8编码）
+    size_t m_nUncompressedSize = 0; //原始数据长度
+    bool m_bStored = false;         //是否为未压缩的文件
+};
+
+/** 原实现：使用minizip打开压缩包，首次查询时遍历所有文件建立路径缓存
+*/
+bool PreviousOpenZip(const std::string& zipPath, std::vector<ZipEntryInfo>& entries, unzFile& hzip)
+{
+    entries.clear();
+    hzip = ::unzOpen(zipPath.c_str());
+    if (hzip == nullptr) {
+        return false;
+    }
+    int nRet = ::unzGoToFirstFile(hzip);
+    while (nRet == UNZ_OK) {
+        char szFileName[1024] = { 0, };
+        unz_file_info fileInfo = { 0, };
+        nRet = ::unzGetCurrentFileInfo(hzip, &fileInfo, szFileName, sizeof(szFileName) - 1, nullptr, 0, nullptr, 0);
+        if (nRet != UNZ_OK) {
+            break;
+        }
+        if (fileInfo.uncompressed_size > 0) {
+            ZipEntryInfo entry;
+            entry.m_innerPath = szFileName;
+            entry.m_nUncompressedSize = fileInfo.uncompressed_size;
+            entry.m_bStored = (fileInfo.compression_method == 0);
+            entries.push_back(entry);
+        }
+        nRet = ::unzGoToNextFile(hzip);
+    }
+    return true;
+}
+
+/** 原实现：使用minizip定位文件（遍历方式）并读取
+*/
+bool PreviousReadZipData(unzFile hzip, const std::string& innerPath, std::vector<uint8_t>& fileData)
+{
+    if (::unzLocateFile(hzip, innerPath.c_str(), 2) != UNZ_OK) {
+        return false;
+    }
+    unz_file_info fileInfo = { 0, };
+    if ((::unzGetCurrentFileInfo(hzip, &fileInfo, nullptr, 0, nullptr, 0, nullptr, 0) != UNZ_OK) ||
+        (::unzOpenCurrentFile(hzip) != UNZ_OK)) {
+        return false;
+    }
+    fileData.resize(fileInfo.uncompressed_size);
+    const int nRead = ::unzReadCurrentFile(hzip, fileData.data(), (uint32_t)fileData.size());
+    ::unzCloseCurrentFile(hzip);
+    return nRead == (int)fileData.size();
+}
+
+} // namespace
+
+/** 资源压缩包（bin/resources.zip）的读取性能：
+*   （1）打开压缩包的耗时：原实现minizip打开并遍历建立路径缓存 / 内存映射并解析中央目录建立文件索引
+*   （2）读取所有文件的吞吐量：原实现minizip逐个定位并读取 / 通过文件索引读取 / 未压缩文件直接访问映射的数据
+*/
+DUILIB_BENCH(BenchZipResource)
+{
+    ui::FilePath zipPath = ui::FilePathUtil::GetCurrentModuleDirectory();
+    zipPath += _T("resources.zip");
+    if (!zipPath.IsExistsFile()) {
+        return;
+    }
+    const std::string zipPathA = zipPath.NativePathA();
+    const int32_t nOpenCount = 20;
+
+    //（1）打开压缩包
+    std::vector<ZipEntryInfo> entries;
+    unzFile hzip = nullptr;
+    ui_test::BenchTimer timer;
+    for (int32_t i = 0; i < nOpenCount; ++i) {
+        if (hzip != nullptr) {
+            ::unzClose(hzip);
+            hzip = nullptr;
+        }
+        PreviousOpenZip(zipPathA, entries, hzip);
+    }
+    ui_test::ReportValue("Open resources.zip (previous, minizip + path cache)",
+                         timer.GetElapsedSeconds() * 1000.0 / nOpenCount, "ms");
+    if ((hzip == nullptr) || entries.empty()) {
+        return;
+    }
+
+    ui::ZipManager zipManager;
+    timer.Restart();
+    for (int32_t i = 0; i < nOpenCount; ++i) {
+        zipManager.OpenZipFile(zipPath, _T(""));
+    }
+    ui_test::ReportValue("Open resources.zip (mapped central-directory index)",
+                         timer.GetElapsedSeconds() * 1000.0 / nOpenCount, "ms");
+
+    //（2）读取所有文件
+    size_t nTotalBytes = 0;
+    size_t nStoredCount = 0;
+    for (const ZipEntryInfo& entry : entries) {
+        nTotalBytes += entry.m_nUncompressedSize;
+        nStoredCount += entry.m_bStored ? 1 : 0;
+    }
+    const double fTotalMB = (double)nTotalBytes / (1024.0 * 1024.0);
+    std::vector<uint8_t> fileData;
+    size_t nReadBytes = 0;
+    timer.Restart();
+    for (const ZipEntryInfo& entry : entries) {
+        if (PreviousReadZipData(hzip, entry.m_innerPath, fileData)) {
+            nReadBytes += fileData.size();
+        }
+    }
+    ui_test::ReportValue("Read all entries (previous, minizip locate + read)", fTotalMB / timer.GetElapsedSeconds(), "MB/s");
+    ::unzClose(hzip);
+    hzip = nullptr;
+    TEST_CHECK_EQ(nReadBytes, nTotalBytes);
+
+    nReadBytes = 0;
+    timer.Restart();
+    for (const ZipEntryInfo& entry : entries) {
+        if (zipManager.GetZipData(ui::FilePath(entry.m_innerPath), fileData)) {
+            nReadBytes += fileData.size();
+        }
+    }
+    ui_test::ReportValue("Read all entries (file index)", fTotalMB / timer.GetElapsedSeconds(), "MB/s");
+    TEST_CHECK_EQ(nReadBytes, nTotalBytes);
+
+    //未压缩的文件：直接访问映射的数据（关闭压缩包后，已获取的数据仍然有效）
+    std::vector<std::shared_ptr<const uint8_t>> storedDataList;
+    size_t nStoredBytes = 0;
+    timer.Restart();
+    for (const ZipEntryInfo& entry : entries) {
+        if (entry.m_bStored) {
+            size_t nDataSize = 0;
+            std::shared_ptr<const uint8_t> pData = zipManager.GetZipStoredData(ui::FilePath(entry.m_innerPath), nDataSize);
+            if (pData != nullptr) {
+                nStoredBytes += nDataSize;
+                storedDataList.push_back(pData);
+            }
+        }
+    }
+    ui_test::ReportThroughput("Get stored entries without copy (" + std::to_string(nStoredCount) + " entries)",
+                              (double)storedDataList.size(), timer.GetElapsedSeconds());
+    zipManager.CloseResZip();
+    uint32_t nCheckSum = 0;
+    for (const std::shared_ptr<const uint8_t>& pData : storedDataList) {
+        nCheckSum += pData.get()[0];
+    }
+    ui_test::DoNotOptimize(&nCheckSum);
+    TEST_CHECK_EQ(storedDataList.size(), nStoredCount);
+    ui_test::DoNotOptimize(&nStoredBytes);
+}
@@ -0,0 +1,10 @@
+#include "tests/common/TestMainThread.h"
+
+/** 性能测试程序的入口点（建议使用Release版本运行）
+ * 用法：duilib_bench [过滤字符串]，指定过滤字符串时，只执行名称中包含该字符串的用例
+ */
+int main(int argc, char** argv)
+{
+    const char* filter = (argc > 1) ? argv[1] : nullptr;
+    return ui_test::RunTestsInUIThread(ui_test::GetBenchmarks(), filter);
+}
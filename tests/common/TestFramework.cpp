@@ -0,0 +1,101 @@
+#include "TestFramework.h"
+#include <cstdio>
+#include <cstring>
+
+namespace ui_test
+{
+/** 当前用例中检查失败的次数
+*/
+static size_t s_nCheckFailures = 0;
+
+std::vector<TestCase>& GetUnitTests()
+{
+    static std::vector<TestCase> unitTests;
+    return unitTests;
+}
+
+std::vector<TestCase>& GetBenchmarks()
+{
+    static std::vector<TestCase> benchmarks;
+    return benchmarks;
+}
+
+TestRegistrar::TestRegistrar(std::vector<TestCase>& tests, const char* name, void (*func)())
+{
+    tests.push_back({ name, func });
+}
+
+void ReportFailure(const char* file, int line, const char* expr)
+{
+    ++s_nCheckFailures;
+    std::printf("  %s(%d): check failed: %s\n", file, line, expr);
+}
+
+int RunTests(const std::vector<TestCase>& tests, const char* filter)
+{
+    int nFailedCount = 0;
+    int nRunCount = 0;
+    for (const TestCase& test : tests) {
+        if ((filter != nullptr) && (std::strstr(test.m_name, filter) == nullptr)) {
+            continue;
+        }
+        std::printf("[ RUN    ] %s\n", test.m_name);
+        std::fflush(stdout);
+        s_nCheckFailures = 0;
+        BenchTimer timer;
+        test.m_func();
+        const double fElapsedMs = timer.GetElapsedSeconds() * 1000.0;
+        if (s_nCheckFailures == 0) {
+            std::printf("[     OK ] %s (%.1f ms)\n", test.m_name, fElapsedMs);
+        }
+        else {
+            std::printf("[ FAILED ] %s (%zu failed checks)\n", test.m_name, s_nCheckFailures);
+            ++nFailedCount;
+        }
+        std::fflush(stdout);
+        ++nRunCount;
+    }
+    std::printf("%d test(s) run, %d failed.\n", nRunCount, nFailedCount);
+    std::fflush(stdout);
+    return nFailedCount;
+}
+
+BenchTimer::BenchTimer():
+    m_startTime(std::chrono::steady_clock::now())
+{
+}
+
+void BenchTimer::Restart()
+{
+    m_startTime = std::chrono::steady_clock::now();
+}
+
+double BenchTimer::GetElapsedSeconds() const
+{
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - m_startTime;
+    return elapsed.count();
+}
+
+void ReportThroughput(const std::string& name, double nOps, double fSeconds)
+{
+    const double fOpsPerSecond = (fSeconds > 0) ? (nOps / fSeconds) : 0;
+    std::printf("  %-56s %14.0f ops/s  (%.0f ops in %.3f ms)\n", name.c_str(), fOpsPerSecond, nOps, fSeconds * 1000.0);
+    std::fflush(stdout);
+}
+
+void ReportValue(const std::string& name, double fValue, const char* unit)
+{
+    std::printf("  %-56s %14.3f %s\n", name.c_str(), fValue, unit);
+    std::fflush(stdout);
+}
+
+/** 保存性能测试的计算结果，写入volatile变量，编译器不能省略
+*/
+const void* volatile g_pBenchSink = nullptr;
+
+void DoNotOptimize(const void* p)
+{
+    g_pBenchSink = p;
+}
+
+} // namespace ui_test
@@ -0,0 +1,124 @@
+#ifndef DUILIB_TESTS_TEST_FRAMEWORK_H_
+#define DUILIB_TESTS_TEST_FRAMEWORK_H_
+
+#include <cstdint>
+#include <chrono>
+#include <string>
+#include <vector>
+
+/** 单元测试与性能测试的简易框架
+ * 说明：
+ * （1）使用 DUILIB_TEST 定义单元测试用例，使用 DUILIB_BENCH 定义性能测试用例，用例在程序启动时自动注册
+ * （2）单元测试使用 TEST_CHECK 系列宏检查结果，检查失败时记录文件和行号，不中断后续的检查
+ * （3）用例在UI线程中执行（GlobalManager已经完成初始化），可以创建窗口和控件
+ */
+namespace ui_test
+{
+/** 测试用例的注册信息
+*/
+struct TestCase
+{
+    //用例名称
+    const char* m_name;
+
+    //用例的执行函数
+    void (*m_func)();
+};
+
+/** 获取所有注册的单元测试用例
+*/
+std::vector<TestCase>& GetUnitTests();
+
+/** 获取所有注册的性能测试用例
+*/
+std::vector<TestCase>& GetBenchmarks();
+
+/** 测试用例的自动注册辅助类
+*/
+class TestRegistrar
+{
+public:
+    TestRegistrar(std::vector<TestCase>& tests, const char* name, void (*func)());
+};
+
+/** 记录一次检查失败
+* @param [in] file 源码文件名
+* @param [in] line 源码行号
+* @param [in] expr 检查失败的表达式
+*/
+void ReportFailure(const char* file, int line, const char* expr);
+
+/** 执行测试用例
+* @param [in] tests 测试用例列表
+* @param [in] filter 如果不为空，只执行名称中包含该字符串的用例
+* @return 返回失败的用例个数
+*/
+int RunTests(const std::vector<TestCase>& tests, const char* filter);
+
+/** 性能测试的计时器（构造时开始计时）
+*/
+class BenchTimer
+{
+public:
+    BenchTimer();
+
+    /** 重新开始计时
+    */
+    void Restart();
+
+    /** 获取从开始计时到现在的时间（单位：秒）
+    */
+    double GetElapsedSeconds() const;
+
+private:
+    std::chrono::steady_clock::time_point m_startTime;
+};
+
+/** 输出性能测试的吞吐量结果
+* @param [in] name 测试项名称
+* @param [in] nOps 执行的操作次数
+* @param [in] fSeconds 执行耗时（单位：秒）
+*/
+void ReportThroughput(const std::string& name, double nOps, double fSeconds);
+
+/** 输出性能测试的单项数值（比如耗时、内存占用）
+* @param [in] name 测试项名称
+* @param [in] fValue 数值
+* @param [in] unit 数值的单位
+*/
+void ReportValue(const std::string& name, double fValue, const char* unit);
+
+/** 防止编译器将性能测试中的计算结果优化掉
+*/
+void DoNotOptimize(const void* p);
+
+} // namespace ui_test
+
+/** 定义一个单元测试用例
+*/
+#define DUILIB_TEST(name) \
+    static void name(); \
+    static ui_test::TestRegistrar name##_registrar(ui_test::GetUnitTests(), #name, name); \
+    static void name()
+
+/** 定义一个性能测试用例
+*/
+#define DUILIB_BENCH(name) \
+    static void name(); \
+    static ui_test::TestRegistrar name##_registrar(ui_test::GetBenchmarks(), #name, name); \
+    static void name()
+
+/** 检查表达式的值为true
+*/
+#define TEST_CHECK(expr) \
+    do { \
+        if (!(expr)) { \
+            ui_test::ReportFailure(__FILE__, __LINE__, #expr); \
+        } \
+    } while (0)
+
+/** 检查两个值相等
+*/
+#define TEST_CHECK_EQ(a, b) TEST_CHECK((a) == (b))
+
+#endif // DUILIB_TESTS_TEST_FRAMEWORK_H_
@@ -0,0 +1,53 @@
+#include "TestMainThread.h"
+
+namespace ui_test
+{
+TestMainThread::TestMainThread(const std::vector<TestCase>& tests, const char* filter) :
+    FrameworkThread(_T("TestMainThread"), ui::kThreadUI),
+    m_tests(tests),
+    m_nFailedCount(0)
+{
+    if (filter != nullptr) {
+        m_filter = filter;
+    }
+}
+
+TestMainThread::~TestMainThread()
+{
+}
+
+int TestMainThread::GetFailedCount() const
+{
+    return m_nFailedCount;
+}
+
+void TestMainThread::OnInit()
+{
+    //使用程序所在目录的resources子目录作为资源（与examples的程序相同）
+    ui::FilePath resourcePath = ui::FilePathUtil::GetCurrentModuleDirectory();
+    resourcePath += _T("resources\\");
+    ui::GlobalManager::Instance().Startup(ui::LocalFilesResParam(resourcePath));
+
+    //进入消息循环后再执行用例，用例中可以创建窗口
+    PostTask(ui::UiBind(&TestMainThread::RunAllTests, this));
+}
+
+void TestMainThread::OnCleanup()
+{
+    ui::GlobalManager::Instance().Shutdown();
+}
+
+void TestMainThread::RunAllTests()
+{
+    m_nFailedCount = RunTests(m_tests, m_filter.empty() ? nullptr : m_filter.c_str());
+    ui::WindowBase::PostQuitMsg(0);
+}
+
+int RunTestsInUIThread(const std::vector<TestCase>& tests, const char* filter)
+{
+    TestMainThread thread(tests, filter);
+    thread.RunMessageLoop();
+    return thread.GetFailedCount();
+}
+
+} // namespace ui_test
@@ -0,0 +1,61 @@
+#ifndef DUILIB_TESTS_TEST_MAIN_THREAD_H_
+#define DUILIB_TESTS_TEST_MAIN_THREAD_H_
+
+#include "tests/common/TestFramework.h"
+#include "duilib/duilib.h"
+
+namespace ui_test
+{
+/** 测试程序的主线程：初始化全局资源后，在UI线程中依次执行测试用例，执行完成后退出消息循环
+*/
+class TestMainThread : public ui::FrameworkThread
+{
+public:
+    /** 构造函数
+    * @param [in] tests 需要执行的测试用例列表
+    * @param [in] filter 如果不为空，只执行名称中包含该字符串的用例
+    */
+    TestMainThread(const std::vector<TestCase>& tests, const char* filter);
+    virtual ~TestMainThread() override;
+
+    /** 获取失败的用例个数
+    */
+    int GetFailedCount() const;
+
+private:
+    /** 运行前初始化，在进入消息循环前调用
+    */
+    virtual void OnInit() override;
+
+    /** 退出时清理，在退出消息循环后调用
+    */
+    virtual void OnCleanup() override;
+
+    /** 执行测试用例，并退出消息循环
+    */
+    void RunAllTests();
+
+private:
+    /** 测试用例列表
+    */
+    std::vector<TestCase> m_tests;
+
+    /** 用例名称过滤条件
+    */
+    std::string m_filter;
+
+    /** 失败的用例个数
+    */
+    int m_nFailedCount;
+};
+
+/** 在UI线程中执行测试用例（阻塞直到执行完成）
+* @param [in] tests 需要执行的测试用例列表
+* @param [in] filter 如果不为空，只执行名称中包含该字符串的用例
+* @return 返回失败的用例个数
+*/
+int RunTestsInUIThread(const std::vector<TestCase>& tests, const char* filter);
+
+} // namespace ui_test
+
+#endif // DUILIB_TESTS_TEST_MAIN_THREAD_H_
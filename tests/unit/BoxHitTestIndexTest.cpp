@@ -0,0 +1,119 @@
+#include "tests/common/TestFramework.h"
+#include "duilib/duilib.h"
+#include "duilib/Core/BoxHitTestIndex.h"
+
+namespace
+{
+/** 简单的伪随机数生成器（结果可重现）
+*/
+class TestRandom
+{
+public:
+    explicit TestRandom(uint32_t nSeed): m_nSeed(nSeed) {}
+    int32_t Next(int32_t nMax)
+    {
+        m_nSeed = m_nSeed * 1664525u + 1013904223u;
+        return (int32_t)((m_nSeed >> 8) % (uint32_t)nMax);
+    }
+
+private:
+    uint32_t m_nSeed;
+};
+
+/** 生成一个随机的子控件位置（部分子控件互相重叠，部分子控件为空矩形）
+*/
+ui::UiRect MakeItemRect(TestRandom& random, int32_t nAreaSize)
+{
+    if (random.Next(20) == 0) {
+        return ui::UiRect();
+    }
+    const int32_t nLeft = random.Next(nAreaSize);
+    const int32_t nTop = random.Next(nAreaSize);
+    return ui::UiRect(nLeft, nTop, nLeft + 1 + random.Next(120), nTop + 1 + random.Next(120));
+}
+
+/** 检查空间索引的查找结果与逐个检查所有子控件的结果一致
+*/
+bool CheckHitTestIndex(ui::BoxHitTestIndex& hitTestIndex, const std::vector<ui::Control*>& items,
+                       TestRandom& random, int32_t nAreaSize)
+{
+    for (int32_t nPoint = 0; nPoint < 2000; ++nPoint) {
+        const ui::UiPoint pt(random.Next(nAreaSize + 200) - 100, random.Next(nAreaSize + 200) - 100);
+        std::vector<uint32_t> expectedItems;
+        for (size_t nIndex = 0; nIndex < items.size(); ++nIndex) {
+            if (items[nIndex]->GetRect().ContainsPt(pt)) {
+                expectedItems.push_back((uint32_t)nIndex);
+            }
+        }
+        std::vector<uint32_t> hitItems;
+        for (uint32_t nIndex : hitTestIndex.FindItems(items, pt)) {
+            if (items[nIndex]->GetRect().ContainsPt(pt)) {
+                hitItems.push_back(nIndex);
+            }
+        }
+        if (hitItems != expectedItems) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+/** 网格空间索引的查找结果与逐个检查所有子控件（原实现）一致：
+*   完整建立索引、部分子控件位置变化后增量更新、子控件移出网格区域后重建
+*/
+DUILIB_TEST(BoxHitTestIndexMatchesLinearScan)
+{
+    const DString xml = _T("<?xml version=\"1.0\" encoding=\"UTF-8\"?><Window size=\"200,100\"><VBox/></Window>");
+    ui::Window* pWindow = new ui::Window;
+    pWindow->InitSkin(_T(""), xml);
+    if (!pWindow->CreateWnd(nullptr, ui::WindowCreateParam(_T("BoxHitTestIndexTest"), true))) {
+        TEST_CHECK(!"CreateWnd failed");
+        return;
+    }
+    const int32_t nAreaSize = 1000;
+    TestRandom random(0x13572468);
+    std::vector<std::unique_ptr<ui::Control>> controls;
+    std::vector<ui::Control*> items;
+    for (int32_t i = 0; i < 500; ++i) {
+        controls.push_back(std::make_unique<ui::Control>(pWindow));
+        controls.back()->SetRect(MakeItemRect(random, nAreaSize));
+        items.push_back(controls.back().get());
+    }
+
+    ui::BoxHitTestIndex hitTestIndex;
+    TEST_CHECK(CheckHitTestIndex(hitTestIndex, items, random, nAreaSize));
+
+    //少量子控件的位置发生变化：增量更新
+    for (int32_t nStep = 0; nStep < 10; ++nStep) {
+        for (int32_t i = 0; i < 8; ++i) {
+            ui::Control* pItem = items[(size_t)random.Next((int32_t)items.size())];
+            ui::UiRect rcItem = pItem->GetRect();
+            if (rcItem.IsEmpty()) {
+                rcItem = MakeItemRect(random, nAreaSize);
+            }
+            else {
+                rcItem.Offset(random.Next(41) - 20, random.Next(41) - 20);
+            }
+            pItem->SetRect(rcItem);
+            hitTestIndex.OnItemRectChanged(pItem);
+        }
+        TEST_CHECK(CheckHitTestIndex(hitTestIndex, items, random, nAreaSize));
+    }
+
+    //子控件移出网格覆盖的区域：完整重建
+    items[0]->SetRect(ui::UiRect(nAreaSize + 50, nAreaSize + 50, nAreaSize + 90, nAreaSize + 90));
+    hitTestIndex.OnItemRectChanged(items[0]);
+    TEST_CHECK(CheckHitTestIndex(hitTestIndex, items, random, nAreaSize + 100));
+
+    //子控件列表变化（删除、调整顺序）
+    items.erase(items.begin() + 10, items.begin() + 20);
+    std::swap(items[1], items[100]);
+    hitTestIndex.Invalidate();
+    TEST_CHECK(CheckHitTestIndex(hitTestIndex, items, random, nAreaSize + 100));
+
+    items.clear();
+    controls.clear();
+    pWindow->CloseWnd();
+}
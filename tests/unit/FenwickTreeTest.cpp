@@ -0,0 +1,119 @@
+#include "tests/common/TestFramework.h"
+#include "duilib/Utils/FenwickTree.h"
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+/** 检查树状数组与参照数据（普通数组）一致：元素个数、每个元素的值、前缀和、查找
+*/
+bool CheckFenwickTree(const ui::FenwickTree<int64_t>& tree, const std::vector<int64_t>& values)
+{
+    if (tree.GetCount() != values.size()) {
+        return false;
+    }
+    int64_t nSum = 0;
+    for (size_t i = 0; i < values.size(); ++i) {
+        if ((tree.GetPrefixSum(i) != nSum) || (tree.GetValue(i) != values[i])) {
+            return false;
+        }
+        //前(i+1)个元素的和大于nSum的第一个元素：跳过值为0的元素
+        size_t nExpected = i;
+        while ((nExpected < values.size()) && (values[nExpected] == 0)) {
+            ++nExpected;
+        }
+        if (tree.FindFirstGreater(nSum) != nExpected) {
+            return false;
+        }
+        nSum += values[i];
+    }
+    return (tree.GetPrefixSum(values.size()) == nSum) && (tree.FindFirstGreater(nSum) == values.size());
+}
+
+} // namespace
+
+/** 随机的追加、插入、删除、修改、调整大小操作，结果与普通数组一致
+*/
+DUILIB_TEST(FenwickTreeMatchesArray)
+{
+    ui::FenwickTree<int64_t> tree;
+    std::vector<int64_t> values;
+    uint32_t nSeed = 0x13579BDF;
+    auto nextRandom = [&nSeed](uint32_t nMax) {
+            nSeed = nSeed * 1664525u + 1013904223u;
+            return (nSeed >> 8) % nMax;
+        };
+    bool bMatched = true;
+    for (int32_t nStep = 0; (nStep < 3000) && bMatched; ++nStep) {
+        const uint32_t nOperation = nextRandom(6);
+        const int64_t nValue = (int64_t)nextRandom(4) * 10;
+        if ((nOperation == 0) || values.empty()) {
+            tree.PushBack(nValue);
+            values.push_back(nValue);
+        }
+        else if (nOperation == 1) {
+            const size_t nIndex = nextRandom((uint32_t)values.size() + 1);
+            const size_t nCount = nextRandom(3) + 1;
+            tree.InsertElements(nIndex, nCount, nValue);
+            values.insert(values.begin() + nIndex, nCount, nValue);
+        }
+        else if (nOperation == 2) {
+            const size_t nIndex = nextRandom((uint32_t)values.size());
+            const size_t nCount = std::min((size_t)nextRandom(3) + 1, values.size() - nIndex);
+            tree.RemoveElements(nIndex, nCount);
+            values.erase(values.begin() + nIndex, values.begin() + nIndex + nCount);
+        }
+        else if (nOperation == 3) {
+            const size_t nIndex = nextRandom((uint32_t)values.size());
+            tree.Add(nIndex, nValue - values[nIndex]);
+            values[nIndex] = nValue;
+        }
+        else if (nOperation == 4) {
+            const size_t nCount = nextRandom((uint32_t)values.size() + 8);
+            tree.Resize(nCount, nValue);
+            values.resize(nCount, nValue);
+        }
+        else {
+            //偶尔整体重建
+            if (nextRandom(20) == 0) {
+                tree.Assign(values);
+            }
+        }
+        bMatched = CheckFenwickTree(tree, values);
+    }
+    TEST_CHECK(bMatched);
+    tree.Clear();
+    TEST_CHECK_EQ(tree.GetCount(), 0u);
+    TEST_CHECK_EQ(tree.GetPrefixSum(10), 0);
+    TEST_CHECK_EQ(tree.FindFirstGreater(0), 0u);
+}
+
+/** 在中间插入、删除元素时，结果与整体重建相同（树节点逐个比较）
+*/
+DUILIB_TEST(FenwickTreeSuffixRebuildMatchesAssign)
+{
+    std::vector<int64_t> values(1000);
+    std::iota(values.begin(), values.end(), 1);
+    for (size_t nIndex : { (size_t)0, (size_t)1, (size_t)255, (size_t)256, (size_t)511, (size_t)999, (size_t)1000 }) {
+        ui::FenwickTree<int64_t> tree;
+        tree.Assign(values);
+        tree.InsertElements(nIndex, 3, 7);
+        std::vector<int64_t> expectedValues = values;
+        expectedValues.insert(expectedValues.begin() + nIndex, 3, 7);
+        ui::FenwickTree<int64_t> expectedTree;
+        expectedTree.Assign(expectedValues);
+        bool bSame = true;
+        for (size_t i = 1; i <= expectedValues.size(); ++i) {
+            bSame = bSame && (tree.GetNode(i) == expectedTree.GetNode(i));
+        }
+        TEST_CHECK(bSame);
+
+        tree.RemoveElements(nIndex, 3);
+        expectedTree.Assign(values);
+        bSame = true;
+        for (size_t i = 1; i <= values.size(); ++i) {
+            bSame = bSame && (tree.GetNode(i) == expectedTree.GetNode(i));
+        }
+        TEST_CHECK(bSame);
+    }
+}
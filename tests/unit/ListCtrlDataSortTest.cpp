@@ -0,0 +1,201 @@
+#include "tests/common/TestFramework.h"
+#include "duilib/duilib.h"
+#include "duilib/Control/ListCtrlData.h"
+#include <algorithm>
+
+namespace
+{
+/** 排序关键字所在的列，以及保存原始行号的列
+*/
+const size_t kKeyColumnId = 1;
+const size_t kRowIdColumnId = 2;
+
+/** 测试数据的一行
+*/
+struct SortTestRow
+{
+    bool bHasData = false;  //排序列是否有数据
+    DString key;            //排序关键字
+    uint64_t nRowId = 0;    //原始行号
+};
+
+/** 生成测试数据：关键字有大量重复（用于检查排序的稳定性），部分行在排序列中无数据
+*/
+std::vector<SortTestRow> MakeSortTestRows(size_t nCount)
+{
+    std::vector<SortTestRow> rows(nCount);
+    uint32_t nSeed = 0x2468ACE1;
+    for (size_t i = 0; i < nCount; ++i) {
+        nSeed = nSeed * 1664525u + 1013904223u;
+        SortTestRow& row = rows[i];
+        row.nRowId = i;
+        row.bHasData = (nSeed >> 28) != 0;
+        if (row.bHasData) {
+            row.key = (((nSeed >> 8) & 1) != 0) ? _T("Key_") : _T("key_");
+            row.key += ui::StringUtil::UInt64ToString((nSeed >> 16) % 37);
+        }
+    }
+    return rows;
+}
+
+/** 将测试数据填充到列表数据中
+*/
+void FillListCtrlData(ui::ListCtrlData& listCtrlData, const std::vector<SortTestRow>& rows)
+{
+    listCtrlData.AddColumn(kKeyColumnId);
+    listCtrlData.AddColumn(kRowIdColumnId);
+    ui::ListCtrlSubItemData subItemData;
+    for (const SortTestRow& row : rows) {
+        subItemData.userDataN = row.nRowId;
+        const size_t itemIndex = listCtrlData.AddDataItem(kRowIdColumnId, subItemData);
+        if (row.bHasData) {
+            listCtrlData.SetSubItemText(itemIndex, kKeyColumnId, row.key);
+        }
+    }
+}
+
+/** 参照实现：稳定排序，升序时无数据的行排在最前面，降序时无数据的行排在最后面
+*/
+std::vector<uint64_t> ReferenceSort(std::vector<SortTestRow> rows, bool bSortedUp, bool bNoCase)
+{
+    auto rowLess = [bNoCase](const SortTestRow& a, const SortTestRow& b) {
+            if (!b.bHasData) {
+                return false;
+            }
+            if (!a.bHasData) {
+                return true;
+            }
+            if (bNoCase) {
+                return ui::StringUtil::StringICompare(a.key.c_str(), b.key.c_str()) < 0;
+            }
+            return a.key < b.key;
+        };
+    std::stable_sort(rows.begin(), rows.end(), [&](const SortTestRow& a, const SortTestRow& b) {
+            return bSortedUp ? rowLess(a, b) : rowLess(b, a);
+        });
+    std::vector<uint64_t> rowIds;
+    for (const SortTestRow& row : rows) {
+        rowIds.push_back(row.nRowId);
+    }
+    return rowIds;
+}
+
+/** 获取列表数据当前的行顺序（原始行号）
+*/
+std::vector<uint64_t> GetRowIds(const ui::ListCtrlData& listCtrlData)
+{
+    std::vector<uint64_t> rowIds;
+    const size_t nCount = listCtrlData.GetDataItemCount();
+    for (size_t itemIndex = 0; itemIndex < nCount; ++itemIndex) {
+        rowIds.push_back(listCtrlData.GetSubItemUserDataN(itemIndex, kRowIdColumnId));
+    }
+    return rowIds;
+}
+
+/** 自定义的比较函数：按文本比较（区分大小写）
+*/
+bool CompareSubItemText(const ui::ListCtrlSubItemData2& a, const ui::ListCtrlSubItemData2& b,
+                        const ui::ListCtrlCompareParam& /*param*/)
+{
+    return ui::StringUtil::StringCompare(a.text.c_str(), b.text.c_str()) < 0;
+}
+
+/** 按各种方式排序，与参照实现的结果比较
+* @param [in] nCount 数据的行数（数据量大时使用并行排序）
+*/
+void CheckSortDataItems(size_t nCount)
+{
+    const std::vector<SortTestRow> rows = MakeSortTestRows(nCount);
+    for (bool bSortedUp : { true, false }) {
+        //默认的比较函数（区分大小写、不区分大小写）
+        for (bool bNoCase : { false, true }) {
+            ui::ListCtrlData listCtrlData;
+            FillListCtrlData(listCtrlData, rows);
+            const uint8_t nSortFlag = bNoCase ? ui::ListCtrlSubItemSortFlag::kSortNoCase : ui::ListCtrlSubItemSortFlag::kSortByText;
+            TEST_CHECK(listCtrlData.SortDataItems(kKeyColumnId, 0, bSortedUp, nSortFlag, nullptr, nullptr));
+            TEST_CHECK(GetRowIds(listCtrlData) == ReferenceSort(rows, bSortedUp, bNoCase));
+        }
+        //自定义的比较函数
+        ui::ListCtrlData listCtrlData;
+        FillListCtrlData(listCtrlData, rows);
+        TEST_CHECK(listCtrlData.SortDataItems(kKeyColumnId, 0, bSortedUp, ui::ListCtrlSubItemSortFlag::kSortByText,
+                                              CompareSubItemText, nullptr));
+        TEST_CHECK(GetRowIds(listCtrlData) == ReferenceSort(rows, bSortedUp, false));
+    }
+}
+
+} // namespace
+
+/** 排序：升序、降序，关键字相同的行保持原来的顺序，无数据的行升序时在最前、降序时在最后
+*/
+DUILIB_TEST(ListCtrlDataSortMatchesStableReference)
+{
+    CheckSortDataItems(1000);
+}
+
+/** 数据量大时使用并行排序，结果与单线程的稳定排序相同
+*/
+DUILIB_TEST(ListCtrlDataParallelSortIsStable)
+{
+    CheckSortDataItems(100000);
+}
+
+/** 先后按两列排序：稳定排序实现多列排序的效果
+*/
+DUILIB_TEST(ListCtrlDataSortByTwoColumns)
+{
+    const std::vector<SortTestRow> rows = MakeSortTestRows(2000);
+    ui::ListCtrlData listCtrlData;
+    FillListCtrlData(listCtrlData, rows);
+    //先按原始行号降序，再按关键字升序：关键字相同的行，原始行号降序排列
+    TEST_CHECK(listCtrlData.SortDataItems(kRowIdColumnId, 0, false, ui::ListCtrlSubItemSortFlag::kSortByUserDataN, nullptr, nullptr));
+    TEST_CHECK(listCtrlData.SortDataItems(kKeyColumnId, 0, true, ui::ListCtrlSubItemSortFlag::kSortByText, nullptr, nullptr));
+
+    std::vector<SortTestRow> reversedRows(rows.rbegin(), rows.rend());
+    TEST_CHECK(GetRowIds(listCtrlData) == ReferenceSort(reversedRows, true, false));
+}
+
+/** 修改数据后的增量排序：移动到正确的位置，其他行保持原来的顺序
+*/
+DUILIB_TEST(ListCtrlDataResortDataItem)
+{
+    std::vector<SortTestRow> rows = MakeSortTestRows(500);
+    for (bool bCustomCompare : { false, true }) {
+        for (bool bSortedUp : { true, false }) {
+            ui::ListCtrlData listCtrlData;
+            FillListCtrlData(listCtrlData, rows);
+            TEST_CHECK(listCtrlData.SortDataItems(kKeyColumnId, 0, bSortedUp, ui::ListCtrlSubItemSortFlag::kSortByText,
+                                                  bCustomCompare ? CompareSubItemText : nullptr, nullptr));
+            //修改一个数据项的关键字后重新定位
+            const size_t itemIndex = 123;
+            const uint64_t nRowId = listCtrlData.GetSubItemUserDataN(itemIndex, kRowIdColumnId);
+            listCtrlData.SetSubItemText(itemIndex, kKeyColumnId, _T("key_20"));
+            listCtrlData.ResortDataItem(itemIndex);
+
+            std::vector<SortTestRow> modifiedRows = rows;
+            modifiedRows[nRowId].bHasData = true;
+            modifiedRows[nRowId].key = _T("key_20");
+            const std::vector<uint64_t> expectedRowIds = ReferenceSort(modifiedRows, bSortedUp, false);
+            const std::vector<uint64_t> rowIds = GetRowIds(listCtrlData);
+            //与整体重新排序的结果相比，只有关键字相同的行中该行的位置可能不同（插入到相等的行之后）
+            std::vector<uint64_t> otherRowIds;
+            std::vector<uint64_t> expectedOtherRowIds;
+            for (size_t i = 0; i < rowIds.size(); ++i) {
+                if (rowIds[i] != nRowId) {
+                    otherRowIds.push_back(rowIds[i]);
+                }
+                if (expectedRowIds[i] != nRowId) {
+                    expectedOtherRowIds.push_back(expectedRowIds[i]);
+                }
+            }
+            TEST_CHECK(otherRowIds == expectedOtherRowIds);
+            const size_t nNewIndex = std::find(rowIds.begin(), rowIds.end(), nRowId) - rowIds.begin();
+            TEST_CHECK(nNewIndex < rowIds.size());
+            TEST_CHECK_EQ(listCtrlData.GetSubItemText(nNewIndex, kKeyColumnId), DString(_T("key_20")));
+            if ((nNewIndex + 1) < rowIds.size()) {
+                const DString nextKey = listCtrlData.GetSubItemText(nNewIndex + 1, kKeyColumnId);
+                TEST_CHECK(bSortedUp ? (nextKey > _T("key_20")) : ((nextKey < _T("key_20")) || nextKey.empty()));
+            }
+        }
+    }
+}
@@ -0,0 +1,97 @@
+#include "tests/common/TestFramework.h"
+#include "duilib/duilib.h"
+#include "duilib/Control/ListCtrlHeightIndex.h"
+
+namespace
+{
+/** 默认行高
+*/
+const int32_t kDefaultItemHeight = 20;
+
+/** 检查增量更新后的索引与按行数据重建的索引一致
+*/
+bool CheckHeightIndex(const ui::ListCtrlHeightIndex& heightIndex, const std::vector<ui::ListCtrlItemData>& rowDataList)
+{
+    ui::ListCtrlHeightIndex expectedIndex;
+    expectedIndex.Build(rowDataList, kDefaultItemHeight);
+    if (!heightIndex.IsValid(rowDataList.size(), kDefaultItemHeight) ||
+        (heightIndex.GetRowCount() != expectedIndex.GetRowCount()) ||
+        (heightIndex.GetAtTopHeights() != expectedIndex.GetAtTopHeights())) {
+        return false;
+    }
+    for (size_t nRowCount = 0; nRowCount <= rowDataList.size(); ++nRowCount) {
+        if ((heightIndex.GetScrollHeights(nRowCount) != expectedIndex.GetScrollHeights(nRowCount)) ||
+            (heightIndex.GetAtTopHeights(nRowCount) != expectedIndex.GetAtTopHeights(nRowCount))) {
+            return false;
+        }
+    }
+    const int64_t nTotalHeights = expectedIndex.GetTotalScrollHeights() + expectedIndex.GetAtTopHeights();
+    for (int64_t nHeights = 0; nHeights <= nTotalHeights; nHeights += 7) {
+        if ((heightIndex.FindRow(nHeights) != expectedIndex.FindRow(nHeights)) ||
+            (heightIndex.FindScrollRow(nHeights) != expectedIndex.FindScrollRow(nHeights)) ||
+            (heightIndex.FindAtTopRow(nHeights) != expectedIndex.FindAtTopRow(nHeights))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+/** 行高索引的增量更新（追加、插入、删除、修改、调整行数）与整体重建的结果一致
+*/
+DUILIB_TEST(ListCtrlHeightIndexIncrementalMatchesBuild)
+{
+    std::vector<ui::ListCtrlItemData> rowDataList;
+    ui::ListCtrlHeightIndex heightIndex;
+    heightIndex.Build(rowDataList, kDefaultItemHeight);
+    uint32_t nSeed = 0x2468ACE1;
+    auto nextRandom = [&nSeed](uint32_t nMax) {
+            nSeed = nSeed * 1664525u + 1013904223u;
+            return (nSeed >> 8) % nMax;
+        };
+    auto makeRowData = [&nextRandom]() {
+            ui::ListCtrlItemData rowData;
+            const uint32_t nType = nextRandom(8);
+            if (nType == 0) {
+                rowData.bVisible = false;
+            }
+            else if (nType == 1) {
+                rowData.nItemHeight = (int16_t)nextRandom(40);
+            }
+            else if (nType == 2) {
+                rowData.nAlwaysAtTop = 0;
+            }
+            return rowData;
+        };
+    bool bMatched = true;
+    for (int32_t nStep = 0; (nStep < 600) && bMatched; ++nStep) {
+        const uint32_t nOperation = nextRandom(5);
+        if ((nOperation == 0) || rowDataList.empty()) {
+            rowDataList.push_back(makeRowData());
+            heightIndex.AppendRow(rowDataList.back());
+        }
+        else if (nOperation == 1) {
+            const size_t nIndex = nextRandom((uint32_t)rowDataList.size() + 1);
+            rowDataList.insert(rowDataList.begin() + nIndex, makeRowData());
+            heightIndex.InsertRow(nIndex, rowDataList[nIndex]);
+        }
+        else if (nOperation == 2) {
+            const size_t nIndex = nextRandom((uint32_t)rowDataList.size());
+            rowDataList.erase(rowDataList.begin() + nIndex);
+            heightIndex.RemoveRow(nIndex);
+        }
+        else if (nOperation == 3) {
+            const size_t nIndex = nextRandom((uint32_t)rowDataList.size());
+            rowDataList[nIndex] = makeRowData();
+            heightIndex.UpdateRow(nIndex, rowDataList[nIndex]);
+        }
+        else {
+            const size_t nCount = nextRandom((uint32_t)rowDataList.size() + 4);
+            rowDataList.resize(nCount);
+            heightIndex.SetRowCount(nCount);
+        }
+        bMatched = CheckHeightIndex(heightIndex, rowDataList);
+    }
+    TEST_CHECK(bMatched);
+}
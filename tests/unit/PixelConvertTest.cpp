@@ -0,0 +1,152 @@
+#include "tests/common/TestFramework.h"
+#include "duilib/Render/PixelConvert.h"
+#include <cstring>
+
+namespace
+{
+/** 颜色通道顺序（R、G、B、A所在的字节序号）
+*/
+struct ChannelOrder
+{
+    int32_t r;
+    int32_t g;
+    int32_t b;
+    int32_t a;
+};
+
+/** 生成测试用的像素数据（固定的伪随机序列，保证每次运行结果相同）
+*/
+std::vector<uint32_t> MakePixels(int32_t nWidth, int32_t nHeight)
+{
+    std::vector<uint32_t> pixels((size_t)nWidth * nHeight);
+    uint32_t nSeed = 0x12345678;
+    for (uint32_t& pixel : pixels) {
+        nSeed = nSeed * 1664525u + 1013904223u;
+        pixel = nSeed;
+    }
+    //包含边界值
+    if (pixels.size() >= 2) {
+        pixels[0] = 0x00000000;
+        pixels[1] = 0xFFFFFFFF;
+    }
+    return pixels;
+}
+
+/** 参照实现：SDL窗口绘制时原有的逐像素处理方式（复制、调整颜色通道顺序、Alpha缩放）
+*/
+void ReferenceConvertRect(uint32_t* pDst, const uint32_t* pSrc, int32_t nStride, const ui::UiRect& rc,
+                          const ChannelOrder& src, const ChannelOrder& dst, uint8_t nAlpha)
+{
+    for (int32_t nRow = rc.top; nRow < rc.bottom; ++nRow) {
+        ::memmove(pDst + (size_t)nRow * nStride + rc.left, pSrc + (size_t)nRow * nStride + rc.left,
+                  (size_t)rc.Width() * sizeof(uint32_t));
+    }
+    for (int32_t nRow = rc.top; nRow < rc.bottom; ++nRow) {
+        for (int32_t nCol = rc.left; nCol < rc.right; ++nCol) {
+            uint32_t* pColorValue = pDst + (size_t)nRow * nStride + nCol;
+            uint32_t colorValue = *pColorValue;
+            uint8_t* pDstBytes = (uint8_t*)pColorValue;
+            const uint8_t* pSrcBytes = (const uint8_t*)&colorValue;
+            pDstBytes[dst.r] = pSrcBytes[src.r];
+            pDstBytes[dst.g] = pSrcBytes[src.g];
+            pDstBytes[dst.b] = pSrcBytes[src.b];
+            pDstBytes[dst.a] = pSrcBytes[src.a];
+            if (nAlpha != 255) {
+                for (int32_t i = 0; i < 4; ++i) {
+                    pDstBytes[i] = (uint8_t)(pDstBytes[i] * nAlpha / 255);
+                }
+            }
+        }
+    }
+}
+
+/** 测试用的颜色通道顺序组合
+*/
+const ChannelOrder kChannelOrders[][2] = {
+    { { 0, 1, 2, 3 }, { 0, 1, 2, 3 } },     //顺序不变
+    { { 0, 1, 2, 3 }, { 2, 1, 0, 3 } },     //R与B交换
+    { { 2, 1, 0, 3 }, { 0, 1, 2, 3 } },     //R与B交换
+    { { 0, 1, 2, 3 }, { 3, 2, 1, 0 } },     //字节序反转
+    { { 1, 2, 3, 0 }, { 0, 1, 2, 3 } },     //任意顺序
+    { { 3, 0, 2, 1 }, { 1, 3, 0, 2 } }      //任意顺序
+};
+
+/** 测试用的透明度
+*/
+const uint8_t kAlphaValues[] = { 255, 254, 128, 1, 0 };
+
+/** 测试用的图像宽度（覆盖SIMD实现中不足一个批次的剩余像素）
+*/
+const int32_t kWidths[] = { 1, 3, 4, 7, 8, 15, 16, 17, 31, 33, 67 };
+
+} // namespace
+
+/** 行转换（非原地）：与参照实现的结果逐像素比较
+*/
+DUILIB_TEST(PixelConvertRowMatchesReference)
+{
+    for (const auto& orders : kChannelOrders) {
+        const ChannelOrder& src = orders[0];
+        const ChannelOrder& dst = orders[1];
+        for (uint8_t nAlpha : kAlphaValues) {
+            ui::PixelConvert pixelConvert(src.r, src.g, src.b, src.a, dst.r, dst.g, dst.b, dst.a, nAlpha);
+            TEST_CHECK(pixelConvert.IsValid());
+            for (int32_t nWidth : kWidths) {
+                const std::vector<uint32_t> srcPixels = MakePixels(nWidth, 1);
+                std::vector<uint32_t> expected(srcPixels.size(), 0);
+                std::vector<uint32_t> actual(srcPixels.size(), 0);
+                ReferenceConvertRect(expected.data(), srcPixels.data(), nWidth, ui::UiRect(0, 0, nWidth, 1), src, dst, nAlpha);
+                pixelConvert.ConvertRow(actual.data(), srcPixels.data(), nWidth);
+                TEST_CHECK(actual == expected);
+            }
+        }
+    }
+}
+
+/** 原地转换：源数据与目标数据相同
+*/
+DUILIB_TEST(PixelConvertRowInPlace)
+{
+    for (const auto& orders : kChannelOrders) {
+        const ChannelOrder& src = orders[0];
+        const ChannelOrder& dst = orders[1];
+        for (uint8_t nAlpha : kAlphaValues) {
+            ui::PixelConvert pixelConvert(src.r, src.g, src.b, src.a, dst.r, dst.g, dst.b, dst.a, nAlpha);
+            for (int32_t nWidth : kWidths) {
+                const std::vector<uint32_t> srcPixels = MakePixels(nWidth, 1);
+                std::vector<uint32_t> expected(srcPixels.size(), 0);
+                ReferenceConvertRect(expected.data(), srcPixels.data(), nWidth, ui::UiRect(0, 0, nWidth, 1), src, dst, nAlpha);
+                std::vector<uint32_t> pixels = srcPixels;
+                pixelConvert.ConvertRow(pixels.data(), pixels.data(), nWidth);
+                TEST_CHECK(pixels == expected);
+            }
+        }
+    }
+}
+
+/** 矩形区域转换：只修改矩形内的像素，矩形外的像素保持不变
+*/
+DUILIB_TEST(PixelConvertRectOnlyTouchesRect)
+{
+    const int32_t nWidth = 45;
+    const int32_t nHeight = 13;
+    const std::vector<uint32_t> srcPixels = MakePixels(nWidth, nHeight);
+    const ui::UiRect rects[] = {
+        ui::UiRect(0, 0, nWidth, nHeight),
+        ui::UiRect(3, 2, 40, 11),
+        ui::UiRect(5, 5, 6, 6),
+        ui::UiRect(44, 0, 45, 13)
+    };
+    for (const auto& orders : kChannelOrders) {
+        const ChannelOrder& src = orders[0];
+        const ChannelOrder& dst = orders[1];
+        ui::PixelConvert pixelConvert(src.r, src.g, src.b, src.a, dst.r, dst.g, dst.b, dst.a, 200);
+        for (const ui::UiRect& rc : rects) {
+            std::vector<uint32_t> expected(srcPixels.size(), 0xA5A5A5A5);
+            std::vector<uint32_t> actual(srcPixels.size(), 0xA5A5A5A5);
+            ReferenceConvertRect(expected.data(), srcPixels.data(), nWidth, rc, src, dst, 200);
+            pixelConvert.ConvertRect(actual.data(), nWidth, srcPixels.data(), nWidth, rc);
+            TEST_CHECK(actual == expected);
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#include "tests/common/TestFramework.h"
+#include "duilib/duilib.h"
+#include "duilib/Control/RichEditLineIndex.h"
+#include <algorithm>
+
+namespace
+{
+/** 生成一行文本数据
+*/
+ui::RichTextLineInfoPtr MakeLineInfo(uint32_t nLineTextLen)
+{
+    ui::RichTextLineInfoPtr spLineInfo(new ui::RichTextLineInfo);
+    spLineInfo->m_nLineTextLen = nLineTextLen;
+    return spLineInfo;
+}
+
+/** 检查增量更新的索引与整体重建的索引一致
+*/
+bool CheckLineIndex(const ui::RichEditLineIndex& lineIndex, const ui::RichTextLineInfoList& lineTextInfo)
+{
+    ui::RichEditLineIndex expectedIndex;
+    expectedIndex.Build(lineTextInfo);
+    if (!lineIndex.IsValid(lineTextInfo.size()) || (lineIndex.GetTextLength() != expectedIndex.GetTextLength())) {
+        return false;
+    }
+    for (size_t nLineIndex = 0; nLineIndex <= lineTextInfo.size(); ++nLineIndex) {
+        const size_t nLineStart = expectedIndex.GetLineStart(nLineIndex);
+        if ((lineIndex.GetLineStart(nLineIndex) != nLineStart) ||
+            (lineIndex.FindLine(nLineStart) != expectedIndex.FindLine(nLineStart))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+/** 随机替换若干行（行数增加、减少或者不变），增量更新的结果与整体重建相同
+*/
+DUILIB_TEST(RichEditLineIndexReplaceLinesMatchesBuild)
+{
+    ui::RichTextLineInfoList lineTextInfo;
+    for (uint32_t i = 0; i < 200; ++i) {
+        lineTextInfo.push_back(MakeLineInfo(1 + i % 17));
+    }
+    ui::RichEditLineIndex lineIndex;
+    lineIndex.Build(lineTextInfo);
+
+    uint32_t nSeed = 0x5A5A1234;
+    auto nextRandom = [&nSeed](uint32_t nMax) {
+            nSeed = nSeed * 1664525u + 1013904223u;
+            return (nSeed >> 8) % nMax;
+        };
+    bool bMatched = true;
+    for (int32_t nStep = 0; (nStep < 500) && bMatched; ++nStep) {
+        const size_t nStartLine = nextRandom((uint32_t)lineTextInfo.size() + 1);
+        const size_t nRemovedCount = std::min((size_t)nextRandom(4), lineTextInfo.size() - nStartLine);
+        const size_t nInsertedCount = nextRandom(4);
+        lineTextInfo.erase(lineTextInfo.begin() + nStartLine, lineTextInfo.begin() + nStartLine + nRemovedCount);
+        for (size_t i = 0; i < nInsertedCount; ++i) {
+            lineTextInfo.insert(lineTextInfo.begin() + nStartLine + i, MakeLineInfo(1 + nextRandom(80)));
+        }
+        lineIndex.ReplaceLines(nStartLine, nRemovedCount, nInsertedCount);
+        for (size_t i = 0; i < nInsertedCount; ++i) {
+            lineIndex.UpdateLine(nStartLine + i, lineTextInfo[nStartLine + i]->m_nLineTextLen);
+        }
+        bMatched = CheckLineIndex(lineIndex, lineTextInfo);
+    }
+    TEST_CHECK(bMatched);
+}
@@ -0,0 +1,70 @@
+#include "tests/common/TestFramework.h"
+#include "duilib/duilib.h"
+
+/** 颜色表的版本号：每个颜色表独立，修改一个颜色表不影响其他颜色表的版本号
+*/
+DUILIB_TEST(ColorMapVersionIsPerMap)
+{
+    ui::ColorMap colorMap1;
+    ui::ColorMap colorMap2;
+    TEST_CHECK(colorMap1.GetVersion() != 0);
+    TEST_CHECK(colorMap1.GetVersion() != colorMap2.GetVersion());
+
+    const uint32_t nVersion1 = colorMap1.GetVersion();
+    const uint32_t nVersion2 = colorMap2.GetVersion();
+    colorMap2.AddColor(_T("test_color"), ui::UiColor(0xFF102030));
+    TEST_CHECK_EQ(colorMap1.GetVersion(), nVersion1);
+    TEST_CHECK(colorMap2.GetVersion() != nVersion2);
+
+    //删除不存在的颜色，版本号不变
+    const uint32_t nVersion3 = colorMap2.GetVersion();
+    colorMap2.RemoveColor(_T("not_exist_color"));
+    TEST_CHECK_EQ(colorMap2.GetVersion(), nVersion3);
+    colorMap2.RemoveAllColors();
+    TEST_CHECK(colorMap2.GetVersion() != nVersion3);
+
+    //新创建的颜色表，版本号与已有的颜色表都不同
+    ui::ColorMap colorMap3;
+    TEST_CHECK(colorMap3.GetVersion() != colorMap1.GetVersion());
+    TEST_CHECK(colorMap3.GetVersion() != colorMap2.GetVersion());
+}
+
+/** 预先解析的颜色值：窗口颜色表变化后重新解析，控件移动到其他窗口后按新窗口的颜色表解析
+*/
+DUILIB_TEST(UiNamedColorFollowsWindowColorMap)
+{
+    const DString xml = _T("<?xml version=\"1.0\" encoding=\"UTF-8\"?><Window size=\"200,100\"><VBox/></Window>");
+    ui::Window* pWindow1 = new ui::Window;
+    pWindow1->InitSkin(_T(""), xml);
+    ui::Window* pWindow2 = new ui::Window;
+    pWindow2->InitSkin(_T(""), xml);
+    if (!pWindow1->CreateWnd(nullptr, ui::WindowCreateParam(_T("UiNamedColorTest1"), true)) ||
+        !pWindow2->CreateWnd(nullptr, ui::WindowCreateParam(_T("UiNamedColorTest2"), true))) {
+        TEST_CHECK(!"CreateWnd failed");
+        return;
+    }
+    pWindow1->AddTextColor(_T("test_named_color"), ui::UiColor(0xFF112233));
+    pWindow2->AddTextColor(_T("test_named_color"), ui::UiColor(0xFF445566));
+
+    ui::Control* pControl = pWindow1->GetRoot();
+    ui::UiNamedColor namedColor;
+    namedColor = DString(_T("test_named_color"));
+    TEST_CHECK_EQ(namedColor.GetColor(pControl).GetARGB(), 0xFF112233u);
+
+    //其他窗口的颜色表变化，不影响本窗口的颜色值
+    const uint32_t nVersion1 = pWindow1->GetTextColorVersion();
+    pWindow2->AddTextColor(_T("test_other_color"), ui::UiColor(0xFF778899));
+    TEST_CHECK_EQ(pWindow1->GetTextColorVersion(), nVersion1);
+    TEST_CHECK_EQ(namedColor.GetColor(pControl).GetARGB(), 0xFF112233u);
+
+    //本窗口的颜色表变化，重新解析
+    pWindow1->RemoveTextColor(_T("test_named_color"));
+    pWindow1->AddTextColor(_T("test_named_color"), ui::UiColor(0xFFAABBCC));
+    TEST_CHECK_EQ(namedColor.GetColor(pControl).GetARGB(), 0xFFAABBCCu);
+
+    //按其他窗口的颜色表解析
+    TEST_CHECK_EQ(namedColor.GetColor(pWindow2->GetRoot()).GetARGB(), 0xFF445566u);
+
+    pWindow1->CloseWnd();
+    pWindow2->CloseWnd();
+}
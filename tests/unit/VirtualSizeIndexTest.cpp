@@ -0,0 +1,85 @@
+#include "tests/common/TestFramework.h"
+#include "duilib/Layout/VirtualSizeIndex.h"
+#include <algorithm>
+
+namespace
+{
+/** 未测量元素的估计大小、元素之间的间隔
+*/
+const int32_t kEstimateSize = 20;
+const int32_t kMargin = 2;
+
+/** 检查索引与参照数据（每个元素的实际大小，-1表示未测量）一致
+*/
+bool CheckSizeIndex(const ui::VirtualSizeIndex& sizeIndex, const std::vector<int32_t>& sizes)
+{
+    if (sizeIndex.GetElementCount() != sizes.size()) {
+        return false;
+    }
+    int64_t nTotalSize = 0;
+    int32_t nMinSize = -1;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        if (sizeIndex.GetElementsSize(i, kEstimateSize, kMargin) != nTotalSize) {
+            return false;
+        }
+        if (sizeIndex.IsElementMeasured(i) != (sizes[i] >= 0)) {
+            return false;
+        }
+        //元素的大小加上间隔总是大于0，位置nTotalSize所在的元素即为i
+        if (sizeIndex.FindElement(nTotalSize, kEstimateSize, kMargin) != i) {
+            return false;
+        }
+        if ((sizes[i] >= 0) && ((nMinSize < 0) || (sizes[i] < nMinSize))) {
+            nMinSize = sizes[i];
+        }
+        nTotalSize += ((sizes[i] >= 0) ? sizes[i] : kEstimateSize) + kMargin;
+    }
+    return (sizeIndex.GetElementsSize(sizes.size(), kEstimateSize, kMargin) == nTotalSize) &&
+           (sizeIndex.FindElement(nTotalSize, kEstimateSize, kMargin) == sizes.size()) &&
+           (sizeIndex.GetMinMeasuredSize() == nMinSize);
+}
+
+} // namespace
+
+/** 随机的设置大小、插入、删除、调整元素个数操作，结果与逐个累加的结果一致
+*/
+DUILIB_TEST(VirtualSizeIndexMatchesArray)
+{
+    ui::VirtualSizeIndex sizeIndex;
+    std::vector<int32_t> sizes;
+    uint32_t nSeed = 0x0F1E2D3C;
+    auto nextRandom = [&nSeed](uint32_t nMax) {
+            nSeed = nSeed * 1664525u + 1013904223u;
+            return (nSeed >> 8) % nMax;
+        };
+    bool bMatched = true;
+    for (int32_t nStep = 0; (nStep < 2000) && bMatched; ++nStep) {
+        const uint32_t nOperation = nextRandom(5);
+        if ((nOperation == 0) || sizes.empty()) {
+            const size_t nCount = nextRandom((uint32_t)sizes.size() + 16);
+            sizeIndex.SetElementCount(nCount);
+            sizes.resize(nCount, -1);
+        }
+        else if (nOperation == 1) {
+            const size_t nIndex = nextRandom((uint32_t)sizes.size() + 1);
+            const size_t nCount = nextRandom(4) + 1;
+            sizeIndex.InsertElements(nIndex, nCount);
+            sizes.insert(sizes.begin() + nIndex, nCount, -1);
+        }
+        else if (nOperation == 2) {
+            const size_t nIndex = nextRandom((uint32_t)sizes.size());
+            const size_t nCount = std::min((size_t)nextRandom(4) + 1, sizes.size() - nIndex);
+            sizeIndex.RemoveElements(nIndex, nCount);
+            sizes.erase(sizes.begin() + nIndex, sizes.begin() + nIndex + nCount);
+        }
+        else {
+            //设置大小，部分恢复为未测量状态
+            const size_t nIndex = nextRandom((uint32_t)sizes.size());
+            const int32_t nSize = (int32_t)nextRandom(60) - 10;
+            sizeIndex.SetElementSize(nIndex, nSize);
+            sizes[nIndex] = std::max(nSize, -1);
+        }
+        bMatched = CheckSizeIndex(sizeIndex, sizes);
+    }
+    TEST_CHECK(bMatched);
+}
@@ -0,0 +1,11 @@
+#include "tests/common/TestMainThread.h"
+
+/** 单元测试程序的入口点
+ * 用法：duilib_tests [过滤字符串]，指定过滤字符串时，只执行名称中包含该字符串的用例
+ * 返回值：失败的用例个数
+ */
+int main(int argc, char** argv)
+{
+    const char* filter = (argc > 1) ? argv[1] : nullptr;
+    return ui_test::RunTestsInUIThread(ui_test::GetUnitTests(), filter);
+}